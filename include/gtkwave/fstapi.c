@@ -742,6 +742,7 @@ struct fstWriterContext
     unsigned flush_context_pending : 1;
     unsigned parallel_enabled : 1;
     unsigned parallel_was_enabled : 1;
+    unsigned int compress_threads; /* threads to compress value changes with, <= 1: none */
 
     /* should really be semaphores, but are bytes to cut down on read-modify-write window size */
     unsigned char already_in_flush; /* in case control-c handlers interrupt */
@@ -1211,6 +1212,385 @@ static void fstWriterEmitSectionHeader(fstWriterContext *xc)
     }
 }
 
+/*
+ * encode the value change chain of one handle backwards from scratchend,
+ * returns the start of the encoded data
+ */
+static unsigned char *fstWriterEncodeChain(fstWriterContext *xc,
+                                           uint32_t *vm4ip,
+                                           unsigned char *scratchend)
+{
+    unsigned char *vchg_mem = xc->vchg_mem;
+    unsigned char *scratchpnt = scratchend;
+    uint32_t offs = vm4ip[2];
+    uint32_t next_offs;
+    unsigned int wrlen;
+
+    if (vm4ip[1] <= 1) {
+        if (vm4ip[1] == 1) {
+            wrlen = fstGetVarint32Length(vchg_mem + offs +
+                                         4); /* used to advance and determine wrlen */
+#ifndef FST_REMOVE_DUPLICATE_VC
+            xc->curval_mem[vm4ip[0]] = vchg_mem[offs + 4 + wrlen]; /* checkpoint variable */
+#endif
+            while (offs) {
+                unsigned char val;
+                uint32_t time_delta, rcv;
+                next_offs = fstGetUint32(vchg_mem + offs);
+                offs += 4;
+
+                time_delta = fstGetVarint32(vchg_mem + offs, (int *)&wrlen);
+                val = vchg_mem[offs + wrlen];
+                offs = next_offs;
+
+                switch (val) {
+                    case '0':
+                    case '1':
+                        rcv = ((val & 1) << 1) | (time_delta << 2);
+                        break; /* pack more delta bits in for 0/1 vchs */
+
+                    case 'x':
+                    case 'X':
+                        rcv = FST_RCV_X | (time_delta << 4);
+                        break;
+                    case 'z':
+                    case 'Z':
+                        rcv = FST_RCV_Z | (time_delta << 4);
+                        break;
+                    case 'h':
+                    case 'H':
+                        rcv = FST_RCV_H | (time_delta << 4);
+                        break;
+                    case 'u':
+                    case 'U':
+                        rcv = FST_RCV_U | (time_delta << 4);
+                        break;
+                    case 'w':
+                    case 'W':
+                        rcv = FST_RCV_W | (time_delta << 4);
+                        break;
+                    case 'l':
+                    case 'L':
+                        rcv = FST_RCV_L | (time_delta << 4);
+                        break;
+                    default:
+                        rcv = FST_RCV_D | (time_delta << 4);
+                        break;
+                }
+
+                scratchpnt = fstCopyVarint32ToLeft(scratchpnt, rcv);
+            }
+        } else {
+            /* variable length */
+            /* fstGetUint32 (next_offs) + fstGetVarint32 (time_delta) + fstGetVarint32 (len)
+             * + payload */
+            unsigned char *pnt;
+            uint32_t record_len;
+            uint32_t time_delta;
+
+            while (offs) {
+                next_offs = fstGetUint32(vchg_mem + offs);
+                offs += 4;
+                pnt = vchg_mem + offs;
+                offs = next_offs;
+                time_delta = fstGetVarint32(pnt, (int *)&wrlen);
+                pnt += wrlen;
+                record_len = fstGetVarint32(pnt, (int *)&wrlen);
+                pnt += wrlen;
+
+                scratchpnt -= record_len;
+                memcpy(scratchpnt, pnt, record_len);
+
+                scratchpnt = fstCopyVarint32ToLeft(scratchpnt, record_len);
+                scratchpnt = fstCopyVarint32ToLeft(
+                    scratchpnt,
+                    (time_delta << 1)); /* reserve | 1 case for future expansion */
+            }
+        }
+    } else {
+        wrlen = fstGetVarint32Length(vchg_mem + offs +
+                                     4); /* used to advance and determine wrlen */
+#ifndef FST_REMOVE_DUPLICATE_VC
+        memcpy(xc->curval_mem + vm4ip[0],
+               vchg_mem + offs + 4 + wrlen,
+               vm4ip[1]); /* checkpoint variable */
+#endif
+        while (offs) {
+            unsigned int idx;
+            char is_binary = 1;
+            unsigned char *pnt;
+            uint32_t time_delta;
+
+            next_offs = fstGetUint32(vchg_mem + offs);
+            offs += 4;
+
+            time_delta = fstGetVarint32(vchg_mem + offs, (int *)&wrlen);
+
+            pnt = vchg_mem + offs + wrlen;
+            offs = next_offs;
+
+            for (idx = 0; idx < vm4ip[1]; idx++) {
+                if ((pnt[idx] == '0') || (pnt[idx] == '1')) {
+                    continue;
+                } else {
+                    is_binary = 0;
+                    break;
+                }
+            }
+
+            if (is_binary) {
+                unsigned char acc = 0;
+                /* new algorithm */
+                idx = ((vm4ip[1] + 7) & ~7);
+                switch (vm4ip[1] & 7) {
+                    case 0:
+                        do {
+                            acc = (pnt[idx + 7 - 8] & 1) << 0; /* fallthrough */
+                            case 7:
+                                acc |= (pnt[idx + 6 - 8] & 1) << 1; /* fallthrough */
+                            case 6:
+                                acc |= (pnt[idx + 5 - 8] & 1) << 2; /* fallthrough */
+                            case 5:
+                                acc |= (pnt[idx + 4 - 8] & 1) << 3; /* fallthrough */
+                            case 4:
+                                acc |= (pnt[idx + 3 - 8] & 1) << 4; /* fallthrough */
+                            case 3:
+                                acc |= (pnt[idx + 2 - 8] & 1) << 5; /* fallthrough */
+                            case 2:
+                                acc |= (pnt[idx + 1 - 8] & 1) << 6; /* fallthrough */
+                            case 1:
+                                acc |= (pnt[idx + 0 - 8] & 1) << 7;
+                                *(--scratchpnt) = acc;
+                                idx -= 8;
+                        } while (idx);
+                }
+
+                scratchpnt = fstCopyVarint32ToLeft(scratchpnt, (time_delta << 1));
+            } else {
+                scratchpnt -= vm4ip[1];
+                memcpy(scratchpnt, pnt, vm4ip[1]);
+
+                scratchpnt = fstCopyVarint32ToLeft(scratchpnt, (time_delta << 1) | 1);
+            }
+        }
+    }
+
+    return (scratchpnt);
+}
+
+/*
+ * compress an encoded value change chain, returns the payload to write and sets
+ * *hdr to the varint preceding it (uncompressed length, or zero if stored as is)
+ */
+static unsigned char *fstWriterPackChain(fstWriterContext *xc,
+                                         unsigned char *scratchpnt,
+                                         unsigned int wrlen,
+                                         unsigned char **packmem,
+                                         unsigned int *packmemlen,
+                                         unsigned int *hdr,
+                                         unsigned int *paylen)
+{
+    *hdr = 0;
+    *paylen = wrlen;
+
+    if (wrlen > 32) {
+        unsigned long destlen = wrlen;
+        unsigned char *dmem;
+        unsigned int rc;
+
+        if (!xc->fastpack) {
+            if (wrlen <= *packmemlen) {
+                dmem = *packmem;
+            } else {
+                free(*packmem);
+                dmem = *packmem = (unsigned char *)malloc(compressBound(*packmemlen = wrlen));
+            }
+
+            rc = compress2(dmem, &destlen, scratchpnt, wrlen, 4);
+            if (rc == Z_OK) {
+                *hdr = wrlen;
+                *paylen = destlen;
+                return (dmem);
+            }
+        } else {
+            /* this is extremely conservative: fastlz needs +5% for worst case, lz4 needs
+             * siz+(siz/255)+16 */
+            if (((wrlen * 2) + 2) <= *packmemlen) {
+                dmem = *packmem;
+            } else {
+                free(*packmem);
+                dmem = *packmem = (unsigned char *)malloc(*packmemlen = (wrlen * 2) + 2);
+            }
+
+            rc = (xc->fourpack) ? LZ4_compress_default((char *)scratchpnt,
+                                                       (char *)dmem,
+                                                       wrlen,
+                                                       *packmemlen)
+                                : fastlz_compress(scratchpnt, wrlen, dmem);
+            if (rc < destlen) {
+                *hdr = wrlen;
+                *paylen = rc;
+                return (dmem);
+            }
+        }
+    }
+
+    return (scratchpnt);
+}
+
+#ifdef FST_WRITER_PARALLEL
+/*
+ * value change chains can be encoded and compressed by a pool of threads
+ * (see fstWriterSetCompressThreads), the results are then written in handle order
+ */
+struct fstWriterPackedChain
+{
+    uint32_t offs; /* offset of payload in out_mem of the job that packed it */
+    unsigned int wrlen; /* encoded (uncompressed) length */
+    unsigned int hdr; /* varint to precede payload */
+    unsigned int paylen; /* payload length */
+};
+
+struct fstWriterPackJob
+{
+    fstWriterContext *xc;
+    const uint32_t *handles; /* handles with value changes, ascending */
+    struct fstWriterPackedChain *packed; /* results, indexed as handles */
+    unsigned int num_handles;
+    unsigned int first; /* this job packs handles[first], handles[first + stride], ... */
+    unsigned int stride;
+    unsigned char *out_mem; /* payloads packed by this job */
+    uint32_t out_siz;
+    uint32_t out_alloc_siz;
+};
+
+static void *fstWriterPackChainsWorker(void *ctx)
+{
+    struct fstWriterPackJob *job = (struct fstWriterPackJob *)ctx;
+    fstWriterContext *xc = job->xc;
+    unsigned char *scratchpad = (unsigned char *)malloc(xc->vchg_siz);
+    unsigned int packmemlen = 1024;
+    unsigned char *packmem = (unsigned char *)malloc(packmemlen);
+    unsigned int idx;
+
+    for (idx = job->first; idx < job->num_handles; idx += job->stride) {
+        struct fstWriterPackedChain *pc = &(job->packed[idx]);
+        uint32_t *vm4ip = &(xc->valpos_mem[4 * job->handles[idx]]);
+        unsigned char *scratchpnt = fstWriterEncodeChain(xc, vm4ip, scratchpad + xc->vchg_siz);
+        unsigned char *payload;
+
+        pc->wrlen = scratchpad + xc->vchg_siz - scratchpnt;
+        payload = fstWriterPackChain(xc,
+                                     scratchpnt,
+                                     pc->wrlen,
+                                     &packmem,
+                                     &packmemlen,
+                                     &pc->hdr,
+                                     &pc->paylen);
+
+        if ((job->out_siz + pc->paylen) > job->out_alloc_siz) {
+            job->out_alloc_siz = (job->out_siz + pc->paylen) * 2;
+            job->out_mem = (unsigned char *)realloc(job->out_mem, job->out_alloc_siz);
+            if (!job->out_mem) {
+                fprintf(stderr,
+                        FST_APIMESS
+                        "Could not realloc() in fstWriterPackChainsWorker, exiting.\n");
+                exit(255);
+            }
+        }
+        memcpy(job->out_mem + job->out_siz, payload, pc->paylen);
+        pc->offs = job->out_siz;
+        job->out_siz += pc->paylen;
+    }
+
+    free(packmem);
+    free(scratchpad);
+    return (NULL);
+}
+
+/*
+ * encode and compress all value change chains on xc->compress_threads threads,
+ * returns the jobs holding the results, or NULL if not packing in parallel
+ */
+static struct fstWriterPackJob *fstWriterPackChainsParallel(fstWriterContext *xc,
+                                                            unsigned int *num_jobs)
+{
+    struct fstWriterPackJob *jobs;
+    struct fstWriterPackedChain *packed;
+    pthread_t *threads;
+    char *started;
+    uint32_t *handles;
+    unsigned int num_handles = 0;
+    unsigned int nthreads;
+    unsigned int i;
+
+    *num_jobs = 0;
+    if (xc->compress_threads <= 1) {
+        return (NULL);
+    }
+
+    handles = (uint32_t *)malloc((xc->maxhandle ? xc->maxhandle : 1) * sizeof(uint32_t));
+    for (i = 0; i < xc->maxhandle; i++) {
+        if (xc->valpos_mem[4 * i + 2]) {
+            handles[num_handles++] = i;
+        }
+    }
+
+    nthreads = (xc->compress_threads < num_handles) ? xc->compress_threads : num_handles;
+    if (nthreads <= 1) { /* not worth it */
+        free(handles);
+        return (NULL);
+    }
+
+    packed = (struct fstWriterPackedChain *)malloc(num_handles *
+                                                   sizeof(struct fstWriterPackedChain));
+    jobs = (struct fstWriterPackJob *)calloc(nthreads, sizeof(struct fstWriterPackJob));
+    threads = (pthread_t *)malloc(nthreads * sizeof(pthread_t));
+    started = (char *)calloc(nthreads, sizeof(char));
+    for (i = 0; i < nthreads; i++) {
+        jobs[i].xc = xc;
+        jobs[i].handles = handles;
+        jobs[i].packed = packed;
+        jobs[i].num_handles = num_handles;
+        jobs[i].first = i;
+        jobs[i].stride = nthreads;
+    }
+
+    /* job 0 runs on the calling thread, as does any job whose thread could not start */
+    for (i = 1; i < nthreads; i++) {
+        started[i] = !pthread_create(&threads[i], NULL, fstWriterPackChainsWorker, &jobs[i]);
+    }
+    fstWriterPackChainsWorker(&jobs[0]);
+    for (i = 1; i < nthreads; i++) {
+        if (started[i]) {
+            pthread_join(threads[i], NULL);
+        } else {
+            fstWriterPackChainsWorker(&jobs[i]);
+        }
+    }
+
+    free(started);
+    free(threads);
+    free(handles);
+    jobs[0].handles = NULL; /* freed above */
+    *num_jobs = nthreads;
+    return (jobs);
+}
+
+static void fstWriterPackChainsFree(struct fstWriterPackJob *jobs, unsigned int num_jobs)
+{
+    unsigned int i;
+
+    if (jobs) {
+        for (i = 0; i < num_jobs; i++) {
+            free(jobs[i].out_mem);
+        }
+        free(jobs[0].packed);
+        free(jobs);
+    }
+}
+#endif
+
 /*
  * only to be called directly by fst code...otherwise must
  * be synced up with time changes
@@ -1225,7 +1605,6 @@ static void fstWriterFlushContextPrivate(fstWriterContext *xc)
     int cnt = 0;
 #endif
     unsigned int i;
-    unsigned char *vchg_mem;
     FILE *f;
     fst_off_t fpos, indxpos, endpos;
     uint32_t prevpos;
@@ -1240,6 +1619,9 @@ static void fstWriterFlushContextPrivate(fstWriterContext *xc)
     uint32_t *vm4ip;
 #ifdef FST_WRITER_PARALLEL
     struct fstWriterContext *xc2 = xc->xc_parent;
+    struct fstWriterPackJob *pack_jobs;
+    unsigned int pack_threads = 0;
+    unsigned int k = 0;
 #else
     struct fstWriterContext *xc2 = xc;
 #endif
@@ -1261,8 +1643,6 @@ static void fstWriterFlushContextPrivate(fstWriterContext *xc)
     xc->section_header_only = 0;
     scratchpad = (unsigned char *)malloc(xc->vchg_siz);
 
-    vchg_mem = xc->vchg_mem;
-
     f = xc->handle;
     fstWriterVarint(f, xc->maxhandle); /* emit current number of handles */
     fputc(xc->fourpack ? '4' : (xc->fastpack ? 'F' : 'Z'), f);
@@ -1272,276 +1652,57 @@ static void fstWriterFlushContextPrivate(fstWriterContext *xc)
     packmem =
         (unsigned char *)malloc(packmemlen); /* prevent continual malloc...free every loop iter */
 
+#ifdef FST_WRITER_PARALLEL
+    pack_jobs = fstWriterPackChainsParallel(xc, &pack_threads);
+#endif
+
     for (i = 0; i < xc->maxhandle; i++) {
         vm4ip = &(xc->valpos_mem[4 * i]);
 
         if (vm4ip[2]) {
-            uint32_t offs = vm4ip[2];
-            uint32_t next_offs;
-            unsigned int wrlen;
-
-            vm4ip[2] = fpos;
-
-            scratchpnt = scratchpad + xc->vchg_siz; /* build this buffer backwards */
-            if (vm4ip[1] <= 1) {
-                if (vm4ip[1] == 1) {
-                    wrlen = fstGetVarint32Length(vchg_mem + offs +
-                                                 4); /* used to advance and determine wrlen */
-#ifndef FST_REMOVE_DUPLICATE_VC
-                    xc->curval_mem[vm4ip[0]] = vchg_mem[offs + 4 + wrlen]; /* checkpoint variable */
-#endif
-                    while (offs) {
-                        unsigned char val;
-                        uint32_t time_delta, rcv;
-                        next_offs = fstGetUint32(vchg_mem + offs);
-                        offs += 4;
-
-                        time_delta = fstGetVarint32(vchg_mem + offs, (int *)&wrlen);
-                        val = vchg_mem[offs + wrlen];
-                        offs = next_offs;
-
-                        switch (val) {
-                            case '0':
-                            case '1':
-                                rcv = ((val & 1) << 1) | (time_delta << 2);
-                                break; /* pack more delta bits in for 0/1 vchs */
-
-                            case 'x':
-                            case 'X':
-                                rcv = FST_RCV_X | (time_delta << 4);
-                                break;
-                            case 'z':
-                            case 'Z':
-                                rcv = FST_RCV_Z | (time_delta << 4);
-                                break;
-                            case 'h':
-                            case 'H':
-                                rcv = FST_RCV_H | (time_delta << 4);
-                                break;
-                            case 'u':
-                            case 'U':
-                                rcv = FST_RCV_U | (time_delta << 4);
-                                break;
-                            case 'w':
-                            case 'W':
-                                rcv = FST_RCV_W | (time_delta << 4);
-                                break;
-                            case 'l':
-                            case 'L':
-                                rcv = FST_RCV_L | (time_delta << 4);
-                                break;
-                            default:
-                                rcv = FST_RCV_D | (time_delta << 4);
-                                break;
-                        }
+            unsigned char *payload;
+            unsigned int wrlen, hdr, paylen;
 
-                        scratchpnt = fstCopyVarint32ToLeft(scratchpnt, rcv);
-                    }
-                } else {
-                    /* variable length */
-                    /* fstGetUint32 (next_offs) + fstGetVarint32 (time_delta) + fstGetVarint32 (len)
-                     * + payload */
-                    unsigned char *pnt;
-                    uint32_t record_len;
-                    uint32_t time_delta;
-
-                    while (offs) {
-                        next_offs = fstGetUint32(vchg_mem + offs);
-                        offs += 4;
-                        pnt = vchg_mem + offs;
-                        offs = next_offs;
-                        time_delta = fstGetVarint32(pnt, (int *)&wrlen);
-                        pnt += wrlen;
-                        record_len = fstGetVarint32(pnt, (int *)&wrlen);
-                        pnt += wrlen;
-
-                        scratchpnt -= record_len;
-                        memcpy(scratchpnt, pnt, record_len);
-
-                        scratchpnt = fstCopyVarint32ToLeft(scratchpnt, record_len);
-                        scratchpnt = fstCopyVarint32ToLeft(
-                            scratchpnt,
-                            (time_delta << 1)); /* reserve | 1 case for future expansion */
-                    }
-                }
-            } else {
-                wrlen = fstGetVarint32Length(vchg_mem + offs +
-                                             4); /* used to advance and determine wrlen */
-#ifndef FST_REMOVE_DUPLICATE_VC
-                memcpy(xc->curval_mem + vm4ip[0],
-                       vchg_mem + offs + 4 + wrlen,
-                       vm4ip[1]); /* checkpoint variable */
+#ifdef FST_WRITER_PARALLEL
+            if (pack_jobs) { /* already encoded and compressed by the pack threads */
+                const struct fstWriterPackedChain *pc = &(pack_jobs[0].packed[k]);
+                payload = pack_jobs[k % pack_threads].out_mem + pc->offs;
+                wrlen = pc->wrlen;
+                hdr = pc->hdr;
+                paylen = pc->paylen;
+                k++;
+            } else
 #endif
-                while (offs) {
-                    unsigned int idx;
-                    char is_binary = 1;
-                    unsigned char *pnt;
-                    uint32_t time_delta;
-
-                    next_offs = fstGetUint32(vchg_mem + offs);
-                    offs += 4;
-
-                    time_delta = fstGetVarint32(vchg_mem + offs, (int *)&wrlen);
-
-                    pnt = vchg_mem + offs + wrlen;
-                    offs = next_offs;
-
-                    for (idx = 0; idx < vm4ip[1]; idx++) {
-                        if ((pnt[idx] == '0') || (pnt[idx] == '1')) {
-                            continue;
-                        } else {
-                            is_binary = 0;
-                            break;
-                        }
-                    }
-
-                    if (is_binary) {
-                        unsigned char acc = 0;
-                        /* new algorithm */
-                        idx = ((vm4ip[1] + 7) & ~7);
-                        switch (vm4ip[1] & 7) {
-                            case 0:
-                                do {
-                                    acc = (pnt[idx + 7 - 8] & 1) << 0; /* fallthrough */
-                                    case 7:
-                                        acc |= (pnt[idx + 6 - 8] & 1) << 1; /* fallthrough */
-                                    case 6:
-                                        acc |= (pnt[idx + 5 - 8] & 1) << 2; /* fallthrough */
-                                    case 5:
-                                        acc |= (pnt[idx + 4 - 8] & 1) << 3; /* fallthrough */
-                                    case 4:
-                                        acc |= (pnt[idx + 3 - 8] & 1) << 4; /* fallthrough */
-                                    case 3:
-                                        acc |= (pnt[idx + 2 - 8] & 1) << 5; /* fallthrough */
-                                    case 2:
-                                        acc |= (pnt[idx + 1 - 8] & 1) << 6; /* fallthrough */
-                                    case 1:
-                                        acc |= (pnt[idx + 0 - 8] & 1) << 7;
-                                        *(--scratchpnt) = acc;
-                                        idx -= 8;
-                                } while (idx);
-                        }
-
-                        scratchpnt = fstCopyVarint32ToLeft(scratchpnt, (time_delta << 1));
-                    } else {
-                        scratchpnt -= vm4ip[1];
-                        memcpy(scratchpnt, pnt, vm4ip[1]);
-
-                        scratchpnt = fstCopyVarint32ToLeft(scratchpnt, (time_delta << 1) | 1);
-                    }
-                }
+            {
+                scratchpnt = fstWriterEncodeChain(xc, vm4ip, scratchpad + xc->vchg_siz);
+                wrlen = scratchpad + xc->vchg_siz - scratchpnt;
+                payload = fstWriterPackChain(xc,
+                                             scratchpnt,
+                                             wrlen,
+                                             &packmem,
+                                             &packmemlen,
+                                             &hdr,
+                                             &paylen);
             }
 
-            wrlen = scratchpad + xc->vchg_siz - scratchpnt;
+            vm4ip[2] = fpos;
             unc_memreq += wrlen;
-            if (wrlen > 32) {
-                unsigned long destlen = wrlen;
-                unsigned char *dmem;
-                unsigned int rc;
-
-                if (!xc->fastpack) {
-                    if (wrlen <= packmemlen) {
-                        dmem = packmem;
-                    } else {
-                        free(packmem);
-                        dmem = packmem = (unsigned char *)malloc(compressBound(packmemlen = wrlen));
-                    }
-
-                    rc = compress2(dmem, &destlen, scratchpnt, wrlen, 4);
-                    if (rc == Z_OK) {
-#ifndef FST_DYNAMIC_ALIAS_DISABLE
-                        PPvoid_t pv = JenkinsIns(&PJHSArray, dmem, destlen, hashmask);
-                        if (*pv) {
-                            uint32_t pvi = (intptr_t)(*pv);
-                            vm4ip[2] = -pvi;
-                        } else {
-                            *pv = (void *)(intptr_t)(i + 1);
-#endif
-                            fpos += fstWriterVarint(f, wrlen);
-                            fpos += destlen;
-                            fstFwrite(dmem, destlen, 1, f);
-#ifndef FST_DYNAMIC_ALIAS_DISABLE
-                        }
-#endif
-                    } else {
-#ifndef FST_DYNAMIC_ALIAS_DISABLE
-                        PPvoid_t pv = JenkinsIns(&PJHSArray, scratchpnt, wrlen, hashmask);
-                        if (*pv) {
-                            uint32_t pvi = (intptr_t)(*pv);
-                            vm4ip[2] = -pvi;
-                        } else {
-                            *pv = (void *)(intptr_t)(i + 1);
-#endif
-                            fpos += fstWriterVarint(f, 0);
-                            fpos += wrlen;
-                            fstFwrite(scratchpnt, wrlen, 1, f);
-#ifndef FST_DYNAMIC_ALIAS_DISABLE
-                        }
-#endif
-                    }
-                } else {
-                    /* this is extremely conservative: fastlz needs +5% for worst case, lz4 needs
-                     * siz+(siz/255)+16 */
-                    if (((wrlen * 2) + 2) <= packmemlen) {
-                        dmem = packmem;
-                    } else {
-                        free(packmem);
-                        dmem = packmem = (unsigned char *)malloc(packmemlen = (wrlen * 2) + 2);
-                    }
-
-                    rc = (xc->fourpack) ? LZ4_compress_default((char *)scratchpnt,
-                                                               (char *)dmem,
-                                                               wrlen,
-                                                               packmemlen)
-                                        : fastlz_compress(scratchpnt, wrlen, dmem);
-                    if (rc < destlen) {
 #ifndef FST_DYNAMIC_ALIAS_DISABLE
-                        PPvoid_t pv = JenkinsIns(&PJHSArray, dmem, rc, hashmask);
-                        if (*pv) {
-                            uint32_t pvi = (intptr_t)(*pv);
-                            vm4ip[2] = -pvi;
-                        } else {
-                            *pv = (void *)(intptr_t)(i + 1);
-#endif
-                            fpos += fstWriterVarint(f, wrlen);
-                            fpos += rc;
-                            fstFwrite(dmem, rc, 1, f);
-#ifndef FST_DYNAMIC_ALIAS_DISABLE
-                        }
-#endif
-                    } else {
-#ifndef FST_DYNAMIC_ALIAS_DISABLE
-                        PPvoid_t pv = JenkinsIns(&PJHSArray, scratchpnt, wrlen, hashmask);
-                        if (*pv) {
-                            uint32_t pvi = (intptr_t)(*pv);
-                            vm4ip[2] = -pvi;
-                        } else {
-                            *pv = (void *)(intptr_t)(i + 1);
-#endif
-                            fpos += fstWriterVarint(f, 0);
-                            fpos += wrlen;
-                            fstFwrite(scratchpnt, wrlen, 1, f);
-#ifndef FST_DYNAMIC_ALIAS_DISABLE
-                        }
-#endif
-                    }
-                }
-            } else {
-#ifndef FST_DYNAMIC_ALIAS_DISABLE
-                PPvoid_t pv = JenkinsIns(&PJHSArray, scratchpnt, wrlen, hashmask);
+            {
+                PPvoid_t pv = JenkinsIns(&PJHSArray, payload, paylen, hashmask);
                 if (*pv) {
                     uint32_t pvi = (intptr_t)(*pv);
                     vm4ip[2] = -pvi;
                 } else {
                     *pv = (void *)(intptr_t)(i + 1);
 #endif
-                    fpos += fstWriterVarint(f, 0);
-                    fpos += wrlen;
-                    fstFwrite(scratchpnt, wrlen, 1, f);
+                    fpos += fstWriterVarint(f, hdr);
+                    fpos += paylen;
+                    fstFwrite(payload, paylen, 1, f);
 #ifndef FST_DYNAMIC_ALIAS_DISABLE
                 }
-#endif
             }
+#endif
 
             /* vm4ip[3] = 0; ...redundant with clearing below */
 #ifdef FST_DEBUG
@@ -1550,6 +1711,10 @@ static void fstWriterFlushContextPrivate(fstWriterContext *xc)
         }
     }
 
+#ifdef FST_WRITER_PARALLEL
+    fstWriterPackChainsFree(pack_jobs, pack_threads);
+#endif
+
 #ifndef FST_DYNAMIC_ALIAS_DISABLE
     JenkinsFree(&PJHSArray, hashmask);
 #endif
@@ -2457,6 +2622,14 @@ void fstWriterSetRepackOnClose(fstWriterContext *xc, int enable)
     }
 }
 
+void fstWriterSetCompressThreads(fstWriterContext *xc, unsigned int threads)
+{
+    if (xc) {
+        /* only takes effect if FST_WRITER_PARALLEL is enabled */
+        xc->compress_threads = threads;
+    }
+}
+
 void fstWriterSetParallelMode(fstWriterContext *xc, int enable)
 {
     if (xc) {
@@ -3054,6 +3227,108 @@ void fstWriterEmitValueChangeVec64(fstWriterContext *xc,
     }
 }
 
+#ifndef FST_REMOVE_DUPLICATE_VC
+/*
+ * convert a two-state packed value, least significant word first, into one
+ * '0'/'1' character per bit, most significant bit first
+ */
+static void fstWriterPackedToChars(unsigned char *dst, uint32_t bits, const uint32_t *val)
+{
+    uint32_t nbytes = bits / 8;
+    uint32_t i;
+    uint32_t k;
+
+    for (i = bits; i > nbytes * 8; --i) { /* leading partial byte */
+        *dst++ = '0' + ((val[(i - 1) / 32] >> ((i - 1) & 31)) & 1);
+    }
+    for (k = nbytes; k > 0; --k) {
+        uint32_t b = (val[(k - 1) / 4] >> (((k - 1) & 3) * 8)) & 0xff;
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+        /* spread the 8 bits into the top bit of each byte, most significant bit lowest */
+        uint64_t v = (((uint64_t)b * 0x8040201008040201ULL) & 0x8080808080808080ULL) >> 7;
+        v |= 0x3030303030303030ULL;
+        memcpy(dst, &v, 8);
+        dst += 8;
+#else
+        for (i = 8; i > 0; --i) {
+            *dst++ = '0' + ((b >> (i - 1)) & 1);
+        }
+#endif
+    }
+}
+#endif
+
+/*
+ * as fstWriterEmitValueChangeVec32, but converts the value straight into the
+ * value change buffer, without an intermediate string
+ */
+void fstWriterEmitValueChangePacked32(fstWriterContext *xc,
+                                      fstHandle handle,
+                                      uint32_t bits,
+                                      const uint32_t *val)
+{
+#ifdef FST_REMOVE_DUPLICATE_VC
+    fstWriterEmitValueChangeVec32(xc, handle, bits, val);
+#else
+    if (FST_LIKELY((xc) && (handle <= xc->maxhandle))) {
+        uint32_t fpos;
+        uint32_t *vm4ip;
+        uint32_t len;
+
+        if (FST_UNLIKELY(!xc->valpos_mem)) {
+            xc->vc_emitted = 1;
+            fstWriterCreateMmaps(xc);
+        }
+
+        handle--; /* move starting at 1 index to starting at 0 */
+        vm4ip = &(xc->valpos_mem[4 * handle]);
+
+        len = vm4ip[1];
+        if (FST_UNLIKELY(len != bits)) /* variable length, or not declared with this width */
+        {
+            if (len)
+                fstWriterEmitValueChangeVec32(xc, handle + 1, bits, val);
+            return;
+        }
+
+        if (FST_LIKELY(!xc->is_initial_time)) {
+            unsigned char *pnt;
+            uint32_t v;
+            uint32_t nxt;
+
+            fpos = xc->vchg_siz;
+
+            if (FST_UNLIKELY((fpos + len + 10) > xc->vchg_alloc_siz)) {
+                xc->vchg_alloc_siz += (xc->fst_break_add_size + len);
+                xc->vchg_mem = (unsigned char *)realloc(xc->vchg_mem, xc->vchg_alloc_siz);
+                if (FST_UNLIKELY(!xc->vchg_mem)) {
+                    fprintf(stderr,
+                            FST_APIMESS
+                            "Could not realloc() in fstWriterEmitValueChangePacked32, exiting.\n");
+                    exit(255);
+                }
+            }
+            /* same record as fstWriterUint32WithVarint32 */
+            pnt = xc->vchg_mem + fpos;
+            memcpy(pnt, &vm4ip[2], sizeof(uint32_t));
+            pnt += 4;
+            v = xc->tchn_idx - vm4ip[3];
+            while ((nxt = v >> 7)) {
+                *(pnt++) = ((unsigned char)v) | 0x80;
+                v = nxt;
+            }
+            *(pnt++) = (unsigned char)v;
+            fstWriterPackedToChars(pnt, bits, val);
+            xc->vchg_siz = (pnt - xc->vchg_mem) + len;
+            vm4ip[3] = xc->tchn_idx;
+            vm4ip[2] = fpos;
+        } else {
+            fstWriterPackedToChars(xc->curval_mem + vm4ip[0], bits, val);
+        }
+    }
+#endif
+}
+
 void fstWriterEmitVariableLengthValueChange(fstWriterContext *xc,
                                             fstHandle handle,
                                             const void *val,
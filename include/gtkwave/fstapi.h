@@ -419,6 +419,10 @@ void fstWriterEmitValueChangeVec64(fstWriterContext *ctx,
                                     fstHandle handle,
                                     uint32_t bits,
                                     const uint64_t *val);
+void fstWriterEmitValueChangePacked32(fstWriterContext *ctx,
+                                      fstHandle handle,
+                                      uint32_t bits,
+                                      const uint32_t *val);
 void fstWriterEmitVariableLengthValueChange(fstWriterContext *ctx,
                                             fstHandle handle,
                                             const void *val,
@@ -435,6 +439,7 @@ void fstWriterSetAttrBegin(fstWriterContext *ctx,
                             uint64_t arg);
 void fstWriterSetAttrEnd(fstWriterContext *ctx);
 void fstWriterSetComment(fstWriterContext *ctx, const char *comm);
+void fstWriterSetCompressThreads(fstWriterContext *ctx, unsigned int threads);
 void fstWriterSetDate(fstWriterContext *ctx, const char *dat);
 void fstWriterSetDumpSizeLimit(fstWriterContext *ctx, uint64_t numbytes);
 void fstWriterSetEnvVar(fstWriterContext *ctx, const char *envvar);
@@ -77,6 +77,12 @@
 # include <sys/resource.h>
 # define _VL_HAVE_GETRLIMIT
 #endif
+#if !defined(_WIN32) && !defined(__MINGW32__)
+# include <fcntl.h>
+# include <sys/mman.h>
+# include <unistd.h>
+# define _VL_HAVE_MMAP
+#endif
 
 #include "verilated_threads.h"
 // clang-format on
@@ -121,6 +127,7 @@ thread_local Verilated::ThreadLocal Verilated::t_s;
 void vl_finish(const char* filename, int linenum, const char* hier) VL_MT_UNSAFE {
     // hier is unused in the default implementation.
     (void)hier;
+    Verilated::threadContextp()->impp()->asyncOutputDrain();
     VL_PRINTF(  // Not VL_PRINTF_MT, already on main thread
         "- %s:%d: Verilog $finish\n", filename, linenum);
     Verilated::threadContextp()->gotFinish(true);
@@ -131,6 +138,7 @@ void vl_finish(const char* filename, int linenum, const char* hier) VL_MT_UNSAFE
 void vl_stop(const char* filename, int linenum, const char* hier) VL_MT_UNSAFE {
     // $stop or $fatal reporting; would break current API to add param as to which
     const char* const msg = "Verilog $stop";
+    Verilated::threadContextp()->impp()->asyncOutputDrain();
     Verilated::threadContextp()->gotError(true);
     Verilated::threadContextp()->gotFinish(true);
     if (Verilated::threadContextp()->fatalOnError()) {
@@ -151,6 +159,7 @@ void vl_stop(const char* filename, int linenum, const char* hier) VL_MT_UNSAFE {
 void vl_fatal(const char* filename, int linenum, const char* hier, const char* msg) VL_MT_UNSAFE {
     // hier is unused in the default implementation.
     (void)hier;
+    Verilated::threadContextp()->impp()->asyncOutputDrain();
     Verilated::threadContextp()->gotError(true);
     Verilated::threadContextp()->gotFinish(true);
     if (filename && filename[0]) {
@@ -180,6 +189,7 @@ void vl_stop_maybe(const char* filename, int linenum, const char* hier, bool may
         && Verilated::threadContextp()->errorCount() < Verilated::threadContextp()->errorLimit()) {
         // Do just once when cross error limit
         if (Verilated::threadContextp()->errorCount() == 1) {
+            Verilated::threadContextp()->impp()->asyncOutputDrain();
             VL_PRINTF(  // Not VL_PRINTF_MT, already on main thread
                 "-Info: %s:%d: %s\n", filename, linenum,
                 "Verilog $stop, ignored due to +verilator+error+limit");
@@ -194,6 +204,7 @@ void vl_stop_maybe(const char* filename, int linenum, const char* hier, bool may
 void vl_warn(const char* filename, int linenum, const char* hier, const char* msg) VL_MT_UNSAFE {
     // hier is unused in the default implementation.
     (void)hier;
+    Verilated::threadContextp()->impp()->asyncOutputDrain();
     if (filename && filename[0]) {
         // Not VL_PRINTF_MT, already on main thread
         VL_PRINTF("%%Warning: %s:%d: %s\n", filename, linenum, msg);
@@ -207,28 +218,42 @@ void vl_warn(const char* filename, int linenum, const char* hier, const char* ms
 //===========================================================================
 // Wrapper to call certain functions via messages when multithreaded
 
+void VerilatedMsg::run() const {
+    switch (m_kind) {
+    case Kind::FINISH: vl_finish(m_filename, m_linenum, m_hier); break;
+    case Kind::STOP: vl_stop_maybe(m_filename, m_linenum, m_hier, m_maybe); break;
+    case Kind::FATAL: vl_fatal(m_filename, m_linenum, m_hier, m_msgp); break;
+    case Kind::WARN: vl_warn(m_filename, m_linenum, m_hier, m_msgp); break;
+    case Kind::PRINT: {
+        VerilatedAsyncOutput* const asyncp = Verilated::threadContextp()->impp()->asyncOutputp();
+        if (asyncp) {
+            asyncp->post(0, m_text);
+        } else {
+            VL_PRINTF("%s", m_text.c_str());
+        }
+        break;
+    }
+    }
+}
+
 void VL_FINISH_MT(const char* filename, int linenum, const char* hier) VL_MT_SAFE {
-    VerilatedThreadMsgQueue::post(VerilatedMsg{[=]() {  //
-        vl_finish(filename, linenum, hier);
-    }});
+    VerilatedThreadMsgQueue::post(
+        VerilatedMsg{VerilatedMsg::Kind::FINISH, filename, linenum, hier});
 }
 
 void VL_STOP_MT(const char* filename, int linenum, const char* hier, bool maybe) VL_MT_SAFE {
-    VerilatedThreadMsgQueue::post(VerilatedMsg{[=]() {  //
-        vl_stop_maybe(filename, linenum, hier, maybe);
-    }});
+    VerilatedThreadMsgQueue::post(
+        VerilatedMsg{VerilatedMsg::Kind::STOP, filename, linenum, hier, nullptr, maybe});
 }
 
 void VL_FATAL_MT(const char* filename, int linenum, const char* hier, const char* msg) VL_MT_SAFE {
-    VerilatedThreadMsgQueue::post(VerilatedMsg{[=]() {  //
-        vl_fatal(filename, linenum, hier, msg);
-    }});
+    VerilatedThreadMsgQueue::post(
+        VerilatedMsg{VerilatedMsg::Kind::FATAL, filename, linenum, hier, msg});
 }
 
 void VL_WARN_MT(const char* filename, int linenum, const char* hier, const char* msg) VL_MT_SAFE {
-    VerilatedThreadMsgQueue::post(VerilatedMsg{[=]() {  //
-        vl_warn(filename, linenum, hier, msg);
-    }});
+    VerilatedThreadMsgQueue::post(
+        VerilatedMsg{VerilatedMsg::Kind::WARN, filename, linenum, hier, msg});
 }
 
 //===========================================================================
@@ -282,11 +307,122 @@ void VL_DBG_MSGF(const char* formatp, ...) VL_MT_SAFE {
 void VL_PRINTF_MT(const char* formatp, ...) VL_MT_SAFE {
     va_list ap;
     va_start(ap, formatp);
-    const std::string result = _vl_string_vprintf(formatp, ap);
+    std::string result = _vl_string_vprintf(formatp, ap);
     va_end(ap);
-    VerilatedThreadMsgQueue::post(VerilatedMsg{[=]() {  //
-        VL_PRINTF("%s", result.c_str());
-    }});
+    VerilatedThreadMsgQueue::post(VerilatedMsg{std::move(result)});
+}
+
+//===========================================================================
+// VerilatedAsyncOutput:: Methods
+
+void VerilatedAsyncOutput::post(IData fdi, const std::string& text) VL_MT_SAFE_EXCLUDES(m_mutex) {
+    VerilatedLockGuard lock{m_mutex};
+    m_cv.wait(m_mutex, [&]() VL_REQUIRES(m_mutex) { return m_count < m_ring.size(); });
+    Record& record = m_ring[(m_head + m_count) % m_ring.size()];
+    record.m_fdi = fdi;
+    record.m_text.assign(text);  // No allocation once grown
+    if (!m_count++) m_cv.notify_all();
+}
+
+void VerilatedAsyncOutput::drain() VL_MT_SAFE_EXCLUDES(m_mutex) {
+    VerilatedLockGuard lock{m_mutex};
+    m_cv.wait(m_mutex, [&]() VL_REQUIRES(m_mutex) { return m_count == 0 || !m_threadp; });
+}
+
+void VerilatedAsyncOutput::start() VL_MT_SAFE_EXCLUDES(m_mutex) {
+    const VerilatedLockGuard lock{m_mutex};
+    m_exit = false;
+    m_threadp.reset(new std::thread{[this]() { writerMain(); }});
+}
+
+void VerilatedAsyncOutput::stop() VL_MT_SAFE_EXCLUDES(m_mutex) {
+    {
+        const VerilatedLockGuard lock{m_mutex};
+        if (!m_threadp) return;
+        m_exit = true;
+        m_cv.notify_all();
+    }
+    // The writer drains the ring before exiting
+    m_threadp->join();
+    const VerilatedLockGuard lock{m_mutex};
+    m_threadp.reset();
+    m_cv.notify_all();
+}
+
+void VerilatedAsyncOutput::writerMain() VL_MT_SAFE_EXCLUDES(m_mutex) {
+    VerilatedLockGuard lock{m_mutex};
+    while (true) {
+        m_cv.wait(m_mutex, [&]() VL_REQUIRES(m_mutex) { return m_count || m_exit; });
+        if (!m_count) break;  // Exit when drained
+        // Producers never touch records being written, so write outside the lock
+        Record& record = m_ring[m_head];
+        m_mutex.unlock();
+        if (record.m_fdi) {
+            m_contextp->impp()->fdWriteNow(record.m_fdi, record.m_text);
+        } else {
+            VL_PRINTF("%s", record.m_text.c_str());
+        }
+        m_mutex.lock();
+        m_head = (m_head + 1) % m_ring.size();
+        --m_count;
+        m_cv.notify_all();
+    }
+    std::fflush(stdout);
+}
+
+//===========================================================================
+// Huge page allocation, for --huge-pages
+
+// Size of a transparent huge page on common hosts
+static constexpr size_t VL_HUGE_PAGE_BYTES = 2 * 1024 * 1024;
+
+static size_t vl_huge_map_size(size_t size) VL_PURE {
+    const size_t align = size >= VL_HUGE_PAGE_BYTES ? VL_HUGE_PAGE_BYTES : 4096;
+    return (size + align - 1) & ~(align - 1);
+}
+
+void* VL_HUGE_ALLOC(size_t size) VL_MT_SAFE {
+#ifdef _VL_HAVE_MMAP
+    const size_t mapSize = vl_huge_map_size(size);
+    if (size < VL_HUGE_PAGE_BYTES) {
+        void* const p = ::mmap(nullptr, mapSize, PROT_READ | PROT_WRITE,
+                               MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (VL_UNLIKELY(p == MAP_FAILED)) throw std::bad_alloc{};
+        return p;
+    }
+#ifdef MAP_HUGETLB
+    // Reserved huge pages, if the system has any configured
+    void* const hugep = ::mmap(nullptr, mapSize, PROT_READ | PROT_WRITE,
+                               MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (hugep != MAP_FAILED) return hugep;
+#endif
+    // Else transparent huge pages, which need a huge page aligned mapping;
+    // over-allocate, then trim the unaligned ends
+    char* const rawp = static_cast<char*>(::mmap(nullptr, mapSize + VL_HUGE_PAGE_BYTES,
+                                                 PROT_READ | PROT_WRITE,
+                                                 MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+    if (VL_UNLIKELY(rawp == MAP_FAILED)) throw std::bad_alloc{};
+    const uintptr_t raw = reinterpret_cast<uintptr_t>(rawp);
+    const uintptr_t aligned = (raw + VL_HUGE_PAGE_BYTES - 1) & ~(VL_HUGE_PAGE_BYTES - 1);
+    char* const alignedp = rawp + (aligned - raw);
+    if (aligned != raw) ::munmap(rawp, aligned - raw);
+    const size_t tail = VL_HUGE_PAGE_BYTES - (aligned - raw);
+    if (tail) ::munmap(alignedp + mapSize, tail);
+#ifdef MADV_HUGEPAGE
+    ::madvise(alignedp, mapSize, MADV_HUGEPAGE);
+#endif
+    return alignedp;
+#else
+    return ::operator new(size);
+#endif
+}
+
+void VL_HUGE_FREE(void* ptr, size_t size) VL_MT_SAFE {
+#ifdef _VL_HAVE_MMAP
+    if (ptr) ::munmap(ptr, vl_huge_map_size(size));
+#else
+    ::operator delete(ptr);
+#endif
 }
 
 //===========================================================================
@@ -297,28 +433,11 @@ VlRNG::VlRNG() VL_MT_SAFE {
     VlRNG& fromr = vl_thread_rng();
     m_state = fromr.m_state;
     // Advance the *source* so it can later generate a new number
-    // Xoroshiro128+ algorithm
-    fromr.m_state[1] ^= fromr.m_state[0];
-    fromr.m_state[0] = (((fromr.m_state[0] << 55) | (fromr.m_state[0] >> 9)) ^ fromr.m_state[1]
-                        ^ (fromr.m_state[1] << 14));
-    fromr.m_state[1] = (fromr.m_state[1] << 36) | (fromr.m_state[1] >> 28);
-}
-uint64_t VlRNG::rand64() VL_MT_UNSAFE {
-    // Xoroshiro128+ algorithm
-    const uint64_t result = m_state[0] + m_state[1];
-    m_state[1] ^= m_state[0];
-    m_state[0] = (((m_state[0] << 55) | (m_state[0] >> 9)) ^ m_state[1] ^ (m_state[1] << 14));
-    m_state[1] = (m_state[1] << 36) | (m_state[1] >> 28);
-    return result;
+    next(fromr.m_state[0], fromr.m_state[1]);
 }
 uint64_t VlRNG::vl_thread_rng_rand64() VL_MT_SAFE {
     VlRNG& fromr = vl_thread_rng();
-    const uint64_t result = fromr.m_state[0] + fromr.m_state[1];
-    fromr.m_state[1] ^= fromr.m_state[0];
-    fromr.m_state[0] = (((fromr.m_state[0] << 55) | (fromr.m_state[0] >> 9)) ^ fromr.m_state[1]
-                        ^ (fromr.m_state[1] << 14));
-    fromr.m_state[1] = (fromr.m_state[1] << 36) | (fromr.m_state[1] >> 28);
-    return result;
+    return next(fromr.m_state[0], fromr.m_state[1]);
 }
 void VlRNG::srandom(uint64_t n) VL_MT_UNSAFE {
     m_state[0] = n;
@@ -367,13 +486,16 @@ static uint32_t vl_sys_rand32() VL_MT_SAFE {
 VlRNG& VlRNG::vl_thread_rng() VL_MT_SAFE {
     static thread_local VlRNG t_rng{0};
     static thread_local uint32_t t_seedEpoch = 0;
-    // For speed, we use a thread-local epoch number to know when to reseed
-    // A thread always belongs to a single context, so this works out ok
-    if (VL_UNLIKELY(t_seedEpoch != VerilatedContextImp::randSeedEpoch())) {
+    // For speed, we use a thread-local epoch number to know when to reseed.
+    // Epochs are unique across contexts, so a thread moving to another
+    // context reseeds, but reseeding another context does not disturb it.
+    const VerilatedContextImp* const contextp = Verilated::threadContextp()->impp();
+    const uint32_t epoch = contextp->randSeedEpoch();
+    if (VL_UNLIKELY(t_seedEpoch != epoch)) {
         // Set epoch before state, to avoid race case with new seeding
-        t_seedEpoch = VerilatedContextImp::randSeedEpoch();
+        t_seedEpoch = epoch;
         // Same as srandom() but here as needs to be VL_MT_SAFE
-        t_rng.m_state[0] = Verilated::threadContextp()->impp()->randSeedDefault64();
+        t_rng.m_state[0] = contextp->randSeedDefault64();
         t_rng.m_state[1] = t_rng.m_state[0];
         // Fix state as algorithm is slow to randomize if many zeros
         // This causes a loss of ~ 1 bit of seed entropy, no big deal
@@ -384,13 +506,13 @@ VlRNG& VlRNG::vl_thread_rng() VL_MT_SAFE {
 }
 
 WDataOutP VL_RANDOM_W(int obits, WDataOutP outwp) VL_MT_SAFE {
-    for (int i = 0; i < VL_WORDS_I(obits); ++i) outwp[i] = vl_rand64();
+    VlRNG::vl_thread_rng_fill(outwp, VL_WORDS_I(obits));
     // Last word is unclean
     return outwp;
 }
 
 WDataOutP VL_RANDOM_RNG_W(VlRNG& rngr, int obits, WDataOutP outwp) VL_MT_UNSAFE {
-    for (int i = 0; i < VL_WORDS_I(obits); ++i) outwp[i] = rngr.rand64();
+    rngr.fill(outwp, VL_WORDS_I(obits));
     // Last word is unclean
     return outwp;
 }
@@ -433,8 +555,8 @@ WDataOutP VL_SCOPED_RAND_RESET_W(int obits, WDataOutP outwp, uint64_t scopeHash,
                                  uint64_t salt) VL_MT_UNSAFE {
     if (Verilated::threadContextp()->randReset() != 2) { return VL_RAND_RESET_W(obits, outwp); }
     VlRNG rng{Verilated::threadContextp()->randSeed() ^ scopeHash ^ salt};
-    for (int i = 0; i < VL_WORDS_I(obits) - 1; ++i) outwp[i] = rng.rand64();
-    outwp[VL_WORDS_I(obits) - 1] = rng.rand64() & VL_MASK_E(obits);
+    rng.fill(outwp, VL_WORDS_I(obits));
+    outwp[VL_WORDS_I(obits) - 1] &= VL_MASK_E(obits);
     return outwp;
 }
 
@@ -453,8 +575,8 @@ QData VL_SCOPED_RAND_RESET_ASSIGN_Q(int obits, uint64_t scopeHash, uint64_t salt
 WDataOutP VL_SCOPED_RAND_RESET_ASSIGN_W(int obits, WDataOutP outwp, uint64_t scopeHash,
                                         uint64_t salt) VL_MT_UNSAFE {
     VlRNG rng{Verilated::threadContextp()->randSeed() ^ scopeHash ^ salt};
-    for (int i = 0; i < VL_WORDS_I(obits) - 1; ++i) outwp[i] = rng.rand64();
-    outwp[VL_WORDS_I(obits) - 1] = rng.rand64() & VL_MASK_E(obits);
+    rng.fill(outwp, VL_WORDS_I(obits));
+    outwp[VL_WORDS_I(obits) - 1] &= VL_MASK_E(obits);
     return outwp;
 }
 
@@ -535,6 +657,43 @@ WDataOutP _vl_moddiv_w(int lbits, WDataOutP owp, const WDataInP lwp, const WData
         return owp;
     }
 
+    // Power of two divisor (not known at compile time): quotient is a shift,
+    // modulus is a mask
+    if (VL_ONEHOT_I(rwp[vw - 1])) {
+        bool pow2 = true;
+        for (int i = 0; i < vw - 1; ++i) pow2 = pow2 && !rwp[i];
+        if (pow2) {
+            const int shift = vmsbp1 - 1;
+            if (!is_modulus) return VL_SHIFTR_WWI(lbits, lbits, 32, owp, lwp, shift);
+            const int mwords = VL_WORDS_I(shift);
+            for (int i = 0; i < mwords; ++i) owp[i] = lwp[i];
+            if (VL_BITBIT_E(shift)) owp[mwords - 1] &= VL_MASK_E(shift);
+            return owp;
+        }
+    }
+
+#ifdef __SIZEOF_INT128__
+    if (vw == 2) {  // Two word divisor, use 128/64 native division per 64-bit dividend chunk
+        const uint64_t v64 = VL_SET_QW(rwp);
+        unsigned __int128 k = 0;
+        for (int c = (uw - 1) / 2; c >= 0; --c) {
+            const uint64_t hi = (2 * c + 1 < uw) ? static_cast<uint64_t>(lwp[2 * c + 1]) : 0;
+            const unsigned __int128 unw128 = (k << 64) | ((hi << 32ULL) | lwp[2 * c]);
+            const uint64_t q = static_cast<uint64_t>(unw128 / v64);
+            k = unw128 - static_cast<unsigned __int128>(q) * v64;
+            if (!is_modulus) {
+                owp[2 * c] = static_cast<EData>(q);
+                if (2 * c + 1 < words) owp[2 * c + 1] = static_cast<EData>(q >> 32ULL);
+            }
+        }
+        if (is_modulus) {
+            owp[0] = static_cast<EData>(k);
+            owp[1] = static_cast<EData>(static_cast<uint64_t>(k) >> 32ULL);
+        }
+        return owp;
+    }
+#endif
+
     // +1 word as we may shift during normalization
     uint32_t un[VL_MULS_MAX_WORDS + 1];  // Fixed size, as MSVC++ doesn't allow [words] here
     uint32_t vn[VL_MULS_MAX_WORDS + 1];  // v normalized
@@ -1694,6 +1853,13 @@ void VL_FWRITEF_NX(IData fpi, const std::string& format, int argc, ...) VL_MT_SA
     Verilated::threadContextp()->impp()->fdWrite(fpi, t_output);
 }
 
+void VL_WRITES_NX(const std::string& output) VL_MT_SAFE { VL_PRINTF_MT("%s", output.c_str()); }
+
+void VL_FWRITES_NX(IData fpi, const std::string& output) VL_MT_SAFE {
+    // While threadsafe, each thread can only access different file handles
+    Verilated::threadContextp()->impp()->fdWrite(fpi, output);
+}
+
 IData VL_FSCANF_INX(IData fpi, const std::string& format, int argc, ...) VL_MT_SAFE {
     // While threadsafe, each thread can only access different file handles
     FILE* const fp = VL_CVT_I_FP(fpi);
@@ -2142,23 +2308,47 @@ VlReadMem::VlReadMem(bool hex, int bits, const std::string& filename, QData star
     , m_filename(filename)  // Need () or GCC 4.8 false warning
     , m_end{end}
     , m_addr{start} {
-    m_fp = std::fopen(filename.c_str(), "r");
-    if (VL_UNLIKELY(!m_fp)) {
+#ifdef _VL_HAVE_MMAP
+    // Large images are memory mapped rather than read through stdio
+    const int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd >= 0) {
+        struct stat st;
+        if (::fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+            void* const mapp = ::mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapp != MAP_FAILED) {
+                ::madvise(mapp, st.st_size, MADV_SEQUENTIAL);
+                m_mapp = mapp;
+                m_mapSize = st.st_size;
+                m_curp = static_cast<const char*>(mapp);
+                m_endp = m_curp + m_mapSize;
+                m_open = true;
+            }
+        }
+        ::close(fd);
+        if (m_open) return;
+    }
+#endif
+    FILE* const fp = std::fopen(filename.c_str(), "rb");
+    if (VL_UNLIKELY(!fp)) {
         // We don't report the Verilog source filename as it slow to have to pass it down
         VL_WARN_MT(filename.c_str(), 0, "", "$readmem file not found");
-        // cppcheck-has-bug-suppress resourceLeak  // m_fp is nullptr
         return;
     }
+    char buf[64 * 1024];
+    while (const std::size_t got = std::fread(buf, 1, sizeof(buf), fp)) m_buffer.append(buf, got);
+    std::fclose(fp);
+    m_curp = m_buffer.data();
+    m_endp = m_curp + m_buffer.size();
+    m_open = true;
 }
 VlReadMem::~VlReadMem() {
-    if (m_fp) {
-        std::fclose(m_fp);
-        m_fp = nullptr;
-    }
+#ifdef _VL_HAVE_MMAP
+    if (m_mapp) ::munmap(m_mapp, m_mapSize);
+#endif
 }
 bool VlReadMem::get(QData& addrr, std::string& valuer) {
-    if (VL_UNLIKELY(!m_fp)) return false;
-    valuer = "";
+    if (VL_UNLIKELY(!m_open)) return false;
+    valuer.clear();
     // Prep for reading
     bool inData = false;
     bool ignoreToEol = false;
@@ -2166,22 +2356,19 @@ bool VlReadMem::get(QData& addrr, std::string& valuer) {
     bool readingAddress = false;
     int lastCh = ' ';
     // Read the data
-    // We process a character at a time, as then we don't need to deal
-    // with changing buffer sizes dynamically, etc.
-    while (true) {
-        int c = std::fgetc(m_fp);
-        if (VL_UNLIKELY(c == EOF)) break;
+    while (m_curp < m_endp) {
+        int c = static_cast<unsigned char>(*m_curp++);
+        // printf("%d: Got '%c' Addr%lx IN%d IgE%d IgC%d\n",
+        //        m_linenum, c, m_addr, inData, ignoreToEol, ignoreToComment);
+        if (c == '_') continue;  // Ignore _ e.g. inside a number
         const bool chIs4StateBin
             = c == '0' || c == '1' || c == 'x' || c == 'X' || c == 'z' || c == 'Z';
         const bool chIs2StateHex = std::isxdigit(c);
-        const bool chIs4StateHex = std::isxdigit(c) || chIs4StateBin;
-        // printf("%d: Got '%c' Addr%lx IN%d IgE%d IgC%d\n",
-        //        m_linenum, c, m_addr, inData, ignoreToEol, ignoreToComment);
+        const bool chIs4StateHex = chIs2StateHex || chIs4StateBin;
         // See if previous data value has completed, and if so return
-        if (c == '_') continue;  // Ignore _ e.g. inside a number
         if (inData && !chIs4StateHex) {
             // printf("Got data @%lx = %s\n", m_addr, valuer.c_str());
-            ungetc(c, m_fp);
+            --m_curp;
             addrr = m_addr;
             ++m_addr;
             return true;
@@ -2219,11 +2406,24 @@ bool VlReadMem::get(QData& addrr, std::string& valuer) {
                             "$readmem address contains 4-state characters");
             } else if (chIs4StateHex) {
                 inData = true;
-                valuer += static_cast<char>(c);
-                if (VL_UNLIKELY(!m_hex && !chIs4StateBin)) {
-                    VL_FATAL_MT(m_filename.c_str(), m_linenum, "",
-                                "$readmemb (binary) file contains hex characters");
+                // Take the whole run of digits at once, rather than per character
+                const char* const startp = m_curp - 1;
+                const char* endp = m_curp;
+                while (endp < m_endp && std::isxdigit(static_cast<unsigned char>(*endp))) {
+                    ++endp;
+                }
+                valuer.append(startp, endp - startp);
+                m_curp = endp;
+                if (VL_UNLIKELY(!m_hex)) {
+                    for (const char* cp = startp; cp < endp; ++cp) {
+                        const char ch = *cp;
+                        if (ch != '0' && ch != '1') {
+                            VL_FATAL_MT(m_filename.c_str(), m_linenum, "",
+                                        "$readmemb (binary) file contains hex characters");
+                        }
+                    }
                 }
+                c = static_cast<unsigned char>(endp[-1]);
             } else {
                 VL_FATAL_MT(m_filename.c_str(), m_linenum, "", "$readmem file syntax error");
             }
@@ -2240,38 +2440,40 @@ bool VlReadMem::get(QData& addrr, std::string& valuer) {
     return inData;  // EOF
 }
 void VlReadMem::setData(void* valuep, const std::string& rhs) {
-    const QData shift = m_hex ? 4ULL : 1ULL;
-    bool innum = false;
-    // Shift value in
-    for (const auto& i : rhs) {
+    if (VL_UNLIKELY(rhs.empty())) return;
+    const int shift = m_hex ? 4 : 1;
+    const auto digitValue = [this](char i) -> IData {
         const char c = std::tolower(i);
-        const int value = (c == 'x' || c == 'z') ? VL_RAND_RESET_I(m_hex ? 4 : 1)
-                          : (c >= 'a')           ? (c - 'a' + 10)
-                                                 : (c - '0');
+        return (c == 'x' || c == 'z') ? VL_RAND_RESET_I(m_hex ? 4 : 1)
+               : (c >= 'a')           ? (c - 'a' + 10)
+                                      : (c - '0');
+    };
+    if (m_bits <= VL_QUADSIZE) {
+        // Shift value in; upper digits beyond the width fall off the top
+        QData data = 0;
+        for (const auto& i : rhs) data = (data << shift) + digitValue(i);
+        data &= VL_MASK_Q(m_bits);
         if (m_bits <= 8) {
-            CData* const datap = reinterpret_cast<CData*>(valuep);
-            if (!innum) *datap = 0;
-            *datap = ((*datap << shift) + value) & VL_MASK_I(m_bits);
+            *reinterpret_cast<CData*>(valuep) = static_cast<CData>(data);
         } else if (m_bits <= 16) {
-            SData* const datap = reinterpret_cast<SData*>(valuep);
-            if (!innum) *datap = 0;
-            *datap = ((*datap << shift) + value) & VL_MASK_I(m_bits);
+            *reinterpret_cast<SData*>(valuep) = static_cast<SData>(data);
         } else if (m_bits <= VL_IDATASIZE) {
-            IData* const datap = reinterpret_cast<IData*>(valuep);
-            if (!innum) *datap = 0;
-            *datap = ((*datap << shift) + value) & VL_MASK_I(m_bits);
-        } else if (m_bits <= VL_QUADSIZE) {
-            QData* const datap = reinterpret_cast<QData*>(valuep);
-            if (!innum) *datap = 0;
-            *datap = ((*datap << static_cast<QData>(shift)) + static_cast<QData>(value))
-                     & VL_MASK_Q(m_bits);
+            *reinterpret_cast<IData*>(valuep) = static_cast<IData>(data);
         } else {
-            WDataOutP datap = reinterpret_cast<WDataOutP>(valuep);
-            if (!innum) VL_ZERO_W(m_bits, datap);
-            _vl_shiftl_inplace_w(m_bits, datap, static_cast<IData>(shift));
-            datap[0] |= value;
+            *reinterpret_cast<QData*>(valuep) = data;
+        }
+    } else {
+        // Place each digit directly at its bit position, rather than shifting
+        // the whole wide value per digit. Digits never straddle a word.
+        WDataOutP datap = reinterpret_cast<WDataOutP>(valuep);
+        VL_ZERO_W(m_bits, datap);
+        int lsb = (static_cast<int>(rhs.size()) - 1) * shift;
+        for (const auto& i : rhs) {
+            const IData value = digitValue(i);
+            if (lsb < m_bits) datap[VL_BITWORD_E(lsb)] |= value << VL_BITBIT_E(lsb);
+            lsb -= shift;
         }
-        innum = true;
+        datap[VL_WORDS_I(m_bits) - 1] &= VL_MASK_E(m_bits);
     }
 }
 
@@ -2579,9 +2781,12 @@ VerilatedContext::VerilatedContext()
     : m_impdatap{new VerilatedContextImpData} {
     Verilated::lastContextp(this);
     Verilated::threadContextp(this);
+    impp()->randSeedEpochNew();
     m_ns.m_coverageFilename = "coverage.dat";
     m_ns.m_profExecFilename = "profile_exec.dat";
     m_ns.m_profVltFilename = "profile.vlt";
+    m_ns.m_profEvalFilename = "profile_eval.dat";
+    m_ns.m_profSampleFilename = "profile_sample.dat";
     m_ns.m_solverProgram = VlOs::getenvStr("VERILATOR_SOLVER", VL_SOLVER_DEFAULT);
     m_fdps.resize(31);
     std::fill(m_fdps.begin(), m_fdps.end(), static_cast<FILE*>(nullptr));
@@ -2593,6 +2798,7 @@ VerilatedContext::VerilatedContext()
 // Must declare here not in interface, as otherwise forward declarations not known
 VerilatedContext::~VerilatedContext() {
     checkMagic(this);
+    outputAsync(false);  // Write out before files close
     m_magic = 0x1;  // Arbitrary but 0x1 is what Verilator src uses for a deleted pointer
 }
 
@@ -2663,6 +2869,14 @@ std::string VerilatedContext::coverageFilename() const VL_MT_SAFE {
     const VerilatedLockGuard lock{m_mutex};
     return m_ns.m_coverageFilename;
 }
+void VerilatedContext::coverageBinary(bool flag) VL_MT_SAFE {
+    const VerilatedLockGuard lock{m_mutex};
+    m_ns.m_coverageBinary = flag;
+}
+bool VerilatedContext::coverageBinary() const VL_MT_SAFE {
+    const VerilatedLockGuard lock{m_mutex};
+    return m_ns.m_coverageBinary;
+}
 void VerilatedContext::dumpfile(const std::string& flag) VL_MT_SAFE_EXCLUDES(m_timeDumpMutex) {
     const VerilatedLockGuard lock{m_timeDumpMutex};
     m_dumpfile = flag;
@@ -2715,6 +2929,23 @@ void VerilatedContext::profExecWindow(uint64_t flag) VL_MT_SAFE {
     const VerilatedLockGuard lock{m_mutex};
     m_ns.m_profExecWindow = flag;
 }
+void VerilatedContext::threadsRepack(uint64_t flag) VL_MT_SAFE {
+    const VerilatedLockGuard lock{m_mutex};
+    m_ns.m_threadsRepack = flag;
+}
+void VerilatedContext::threadsWait(const std::string& flag) VL_MT_SAFE {
+    if (flag == "yield") {
+        VlMTaskVertex::waitPolicy(VlThreadsWait::YIELD);
+    } else if (flag == "sleep") {
+        VlMTaskVertex::waitPolicy(VlThreadsWait::SLEEP);
+    } else if (flag == "spin") {
+        VlMTaskVertex::waitPolicy(VlThreadsWait::SPIN);
+    } else {
+        const std::string msg = "Unknown +verilator+threads+wait+ policy '" + flag
+                                + "', expected 'yield', 'sleep' or 'spin'";
+        VL_FATAL_MT("COMMAND_LINE", 0, "", msg.c_str());
+    }
+}
 void VerilatedContext::profExecFilename(const std::string& flag) VL_MT_SAFE {
     const VerilatedLockGuard lock{m_mutex};
     m_ns.m_profExecFilename = flag;
@@ -2723,6 +2954,14 @@ std::string VerilatedContext::profExecFilename() const VL_MT_SAFE {
     const VerilatedLockGuard lock{m_mutex};
     return m_ns.m_profExecFilename;
 }
+void VerilatedContext::profExecBinary(bool flag) VL_MT_SAFE {
+    const VerilatedLockGuard lock{m_mutex};
+    m_ns.m_profExecBinary = flag;
+}
+void VerilatedContext::profExecHwCounters(bool flag) VL_MT_SAFE {
+    const VerilatedLockGuard lock{m_mutex};
+    m_ns.m_profExecHwCounters = flag;
+}
 void VerilatedContext::profVltFilename(const std::string& flag) VL_MT_SAFE {
     const VerilatedLockGuard lock{m_mutex};
     m_ns.m_profVltFilename = flag;
@@ -2731,6 +2970,37 @@ std::string VerilatedContext::profVltFilename() const VL_MT_SAFE {
     const VerilatedLockGuard lock{m_mutex};
     return m_ns.m_profVltFilename;
 }
+void VerilatedContext::profEvalFilename(const std::string& flag) VL_MT_SAFE {
+    const VerilatedLockGuard lock{m_mutex};
+    m_ns.m_profEvalFilename = flag;
+}
+std::string VerilatedContext::profEvalFilename() const VL_MT_SAFE {
+    const VerilatedLockGuard lock{m_mutex};
+    return m_ns.m_profEvalFilename;
+}
+void VerilatedContext::profSampleFilename(const std::string& flag) VL_MT_SAFE {
+    const VerilatedLockGuard lock{m_mutex};
+    m_ns.m_profSampleFilename = flag;
+}
+std::string VerilatedContext::profSampleFilename() const VL_MT_SAFE {
+    const VerilatedLockGuard lock{m_mutex};
+    return m_ns.m_profSampleFilename;
+}
+void VerilatedContext::addEvalCountersCb(EvalCountersCb cb, const void* datap) VL_MT_SAFE {
+    const VerilatedLockGuard lock{m_impdatap->m_evalCountersMutex};
+    m_impdatap->m_evalCountersCbs.emplace_back(cb, datap);
+}
+void VerilatedContext::removeEvalCountersCb(EvalCountersCb cb, const void* datap) VL_MT_SAFE {
+    const VerilatedLockGuard lock{m_impdatap->m_evalCountersMutex};
+    auto& cbs = m_impdatap->m_evalCountersCbs;
+    cbs.erase(std::remove(cbs.begin(), cbs.end(), std::make_pair(cb, datap)), cbs.end());
+}
+std::map<std::string, uint64_t> VerilatedContext::evalCounters() const VL_MT_SAFE {
+    std::map<std::string, uint64_t> counters;
+    const VerilatedLockGuard lock{m_impdatap->m_evalCountersMutex};
+    for (const auto& pair : m_impdatap->m_evalCountersCbs) pair.first(pair.second, counters);
+    return counters;
+}
 void VerilatedContext::solverProgram(const std::string& flag) VL_MT_SAFE {
     const VerilatedLockGuard lock{m_mutex};
     m_ns.m_solverProgram = flag;
@@ -2739,6 +3009,20 @@ std::string VerilatedContext::solverProgram() const VL_MT_SAFE {
     const VerilatedLockGuard lock{m_mutex};
     return m_ns.m_solverProgram;
 }
+static void asyncOutputFlushCb(void* datap) VL_MT_SAFE {
+    static_cast<VerilatedContext*>(datap)->impp()->asyncOutputDrain();
+}
+bool VerilatedContext::outputAsync() const VL_MT_SAFE { return impp()->asyncOutputp(); }
+void VerilatedContext::outputAsync(bool flag) VL_MT_SAFE {
+    if (flag == outputAsync()) return;
+    if (flag) {
+        m_impdatap->m_asyncOutputp.reset(new VerilatedAsyncOutput{this, 4096});
+        Verilated::addFlushCb(asyncOutputFlushCb, this);
+    } else {
+        Verilated::removeFlushCb(asyncOutputFlushCb, this);
+        m_impdatap->m_asyncOutputp.reset();  // Drains and stops
+    }
+}
 void VerilatedContext::quiet(bool flag) VL_MT_SAFE {
     const VerilatedLockGuard lock{m_mutex};
     m_s.m_quiet = flag;
@@ -2760,7 +3044,7 @@ const char* VerilatedContext::timeprecisionString() const VL_MT_SAFE {
 void VerilatedContext::threads(unsigned n) {
     if (n == 0) VL_FATAL_MT(__FILE__, __LINE__, "", "Simulation threads must be >= 1");
 
-    if (m_threadPool) {
+    if (m_threadPool || m_threadPoolSharedp) {
         VL_FATAL_MT(
             __FILE__, __LINE__, "",
             "%Error: Cannot set simulation threads after the thread pool has been created.");
@@ -2776,6 +3060,15 @@ void VerilatedContext::threads(unsigned n) {
     }
 }
 
+void VerilatedContext::threadPoolShared(bool flag) {
+    if (m_threadPool || m_threadPoolSharedp) {
+        VL_FATAL_MT(
+            __FILE__, __LINE__, "",
+            "%Error: Cannot set shared thread pool after the thread pool has been created.");
+    }
+    m_threadPoolShared = flag;
+}
+
 void VerilatedContext::commandArgs(int argc, const char** argv) VL_MT_SAFE_EXCLUDES(m_argMutex) {
     // Not locking m_argMutex here, it is done in impp()->commandArgsAddGuts
     // m_argMutex here is the same as in impp()->commandArgsAddGuts;
@@ -2840,13 +3133,39 @@ void VerilatedContext::addModel(VerilatedModel* modelp) {
 
 VerilatedVirtualBase* VerilatedContext::threadPoolp() {
     if (m_threads == 1) return nullptr;
+    if (m_threadPoolShared) {
+        if (!m_threadPoolSharedp) m_threadPoolSharedp = VlThreadPool::sharedp(m_threads - 1);
+        return m_threadPoolSharedp;
+    }
     if (!m_threadPool) m_threadPool.reset(new VlThreadPool{this, m_threads - 1});
     return m_threadPool.get();
 }
 
 void VerilatedContext::prepareClone() { delete m_threadPool.release(); }
 
+int VerilatedContext::forkProcess() VL_MT_UNSAFE {
+#ifdef _VL_HAVE_MMAP
+    // Else buffered output would be written by both processes
+    Verilated::runFlushCallbacks();
+    // Only the calling thread survives fork(), so stop the workers and
+    // restart them in both processes, keeping the pool that models point to
+    VlThreadPool* const poolp = static_cast<VlThreadPool*>(
+        m_threadPoolShared ? m_threadPoolSharedp : m_threadPool.get());
+    if (poolp) poolp->stopWorkers();
+    VerilatedAsyncOutput* const asyncp = impp()->asyncOutputp();
+    if (asyncp) asyncp->stop();
+    const pid_t pid = ::fork();
+    if (asyncp) asyncp->start();
+    if (poolp) poolp->startWorkers();
+    return pid;
+#else
+    VL_FATAL_MT(__FILE__, __LINE__, "", "VerilatedContext::forkProcess unsupported on this OS");
+    return -1;
+#endif
+}
+
 VerilatedVirtualBase* VerilatedContext::threadPoolpOnClone() {
+    if (m_threadPoolShared) return threadPoolp();
     if (VL_UNLIKELY(m_threadPool)) m_threadPool.release();
     m_threadPool = std::unique_ptr<VlThreadPool>(new VlThreadPool{this, m_threads - 1});
     return m_threadPool.get();
@@ -2932,7 +3251,9 @@ void VerilatedContextImp::commandArgVl(const std::string& arg) {
     if (0 == std::strncmp(arg.c_str(), "+verilator+", std::strlen("+verilator+"))) {
         std::string str;
         uint64_t u64;
-        if (commandArgVlString(arg, "+verilator+coverage+file+", str)) {
+        if (arg == "+verilator+coverage+binary") {
+            coverageBinary(true);
+        } else if (commandArgVlString(arg, "+verilator+coverage+file+", str)) {
             coverageFilename(str);
         } else if (arg == "+verilator+debug") {
             Verilated::debug(4);
@@ -2949,12 +3270,22 @@ void VerilatedContextImp::commandArgVl(const std::string& arg) {
                         "Exiting due to command line argument (not an error)");
         } else if (arg == "+verilator+noassert") {
             assertOn(false);
+        } else if (arg == "+verilator+output+async") {
+            outputAsync(true);
         } else if (commandArgVlUint64(arg, "+verilator+prof+exec+start+", u64)) {
             profExecStart(u64);
         } else if (commandArgVlUint64(arg, "+verilator+prof+exec+window+", u64, 1)) {
             profExecWindow(u64);
         } else if (commandArgVlString(arg, "+verilator+prof+exec+file+", str)) {
             profExecFilename(str);
+        } else if (arg == "+verilator+prof+exec+binary") {
+            profExecBinary(true);
+        } else if (arg == "+verilator+prof+exec+hwcounters") {
+            profExecHwCounters(true);
+        } else if (commandArgVlString(arg, "+verilator+prof+eval+file+", str)) {
+            profEvalFilename(str);
+        } else if (commandArgVlString(arg, "+verilator+prof+sample+file+", str)) {
+            profSampleFilename(str);
         } else if (commandArgVlString(arg, "+verilator+prof+vlt+file+", str)) {
             profVltFilename(str);
         } else if (arg == "+verilator+quiet") {
@@ -2964,6 +3295,10 @@ void VerilatedContextImp::commandArgVl(const std::string& arg) {
         } else if (commandArgVlUint64(arg, "+verilator+seed+", u64, 1,
                                       std::numeric_limits<int>::max())) {
             randSeed(static_cast<int>(u64));
+        } else if (commandArgVlUint64(arg, "+verilator+threads+repack+", u64)) {
+            threadsRepack(u64);
+        } else if (commandArgVlString(arg, "+verilator+threads+wait+", str)) {
+            threadsWait(str);
         } else if (arg == "+verilator+V") {
             VerilatedImp::versionDump();  // Someday more info too
             VL_FATAL_MT("COMMAND_LINE", 0, "",
@@ -3020,12 +3355,13 @@ bool VerilatedContextImp::commandArgVlUint64(const std::string& arg, const std::
 void VerilatedContext::randSeed(int val) VL_MT_SAFE {
     // As we have per-thread state, the epoch must be static,
     // and so the rand seed's mutex must also be static
-    const VerilatedLockGuard lock{VerilatedContextImp::s().s_randMutex};
     m_s.m_randSeed = val;
-    const uint64_t newEpoch = VerilatedContextImp::s().s_randSeedEpoch + 1;
-    // Observers must see new epoch AFTER seed updated
-    std::atomic_signal_fence(std::memory_order_release);
-    VerilatedContextImp::s().s_randSeedEpoch = newEpoch;
+    // Observers must see new epoch AFTER seed updated, the store releases
+    impp()->randSeedEpochNew();
+}
+void VerilatedContextImp::randSeedEpochNew() VL_MT_SAFE {
+    const VerilatedLockGuard lock{s().s_randMutex};
+    m_impdatap->m_randSeedEpoch.store(++s().s_randSeedEpoch, std::memory_order_release);
 }
 uint64_t VerilatedContextImp::randSeedDefault64() const VL_MT_SAFE {
     if (randSeed() != 0) {
@@ -3049,6 +3385,7 @@ double VerilatedContext::statWallTimeSinceStart() const VL_MT_SAFE_EXCLUDES(m_mu
 }
 void VerilatedContext::statsPrintSummary() VL_MT_UNSAFE {
     if (quiet()) return;
+    impp()->asyncOutputDrain();
     VL_PRINTF("- S i m u l a t i o n   R e p o r t: %s %s\n", Verilated::productName(),
               Verilated::productVersion());
     const std::string endwhy = gotError() ? "$stop" : gotFinish() ? "$finish" : "end";
@@ -3072,7 +3409,7 @@ void VerilatedContext::statsPrintSummary() VL_MT_UNSAFE {
 void VerilatedContext::scopesDump() const VL_MT_SAFE {
     const VerilatedLockGuard lock{m_impdatap->m_nameMutex};
     VL_PRINTF_MT("  scopesDump:\n");
-    for (const auto& i : m_impdatap->m_nameMap) {
+    for (const auto& i : m_impdatap->nameMap()) {
         const VerilatedScope* const scopep = i.second;
         scopep->scopeDump();
     }
@@ -3082,26 +3419,33 @@ void VerilatedContext::scopesDump() const VL_MT_SAFE {
 void VerilatedContextImp::scopeInsert(const VerilatedScope* scopep) VL_MT_SAFE {
     // Slow ok - called once/scope at construction
     const VerilatedLockGuard lock{m_impdatap->m_nameMutex};
-    const auto it = m_impdatap->m_nameMap.find(scopep->name());
-    if (it == m_impdatap->m_nameMap.end()) m_impdatap->m_nameMap.emplace(scopep->name(), scopep);
+    if (m_impdatap->m_nameHash.emplace(scopep->name(), scopep).second) {
+        m_impdatap->m_nameMapStale = true;
+    }
+    ++m_impdatap->m_nameGeneration;
 }
 void VerilatedContextImp::scopeErase(const VerilatedScope* scopep) VL_MT_SAFE {
     // Slow ok - called once/scope at destruction
     const VerilatedLockGuard lock{m_impdatap->m_nameMutex};
     VerilatedImp::userEraseScope(scopep);
-    const auto it = m_impdatap->m_nameMap.find(scopep->name());
-    if (it != m_impdatap->m_nameMap.end()) m_impdatap->m_nameMap.erase(it);
+    if (m_impdatap->m_nameHash.erase(scopep->name())) m_impdatap->m_nameMapStale = true;
+    ++m_impdatap->m_nameGeneration;
+}
+uint64_t VerilatedContextImp::scopeGeneration() const VL_MT_SAFE {
+    const VerilatedLockGuard lock{m_impdatap->m_nameMutex};
+    return m_impdatap->m_nameGeneration;
 }
 const VerilatedScope* VerilatedContext::scopeFind(const char* namep) const VL_MT_SAFE {
     // Thread save only assuming this is called only after model construction completed
     const VerilatedLockGuard lock{m_impdatap->m_nameMutex};
     // If too slow, can assume this is only VL_MT_SAFE_POSINIT
-    const auto& it = m_impdatap->m_nameMap.find(namep);
-    if (VL_UNLIKELY(it == m_impdatap->m_nameMap.end())) return nullptr;
+    const auto& it = m_impdatap->m_nameHash.find(namep);
+    if (VL_UNLIKELY(it == m_impdatap->m_nameHash.end())) return nullptr;
     return it->second;
 }
 const VerilatedScopeNameMap* VerilatedContext::scopeNameMap() VL_MT_SAFE {
-    return &(impp()->m_impdatap->m_nameMap);
+    const VerilatedLockGuard lock{m_impdatap->m_nameMutex};
+    return &(impp()->m_impdatap->nameMap());
 }
 
 //======================================================================
@@ -3507,11 +3851,28 @@ void VerilatedScope::varInsert(int finalize, const char* namep, void* datap, boo
     m_varsp->emplace(namep, var);
 }
 
+void VerilatedScope::varInitRun() const VL_MT_SAFE {
+    // Slowpath - called once/scope when variables are first looked up
+    // Registration is deferred so large public models construct quickly
+    static VerilatedMutex s_mutex;
+    const VerilatedLockGuard lock{s_mutex};
+    if (const VarInitCb cb = m_varInitCb.load()) {
+        cb(m_symsp);
+        m_varInitCb.store(nullptr, std::memory_order_release);
+    }
+}
+
+void VerilatedScope::varDirty(int finalize, const char* namep, CData* dirtyp) VL_MT_UNSAFE {
+    if (!finalize) return;
+    const auto it = m_varsp->find(namep);
+    if (VL_LIKELY(it != m_varsp->end())) it->second.m_dirtyp = dirtyp;
+}
+
 // cppcheck-suppress unusedFunction  // Used by applications
 VerilatedVar* VerilatedScope::varFind(const char* namep) const VL_MT_SAFE_POSTINIT {
-    if (VL_LIKELY(m_varsp)) {
-        const auto it = m_varsp->find(namep);
-        if (VL_LIKELY(it != m_varsp->end())) return &(it->second);
+    if (VerilatedVarNameMap* const varsp = this->varsp()) {
+        const auto it = varsp->find(namep);
+        if (VL_LIKELY(it != varsp->end())) return &(it->second);
     }
     return nullptr;
 }
@@ -3567,6 +3928,11 @@ void VerilatedAssertOneThread::fatal_different() VL_MT_SAFE {
 }
 #endif
 
+//===========================================================================
+// VlClassPool:: Members
+
+thread_local VlClassPool::FreeLists VlClassPool::t_lists;
+
 //===========================================================================
 // VlDeleter:: Methods
 
@@ -429,10 +429,18 @@ protected:
         // Fast path
         uint64_t m_profExecStart = 1;  // +prof+exec+start time
         uint32_t m_profExecWindow = 2;  // +prof+exec+window size
+        bool m_profExecBinary = false;  // +prof+exec+binary
+        bool m_profExecHwCounters = false;  // +prof+exec+hwcounters
+        uint64_t m_threadsRepack = 0;  // +threads+repack evaluations
+        std::atomic<uint32_t> m_dumponCount{0};  // Number of $dumpon executed
+        std::atomic<uint64_t> m_signalsWritten{0};  // Number of signalsWritten() calls
         // Slow path
         std::string m_coverageFilename;  // +coverage+file filename
+        bool m_coverageBinary = false;  // +coverage+binary
         std::string m_profExecFilename;  // +prof+exec+file filename
         std::string m_profVltFilename;  // +prof+vlt filename
+        std::string m_profEvalFilename;  // +prof+eval+file filename
+        std::string m_profSampleFilename;  // +prof+sample+file filename
         std::string m_solverProgram;  // SMT solver program
         VlOs::DeltaCpuTime m_cpuTimeStart{false};  // CPU time, starts when create first model
         VlOs::DeltaWallTime m_wallTimeStart{false};  // Wall time, starts when create first model
@@ -456,6 +464,10 @@ protected:
     unsigned m_threadsInModels = 0;
     // The thread pool shared by all models added to this context
     std::unique_ptr<VerilatedVirtualBase> m_threadPool;
+    // Use the process-wide thread pool instead of m_threadPool
+    bool m_threadPoolShared = false;
+    // The process-wide thread pool, once used by this context; not owned
+    VerilatedVirtualBase* m_threadPoolSharedp = nullptr;
     // The execution profiler shared by all models added to this context
     std::unique_ptr<VerilatedVirtualBase> m_executionProfiler;
     // Coverage access
@@ -479,6 +491,10 @@ private:
     VL_UNCOPYABLE(VerilatedContext);
 
 public:
+    // TYPES
+    /// Internal: Callback adding a model's --prof-eval counters to a map
+    using EvalCountersCb = void (*)(const void* datap, std::map<std::string, uint64_t>& counters);
+
     /// Construct context. Also sets Verilated::threadContextp to the created context.
     VerilatedContext();
     ~VerilatedContext();
@@ -530,6 +546,10 @@ public:
     int errorLimit() const VL_MT_SAFE { return m_s.m_errorLimit; }
     /// Set number of errors/assertions before stop
     void errorLimit(int val) VL_MT_SAFE;
+    /// Return the --prof-eval counters of all models under this context,
+    /// keyed "<model>.<counter>", e.g. "TOP.act.iterations".  Empty unless a
+    /// model was Verilated with --prof-eval.  Call between eval() calls.
+    std::map<std::string, uint64_t> evalCounters() const VL_MT_SAFE;
     /// Return if to throw fatal error on $stop/non-fatal
     bool fatalOnError() const VL_MT_SAFE { return m_s.m_fatalOnError; }
     /// Set to throw fatal error on $stop/non-fatal error
@@ -546,6 +566,21 @@ public:
     bool gotFinish() const VL_MT_SAFE { return m_s.m_gotFinish; }
     /// Set if got a $finish or $stop/error
     void gotFinish(bool flag) VL_MT_SAFE;
+    /// Return if asynchronous output enabled
+    bool outputAsync() const VL_MT_SAFE;
+    /// Enable writing $display and $fwrite output from a background thread.
+    /// Must be set before the model is evaluated.
+    void outputAsync(bool flag) VL_MT_SAFE;
+    /// Note model signals were written other than through top-level inputs,
+    /// e.g. through public signals, so with --skip-idle-eval the next eval()
+    /// is not skipped.  Called by vpi_put_value.
+    void signalsWritten() VL_MT_SAFE {
+        m_ns.m_signalsWritten.fetch_add(1, std::memory_order_relaxed);
+    }
+    /// Return number of signalsWritten() calls; internal use by --skip-idle-eval
+    uint64_t signalsWrittenCount() const VL_MT_SAFE {
+        return m_ns.m_signalsWritten.load(std::memory_order_relaxed);
+    }
     /// Return if quiet enabled
     bool quiet() const VL_MT_SAFE { return m_s.m_quiet; }
     /// Enable quiet (also prevents need for OS calls to get CPU time)
@@ -617,6 +652,22 @@ public:
     /// Set number of threads used for simulation (including the main thread)
     /// Can only be called before the thread pool is created (before first model is added).
     void threads(unsigned n);
+    /// Return if models in this context run on the process-wide thread pool
+    bool threadPoolShared() const { return m_threadPoolShared; }
+    /// Run models in this context on one thread pool shared with all other
+    /// contexts that enable this, instead of creating a pool per context.
+    /// Evaluations of models from different contexts, e.g. each driven by its
+    /// own application thread, are then interleaved on the same workers.
+    /// Can only be called before the thread pool is created (before first model is added).
+    void threadPoolShared(bool flag);
+
+    /// Fork the simulation process at the current time, as with POSIX fork().
+    /// Open files are flushed and the thread pool is stopped before the fork,
+    /// then the thread pool is restarted in both processes.  The child shares
+    /// memory copy-on-write, so branches from a common state start quickly.
+    /// Returns 0 in the child, the child's process ID in the parent, or -1 on error.
+    /// Must be called from the main thread between evaluations.
+    int forkProcess() VL_MT_UNSAFE;
 
     /// Trace signals in models within the context; called by application code
     void trace(VerilatedTraceBaseC* tfp, int levels, int options = 0);
@@ -654,11 +705,18 @@ public:
     // Internal: coverage
     std::string coverageFilename() const VL_MT_SAFE;
     void coverageFilename(const std::string& flag) VL_MT_SAFE;
+    bool coverageBinary() const VL_MT_SAFE;
+    void coverageBinary(bool flag) VL_MT_SAFE;
 
     // Internal: $dumpfile
     std::string dumpfile() const VL_MT_SAFE_EXCLUDES(m_timeDumpMutex);
     void dumpfile(const std::string& flag) VL_MT_SAFE_EXCLUDES(m_timeDumpMutex);
     std::string dumpfileCheck() const VL_MT_SAFE_EXCLUDES(m_timeDumpMutex);
+    // Internal: $dumpon, triggers flight recording traces
+    void dumpon() VL_MT_SAFE { m_ns.m_dumponCount.fetch_add(1, std::memory_order_relaxed); }
+    uint32_t dumponCount() const VL_MT_SAFE {
+        return m_ns.m_dumponCount.load(std::memory_order_relaxed);
+    }
 
     // Internal: --prof-exec related settings
     uint64_t profExecStart() const VL_MT_SAFE { return m_ns.m_profExecStart; }
@@ -667,9 +725,27 @@ public:
     void profExecWindow(uint64_t flag) VL_MT_SAFE;
     std::string profExecFilename() const VL_MT_SAFE;
     void profExecFilename(const std::string& flag) VL_MT_SAFE;
+    bool profExecBinary() const VL_MT_SAFE { return m_ns.m_profExecBinary; }
+    void profExecBinary(bool flag) VL_MT_SAFE;
+    bool profExecHwCounters() const VL_MT_SAFE { return m_ns.m_profExecHwCounters; }
+    void profExecHwCounters(bool flag) VL_MT_SAFE;
     std::string profVltFilename() const VL_MT_SAFE;
     void profVltFilename(const std::string& flag) VL_MT_SAFE;
 
+    // Internal: --prof-eval and --prof-sample related settings and counter registration
+    std::string profEvalFilename() const VL_MT_SAFE;
+    void profEvalFilename(const std::string& flag) VL_MT_SAFE;
+    std::string profSampleFilename() const VL_MT_SAFE;
+    void profSampleFilename(const std::string& flag) VL_MT_SAFE;
+    void addEvalCountersCb(EvalCountersCb cb, const void* datap) VL_MT_SAFE;
+    void removeEvalCountersCb(EvalCountersCb cb, const void* datap) VL_MT_SAFE;
+
+    // Internal: --threads-work-stealing related settings
+    uint64_t threadsRepack() const VL_MT_SAFE { return m_ns.m_threadsRepack; }
+    void threadsRepack(uint64_t flag) VL_MT_SAFE;
+    // Internal: +verilator+threads+wait+ policy; process-wide, as are the waiting threads
+    void threadsWait(const std::string& flag) VL_MT_SAFE;
+
     // Internal: SMT solver program
     std::string solverProgram() const VL_MT_SAFE;
     void solverProgram(const std::string& flag) VL_MT_SAFE;
@@ -716,6 +792,9 @@ public:
         SCOPE_OTHER,
         SCOPE_PACKAGE
     };  // Type of a scope, currently only module and package are interesting
+    // Generated function registering the scope's variables when first needed
+    using VarInitCb = void (*)(VerilatedSyms* symsp);
+
 private:
     // Fastpath:
     VerilatedSyms* m_symsp = nullptr;  // Symbol table
@@ -723,6 +802,7 @@ private:
     int m_funcnumMax = 0;  // Maximum function number stored (Fastpath)
     // 4 bytes padding (on -m64), for rent.
     VerilatedVarNameMap* m_varsp = nullptr;  // Variable map
+    mutable std::atomic<VarInitCb> m_varInitCb{nullptr};  // Pending variable registration
     const char* m_namep = nullptr;  // Scope name (Slowpath)
     const char* m_identifierp = nullptr;  // Identifier of scope (with escapes removed)
     const char* m_defnamep = nullptr;  // Definition name (SCOPE_MODULE only)
@@ -738,6 +818,8 @@ public:  // But internals only - called from VerilatedModule's
     void exportInsert(int finalize, const char* namep, void* cb) VL_MT_UNSAFE;
     void varInsert(int finalize, const char* namep, void* datap, bool isParam,
                    VerilatedVarType vltype, int vlflags, int udims, int pdims, ...) VL_MT_UNSAFE;
+    void varDirty(int finalize, const char* namep, CData* dirtyp) VL_MT_UNSAFE;
+    void varInit(VarInitCb cb) VL_MT_UNSAFE { m_varInitCb.store(cb); }
     // ACCESSORS
     const char* name() const VL_MT_SAFE_POSTINIT { return m_namep; }
     const char* identifier() const VL_MT_SAFE_POSTINIT { return m_identifierp; }
@@ -745,7 +827,11 @@ public:  // But internals only - called from VerilatedModule's
     int8_t timeunit() const VL_MT_SAFE_POSTINIT { return m_timeunit; }
     VerilatedSyms* symsp() const VL_MT_SAFE_POSTINIT { return m_symsp; }
     VerilatedVar* varFind(const char* namep) const VL_MT_SAFE_POSTINIT;
-    VerilatedVarNameMap* varsp() const VL_MT_SAFE_POSTINIT { return m_varsp; }
+    VerilatedVarNameMap* varsp() const VL_MT_SAFE_POSTINIT {
+        if (VL_UNLIKELY(m_varInitCb.load(std::memory_order_acquire))) varInitRun();
+        return m_varsp;
+    }
+    void varInitRun() const VL_MT_SAFE;
     void scopeDump() const;
     void* exportFindError(int funcnum) const VL_MT_SAFE;
     static void* exportFindNullError(int funcnum) VL_MT_SAFE;
@@ -792,6 +878,7 @@ class Verilated final {
         // Fast path
         VerilatedContext* t_contextp = nullptr;  // Thread's context
         uint32_t t_mtaskId = 0;  // mtask# executing on this thread
+        uint32_t t_threadIndex = 0;  // Model schedule thread executing on this thread
         // Messages maybe pending on thread, needs end-of-eval calls
         uint32_t t_endOfEvalReqd = 0;
         const VerilatedScope* t_dpiScopep = nullptr;  // DPI context scope
@@ -1008,6 +1095,9 @@ public:
     // Per thread, so no need to be in VerilatedContext
     static uint32_t mtaskId() VL_MT_SAFE { return t_s.t_mtaskId; }
     static void mtaskId(uint32_t id) VL_MT_SAFE { t_s.t_mtaskId = id; }
+    // Internal: Set the schedule thread index, 0 outside of parallel sections
+    static uint32_t threadIndex() VL_MT_SAFE { return t_s.t_threadIndex; }
+    static void threadIndex(uint32_t index) VL_MT_SAFE { t_s.t_threadIndex = index; }
     static void endOfEvalReqdInc() VL_MT_SAFE { ++t_s.t_endOfEvalReqd; }
     static void endOfEvalReqdDec() VL_MT_SAFE { --t_s.t_endOfEvalReqd; }
 
@@ -0,0 +1,485 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//=============================================================================
+//
+// Code available from: https://verilator.org
+//
+// Copyright 2025 by Wilson Snyder. This program is free software; you
+// can redistribute it and/or modify it under the terms of either the GNU
+// Lesser General Public License Version 3 or the Perl Artistic License
+// Version 2.0.
+// SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+//
+//=============================================================================
+///
+/// \file
+/// \brief Verilated C++ tracing in raw binary format implementation code
+///
+/// This file must be compiled and linked against all Verilated objects
+/// that use --trace-bin.
+///
+/// Use "verilator --trace-bin" to add this to the Makefile for the linker.
+///
+//=============================================================================
+
+// clang-format off
+
+#include "verilatedos.h"
+#include "verilated.h"
+#include "verilated_bin_c.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <fcntl.h>
+
+#if defined(_WIN32) && !defined(__MINGW32__) && !defined(__CYGWIN__)
+# include <io.h>
+#else
+# include <unistd.h>
+#endif
+
+#ifndef O_LARGEFILE  // WIN32 headers omit this
+# define O_LARGEFILE 0
+#endif
+#ifndef O_BINARY  // Only WIN32 headers define this
+# define O_BINARY 0
+#endif
+#ifndef O_CLOEXEC  // WIN32 headers omit this
+# define O_CLOEXEC 0
+#endif
+
+// clang-format on
+
+// Code of a time change record, 0 is never a signal code
+constexpr uint32_t VL_TRACE_BIN_TIME_CODE = 0;
+
+//=============================================================================
+// Specialization of the generics for this trace format
+
+#define VL_SUB_T VerilatedBin
+#define VL_BUF_T VerilatedBinBuffer
+#include "verilated_trace_imp.h"
+#undef VL_SUB_T
+#undef VL_BUF_T
+
+//=============================================================================
+//=============================================================================
+//=============================================================================
+// Opening/Closing
+
+VerilatedBin::VerilatedBin() {
+    // Not in header to avoid link issue if header is included without this .cpp file
+    m_wrChunkSize = 8 * 1024;
+    m_wrBufp = new uint32_t[m_wrChunkSize * 8];
+    m_wrFlushp = m_wrBufp + m_wrChunkSize * 6;
+    m_writep = m_wrBufp;
+}
+
+void VerilatedBin::open(const char* filename) VL_MT_SAFE_EXCLUDES(m_mutex) {
+    const VerilatedLockGuard lock{m_mutex};
+    if (isOpen()) return;
+
+    m_filename = filename;  // "" is ok, as someone may overload open
+    m_fd = ::open(m_filename.c_str(),
+                  O_CREAT | O_WRONLY | O_TRUNC | O_LARGEFILE | O_BINARY | O_CLOEXEC, 0666);
+    if (m_fd < 0) return;  // User code can check isOpen()
+    m_isOpen = true;
+
+    // Scope and signal definitions
+    m_decls = "$version Generated by VerilatedBin $end\n";
+    m_decls += "$timescale ";
+    m_decls += timeResStr();
+    m_decls += " $end\n";
+    assert(m_indent >= 0);
+    ++m_indent;
+    Super::traceInit();
+    --m_indent;
+    assert(m_indent >= 0);
+    m_decls += "$enddefinitions $end\n";
+    m_decls.resize(roundUpToMultipleOf<sizeof(uint32_t)>(m_decls.size()), '\0');
+
+    // Header, written directly as the output buffer must only hold whole words
+    const uint32_t header[2] = {0x01020304U, static_cast<uint32_t>(m_decls.size())};
+    writeBytes("VLTRBIN1", 8);
+    writeBytes(reinterpret_cast<const char*>(header), sizeof(header));
+    writeBytes(m_decls.data(), m_decls.size());
+    std::string{}.swap(m_decls);
+
+    constDump(true);  // First dump must contain the const signals
+    fullDump(true);  // First dump must be full
+}
+
+void VerilatedBin::emitTimeChange(uint64_t timeui) {
+    m_writep[0] = VL_TRACE_BIN_TIME_CODE;
+    m_writep[1] = static_cast<uint32_t>(timeui);
+    m_writep[2] = static_cast<uint32_t>(timeui >> 32ULL);
+    m_writep += 3;
+    bufferCheck();
+}
+
+VerilatedBin::~VerilatedBin() {
+    close();
+    if (m_wrBufp) VL_DO_CLEAR(delete[] m_wrBufp, m_wrBufp = nullptr);
+    if (parallel()) {
+        assert(m_numBuffers == m_freeBuffers.size());
+        for (auto& pair : m_freeBuffers) VL_DO_CLEAR(delete[] pair.first, pair.first = nullptr);
+    }
+}
+
+void VerilatedBin::closeErr() {
+    // This function is on the flush() call path
+    // Close due to an error.  We might abort before even getting here,
+    // depending on the definition of vl_fatal.
+    if (!isOpen()) return;
+
+    // No buffer flush, just close
+    m_isOpen = false;
+    ::close(m_fd);  // May get error, just ignore it
+}
+
+void VerilatedBin::close() VL_MT_SAFE_EXCLUDES(m_mutex) {
+    // This function is on the flush() call path
+    const VerilatedLockGuard lock{m_mutex};
+    if (!isOpen()) return;
+    Super::flushBase();
+    bufferFlush();
+    m_isOpen = false;
+    ::close(m_fd);
+    // Super::flushBase() was called above, so we just
+    // need to shut down the tracing thread here.
+    Super::closeBase();
+}
+
+void VerilatedBin::flush() VL_MT_SAFE_EXCLUDES(m_mutex) {
+    const VerilatedLockGuard lock{m_mutex};
+    Super::flushBase();
+    bufferFlush();
+}
+
+void VerilatedBin::bufferResize(size_t minsize) {
+    // minsize is size of largest write, in words.  We buffer at least 8 times as much data,
+    // writing when we are 3/4 full (with thus 2*minsize remaining free)
+    if (VL_UNLIKELY(minsize > m_wrChunkSize)) {
+        const uint32_t* oldbufp = m_wrBufp;
+        m_wrChunkSize = roundUpToMultipleOf<1024>(minsize * 2);
+        m_wrBufp = new uint32_t[m_wrChunkSize * 8];
+        std::memcpy(m_wrBufp, oldbufp, (m_writep - oldbufp) * sizeof(uint32_t));
+        m_writep = m_wrBufp + (m_writep - oldbufp);
+        m_wrFlushp = m_wrBufp + m_wrChunkSize * 6;
+        VL_DO_CLEAR(delete[] oldbufp, oldbufp = nullptr);
+    }
+}
+
+void VerilatedBin::writeBytes(const char* bufp, size_t len) {
+    // This function can be called from the trace offload thread
+    // This function is on the flush() call path
+    if (VL_UNLIKELY(!m_isOpen)) return;
+    const char* wp = bufp;
+    const char* const endp = bufp + len;
+    while (wp != endp) {
+        errno = 0;
+        const ssize_t got = ::write(m_fd, wp, endp - wp);
+        if (got > 0) {
+            wp += got;
+        } else if (VL_UNCOVERABLE(got < 0)) {
+            if (VL_UNCOVERABLE(errno != EAGAIN && errno != EINTR)) {
+                // LCOV_EXCL_START
+                // write failed, presume error (perhaps out of disk space)
+                const std::string msg = "VerilatedBin::writeBytes: "s + std::strerror(errno);
+                VL_FATAL_MT("", 0, "", msg.c_str());
+                closeErr();
+                break;
+                // LCOV_EXCL_STOP
+            }
+        }
+    }
+}
+
+void VerilatedBin::bufferFlush() VL_MT_UNSAFE_ONE {
+    // We add output data to m_writep.
+    // When it gets nearly full we dump it using this routine which calls write()
+    writeBytes(reinterpret_cast<const char*>(m_wrBufp),
+               (m_writep - m_wrBufp) * sizeof(uint32_t));
+    m_writep = m_wrBufp;
+}
+
+//=============================================================================
+// Definitions
+
+void VerilatedBin::printIndent(int level_change) {
+    if (level_change < 0) m_indent += level_change;
+    m_decls.append(m_indent, ' ');
+    if (level_change > 0) m_indent += level_change;
+}
+
+void VerilatedBin::pushPrefix(const std::string& name, VerilatedTracePrefixType type) {
+    assert(!m_prefixStack.empty());  // Constructor makes an empty entry
+    // An empty name means this is the root of a model created with
+    // name()=="".  The tools get upset if we try to pass this as empty, so
+    // we put the signals under a new $rootio scope, but the signals
+    // further down will be peers, not children (as usual for name()!="").
+    const std::string prevPrefix = m_prefixStack.back().first;
+    if (name == "$rootio" && !prevPrefix.empty()) {
+        // Upper has name, we can suppress inserting $rootio, but still push so popPrefix works
+        m_prefixStack.emplace_back(prevPrefix, VerilatedTracePrefixType::ROOTIO_WRAPPER);
+        return;
+    } else if (name.empty()) {
+        m_prefixStack.emplace_back(prevPrefix, VerilatedTracePrefixType::ROOTIO_WRAPPER);
+        return;
+    }
+
+    const std::string newPrefix = prevPrefix + name;
+    bool properScope = false;
+    switch (type) {
+    case VerilatedTracePrefixType::SCOPE_MODULE:
+    case VerilatedTracePrefixType::SCOPE_INTERFACE:
+    case VerilatedTracePrefixType::STRUCT_PACKED:
+    case VerilatedTracePrefixType::STRUCT_UNPACKED:
+    case VerilatedTracePrefixType::UNION_PACKED: {
+        properScope = true;
+        break;
+    }
+    default: break;
+    }
+    if (properScope) {
+        printIndent(1);
+        m_decls += "$scope module ";
+        m_decls += lastWordp(newPrefix);
+        m_decls += " $end\n";
+    }
+    m_prefixStack.emplace_back(newPrefix + (properScope ? " " : ""), type);
+}
+
+void VerilatedBin::popPrefix() {
+    assert(!m_prefixStack.empty());
+    switch (m_prefixStack.back().second) {
+    case VerilatedTracePrefixType::SCOPE_MODULE:
+    case VerilatedTracePrefixType::SCOPE_INTERFACE:
+    case VerilatedTracePrefixType::STRUCT_PACKED:
+    case VerilatedTracePrefixType::STRUCT_UNPACKED:
+    case VerilatedTracePrefixType::UNION_PACKED:
+        printIndent(-1);
+        m_decls += "$upscope $end\n";
+        break;
+    default: break;
+    }
+    m_prefixStack.pop_back();
+    assert(!m_prefixStack.empty());  // Always one left, the constructor's initial one
+}
+
+void VerilatedBin::declare(uint32_t code, const char* name, const char* wirep, bool array,
+                           int arraynum, bool bussed, int msb, int lsb) {
+    const int bits = ((msb > lsb) ? (msb - lsb) : (lsb - msb)) + 1;
+
+    const std::string& hierarchicalName = declName(m_prefixStack.back().first, name);
+
+    const bool enabled = Super::declCode(code, hierarchicalName, bits);
+
+    // Keep upper bound on words a single record can emit into the buffer, a time change is 3
+    m_maxSignalWords = std::max<size_t>(m_maxSignalWords, std::max(1 + VL_WORDS_I(bits), 3));
+    // Make sure write buffer is large enough
+    bufferResize(m_maxSignalWords + 1024);
+
+    if (!enabled) return;
+
+    // Assemble the declaration, with the code for the converter to map to an identifier
+    printIndent(0);
+    m_decls += "$var ";
+    m_decls += wirep;
+    m_decls += ' ';
+    m_decls += std::to_string(bits);
+    m_decls += ' ';
+    m_decls += std::to_string(code);
+    m_decls += ' ';
+    m_decls += lastWordp(hierarchicalName);
+    if (array) {
+        m_decls += '[';
+        m_decls += std::to_string(arraynum);
+        m_decls += ']';
+    }
+    if (bussed) {
+        m_decls += " [";
+        m_decls += std::to_string(msb);
+        m_decls += ':';
+        m_decls += std::to_string(lsb);
+        m_decls += ']';
+    }
+    m_decls += " $end\n";
+}
+
+void VerilatedBin::declEvent(uint32_t code, uint32_t fidx, const char* name, int dtypenum,
+                             VerilatedTraceSigDirection, VerilatedTraceSigKind,
+                             VerilatedTraceSigType, bool array, int arraynum) {
+    declare(code, name, "event", array, arraynum, false, 0, 0);
+}
+void VerilatedBin::declBit(uint32_t code, uint32_t fidx, const char* name, int dtypenum,
+                           VerilatedTraceSigDirection, VerilatedTraceSigKind,
+                           VerilatedTraceSigType, bool array, int arraynum) {
+    declare(code, name, "wire", array, arraynum, false, 0, 0);
+}
+void VerilatedBin::declBus(uint32_t code, uint32_t fidx, const char* name, int dtypenum,
+                           VerilatedTraceSigDirection, VerilatedTraceSigKind,
+                           VerilatedTraceSigType, bool array, int arraynum, int msb, int lsb) {
+    declare(code, name, "wire", array, arraynum, true, msb, lsb);
+}
+void VerilatedBin::declQuad(uint32_t code, uint32_t fidx, const char* name, int dtypenum,
+                            VerilatedTraceSigDirection, VerilatedTraceSigKind,
+                            VerilatedTraceSigType, bool array, int arraynum, int msb, int lsb) {
+    declare(code, name, "wire", array, arraynum, true, msb, lsb);
+}
+void VerilatedBin::declArray(uint32_t code, uint32_t fidx, const char* name, int dtypenum,
+                             VerilatedTraceSigDirection, VerilatedTraceSigKind,
+                             VerilatedTraceSigType, bool array, int arraynum, int msb, int lsb) {
+    declare(code, name, "wire", array, arraynum, true, msb, lsb);
+}
+void VerilatedBin::declDouble(uint32_t code, uint32_t fidx, const char* name, int dtypenum,
+                              VerilatedTraceSigDirection, VerilatedTraceSigKind,
+                              VerilatedTraceSigType, bool array, int arraynum) {
+    declare(code, name, "real", array, arraynum, false, 63, 0);
+}
+
+//=============================================================================
+// Get/commit trace buffer
+
+VerilatedBin::Buffer* VerilatedBin::getTraceBuffer(uint32_t fidx) {
+    VerilatedBin::Buffer* const bufp = new Buffer{*this};
+    if (parallel()) {
+        // Note: This is called from VerilatedBin::dump, which already holds the lock
+        // If no buffer available, allocate a new one
+        if (m_freeBuffers.empty()) {
+            constexpr size_t pageWords = 1024;
+            // 4 * m_maxSignalWords, so we can reserve 2 * m_maxSignalWords at the end for safety
+            const size_t startingSize = roundUpToMultipleOf<pageWords>(4 * m_maxSignalWords);
+            m_freeBuffers.emplace_back(new uint32_t[startingSize], startingSize);
+            ++m_numBuffers;
+        }
+        // Grab a buffer
+        const auto pair = m_freeBuffers.back();
+        m_freeBuffers.pop_back();
+        // Initialize
+        bufp->m_writep = bufp->m_bufp = pair.first;
+        bufp->m_size = pair.second;
+        bufp->adjustGrowp();
+    }
+    // Return the buffer
+    return bufp;
+}
+
+void VerilatedBin::commitTraceBuffer(VerilatedBin::Buffer* bufp) {
+    if (parallel()) {
+        // Note: This is called from VerilatedBin::dump, which already holds the lock
+        // Resize output buffer. Note, we use the full size of the trace buffer, as
+        // this is a lot more stable than the actual occupancy of the trace buffer.
+        bufferResize(bufp->m_size);
+        // Copy to output buffer
+        const size_t usedSize = bufp->m_writep - bufp->m_bufp;
+        std::memcpy(m_writep, bufp->m_bufp, usedSize * sizeof(uint32_t));
+        m_writep += usedSize;
+        // Flush if necessary
+        bufferCheck();
+        // Put buffer back on free list
+        m_freeBuffers.emplace_back(bufp->m_bufp, bufp->m_size);
+    } else {
+        // Needs adjusting for emitTimeChange
+        m_writep = bufp->m_writep;
+    }
+    delete bufp;
+}
+
+//=============================================================================
+// VerilatedBinBuffer implementation
+
+void VerilatedBinBuffer::finishRecord(uint32_t* writep) {
+    m_writep = writep;
+    if (m_owner.parallel()) {
+        // Double the size of the buffer if necessary
+        if (VL_UNLIKELY(m_writep >= m_growp)) {
+            const size_t usedSize = m_writep - m_bufp;
+            m_size *= 2;
+            uint32_t* const newBufp = new uint32_t[m_size];
+            std::memcpy(newBufp, m_bufp, usedSize * sizeof(uint32_t));
+            delete[] m_bufp;
+            m_bufp = newBufp;
+            m_writep = m_bufp + usedSize;
+            adjustGrowp();
+        }
+    } else {
+        // Flush the write buffer if there's not enough space left for new information
+        if (VL_UNLIKELY(m_writep > m_wrFlushp)) {
+            m_owner.m_writep = m_writep;
+            m_owner.bufferFlush();
+            m_writep = m_owner.m_writep;
+        }
+    }
+}
+
+//=============================================================================
+// emit* trace routines
+
+// Note: emit* are only ever called from one place (full* in
+// verilated_trace_imp.h, which is included in this file at the top),
+// so always inline them.
+
+VL_ATTR_ALWINLINE
+void VerilatedBinBuffer::emitEvent(uint32_t code) {
+    uint32_t* const wp = m_writep;
+    wp[0] = code;
+    finishRecord(wp + 1);
+}
+
+VL_ATTR_ALWINLINE
+void VerilatedBinBuffer::emitBit(uint32_t code, CData newval) {
+    uint32_t* const wp = m_writep;
+    wp[0] = code;
+    wp[1] = newval;
+    finishRecord(wp + 2);
+}
+
+VL_ATTR_ALWINLINE
+void VerilatedBinBuffer::emitCData(uint32_t code, CData newval, int bits) {
+    uint32_t* const wp = m_writep;
+    wp[0] = code;
+    wp[1] = newval;
+    finishRecord(wp + 2);
+}
+
+VL_ATTR_ALWINLINE
+void VerilatedBinBuffer::emitSData(uint32_t code, SData newval, int bits) {
+    uint32_t* const wp = m_writep;
+    wp[0] = code;
+    wp[1] = newval;
+    finishRecord(wp + 2);
+}
+
+VL_ATTR_ALWINLINE
+void VerilatedBinBuffer::emitIData(uint32_t code, IData newval, int bits) {
+    uint32_t* const wp = m_writep;
+    wp[0] = code;
+    wp[1] = newval;
+    finishRecord(wp + 2);
+}
+
+VL_ATTR_ALWINLINE
+void VerilatedBinBuffer::emitQData(uint32_t code, QData newval, int bits) {
+    uint32_t* const wp = m_writep;
+    wp[0] = code;
+    wp[1] = static_cast<uint32_t>(newval);
+    wp[2] = static_cast<uint32_t>(newval >> 32ULL);
+    finishRecord(wp + 3);
+}
+
+VL_ATTR_ALWINLINE
+void VerilatedBinBuffer::emitWData(uint32_t code, const WData* newvalp, int bits) {
+    const int words = VL_WORDS_I(bits);
+    uint32_t* const wp = m_writep;
+    wp[0] = code;
+    std::memcpy(wp + 1, newvalp, words * sizeof(uint32_t));
+    finishRecord(wp + 1 + words);
+}
+
+VL_ATTR_ALWINLINE
+void VerilatedBinBuffer::emitDouble(uint32_t code, double newval) {
+    uint32_t* const wp = m_writep;
+    wp[0] = code;
+    std::memcpy(wp + 1, &newval, sizeof(newval));
+    finishRecord(wp + 3);
+}
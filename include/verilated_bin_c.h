@@ -0,0 +1,306 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//=============================================================================
+//
+// Code available from: https://verilator.org
+//
+// Copyright 2025 by Wilson Snyder. This program is free software; you
+// can redistribute it and/or modify it under the terms of either the GNU
+// Lesser General Public License Version 3 or the Perl Artistic License
+// Version 2.0.
+// SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+//
+//=============================================================================
+///
+/// \file
+/// \brief Verilated tracing in raw binary format header
+///
+/// User wrapper code should use this header when creating binary traces.
+///
+/// The binary format stores value changes with minimal encoding, so dumping
+/// costs little more than copying the changed values. Use
+/// verilator_trace2vcd to convert the result to VCD after simulation.
+///
+//=============================================================================
+
+#ifndef VERILATOR_VERILATED_BIN_C_H_
+#define VERILATOR_VERILATED_BIN_C_H_
+
+#include "verilated.h"
+#include "verilated_trace.h"
+
+#include <string>
+#include <vector>
+
+class VerilatedBinBuffer;
+
+//=============================================================================
+// VerilatedBin
+// Base class to create a Verilator binary dump
+// This is an internally used class - see VerilatedBinC for what to call from applications
+//
+// File layout, all words are 32 bit unsigned in host byte order:
+// - 8 byte magic "VLTRBIN1"
+// - Word 0x01020304, to detect the byte order
+// - Word with the number of bytes of declarations that follow
+// - Declarations, as VCD header text, except each $var has the trace code
+//   in decimal in place of the VCD identifier. NUL padded to a word boundary.
+// - Records, each a code word followed by the value. Code 0 is a time
+//   change followed by 2 words of time, least significant first. Otherwise
+//   the value takes 0 words for events, 2 for reals, and one word per 32
+//   bits, least significant first, for everything else.
+
+class VerilatedBin VL_NOT_FINAL : public VerilatedTrace<VerilatedBin, VerilatedBinBuffer> {
+public:
+    using Super = VerilatedTrace<VerilatedBin, VerilatedBinBuffer>;
+
+private:
+    friend VerilatedBinBuffer;  // Give the buffer access to the private bits
+
+    //=========================================================================
+    // Binary format specific internals
+
+    int m_fd = -1;  // File descriptor we're writing to
+    bool m_isOpen = false;  // True indicates open file
+    std::string m_filename;  // Filename we're writing to (if open)
+    int m_indent = 0;  // Indentation depth of declarations
+    std::string m_decls;  // Declarations, only while opening
+
+    uint32_t* m_wrBufp;  // Output buffer
+    uint32_t* m_wrFlushp;  // Output buffer flush trigger location
+    uint32_t* m_writep;  // Write pointer into output buffer
+    size_t m_wrChunkSize;  // Output buffer size, in words
+    size_t m_maxSignalWords = 0;  // Upper bound on number of words a single signal can generate
+
+    // Prefixes to add to signal names/scope types
+    std::vector<std::pair<std::string, VerilatedTracePrefixType>> m_prefixStack{
+        {"", VerilatedTracePrefixType::SCOPE_MODULE}};
+
+    // Vector of free trace buffers as (pointer, size in words) pairs.
+    std::vector<std::pair<uint32_t*, size_t>> m_freeBuffers;
+    size_t m_numBuffers = 0;  // Number of trace buffers allocated
+
+    void bufferResize(size_t minsize);
+    void bufferFlush() VL_MT_UNSAFE_ONE;
+    void bufferCheck() {
+        // Flush the write buffer if there's not enough space left for new information
+        if (VL_UNLIKELY(m_writep > m_wrFlushp)) bufferFlush();
+    }
+    void writeBytes(const char* bufp, size_t len);
+    void closeErr();
+    void printIndent(int level_change);
+    void declare(uint32_t code, const char* name, const char* wirep, bool array, int arraynum,
+                 bool bussed, int msb, int lsb);
+
+    // CONSTRUCTORS
+    VL_UNCOPYABLE(VerilatedBin);
+
+protected:
+    //=========================================================================
+    // Implementation of VerilatedTrace interface
+
+    // Called when the trace moves forward to a new time point
+    void emitTimeChange(uint64_t timeui) override;
+
+    // Hooks called from VerilatedTrace
+    bool preFullDump() override { return isOpen(); }
+    bool preChangeDump() override { return isOpen(); }
+
+    // Trace buffer management
+    Buffer* getTraceBuffer(uint32_t fidx) override;
+    void commitTraceBuffer(Buffer*) override;
+
+    // Configure sub-class
+    void configure(const VerilatedTraceConfig&) override{};
+
+public:
+    //=========================================================================
+    // External interface to client code
+
+    // CONSTRUCTOR
+    VerilatedBin();
+    ~VerilatedBin();
+
+    // METHODS - All must be thread safe
+    // Open the file; call isOpen() to see if errors
+    void open(const char* filename) VL_MT_SAFE_EXCLUDES(m_mutex);
+    // Close the file
+    void close() VL_MT_SAFE_EXCLUDES(m_mutex);
+    // Flush any remaining data to this file
+    void flush() VL_MT_SAFE_EXCLUDES(m_mutex);
+    // Return if file is open
+    bool isOpen() const VL_MT_SAFE { return m_isOpen; }
+
+    //=========================================================================
+    // Internal interface to Verilator generated code
+
+    void pushPrefix(const std::string&, VerilatedTracePrefixType);
+    void popPrefix();
+
+    void declEvent(uint32_t code, uint32_t fidx, const char* name, int dtypenum,
+                   VerilatedTraceSigDirection, VerilatedTraceSigKind, VerilatedTraceSigType,
+                   bool array, int arraynum);
+    void declBit(uint32_t code, uint32_t fidx, const char* name, int dtypenum,
+                 VerilatedTraceSigDirection, VerilatedTraceSigKind, VerilatedTraceSigType,
+                 bool array, int arraynum);
+    void declBus(uint32_t code, uint32_t fidx, const char* name, int dtypenum,
+                 VerilatedTraceSigDirection, VerilatedTraceSigKind, VerilatedTraceSigType,
+                 bool array, int arraynum, int msb, int lsb);
+    void declQuad(uint32_t code, uint32_t fidx, const char* name, int dtypenum,
+                  VerilatedTraceSigDirection, VerilatedTraceSigKind, VerilatedTraceSigType,
+                  bool array, int arraynum, int msb, int lsb);
+    void declArray(uint32_t code, uint32_t fidx, const char* name, int dtypenum,
+                   VerilatedTraceSigDirection, VerilatedTraceSigKind, VerilatedTraceSigType,
+                   bool array, int arraynum, int msb, int lsb);
+    void declDouble(uint32_t code, uint32_t fidx, const char* name, int dtypenum,
+                    VerilatedTraceSigDirection, VerilatedTraceSigKind, VerilatedTraceSigType,
+                    bool array, int arraynum);
+};
+
+#ifndef DOXYGEN
+// Declare specialization here as it's used in VerilatedBinC just below
+template <>
+void VerilatedBin::Super::dump(uint64_t time);
+template <>
+void VerilatedBin::Super::set_time_unit(const char* unitp);
+template <>
+void VerilatedBin::Super::set_time_unit(const std::string& unit);
+template <>
+void VerilatedBin::Super::set_time_resolution(const char* unitp);
+template <>
+void VerilatedBin::Super::set_time_resolution(const std::string& unit);
+template <>
+void VerilatedBin::Super::dumpvars(int level, const std::string& hier);
+template <>
+void VerilatedBin::Super::traceScopes(const std::string& scopes);
+template <>
+void VerilatedBin::Super::flightRecorder(uint64_t cycles);
+template <>
+void VerilatedBin::Super::flightRecorderTrigger();
+#endif  // DOXYGEN
+
+//=============================================================================
+// VerilatedBinBuffer
+
+class VerilatedBinBuffer VL_NOT_FINAL {
+    // Give the trace file and sub-classes access to the private bits
+    friend VerilatedBin;
+    friend VerilatedBin::Super;
+    friend VerilatedBin::Buffer;
+    friend VerilatedBin::OffloadBuffer;
+
+    VerilatedBin& m_owner;  // Trace file owning this buffer. Required by subclasses.
+
+    // Write pointer into output buffer (in parallel mode, this is set up in 'getTraceBuffer')
+    uint32_t* m_writep = m_owner.parallel() ? nullptr : m_owner.m_writep;
+    // Output buffer flush trigger location (only used when not parallel)
+    uint32_t* const m_wrFlushp = m_owner.parallel() ? nullptr : m_owner.m_wrFlushp;
+
+    // The maximum number of words a single signal can emit
+    const size_t m_maxSignalWords = m_owner.m_maxSignalWords;
+
+    // Additional data for parallel tracing only
+    uint32_t* m_bufp = nullptr;  // The beginning of the trace buffer
+    size_t m_size = 0;  // The size of the buffer at m_bufp, in words
+    uint32_t* m_growp = nullptr;  // Resize limit pointer
+
+    void adjustGrowp() {
+        m_growp = (m_bufp + m_size) - (2 * m_maxSignalWords);
+        assert(m_growp >= m_bufp + m_maxSignalWords);
+    }
+
+    void finishRecord(uint32_t* writep);
+
+    // CONSTRUCTOR
+    explicit VerilatedBinBuffer(VerilatedBin& owner)
+        : m_owner{owner} {}
+    virtual ~VerilatedBinBuffer() = default;
+
+    //=========================================================================
+    // Implementation of VerilatedTraceBuffer interface
+    // Implementations of duck-typed methods for VerilatedTraceBuffer. These are
+    // called from only one place (the full* methods), so always inline them.
+    VL_ATTR_ALWINLINE void emitEvent(uint32_t code);
+    VL_ATTR_ALWINLINE void emitBit(uint32_t code, CData newval);
+    VL_ATTR_ALWINLINE void emitCData(uint32_t code, CData newval, int bits);
+    VL_ATTR_ALWINLINE void emitSData(uint32_t code, SData newval, int bits);
+    VL_ATTR_ALWINLINE void emitIData(uint32_t code, IData newval, int bits);
+    VL_ATTR_ALWINLINE void emitQData(uint32_t code, QData newval, int bits);
+    VL_ATTR_ALWINLINE void emitWData(uint32_t code, const WData* newvalp, int bits);
+    VL_ATTR_ALWINLINE void emitDouble(uint32_t code, double newval);
+};
+
+//=============================================================================
+// VerilatedBinC
+/// Class representing a binary dump file in C standalone (no SystemC)
+/// simulations.  Also derived for use in SystemC simulations.
+
+class VerilatedBinC VL_NOT_FINAL : public VerilatedTraceBaseC {
+    VerilatedBin m_sptrace;  // Trace file being created
+
+    // CONSTRUCTORS
+    VL_UNCOPYABLE(VerilatedBinC);
+
+public:
+    /// Construct the dump
+    VerilatedBinC() = default;
+    /// Destruct, flush, and close the dump
+    virtual ~VerilatedBinC() { close(); }
+
+    // METHODS - User called
+
+    /// Return if file is open
+    bool isOpen() const override VL_MT_SAFE { return m_sptrace.isOpen(); }
+    /// Open a new binary dump file
+    virtual void open(const char* filename) VL_MT_SAFE { m_sptrace.open(filename); }
+    /// Close dump
+    void close() VL_MT_SAFE {
+        m_sptrace.close();
+        modelConnected(false);
+    }
+    /// Flush dump
+    void flush() VL_MT_SAFE { m_sptrace.flush(); }
+    /// Write one cycle of dump data
+    /// Call with the current context's time just after eval'ed,
+    /// e.g. ->dump(contextp->time())
+    void dump(uint64_t timeui) VL_MT_SAFE { m_sptrace.dump(timeui); }
+    /// Write one cycle of dump data - backward compatible and to reduce
+    /// conversion warnings.  It's better to use a uint64_t time instead.
+    void dump(double timestamp) { dump(static_cast<uint64_t>(timestamp)); }
+    void dump(uint32_t timestamp) { dump(static_cast<uint64_t>(timestamp)); }
+    void dump(int timestamp) { dump(static_cast<uint64_t>(timestamp)); }
+
+    // METHODS - Internal/backward compatible
+    // \protectedsection
+
+    // Set time units (s/ms, defaults to ns)
+    // Users should not need to call this, as for Verilated models, these
+    // propagate from the Verilated default timeunit
+    void set_time_unit(const char* unit) VL_MT_SAFE { m_sptrace.set_time_unit(unit); }
+    void set_time_unit(const std::string& unit) VL_MT_SAFE { m_sptrace.set_time_unit(unit); }
+    // Set time resolution (s/ms, defaults to ns)
+    // Users should not need to call this, as for Verilated models, these
+    // propagate from the Verilated default timeprecision
+    void set_time_resolution(const char* unit) VL_MT_SAFE { m_sptrace.set_time_resolution(unit); }
+    void set_time_resolution(const std::string& unit) VL_MT_SAFE {
+        m_sptrace.set_time_resolution(unit);
+    }
+    // Set variables to dump, using $dumpvars format
+    // If level = 0, dump everything and hier is then ignored
+    void dumpvars(int level, const std::string& hier) VL_MT_SAFE {
+        m_sptrace.dumpvars(level, hier);
+    }
+    /// Trace only signals under the given scopes, see VerilatedTraceBaseC
+    void traceScopes(const std::string& scopes) override VL_MT_SAFE {
+        m_sptrace.traceScopes(scopes);
+    }
+    // Only keep the last 'cycles' dumps in memory, until triggered by
+    // flightRecorderTrigger() or $dumpon. Call before open().
+    void flightRecorder(uint64_t cycles) VL_MT_SAFE { m_sptrace.flightRecorder(cycles); }
+    // Write the flight recorder contents, then continue dumping as normal
+    void flightRecorderTrigger() VL_MT_SAFE { m_sptrace.flightRecorderTrigger(); }
+
+    // Internal class access
+    VerilatedBin* spTrace() { return &m_sptrace; }
+};
+
+#endif  // guard
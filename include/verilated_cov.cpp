@@ -32,6 +32,7 @@
 #include <fstream>
 #include <map>
 #include <utility>
+#include <vector>
 
 //=============================================================================
 // VerilatedCovConst
@@ -90,6 +91,36 @@ public:
     ~VerilatedCoverItemSpec() override = default;
 };
 
+//=============================================================================
+// VerilatedCoverShardItemSpec
+// Coverage item counted separately by each thread, see VL_COVER_INSERT_SHARDS
+
+class VerilatedCoverShardItemSpec final : public VerilatedCovImpItem {
+private:
+    // MEMBERS
+    uint32_t* const m_countp;  // Count value in first shard
+    const size_t m_stride;  // Counters from one shard to the next
+    const uint32_t m_nshards;  // Number of shards
+public:
+    // METHODS
+    uint64_t count() const override {
+        uint64_t sum = 0;
+        for (uint32_t i = 0; i < m_nshards; ++i) sum += m_countp[i * m_stride];
+        return sum;
+    }
+    void zero() const override {
+        for (uint32_t i = 0; i < m_nshards; ++i) m_countp[i * m_stride] = 0;
+    }
+    // CONSTRUCTORS
+    VerilatedCoverShardItemSpec(uint32_t* countp, size_t stride, uint32_t nshards)
+        : m_countp{countp}
+        , m_stride{stride}
+        , m_nshards{nshards} {
+        zero();
+    }
+    ~VerilatedCoverShardItemSpec() override = default;
+};
+
 //=============================================================================
 // VerilatedCovImp
 //
@@ -104,6 +135,7 @@ private:
     using ValueIndexMap = std::map<const std::string, int>;
     using IndexValueMap = std::map<int, std::string>;
     using ItemList = std::deque<VerilatedCovImpItem*>;
+    using EventCounts = std::map<const std::string, std::pair<std::string, uint64_t>>;
 
     // MEMBERS
     VerilatedContext* const m_contextp;  // Context VerilatedCovImp is pointed-to by
@@ -118,6 +150,12 @@ private:
     const char* m_insertFilenamep VL_GUARDED_BY(m_mutex) = nullptr;  // Filename about to insert
     int m_insertLineno VL_GUARDED_BY(m_mutex) = 0;  // Line number about to insert
     bool m_forcePerInstance VL_GUARDED_BY(m_mutex) = false;  // Force per_instance
+    // writeDelta state: the event of each item, and each event's name and count last written
+    std::string m_deltaFilename VL_GUARDED_BY(m_mutex);  // File writeDelta appends to
+    std::vector<size_t> m_deltaItemEvents VL_GUARDED_BY(m_mutex);  // Event of each m_items
+    std::vector<std::string> m_deltaNames VL_GUARDED_BY(m_mutex);  // Name of each event
+    std::vector<uint64_t> m_deltaCounts VL_GUARDED_BY(m_mutex);  // Count of each event written
+    bool m_deltaStale VL_GUARDED_BY(m_mutex) = true;  // Items changed since events were built
 
 public:
     // CONSTRUCTORS
@@ -245,12 +283,126 @@ private:
         SELF_CHECK(combineHier("1.2.3.a", "9.8.7.a"), "*.a");
 #undef SELF_CHECK
     }
+    static void binaryU32(std::string& buf, uint32_t value) VL_PURE {
+        for (int i = 0; i < 4; ++i) buf += static_cast<char>((value >> (i * 8)) & 0xff);
+    }
+    static void binaryU64(std::string& buf, uint64_t value) VL_PURE {
+        for (int i = 0; i < 8; ++i) buf += static_cast<char>((value >> (i * 8)) & 0xff);
+    }
+    static void writeBinary(std::ofstream& os, const EventCounts& eventCounts) VL_MT_SAFE {
+        // See VL_COV_BINARY_MAGIC for the format
+        std::map<const std::string, uint32_t> stringIndexes;
+        std::string strings;
+        std::string points;
+        const auto stringIndex = [&](const std::string& str) -> uint32_t {
+            const auto pair
+                = stringIndexes.emplace(str, static_cast<uint32_t>(stringIndexes.size()));
+            if (pair.second) {
+                binaryU32(strings, static_cast<uint32_t>(str.size()));
+                strings += str;
+            }
+            return pair.first->second;
+        };
+        std::vector<uint32_t> fields;
+        for (const auto& i : eventCounts) {
+            std::string name = i.first;
+            if (!i.second.first.empty()) name += keyValueFormatter(VL_CIK_HIER, i.second.first);
+            // Split into "\001key\002value" fields; dequote removed any other control codes
+            fields.clear();
+            std::string::size_type pos = name.find('\001');
+            while (pos != std::string::npos) {
+                const std::string::size_type valPos = name.find('\002', pos);
+                const std::string::size_type endPos = name.find('\001', valPos);
+                fields.push_back(stringIndex(name.substr(pos + 1, valPos - pos - 1)));
+                fields.push_back(stringIndex(name.substr(
+                    valPos + 1, endPos == std::string::npos ? endPos : endPos - valPos - 1)));
+                pos = endPos;
+            }
+            binaryU32(points, static_cast<uint32_t>(fields.size() / 2));
+            for (const uint32_t field : fields) binaryU32(points, field);
+            binaryU64(points, i.second.second);
+        }
+        std::string header{VL_COV_BINARY_MAGIC};
+        binaryU32(header, static_cast<uint32_t>(stringIndexes.size()));
+        os.write(header.data(), header.size());
+        os.write(strings.data(), strings.size());
+        header.clear();
+        binaryU64(header, eventCounts.size());
+        os.write(header.data(), header.size());
+        os.write(points.data(), points.size());
+    }
+
     void clearGuts() VL_REQUIRES(m_mutex) {
         for (const auto& itemp : m_items) VL_DO_DANGLING(delete itemp, itemp);
         m_items.clear();
         m_indexValues.clear();
         m_valueIndexes.clear();
         m_nextIndex = VerilatedCovConst::KEY_UNDEF + 1;
+        m_deltaStale = true;
+    }
+    // Name of the event an item counts, and its hierarchy if that is collapsed
+    void itemName(const VerilatedCovImpItem* itemp, std::string& name,
+                  std::string& hier) const VL_REQUIRES(m_mutex) {
+        bool per_instance = false;
+        if (m_forcePerInstance) per_instance = true;
+
+        for (int i = 0; i < VerilatedCovConst::MAX_KEYS; ++i) {
+            if (itemp->m_keys[i] != VerilatedCovConst::KEY_UNDEF) {
+                const std::string key
+                    = VerilatedCovKey::shortKey(m_indexValues.at(itemp->m_keys[i]));
+                const std::string val = m_indexValues.at(itemp->m_vals[i]);
+                if (key == VL_CIK_PER_INSTANCE) {
+                    if (val != "0") per_instance = true;
+                }
+                if (key == VL_CIK_HIER) {
+                    hier = val;
+                } else {
+                    // Print it
+                    if (key == "page") {
+                        const std::string type = val.substr(2, val.find('/') - 2);
+                        name += keyValueFormatter(VL_CIK_TYPE, type);
+                    }
+                    name += keyValueFormatter(key, val);
+                }
+            }
+        }
+        if (per_instance) {  // Not collapsing hierarchies
+            name += keyValueFormatter(VL_CIK_HIER, hier);
+            hier = "";
+        }
+    }
+    // Group the items into events for writeDelta, keeping the counts already written
+    void deltaBuild(bool keepCounts) VL_REQUIRES(m_mutex) {
+        std::map<std::string, uint64_t> written;
+        if (keepCounts) {
+            for (size_t i = 0; i < m_deltaNames.size(); ++i) {
+                written.emplace(m_deltaNames[i], m_deltaCounts[i]);
+            }
+        }
+        std::map<std::string, size_t> nameEvents;
+        std::vector<std::string> hiers;
+        m_deltaItemEvents.clear();
+        m_deltaNames.clear();
+        for (const auto& itemp : m_items) {
+            std::string name;
+            std::string hier;
+            itemName(itemp, name, hier);
+            const auto pair = nameEvents.emplace(name, m_deltaNames.size());
+            if (pair.second) {
+                m_deltaNames.push_back(name);
+                hiers.push_back(hier);
+            } else {
+                hiers[pair.first->second] = combineHier(hiers[pair.first->second], hier);
+            }
+            m_deltaItemEvents.push_back(pair.first->second);
+        }
+        m_deltaCounts.assign(m_deltaNames.size(), 0);
+        for (size_t i = 0; i < m_deltaNames.size(); ++i) {
+            if (!hiers[i].empty()) m_deltaNames[i] += keyValueFormatter(VL_CIK_HIER, hiers[i]);
+            const auto it = written.find(m_deltaNames[i]);
+            if (it != written.end()) m_deltaCounts[i] = it->second;
+        }
+        m_deltaStale = false;
     }
 
 public:
@@ -260,6 +412,7 @@ public:
         Verilated::quiesce();
         const VerilatedLockGuard lock{m_mutex};
         m_forcePerInstance = flag;
+        m_deltaStale = true;
     }
     void clear() VL_MT_SAFE_EXCLUDES(m_mutex) {
         Verilated::quiesce();
@@ -279,6 +432,7 @@ public:
                 }
             }
             m_items = newlist;
+            m_deltaStale = true;
         }
     }
     void zero() VL_MT_SAFE_EXCLUDES(m_mutex) {
@@ -353,6 +507,7 @@ public:
             }
         }
         m_items.push_back(m_insertp);
+        m_deltaStale = true;
         // Prepare for next
         m_insertp = nullptr;
     }
@@ -362,46 +517,20 @@ public:
         const VerilatedLockGuard lock{m_mutex};
         selftest();
 
-        std::ofstream os{filename};
+        const bool binary = m_contextp->coverageBinary();
+        std::ofstream os{filename, binary ? std::ios::out | std::ios::binary : std::ios::out};
         if (os.fail()) {
             const std::string msg = "%Error: Can't write '"s + filename + "'";
             VL_FATAL_MT("", 0, "", msg.c_str());
             return;
         }
-        os << "# SystemC::Coverage-3\n";
 
         // Build list of events; totalize if collapsing hierarchy
-        std::map<const std::string, std::pair<std::string, uint64_t>> eventCounts;
+        EventCounts eventCounts;
         for (const auto& itemp : m_items) {
             std::string name;
             std::string hier;
-            bool per_instance = false;
-            if (m_forcePerInstance) per_instance = true;
-
-            for (int i = 0; i < VerilatedCovConst::MAX_KEYS; ++i) {
-                if (itemp->m_keys[i] != VerilatedCovConst::KEY_UNDEF) {
-                    const std::string key
-                        = VerilatedCovKey::shortKey(m_indexValues[itemp->m_keys[i]]);
-                    const std::string val = m_indexValues[itemp->m_vals[i]];
-                    if (key == VL_CIK_PER_INSTANCE) {
-                        if (val != "0") per_instance = true;
-                    }
-                    if (key == VL_CIK_HIER) {
-                        hier = val;
-                    } else {
-                        // Print it
-                        if (key == "page") {
-                            const std::string type = val.substr(2, val.find('/') - 2);
-                            name += keyValueFormatter(VL_CIK_TYPE, type);
-                        }
-                        name += keyValueFormatter(key, val);
-                    }
-                }
-            }
-            if (per_instance) {  // Not collapsing hierarchies
-                name += keyValueFormatter(VL_CIK_HIER, hier);
-                hier = "";
-            }
+            itemName(itemp, name, hier);
 
             // Group versus point labels don't matter here, downstream
             // deals with it.  Seems bad for sizing though and doesn't
@@ -419,7 +548,13 @@ public:
             }
         }
 
+        if (binary) {
+            writeBinary(os, eventCounts);
+            return;
+        }
+
         // Output body
+        os << "# SystemC::Coverage-3\n";
         for (const auto& i : eventCounts) {
             os << "C '" << std::dec;
             os << i.first;
@@ -428,6 +563,40 @@ public:
             os << '\n';
         }
     }
+
+    void writeDelta(const std::string& filename) VL_MT_SAFE_EXCLUDES(m_mutex) {
+        Verilated::quiesce();
+        const VerilatedLockGuard lock{m_mutex};
+        const bool fresh = filename != m_deltaFilename;
+        if (fresh || m_deltaStale) deltaBuild(!fresh);
+
+        std::ofstream os{filename, fresh ? std::ios::out : std::ios::out | std::ios::app};
+        if (os.fail()) {
+            const std::string msg = "%Error: Can't write '"s + filename + "'";
+            VL_FATAL_MT("", 0, "", msg.c_str());
+            return;
+        }
+        m_deltaFilename = filename;
+
+        std::vector<uint64_t> counts(m_deltaNames.size(), 0);
+        for (size_t i = 0; i < m_items.size(); ++i) {
+            counts[m_deltaItemEvents[i]] += m_items[i]->count();
+        }
+        // A new file lists every point, later writes only the points that changed. As points
+        // are summed when read, the file holds the current counts after every write.
+        std::string buf;
+        if (fresh) buf += "# SystemC::Coverage-3\n";
+        for (size_t i = 0; i < counts.size(); ++i) {
+            // If zeroed since the last write, all of the count is new
+            if (counts[i] < m_deltaCounts[i]) m_deltaCounts[i] = 0;
+            if (fresh || counts[i] != m_deltaCounts[i]) {
+                buf += "C '" + m_deltaNames[i] + "' "
+                       + std::to_string(counts[i] - m_deltaCounts[i]) + '\n';
+                m_deltaCounts[i] = counts[i];
+            }
+        }
+        os.write(buf.data(), buf.size());
+    }
 };
 
 //=============================================================================
@@ -445,9 +614,15 @@ void VerilatedCovContext::zero() VL_MT_SAFE { impp()->zero(); }
 void VerilatedCovContext::write(const std::string& filename) VL_MT_SAFE {
     impp()->write(filename);
 }
+void VerilatedCovContext::writeDelta(const std::string& filename) VL_MT_SAFE {
+    impp()->writeDelta(filename);
+}
 void VerilatedCovContext::_inserti(uint32_t* itemp) VL_MT_SAFE {
     impp()->inserti(new VerilatedCoverItemSpec<uint32_t>{itemp});
 }
+void VerilatedCovContext::_inserti(uint32_t* itemp, size_t stride, uint32_t nshards) VL_MT_SAFE {
+    impp()->inserti(new VerilatedCoverShardItemSpec{itemp, stride, nshards});
+}
 void VerilatedCovContext::_inserti(uint64_t* itemp) VL_MT_SAFE {
     impp()->inserti(new VerilatedCoverItemSpec<uint64_t>{itemp});
 }
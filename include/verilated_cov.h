@@ -29,9 +29,11 @@
 
 #include "verilated.h"
 
+#include <algorithm>
 #include <iostream>
 #include <sstream>
 #include <string>
+#include <vector>
 
 class VerilatedCovImp;
 
@@ -75,6 +77,17 @@ class VerilatedCovImp;
         ccontextp->_insertp("hier", name, __VA_ARGS__); \
     } while (false)
 
+/// As VL_COVER_INSERT, but the count is the sum of nshards counters,
+/// each stride counters after the previous, starting at countp.
+
+#define VL_COVER_INSERT_SHARDS(covcontextp, name, countp, stride, nshards, ...) \
+    do { \
+        auto const ccontextp = covcontextp; \
+        ccontextp->_inserti(countp, stride, nshards); \
+        ccontextp->_insertf(__FILE__, __LINE__); \
+        ccontextp->_insertp("hier", name, __VA_ARGS__); \
+    } while (false)
+
 //=============================================================================
 //  VerilatedCov
 /// Per-VerilatedContext coverage data class.
@@ -95,6 +108,11 @@ public:
     /// Write all coverage data to a file
     void write() VL_MT_SAFE { write(defaultFilename()); }
     void write(const std::string& filename) VL_MT_SAFE;
+    /// Append the counts added since the previous writeDelta() to a coverage data file.
+    /// The first call with a filename creates the file listing every point, and later
+    /// calls append only the points that changed, so the file always reads as the
+    /// current coverage, and the counts written before a run is killed are kept.
+    void writeDelta(const std::string& filename) VL_MT_SAFE;
     /// Clear coverage points (and call delete on all items)
     void clear() VL_MT_SAFE;
     /// Clear items not matching the provided string
@@ -111,6 +129,7 @@ public:
     // _insert1: Remember item pointer with count.  (Not const, as may add zeroing function)
     void _inserti(uint32_t* itemp) VL_MT_SAFE;
     void _inserti(uint64_t* itemp) VL_MT_SAFE;
+    void _inserti(uint32_t* itemp, size_t stride, uint32_t nshards) VL_MT_SAFE;
     // _insert2: Set default filename and line number
     void _insertf(const char* filename, int lineno) VL_MT_SAFE;
     // _insert3: Set parameters
@@ -148,6 +167,122 @@ protected:
     VerilatedCovImp* impp() VL_MT_SAFE { return reinterpret_cast<VerilatedCovImp*>(this); }
 };
 
+//=============================================================================
+//  VerilatedCovBins
+/// Mapping of sampled values to functional coverage bins, each a set of
+/// value ranges, with a count of the samples hitting it. As ranges of
+/// different bins may overlap, a sample can increment several bins.
+///
+/// Ranges are all added before the first sample. The first sample then
+/// splits them into disjoint segments, each with the list of bins it hits,
+/// so a sample is a single lookup: a direct table index when the values
+/// span a small domain, else a binary search of the segment starts.
+/// The counts may be inserted into a VerilatedCovContext with
+/// VL_COVER_INSERT, using countp().
+
+class VerilatedCovBins final {
+    VL_UNCOPYABLE(VerilatedCovBins);
+
+    // Maximum number of values in domain to use a direct lookup table
+    static constexpr uint64_t DIRECT_MAX = 4096;
+    static constexpr uint32_t NO_SEGMENT = ~0U;
+
+    // TYPES
+    struct Range final {
+        uint64_t m_lo;  // Lowest value in range
+        uint64_t m_hi;  // Highest value in range
+        uint32_t m_bin;  // Bin the range is part of
+    };
+
+    // MEMBERS
+    std::vector<uint64_t> m_counts;  // Count of samples per bin
+    std::vector<Range> m_ranges;  // Ranges added
+    bool m_built = false;  // Segments built from m_ranges
+    std::vector<uint64_t> m_segStarts;  // Lowest value of each segment, sorted
+    std::vector<uint32_t> m_segBinsOffset;  // Per segment, index in m_segBins, plus one at end
+    std::vector<uint32_t> m_segBins;  // Bins hit by each segment, in segment order
+    uint64_t m_directLo = 0;  // Lowest value in m_direct
+    std::vector<uint32_t> m_direct;  // Segment of each value from m_directLo, or NO_SEGMENT
+
+    // METHODS
+    void build() {
+        m_built = true;
+        if (m_ranges.empty()) return;
+        // Segment boundaries, a segment ends where the next one starts.
+        // Unless a range reaches the maximum value, the last segment is above all ranges.
+        std::vector<uint64_t> bounds;
+        bool toMax = false;  // A range includes the maximum value
+        for (const Range& range : m_ranges) {
+            bounds.push_back(range.m_lo);
+            if (range.m_hi == ~0ULL) {
+                toMax = true;
+            } else {
+                bounds.push_back(range.m_hi + 1);
+            }
+        }
+        std::sort(bounds.begin(), bounds.end());
+        bounds.erase(std::unique(bounds.begin(), bounds.end()), bounds.end());
+        for (size_t i = 0; i < bounds.size(); ++i) {
+            const uint64_t lo = bounds[i];
+            const uint64_t hi = i + 1 < bounds.size() ? bounds[i + 1] - 1 : ~0ULL;
+            m_segStarts.push_back(lo);
+            m_segBinsOffset.push_back(static_cast<uint32_t>(m_segBins.size()));
+            for (const Range& range : m_ranges) {
+                if (range.m_lo <= lo && hi <= range.m_hi) m_segBins.push_back(range.m_bin);
+            }
+        }
+        m_segBinsOffset.push_back(static_cast<uint32_t>(m_segBins.size()));
+        // Direct table for small domains
+        const uint64_t lo = m_segStarts.front();
+        const uint64_t hi = toMax ? ~0ULL : bounds.back() - 1;
+        if (hi - lo < DIRECT_MAX) {
+            m_directLo = lo;
+            m_direct.resize(hi - lo + 1);
+            uint32_t seg = 0;
+            for (uint64_t value = lo; value <= hi; ++value) {
+                while (seg + 1 < m_segStarts.size() && m_segStarts[seg + 1] <= value) ++seg;
+                m_direct[value - lo] = seg;
+            }
+        }
+    }
+    uint32_t findSegment(uint64_t value) const {
+        if (!m_direct.empty()) {
+            if (value < m_directLo || value - m_directLo >= m_direct.size()) return NO_SEGMENT;
+            return m_direct[value - m_directLo];
+        }
+        const auto it = std::upper_bound(m_segStarts.begin(), m_segStarts.end(), value);
+        if (it == m_segStarts.begin()) return NO_SEGMENT;
+        return static_cast<uint32_t>(it - m_segStarts.begin() - 1);
+    }
+
+public:
+    // CONSTRUCTORS
+    explicit VerilatedCovBins(uint32_t nBins)
+        : m_counts(nBins, 0) {}
+    ~VerilatedCovBins() = default;
+
+    // METHODS
+    /// Add values lo to hi inclusive to a bin, must be before the first sample()
+    void addRange(uint32_t bin, uint64_t lo, uint64_t hi) {
+        VL_DEBUG_IFDEF(assert(!m_built && bin < m_counts.size() && lo <= hi););
+        m_ranges.push_back({lo, hi, bin});
+    }
+    /// Count a sampled value in each of the bins it hits
+    void sample(uint64_t value) {
+        if (VL_UNLIKELY(!m_built)) build();
+        const uint32_t seg = findSegment(value);
+        if (seg == NO_SEGMENT) return;
+        for (uint32_t i = m_segBinsOffset[seg]; i < m_segBinsOffset[seg + 1]; ++i) {
+            ++m_counts[m_segBins[i]];
+        }
+    }
+    /// Number of bins
+    uint32_t size() const { return static_cast<uint32_t>(m_counts.size()); }
+    /// Count of a bin, for VL_COVER_INSERT
+    uint64_t* countp(uint32_t bin) { return &m_counts[bin]; }
+    uint64_t count(uint32_t bin) const { return m_counts[bin]; }
+};
+
 //=============================================================================
 //  VerilatedCov
 /// Coverage global class.
@@ -58,6 +58,17 @@ VLCOVGEN_ITEM("'name':'weight',      'short':'w',  'group':0, 'default':None, 'd
 #define VL_CIK_WEIGHT "w"
 // VLCOVGEN_CIK_AUTO_EDIT_END
 
+//=============================================================================
+// Binary coverage file, written with +verilator+coverage+binary
+// All integers are little endian:
+//   magic[8]                           VL_COV_BINARY_MAGIC
+//   u32 nstrings, {u32 len, char[len]}  String table: keys and values
+//   u64 npoints, {u32 nfields, {u32 key, u32 value}[nfields], u64 count}
+// A point's name is the text format's "\001key\002value..." of its fields
+
+#define VL_COV_BINARY_MAGIC "VlCovB1\n"
+#define VL_COV_BINARY_MAGIC_LEN 8
+
 //=============================================================================
 // VerilatedCovKey
 // Namespace-style static class for \internal use.
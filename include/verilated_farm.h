@@ -0,0 +1,142 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//=============================================================================
+//
+// Code available from: https://verilator.org
+//
+// Copyright 2025 by Wilson Snyder. This program is free software; you
+// can redistribute it and/or modify it under the terms of either the GNU
+// Lesser General Public License Version 3 or the Perl Artistic License
+// Version 2.0.
+// SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+//
+//=============================================================================
+///
+/// \file
+/// \brief Verilated simulation farm header
+///
+/// This may be included in user wrapper code that runs many independent
+/// instances of a model in one process, e.g. the same test with different
+/// seeds.  Each instance gets its own VerilatedContext, and the instances
+/// are spread over a pool of worker threads, one instance per worker at a
+/// time.  Only one copy of the model code exists in the process.
+///
+//=============================================================================
+
+#ifndef VERILATOR_VERILATED_FARM_H_
+#define VERILATOR_VERILATED_FARM_H_
+
+#include "verilatedos.h"
+
+#include "verilated.h"
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+//=============================================================================
+// VerilatedFarm
+/// Run many model instances, each in its own VerilatedContext, across a
+/// pool of worker threads.
+///
+/// Example:
+///
+///     VerilatedFarm farm;
+///     farm.commandArgs(argc, argv);
+///     const unsigned failed = farm.run(100, [](VerilatedContext* contextp, unsigned) {
+///         const std::unique_ptr<Vtop> topp{new Vtop{contextp}};
+///         while (!contextp->gotFinish()) { topp->eval(); contextp->timeInc(1); }
+///         topp->final();
+///         contextp->coveragep()->write();
+///     });
+
+class VerilatedFarm final {
+public:
+    // TYPES
+    /// Simulate one instance: construct the model under the given context,
+    /// run it to completion and write its outputs.  Called on a worker thread.
+    using RunFunc = std::function<void(VerilatedContext* contextp, unsigned index)>;
+
+private:
+    // MEMBERS
+    unsigned m_workers;  // Number of worker threads
+    int m_seedBase = 1;  // Random seed of instance 0
+    std::vector<std::string> m_args;  // Command arguments given to every instance
+
+public:
+    // CONSTRUCTORS
+    /// Create a farm with the given number of workers, 0 = one per hardware thread
+    explicit VerilatedFarm(unsigned workers = 0)
+        : m_workers{workers ? workers : std::thread::hardware_concurrency()} {
+        if (!m_workers) m_workers = 1;
+    }
+    ~VerilatedFarm() = default;
+    VL_UNCOPYABLE(VerilatedFarm);
+
+    // METHODS
+    /// Return number of worker threads
+    unsigned workers() const { return m_workers; }
+    /// Return random seed of instance 0; instance N uses seedBase() + N
+    int seedBase() const { return m_seedBase; }
+    /// Set random seed of instance 0; must not be 0, which would pick random seeds
+    void seedBase(int value) { m_seedBase = value; }
+    /// Set command arguments given to every instance's VerilatedContext
+    void commandArgs(int argc, const char** argv) { m_args.assign(argv, argv + argc); }
+    void commandArgs(int argc, char** argv) { commandArgs(argc, const_cast<const char**>(argv)); }
+
+    /// Return a filename made unique to an instance, by inserting "_<index>"
+    /// before the extension, e.g. "dump.vcd" becomes "dump_3.vcd"
+    static std::string instanceFilename(const std::string& filename, unsigned index) {
+        const std::string suffix = "_" + std::to_string(index);
+        const size_t slash = filename.find_last_of('/');
+        const size_t dot = filename.find_last_of('.');
+        if (dot == std::string::npos || dot == 0
+            || (slash != std::string::npos && dot <= slash + 1)) {
+            return filename + suffix;
+        }
+        return filename.substr(0, dot) + suffix + filename.substr(dot);
+    }
+
+    /// Simulate 'instances' instances by calling 'func' for each, and
+    /// return when all have completed.  Each context is created with one
+    /// thread, the farm's command arguments, a random seed of seedBase() plus
+    /// the instance index, a coverage filename made unique by
+    /// instanceFilename(), and fatalOnError(false) so a failing instance does
+    /// not exit the process.  Returns the number of instances that got an
+    /// error.
+    unsigned run(unsigned instances, const RunFunc& func) {
+        std::atomic<unsigned> next{0};
+        std::atomic<unsigned> failed{0};
+        const auto workerMain = [&]() {
+            while (true) {
+                const unsigned index = next.fetch_add(1);
+                if (index >= instances) break;
+                const std::unique_ptr<VerilatedContext> contextp{new VerilatedContext};
+                Verilated::threadContextp(contextp.get());
+                contextp->threads(1);
+                contextp->fatalOnError(false);
+                if (!m_args.empty()) {
+                    std::vector<const char*> argv;
+                    for (const std::string& arg : m_args) argv.push_back(arg.c_str());
+                    contextp->commandArgs(static_cast<int>(argv.size()), argv.data());
+                }
+                contextp->randSeed(m_seedBase + static_cast<int>(index));
+                contextp->coverageFilename(instanceFilename(contextp->coverageFilename(), index));
+                func(contextp.get(), index);
+                if (contextp->gotError()) ++failed;
+            }
+        };
+        // The calling thread only waits, so its threadContextp() is left alone
+        std::vector<std::thread> threads;
+        for (unsigned i = 0; i < std::min(m_workers, instances); ++i) {
+            threads.emplace_back(workerMain);
+        }
+        for (std::thread& thread : threads) thread.join();
+        return failed;
+    }
+};
+
+#endif  // Guard
@@ -38,8 +38,8 @@
 #include "gtkwave/lz4.c"
 
 #include <algorithm>
+#include <cstring>
 #include <iterator>
-#include <sstream>
 #include <type_traits>
 
 #if defined(_WIN32) && !defined(__MINGW32__) && !defined(__CYGWIN__)
@@ -73,7 +73,6 @@ VerilatedFst::VerilatedFst(void* /*fst*/) {}
 VerilatedFst::~VerilatedFst() {
     if (m_fst) fstWriterClose(m_fst);
     if (m_symbolp) VL_DO_CLEAR(delete[] m_symbolp, m_symbolp = nullptr);
-    if (m_strbufp) VL_DO_CLEAR(delete[] m_strbufp, m_strbufp = nullptr);
 }
 
 void VerilatedFst::open(const char* filename) VL_MT_SAFE_EXCLUDES(m_mutex) {
@@ -82,6 +81,7 @@ void VerilatedFst::open(const char* filename) VL_MT_SAFE_EXCLUDES(m_mutex) {
     fstWriterSetPackType(m_fst, FST_WR_PT_LZ4);
     fstWriterSetTimescaleFromString(m_fst, timeResStr().c_str());  // lintok-begin-on-ref
     if (m_useFstWriterThread) fstWriterSetParallelMode(m_fst, 1);
+    if (m_compressThreads > 1) fstWriterSetCompressThreads(m_fst, m_compressThreads);
     constDump(true);  // First dump must contain the const signals
     fullDump(true);  // First dump must be full for fst
 
@@ -93,9 +93,6 @@ void VerilatedFst::open(const char* filename) VL_MT_SAFE_EXCLUDES(m_mutex) {
         for (const auto& i : m_code2symbol) m_symbolp[i.first] = i.second;
     }
     m_code2symbol.clear();
-
-    // Allocate string buffer for arrays
-    if (!m_strbufp) m_strbufp = new char[maxBits() + 32];
 }
 
 void VerilatedFst::close() VL_MT_SAFE_EXCLUDES(m_mutex) {
@@ -113,6 +110,11 @@ void VerilatedFst::flush() VL_MT_SAFE_EXCLUDES(m_mutex) {
     fstWriterFlushContext(m_fst);
 }
 
+void VerilatedFst::compressThreads(unsigned threads) VL_MT_SAFE_EXCLUDES(m_mutex) {
+    const VerilatedLockGuard lock{m_mutex};
+    m_compressThreads = threads;
+}
+
 void VerilatedFst::emitTimeChange(uint64_t timeui) {
     if (!timeui) fstWriterEmitTimeChange(m_fst, timeui);
     m_timeui = timeui;
@@ -192,17 +194,27 @@ void VerilatedFst::declare(uint32_t code, const char* name, int dtypenum,
                            int msb, int lsb) {
     const int bits = ((msb > lsb) ? (msb - lsb) : (lsb - msb)) + 1;
 
-    const std::string hierarchicalName = m_prefixStack.back().first + name;
+    const std::string& hierarchicalName = declName(m_prefixStack.back().first, name);
 
     const bool enabled = Super::declCode(code, hierarchicalName, bits);
     if (!enabled) return;
 
     assert(hierarchicalName.rfind(' ') != std::string::npos);
-    std::stringstream name_ss;
-    name_ss << lastWord(hierarchicalName);
-    if (array) name_ss << "[" << arraynum << "]";
-    if (bussed) name_ss << " [" << msb << ":" << lsb << "]";
-    const std::string name_str = name_ss.str();
+    // Reuse a buffer, as there might be millions of signals
+    m_declNameStr.assign(lastWordp(hierarchicalName));
+    if (array) {
+        m_declNameStr += '[';
+        m_declNameStr += std::to_string(arraynum);
+        m_declNameStr += ']';
+    }
+    if (bussed) {
+        m_declNameStr += " [";
+        m_declNameStr += std::to_string(msb);
+        m_declNameStr += ':';
+        m_declNameStr += std::to_string(lsb);
+        m_declNameStr += ']';
+    }
+    const std::string& name_str = m_declNameStr;
 
     if (dtypenum > 0) fstWriterEmitEnumTableRef(m_fst, m_local2fstdtype[dtypenum]);
 
@@ -244,12 +256,12 @@ void VerilatedFst::declare(uint32_t code, const char* name, int dtypenum,
     else { assert(0); /* Unreachable */ }
     // clang-format on
 
-    const auto it = vlstd::as_const(m_code2symbol).find(code);
-    if (it == m_code2symbol.end()) {  // New
-        m_code2symbol[code]
+    const auto pair = m_code2symbol.emplace(code, 0);
+    if (pair.second) {  // New
+        pair.first->second
             = fstWriterCreateVar(m_fst, varType, varDir, bits, name_str.c_str(), 0);
     } else {  // Alias
-        fstWriterCreateVar(m_fst, varType, varDir, bits, name_str.c_str(), it->second);
+        fstWriterCreateVar(m_fst, varType, varDir, bits, name_str.c_str(), pair.first->second);
     }
 }
 
@@ -292,7 +304,13 @@ void VerilatedFst::declDouble(uint32_t code, uint32_t fidx, const char* name, in
 
 VerilatedFst::Buffer* VerilatedFst::getTraceBuffer(uint32_t fidx) {
     if (offload()) return new OffloadBuffer{*this};
-    return new Buffer{*this};
+    Buffer* const bufp = new Buffer{*this};
+    if (parallel() && !m_freeRecords.empty()) {
+        // Note: This is called from VerilatedFst::dump, which already holds the lock
+        bufp->m_record = std::move(m_freeRecords.back());
+        m_freeRecords.pop_back();
+    }
+    return bufp;
 }
 
 void VerilatedFst::commitTraceBuffer(VerilatedFst::Buffer* bufp) {
@@ -302,6 +320,23 @@ void VerilatedFst::commitTraceBuffer(VerilatedFst::Buffer* bufp) {
             m_offloadBufferWritep = offloadBufferp->m_offloadBufferWritep;
             return;  // Buffer will be deleted by the offload thread
         }
+    } else if (parallel()) {
+        // Note: This is called from VerilatedFst::dump, which already holds the lock
+        // Replay the recorded changes into the FST writer, in order
+        std::vector<char>& record = bufp->m_record;
+        if (!record.empty()) emitTimeChangeMaybe();
+        const char* readp = record.data();
+        const char* const endp = readp + record.size();
+        while (readp < endp) {
+            uint32_t header[2];  // {handle, length}
+            std::memcpy(header, readp, sizeof(header));
+            readp += sizeof(header);
+            fstWriterEmitValueChange(m_fst, header[0], readp);
+            readp += header[1];
+        }
+        // Put record back on free list
+        record.clear();
+        m_freeRecords.emplace_back(std::move(record));
     }
     delete bufp;
 }
@@ -325,59 +360,92 @@ void VerilatedFst::configure(const VerilatedTraceConfig& config) {
 // so always inline them.
 
 VL_ATTR_ALWINLINE
-void VerilatedFstBuffer::emitEvent(uint32_t code) {
+char* VerilatedFstBuffer::recordValue(uint32_t code, size_t len, size_t slack) {
+    const uint32_t header[2] = {m_symbolp[code], static_cast<uint32_t>(len)};
+    const size_t pos = m_record.size();
+    m_record.resize(pos + sizeof(header) + len + slack);
+    char* const writep = m_record.data() + pos;
+    std::memcpy(writep, header, sizeof(header));
+    return writep + sizeof(header);
+}
+
+VL_ATTR_ALWINLINE
+void VerilatedFstBuffer::emitValueChange(uint32_t code, const void* valp, size_t len) {
     VL_DEBUG_IFDEF(assert(m_symbolp[code]););
+    if (m_owner.parallel()) {
+        std::memcpy(recordValue(code, len), valp, len);
+        return;
+    }
     m_owner.emitTimeChangeMaybe();
-    fstWriterEmitValueChange(m_fst, m_symbolp[code], "1");
+    fstWriterEmitValueChange(m_fst, m_symbolp[code], valp);
 }
 
+VL_ATTR_ALWINLINE
+void VerilatedFstBuffer::emitEvent(uint32_t code) { emitValueChange(code, "1", 1); }
+
 VL_ATTR_ALWINLINE
 void VerilatedFstBuffer::emitBit(uint32_t code, CData newval) {
-    VL_DEBUG_IFDEF(assert(m_symbolp[code]););
-    m_owner.emitTimeChangeMaybe();
-    fstWriterEmitValueChange(m_fst, m_symbolp[code], newval ? "1" : "0");
+    emitValueChange(code, newval ? "1" : "0", 1);
 }
 
 VL_ATTR_ALWINLINE
 void VerilatedFstBuffer::emitCData(uint32_t code, CData newval, int bits) {
     char buf[VL_BYTESIZE];
-    VL_DEBUG_IFDEF(assert(m_symbolp[code]););
     cvtCDataToStr(buf, newval << (VL_BYTESIZE - bits));
-    m_owner.emitTimeChangeMaybe();
-    fstWriterEmitValueChange(m_fst, m_symbolp[code], buf);
+    emitValueChange(code, buf, bits);
 }
 
 VL_ATTR_ALWINLINE
 void VerilatedFstBuffer::emitSData(uint32_t code, SData newval, int bits) {
     char buf[VL_SHORTSIZE];
-    VL_DEBUG_IFDEF(assert(m_symbolp[code]););
     cvtSDataToStr(buf, newval << (VL_SHORTSIZE - bits));
-    m_owner.emitTimeChangeMaybe();
-    fstWriterEmitValueChange(m_fst, m_symbolp[code], buf);
+    emitValueChange(code, buf, bits);
 }
 
+// Values of 32 bits or more are passed to the FST writer packed, which converts them straight
+// into its value change buffer. When tracing in parallel, they are converted into the record.
+
 VL_ATTR_ALWINLINE
 void VerilatedFstBuffer::emitIData(uint32_t code, IData newval, int bits) {
-    char buf[VL_IDATASIZE];
+    if (m_owner.parallel()) {
+        char buf[VL_IDATASIZE];
+        cvtIDataToStr(buf, newval << (VL_IDATASIZE - bits));
+        emitValueChange(code, buf, bits);
+        return;
+    }
     VL_DEBUG_IFDEF(assert(m_symbolp[code]););
-    cvtIDataToStr(buf, newval << (VL_IDATASIZE - bits));
     m_owner.emitTimeChangeMaybe();
-    fstWriterEmitValueChange(m_fst, m_symbolp[code], buf);
+    fstWriterEmitValueChangePacked32(m_fst, m_symbolp[code], bits, &newval);
 }
 
 VL_ATTR_ALWINLINE
 void VerilatedFstBuffer::emitQData(uint32_t code, QData newval, int bits) {
-    char buf[VL_QUADSIZE];
+    if (m_owner.parallel()) {
+        char buf[VL_QUADSIZE];
+        cvtQDataToStr(buf, newval << (VL_QUADSIZE - bits));
+        emitValueChange(code, buf, bits);
+        return;
+    }
     VL_DEBUG_IFDEF(assert(m_symbolp[code]););
-    cvtQDataToStr(buf, newval << (VL_QUADSIZE - bits));
+    const uint32_t words[2] = {static_cast<uint32_t>(newval), static_cast<uint32_t>(newval >> 32)};
     m_owner.emitTimeChangeMaybe();
-    fstWriterEmitValueChange(m_fst, m_symbolp[code], buf);
+    fstWriterEmitValueChangePacked32(m_fst, m_symbolp[code], bits, words);
 }
 
 VL_ATTR_ALWINLINE
 void VerilatedFstBuffer::emitWData(uint32_t code, const WData* newvalp, int bits) {
+    VL_DEBUG_IFDEF(assert(m_symbolp[code]););
+    if (!m_owner.parallel()) {
+        static_assert(sizeof(EData) == sizeof(uint32_t), "Packed FST values are 32-bit words");
+        m_owner.emitTimeChangeMaybe();
+        fstWriterEmitValueChangePacked32(m_fst, m_symbolp[code], bits, newvalp);
+        return;
+    }
+    // Convert straight into the record. The most significant word is always
+    // converted in full, so this needs VL_EDATASIZE chars of slack.
+    char* const strp = recordValue(code, bits, VL_EDATASIZE);
     int words = VL_WORDS_I(bits);
-    char* wp = m_strbufp;
+    char* wp = strp;
     // Convert the most significant word
     const int bitsInMSW = VL_BITBIT_E(bits) ? VL_BITBIT_E(bits) : VL_EDATASIZE;
     cvtEDataToStr(wp, newvalp[--words] << (VL_EDATASIZE - bitsInMSW));
@@ -387,12 +455,10 @@ void VerilatedFstBuffer::emitWData(uint32_t code, const WData* newvalp, int bits
         cvtEDataToStr(wp, newvalp[--words]);
         wp += VL_EDATASIZE;
     }
-    m_owner.emitTimeChangeMaybe();
-    fstWriterEmitValueChange(m_fst, m_symbolp[code], m_strbufp);
+    m_record.resize(m_record.size() - VL_EDATASIZE);  // Drop the slack
 }
 
 VL_ATTR_ALWINLINE
 void VerilatedFstBuffer::emitDouble(uint32_t code, double newval) {
-    m_owner.emitTimeChangeMaybe();
-    fstWriterEmitValueChange(m_fst, m_symbolp[code], &newval);
+    emitValueChange(code, &newval, sizeof(newval));
 }
@@ -55,10 +55,14 @@ private:
     std::map<uint32_t, vlFstHandle> m_code2symbol;
     std::map<int, vlFstEnumHandle> m_local2fstdtype;
     vlFstHandle* m_symbolp = nullptr;  // same as m_code2symbol, but as an array
-    char* m_strbufp = nullptr;  // String buffer long enough to hold maxBits() chars
+    std::string m_declNameStr;  // Buffer for declared variable names
     uint64_t m_timeui = 0;  // Time to emit, 0 = not needed
 
     bool m_useFstWriterThread = false;  // Whether to use the separate FST writer thread
+    unsigned m_compressThreads = 0;  // Threads compressing value change blocks, <= 1: none
+
+    // Recycled change records of parallel trace buffers (keeps their capacity)
+    std::vector<std::vector<char>> m_freeRecords;
 
     // Prefixes to add to signal names/scope types
     std::vector<std::pair<std::string, VerilatedTracePrefixType>> m_prefixStack{
@@ -106,6 +110,8 @@ public:
     void flush() VL_MT_SAFE_EXCLUDES(m_mutex);
     // Return if file is open
     bool isOpen() const VL_MT_SAFE { return m_fst != nullptr; }
+    // Set number of threads compressing value change blocks, takes effect on open()
+    void compressThreads(unsigned threads) VL_MT_SAFE_EXCLUDES(m_mutex);
 
     //=========================================================================
     // Internal interface to Verilator generated code
@@ -150,6 +156,12 @@ template <>
 void VerilatedFst::Super::set_time_resolution(const std::string& unit);
 template <>
 void VerilatedFst::Super::dumpvars(int level, const std::string& hier);
+template <>
+void VerilatedFst::Super::traceScopes(const std::string& scopes);
+template <>
+void VerilatedFst::Super::flightRecorder(uint64_t cycles);
+template <>
+void VerilatedFst::Super::flightRecorderTrigger();
 #endif
 
 //=============================================================================
@@ -168,8 +180,10 @@ class VerilatedFstBuffer VL_NOT_FINAL {
     fstWriterContext* const m_fst = m_owner.m_fst;
     // code to fstHande map, as an array
     const vlFstHandle* const m_symbolp = m_owner.m_symbolp;
-    // String buffer long enough to hold maxBits() chars
-    char* const m_strbufp = m_owner.m_strbufp;
+    // When tracing in parallel, value changes are recorded here as
+    // {handle, length, value bytes} entries, and are passed on to the FST
+    // writer in order by VerilatedFst::commitTraceBuffer on the main thread.
+    std::vector<char> m_record;
 
     // CONSTRUCTOR
     explicit VerilatedFstBuffer(VerilatedFst& owner)
@@ -189,6 +203,11 @@ class VerilatedFstBuffer VL_NOT_FINAL {
     VL_ATTR_ALWINLINE void emitQData(uint32_t code, QData newval, int bits);
     VL_ATTR_ALWINLINE void emitWData(uint32_t code, const WData* newvalp, int bits);
     VL_ATTR_ALWINLINE void emitDouble(uint32_t code, double newval);
+
+    // Reserve space for a value of 'len' (+ 'slack') bytes in m_record, return where to write it
+    VL_ATTR_ALWINLINE char* recordValue(uint32_t code, size_t len, size_t slack = 0);
+    // Emit, or when tracing in parallel record, a value change of 'len' bytes
+    VL_ATTR_ALWINLINE void emitValueChange(uint32_t code, const void* valp, size_t len);
 };
 
 //=============================================================================
@@ -222,6 +241,9 @@ public:
     }
     /// Flush dump
     void flush() VL_MT_SAFE { m_sptrace.flush(); }
+    /// Set number of threads used to compress value change blocks in parallel
+    /// (default 0, compress on the single writer thread). Call before open().
+    void compressThreads(unsigned threads) VL_MT_SAFE { m_sptrace.compressThreads(threads); }
     /// Write one cycle of dump data
     /// Call with the current context's time just after eval'ed,
     /// e.g. ->dump(contextp->time())
@@ -254,6 +276,15 @@ public:
     void dumpvars(int level, const std::string& hier) VL_MT_SAFE {
         m_sptrace.dumpvars(level, hier);
     }
+    /// Trace only signals under the given scopes, see VerilatedTraceBaseC
+    void traceScopes(const std::string& scopes) override VL_MT_SAFE {
+        m_sptrace.traceScopes(scopes);
+    }
+    // Only keep the last 'cycles' dumps in memory, until triggered by
+    // flightRecorderTrigger() or $dumpon. Call before open().
+    void flightRecorder(uint64_t cycles) VL_MT_SAFE { m_sptrace.flightRecorder(cycles); }
+    // Write the flight recorder contents, then continue dumping as normal
+    void flightRecorderTrigger() VL_MT_SAFE { m_sptrace.flightRecorderTrigger(); }
 
     // Internal class access
     VerilatedFst* spTrace() { return &m_sptrace; }
@@ -28,6 +28,8 @@
 #error "verilated_funcs.h should only be included by verilated.h"
 #endif
 
+#include "verilated_intrinsics.h"
+
 #include <string>
 
 //=========================================================================
@@ -82,6 +84,11 @@ extern void VL_PRINTF_MT(const char* formatp, ...) VL_ATTR_PRINTF(1) VL_MT_SAFE;
 /// Print a debug message from internals with standard prefix, with printf style format
 extern void VL_DBG_MSGF(const char* formatp, ...) VL_ATTR_PRINTF(1) VL_MT_SAFE;
 
+/// Allocate memory for a model, page aligned and using huge pages when large
+/// enough, for --huge-pages.  Free with VL_HUGE_FREE passing the same size.
+extern void* VL_HUGE_ALLOC(size_t size) VL_MT_SAFE;
+extern void VL_HUGE_FREE(void* ptr, size_t size) VL_MT_SAFE;
+
 // EMIT_RULE: VL_RANDOM:  oclean=dirty
 inline IData VL_RANDOM_I() VL_MT_SAFE { return vl_rand64(); }
 inline QData VL_RANDOM_Q() VL_MT_SAFE { return vl_rand64(); }
@@ -109,6 +116,26 @@ extern QData VL_SCOPED_RAND_RESET_Q(int obits, uint64_t scopeHash, uint64_t salt
 extern WDataOutP VL_SCOPED_RAND_RESET_W(int obits, WDataOutP outwp, uint64_t scopeHash,
                                         uint64_t salt) VL_MT_UNSAFE;
 
+/// Entry in a table of model variables for VL_SCOPED_RAND_RESET_TABLE
+template <typename T_Class, typename T_Data>
+struct VlScopedRandResetEntry final {
+    T_Data T_Class::*m_memberp;  // Variable to reset
+    int m_obits;  // Width of variable
+    uint64_t m_salt;  // Hash of variable's name
+};
+/// Random reset each signal in a table (init time only, var-specific PRNG)
+template <typename T_Class, typename T_Data, std::size_t N_Entries>
+void VL_SCOPED_RAND_RESET_TABLE(T_Class* selfp,
+                                const VlScopedRandResetEntry<T_Class, T_Data> (&table)[N_Entries],
+                                uint64_t scopeHash) VL_MT_UNSAFE {
+    for (const VlScopedRandResetEntry<T_Class, T_Data>& entry : table) {
+        selfp->*entry.m_memberp = static_cast<T_Data>(
+            sizeof(T_Data) > sizeof(IData)
+                ? VL_SCOPED_RAND_RESET_Q(entry.m_obits, scopeHash, entry.m_salt)
+                : VL_SCOPED_RAND_RESET_I(entry.m_obits, scopeHash, entry.m_salt));
+    }
+}
+
 /// Random reset a signal of given width (assign time only)
 extern IData VL_SCOPED_RAND_RESET_ASSIGN_I(int obits, uint64_t scopeHash,
                                            uint64_t salt) VL_MT_UNSAFE;
@@ -637,6 +664,137 @@ static inline WDataOutP VL_EXTENDS_WW(int obits, int lbits, WDataOutP owp,
     return VL_MEMCPY_W(owp, lwp, lwords - 1);
 }
 
+//===================================================================
+// WIDE SIMD HELPERS
+
+// Where available, wide operations below process VL_SIMD_WORDS words per
+// step using these helpers, finishing any remaining words with the scalar
+// loop. All loads and stores are unaligned.
+
+#ifdef VL_HAVE_SSE2
+static inline EData _vl_simd_hor128(__m128i v) VL_PURE {
+    v = _mm_or_si128(v, _mm_shuffle_epi32(v, 0x4e));
+    v = _mm_or_si128(v, _mm_shuffle_epi32(v, 0xb1));
+    return static_cast<EData>(_mm_cvtsi128_si32(v));
+}
+static inline EData _vl_simd_hxor128(__m128i v) VL_PURE {
+    v = _mm_xor_si128(v, _mm_shuffle_epi32(v, 0x4e));
+    v = _mm_xor_si128(v, _mm_shuffle_epi32(v, 0xb1));
+    return static_cast<EData>(_mm_cvtsi128_si32(v));
+}
+#endif
+#ifdef VL_HAVE_AVX2
+static inline EData _vl_simd_hor256(__m256i v) VL_PURE {
+    return _vl_simd_hor128(
+        _mm_or_si128(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1)));
+}
+static inline EData _vl_simd_hxor256(__m256i v) VL_PURE {
+    return _vl_simd_hxor128(
+        _mm_xor_si128(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1)));
+}
+#endif
+
+#if defined(VL_HAVE_AVX512)
+#define VL_SIMD_WORDS 16
+using VlSimdW = __m512i;
+static inline VlSimdW _vl_simd_load(const EData* p) VL_PURE { return _mm512_loadu_si512(p); }
+static inline void _vl_simd_store(EData* p, VlSimdW v) VL_MT_SAFE { _mm512_storeu_si512(p, v); }
+static inline VlSimdW _vl_simd_zero() VL_PURE { return _mm512_setzero_si512(); }
+static inline VlSimdW _vl_simd_and(VlSimdW a, VlSimdW b) VL_PURE { return _mm512_and_si512(a, b); }
+static inline VlSimdW _vl_simd_or(VlSimdW a, VlSimdW b) VL_PURE { return _mm512_or_si512(a, b); }
+static inline VlSimdW _vl_simd_xor(VlSimdW a, VlSimdW b) VL_PURE { return _mm512_xor_si512(a, b); }
+static inline VlSimdW _vl_simd_not(VlSimdW a) VL_PURE {
+    return _mm512_xor_si512(a, _mm512_set1_epi32(-1));
+}
+static inline VlSimdW _vl_simd_shl(VlSimdW a, int n) VL_PURE {
+    return _mm512_sll_epi32(a, _mm_cvtsi32_si128(n));
+}
+static inline VlSimdW _vl_simd_shr(VlSimdW a, int n) VL_PURE {
+    return _mm512_srl_epi32(a, _mm_cvtsi32_si128(n));
+}
+static inline EData _vl_simd_hor(VlSimdW v) VL_PURE {
+    // Fold upper 256 bits onto lower
+    const __m512i h = _mm512_shuffle_i64x2(v, v, 0xee);
+    return _vl_simd_hor256(_mm512_castsi512_si256(_mm512_or_si512(v, h)));
+}
+static inline EData _vl_simd_hxor(VlSimdW v) VL_PURE {
+    const __m512i h = _mm512_shuffle_i64x2(v, v, 0xee);
+    return _vl_simd_hxor256(_mm512_castsi512_si256(_mm512_xor_si512(v, h)));
+}
+#elif defined(VL_HAVE_AVX2)
+#define VL_SIMD_WORDS 8
+using VlSimdW = __m256i;
+static inline VlSimdW _vl_simd_load(const EData* p) VL_PURE {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+}
+static inline void _vl_simd_store(EData* p, VlSimdW v) VL_MT_SAFE {
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v);
+}
+static inline VlSimdW _vl_simd_zero() VL_PURE { return _mm256_setzero_si256(); }
+static inline VlSimdW _vl_simd_and(VlSimdW a, VlSimdW b) VL_PURE { return _mm256_and_si256(a, b); }
+static inline VlSimdW _vl_simd_or(VlSimdW a, VlSimdW b) VL_PURE { return _mm256_or_si256(a, b); }
+static inline VlSimdW _vl_simd_xor(VlSimdW a, VlSimdW b) VL_PURE { return _mm256_xor_si256(a, b); }
+static inline VlSimdW _vl_simd_not(VlSimdW a) VL_PURE {
+    return _mm256_xor_si256(a, _mm256_set1_epi32(-1));
+}
+static inline VlSimdW _vl_simd_shl(VlSimdW a, int n) VL_PURE {
+    return _mm256_sll_epi32(a, _mm_cvtsi32_si128(n));
+}
+static inline VlSimdW _vl_simd_shr(VlSimdW a, int n) VL_PURE {
+    return _mm256_srl_epi32(a, _mm_cvtsi32_si128(n));
+}
+static inline EData _vl_simd_hor(VlSimdW v) VL_PURE { return _vl_simd_hor256(v); }
+static inline EData _vl_simd_hxor(VlSimdW v) VL_PURE { return _vl_simd_hxor256(v); }
+#elif defined(VL_HAVE_SSE2)
+#define VL_SIMD_WORDS 4
+using VlSimdW = __m128i;
+static inline VlSimdW _vl_simd_load(const EData* p) VL_PURE {
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+}
+static inline void _vl_simd_store(EData* p, VlSimdW v) VL_MT_SAFE {
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v);
+}
+static inline VlSimdW _vl_simd_zero() VL_PURE { return _mm_setzero_si128(); }
+static inline VlSimdW _vl_simd_and(VlSimdW a, VlSimdW b) VL_PURE { return _mm_and_si128(a, b); }
+static inline VlSimdW _vl_simd_or(VlSimdW a, VlSimdW b) VL_PURE { return _mm_or_si128(a, b); }
+static inline VlSimdW _vl_simd_xor(VlSimdW a, VlSimdW b) VL_PURE { return _mm_xor_si128(a, b); }
+static inline VlSimdW _vl_simd_not(VlSimdW a) VL_PURE {
+    return _mm_xor_si128(a, _mm_set1_epi32(-1));
+}
+static inline VlSimdW _vl_simd_shl(VlSimdW a, int n) VL_PURE {
+    return _mm_sll_epi32(a, _mm_cvtsi32_si128(n));
+}
+static inline VlSimdW _vl_simd_shr(VlSimdW a, int n) VL_PURE {
+    return _mm_srl_epi32(a, _mm_cvtsi32_si128(n));
+}
+static inline EData _vl_simd_hor(VlSimdW v) VL_PURE { return _vl_simd_hor128(v); }
+static inline EData _vl_simd_hxor(VlSimdW v) VL_PURE { return _vl_simd_hxor128(v); }
+#elif defined(VL_HAVE_NEON)
+#define VL_SIMD_WORDS 4
+using VlSimdW = uint32x4_t;
+static inline VlSimdW _vl_simd_load(const EData* p) VL_PURE { return vld1q_u32(p); }
+static inline void _vl_simd_store(EData* p, VlSimdW v) VL_MT_SAFE { vst1q_u32(p, v); }
+static inline VlSimdW _vl_simd_zero() VL_PURE { return vdupq_n_u32(0); }
+static inline VlSimdW _vl_simd_and(VlSimdW a, VlSimdW b) VL_PURE { return vandq_u32(a, b); }
+static inline VlSimdW _vl_simd_or(VlSimdW a, VlSimdW b) VL_PURE { return vorrq_u32(a, b); }
+static inline VlSimdW _vl_simd_xor(VlSimdW a, VlSimdW b) VL_PURE { return veorq_u32(a, b); }
+static inline VlSimdW _vl_simd_not(VlSimdW a) VL_PURE { return vmvnq_u32(a); }
+static inline VlSimdW _vl_simd_shl(VlSimdW a, int n) VL_PURE {
+    return vshlq_u32(a, vdupq_n_s32(n));
+}
+static inline VlSimdW _vl_simd_shr(VlSimdW a, int n) VL_PURE {
+    return vshlq_u32(a, vdupq_n_s32(-n));  // Negative shift-left is a right shift
+}
+static inline EData _vl_simd_hor(VlSimdW v) VL_PURE {
+    const uint32x2_t r = vorr_u32(vget_low_u32(v), vget_high_u32(v));
+    return vget_lane_u32(r, 0) | vget_lane_u32(r, 1);
+}
+static inline EData _vl_simd_hxor(VlSimdW v) VL_PURE {
+    const uint32x2_t r = veor_u32(vget_low_u32(v), vget_high_u32(v));
+    return vget_lane_u32(r, 0) ^ vget_lane_u32(r, 1);
+}
+#endif
+
 //===================================================================
 // REDUCTION OPERATORS
 
@@ -657,7 +815,17 @@ static inline IData VL_REDAND_IW(int lbits, WDataInP const lwp) VL_PURE {
 #define VL_REDOR_Q(lhs) ((lhs) != 0)
 static inline IData VL_REDOR_W(int words, WDataInP const lwp) VL_PURE {
     EData equal = 0;
-    for (int i = 0; i < words; ++i) equal |= lwp[i];
+    int i = 0;
+#ifdef VL_SIMD_WORDS
+    if (words >= VL_SIMD_WORDS) {
+        VlSimdW acc = _vl_simd_zero();
+        for (; i + VL_SIMD_WORDS <= words; i += VL_SIMD_WORDS) {
+            acc = _vl_simd_or(acc, _vl_simd_load(lwp + i));
+        }
+        equal = _vl_simd_hor(acc);
+    }
+#endif
+    for (; i < words; ++i) equal |= lwp[i];
     return (equal != 0);
 }
 
@@ -723,8 +891,18 @@ static inline IData VL_REDXOR_64(QData r) VL_PURE {
 #endif
 }
 static inline IData VL_REDXOR_W(int words, WDataInP const lwp) VL_PURE {
-    EData r = lwp[0];
-    for (int i = 1; i < words; ++i) r ^= lwp[i];
+    EData r = 0;
+    int i = 0;
+#ifdef VL_SIMD_WORDS
+    if (words >= VL_SIMD_WORDS) {
+        VlSimdW acc = _vl_simd_zero();
+        for (; i + VL_SIMD_WORDS <= words; i += VL_SIMD_WORDS) {
+            acc = _vl_simd_xor(acc, _vl_simd_load(lwp + i));
+        }
+        r = _vl_simd_hxor(acc);
+    }
+#endif
+    for (; i < words; ++i) r ^= lwp[i];
     return VL_REDXOR_32(r);
 }
 
@@ -859,30 +1037,64 @@ static inline IData VL_MOSTSETBITP1_W(int words, WDataInP const lwp) VL_PURE {
 // EMIT_RULE: VL_AND:  oclean=lclean||rclean; obits=lbits; lbits==rbits;
 static inline WDataOutP VL_AND_W(int words, WDataOutP owp, WDataInP const lwp,
                                  WDataInP const rwp) VL_MT_SAFE {
-    for (int i = 0; (i < words); ++i) owp[i] = (lwp[i] & rwp[i]);
+    int i = 0;
+#ifdef VL_SIMD_WORDS
+    for (; i + VL_SIMD_WORDS <= words; i += VL_SIMD_WORDS) {
+        _vl_simd_store(owp + i, _vl_simd_and(_vl_simd_load(lwp + i), _vl_simd_load(rwp + i)));
+    }
+#endif
+    for (; i < words; ++i) owp[i] = (lwp[i] & rwp[i]);
     return owp;
 }
 // EMIT_RULE: VL_OR:   oclean=lclean&&rclean; obits=lbits; lbits==rbits;
 static inline WDataOutP VL_OR_W(int words, WDataOutP owp, WDataInP const lwp,
                                 WDataInP const rwp) VL_MT_SAFE {
-    for (int i = 0; (i < words); ++i) owp[i] = (lwp[i] | rwp[i]);
+    int i = 0;
+#ifdef VL_SIMD_WORDS
+    for (; i + VL_SIMD_WORDS <= words; i += VL_SIMD_WORDS) {
+        _vl_simd_store(owp + i, _vl_simd_or(_vl_simd_load(lwp + i), _vl_simd_load(rwp + i)));
+    }
+#endif
+    for (; i < words; ++i) owp[i] = (lwp[i] | rwp[i]);
     return owp;
 }
 // EMIT_RULE: VL_CHANGEXOR:  oclean=1; obits=32; lbits==rbits;
 static inline IData VL_CHANGEXOR_W(int words, WDataInP const lwp, WDataInP const rwp) VL_PURE {
     IData od = 0;
-    for (int i = 0; (i < words); ++i) od |= (lwp[i] ^ rwp[i]);
+    int i = 0;
+#ifdef VL_SIMD_WORDS
+    if (words >= VL_SIMD_WORDS) {
+        VlSimdW acc = _vl_simd_zero();
+        for (; i + VL_SIMD_WORDS <= words; i += VL_SIMD_WORDS) {
+            acc = _vl_simd_or(acc, _vl_simd_xor(_vl_simd_load(lwp + i), _vl_simd_load(rwp + i)));
+        }
+        od = _vl_simd_hor(acc);
+    }
+#endif
+    for (; i < words; ++i) od |= (lwp[i] ^ rwp[i]);
     return od;
 }
 // EMIT_RULE: VL_XOR:  oclean=lclean&&rclean; obits=lbits; lbits==rbits;
 static inline WDataOutP VL_XOR_W(int words, WDataOutP owp, WDataInP const lwp,
                                  WDataInP const rwp) VL_MT_SAFE {
-    for (int i = 0; (i < words); ++i) owp[i] = (lwp[i] ^ rwp[i]);
+    int i = 0;
+#ifdef VL_SIMD_WORDS
+    for (; i + VL_SIMD_WORDS <= words; i += VL_SIMD_WORDS) {
+        _vl_simd_store(owp + i, _vl_simd_xor(_vl_simd_load(lwp + i), _vl_simd_load(rwp + i)));
+    }
+#endif
+    for (; i < words; ++i) owp[i] = (lwp[i] ^ rwp[i]);
     return owp;
 }
 // EMIT_RULE: VL_NOT:  oclean=dirty; obits=lbits;
 static inline WDataOutP VL_NOT_W(int words, WDataOutP owp, WDataInP const lwp) VL_MT_SAFE {
-    for (int i = 0; i < words; ++i) owp[i] = ~(lwp[i]);
+    int i = 0;
+#ifdef VL_SIMD_WORDS
+    for (; i + VL_SIMD_WORDS <= words; i += VL_SIMD_WORDS) {
+        _vl_simd_store(owp + i, _vl_simd_not(_vl_simd_load(lwp + i)));
+    }
+#endif
+    for (; i < words; ++i) owp[i] = ~(lwp[i]);
     return owp;
 }
 
@@ -903,9 +1115,7 @@ static inline WDataOutP VL_NOT_W(int words, WDataOutP owp, WDataInP const lwp) V
 
 // Output clean, <lhs> AND <rhs> MUST BE CLEAN
 static inline IData VL_EQ_W(int words, WDataInP const lwp, WDataInP const rwp) VL_PURE {
-    EData nequal = 0;
-    for (int i = 0; (i < words); ++i) nequal |= (lwp[i] ^ rwp[i]);
-    return (nequal == 0);
+    return VL_CHANGEXOR_W(words, lwp, rwp) == 0;
 }
 
 // Internal usage
@@ -1021,6 +1231,25 @@ static inline QData VL_MODDIV_QQQ(int lbits, QData lhs, QData rhs) {
     return (rhs == 0) ? 0 : lhs % rhs;
 }
 #define VL_MODDIV_WWW(lbits, owp, lwp, rwp) (_vl_moddiv_w(lbits, owp, lwp, rwp, 1))
+// Division by a constant single word divisor; one native 64/32 divide per word
+static inline WDataOutP _vl_moddiv_wi(int lbits, WDataOutP owp, WDataInP const lwp, EData rd,
+                                      bool is_modulus) VL_MT_SAFE {
+    const int words = VL_WORDS_I(lbits);
+    uint64_t k = 0;
+    for (int j = words - 1; j >= 0; --j) {
+        const uint64_t unw64 = (k << 32ULL) | static_cast<uint64_t>(lwp[j]);
+        const uint64_t q = unw64 / rd;
+        k = unw64 - q * rd;
+        if (!is_modulus) owp[j] = static_cast<EData>(q);
+    }
+    if (is_modulus) {
+        owp[0] = static_cast<EData>(k);
+        for (int i = 1; i < words; ++i) owp[i] = 0;
+    }
+    return owp;
+}
+#define VL_DIV_WWI(lbits, owp, lwp, rd) (_vl_moddiv_wi(lbits, owp, lwp, rd, 0))
+#define VL_MODDIV_WWI(lbits, owp, lwp, rd) (_vl_moddiv_wi(lbits, owp, lwp, rd, 1))
 
 static inline WDataOutP VL_ADD_W(int words, WDataOutP owp, WDataInP const lwp,
                                  WDataInP const rwp) VL_MT_SAFE {
@@ -1048,6 +1277,79 @@ static inline WDataOutP VL_SUB_W(int words, WDataOutP owp, WDataInP const lwp,
     return owp;
 }
 
+//=========================================================================
+// Width specialized wide operators
+// Same as the word-count versions above, but the emitted code passes the
+// word count as a template argument, so the compiler can fully unroll or
+// vectorize without branching on the width at runtime.
+
+template <std::size_t N_Words>
+static inline IData VL_REDOR_W(WDataInP const lwp) VL_PURE {
+    EData r = 0;
+    for (std::size_t i = 0; i < N_Words; ++i) r |= lwp[i];
+    return r != 0;
+}
+template <std::size_t N_Words>
+static inline IData VL_REDXOR_W(WDataInP const lwp) VL_PURE {
+    EData r = 0;
+    for (std::size_t i = 0; i < N_Words; ++i) r ^= lwp[i];
+    return VL_REDXOR_32(r);
+}
+template <std::size_t N_Words>
+static inline WDataOutP VL_AND_W(WDataOutP owp, WDataInP const lwp,
+                                 WDataInP const rwp) VL_MT_SAFE {
+    for (std::size_t i = 0; i < N_Words; ++i) owp[i] = lwp[i] & rwp[i];
+    return owp;
+}
+template <std::size_t N_Words>
+static inline WDataOutP VL_OR_W(WDataOutP owp, WDataInP const lwp,
+                                WDataInP const rwp) VL_MT_SAFE {
+    for (std::size_t i = 0; i < N_Words; ++i) owp[i] = lwp[i] | rwp[i];
+    return owp;
+}
+template <std::size_t N_Words>
+static inline WDataOutP VL_XOR_W(WDataOutP owp, WDataInP const lwp,
+                                 WDataInP const rwp) VL_MT_SAFE {
+    for (std::size_t i = 0; i < N_Words; ++i) owp[i] = lwp[i] ^ rwp[i];
+    return owp;
+}
+template <std::size_t N_Words>
+static inline WDataOutP VL_NOT_W(WDataOutP owp, WDataInP const lwp) VL_MT_SAFE {
+    for (std::size_t i = 0; i < N_Words; ++i) owp[i] = ~lwp[i];
+    return owp;
+}
+template <std::size_t N_Words>
+static inline IData VL_EQ_W(WDataInP const lwp, WDataInP const rwp) VL_PURE {
+    EData od = 0;
+    for (std::size_t i = 0; i < N_Words; ++i) od |= lwp[i] ^ rwp[i];
+    return od == 0;
+}
+template <std::size_t N_Words>
+static inline WDataOutP VL_ADD_W(WDataOutP owp, WDataInP const lwp,
+                                 WDataInP const rwp) VL_MT_SAFE {
+    QData carry = 0;
+    for (std::size_t i = 0; i < N_Words; ++i) {
+        carry = carry + static_cast<QData>(lwp[i]) + static_cast<QData>(rwp[i]);
+        owp[i] = static_cast<EData>(carry);
+        carry >>= 32ULL;
+    }
+    // Last output word is dirty
+    return owp;
+}
+template <std::size_t N_Words>
+static inline WDataOutP VL_SUB_W(WDataOutP owp, WDataInP const lwp,
+                                 WDataInP const rwp) VL_MT_SAFE {
+    QData carry = 1;  // Negation of rwp
+    for (std::size_t i = 0; i < N_Words; ++i) {
+        carry = (carry + static_cast<QData>(lwp[i])
+                 + static_cast<QData>(static_cast<EData>(~rwp[i])));
+        owp[i] = static_cast<EData>(carry);
+        carry >>= 32ULL;
+    }
+    // Last output word is dirty
+    return owp;
+}
+
 static inline WDataOutP VL_MUL_W(int words, WDataOutP owp, WDataInP const lwp,
                                  WDataInP const rwp) VL_MT_SAFE {
     for (int i = 0; i < words; ++i) owp[i] = 0;
@@ -1922,8 +2224,23 @@ static inline WDataOutP VL_SHIFTL_WWI(int obits, int, int, WDataOutP owp, WDataI
         for (int i = 0; i < word_shift; ++i) owp[i] = 0;
         for (int i = word_shift; i < VL_WORDS_I(obits); ++i) owp[i] = lwp[i - word_shift];
     } else {
-        for (int i = 0; i < VL_WORDS_I(obits); ++i) owp[i] = 0;
-        _vl_insert_WW(owp, lwp, obits - 1, rd);
+        const int owords = VL_WORDS_I(obits);
+        const int nbitsonleft = VL_EDATASIZE - bit_shift;  // bits that end up in lower word
+        for (int i = 0; i < word_shift; ++i) owp[i] = 0;
+        owp[word_shift] = lwp[0] << bit_shift;
+        int i = word_shift + 1;
+#ifdef VL_SIMD_WORDS
+        for (; i + VL_SIMD_WORDS <= owords; i += VL_SIMD_WORDS) {
+            const VlSimdW lo = _vl_simd_load(lwp + i - word_shift - 1);
+            const VlSimdW hi = _vl_simd_load(lwp + i - word_shift);
+            _vl_simd_store(owp + i, _vl_simd_or(_vl_simd_shl(hi, bit_shift),
+                                                _vl_simd_shr(lo, nbitsonleft)));
+        }
+#endif
+        for (; i < owords; ++i) {
+            owp[i] = (lwp[i - word_shift] << bit_shift) | (lwp[i - word_shift - 1] >> nbitsonleft);
+        }
+        owp[owords - 1] &= VL_MASK_E(obits);
     }
     return owp;
 }
@@ -1962,6 +2279,29 @@ static inline QData VL_SHIFTL_QQW(int obits, int, int rbits, QData lhs,
     return VL_SHIFTL_QQI(obits, obits, 32, lhs, rwp[0]);
 }
 
+// Internal usage: owp[0, words) = lwp shifted right by word_shift words and
+// loffset (non-zero) bits, where lwp has owords words
+static inline void _vl_shiftr_words(WDataOutP owp, WDataInP const lwp, int words, int word_shift,
+                                    int loffset, int owords) VL_MT_SAFE {
+    const int nbitsonright = VL_EDATASIZE - loffset;  // bits that end up in lword
+    int i = 0;
+#ifdef VL_SIMD_WORDS
+    // Vector steps while the upper word of each lane is in range
+    for (; i + VL_SIMD_WORDS <= words && i + word_shift + VL_SIMD_WORDS < owords;
+         i += VL_SIMD_WORDS) {
+        const VlSimdW lo = _vl_simd_load(lwp + i + word_shift);
+        const VlSimdW hi = _vl_simd_load(lwp + i + word_shift + 1);
+        _vl_simd_store(owp + i,
+                       _vl_simd_or(_vl_simd_shr(lo, loffset), _vl_simd_shl(hi, nbitsonright)));
+    }
+#endif
+    for (; i < words; ++i) {
+        owp[i] = lwp[i + word_shift] >> loffset;
+        const int upperword = i + word_shift + 1;
+        if (upperword < owords) owp[i] |= lwp[upperword] << nbitsonright;
+    }
+}
+
 // EMIT_RULE: VL_SHIFTR:  oclean=lclean; rclean==clean;
 // Important: Unlike most other funcs, the shift might well be a computed
 // expression.  Thus consider this when optimizing.  (And perhaps have 2 funcs?)
@@ -1993,14 +2333,9 @@ static inline WDataOutP VL_SHIFTR_WWI(int obits, int, int, WDataOutP owp, WDataI
         for (int i = copy_words; i < VL_WORDS_I(obits); ++i) owp[i] = 0;
     } else {
         const int loffset = rd & VL_SIZEBITS_E;
-        const int nbitsonright = VL_EDATASIZE - loffset;  // bits that end up in lword (know
-                                                          // loffset!=0) Middle words
+        // Middle words
         const int words = VL_WORDS_I(obits - rd);
-        for (int i = 0; i < words; ++i) {
-            owp[i] = lwp[i + word_shift] >> loffset;
-            const int upperword = i + word_shift + 1;
-            if (upperword < VL_WORDS_I(obits)) owp[i] |= lwp[upperword] << nbitsonright;
-        }
+        _vl_shiftr_words(owp, lwp, words, word_shift, loffset, VL_WORDS_I(obits));
         for (int i = words; i < VL_WORDS_I(obits); ++i) owp[i] = 0;
     }
     return owp;
@@ -2073,15 +2408,9 @@ static inline WDataOutP VL_SHIFTRS_WWI(int obits, int lbits, int, WDataOutP owp,
         owp[lmsw] &= VL_MASK_E(lbits);
     } else {
         const int loffset = rd & VL_SIZEBITS_E;
-        const int nbitsonright
-            = VL_EDATASIZE - loffset;  // bits that end up in lword (know loffset!=0)
         // Middle words
         const int words = VL_WORDS_I(obits - rd);
-        for (int i = 0; i < words; ++i) {
-            owp[i] = lwp[i + word_shift] >> loffset;
-            const int upperword = i + word_shift + 1;
-            if (upperword < VL_WORDS_I(obits)) owp[i] |= lwp[upperword] << nbitsonright;
-        }
+        _vl_shiftr_words(owp, lwp, words, word_shift, loffset, VL_WORDS_I(obits));
         if (words) owp[words - 1] |= sign & ~VL_MASK_E(obits - loffset);
         for (int i = words; i < VL_WORDS_I(obits); ++i) owp[i] = sign;
         owp[lmsw] &= VL_MASK_E(lbits);
@@ -2838,6 +3167,117 @@ extern IData VL_VALUEPLUSARGS_INN(int, const std::string& ld, std::string& rdr)
 
 uint64_t VL_MURMUR64_HASH(const char* key) VL_PURE;
 
+//======================================================================
+// Pre-parsed $display formats
+
+extern void VL_WRITES_NX(const std::string& output) VL_MT_SAFE;
+extern void VL_FWRITES_NX(IData fpi, const std::string& output) VL_MT_SAFE;
+
+// Output of a $display-like format that Verilator parsed at compile time, built by a
+// chain of appends, e.g. VlFormat{16}.addText("a=", 2).addDecU(4, a).str().
+// Produces the same text as _vl_vsformat for the specifiers each method notes.
+class VlFormat final {
+    std::string m_out;  // Text so far
+
+    static char* decDigits(char* endp, uint64_t value) VL_PURE {
+        // Write decimal digits of value ending before endp, return the first digit
+        static const char s_pairs[] = "00010203040506070809"
+                                      "10111213141516171819"
+                                      "20212223242526272829"
+                                      "30313233343536373839"
+                                      "40414243444546474849"
+                                      "50515253545556575859"
+                                      "60616263646566676869"
+                                      "70717273747576777879"
+                                      "80818283848586878889"
+                                      "90919293949596979899";
+        while (value >= 100) {
+            const size_t i = (value % 100) * 2;
+            value /= 100;
+            *--endp = s_pairs[i + 1];
+            *--endp = s_pairs[i];
+        }
+        if (value >= 10) {
+            const size_t i = value * 2;
+            *--endp = s_pairs[i + 1];
+            *--endp = s_pairs[i];
+        } else {
+            *--endp = static_cast<char>('0' + value);
+        }
+        return endp;
+    }
+    void addPadded(int width, const char* startp, const char* endp) {
+        const int digits = static_cast<int>(endp - startp);
+        if (width > digits) m_out.append(width - digits, ' ');
+        m_out.append(startp, endp);
+    }
+
+public:
+    explicit VlFormat(size_t reserve) { m_out.reserve(reserve); }
+
+    // Literal text
+    VlFormat& addText(const char* textp, size_t len) {
+        m_out.append(textp, len);
+        return *this;
+    }
+    // %m: scope name, with a '.' after it if more hierarchy follows
+    VlFormat& addScope(const char* namep, bool dot) {
+        m_out += namep;
+        if (dot && *namep) m_out += '.';
+        return *this;
+    }
+    // %c
+    VlFormat& addChar(QData ld) {
+        m_out += static_cast<char>(ld & 0xff);
+        return *this;
+    }
+    // %d as unsigned, right aligned to width (%0d is width 0)
+    VlFormat& addDecU(int width, QData ld) {
+        char buf[24];
+        char* const endp = buf + sizeof(buf);
+        addPadded(width, decDigits(endp, ld), endp);
+        return *this;
+    }
+    // %d of a signed value of lbits, right aligned to width (%0d is width 0)
+    VlFormat& addDecS(int lbits, int width, QData ld) {
+        char buf[24];
+        char* const endp = buf + sizeof(buf);
+        const int64_t value = static_cast<int64_t>(VL_EXTENDS_QQ(lbits, lbits, ld));
+        char* startp = decDigits(endp, value < 0 ? 0 - static_cast<uint64_t>(value) : value);
+        if (value < 0) *--startp = '-';
+        addPadded(width, startp, endp);
+        return *this;
+    }
+    // %x of the low lbits, all digits, or without leading zeros if minimal (%0x)
+    VlFormat& addHex(int lbits, bool minimal, QData ld) {
+        ld &= VL_MASK_Q(lbits);
+        int msb = lbits - 1;
+        if (minimal) {
+            while (msb && !((ld >> msb) & 1)) --msb;
+        }
+        for (int lsb = (msb / 4) * 4; lsb >= 0; lsb -= 4) {
+            m_out += "0123456789abcdef"[(ld >> lsb) & 0xf];
+        }
+        return *this;
+    }
+    // %b of the low lbits, all digits, or without leading zeros if minimal (%0b)
+    VlFormat& addBin(int lbits, bool minimal, QData ld) {
+        ld &= VL_MASK_Q(lbits);
+        int msb = lbits - 1;
+        if (minimal) {
+            while (msb && !((ld >> msb) & 1)) --msb;
+        }
+        for (int lsb = msb; lsb >= 0; --lsb) m_out += static_cast<char>('0' + ((ld >> lsb) & 1));
+        return *this;
+    }
+    // %s of a string
+    VlFormat& addString(const std::string& str) {
+        m_out += str;
+        return *this;
+    }
+    std::string str() { return std::move(m_out); }
+};
+
 //======================================================================
 
 #endif  // Guard
@@ -43,6 +43,8 @@
 #include <vector>
 #include <functional>
 #include <queue>
+#include <condition_variable>
+#include <thread>
 // clang-format on
 
 class VerilatedScope;
@@ -54,21 +56,34 @@ class VerilatedScope;
 class VerilatedMsg final {
 public:
     // TYPES
-    struct Cmp final {
-        bool operator()(const VerilatedMsg& a, const VerilatedMsg& b) const {
-            return a.mtaskId() < b.mtaskId();
-        }
-    };
+    enum class Kind : uint8_t { FINISH, STOP, FATAL, WARN, PRINT };
 
 private:
     // MEMBERS
     uint32_t m_mtaskId;  // MTask that did enqueue
-    std::function<void()> m_cb;  // Lambda to execute when message received
+    Kind m_kind;  // Action to take when message received
+    bool m_maybe = false;  // STOP: only stop if enabled
+    int m_linenum = 0;  // Source line of the call
+    const char* m_filename = nullptr;  // Source file of the call
+    const char* m_hier = nullptr;  // Hierarchy of the call
+    const char* m_msgp = nullptr;  // FATAL/WARN: message text, static lifetime
+    std::string m_text;  // PRINT: text to print
+
 public:
     // CONSTRUCTORS
-    explicit VerilatedMsg(const std::function<void()>& cb)
+    VerilatedMsg(Kind kind, const char* filename, int linenum, const char* hier,
+                 const char* msgp = nullptr, bool maybe = false)
         : m_mtaskId{Verilated::mtaskId()}
-        , m_cb{cb} {}
+        , m_kind{kind}
+        , m_maybe{maybe}
+        , m_linenum{linenum}
+        , m_filename{filename}
+        , m_hier{hier}
+        , m_msgp{msgp} {}
+    explicit VerilatedMsg(std::string&& text)
+        : m_mtaskId{Verilated::mtaskId()}
+        , m_kind{Kind::PRINT}
+        , m_text{std::move(text)} {}
     ~VerilatedMsg() = default;
     VerilatedMsg(const VerilatedMsg&) = default;
     VerilatedMsg(VerilatedMsg&&) = default;
@@ -76,20 +91,22 @@ public:
     VerilatedMsg& operator=(VerilatedMsg&&) = default;
     // METHODS
     uint32_t mtaskId() const { return m_mtaskId; }
-    // Execute the lambda function
-    void run() const { m_cb(); }
+    // Take the action of the message
+    void run() const;
 };
 
 // Each thread has a queue it pushes to
 // This assumes no thread starts pushing the next tick until the previous has drained.
-// If more aggressiveness is needed, a double-buffered scheme might work well.
+// Threads post all their messages at once at the end of each mtask, and the consumer takes
+// everything posted so far, so the lock is taken once per mtask, not once per message.
 class VerilatedEvalMsgQueue final {
-    using VerilatedThreadQueue = std::multiset<VerilatedMsg, VerilatedMsg::Cmp>;
+    using VerilatedMsgs = std::vector<VerilatedMsg>;
 
     std::atomic<uint64_t> m_depth;  // Current depth of queue (see comments below)
 
     mutable VerilatedMutex m_mutex;  // Mutex protecting queue
-    VerilatedThreadQueue m_queue VL_GUARDED_BY(m_mutex);  // Message queue
+    VerilatedMsgs m_queue VL_GUARDED_BY(m_mutex);  // Message queue, in posting order
+    VerilatedMsgs m_running;  // Messages being run by process(), kept to reuse the storage
 public:
     // CONSTRUCTORS
     VerilatedEvalMsgQueue()
@@ -103,40 +120,42 @@ private:
 
 public:
     // METHODS
-    // Add message to queue (called by producer)
-    void post(const VerilatedMsg& msg) VL_MT_SAFE_EXCLUDES(m_mutex) {
+    // Move all messages to queue (called by producer)
+    void post(VerilatedMsgs& msgs) VL_MT_SAFE_EXCLUDES(m_mutex) {
         const VerilatedLockGuard lock{m_mutex};
-        m_queue.insert(msg);  // Pass by value to copy the message into queue
-        ++m_depth;
+        m_queue.insert(m_queue.end(), std::make_move_iterator(msgs.begin()),
+                       std::make_move_iterator(msgs.end()));
+        m_depth += msgs.size();
+        msgs.clear();
     }
     // Service queue until completion (called by consumer)
     void process() VL_MT_SAFE_EXCLUDES(m_mutex) {
         // Tracking m_depth is redundant to e.g. getting the mutex and looking at queue size,
         // but on the reader side it's 4x faster to test an atomic then getting a mutex
         while (m_depth) {
-            // Wait for a message to be added to the queue
-            // We don't use unique_lock as want to unlock with the message copy still in scope
-            m_mutex.lock();
-            assert(!m_queue.empty());  // Otherwise m_depth is wrong
-            // Unfortunately to release the lock we need to copy the message
-            // (Or have the message be a pointer, but then new/delete cost on each message)
-            // We assume messages are small, so copy
-            const auto it = m_queue.begin();
-            const VerilatedMsg msg = *(it);
-            m_queue.erase(it);
-            m_mutex.unlock();
-            --m_depth;  // Ok if outside critical section as only this code checks the value
             {
+                const VerilatedLockGuard lock{m_mutex};
+                assert(!m_queue.empty());  // Otherwise m_depth is wrong
+                m_running.swap(m_queue);
+            }
+            m_depth -= m_running.size();  // Ok outside critical section, only we decrement
+            // Messages run in mtask order, and in posting order within an mtask
+            std::stable_sort(m_running.begin(), m_running.end(),
+                             [](const VerilatedMsg& a, const VerilatedMsg& b) {
+                                 return a.mtaskId() < b.mtaskId();
+                             });
+            for (const VerilatedMsg& msg : m_running) {
                 VL_DEBUG_IF(VL_DBG_MSGF("Executing callback from mtaskId=%d\n", msg.mtaskId()););
                 msg.run();
             }
+            m_running.clear();
         }
     }
 };
 
 // Each thread has a local queue to build up messages until the end of the eval() call
 class VerilatedThreadMsgQueue final {
-    std::queue<VerilatedMsg> m_queue;
+    std::vector<VerilatedMsg> m_queue;  // Cleared after each flush, keeping its storage
 
 public:
     // CONSTRUCTORS
@@ -155,7 +174,7 @@ private:
 
 public:
     // Add message to queue, called by producer
-    static void post(const VerilatedMsg& msg) VL_MT_SAFE {
+    static void post(VerilatedMsg&& msg) VL_MT_SAFE {
         // Handle calls to threaded routines outside
         // of any mtask -- if an initial block calls $finish, say.
         if (Verilated::mtaskId() == 0) {
@@ -163,16 +182,15 @@ public:
             msg.run();
         } else {
             Verilated::endOfEvalReqdInc();
-            threadton().m_queue.push(msg);  // Pass by value to copy the message into queue
+            threadton().m_queue.push_back(std::move(msg));
         }
     }
     // Push all messages to the eval's queue
     static void flush(VerilatedEvalMsgQueue* evalMsgQp) VL_MT_SAFE {
-        while (!threadton().m_queue.empty()) {
-            evalMsgQp->post(threadton().m_queue.front());
-            threadton().m_queue.pop();
-            Verilated::endOfEvalReqdDec();
-        }
+        std::vector<VerilatedMsg>& queue = threadton().m_queue;
+        if (queue.empty()) return;
+        for (size_t i = 0; i < queue.size(); ++i) Verilated::endOfEvalReqdDec();
+        evalMsgQp->post(queue);
     }
 };
 
@@ -193,6 +211,57 @@ public:
     }
 };
 
+//======================================================================
+// Asynchronous output
+
+// With +verilator+output+async, text from $display, $write and $fwrite is copied
+// into a preallocated ring of records, and a background thread writes the records
+// in the order they were posted. Anything that must see the output in the file
+// or on the screen (file operations, $finish, errors) drains the ring first.
+class VerilatedAsyncOutput final {
+    // TYPES
+    struct Record final {
+        IData m_fdi = 0;  // File descriptor, or 0 for VL_PRINTF
+        std::string m_text;  // Text, reused so keeps its allocation
+    };
+
+    // MEMBERS
+    VerilatedContext* const m_contextp;  // Context whose files are written
+    mutable VerilatedMutex m_mutex;  // Protects all below
+    std::condition_variable_any m_cv;  // Notified on post, and when a record is written
+    std::vector<Record> m_ring VL_GUARDED_BY(m_mutex);  // Records, used modulo size
+    size_t m_head VL_GUARDED_BY(m_mutex) = 0;  // Next record to write out
+    size_t m_count VL_GUARDED_BY(m_mutex) = 0;  // Records posted and not yet written
+    bool m_exit VL_GUARDED_BY(m_mutex) = false;  // Writer thread must exit when drained
+    std::unique_ptr<std::thread> m_threadp;  // Writer thread
+
+public:
+    // CONSTRUCTORS
+    VerilatedAsyncOutput(VerilatedContext* contextp, size_t depth)
+        : m_contextp{contextp}
+        , m_ring(depth) {
+        for (Record& record : m_ring) record.m_text.reserve(128);
+        start();
+    }
+    ~VerilatedAsyncOutput() { stop(); }
+
+private:
+    VL_UNCOPYABLE(VerilatedAsyncOutput);
+
+public:
+    // METHODS
+    // Copy text to the ring, waiting for space if full
+    void post(IData fdi, const std::string& text) VL_MT_SAFE_EXCLUDES(m_mutex);
+    // Wait until all posted records are written out
+    void drain() VL_MT_SAFE_EXCLUDES(m_mutex);
+    // Start, or drain and stop, the writer thread, e.g. around fork()
+    void start() VL_MT_SAFE_EXCLUDES(m_mutex);
+    void stop() VL_MT_SAFE_EXCLUDES(m_mutex);
+
+private:
+    void writerMain() VL_MT_SAFE_EXCLUDES(m_mutex);
+};
+
 //======================================================================
 // VerilatedContextImpData
 
@@ -203,10 +272,38 @@ class VerilatedContextImpData final {
     friend class VerilatedContextImp;
 
 protected:
-    // Map of <scope_name, scope pointer>
-    // Used by scopeInsert, scopeFind, scopeErase, scopeNameMap
-    mutable VerilatedMutex m_nameMutex;  // Protect m_nameMap
+    // Hash of <scope_name, scope pointer>
+    // Used by scopeInsert, scopeFind, scopeErase
+    mutable VerilatedMutex m_nameMutex;  // Protect m_nameHash, m_nameMap
+    std::unordered_map<const char*, const VerilatedScope*, VerilatedCStrHash, VerilatedCStrEq>
+        m_nameHash VL_GUARDED_BY(m_nameMutex);
+    // Sorted map of <scope_name, scope pointer>, built from m_nameHash when
+    // first needed, so construction of large models needs no sorting
+    // Used by scopeNameMap, scopesDump
     VerilatedScopeNameMap m_nameMap VL_GUARDED_BY(m_nameMutex);
+    bool m_nameMapStale VL_GUARDED_BY(m_nameMutex) = false;  // m_nameMap needs rebuild
+    // Incremented on every scope insert or erase, to invalidate caches of lookups
+    uint64_t m_nameGeneration VL_GUARDED_BY(m_nameMutex) = 0;
+
+    // Asynchronous output, nullptr unless enabled
+    std::unique_ptr<VerilatedAsyncOutput> m_asyncOutputp;
+
+    // Callbacks adding the --prof-eval counters of each model
+    mutable VerilatedMutex m_evalCountersMutex;  // Protect m_evalCountersCbs
+    std::vector<std::pair<VerilatedContext::EvalCountersCb, const void*>>
+        m_evalCountersCbs VL_GUARDED_BY(m_evalCountersMutex);
+
+    // Random seed epoch of this context, unique across all contexts, see vl_thread_rng
+    std::atomic<uint32_t> m_randSeedEpoch{0};
+
+    const VerilatedScopeNameMap& nameMap() VL_REQUIRES(m_nameMutex) {
+        if (m_nameMapStale) {
+            m_nameMapStale = false;
+            m_nameMap.clear();
+            m_nameMap.insert(m_nameHash.begin(), m_nameHash.end());
+        }
+        return m_nameMap;
+    }
 };
 
 //======================================================================
@@ -223,8 +320,8 @@ class VerilatedContextImp final : VerilatedContext {
     // Medium speed, so uses singleton accessing
     struct Statics final {
         VerilatedMutex s_randMutex;  // Mutex protecting s_randSeedEpoch
-        // Number incrementing on each reseed, 0=illegal
-        int s_randSeedEpoch = 1;  // Reads ok, wish had a VL_WRITE_GUARDED_BY(s_randMutex)
+        // Number incrementing on each reseed of any context, 0=illegal
+        uint32_t s_randSeedEpoch VL_GUARDED_BY(s_randMutex) = 0;
     };
     static Statics& s() VL_MT_SAFE {
         static Statics s_s;
@@ -240,7 +337,10 @@ public:  // But only for verilated*.cpp
 
     // Random seed handling
     uint64_t randSeedDefault64() const VL_MT_SAFE;
-    static uint32_t randSeedEpoch() VL_MT_SAFE { return s().s_randSeedEpoch; }
+    uint32_t randSeedEpoch() const VL_MT_SAFE {
+        return m_impdatap->m_randSeedEpoch.load(std::memory_order_acquire);
+    }
+    void randSeedEpochNew() VL_MT_SAFE;
 
     // METHODS - timeformat
     int timeFormatUnits() const VL_MT_SAFE {
@@ -269,6 +369,15 @@ public:  // But only for verilated*.cpp
     // METHODS - scope name - INTERNAL only for verilated*.cpp
     void scopeInsert(const VerilatedScope* scopep) VL_MT_SAFE;
     void scopeErase(const VerilatedScope* scopep) VL_MT_SAFE;
+    uint64_t scopeGeneration() const VL_MT_SAFE;
+
+    // METHODS - asynchronous output - INTERNAL only for verilated*.cpp
+    VerilatedAsyncOutput* asyncOutputp() const VL_MT_SAFE {
+        return m_impdatap->m_asyncOutputp.get();
+    }
+    void asyncOutputDrain() const VL_MT_SAFE {
+        if (VerilatedAsyncOutput* const asyncp = asyncOutputp()) asyncp->drain();
+    }
 
     // METHODS - file IO - INTERNAL only for verilated*.cpp
 
@@ -303,11 +412,13 @@ public:  // But only for verilated*.cpp
         return (idx | (1UL << 31));  // bit 31 indicates not MCD
     }
     void fdFlush(IData fdi) VL_MT_SAFE_EXCLUDES(m_fdMutex) {
+        asyncOutputDrain();
         const VerilatedLockGuard lock{m_fdMutex};
         const VerilatedFpList fdlist = fdToFpList(fdi);
         for (const auto& i : fdlist) std::fflush(i);
     }
     IData fdSeek(IData fdi, IData offset, IData origin) VL_MT_SAFE_EXCLUDES(m_fdMutex) {
+        asyncOutputDrain();
         const VerilatedLockGuard lock{m_fdMutex};
         const VerilatedFpList fdlist = fdToFpList(fdi);
         if (VL_UNLIKELY(fdlist.size() != 1)) return ~0U;  // -1
@@ -315,12 +426,20 @@ public:  // But only for verilated*.cpp
             std::fseek(*fdlist.begin(), static_cast<long>(offset), static_cast<int>(origin)));
     }
     IData fdTell(IData fdi) VL_MT_SAFE_EXCLUDES(m_fdMutex) {
+        asyncOutputDrain();
         const VerilatedLockGuard lock{m_fdMutex};
         const VerilatedFpList fdlist = fdToFpList(fdi);
         if (VL_UNLIKELY(fdlist.size() != 1)) return ~0U;  // -1
         return static_cast<IData>(std::ftell(*fdlist.begin()));
     }
     void fdWrite(IData fdi, const std::string& output) VL_MT_SAFE_EXCLUDES(m_fdMutex) {
+        if (VerilatedAsyncOutput* const asyncp = asyncOutputp()) {
+            asyncp->post(fdi, output);
+            return;
+        }
+        fdWriteNow(fdi, output);
+    }
+    void fdWriteNow(IData fdi, const std::string& output) VL_MT_SAFE_EXCLUDES(m_fdMutex) {
         const VerilatedLockGuard lock{m_fdMutex};
         const VerilatedFpList fdlist = fdToFpList(fdi);
         for (const auto& i : fdlist) {
@@ -329,6 +448,7 @@ public:  // But only for verilated*.cpp
         }
     }
     void fdClose(IData fdi) VL_MT_SAFE_EXCLUDES(m_fdMutex) {
+        asyncOutputDrain();
         const VerilatedLockGuard lock{m_fdMutex};
         if (VL_BITISSET_I(fdi, 31)) {
             // Non-MCD case
@@ -353,6 +473,7 @@ public:  // But only for verilated*.cpp
         }
     }
     FILE* fdToFp(IData fdi) VL_MT_SAFE_EXCLUDES(m_fdMutex) {
+        asyncOutputDrain();
         const VerilatedLockGuard lock{m_fdMutex};
         const VerilatedFpList fdlist = fdToFpList(fdi);
         if (VL_UNLIKELY(fdlist.size() != 1)) return nullptr;
@@ -22,9 +22,28 @@
 
 #include "verilated_threads.h"
 
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
 #include <fstream>
 #include <string>
 
+#ifdef __linux
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#if defined(__linux) && (defined(__x86_64__) || defined(__aarch64__))
+#define VL_PROF_SAMPLE_SUPPORTED
+#include <csignal>
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <sys/time.h>
+#include <ucontext.h>
+#endif
+
 //=============================================================================
 // Globals
 
@@ -34,6 +53,109 @@ thread_local VlExecutionProfiler::ExecutionTrace VlExecutionProfiler::t_trace;
 
 constexpr const char* const VlExecutionRecord::s_ascii[];
 
+//=============================================================================
+// Hardware performance counters of a thread, for +verilator+prof+exec+hwcounters
+
+// Names of the counters, as written to the profile, in payload order
+static const char* const s_hwCounterNames[VlExecutionRecord::HW_COUNTERS]
+    = {"cycles", "instructions", "l1dMisses", "llcMisses", "branchMisses"};
+
+class VlHwCounters final {
+    // MEMBERS
+    int m_leaderFd = -1;  // perf_event group leader, -1 if not counting
+    std::vector<int> m_fds;  // All opened counters, leader first
+    // Position of each counter in a group read, or -1 if the CPU lacks it
+    int m_slots[VlExecutionRecord::HW_COUNTERS];
+    uint64_t m_begin[VlExecutionRecord::HW_COUNTERS]{};  // Values at mtask begin
+
+    bool read(uint64_t* valuesp) const {
+#ifdef __linux
+        uint64_t buf[VlExecutionRecord::HW_COUNTERS + 1];  // PERF_FORMAT_GROUP: nr, values
+        const ssize_t size = ::read(m_leaderFd, buf, sizeof(buf));
+        if (VL_UNLIKELY(size < static_cast<ssize_t>(sizeof(uint64_t)))) return false;
+        for (size_t i = 0; i < VlExecutionRecord::HW_COUNTERS; ++i) {
+            valuesp[i] = m_slots[i] >= 0 ? buf[m_slots[i] + 1] : 0;
+        }
+        return true;
+#else
+        return false;
+#endif
+    }
+
+public:
+    // CONSTRUCTORS
+    VlHwCounters() { std::fill(std::begin(m_slots), std::end(m_slots), -1); }
+    ~VlHwCounters() {
+#ifdef __linux
+        for (const int fd : m_fds) close(fd);
+#endif
+    }
+    VL_UNCOPYABLE(VlHwCounters);
+
+    // METHODS
+    bool enabled() const { return m_leaderFd >= 0; }
+    // Open the counters for the calling thread, return false if not possible
+    bool open() {
+#ifdef __linux
+        // User-space only counts, so works without privileges at perf_event_paranoid <= 2
+        const auto openOne = [this](uint32_t type, uint64_t config) {
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.type = type;
+            attr.config = config;
+            attr.disabled = m_leaderFd < 0;  // Leader starts the group once all are added
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_GROUP;
+            const int fd = static_cast<int>(
+                syscall(SYS_perf_event_open, &attr, 0, -1, m_leaderFd, 0));
+            if (fd >= 0) {
+                if (m_leaderFd < 0) m_leaderFd = fd;
+                m_fds.push_back(fd);
+            }
+            return fd >= 0;
+        };
+        const auto cacheMiss = [](uint64_t cache) -> uint64_t {
+            return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+                   | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        };
+        const std::pair<uint32_t, uint64_t> events[VlExecutionRecord::HW_COUNTERS] = {
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+            {PERF_TYPE_HW_CACHE, cacheMiss(PERF_COUNT_HW_CACHE_L1D)},
+            {PERF_TYPE_HW_CACHE, cacheMiss(PERF_COUNT_HW_CACHE_LL)},
+            {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+        };
+        // Cycles lead the group, without them the other counters are of little use
+        for (size_t i = 0; i < VlExecutionRecord::HW_COUNTERS; ++i) {
+            if (openOne(events[i].first, events[i].second)) {
+                m_slots[i] = static_cast<int>(m_fds.size()) - 1;
+            } else if (i == 0) {
+                return false;
+            }
+        }
+        ioctl(m_leaderFd, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+        return true;
+#else
+        return false;
+#endif
+    }
+    void begin() {
+        if (!read(m_begin)) std::fill(std::begin(m_begin), std::end(m_begin), 0);
+    }
+    void end(uint32_t* deltasp) const {
+        uint64_t values[VlExecutionRecord::HW_COUNTERS];
+        if (!read(values)) std::copy(std::begin(m_begin), std::end(m_begin), values);
+        for (size_t i = 0; i < VlExecutionRecord::HW_COUNTERS; ++i) {
+            const uint64_t delta = values[i] - m_begin[i];
+            deltasp[i] = static_cast<uint32_t>(std::min<uint64_t>(delta, 0xffffffffULL));
+        }
+    }
+};
+
+static thread_local VlHwCounters t_hwCounters;
+
 //=============================================================================
 // VlExecutionProfiler implementation
 
@@ -108,17 +230,38 @@ void VlExecutionProfiler::setupThread(uint32_t threadId) {
     // Reserve some space in the thread-local profiling buffer, in order to try to avoid malloc
     // while profiling.
     t_trace.reserve(RESERVED_TRACE_CAPACITY);
+    if (m_context.profExecHwCounters() && !t_hwCounters.enabled()) {
+        if (t_hwCounters.open()) {
+            m_hwCountersOpen = true;
+        } else if (threadId == 0) {
+            VL_PRINTF_MT("%%Warning: +verilator+prof+exec+hwcounters: hardware performance "
+                         "counters not available, see perf_event_paranoid\n");
+        }
+    }
     // Register thread-local buffer in list of all buffers
     bool exists;
     {
         const VerilatedLockGuard lock{m_mutex};
         exists = !m_traceps.emplace(threadId, &t_trace).second;
+        m_waitStatsps.emplace(threadId, &VlMTaskVertex::waitStats());
     }
     if (VL_UNLIKELY(exists)) {
         VL_FATAL_MT(__FILE__, __LINE__, "", "multiple initialization of profiler on some thread");
     }
 }
 
+void VlExecutionProfiler::hwCountersBegin() {
+    if (VL_UNLIKELY(t_hwCounters.enabled())) t_hwCounters.begin();
+}
+
+void VlExecutionProfiler::hwCountersEnd(uint32_t* deltasp) {
+    if (VL_UNLIKELY(t_hwCounters.enabled())) {
+        t_hwCounters.end(deltasp);
+    } else {
+        std::fill(deltasp, deltasp + VlExecutionRecord::HW_COUNTERS, 0);
+    }
+}
+
 void VlExecutionProfiler::clear() VL_MT_SAFE_EXCLUDES(m_mutex) {
     const VerilatedLockGuard lock{m_mutex};
     for (const auto& pair : m_traceps) {
@@ -127,6 +270,7 @@ void VlExecutionProfiler::clear() VL_MT_SAFE_EXCLUDES(m_mutex) {
         tracep->clear();
         tracep->reserve(reserve);
     }
+    for (const auto& pair : m_waitStatsps) *pair.second = VlThreadWaitStats{};
 }
 
 void VlExecutionProfiler::dump(const char* filenamep, uint64_t tickEnd)
@@ -134,7 +278,8 @@ void VlExecutionProfiler::dump(const char* filenamep, uint64_t tickEnd)
     const VerilatedLockGuard lock{m_mutex};
     VL_DEBUG_IF(VL_DBG_MSGF("+prof+exec writing to '%s'\n", filenamep););
 
-    FILE* const fp = std::fopen(filenamep, "w");
+    const bool binary = m_context.profExecBinary();
+    FILE* const fp = std::fopen(filenamep, binary ? "wb" : "w");
     if (VL_UNLIKELY(!fp)) VL_FATAL_MT(filenamep, 0, "", "+prof+exec+file file not writable");
 
     // TODO Perhaps merge with verilated_coverage output format, so can
@@ -150,6 +295,19 @@ void VlExecutionProfiler::dump(const char* filenamep, uint64_t tickEnd)
         numa = threadPoolp->numaStatus();
     }
     fprintf(fp, "VLPROF info numa %s\n", numa.c_str());
+    if (m_hwCountersOpen) {
+        std::string names;
+        for (const char* const namep : s_hwCounterNames) names += std::string{" "} + namep;
+        fprintf(fp, "VLPROF info hwcounters%s\n", names.c_str());
+    }
+    if (binary) {
+        // Record type codes of the binary records, in code order
+        std::string names;
+        for (const char* const namep : VlExecutionRecord::s_ascii) {
+            names += std::string{" "} + namep;
+        }
+        fprintf(fp, "VLPROF info types%s\n", names.c_str());
+    }
     // Note that VerilatedContext will by default create as many threads as there are hardware
     // processors, but not all of them might be utilized. Report the actual number that has trace
     // entries to avoid over-counting.
@@ -159,6 +317,18 @@ void VlExecutionProfiler::dump(const char* filenamep, uint64_t tickEnd)
     }
     fprintf(fp, "VLPROF stat threads %u\n", threads);
     fprintf(fp, "VLPROF stat yields %" PRIu64 "\n", VlMTaskVertex::yields());
+    for (const auto& pair : m_waitStatsps) {
+        if (m_traceps.at(pair.first)->empty()) continue;
+        const VlThreadWaitStats& stats = *pair.second;
+        fprintf(fp, "VLPROF stat thread%" PRIu32 "_waits %" PRIu64 "\n", pair.first,
+                stats.m_waits);
+        fprintf(fp, "VLPROF stat thread%" PRIu32 "_wait_ticks %" PRIu64 "\n", pair.first,
+                stats.m_waitTicks);
+        fprintf(fp, "VLPROF stat thread%" PRIu32 "_yields %" PRIu64 "\n", pair.first,
+                stats.m_yields);
+        fprintf(fp, "VLPROF stat thread%" PRIu32 "_sleeps %" PRIu64 "\n", pair.first,
+                stats.m_sleeps);
+    }
 
     // Copy /proc/cpuinfo into this output so verilator_gantt can be run on
     // a different machine
@@ -174,6 +344,11 @@ void VlExecutionProfiler::dump(const char* filenamep, uint64_t tickEnd)
         const uint32_t threadId = pair.first;
         ExecutionTrace* const tracep = pair.second;
         if (tracep->empty()) continue;
+        if (binary) {
+            fprintf(fp, "VLPROFTHREAD %" PRIu32 " records %zu\n", threadId, tracep->size());
+            dumpBinary(fp, *tracep);
+            continue;
+        }
         fprintf(fp, "VLPROFTHREAD %" PRIu32 "\n", threadId);
 
         for (const VlExecutionRecord& er : *tracep) {
@@ -201,7 +376,13 @@ void VlExecutionProfiler::dump(const char* filenamep, uint64_t tickEnd)
             }
             case VlExecutionRecord::Type::MTASK_END: {
                 const auto& payload = er.m_payload.mtaskEnd;
-                fprintf(fp, " predictCost %u\n", payload.m_predictCost);
+                fprintf(fp, " predictCost %u", payload.m_predictCost);
+                if (m_hwCountersOpen) {
+                    for (size_t i = 0; i < VlExecutionRecord::HW_COUNTERS; ++i) {
+                        fprintf(fp, " %s %u", s_hwCounterNames[i], payload.m_hwCounters[i]);
+                    }
+                }
+                fprintf(fp, "\n");
                 break;
             }
             case VlExecutionRecord::Type::THREAD_SCHEDULE_WAIT_BEGIN:
@@ -223,3 +404,268 @@ void VlExecutionProfiler::dump(const char* filenamep, uint64_t tickEnd)
 
     std::fclose(fp);
 }
+
+// Binary records are written in little-endian order, as a uint8_t type code
+// (see "VLPROF info types"), a uint64_t time, then per type:
+//   SECTION_PUSH: uint16_t length, name characters
+//   MTASK_BEGIN: uint32_t id, predictStart, cpu, uint16_t length, hierBlock characters
+//   MTASK_END: uint32_t predictCost, then uint32_t counters if "VLPROF info hwcounters"
+//   THREAD_SCHEDULE_WAIT_BEGIN/END: uint32_t cpu
+// This is about a third the size of the text records, and much faster to read.
+static void profBinaryU16(std::string& buf, uint16_t value) VL_PURE {
+    for (int i = 0; i < 2; ++i) buf += static_cast<char>((value >> (i * 8)) & 0xff);
+}
+static void profBinaryU32(std::string& buf, uint32_t value) VL_PURE {
+    for (int i = 0; i < 4; ++i) buf += static_cast<char>((value >> (i * 8)) & 0xff);
+}
+static void profBinaryU64(std::string& buf, uint64_t value) VL_PURE {
+    for (int i = 0; i < 8; ++i) buf += static_cast<char>((value >> (i * 8)) & 0xff);
+}
+static void profBinaryStr(std::string& buf, const char* strp) VL_PURE {
+    const size_t len = std::min<size_t>(std::strlen(strp), 0xffff);
+    profBinaryU16(buf, static_cast<uint16_t>(len));
+    buf.append(strp, len);
+}
+
+void VlExecutionProfiler::dumpBinary(FILE* fp, const ExecutionTrace& trace) const {
+    std::string buf;
+    buf.reserve(1 << 16);
+    for (const VlExecutionRecord& er : trace) {
+        buf += static_cast<char>(er.m_type);
+        profBinaryU64(buf, er.m_tick - m_tickBegin);
+        switch (er.m_type) {
+        case VlExecutionRecord::Type::SECTION_POP:
+        case VlExecutionRecord::Type::EXEC_GRAPH_BEGIN:
+        case VlExecutionRecord::Type::EXEC_GRAPH_END:
+            // No payload
+            break;
+        case VlExecutionRecord::Type::MTASK_BEGIN: {
+            const auto& payload = er.m_payload.mtaskBegin;
+            profBinaryU32(buf, payload.m_id);
+            profBinaryU32(buf, payload.m_predictStart);
+            profBinaryU32(buf, payload.m_cpu);
+            profBinaryStr(buf, payload.m_hierBlock);
+            break;
+        }
+        case VlExecutionRecord::Type::MTASK_END: {
+            const auto& payload = er.m_payload.mtaskEnd;
+            profBinaryU32(buf, payload.m_predictCost);
+            if (m_hwCountersOpen) {
+                for (size_t i = 0; i < VlExecutionRecord::HW_COUNTERS; ++i) {
+                    profBinaryU32(buf, payload.m_hwCounters[i]);
+                }
+            }
+            break;
+        }
+        case VlExecutionRecord::Type::THREAD_SCHEDULE_WAIT_BEGIN:
+        case VlExecutionRecord::Type::THREAD_SCHEDULE_WAIT_END:
+            profBinaryU32(buf, er.m_payload.threadScheduleWait.m_cpu);
+            break;
+        case VlExecutionRecord::Type::SECTION_PUSH:
+            profBinaryStr(buf, er.m_payload.sectionPush.m_name);
+            break;
+        default: abort();  // LCOV_EXCL_LINE
+        }
+        if (buf.size() >= (1 << 16) - 64) {
+            std::fwrite(buf.data(), 1, buf.size(), fp);
+            buf.clear();
+        }
+    }
+    std::fwrite(buf.data(), 1, buf.size(), fp);
+}
+
+//=============================================================================
+// VlEvalCounters implementation
+
+void VlEvalCounters::addCounters(const void* selfp, std::map<std::string, uint64_t>& counters) {
+    const VlEvalCounters& self = *static_cast<const VlEvalCounters*>(selfp);
+    const std::string prefix = self.m_name + ".";
+    counters[prefix + "evals"] += self.m_evals;
+    counters[prefix + "mtasks"] += self.m_mtasks.load(std::memory_order_relaxed);
+    for (const Region& r : self.m_regions) {
+        if (!r.m_namep) continue;
+        const std::string regionPrefix = prefix + r.m_namep + ".";
+        counters[regionPrefix + "loops"] += r.m_loops;
+        counters[regionPrefix + "iterations"] += r.m_iterations;
+        uint64_t& maxIterations = counters[regionPrefix + "maxIterations"];
+        maxIterations = std::max<uint64_t>(maxIterations, r.m_maxIterations);
+        for (size_t i = 0; i < r.m_triggerFires.size(); ++i) {
+            counters[regionPrefix + "trigger" + std::to_string(i)] += r.m_triggerFires[i];
+        }
+    }
+}
+
+void VlEvalCounters::write(const char* modelp, const std::string& filename) const VL_MT_SAFE {
+    static VerilatedMutex s_mutex;
+    const VerilatedLockGuard lock{s_mutex};
+
+    // As with VlPgoProfiler, the first model creates the file, later models append
+    static bool s_firstCall = true;
+
+    VL_DEBUG_IF(VL_DBG_MSGF("+prof+eval+file writing to '%s'\n", filename.c_str()););
+
+    FILE* const fp = std::fopen(filename.c_str(), s_firstCall ? "w" : "a");
+    if (VL_UNLIKELY(!fp)) {
+        VL_FATAL_MT(filename.c_str(), 0, "", "+prof+eval+file file not writable");
+    }
+    if (s_firstCall) {
+        fprintf(fp, "VLPROFEVAL version 1.0 # Verilator evaluation counters version 1.0\n");
+    }
+    s_firstCall = false;
+
+    fprintf(fp, "VLPROFEVAL model %s name %s evals %" PRIu64 " mtasks %" PRIu64 "\n", modelp,
+            m_name.c_str(), m_evals, m_mtasks.load(std::memory_order_relaxed));
+    for (const Region& r : m_regions) {
+        if (!r.m_namep) continue;
+        fprintf(fp,
+                "VLPROFEVAL region %s loops %" PRIu64 " iterations %" PRIu64
+                " maxIterations %" PRIu32 "\n",
+                r.m_namep, r.m_loops, r.m_iterations, r.m_maxIterations);
+        // Each run of a loop has a last iteration finding nothing triggered. Regions that need
+        // more than 2 further iterations on average usually have slowly converging
+        // combinational cycles (see UNOPTFLAT), or long chains of generated clocks.
+        if (r.m_loops && r.m_iterations - r.m_loops > 2 * r.m_loops) {
+            const std::string msg
+                = std::string{"'"} + r.m_namep + "' region took "
+                  + std::to_string(static_cast<double>(r.m_iterations - r.m_loops) / r.m_loops)
+                  + " iterations per evaluation on average, check for combinational cycles";
+            VL_WARN_MT("", 0, m_name.c_str(), msg.c_str());
+        }
+        for (size_t i = 0; i < r.m_triggerFires.size(); ++i) {
+            fprintf(fp, "VLPROFEVAL trigger %s %zu fires %" PRIu64, r.m_namep, i,
+                    r.m_triggerFires[i]);
+            if (r.m_triggerNamesp) fprintf(fp, " %s", r.m_triggerNamesp[i]);
+            fprintf(fp, "\n");
+        }
+    }
+    std::fclose(fp);
+}
+
+//=============================================================================
+// VlSampleProfiler implementation
+
+// Sampling period of --prof-sample, in microseconds
+static constexpr long PROF_SAMPLE_PERIOD_US = 1000;
+
+#ifdef VL_PROF_SAMPLE_SUPPORTED
+
+// Samples are counted per program counter in a lock-free open addressing hash table, as the
+// signal handler may neither lock nor allocate
+static constexpr size_t PROF_SAMPLE_SLOTS_LOG2 = 16;
+static constexpr size_t PROF_SAMPLE_SLOTS = 1ULL << PROF_SAMPLE_SLOTS_LOG2;
+
+struct VlSampleSlot final {
+    std::atomic<uintptr_t> m_pc{0};  // Sampled program counter, 0 if slot unused
+    std::atomic<uint64_t> m_count{0};  // Number of samples at m_pc
+};
+
+static VlSampleSlot s_sampleSlots[PROF_SAMPLE_SLOTS];
+static std::atomic<uint64_t> s_sampleDropped{0};  // Samples with no slot left
+static struct sigaction s_samplePrevAction;  // SIGPROF action before sampling started
+
+static void vlSampleHandler(int, siginfo_t*, void* ucontextp) {
+    const ucontext_t* const ucp = static_cast<const ucontext_t*>(ucontextp);
+#if defined(__x86_64__)
+    const uintptr_t pc = static_cast<uintptr_t>(ucp->uc_mcontext.gregs[REG_RIP]);
+#else
+    const uintptr_t pc = static_cast<uintptr_t>(ucp->uc_mcontext.pc);
+#endif
+    size_t index = (static_cast<uint64_t>(pc) * 0x9E3779B97F4A7C15ULL)
+                   >> (64 - PROF_SAMPLE_SLOTS_LOG2);
+    for (size_t probe = 0; probe < PROF_SAMPLE_SLOTS; ++probe) {
+        VlSampleSlot& slot = s_sampleSlots[index];
+        uintptr_t slotPc = slot.m_pc.load(std::memory_order_relaxed);
+        if (slotPc == 0 && slot.m_pc.compare_exchange_strong(slotPc, pc)) slotPc = pc;
+        if (slotPc == pc) {
+            slot.m_count.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        index = (index + 1) & (PROF_SAMPLE_SLOTS - 1);
+    }
+    s_sampleDropped.fetch_add(1, std::memory_order_relaxed);
+}
+
+// Name of the function containing 'pc', without arguments
+static std::string vlSampleFuncName(uintptr_t pc) {
+    Dl_info info;
+    if (!dladdr(reinterpret_cast<void*>(pc), &info) || !info.dli_sname) return "<unknown>";
+    std::string name = info.dli_sname;
+    int status = 0;
+    char* const demangledp = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+    if (demangledp) {
+        name = demangledp;
+        std::free(demangledp);
+    }
+    const size_t paren = name.find('(');
+    if (paren != std::string::npos) name.erase(paren);
+    return name;
+}
+
+#endif
+
+static VerilatedMutex s_sampleMutex;  // Protects s_sampleUsers
+static unsigned s_sampleUsers = 0;  // Number of models that started sampling
+
+void VlSampleProfiler::start() VL_MT_SAFE {
+    const VerilatedLockGuard lock{s_sampleMutex};
+    if (s_sampleUsers++) return;
+#ifdef VL_PROF_SAMPLE_SUPPORTED
+    struct sigaction action;
+    std::memset(&action, 0, sizeof(action));
+    action.sa_sigaction = vlSampleHandler;
+    action.sa_flags = SA_SIGINFO | SA_RESTART;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGPROF, &action, &s_samplePrevAction);
+    const itimerval timer{{0, PROF_SAMPLE_PERIOD_US}, {0, PROF_SAMPLE_PERIOD_US}};
+    setitimer(ITIMER_PROF, &timer, nullptr);
+#else
+    VL_PRINTF_MT("%%Warning: --prof-sample: sampling is not supported on this platform\n");
+#endif
+}
+
+void VlSampleProfiler::stop(const std::string& filename) VL_MT_SAFE {
+    const VerilatedLockGuard lock{s_sampleMutex};
+    if (--s_sampleUsers) return;
+
+    // Aggregate samples by function
+    std::map<std::string, uint64_t> funcSamples;
+    uint64_t total = 0;
+    uint64_t dropped = 0;
+#ifdef VL_PROF_SAMPLE_SUPPORTED
+    const itimerval timer{{0, 0}, {0, 0}};
+    setitimer(ITIMER_PROF, &timer, nullptr);
+    // A SIGPROF may still be pending, which by default would terminate the process
+    if (!(s_samplePrevAction.sa_flags & SA_SIGINFO) && s_samplePrevAction.sa_handler == SIG_DFL) {
+        signal(SIGPROF, SIG_IGN);
+    } else {
+        sigaction(SIGPROF, &s_samplePrevAction, nullptr);
+    }
+    for (VlSampleSlot& slot : s_sampleSlots) {
+        const uintptr_t pc = slot.m_pc.exchange(0);
+        const uint64_t count = slot.m_count.exchange(0);
+        if (!pc) continue;
+        funcSamples[vlSampleFuncName(pc)] += count;
+        total += count;
+    }
+    dropped = s_sampleDropped.exchange(0);
+#endif
+
+    VL_DEBUG_IF(VL_DBG_MSGF("+prof+sample+file writing to '%s'\n", filename.c_str()););
+    FILE* const fp = std::fopen(filename.c_str(), "w");
+    if (VL_UNLIKELY(!fp)) {
+        VL_FATAL_MT(filename.c_str(), 0, "", "+prof+sample+file file not writable");
+    }
+    fprintf(fp, "VLPROFSAMPLE version 1.0 # Verilator sampling profile version 1.0\n");
+    fprintf(fp, "VLPROFSAMPLE period_us %ld\n", PROF_SAMPLE_PERIOD_US);
+    fprintf(fp, "VLPROFSAMPLE total %" PRIu64 " dropped %" PRIu64 "\n", total + dropped, dropped);
+    std::vector<std::pair<uint64_t, std::string>> sorted;
+    for (const auto& pair : funcSamples) sorted.emplace_back(pair.second, pair.first);
+    std::sort(sorted.begin(), sorted.end(), [](const std::pair<uint64_t, std::string>& a,
+                                               const std::pair<uint64_t, std::string>& b) {
+        return a.first != b.first ? a.first > b.first : a.second < b.second;
+    });
+    for (const auto& pair : sorted) {
+        fprintf(fp, "VLPROFSAMPLE samples %" PRIu64 " %s\n", pair.first, pair.second.c_str());
+    }
+    std::fclose(fp);
+}
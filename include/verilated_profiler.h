@@ -29,11 +29,13 @@
 #include <array>
 #include <atomic>
 #include <cassert>
+#include <map>
 #include <string>
 #include <type_traits>
 #include <vector>
 
 class VlExecutionProfiler;
+struct VlThreadWaitStats;
 class VlThreadPool;
 
 //=============================================================================
@@ -71,6 +73,13 @@ VL_ATTR_ALWINLINE QData VL_CPU_TICK() {
 class VlExecutionRecord final {
     friend class VlExecutionProfiler;
 
+public:
+    // CONSTANTS
+    // Number of hardware performance counters sampled per mtask, see
+    // +verilator+prof+exec+hwcounters
+    static constexpr size_t HW_COUNTERS = 5;
+
+private:
     // TYPES
     enum class Type : uint8_t {
 #define VL_FOREACH_MACRO(id, name) id,
@@ -96,6 +105,7 @@ class VlExecutionRecord final {
         } mtaskBegin;
         struct {
             uint32_t m_predictCost;  // How long scheduler predicted would take
+            uint32_t m_hwCounters[HW_COUNTERS];  // Hardware counter deltas over the mtask
         } mtaskEnd;
         struct {
             uint32_t m_cpu;  // Executing CPU id
@@ -109,6 +119,7 @@ class VlExecutionRecord final {
     Type m_type;  // The record type
     static_assert(alignof(uint64_t) >= alignof(Payload), "Padding not allowed");
     static_assert(alignof(Payload) >= alignof(Type), "Padding not allowed");
+    static_assert(sizeof(Payload) <= 24, "Hardware counters should not grow records");
 
 public:
     // CONSTRUCTOR
@@ -120,17 +131,8 @@ public:
         m_type = Type::SECTION_PUSH;
     }
     void sectionPop() { m_type = Type::SECTION_POP; }
-    void mtaskBegin(uint32_t id, uint32_t predictStart, const char* hierBlock = "") {
-        m_payload.mtaskBegin.m_id = id;
-        m_payload.mtaskBegin.m_predictStart = predictStart;
-        m_payload.mtaskBegin.m_cpu = VlOs::getcpu();
-        m_payload.mtaskBegin.m_hierBlock = hierBlock;
-        m_type = Type::MTASK_BEGIN;
-    }
-    void mtaskEnd(uint32_t predictCost) {
-        m_payload.mtaskEnd.m_predictCost = predictCost;
-        m_type = Type::MTASK_END;
-    }
+    inline void mtaskBegin(uint32_t id, uint32_t predictStart, const char* hierBlock = "");
+    inline void mtaskEnd(uint32_t predictCost);
     void threadScheduleWaitBegin() {
         m_payload.threadScheduleWait.m_cpu = VlOs::getcpu();
         m_type = Type::THREAD_SCHEDULE_WAIT_BEGIN;
@@ -172,13 +174,20 @@ class VlExecutionProfiler final : public VerilatedVirtualBase {
     mutable VerilatedMutex m_mutex;
     // Map from thread id to &t_trace of given thread
     std::map<uint32_t, ExecutionTrace*> m_traceps VL_GUARDED_BY(m_mutex);
+    // Map from thread id to the mtask waiting statistics of given thread
+    std::map<uint32_t, VlThreadWaitStats*> m_waitStatsps VL_GUARDED_BY(m_mutex);
 
     bool m_enabled = false;  // Is profiling currently enabled
+    std::atomic<bool> m_hwCountersOpen{false};  // Hardware counters opened on some thread
 
     uint64_t m_tickBegin = 0;  // Sample time (rdtsc() on x86) at beginning of collection
     uint64_t m_lastStartReq = 0;  // Last requested profiling start (in simulation time)
     uint32_t m_windowCount = 0;  // Track our position in the cache warmup and profile window
 
+    // METHODS
+    // Write the records of one thread in binary, see +verilator+prof+exec+binary
+    void dumpBinary(FILE* fp, const ExecutionTrace& trace) const;
+
 public:
     // CONSTRUCTOR
     explicit VlExecutionProfiler(VerilatedContext& context);
@@ -201,11 +210,32 @@ public:
     void clear() VL_MT_SAFE_EXCLUDES(m_mutex);
     // Write profiling data into file
     void dump(const char* filenamep, uint64_t tickEnd) VL_MT_SAFE_EXCLUDES(m_mutex);
+    // Sample the hardware counters of the current thread at the beginning of an mtask
+    static void hwCountersBegin();
+    // Set 'deltasp' to the hardware counter changes since hwCountersBegin, or zero
+    static void hwCountersEnd(uint32_t* deltasp);
 
     // Passed to VerilatedContext to create the VlExecutionProfiler profiler instance
     static VerilatedVirtualBase* construct(VerilatedContext& context);
 };
 
+//=============================================================================
+// VlExecutionRecord inline methods, need VlExecutionProfiler
+
+void VlExecutionRecord::mtaskBegin(uint32_t id, uint32_t predictStart, const char* hierBlock) {
+    m_payload.mtaskBegin.m_id = id;
+    m_payload.mtaskBegin.m_predictStart = predictStart;
+    m_payload.mtaskBegin.m_cpu = VlOs::getcpu();
+    m_payload.mtaskBegin.m_hierBlock = hierBlock;
+    m_type = Type::MTASK_BEGIN;
+    VlExecutionProfiler::hwCountersBegin();
+}
+void VlExecutionRecord::mtaskEnd(uint32_t predictCost) {
+    m_payload.mtaskEnd.m_predictCost = predictCost;
+    VlExecutionProfiler::hwCountersEnd(m_payload.mtaskEnd.m_hwCounters);
+    m_type = Type::MTASK_END;
+}
+
 //=============================================================================
 // VlPgoProfiler is for collecting profiling data for PGO
 
@@ -275,4 +305,93 @@ void VlPgoProfiler<N_Entries>::write(const char* modelp, const std::string& file
     std::fclose(fp);
 }
 
+
+//=============================================================================
+// VlEvalCounters is for --prof-eval, counting evaluation loop iterations,
+// trigger firings and mtask executions of one model.  Regions and their
+// triggers are registered lazily, on their first use.
+
+class VlEvalCounters final {
+    // TYPES
+    struct Region final {
+        const char* m_namep = nullptr;  // Region name, e.g. "act"
+        uint64_t m_loops = 0;  // Number of times the region's loop ran
+        uint64_t m_iterations = 0;  // Total iterations of the region's loop
+        uint32_t m_maxIterations = 0;  // Most iterations of any one run of the loop
+        const char* const* m_triggerNamesp = nullptr;  // Description of each trigger, or nullptr
+        std::vector<uint64_t> m_triggerFires;  // Iterations on which each trigger was set
+    };
+
+    // MEMBERS
+    std::string m_name;  // Hierarchical name of the model
+    uint64_t m_evals = 0;  // Number of _eval calls
+    std::atomic<uint64_t> m_mtasks{0};  // Number of mtasks executed, from any thread
+    std::vector<Region> m_regions;  // Region counters, by region index
+
+    Region& region(size_t index, const char* namep) {
+        if (VL_UNLIKELY(index >= m_regions.size())) m_regions.resize(index + 1);
+        Region& region = m_regions[index];
+        region.m_namep = namep;
+        return region;
+    }
+    static size_t lowestSetBit(uint64_t bits) {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_ctzll(bits);
+#else
+        size_t bit = 0;
+        while (!(bits & 1)) {
+            bits >>= 1;
+            ++bit;
+        }
+        return bit;
+#endif
+    }
+
+public:
+    // METHODS
+    VlEvalCounters() = default;
+    ~VlEvalCounters() = default;
+    void name(const std::string& name) { m_name = name; }
+    void eval() { ++m_evals; }
+    void mtask() { m_mtasks.fetch_add(1, std::memory_order_relaxed); }
+    void loop(size_t index, const char* namep, uint32_t iterations) {
+        Region& r = region(index, namep);
+        ++r.m_loops;
+        r.m_iterations += iterations;
+        if (iterations > r.m_maxIterations) r.m_maxIterations = iterations;
+    }
+    template <std::size_t N_Size>
+    void triggers(size_t index, const char* namep, const char* const* triggerNamesp,
+                  const VlTriggerVec<N_Size>& trigs) {
+        Region& r = region(index, namep);
+        if (VL_UNLIKELY(r.m_triggerFires.empty())) {
+            r.m_triggerFires.resize(N_Size);
+            r.m_triggerNamesp = triggerNamesp;
+        }
+        for (size_t w = 0; w * 64 < N_Size; ++w) {
+            for (uint64_t bits = trigs.word(w); bits; bits &= bits - 1) {
+                ++r.m_triggerFires[w * 64 + lowestSetBit(bits)];
+            }
+        }
+    }
+    // Add counters to 'counters', as VerilatedContext::evalCounters
+    static void addCounters(const void* selfp, std::map<std::string, uint64_t>& counters);
+    void write(const char* modelp, const std::string& filename) const VL_MT_SAFE;
+};
+
+
+//=============================================================================
+// VlSampleProfiler is for --prof-sample, sampling the program counter on
+// SIGPROF, and naming each sample by the function it falls in.  There is one
+// sampler per process, shared by all models.
+
+class VlSampleProfiler final {
+public:
+    // METHODS
+    // Start sampling, unless already started for another model
+    static void start() VL_MT_SAFE;
+    // Stop sampling when the last model stops, and write the samples to 'filename'
+    static void stop(const std::string& filename) VL_MT_SAFE;
+};
+
 #endif
@@ -251,6 +251,68 @@ static Process& getSolver() {
     return s_solver;
 }
 
+//======================================================================
+// VlSolverSession
+// State kept in the solver process between randomize() calls, so that a call
+// with the same constraints as the previous one (typically the same class,
+// whatever the object) only sends its per-call random hash constraints.
+//   Level 0: prelude and variable declarations, sent once
+//   Level 1: the constraint set, replaced only when it changes
+//   Level 2: per-call random hash constraints (push/pop each call)
+
+class VlSolverSession final {
+    // MEMBERS
+    bool m_prelude = false;  // Prelude has been sent
+    std::map<std::string, std::string> m_declared;  // Declared variable name -> type
+    std::vector<std::string> m_constraints;  // Constraints asserted at level 1
+    bool m_pushed = false;  // Level 1 constraint set is pushed
+
+public:
+    // METHODS
+    static VlSolverSession& instance() {
+        static VlSolverSession s_session;
+        return s_session;
+    }
+    // Bring the solver to level 1 with the given declarations and constraints
+    void setup(std::iostream& f, const std::vector<std::pair<std::string, std::string>>& decls,
+               const std::vector<std::string>& constraints) {
+        bool redeclare = !m_prelude;
+        std::vector<const std::pair<std::string, std::string>*> newDecls;
+        for (const auto& decl : decls) {
+            const auto it = m_declared.find(decl.first);
+            if (it == m_declared.end()) {
+                newDecls.push_back(&decl);
+            } else if (it->second != decl.second) {
+                redeclare = true;  // Same name as another class's variable, but other type
+            }
+        }
+        if (!redeclare && newDecls.empty() && m_pushed && constraints == m_constraints) return;
+        if (redeclare) {
+            if (m_prelude) f << "(reset)\n";
+            f << "(set-option :produce-models true)\n";
+            f << "(set-logic QF_ABV)\n";
+            f << "(define-fun __Vbv ((b Bool)) (_ BitVec 1) (ite b #b1 #b0))\n";
+            f << "(define-fun __Vbool ((v (_ BitVec 1))) Bool (= #b1 v))\n";
+            m_prelude = true;
+            m_declared.clear();
+            m_pushed = false;
+            newDecls.clear();
+            for (const auto& decl : decls) newDecls.push_back(&decl);
+        }
+        if (m_pushed) f << "(pop 1)\n";
+        for (const auto* const declp : newDecls) {
+            f << "(declare-fun " << declp->first << " () " << declp->second << ")\n";
+            m_declared.emplace(declp->first, declp->second);
+        }
+        f << "(push 1)\n";
+        for (const std::string& constraint : constraints) {
+            f << "(assert (= #b1 " << constraint << "))\n";
+        }
+        m_constraints = constraints;
+        m_pushed = true;
+    }
+};
+
 std::string readUntilBalanced(std::istream& stream) {
     std::string result;
     std::string token;
@@ -370,29 +432,22 @@ bool VlRandomizer::next(VlRNG& rngr) {
     std::iostream& f = getSolver();
     if (!f) return false;
 
-    f << "(set-option :produce-models true)\n";
-    f << "(set-logic QF_ABV)\n";
-    f << "(define-fun __Vbv ((b Bool)) (_ BitVec 1) (ite b #b1 #b0))\n";
-    f << "(define-fun __Vbool ((v (_ BitVec 1))) Bool (= #b1 v))\n";
+    std::vector<std::pair<std::string, std::string>> decls;
     for (const auto& var : m_vars) {
         if (var.second->dimension() > 0) {
             auto arrVarsp = std::make_shared<const ArrayInfoMap>(m_arr_vars);
             var.second->setArrayInfo(arrVarsp);
         }
-        f << "(declare-fun " << var.first << " () ";
-        var.second->emitType(f);
-        f << ")\n";
-    }
-    for (const std::string& constraint : m_constraints) {
-        f << "(assert (= #b1 " << constraint << "))\n";
+        std::ostringstream type;
+        var.second->emitType(type);
+        decls.emplace_back(var.first, type.str());
     }
+    VlSolverSession::instance().setup(f, decls, m_constraints);
     f << "(check-sat)\n";
 
     bool sat = parseSolution(f);
-    if (!sat) {
-        f << "(reset)\n";
-        return false;
-    }
+    if (!sat) return false;
+    f << "(push 1)\n";
     for (int i = 0; i < _VL_SOLVER_HASH_LEN_TOTAL && sat; ++i) {
         f << "(assert ";
         randomConstraint(f, rngr, _VL_SOLVER_HASH_LEN);
@@ -400,8 +455,7 @@ bool VlRandomizer::next(VlRNG& rngr) {
         f << "\n(check-sat)\n";
         sat = parseSolution(f);
     }
-
-    f << "(reset)\n";
+    f << "(pop 1)\n";
     return true;
 }
 
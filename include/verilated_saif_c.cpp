@@ -59,70 +59,106 @@
 #undef VL_SUB_T
 #undef VL_BUF_T
 
-//=============================================================================
-// VerilatedSaifActivityBit
-
-class VerilatedSaifActivityBit final {
-    // MEMBERS
-    bool m_lastVal = false;  // Last emitted activity bit value
-    uint64_t m_highTime = 0;  // Total time when bit was high
-    size_t m_transitions = 0;  // Total number of bit transitions
-
-public:
-    // METHODS
-    VL_ATTR_ALWINLINE
-    void aggregateVal(uint64_t dt, bool newVal) {
-        m_transitions += newVal != m_lastVal ? 1 : 0;
-        m_highTime += m_lastVal ? dt : 0;
-        m_lastVal = newVal;
-    }
-
-    // ACCESSORS
-    VL_ATTR_ALWINLINE bool bitValue() const { return m_lastVal; }
-    VL_ATTR_ALWINLINE uint64_t highTime() const { return m_highTime; }
-    VL_ATTR_ALWINLINE uint64_t toggleCount() const { return m_transitions; }
-};
-
 //=============================================================================
 // VerilatedSaifActivityVar
 
+// Activity of one variable, as arrays indexed by bit. A value change is compared
+// against the previous value a word at a time, and only the bits that toggled are
+// visited. Rather than adding elapsed time to every high bit on every change, each
+// high-time accumulator has the time subtracted when the bit rises and added when it
+// falls (modulo 2^64); bits still high are finalised when printed at close().
+
 class VerilatedSaifActivityVar final {
     // MEMBERS
-    uint64_t m_lastTime = 0;  // Last time when variable value was updated
-    VerilatedSaifActivityBit* m_bits;  // Pointer to variable bits objects
+    uint64_t* m_lastValp;  // Last emitted value, as 64-bit words
+    uint64_t* m_highTimep;  // Per bit: high time, less time of last rise if now high
+    uint64_t* m_togglesp;  // Per bit: total number of bit transitions
     uint32_t m_width;  // Width of variable (in bits)
 
+    static size_t lowestSetBit(uint64_t bits) {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_ctzll(bits);
+#else
+        size_t bit = 0;
+        while (!(bits & 1)) {
+            bits >>= 1;
+            ++bit;
+        }
+        return bit;
+#endif
+    }
+
 public:
     // CONSTRUCTORS
-    VerilatedSaifActivityVar(uint32_t width, VerilatedSaifActivityBit* bits)
-        : m_bits{bits}
+    // Storage must hold storageWords(width) zeroed words
+    VerilatedSaifActivityVar(uint32_t width, uint64_t* storagep)
+        : m_lastValp{storagep}
+        , m_highTimep{storagep + valueWords(width)}
+        , m_togglesp{storagep + valueWords(width) + width}
         , m_width{width} {}
 
     VerilatedSaifActivityVar(VerilatedSaifActivityVar&&) = default;
     VerilatedSaifActivityVar& operator=(VerilatedSaifActivityVar&&) = default;
 
     // METHODS
-    VL_ATTR_ALWINLINE void emitBit(uint64_t time, CData newval);
+    static size_t valueWords(uint32_t width) { return (width + 63) / 64; }
+    static size_t storageWords(uint32_t width) { return valueWords(width) + 2 * width; }
+
+    VL_ATTR_ALWINLINE void emitBit(uint64_t time, CData newval) {
+        emitWord(time, 0, newval & 1);
+    }
 
     template <typename DataType>
     VL_ATTR_ALWINLINE void emitData(uint64_t time, DataType newval, uint32_t bits) {
         static_assert(std::is_integral<DataType>::value,
                       "The emitted value must be of integral type");
+        const uint32_t width = std::min(m_width, bits);
+        const uint64_t mask = width >= 64 ? ~0ULL : ((1ULL << width) - 1);
+        emitWord(time, 0, static_cast<uint64_t>(newval) & mask);
+    }
 
-        const uint64_t dt = time - m_lastTime;
-        for (size_t i = 0; i < std::min(m_width, bits); ++i) {
-            m_bits[i].aggregateVal(dt, (newval >> i) & 1);
+    VL_ATTR_ALWINLINE void emitWData(uint64_t time, const WData* newvalp, uint32_t bits) {
+        const uint32_t width = std::min(m_width, bits);
+        const size_t ewords = VL_WORDS_I(width);
+        for (size_t w = 0; w < valueWords(width); ++w) {
+            uint64_t word = newvalp[2 * w];
+            if (2 * w + 1 < ewords) word |= static_cast<uint64_t>(newvalp[2 * w + 1]) << 32;
+            const uint32_t wordBits = width - 64 * w;
+            if (wordBits < 64) word &= (1ULL << wordBits) - 1;
+            emitWord(time, w, word);
         }
-        updateLastTime(time);
     }
 
-    VL_ATTR_ALWINLINE void emitWData(uint64_t time, const WData* newvalp, uint32_t bits);
-    VL_ATTR_ALWINLINE void updateLastTime(uint64_t val) { m_lastTime = val; }
+    VL_ATTR_ALWINLINE void emitWord(uint64_t time, size_t w, uint64_t newWord) {
+        uint64_t changed = m_lastValp[w] ^ newWord;
+        if (VL_LIKELY(!changed)) return;
+        m_lastValp[w] = newWord;
+        do {
+            const size_t i = 64 * w + lowestSetBit(changed);
+            changed &= changed - 1;
+            ++m_togglesp[i];
+            if (bitValue(i)) {
+                m_highTimep[i] -= time;
+            } else {
+                m_highTimep[i] += time;
+            }
+        } while (changed);
+    }
 
     // ACCESSORS
     VL_ATTR_ALWINLINE uint32_t width() const { return m_width; }
-    VL_ATTR_ALWINLINE VerilatedSaifActivityBit& bit(std::size_t index);
-    VL_ATTR_ALWINLINE uint64_t lastUpdateTime() const { return m_lastTime; }
+    VL_ATTR_ALWINLINE bool bitValue(size_t index) const {
+        return (m_lastValp[index / 64] >> (index % 64)) & 1;
+    }
+    // Total time bit was high up to the given current time
+    VL_ATTR_ALWINLINE uint64_t highTime(size_t index, uint64_t time) const {
+        assert(index < m_width);
+        return m_highTimep[index] + (bitValue(index) ? time : 0);
+    }
+    VL_ATTR_ALWINLINE uint64_t toggleCount(size_t index) const {
+        assert(index < m_width);
+        return m_togglesp[index];
+    }
 
 private:
     // CONSTRUCTORS
@@ -197,8 +233,8 @@ class VerilatedSaifActivityAccumulator final {
         m_scopeToActivities;
     // Map of variables codes mapped to their activity objects
     std::unordered_map<uint32_t, VerilatedSaifActivityVar> m_activity;
-    // Memory pool for signals bits objects
-    std::vector<std::vector<VerilatedSaifActivityBit>> m_activityArena;
+    // Memory pool for signals activity arrays
+    std::vector<std::vector<uint64_t>> m_activityArena;
 
 public:
     // METHODS
@@ -215,36 +251,6 @@ private:
     VL_UNCOPYABLE(VerilatedSaifActivityAccumulator);
 };
 
-//=============================================================================
-//=============================================================================
-//=============================================================================
-// VerilatedSaifActivityVar implementation
-
-VL_ATTR_ALWINLINE
-void VerilatedSaifActivityVar::emitBit(const uint64_t time, const CData newval) {
-    assert(m_lastTime <= time);
-    m_bits[0].aggregateVal(time - m_lastTime, newval);
-    updateLastTime(time);
-}
-
-VL_ATTR_ALWINLINE
-void VerilatedSaifActivityVar::emitWData(const uint64_t time, const WData* newvalp,
-                                         const uint32_t bits) {
-    assert(m_lastTime <= time);
-    const uint64_t dt = time - m_lastTime;
-    for (std::size_t i = 0; i < std::min(m_width, bits); ++i) {
-        const size_t wordIndex = i / VL_EDATASIZE;
-        m_bits[i].aggregateVal(dt, (newvalp[wordIndex] >> VL_BITBIT_E(i)) & 1);
-    }
-
-    updateLastTime(time);
-}
-
-VerilatedSaifActivityBit& VerilatedSaifActivityVar::bit(const std::size_t index) {
-    assert(index < m_width);
-    return m_bits[index];
-}
-
 //=============================================================================
 //=============================================================================
 //=============================================================================
@@ -253,14 +259,15 @@ VerilatedSaifActivityBit& VerilatedSaifActivityVar::bit(const std::size_t index)
 void VerilatedSaifActivityAccumulator::declare(uint32_t code, const std::string& absoluteScopePath,
                                                std::string variableName, int bits, bool array,
                                                int arraynum) {
-    const size_t block_size = 1024;
+    const size_t block_size = 4096;
+    const size_t words = VerilatedSaifActivityVar::storageWords(static_cast<uint32_t>(bits));
     if (m_activityArena.empty()
-        || m_activityArena.back().size() + bits > m_activityArena.back().capacity()) {
+        || m_activityArena.back().size() + words > m_activityArena.back().capacity()) {
         m_activityArena.emplace_back();
-        m_activityArena.back().reserve(block_size);
+        m_activityArena.back().reserve(std::max(block_size, words));
     }
-    const size_t bitsIdx = m_activityArena.back().size();
-    m_activityArena.back().resize(m_activityArena.back().size() + bits);
+    const size_t wordsIdx = m_activityArena.back().size();
+    m_activityArena.back().resize(m_activityArena.back().size() + words);
 
     if (array) {
         variableName += '[';
@@ -269,7 +276,7 @@ void VerilatedSaifActivityAccumulator::declare(uint32_t code, const std::string&
     }
     m_scopeToActivities[absoluteScopePath].emplace_back(code, variableName);
     m_activity.emplace(code, VerilatedSaifActivityVar{static_cast<uint32_t>(bits),
-                                                      m_activityArena.back().data() + bitsIdx});
+                                                      m_activityArena.back().data() + wordsIdx});
 }
 
 //=============================================================================
@@ -399,9 +406,7 @@ void VerilatedSaif::closeNetScope() {
 bool VerilatedSaif::printActivityStats(VerilatedSaifActivityVar& activity,
                                        const std::string& activityName, bool anyNetWritten) {
     for (size_t i = 0; i < activity.width(); ++i) {
-        VerilatedSaifActivityBit& bit = activity.bit(i);
-
-        bit.aggregateVal(currentTime() - activity.lastUpdateTime(), bit.bitValue());
+        const uint64_t highTime = activity.highTime(i, currentTime());
 
         if (!anyNetWritten) {
             openNetScope();
@@ -419,16 +424,14 @@ bool VerilatedSaif::printActivityStats(VerilatedSaifActivityVar& activity,
 
         // We only have two-value logic so TZ, TX and TB will always be 0
         printStr(" (T0 ");
-        printStr(std::to_string(currentTime() - bit.highTime()));
+        printStr(std::to_string(currentTime() - highTime));
         printStr(") (T1 ");
-        printStr(std::to_string(bit.highTime()));
+        printStr(std::to_string(highTime));
         printStr(") (TZ 0) (TX 0) (TB 0) (TC ");
-        printStr(std::to_string(bit.toggleCount()));
+        printStr(std::to_string(activity.toggleCount(i)));
         printStr("))\n");
     }
 
-    activity.updateLastTime(currentTime());
-
     return anyNetWritten;
 }
 
@@ -530,16 +533,21 @@ void VerilatedSaif::popPrefix() {
 void VerilatedSaif::declare(const uint32_t code, uint32_t fidx, const char* name,
                             const char* wirep, const bool array, const int arraynum,
                             const bool bussed, const int msb, const int lsb) {
-    assert(m_activityAccumulators.size() > fidx);
-    VerilatedSaifActivityAccumulator& accumulator = *m_activityAccumulators.at(fidx);
+    // Each trace function index has its own accumulator, so that with parallel
+    // tracing, the threads running different trace functions never share one.
+    // These are all merged when printed at close().
+    while (m_activityAccumulators.size() <= fidx) {
+        m_activityAccumulators.emplace_back(std::make_unique<VerilatedSaifActivityAccumulator>());
+    }
+    VerilatedSaifActivityAccumulator& accumulator = *m_activityAccumulators[fidx];
 
     const int bits = ((msb > lsb) ? (msb - lsb) : (lsb - msb)) + 1;
 
-    const std::string hierarchicalName = m_prefixStack.back().first + name;
+    const std::string& hierarchicalName = declName(m_prefixStack.back().first, name);
 
     if (!Super::declCode(code, hierarchicalName, bits)) return;
 
-    std::string variableName = lastWord(hierarchicalName);
+    std::string variableName{lastWordp(hierarchicalName)};
     m_currentScope->addActivityVar(code, variableName);
 
     accumulator.declare(code, m_currentScope->path(), std::move(variableName), bits, array,
@@ -587,7 +595,12 @@ void VerilatedSaif::declDouble(const uint32_t code, const uint32_t fidx, const c
 //=============================================================================
 // Get/commit trace buffer
 
-VerilatedSaif::Buffer* VerilatedSaif::getTraceBuffer(uint32_t fidx) { return new Buffer{*this}; }
+VerilatedSaif::Buffer* VerilatedSaif::getTraceBuffer(uint32_t fidx) {
+    Buffer* const bufp = new Buffer{*this};
+    // Accumulate into the activities declared by this trace function
+    bufp->m_fidx = fidx;
+    return bufp;
+}
 
 void VerilatedSaif::commitTraceBuffer(VerilatedSaif::Buffer* bufp) { delete bufp; }
 
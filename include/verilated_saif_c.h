@@ -32,7 +32,6 @@ class VerilatedSaifBuffer;
 class VerilatedSaifActivityAccumulator;
 class VerilatedSaifActivityScope;
 class VerilatedSaifActivityVar;
-class VerilatedSaifActivityBit;
 
 //=============================================================================
 // VerilatedSaif
@@ -180,6 +179,8 @@ template <>
 void VerilatedSaif::Super::set_time_resolution(const std::string& unit);
 template <>
 void VerilatedSaif::Super::dumpvars(int level, const std::string& hier);
+template <>
+void VerilatedSaif::Super::traceScopes(const std::string& scopes);
 #endif  // DOXYGEN
 
 //=============================================================================
@@ -284,6 +285,10 @@ public:
     void dumpvars(int level, const std::string& hier) VL_MT_SAFE {
         m_sptrace.dumpvars(level, hier);
     }
+    /// Trace only signals under the given scopes, see VerilatedTraceBaseC
+    void traceScopes(const std::string& scopes) override VL_MT_SAFE {
+        m_sptrace.traceScopes(scopes);
+    }
 
     // Internal class access
     VerilatedSaif* spTrace() { return &m_sptrace; }
@@ -30,15 +30,29 @@
 #include "verilated.h"
 #include "verilated_imp.h"
 
+#include <algorithm>
 #include <cerrno>
+#include <cstring>
 #include <fcntl.h>
 
+#define LZ4_DISABLE_DEPRECATE_WARNINGS
+#include "gtkwave/lz4.h"
+#if !VM_TRACE_FST
+// When FST tracing is linked, verilated_fst_c.cpp already provides LZ4
+#include "gtkwave/lz4.c"
+#endif
+
 // clang-format off
 #if defined(_WIN32) && !defined(__MINGW32__) && !defined(__CYGWIN__)
 # include <io.h>
 #else
 # include <unistd.h>
 #endif
+#if !defined(_WIN32) && !defined(__MINGW32__)
+# include <sys/mman.h>
+# include <sys/stat.h>
+# define _VL_HAVE_MMAP
+#endif
 
 #ifndef O_LARGEFILE  // WIN32 headers omit this
 # define O_LARGEFILE 0
@@ -56,6 +70,61 @@
 static const char* const VLTSAVE_HEADER_STR = "verilatorsave02\n";
 // Value of last bytes of each file (must be multiple of 8 bytes)
 static const char* const VLTSAVE_TRAILER_STR = "vltsaved";
+// Value of first bytes of each compressed or incremental file, before any blocks
+static const char* const VLTSAVE_BLOCKED_STR = "verilatorsaveb1\n";
+// Kinds of block records in compressed or incremental files
+static constexpr uint32_t VLTSAVE_BLOCK_END = 0;  // End of file
+static constexpr uint32_t VLTSAVE_BLOCK_RAW = 1;  // Uncompressed data
+static constexpr uint32_t VLTSAVE_BLOCK_LZ4 = 2;  // LZ4 compressed data
+static constexpr uint32_t VLTSAVE_BLOCK_SAME = 3;  // Same as block in parent file
+
+//=============================================================================
+// Utilities
+
+static uint64_t vlSaveBlockHash(const uint8_t* datap, size_t size) {
+    // 64-bit signature of a block, collisions are negligible at checkpoint sizes
+    uint64_t hash = 0xcbf29ce484222325ULL ^ size;
+    for (; size >= sizeof(uint64_t); datap += sizeof(uint64_t), size -= sizeof(uint64_t)) {
+        uint64_t word;
+        std::memcpy(&word, datap, sizeof(word));
+        hash = (hash ^ word) * 0x9e3779b97f4a7c15ULL;
+        hash ^= hash >> 29;
+    }
+    for (; size; ++datap, --size) hash = (hash ^ *datap) * 0x100000001b3ULL;
+    return hash;
+}
+
+static size_t vlSaveReadFd(int fd, void* datap, size_t size) VL_MT_UNSAFE_ONE {
+    // Read until size bytes or EOF, return bytes read
+    uint8_t* const bufp = static_cast<uint8_t*>(datap);
+    size_t done = 0;
+    while (done < size) {
+        errno = 0;
+        const ssize_t got = ::read(fd, bufp + done, size - done);
+        if (got > 0) {
+            done += got;
+        } else if (VL_UNCOVERABLE(got < 0)) {
+            if (VL_UNCOVERABLE(errno != EAGAIN && errno != EINTR)) {
+                // LCOV_EXCL_START
+                const std::string msg = std::string{__FUNCTION__} + ": " + std::strerror(errno);
+                VL_FATAL_MT("", 0, "", msg.c_str());
+                break;
+                // LCOV_EXCL_STOP
+            }
+        } else {  // got==0, EOF
+            break;
+        }
+    }
+    return done;
+}
+
+static bool vlSaveReadParent(int fd, std::string& parent) VL_MT_UNSAFE_ONE {
+    // Read parent filename following VLTSAVE_BLOCKED_STR
+    uint32_t len = 0;
+    if (vlSaveReadFd(fd, &len, sizeof(len)) != sizeof(len)) return false;
+    parent.resize(len);
+    return vlSaveReadFd(fd, &parent[0], len) == len;
+}
 
 //=============================================================================
 //=============================================================================
@@ -144,6 +213,16 @@ void VerilatedSave::open(const char* filenamep) VL_MT_UNSAFE_ONE {
     m_isOpen = true;
     m_filename = filenamep;
     m_cp = m_bufp;
+    m_blocks.clear();
+    // Can't reference a previous save that is being overwritten
+    if (m_prevFilename == m_filename) m_prevBlocks.clear();
+    if (blocked()) {
+        const std::string parent = m_prevBlocks.empty() ? "" : m_prevFilename;
+        const uint32_t len = parent.length();
+        writeImp(VLTSAVE_BLOCKED_STR, std::strlen(VLTSAVE_BLOCKED_STR));
+        writeImp(&len, sizeof(len));
+        writeImp(parent.data(), len);
+    }
     header();
 }
 
@@ -166,16 +245,68 @@ void VerilatedRestore::open(const char* filenamep) VL_MT_UNSAFE_ONE {
     m_isOpen = true;
     m_filename = filenamep;
     m_cp = m_bufp;
-    m_endp = m_bufp;
+    // Detect block format; otherwise the bytes read start a plain save
+    const size_t blockedLen = std::strlen(VLTSAVE_BLOCKED_STR);
+    m_endp = m_bufp + vlSaveReadFd(m_fd, m_bufp, blockedLen);
+    if (static_cast<size_t>(m_endp - m_bufp) == blockedLen
+        && 0 == std::memcmp(m_bufp, VLTSAVE_BLOCKED_STR, blockedLen)) {
+        m_endp = m_bufp;
+        m_blocked = true;
+        std::string parent;
+        bool ok = vlSaveReadParent(m_fd, parent);
+        while (ok && !parent.empty()) {
+            const std::string filename = parent;
+            const int fd = ::open(filename.c_str(), O_RDONLY | O_LARGEFILE | O_CLOEXEC);
+            char magic[16];
+            ok = fd >= 0 && vlSaveReadFd(fd, magic, blockedLen) == blockedLen
+                 && 0 == std::memcmp(magic, VLTSAVE_BLOCKED_STR, blockedLen)
+                 && vlSaveReadParent(fd, parent);
+            if (fd >= 0) m_parentFds.push_back(fd);
+            if (VL_UNLIKELY(!ok)) {
+                const std::string fn = this->filename();
+                const std::string msg
+                    = "Can't deserialize; can't read incremental save parent file: " + filename;
+                VL_FATAL_MT(fn.c_str(), 0, "", msg.c_str());
+            }
+        }
+    } else {
+        mapFile();
+    }
     header();
 }
 
+void VerilatedRestore::mapFile() VL_MT_UNSAFE_ONE {
+    // Map a plain format file, so restoring copies straight from the page cache rather than
+    // through read() and the buffer. If this fails, just read the file.
+#ifdef _VL_HAVE_MMAP
+    struct stat st;
+    if (::fstat(m_fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size <= 0) return;
+    const size_t size = static_cast<size_t>(st.st_size);
+    void* const p = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, m_fd, 0);
+    if (p == MAP_FAILED) return;
+#ifdef MADV_SEQUENTIAL
+    ::madvise(p, size, MADV_SEQUENTIAL);
+#endif
+    m_mapp = static_cast<uint8_t*>(p);
+    m_mapSize = size;
+    // Restart from the beginning of the file, including the bytes read to detect the format
+    m_cp = m_mapp;
+    m_endp = m_mapp + size;
+#endif
+}
+
 void VerilatedSave::closeImp() VL_MT_UNSAFE_ONE {
     if (!isOpen()) return;
     trailer();
     flushImp();
+    if (blocked()) writeBlock(VLTSAVE_BLOCK_END, nullptr, 0, 0);
     m_isOpen = false;
     ::close(m_fd);  // May get error, just ignore it
+    if (m_incremental) {
+        m_prevBlocks.swap(m_blocks);
+        m_prevFilename = m_filename;
+    }
+    m_blocks.clear();
 }
 
 void VerilatedRestore::closeImp() VL_MT_UNSAFE_ONE {
@@ -184,6 +315,16 @@ void VerilatedRestore::closeImp() VL_MT_UNSAFE_ONE {
     flushImp();
     m_isOpen = false;
     ::close(m_fd);  // May get error, just ignore it
+#ifdef _VL_HAVE_MMAP
+    if (m_mapp) ::munmap(m_mapp, m_mapSize);
+#endif
+    m_mapp = nullptr;
+    m_mapSize = 0;
+    for (const int fd : m_parentFds) ::close(fd);
+    m_parentFds.clear();
+    m_blocked = false;
+    m_block.clear();
+    m_blockPos = 0;
 }
 
 //=============================================================================
@@ -192,9 +333,45 @@ void VerilatedRestore::closeImp() VL_MT_UNSAFE_ONE {
 void VerilatedSave::flushImp() VL_MT_UNSAFE_ONE {
     m_assertOne.check();
     if (VL_UNLIKELY(!isOpen())) return;
-    const uint8_t* wp = m_bufp;
+    const uint32_t size = m_cp - m_bufp;
+    if (!blocked()) {
+        writeImp(m_bufp, size);
+    } else if (size) {
+        // Each flush of the buffer becomes one block.  Saves of the same model
+        // flush at the same points, so unchanged blocks line up with the previous save.
+        const BlockSig sig{vlSaveBlockHash(m_bufp, size), size};
+        const size_t index = m_blocks.size();
+        m_blocks.push_back(sig);
+        if (index < m_prevBlocks.size() && m_prevBlocks[index] == sig) {
+            writeBlock(VLTSAVE_BLOCK_SAME, nullptr, size, 0);
+        } else if (m_compress) {
+            if (m_zbuf.empty()) m_zbuf.resize(LZ4_compressBound(bufferSize()));
+            const int zsize = LZ4_compress_default(reinterpret_cast<const char*>(m_bufp),
+                                                   m_zbuf.data(), size, m_zbuf.size());
+            if (zsize > 0 && static_cast<uint32_t>(zsize) < size) {
+                writeBlock(VLTSAVE_BLOCK_LZ4, m_zbuf.data(), size, zsize);
+            } else {
+                writeBlock(VLTSAVE_BLOCK_RAW, m_bufp, size, size);
+            }
+        } else {
+            writeBlock(VLTSAVE_BLOCK_RAW, m_bufp, size, size);
+        }
+    }
+    m_cp = m_bufp;  // Reset buffer
+}
+
+void VerilatedSave::writeBlock(uint32_t kind, const void* datap, uint32_t rawSize,
+                               uint32_t size) VL_MT_UNSAFE_ONE {
+    const uint32_t record[3] = {kind, rawSize, size};
+    writeImp(record, sizeof(record));
+    writeImp(datap, size);
+}
+
+void VerilatedSave::writeImp(const void* datap, size_t size) VL_MT_UNSAFE_ONE {
+    const uint8_t* wp = static_cast<const uint8_t*>(datap);
+    const uint8_t* const endp = wp + size;
     while (true) {
-        const ssize_t remaining = (m_cp - wp);
+        const ssize_t remaining = (endp - wp);
         if (remaining == 0) break;
         errno = 0;
         const ssize_t got = ::write(m_fd, wp, remaining);
@@ -212,7 +389,6 @@ void VerilatedSave::flushImp() VL_MT_UNSAFE_ONE {
             }
         }
     }
-    m_cp = m_bufp;  // Reset buffer
 }
 
 void VerilatedRestore::fill() VL_MT_UNSAFE_ONE {
@@ -223,6 +399,29 @@ void VerilatedRestore::fill() VL_MT_UNSAFE_ONE {
     for (uint8_t* sp = m_cp; sp < m_endp; *rp++ = *sp++) {}  // Overlaps
     m_endp = m_bufp + (m_endp - m_cp);
     m_cp = m_bufp;  // Reset buffer
+    if (m_mapp) {
+        // Reached the end of the mapped file, the rest was copied into the buffer above.
+        // Fill buffer from here to end with NULLs, as for EOF below
+        while (m_endp < m_bufp + bufferSize()) *m_endp++ = '\0';
+        return;
+    }
+    if (m_blocked) {
+        uint8_t* const endp = m_bufp + bufferSize();
+        while (m_endp < endp) {
+            if (m_blockPos >= m_block.size()) {
+                if (readBlock(0, true)) continue;
+                // Fill buffer from here to end with NULLs, as for EOF below
+                while (m_endp < endp) *m_endp++ = '\0';
+                break;
+            }
+            const size_t size = std::min(static_cast<size_t>(endp - m_endp),
+                                         m_block.size() - m_blockPos);
+            std::memcpy(m_endp, m_block.data() + m_blockPos, size);
+            m_endp += size;
+            m_blockPos += size;
+        }
+        return;
+    }
     // Read into buffer starting at m_endp
     while (true) {
         const ssize_t remaining = (m_bufp + bufferSize() - m_endp);
@@ -250,6 +449,47 @@ void VerilatedRestore::fill() VL_MT_UNSAFE_ONE {
     }
 }
 
+bool VerilatedRestore::readBlock(size_t level, bool want) VL_MT_UNSAFE_ONE {
+    // Read the next block record of the file at the given incremental level,
+    // and keep the parent files in step.  If want, decode the block into m_block.
+    // Return false at end of file.
+    const int fd = level ? m_parentFds[level - 1] : m_fd;
+    uint32_t record[3];  // Kind, raw size, stored size
+    if (vlSaveReadFd(fd, record, sizeof(record)) != sizeof(record)) return false;
+    const uint32_t kind = record[0];
+    if (kind == VLTSAVE_BLOCK_END) return false;
+    const bool fromParent = kind == VLTSAVE_BLOCK_SAME;
+    bool ok = true;
+    if (want && kind == VLTSAVE_BLOCK_RAW) {
+        m_block.resize(record[1]);
+        ok = vlSaveReadFd(fd, m_block.data(), record[2]) == record[2];
+    } else if (want && kind == VLTSAVE_BLOCK_LZ4) {
+        m_zbuf.resize(record[2]);
+        m_block.resize(record[1]);
+        ok = vlSaveReadFd(fd, m_zbuf.data(), record[2]) == record[2]
+             && LZ4_decompress_safe(m_zbuf.data(), reinterpret_cast<char*>(m_block.data()),
+                                    record[2], record[1])
+                    == static_cast<int>(record[1]);
+    } else if (want && !fromParent) {
+        ok = false;
+    } else if (record[2]) {
+        ok = ::lseek(fd, record[2], SEEK_CUR) >= 0;
+    }
+    if (want && !fromParent) m_blockPos = 0;
+    if (level < m_parentFds.size()) {
+        ok = (readBlock(level + 1, want && fromParent) || !(want && fromParent)) && ok;
+    } else if (want && fromParent) {
+        ok = false;
+    }
+    if (VL_UNLIKELY(!ok)) {
+        const std::string fn = filename();
+        const std::string msg = "Can't deserialize; corrupt save-restore file: " + filename();
+        VL_FATAL_MT(fn.c_str(), 0, "", msg.c_str());
+        return false;
+    }
+    return true;
+}
+
 //=============================================================================
 // Serialization of types
 
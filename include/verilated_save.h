@@ -26,7 +26,11 @@
 
 #include "verilated.h"
 
+#include <cstring>
 #include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 //=============================================================================
 // VerilatedSerialize
@@ -83,8 +87,9 @@ public:
             bufferCheck();
             size_t blk = size;
             if (blk > bufferInsertSize()) blk = bufferInsertSize();
-            const uint8_t* __restrict maxp = dp + blk;
-            for (; dp < maxp; *m_cp++ = *dp++) {}
+            std::memcpy(m_cp, dp, blk);
+            m_cp += blk;
+            dp += blk;
             size -= blk;
         }
         return *this;  // For function chaining
@@ -156,8 +161,9 @@ public:
             bufferCheck();
             size_t blk = size;
             if (blk > bufferInsertSize()) blk = bufferInsertSize();
-            const uint8_t* __restrict maxp = dp + blk;
-            for (; dp < maxp; *dp++ = *m_cp++) {}
+            std::memcpy(dp, m_cp, blk);
+            m_cp += blk;
+            dp += blk;
             size -= blk;
         }
         return *this;  // For function chaining
@@ -184,14 +190,32 @@ private:
 // VerilatedSave
 /// Stream-like object that serializes Verilated model to a file.
 ///
+/// With compress() or incremental() the file is written as a sequence of
+/// blocks, each either LZ4 compressed, or in incremental mode a reference
+/// to the same block in the previous save made by this object.
+/// VerilatedRestore detects these formats automatically.
+///
 /// This class is not thread safe, it must be called by a single thread
 
 class VerilatedSave final : public VerilatedSerialize {
 private:
-    int m_fd = -1;  // File descriptor we're writing to
+    // TYPES
+    using BlockSig = std::pair<uint64_t, uint32_t>;  // Block hash and length
 
+    int m_fd = -1;  // File descriptor we're writing to
+    bool m_compress = false;  // Compress blocks with LZ4
+    bool m_incremental = false;  // Write only blocks changed since previous save
+    std::vector<char> m_zbuf;  // Compression buffer
+    std::vector<BlockSig> m_blocks;  // Signatures of blocks written to this file
+    std::vector<BlockSig> m_prevBlocks;  // Signatures of blocks in previous save
+    std::string m_prevFilename;  // Filename of previous save, parent of incremental save
+
+    bool blocked() const { return m_compress || m_incremental; }
     void closeImp() VL_MT_UNSAFE_ONE;
     void flushImp() VL_MT_UNSAFE_ONE;
+    void writeBlock(uint32_t kind, const void* datap, uint32_t rawSize,
+                    uint32_t size) VL_MT_UNSAFE_ONE;
+    void writeImp(const void* datap, size_t size) VL_MT_UNSAFE_ONE;
 
 public:
     // CONSTRUCTORS
@@ -204,6 +228,15 @@ public:
     void open(const char* filenamep) VL_MT_UNSAFE_ONE;
     /// Open the file; call isOpen() to see if errors
     void open(const std::string& filename) VL_MT_UNSAFE_ONE { open(filename.c_str()); }
+    /// Compress saves with LZ4; takes effect on the next open()
+    void compress(bool flag) VL_MT_UNSAFE_ONE { m_compress = flag; }
+    /// Save incrementally; takes effect on the next open(). Each save after
+    /// the first writes only the blocks that changed since the previous save
+    /// by this object, so the previous save file must be kept for restores.
+    void incremental(bool flag) VL_MT_UNSAFE_ONE {
+        m_incremental = flag;
+        if (!flag) m_prevBlocks.clear();
+    }
     /// Flush and close the file
     void close() override VL_MT_UNSAFE_ONE { closeImp(); }
     /// Flush data to file
@@ -219,9 +252,18 @@ public:
 class VerilatedRestore final : public VerilatedDeserialize {
 private:
     int m_fd = -1;  // File descriptor we're writing to
+    uint8_t* m_mapp = nullptr;  // Plain format file mapped into memory, or nullptr
+    size_t m_mapSize = 0;  // Size of m_mapp mapping
+    bool m_blocked = false;  // File is in block format
+    std::vector<int> m_parentFds;  // Incremental parent files, newest first
+    std::vector<uint8_t> m_block;  // Current decoded block
+    size_t m_blockPos = 0;  // Read position in m_block
+    std::vector<char> m_zbuf;  // Decompression buffer
 
     void closeImp() VL_MT_UNSAFE_ONE;
     void flushImp() VL_MT_UNSAFE_ONE {}
+    bool readBlock(size_t level, bool want) VL_MT_UNSAFE_ONE;
+    void mapFile() VL_MT_UNSAFE_ONE;
 
 public:
     // CONSTRUCTORS
@@ -300,6 +342,35 @@ inline VerilatedDeserialize& operator>>(VerilatedDeserialize& os, std::string& r
 VerilatedSerialize& operator<<(VerilatedSerialize& os, VerilatedContext* rhsp);
 VerilatedDeserialize& operator>>(VerilatedDeserialize& os, VerilatedContext* rhsp);
 
+// Types that are saved as their raw bytes, so arrays of them can be saved with one write
+template <typename T_Value>
+struct VlSaveIsPlain : public std::is_arithmetic<T_Value> {};
+template <std::size_t N_Words>
+struct VlSaveIsPlain<VlWide<N_Words>> : public std::true_type {};
+template <typename T_Value, std::size_t N_Depth>
+struct VlSaveIsPlain<VlUnpacked<T_Value, N_Depth>> : public VlSaveIsPlain<T_Value> {};
+
+template <std::size_t N_Words>
+VerilatedSerialize& operator<<(VerilatedSerialize& os, const VlWide<N_Words>& rhs) {
+    return os.write(rhs.m_storage, sizeof(rhs.m_storage));
+}
+template <std::size_t N_Words>
+VerilatedDeserialize& operator>>(VerilatedDeserialize& os, VlWide<N_Words>& rhs) {
+    return os.read(rhs.m_storage, sizeof(rhs.m_storage));
+}
+template <typename T_Value, std::size_t N_Depth>
+VerilatedSerialize& operator<<(VerilatedSerialize& os, const VlUnpacked<T_Value, N_Depth>& rhs) {
+    static_assert(VlSaveIsPlain<T_Value>::value, "Only arrays of plain types are saved in bulk");
+    static_assert(sizeof(rhs.m_storage) == N_Depth * sizeof(T_Value), "Padded array");
+    return os.write(rhs.m_storage, sizeof(rhs.m_storage));
+}
+template <typename T_Value, std::size_t N_Depth>
+VerilatedDeserialize& operator>>(VerilatedDeserialize& os, VlUnpacked<T_Value, N_Depth>& rhs) {
+    static_assert(VlSaveIsPlain<T_Value>::value, "Only arrays of plain types are saved in bulk");
+    static_assert(sizeof(rhs.m_storage) == N_Depth * sizeof(T_Value), "Padded array");
+    return os.read(rhs.m_storage, sizeof(rhs.m_storage));
+}
+
 template <typename T_Key, typename T_Value>
 VerilatedSerialize& operator<<(VerilatedSerialize& os, VlAssocArray<T_Key, T_Value>& rhs) {
     os << rhs.atDefault();
@@ -252,6 +252,7 @@ class VerilatedVar final : public VerilatedVarProps {
     // MEMBERS
     void* const m_datap;  // Location of data
     const char* const m_namep;  // Name - slowpath
+    uint8_t* m_dirtyp = nullptr;  // Set by model on write, with --vpi-dirty
 protected:
     const bool m_isParam;
     friend class VerilatedScope;
@@ -267,6 +268,8 @@ public:
     ~VerilatedVar() = default;
     // ACCESSORS
     void* datap() const { return m_datap; }
+    // Flag set on each model write, or nullptr if writes are not flagged
+    uint8_t* dirtyp() const { return m_dirtyp; }
     const char* name() const { return m_namep; }
     bool isParam() const { return m_isParam; }
 };
@@ -46,6 +46,19 @@ struct VerilatedCStrCmp final {
     bool operator()(const char* a, const char* b) const { return std::strcmp(a, b) < 0; }
 };
 
+// Classes to hash maps keyed by const char*'s
+struct VerilatedCStrHash final {
+    size_t operator()(const char* a) const {
+        // FNV-1a
+        uint64_t hash = 0xcbf29ce484222325ULL;
+        for (; *a; ++a) hash = (hash ^ static_cast<uint8_t>(*a)) * 0x100000001b3ULL;
+        return static_cast<size_t>(hash);
+    }
+};
+struct VerilatedCStrEq final {
+    bool operator()(const char* a, const char* b) const { return std::strcmp(a, b) == 0; }
+};
+
 // Map of sorted scope names to find associated scope class
 // This is a class instead of typedef/using to allow forward declaration in verilated.h
 class VerilatedScopeNameMap final
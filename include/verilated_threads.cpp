@@ -25,15 +25,23 @@
 
 #include "verilated_threads.h"
 
+#include <algorithm>
+#include <climits>
 #include <cstdio>
 #include <fstream>
 #include <iostream>
 #include <memory>
+#include <queue>
 #include <string>
 
 #ifdef __FreeBSD__
 #include <pthread_np.h>
 #endif
+#ifdef __linux
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
 
 //=============================================================================
 // Globals
@@ -41,6 +49,10 @@
 // Internal note: Globals may multi-construct, see verilated.cpp top.
 
 std::atomic<uint64_t> VlMTaskVertex::s_yields;
+thread_local VlThreadWaitStats VlMTaskVertex::t_waitStats;
+std::atomic<VlThreadsWait> VlMTaskVertex::s_waitPolicy{VlThreadsWait::YIELD};
+std::atomic<uint32_t> VlMTaskVertex::s_sleepers{0};
+std::atomic<uint64_t> VlMTaskGraph::s_steals;
 
 //=============================================================================
 // VlMTaskVertex
@@ -51,11 +63,66 @@ VlMTaskVertex::VlMTaskVertex(uint32_t upstreamDepCount)
     assert(atomic_is_lock_free(&m_upstreamDepsDone));
 }
 
+void VlMTaskVertex::waitSlow(bool evenCycle) const {
+    VlThreadWaitStats& stats = t_waitStats;
+    uint64_t startTick;
+    VL_GET_CPU_TICK(startTick);
+    const VlThreadsWait policy = waitPolicy();
+    unsigned ct = 0;
+    while (!areUpstreamDepsDone(evenCycle)) {
+        VL_CPU_RELAX();
+        if (VL_UNLIKELY(++ct > VL_LOCK_SPINS)) {
+            ct = 0;
+            if (policy == VlThreadsWait::SLEEP) {
+                sleepUntilUpstreamDone(evenCycle);
+                break;
+            }
+            yieldThread();
+        }
+    }
+    uint64_t endTick;
+    VL_GET_CPU_TICK(endTick);
+    ++stats.m_waits;
+    stats.m_waitTicks += endTick - startTick;
+}
+
+void VlMTaskVertex::sleepUntilUpstreamDone(bool evenCycle) const {
+    const uint32_t target = evenCycle ? m_upstreamDepCount : 0;
+    // Count ourselves before reading the value, so signalUpstreamDone either wakes us,
+    // or has changed the value we then read
+    ++s_sleepers;
+    while (true) {
+        const uint32_t value = m_upstreamDepsDone.load();
+        if (value == target) break;
+        ++t_waitStats.m_sleeps;
+#if defined(__cpp_lib_atomic_wait)
+        m_upstreamDepsDone.wait(value);
+#elif defined(__linux)
+        // Returns at once if the value is no longer 'value'
+        syscall(SYS_futex, reinterpret_cast<const uint32_t*>(&m_upstreamDepsDone),
+                FUTEX_WAIT_PRIVATE, value, nullptr, nullptr, 0);
+#else
+        std::this_thread::yield();
+#endif
+    }
+    --s_sleepers;
+}
+
+void VlMTaskVertex::wakeSleepers() {
+#if defined(__cpp_lib_atomic_wait)
+    m_upstreamDepsDone.notify_all();
+#elif defined(__linux)
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&m_upstreamDepsDone), FUTEX_WAKE_PRIVATE,
+            INT_MAX, nullptr, nullptr, 0);
+#endif
+}
+
 //=============================================================================
 // VlWorkerThread
 
-VlWorkerThread::VlWorkerThread(VerilatedContext* contextp)
+VlWorkerThread::VlWorkerThread(VerilatedContext* contextp, const std::atomic<unsigned>* hotp)
     : m_ready_size{0}
+    , m_hotp{hotp}
     , m_cthread{startWorker, this, contextp} {}
 
 VlWorkerThread::~VlWorkerThread() {
@@ -91,6 +158,9 @@ void VlWorkerThread::workerLoop() {
 
     while (true) {
         if (VL_UNLIKELY(work.m_fnp == shutdownTask)) break;
+        if (work.m_contextp && work.m_contextp != Verilated::threadContextp()) {
+            Verilated::threadContextp(work.m_contextp);
+        }
         work.m_fnp(work.m_selfp, work.m_evenCycle);
         // Wait for next task with spinning.
         dequeWork</* SpinWait: */ true>(&work);
@@ -98,16 +168,17 @@ void VlWorkerThread::workerLoop() {
 }
 
 void VlWorkerThread::startWorker(VlWorkerThread* workerp, VerilatedContext* contextp) {
-    Verilated::threadContextp(contextp);
+    if (contextp) Verilated::threadContextp(contextp);
     workerp->workerLoop();
 }
 
 //=============================================================================
 // VlThreadPool
 
-VlThreadPool::VlThreadPool(VerilatedContext* contextp, unsigned nThreads) {
+VlThreadPool::VlThreadPool(VerilatedContext* contextp, unsigned nThreads)
+    : m_contextp{contextp} {
     for (unsigned i = 0; i < nThreads; ++i) {
-        m_workers.push_back(new VlWorkerThread{contextp});
+        m_workers.push_back(new VlWorkerThread{contextp, &m_hot});
         m_unassignedWorkers.push(i);
     }
     m_numaStatus = numaAssign();
@@ -118,6 +189,68 @@ VlThreadPool::~VlThreadPool() {
     for (auto& i : m_workers) delete i;
 }
 
+void VlThreadPool::stopWorkers() {
+    // Each ~WorkerThread will wait for its thread to exit.
+    for (auto& i : m_workers) VL_DO_CLEAR(delete i, i = nullptr);
+}
+
+void VlThreadPool::startWorkers() {
+    for (auto& i : m_workers) i = new VlWorkerThread{m_contextp, &m_hot};
+    m_numaStatus = numaAssign();
+}
+
+VlThreadPool* VlThreadPool::sharedp(unsigned nThreads) {
+    static VerilatedMutex s_mutex;
+    // Never deleted, as contexts using it may be destroyed during static destruction
+    static VlThreadPool* s_poolp = nullptr;
+    const VerilatedLockGuard lock{s_mutex};
+    if (!s_poolp) {
+        s_poolp = new VlThreadPool{nullptr, nThreads};
+        s_poolp->m_shared = true;
+    } else if (nThreads > static_cast<unsigned>(s_poolp->numThreads())) {
+        const std::string msg = "Shared thread pool has " + std::to_string(s_poolp->numThreads())
+                                + " workers but a VerilatedContext needs "
+                                + std::to_string(nThreads)
+                                + "; create the context with the most threads first";
+        VL_FATAL_MT(__FILE__, __LINE__, "", msg.c_str());
+    }
+    return s_poolp;
+}
+
+void VlThreadPool::numaPlace(int index, const void* beginp, const void* endp) {
+#if defined(__linux) && defined(SYS_move_pages) && defined(SYS_getcpu)
+    // Only a single node, or pages that cannot move, makes this a no-op
+    static const bool s_multiNode = access("/sys/devices/system/node/node1", F_OK) == 0;
+    if (!s_multiNode || index < 0 || index >= numThreads()) return;
+    // Only pages completely within the range are moved, others hold other workers' state
+    const uintptr_t pageSize = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+    struct Placement final {
+        std::vector<void*> m_pages;  // Pages to move
+    } placement;
+    for (uintptr_t page = (reinterpret_cast<uintptr_t>(beginp) + pageSize - 1) & ~(pageSize - 1);
+         page + pageSize <= reinterpret_cast<uintptr_t>(endp); page += pageSize) {
+        placement.m_pages.push_back(reinterpret_cast<void*>(page));
+    }
+    if (placement.m_pages.empty()) return;
+    // Move them from the worker, which numaAssign may have pinned, to its current node
+    m_workers[index]->addTask(
+        [](void* placementp, bool) {
+            std::vector<void*>& pages = static_cast<Placement*>(placementp)->m_pages;
+            unsigned cpu = 0;
+            unsigned node = 0;
+            if (syscall(SYS_getcpu, &cpu, &node, nullptr) != 0) return;
+            std::vector<int> nodes(pages.size(), static_cast<int>(node));
+            std::vector<int> status(pages.size(), 0);
+            constexpr int MOVE_FLAG = 1 << 1;  // MPOL_MF_MOVE, <numaif.h> needs libnuma
+            // Failure leaves the pages where they are, which is only slower
+            syscall(SYS_move_pages, 0, pages.size(), pages.data(), nodes.data(), status.data(),
+                    MOVE_FLAG);
+        },
+        &placement);
+    m_workers[index]->wait();
+#endif
+}
+
 bool VlThreadPool::isNumactlRunning() {
     // We assume if current thread is CPU-masked, then under numactl, otherwise not.
     // This shows that numactl is visible through the affinity mask
@@ -146,19 +279,17 @@ std::string VlThreadPool::numaAssign() {
     // Read CPU info.
     // Uncertain if any modern system has gaps in the processor id (Solaris
     // did), but just in case use vectors instead of processor number math.
-    //
-    // Currently ignoring socket number "physical id".
-    // If processor numbers are sequential on sockets, algorithm works out ok.
-    // If processor numbers are strided on sockets, algorithm also works out ok.
     std::ifstream is{"/proc/cpuinfo"};
     if (VL_UNLIKELY(!is)) return "%Warning: no /proc/cpuinfo";
 
     std::vector<int> unassigned_processors;  // Processors to assign in sorted order
-    std::map<int, int> processor_core;
+    std::map<int, int> processor_core;  // Core numbers are unique across sockets
+    std::map<int, int> processor_socket;
     std::multimap<int, int> core_processors;
     std::set<int> cores;
     {
         int processor = -1;
+        int socket = 0;
         while (!is.eof()) {
             std::string line;
             std::getline(is, line);
@@ -167,25 +298,47 @@ std::string VlThreadPool::numaAssign() {
             if (pos != std::string::npos) number = atoi(line.c_str() + pos + 1);
             if (line.compare(0, std::strlen("processor"), "processor") == 0) {
                 processor = number;
+                socket = 0;
+            } else if (line.compare(0, std::strlen("physical id"), "physical id") == 0) {
+                socket = number;
             } else if (line.compare(0, std::strlen("core id"), "core id") == 0) {
-                const int core = number;
-                // std::cout << "p" << processor << " socket " << socket << " c" << core <<
-                // std::endl;
+                const int core = socket * 65536 + number;
                 cores.emplace(core);
                 processor_core[processor] = core;
+                processor_socket[processor] = socket;
                 core_processors.emplace(core, processor);
                 unassigned_processors.push_back(processor);
             }
         }
     }
 
+    // Group processors by the last level cache they share, e.g. an AMD CCX.
+    // Without sysfs cache information assume one shared cache per socket.
+    std::map<int, std::string> processor_cache;
+    for (const int processor : unassigned_processors) {
+        std::string cache = "socket" + std::to_string(processor_socket[processor]);
+        const std::string cpuDir
+            = "/sys/devices/system/cpu/cpu" + std::to_string(processor) + "/cache/index";
+        for (int index = 0;; ++index) {
+            const std::string dir = cpuDir + std::to_string(index);
+            std::string level;
+            std::getline(std::ifstream{dir + "/level"}, level);
+            if (level.empty()) break;
+            if (level == "3") {
+                std::getline(std::ifstream{dir + "/shared_cpu_list"}, cache);
+                break;
+            }
+        }
+        processor_cache[processor] = cache;
+    }
+
     // Start scheduling on the current CPU + 1.
     // This will help to land on the same socket as current CPU, and also
     // help make sure that different processes have different masks (when
     // num_threads is not a common-factor of the processor count).
     std::sort(unassigned_processors.begin(), unassigned_processors.end());
+    const int on_cpu = sched_getcpu();  // TODO: this is a system call. Not exactly cheap.
     {
-        const int on_cpu = sched_getcpu();  // TODO: this is a system call. Not exactly cheap.
         bool hit = false;
         std::vector<int> new_front;
         std::vector<int> new_back;
@@ -201,8 +354,23 @@ std::string VlThreadPool::numaAssign() {
         unassigned_processors.insert(unassigned_processors.end(), new_back.begin(),
                                      new_back.end());
     }
+    // Then fill the cache of the current CPU, before moving on to the next cache. Verilator
+    // numbers the threads exchanging the most data adjacently, so they share a cache.
+    {
+        std::map<std::string, int> cache_rank;
+        cache_rank.emplace(processor_cache[on_cpu], 0);
+        for (const int processor : unassigned_processors) {
+            cache_rank.emplace(processor_cache[processor], static_cast<int>(cache_rank.size()));
+        }
+        std::stable_sort(unassigned_processors.begin(), unassigned_processors.end(),
+                         [&](int a, int b) {
+                             return cache_rank[processor_cache[a]]
+                                    < cache_rank[processor_cache[b]];
+                         });
+    }
 
-    // If less threads than cores, we can schedule per-core
+    // If less threads than cores, we can give each thread a core of its own,
+    // so no thread shares a core with another as an SMT sibling
     const bool core_per_thread = num_threads <= cores.size();
 
     // Compute core mapping
@@ -213,6 +381,7 @@ std::string VlThreadPool::numaAssign() {
         for (const int processor : unassigned_processors) {
             // Find free processor, the current thread can use that
             if (assigned_processors.find(processor) != assigned_processors.end()) continue;
+            if (core_per_thread && thread_processors.count(thread)) break;  // All cores given
             assigned_processors.emplace(processor);
             thread_processors.emplace(thread, processor);
             if (core_per_thread) {
@@ -257,3 +426,199 @@ std::string VlThreadPool::numaAssign() {
     return "non-supported host OS";
 #endif
 }
+
+//=============================================================================
+// VlMTaskGraph
+
+void VlMTaskGraph::init(const VlMTaskInfo* infop, uint32_t size, const uint32_t* succsp,
+                        uint32_t nThreads, VerilatedContext* contextp) {
+    assert(nThreads >= 1);
+    m_contextp = contextp;
+    m_infop = infop;
+    m_succsp = succsp;
+    m_size = size;
+    m_nThreads = nThreads;
+    m_repackAfter = contextp->threadsRepack();
+    if (m_repackAfter) m_costs.resize(size, 0);
+    for (uint32_t i = 0; i < size; ++i) {
+        m_vertices.emplace_back(infop[i].m_upstreamDepCount);
+        m_threadIds.push_back(infop[i].m_threadId % nThreads);
+    }
+    for (uint32_t i = 0; i < nThreads; ++i) m_queues.emplace_back(new ReadyQueue);
+    for (uint32_t i = 0; i + 1 < nThreads; ++i) m_helpers.push_back(HelperEntry{this, i});
+}
+
+void VlMTaskGraph::execute(VlThreadPool* poolp, VlSelfP selfp, bool evenCycle) {
+    m_selfp = selfp;
+    m_remaining.store(m_size, std::memory_order_relaxed);
+    // Seed the queues with the MTasks having no upstream dependencies, on the
+    // thread the static schedule chose for them
+    for (uint32_t i = 0; i < m_size; ++i) {
+        if (!m_infop[i].m_upstreamDepCount) push(m_threadIds[i], i);
+    }
+    m_activeHelpers.store(static_cast<uint32_t>(m_helpers.size()), std::memory_order_relaxed);
+    poolp->enqueueBegin();
+    for (HelperEntry& entry : m_helpers) {
+        poolp->workerp(static_cast<int>(entry.m_queue))
+            ->addTask(helperEntry, &entry, evenCycle, m_contextp);
+    }
+    poolp->enqueueEnd();
+    // The calling thread owns the last queue
+    run(m_nThreads - 1, evenCycle);
+    // Wait for the helpers to leave, so the next evaluation can reseed the queues
+    unsigned ct = 0;
+    while (VL_UNLIKELY(m_activeHelpers.load(std::memory_order_acquire))) {
+        VL_CPU_RELAX();
+        if (VL_UNLIKELY(++ct > VL_LOCK_SPINS)) {
+            ct = 0;
+            VlMTaskVertex::yieldThread();
+        }
+    }
+    // After the warm-up window, re-pack onto threads using the measured costs
+    if (VL_UNLIKELY(m_repackAfter) && ++m_evals == m_repackAfter) {
+        repack();
+        m_repackAfter = 0;
+    }
+}
+
+void VlMTaskGraph::helperEntry(VlSelfP entryp, bool evenCycle) {
+    const HelperEntry* const helperp = static_cast<HelperEntry*>(entryp);
+    VlMTaskGraph* const graphp = helperp->m_graphp;
+    graphp->run(helperp->m_queue, evenCycle);
+    graphp->m_activeHelpers.fetch_sub(1, std::memory_order_release);
+}
+
+void VlMTaskGraph::run(uint32_t queue, bool evenCycle) {
+    // Each queue is owned by one thread, so it indexes per-thread state, e.g. coverage shards
+    Verilated::threadIndex(queue);
+    unsigned ct = 0;
+    while (m_remaining.load(std::memory_order_acquire)) {
+        uint32_t index;
+        if (!pop(queue, index) && !steal(queue, index)) {
+            VL_CPU_RELAX();
+            if (VL_UNLIKELY(++ct > VL_LOCK_SPINS)) {
+                ct = 0;
+                VlMTaskVertex::yieldThread();
+            }
+            continue;
+        }
+        ct = 0;
+        runMTask(queue, index, evenCycle);
+    }
+}
+
+void VlMTaskGraph::runMTask(uint32_t queue, uint32_t index, bool evenCycle) {
+    const VlMTaskInfo& info = m_infop[index];
+    if (VL_UNLIKELY(m_repackAfter)) {
+        // Only this thread touches this MTask's cost during the evaluation
+        uint64_t tick;
+        VL_GET_CPU_TICK(tick);
+        m_costs[index] -= tick;
+        info.m_fnp(m_selfp, evenCycle);
+        VL_GET_CPU_TICK(tick);
+        m_costs[index] += tick;
+    } else {
+        info.m_fnp(m_selfp, evenCycle);
+    }
+    for (uint32_t i = info.m_succBegin; i < info.m_succEnd; ++i) {
+        const uint32_t succ = m_succsp[i];
+        if (m_vertices[succ].signalUpstreamDone(evenCycle)) {
+            // Make the results of all the other upstream MTasks visible
+            std::atomic_thread_fence(std::memory_order_acquire);
+            push(m_threadIds[succ], succ);
+        }
+    }
+    m_remaining.fetch_sub(1, std::memory_order_release);
+}
+
+void VlMTaskGraph::repack() {
+    // Topological order, from the dependency counts
+    std::vector<uint32_t> order;
+    order.reserve(m_size);
+    std::vector<uint32_t> pending(m_size);
+    for (uint32_t i = 0; i < m_size; ++i) {
+        pending[i] = m_infop[i].m_upstreamDepCount;
+        if (!pending[i]) order.push_back(i);
+    }
+    for (size_t n = 0; n < order.size(); ++n) {
+        const VlMTaskInfo& info = m_infop[order[n]];
+        for (uint32_t i = info.m_succBegin; i < info.m_succEnd; ++i) {
+            if (!--pending[m_succsp[i]]) order.push_back(m_succsp[i]);
+        }
+    }
+    // Priority is the measured critical path from the start of the MTask to the end
+    std::vector<uint64_t> priority(m_size, 0);
+    for (auto it = order.rbegin(); it != order.rend(); ++it) {
+        const VlMTaskInfo& info = m_infop[*it];
+        uint64_t downstream = 0;
+        for (uint32_t i = info.m_succBegin; i < info.m_succEnd; ++i) {
+            downstream = std::max(downstream, priority[m_succsp[i]]);
+        }
+        priority[*it] = m_costs[*it] + downstream;
+    }
+    // List schedule: place the ready MTask with the highest priority on the
+    // thread that can start it earliest
+    std::vector<uint64_t> threadFree(m_nThreads, 0);
+    std::vector<uint64_t> readyTime(m_size, 0);
+    std::priority_queue<std::pair<uint64_t, uint32_t>> ready;
+    for (uint32_t i = 0; i < m_size; ++i) {
+        pending[i] = m_infop[i].m_upstreamDepCount;
+        if (!pending[i]) ready.emplace(priority[i], i);
+    }
+    while (!ready.empty()) {
+        const uint32_t index = ready.top().second;
+        ready.pop();
+        uint32_t bestThread = 0;
+        uint64_t bestStart = std::max(threadFree[0], readyTime[index]);
+        for (uint32_t t = 1; t < m_nThreads; ++t) {
+            const uint64_t start = std::max(threadFree[t], readyTime[index]);
+            if (start < bestStart) {
+                bestThread = t;
+                bestStart = start;
+            }
+        }
+        m_threadIds[index] = bestThread;
+        const uint64_t end = bestStart + m_costs[index];
+        threadFree[bestThread] = end;
+        const VlMTaskInfo& info = m_infop[index];
+        for (uint32_t i = info.m_succBegin; i < info.m_succEnd; ++i) {
+            const uint32_t succ = m_succsp[i];
+            readyTime[succ] = std::max(readyTime[succ], end);
+            if (!--pending[succ]) ready.emplace(priority[succ], succ);
+        }
+    }
+    m_costs.clear();
+}
+
+void VlMTaskGraph::push(uint32_t queue, uint32_t index) {
+    ReadyQueue& rq = *m_queues[queue];
+    const VerilatedLockGuard lock{rq.m_mutex};
+    rq.m_tasks.push_back(index);
+    rq.m_size.fetch_add(1, std::memory_order_relaxed);
+}
+
+bool VlMTaskGraph::pop(uint32_t queue, uint32_t& index) {
+    ReadyQueue& rq = *m_queues[queue];
+    if (!rq.m_size.load(std::memory_order_relaxed)) return false;
+    const VerilatedLockGuard lock{rq.m_mutex};
+    if (rq.m_tasks.empty()) return false;
+    index = rq.m_tasks.back();
+    rq.m_tasks.pop_back();
+    rq.m_size.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool VlMTaskGraph::steal(uint32_t queue, uint32_t& index) {
+    for (uint32_t i = 1; i < m_nThreads; ++i) {
+        ReadyQueue& rq = *m_queues[(queue + i) % m_nThreads];
+        if (!rq.m_size.load(std::memory_order_relaxed)) continue;
+        const VerilatedLockGuard lock{rq.m_mutex};
+        if (rq.m_tasks.empty()) continue;
+        index = rq.m_tasks.front();
+        rq.m_tasks.pop_front();
+        rq.m_size.fetch_sub(1, std::memory_order_relaxed);
+        ++s_steals;  // Statistics
+        return true;
+    }
+    return false;
+}
@@ -29,6 +29,8 @@
 
 #include <atomic>
 #include <condition_variable>
+#include <deque>
+#include <memory>
 #include <set>
 #include <stack>
 #include <thread>
@@ -44,10 +46,28 @@ using VlSelfP = void*;
 
 using VlExecFnp = void (*)(VlSelfP, bool);
 
+// How threads wait for upstream mtasks and for work, see +verilator+threads+wait+
+enum class VlThreadsWait : uint8_t {
+    YIELD,  // Spin, then yield the CPU between further spins (default)
+    SLEEP,  // Spin, then block until the upstream mtasks are done
+    SPIN  // Only spin, idle workers also busy-poll between evaluations
+};
+
+// Waiting statistics of one thread, reported by VlExecutionProfiler
+struct VlThreadWaitStats final {
+    uint64_t m_waits = 0;  // Waits for upstream mtasks not already done
+    uint64_t m_waitTicks = 0;  // Ticks spent in those waits
+    uint64_t m_yields = 0;  // Yields of the CPU while waiting
+    uint64_t m_sleeps = 0;  // Blocking sleeps while waiting
+};
+
 // Track dependencies for a single MTask.
 class VlMTaskVertex final {
     // MEMBERS
     static std::atomic<uint64_t> s_yields;  // Statistics
+    static thread_local VlThreadWaitStats t_waitStats;  // Statistics of this thread
+    static std::atomic<VlThreadsWait> s_waitPolicy;  // Process-wide wait policy
+    static std::atomic<uint32_t> s_sleepers;  // Threads blocked in sleepUntilUpstreamDone
 
     // On even cycles, _upstreamDepsDone increases as upstream
     // dependencies complete. When it reaches _upstreamDepCount,
@@ -78,8 +98,16 @@ public:
     ~VlMTaskVertex() = default;
 
     static uint64_t yields() { return s_yields; }
+    static VlThreadWaitStats& waitStats() { return t_waitStats; }
+    static VlThreadsWait waitPolicy() VL_MT_SAFE {
+        return s_waitPolicy.load(std::memory_order_relaxed);
+    }
+    static void waitPolicy(VlThreadsWait policy) VL_MT_SAFE { s_waitPolicy.store(policy); }
+    // Back off after spinning VL_LOCK_SPINS times, unless the policy is to only spin
     static void yieldThread() {
+        if (waitPolicy() == VlThreadsWait::SPIN) return;
         ++s_yields;  // Statistics
+        ++t_waitStats.m_yields;
         std::this_thread::yield();
     }
 
@@ -87,33 +115,32 @@ public:
     // Returns true when the current MTaskVertex becomes ready to execute,
     // false while it's still waiting on more dependencies.
     bool signalUpstreamDone(bool evenCycle) {
+        bool ready;
         if (evenCycle) {
-            const uint32_t upstreamDepsDone
-                = 1 + m_upstreamDepsDone.fetch_add(1, std::memory_order_release);
+            const uint32_t upstreamDepsDone = 1 + m_upstreamDepsDone.fetch_add(1);
             assert(upstreamDepsDone <= m_upstreamDepCount);
-            return (upstreamDepsDone == m_upstreamDepCount);
+            ready = upstreamDepsDone == m_upstreamDepCount;
         } else {
-            const uint32_t upstreamDepsDone_prev
-                = m_upstreamDepsDone.fetch_sub(1, std::memory_order_release);
+            const uint32_t upstreamDepsDone_prev = m_upstreamDepsDone.fetch_sub(1);
             assert(upstreamDepsDone_prev > 0);
-            return (upstreamDepsDone_prev == 1);
+            ready = upstreamDepsDone_prev == 1;
         }
+        // Sequentially consistent with the count in sleepUntilUpstreamDone, so no wakeup is lost
+        if (ready && VL_UNLIKELY(s_sleepers.load())) wakeSleepers();
+        return ready;
     }
     bool areUpstreamDepsDone(bool evenCycle) const {
         const uint32_t target = evenCycle ? m_upstreamDepCount : 0;
         return m_upstreamDepsDone.load(std::memory_order_acquire) == target;
     }
     void waitUntilUpstreamDone(bool evenCycle) const {
-        unsigned ct = 0;
-        while (VL_UNLIKELY(!areUpstreamDepsDone(evenCycle))) {
-            VL_CPU_RELAX();
-            ++ct;
-            if (VL_UNLIKELY(ct > VL_LOCK_SPINS)) {
-                ct = 0;
-                yieldThread();
-            }
-        }
+        if (VL_UNLIKELY(!areUpstreamDepsDone(evenCycle))) waitSlow(evenCycle);
     }
+
+private:
+    void waitSlow(bool evenCycle) const;
+    void sleepUntilUpstreamDone(bool evenCycle) const;
+    void wakeSleepers();
 };
 
 class VlWorkerThread final {
@@ -123,11 +150,13 @@ private:
         VlExecFnp m_fnp = nullptr;  // Function to execute
         VlSelfP m_selfp = nullptr;  // Symbol table to execute
         bool m_evenCycle = false;  // Even/odd for flag alternation
+        VerilatedContext* m_contextp = nullptr;  // Context to execute under, or nullptr
         ExecRec() = default;
-        ExecRec(VlExecFnp fnp, VlSelfP selfp, bool evenCycle)
+        ExecRec(VlExecFnp fnp, VlSelfP selfp, bool evenCycle, VerilatedContext* contextp)
             : m_fnp{fnp}
             , m_selfp{selfp}
-            , m_evenCycle{evenCycle} {}
+            , m_evenCycle{evenCycle}
+            , m_contextp{contextp} {}
     };
 
     // MEMBERS
@@ -142,6 +171,8 @@ private:
     std::vector<ExecRec> m_ready VL_GUARDED_BY(m_mutex);
     // Store the size atomically, so we can spin wait
     std::atomic<size_t> m_ready_size;
+    // Non-zero while the pool keeps workers spinning, see VlThreadPool::hotBegin
+    const std::atomic<unsigned>* const m_hotp;
 
     std::thread m_cthread;  // Underlying C++ thread record
 
@@ -153,7 +184,7 @@ protected:
 
 public:
     // CONSTRUCTORS
-    explicit VlWorkerThread(VerilatedContext* contextp);
+    VlWorkerThread(VerilatedContext* contextp, const std::atomic<unsigned>* hotp);
     ~VlWorkerThread();
 
     // METHODS
@@ -161,7 +192,9 @@ public:
     void dequeWork(ExecRec* workp) VL_MT_SAFE_EXCLUDES(m_mutex) {
         // Spin for a while, waiting for new data
         if VL_CONSTEXPR_CXX17 (N_SpinWait) {
-            for (unsigned i = 0; i < VL_LOCK_SPINS; ++i) {
+            const bool poll = VlMTaskVertex::waitPolicy() == VlThreadsWait::SPIN;
+            for (unsigned i = 0;
+                 i < VL_LOCK_SPINS || poll || m_hotp->load(std::memory_order_relaxed); ++i) {
                 if (VL_LIKELY(m_ready_size.load(std::memory_order_relaxed))) break;
                 VL_CPU_RELAX();
             }
@@ -178,12 +211,14 @@ public:
         m_ready.erase(m_ready.begin());
         m_ready_size.fetch_sub(1, std::memory_order_relaxed);
     }
-    void addTask(VlExecFnp fnp, VlSelfP selfp, bool evenCycle = false)
-        VL_MT_SAFE_EXCLUDES(m_mutex) {
+    // If 'contextp' is given, the task runs with it as Verilated::threadContextp(),
+    // as needed when the pool is shared between contexts
+    void addTask(VlExecFnp fnp, VlSelfP selfp, bool evenCycle = false,
+                 VerilatedContext* contextp = nullptr) VL_MT_SAFE_EXCLUDES(m_mutex) {
         bool notify;
         {
             const VerilatedLockGuard lock{m_mutex};
-            m_ready.emplace_back(fnp, selfp, evenCycle);
+            m_ready.emplace_back(fnp, selfp, evenCycle, contextp);
             m_ready_size.fetch_add(1, std::memory_order_relaxed);
             notify = m_waiting;
         }
@@ -207,6 +242,11 @@ class VlThreadPool final : public VerilatedVirtualBase {
     // For sequentially generating task IDs to avoid shadowing
     std::atomic<unsigned> m_assignedTasks{0};
     std::string m_numaStatus;  // Status of NUMA assignment
+    VerilatedContext* const m_contextp;  // Context workers run under, nullptr if shared
+    // Held while enqueueing the tasks of one evaluation onto a shared pool
+    VerilatedMutex m_enqueueMutex;
+    bool m_shared = false;  // Process-wide pool, see sharedp()
+    std::atomic<unsigned> m_hot{0};  // Number of hotBegin() without hotEnd()
 
 public:
     // CONSTRUCTORS
@@ -230,6 +270,31 @@ public:
         indexes.clear();
     }
     unsigned assignTaskIndex() { return m_assignedTasks++; }
+    // Bracket enqueueing the worker tasks of one evaluation. On a shared pool
+    // evaluations of different models then reach every worker in the same
+    // order, so a task only ever waits on tasks queued ahead of it.
+    void enqueueBegin() VL_MT_SAFE {
+        if (m_shared) m_enqueueMutex.lock();
+    }
+    void enqueueEnd() VL_MT_SAFE {
+        if (m_shared) m_enqueueMutex.unlock();
+    }
+    bool shared() const { return m_shared; }
+    // Bracket a run of evaluations with little time between them, e.g.
+    // evalCycles(). Idle workers keep spinning for work instead of sleeping
+    // until the matching hotEnd(), avoiding the wakeup latency each cycle.
+    void hotBegin() VL_MT_SAFE { m_hot.fetch_add(1, std::memory_order_relaxed); }
+    void hotEnd() VL_MT_SAFE { m_hot.fetch_sub(1, std::memory_order_relaxed); }
+    // Return the process-wide pool used by contexts with threadPoolShared(),
+    // creating it with 'nThreads' workers on first call
+    static VlThreadPool* sharedp(unsigned nThreads);
+    // Terminate the worker threads, which must be idle, e.g. before fork()
+    void stopWorkers();
+    // Recreate the worker threads terminated by stopWorkers()
+    void startWorkers();
+    // Move the whole pages of model state in [beginp, endp) to the NUMA node
+    // of worker 'index', as that worker's mtasks are the only users of it
+    void numaPlace(int index, const void* beginp, const void* endp);
     int numThreads() const { return static_cast<int>(m_workers.size()); }
     std::string numaStatus() const { return m_numaStatus; }
     VlWorkerThread* workerp(int index) {
@@ -246,4 +311,80 @@ private:
     std::string numaAssign();
 };
 
+//=============================================================================
+// Work-stealing execution of an mtask graph, used with --threads-work-stealing
+
+// Static description of a single MTask, emitted by Verilator into a constant table
+struct VlMTaskInfo final {
+    VlExecFnp m_fnp;  // Function executing the MTask body
+    uint32_t m_threadId;  // Thread the static schedule packed this MTask onto
+    uint32_t m_upstreamDepCount;  // Number of upstream MTasks
+    uint32_t m_succBegin;  // Index of first downstream MTask in successor table
+    uint32_t m_succEnd;  // One past the last downstream MTask in successor table
+};
+
+class VlMTaskGraph final {
+    // TYPES
+    // MTasks ready to execute on one thread. The owner pops from the back (the
+    // most recently readied MTask, whose inputs are likely still in cache),
+    // other threads steal from the front. An MTask is readied on the queue
+    // of the thread it is packed onto; initially that of the static schedule,
+    // after +verilator+threads+repack one computed from measured costs.
+    struct ReadyQueue final {
+        mutable VerilatedMutex m_mutex;
+        std::deque<uint32_t> m_tasks VL_GUARDED_BY(m_mutex);
+        // Store the size atomically, so we can poll without locking
+        std::atomic<size_t> m_size{0};
+    };
+    struct HelperEntry final {
+        VlMTaskGraph* m_graphp;  // Graph being executed
+        uint32_t m_queue;  // Ready queue owned by this helper
+    };
+
+    // MEMBERS
+    static std::atomic<uint64_t> s_steals;  // Statistics
+
+    const VlMTaskInfo* m_infop = nullptr;  // MTask table, indexed by MTask index
+    const uint32_t* m_succsp = nullptr;  // Successor table, ranges given by VlMTaskInfo
+    uint32_t m_size = 0;  // Number of MTasks
+    uint32_t m_nThreads = 0;  // Number of threads executing the graph, including the caller
+    std::deque<VlMTaskVertex> m_vertices;  // Dependency counters, indexed by MTask index
+    std::vector<std::unique_ptr<ReadyQueue>> m_queues;  // Ready queue for each thread
+    std::vector<HelperEntry> m_helpers;  // Argument passed to each helper thread
+    std::vector<uint32_t> m_threadIds;  // Thread whose queue each MTask is readied on
+    std::vector<uint64_t> m_costs;  // Measured ticks of each MTask, while measuring
+    uint64_t m_repackAfter = 0;  // Evaluations to measure before re-packing, 0 = never
+    uint64_t m_evals = 0;  // Evaluations measured so far
+    VlSelfP m_selfp = nullptr;  // Model being evaluated
+    VerilatedContext* m_contextp = nullptr;  // Context of the model being evaluated
+    std::atomic<uint32_t> m_remaining{0};  // MTasks not yet completed in this evaluation
+    std::atomic<uint32_t> m_activeHelpers{0};  // Helper threads still executing MTasks
+
+public:
+    // CONSTRUCTORS
+    VlMTaskGraph() = default;
+    ~VlMTaskGraph() = default;
+
+    // METHODS
+    static uint64_t steals() { return s_steals; }
+    bool initialized() const { return m_infop; }
+    // Set up the graph from the Verilator generated tables
+    void init(const VlMTaskInfo* infop, uint32_t size, const uint32_t* succsp, uint32_t nThreads,
+              VerilatedContext* contextp);
+    // Execute every MTask in the graph, using the first 'nThreads - 1' workers of the
+    // pool and the calling thread. Returns when all MTasks have completed.
+    void execute(VlThreadPool* poolp, VlSelfP selfp, bool evenCycle);
+
+private:
+    VL_UNCOPYABLE(VlMTaskGraph);
+
+    static void helperEntry(VlSelfP entryp, bool evenCycle);
+    void run(uint32_t queue, bool evenCycle);
+    void runMTask(uint32_t queue, uint32_t index, bool evenCycle);
+    void repack();
+    void push(uint32_t queue, uint32_t index);
+    bool pop(uint32_t queue, uint32_t& index);
+    bool steal(uint32_t queue, uint32_t& index);
+};
+
 #endif
@@ -59,10 +59,17 @@ void VlDelayScheduler::resume() {
 #endif
     bool resumed = false;
 
-    while (!m_queue.empty() && (m_queue.cbegin()->first == m_context.time())) {
-        VlCoroutineHandle handle = std::move(m_queue.begin()->second);
-        m_queue.erase(m_queue.begin());
-        handle.resume();
+    const uint64_t now = m_context.time();
+    if (!delayedEmpty() && earliestTime() == now) {
+        advanceWheel(now);
+        // Take the whole slot, as resumed coroutines may schedule into other slots. We swap
+        // with the m_resumeBatch field to keep the allocated buffers.
+        const size_t slot = now & WHEEL_MASK;
+        m_resumeBatch.swap(m_wheel[slot]);
+        m_wheelUsed[slot / 64] &= ~(1ULL << (slot % 64));
+        m_wheelCount -= m_resumeBatch.size();
+        for (auto&& handle : m_resumeBatch) handle.resume();
+        m_resumeBatch.clear();
         resumed = true;
     }
 
@@ -86,8 +93,59 @@ void VlDelayScheduler::resume() {
     }
 }
 
+static inline size_t vlLowestSetBit(uint64_t bits) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(bits);
+#else
+    size_t bit = 0;
+    while (!(bits & 1)) {
+        bits >>= 1;
+        ++bit;
+    }
+    return bit;
+#endif
+}
+
+uint64_t VlDelayScheduler::earliestTime() const {
+    if (!m_wheelCount) return m_queue.cbegin()->first;
+    // Search the used slot bits circularly, starting from the slot of m_wheelBase
+    const size_t start = m_wheelBase & WHEEL_MASK;
+    for (size_t n = 0; n <= WHEEL_WORDS; ++n) {
+        const size_t word = (start / 64 + n) % WHEEL_WORDS;
+        uint64_t bits = m_wheelUsed[word];
+        if (n == 0) bits &= ~0ULL << (start % 64);  // Skip slots before start in first word
+        if (bits) {
+            const size_t slot = word * 64 + vlLowestSetBit(bits);
+            return m_wheelBase + ((slot - start) & WHEEL_MASK);
+        }
+    }
+    VL_FATAL_MT(__FILE__, __LINE__, "", "Internal: Timing wheel count mismatch");
+    return 0;
+}
+
+void VlDelayScheduler::advanceWheel(uint64_t time) {
+    // Caller ensures no wheel slot earlier than time is used
+    m_wheelBase = time;
+    while (!m_queue.empty() && m_queue.cbegin()->first - m_wheelBase < WHEEL_SIZE) {
+        const auto it = m_queue.begin();
+        schedule(it->first, std::move(it->second));
+        m_queue.erase(it);
+    }
+}
+
 uint64_t VlDelayScheduler::nextTimeSlot() const {
-    if (!m_queue.empty()) return m_queue.cbegin()->first;
+    uint64_t next = ~0ULL;
+    bool found = false;
+    if (!delayedEmpty()) {
+        next = earliestTime();
+        found = true;
+    }
+    for (const Timer& timer : m_timers) {
+        if (!timer.m_active) continue;
+        next = std::min(next, timer.m_next);
+        found = true;
+    }
+    if (found) return next;
     if (m_zeroDelayed.empty())
         VL_FATAL_MT(__FILE__, __LINE__, "", "There is no next time slot scheduled");
     return m_context.time();
@@ -95,7 +153,7 @@ uint64_t VlDelayScheduler::nextTimeSlot() const {
 
 #ifdef VL_DEBUG
 void VlDelayScheduler::dump() const {
-    if (m_queue.empty()) {
+    if (delayedEmpty()) {
         VL_DBG_MSGF("         No delayed processes:\n");
     } else {
         VL_DBG_MSGF("         Delayed processes:\n");
@@ -105,29 +163,43 @@ void VlDelayScheduler::dump() const {
                         m_context.time());
             susp.dump();
         }
+        for (uint64_t n = 0; n < WHEEL_SIZE; ++n) {
+            for (const auto& susp : m_wheel[(m_wheelBase + n) & WHEEL_MASK]) {
+                VL_DBG_MSGF("             Awaiting time %" PRIu64 ": ", m_wheelBase + n);
+                susp.dump();
+            }
+        }
         for (const auto& susp : m_queue) {
             VL_DBG_MSGF("             Awaiting time %" PRIu64 ": ", susp.first);
             susp.second.dump();
         }
     }
+    for (size_t id = 0; id < m_timers.size(); ++id) {
+        if (!m_timers[id].m_active) continue;
+        VL_DBG_MSGF("         Timer %zu: next time %" PRIu64 ", period %" PRIu64 "\n", id,
+                    m_timers[id].m_next, m_timers[id].m_period);
+    }
 }
 #endif
 
 //======================================================================
 // VlTriggerScheduler:: Methods
 
-void VlTriggerScheduler::resume(const char* eventDescription) {
+void VlTriggerScheduler::resumeSlow(const char* eventDescription) {
 #ifdef VL_DEBUG
     VL_DEBUG_IF(dump(eventDescription);
                 VL_DBG_MSGF("         Resuming processes waiting for %s\n", eventDescription););
 #endif
-    std::swap(m_ready, m_resumeQueue);
-    for (VlCoroutineHandle& coro : m_resumeQueue) coro.resume();
-    m_resumeQueue.clear();
+    if (!m_ready.empty()) {
+        // Swap, so coroutines can suspend on this trigger again while in the loop
+        std::swap(m_ready, m_resumeQueue);
+        for (VlCoroutineHandle& coro : m_resumeQueue) coro.resume();
+        m_resumeQueue.clear();
+    }
     commit(eventDescription);
 }
 
-void VlTriggerScheduler::commit(const char* eventDescription) {
+void VlTriggerScheduler::commitSlow(const char* eventDescription) {
 #ifdef VL_DEBUG
     if (!m_uncommitted.empty()) {
         VL_DEBUG_IF(
@@ -139,6 +211,11 @@ void VlTriggerScheduler::commit(const char* eventDescription) {
             });
     }
 #endif
+    if (m_ready.empty()) {
+        // Common case, just exchange the buffers
+        std::swap(m_ready, m_uncommitted);
+        return;
+    }
     m_ready.reserve(m_ready.size() + m_uncommitted.size());
     m_ready.insert(m_ready.end(), std::make_move_iterator(m_uncommitted.begin()),
                    std::make_move_iterator(m_uncommitted.end()));
@@ -169,7 +246,7 @@ void VlTriggerScheduler::dump(const char* eventDescription) const {
 //======================================================================
 // VlDynamicTriggerScheduler:: Methods
 
-bool VlDynamicTriggerScheduler::evaluate() {
+bool VlDynamicTriggerScheduler::evaluateSlow() {
     m_anyTriggered = false;
     VL_DEBUG_IF(dump(););
     std::swap(m_suspended, m_evaluated);
@@ -178,7 +255,7 @@ bool VlDynamicTriggerScheduler::evaluate() {
     return m_anyTriggered;
 }
 
-void VlDynamicTriggerScheduler::doPostUpdates() {
+void VlDynamicTriggerScheduler::doPostUpdatesSlow() {
     VL_DEBUG_IF(if (!m_post.empty())
                     VL_DBG_MSGF("         Doing post updates for processes:\n");  //
                 for (const auto& susp
@@ -190,7 +267,7 @@ void VlDynamicTriggerScheduler::doPostUpdates() {
     m_post.clear();
 }
 
-void VlDynamicTriggerScheduler::resume() {
+void VlDynamicTriggerScheduler::resumeSlow() {
     VL_DEBUG_IF(if (!m_triggered.empty()) VL_DBG_MSGF("         Resuming processes:\n");  //
                 for (const auto& susp
                      : m_triggered) {
@@ -224,6 +301,77 @@ void VlForkSync::done(const char* filename, int lineno) {
     if (m_join->m_counter == 0) m_join->m_susp.resume();
 }
 
+//======================================================================
+// VlCoroutineFramePool:: Methods
+
+// Pool of this thread, created on first use. Cleared when the thread exits; frames freed after
+// that (e.g. by static destructors) go straight to operator delete.
+static thread_local VlCoroutineFramePool* t_framePoolp = nullptr;
+static thread_local bool t_framePoolDead = false;
+
+VlCoroutineFramePool* VlCoroutineFramePool::threadPoolp() {
+    if (VL_UNLIKELY(!t_framePoolp && !t_framePoolDead)) {
+        // Owner destroys the pool at thread exit
+        static thread_local std::unique_ptr<VlCoroutineFramePool> t_ownerp{
+            new VlCoroutineFramePool};
+        t_framePoolp = t_ownerp.get();
+    }
+    return t_framePoolp;
+}
+
+VlCoroutineFramePool::~VlCoroutineFramePool() {
+    VL_DEBUG_IF(VL_DBG_MSGF("+ Coroutine frame pool: %" PRIu64 " frames, %" PRIu64
+                            " reused, %" PRIu64 " unpooled, %" PRIu64 " bytes cached\n",
+                            m_stats.m_allocs, m_stats.m_reused, m_stats.m_unpooled,
+                            m_stats.m_cachedBytes););
+    for (FreeFrame* headp : m_freeps) {
+        while (headp) {
+            FreeFrame* const nextp = headp->m_nextp;
+            ::operator delete(headp);
+            headp = nextp;
+        }
+    }
+    t_framePoolp = nullptr;
+    t_framePoolDead = true;
+}
+
+void* VlCoroutineFramePool::allocate(size_t size) {
+    VlCoroutineFramePool* const poolp = threadPoolp();
+    if (VL_UNLIKELY(!poolp)) return ::operator new(size);
+    ++poolp->m_stats.m_allocs;
+    if (VL_UNLIKELY(size > MAX_POOLED)) {
+        ++poolp->m_stats.m_unpooled;
+        return ::operator new(size);
+    }
+    const size_t cls = sizeClass(size);
+    if (FreeFrame* const framep = poolp->m_freeps[cls]) {
+        poolp->m_freeps[cls] = framep->m_nextp;
+        ++poolp->m_stats.m_reused;
+        poolp->m_stats.m_cachedBytes -= (cls + 1) * GRANULE;
+        return framep;
+    }
+    return ::operator new((cls + 1) * GRANULE);
+}
+
+void VlCoroutineFramePool::deallocate(void* ptr, size_t size) {
+    VlCoroutineFramePool* const poolp = t_framePoolp;
+    if (VL_UNLIKELY(!poolp || size > MAX_POOLED)) {
+        ::operator delete(ptr);
+        return;
+    }
+    // The frame may come from another thread's pool; size classes are the same everywhere
+    const size_t cls = sizeClass(size);
+    FreeFrame* const framep = static_cast<FreeFrame*>(ptr);
+    framep->m_nextp = poolp->m_freeps[cls];
+    poolp->m_freeps[cls] = framep;
+    poolp->m_stats.m_cachedBytes += (cls + 1) * GRANULE;
+}
+
+VlCoroutineFramePool::Stats VlCoroutineFramePool::stats() {
+    const VlCoroutineFramePool* const poolp = threadPoolp();
+    return poolp ? poolp->m_stats : Stats{};
+}
+
 //======================================================================
 // VlCoroutine:: Methods
 
@@ -27,6 +27,8 @@
 
 #include "verilated.h"
 
+#include <array>
+#include <map>
 #include <vector>
 
 // clang-format off
@@ -159,20 +161,72 @@ enum class VlDelayPhase : bool { ACTIVE, INACTIVE };
 //=============================================================================
 // VlDelayScheduler stores coroutines to be resumed at a certain simulation time. If the current
 // time is equal to a coroutine's resume time, the coroutine gets resumed.
+//
+// Near future resumptions are kept in a timing wheel with one slot per time unit, covering
+// [m_wheelBase, m_wheelBase + WHEEL_SIZE). Scheduling is an append to a slot, and all
+// coroutines of a slot are resumed as one batch. Later resumptions wait in a time-sorted
+// overflow queue, and move into the wheel as the wheel advances over their time. Within a
+// time slot, coroutines are resumed in the order they were scheduled.
+//
+// It also keeps timers, which replace the coroutines of simple clock generators (periodic
+// timers) and of straight-line delay sequences (one-shot timers, re-armed by each state of the
+// process), see V3Timing. Such a process is an ordinary process triggered by timerDue(), so
+// timers need no coroutine and are never resumed.
 
 class VlDelayScheduler final {
     // TYPES
     // Time-sorted queue of timestamps and handles
     using VlDelayedCoroutineQueue = std::multimap<uint64_t, VlCoroutineHandle>;
+    using VlCoroutineVec = std::vector<VlCoroutineHandle>;
+    static constexpr uint64_t WHEEL_SIZE = 256;  // Slots in wheel, power of two
+    static constexpr uint64_t WHEEL_MASK = WHEEL_SIZE - 1;
+    static constexpr size_t WHEEL_WORDS = WHEEL_SIZE / 64;
+    struct Timer final {
+        uint64_t m_next = 0;  // Time of next firing
+        uint64_t m_period = 0;  // Time between firings, zero if one-shot
+        bool m_active = false;  // Will fire at m_next
+    };
 
     // MEMBERS
     VerilatedContext& m_context;
-    VlDelayedCoroutineQueue m_queue;  // Coroutines to be restored at a certain simulation time
+    std::array<VlCoroutineVec, WHEEL_SIZE> m_wheel;  // Coroutines per time, indexed by time
+    std::array<uint64_t, WHEEL_WORDS> m_wheelUsed{};  // Bit set of non-empty m_wheel slots
+    uint64_t m_wheelBase = 0;  // Earliest time that may be in m_wheel
+    size_t m_wheelCount = 0;  // Number of coroutines in m_wheel
+    VlDelayedCoroutineQueue m_queue;  // Coroutines for times after the wheel
+    VlCoroutineVec m_resumeBatch;  // Slot being resumed. Kept as a field to avoid reallocation.
+    std::vector<Timer> m_timers;  // Timers, indexed by id
+    size_t m_activeTimers = 0;  // Number of active m_timers
     std::vector<VlCoroutineHandle> m_zeroDelayed;  // Coroutines waiting for #0
     std::vector<VlCoroutineHandle> m_zeroDlyResumed;  // Coroutines that waited for #0 and are
                                                       // to be resumed. Kept as a field to avoid
                                                       // reallocation.
 
+    // METHODS
+    // Earliest time of a delayed coroutine (there must be one)
+    uint64_t earliestTime() const;
+    // Move the wheel to start at the given time, pulling in coroutines from m_queue
+    void advanceWheel(uint64_t time);
+    void schedule(uint64_t time, VlCoroutineHandle&& handle) {
+        if (time - m_wheelBase < WHEEL_SIZE) {
+            const size_t slot = time & WHEEL_MASK;
+            m_wheel[slot].emplace_back(std::move(handle));
+            m_wheelUsed[slot / 64] |= 1ULL << (slot % 64);
+            ++m_wheelCount;
+        } else {
+            m_queue.emplace(time, std::move(handle));
+        }
+    }
+    bool delayedEmpty() const { return !m_wheelCount && m_queue.empty(); }
+    void setTimer(uint32_t id, uint64_t delay, uint64_t period) {
+        if (id >= m_timers.size()) m_timers.resize(id + 1);
+        Timer& timer = m_timers[id];
+        if (!timer.m_active) ++m_activeTimers;
+        timer.m_next = m_context.time() + delay;
+        timer.m_period = period;
+        timer.m_active = true;
+    }
+
 public:
     // CONSTRUCTORS
     explicit VlDelayScheduler(VerilatedContext& context)
@@ -184,22 +238,41 @@ public:
     // coroutines)
     uint64_t nextTimeSlot() const;
     // Are there no delayed coroutines awaiting?
-    bool empty() const { return m_queue.empty() && m_zeroDelayed.empty(); }
+    bool empty() const {
+        return delayedEmpty() && m_zeroDelayed.empty() && !m_activeTimers;
+    }
     // Are there coroutines to resume at the current simulation time?
     bool awaitingCurrentTime() const {
-        return (!m_queue.empty() && (m_queue.cbegin()->first <= m_context.time()))
+        return (!delayedEmpty() && (earliestTime() <= m_context.time()))
                || !m_zeroDelayed.empty();
     }
 #ifdef VL_DEBUG
     void dump() const;
 #endif
+    // Start timer 'id' firing every 'period', first 'period' after the current time
+    void addPeriodic(uint32_t id, uint64_t period) { setTimer(id, period, period); }
+    // Start timer 'id' firing once, 'delay' after the current time
+    void addTimeout(uint32_t id, uint64_t delay) { setTimer(id, delay, 0); }
+    // Is timer 'id' due at the current time? Consumes the firing, so called once per
+    // trigger evaluation
+    bool timerDue(uint32_t id) {
+        if (VL_UNLIKELY(id >= m_timers.size())) return false;
+        Timer& timer = m_timers[id];
+        if (!timer.m_active || timer.m_next > m_context.time()) return false;
+        if (timer.m_period) {
+            timer.m_next += timer.m_period;
+        } else {
+            timer.m_active = false;
+            --m_activeTimers;
+        }
+        return true;
+    }
     // Used by coroutines for co_awaiting a certain simulation time
     auto delay(uint64_t delay, VlProcessRef process, const char* filename = VL_UNKNOWN,
                int lineno = 0) {
         struct Awaitable final {
             VlProcessRef process;  // Data of the suspended process, null if not needed
-            VlDelayedCoroutineQueue& queue;
-            std::vector<VlCoroutineHandle>& queueZeroDelay;
+            VlDelayScheduler& sched;
             const uint64_t delay;
             const VlDelayPhase phase;
             const VlFileLineDebug fileline;
@@ -207,9 +280,9 @@ public:
             bool await_ready() const { return false; }  // Always suspend
             void await_suspend(std::coroutine_handle<> coro) {
                 if (phase == VlDelayPhase::ACTIVE) {
-                    queue.emplace(delay, VlCoroutineHandle{coro, process, fileline});
+                    sched.schedule(delay, VlCoroutineHandle{coro, process, fileline});
                 } else {
-                    queueZeroDelay.emplace_back(VlCoroutineHandle{coro, process, fileline});
+                    sched.m_zeroDelayed.emplace_back(VlCoroutineHandle{coro, process, fileline});
                 }
             }
             void await_resume() const {}
@@ -224,9 +297,8 @@ public:
         }
 #endif
 
-        return Awaitable{process,       m_queue,
-                         m_zeroDelayed, m_context.time() + delay,
-                         phase,         VlFileLineDebug{filename, lineno}};
+        return Awaitable{process, *this, m_context.time() + delay, phase,
+                         VlFileLineDebug{filename, lineno}};
     }
 };
 
@@ -251,12 +323,24 @@ class VlTriggerScheduler final {
                                    // m_resumeQueue to allow adding coroutines to m_ready
                                    // during resume(). Outside of resume() should always be empty.
 
-public:
     // METHODS
+    void resumeSlow(const char* eventDescription);
+    void commitSlow(const char* eventDescription);
+
+public:
     // Resumes all coroutines from the 'ready' stage
-    void resume(const char* eventDescription = VL_UNKNOWN);
+    void resume(const char* eventDescription = VL_UNKNOWN) {
+        // Called for every fired trigger, and often nothing is waiting
+        VL_DEBUG_IF(resumeSlow(eventDescription); return;);
+        if (VL_LIKELY(empty())) return;
+        resumeSlow(eventDescription);
+    }
     // Moves all coroutines from m_uncommitted to m_ready
-    void commit(const char* eventDescription = VL_UNKNOWN);
+    void commit(const char* eventDescription = VL_UNKNOWN) {
+        // Called for every trigger not fired in an iteration, usually nothing is uncommitted
+        if (VL_LIKELY(m_uncommitted.empty())) return;
+        commitSlow(eventDescription);
+    }
     // Are there no coroutines awaiting?
     bool empty() const { return m_ready.empty() && m_uncommitted.empty(); }
 #ifdef VL_DEBUG
@@ -329,15 +413,29 @@ class VlDynamicTriggerScheduler final {
         return Awaitable{process, queue, VlFileLineDebug{filename, lineno}};
     }
 
+    bool evaluateSlow();
+    void doPostUpdatesSlow();
+    void resumeSlow();
+
 public:
     // Evaluates all dynamic triggers (resumed coroutines that co_await evaluation())
-    bool evaluate();
+    bool evaluate() {
+        VL_DEBUG_IF(return evaluateSlow(););
+        if (VL_LIKELY(m_suspended.empty())) return false;
+        return evaluateSlow();
+    }
     // Called by coroutines that evaluate triggers to notify the scheduler if any triggers were set
     void anyTriggered(bool triggered) { m_anyTriggered = m_anyTriggered || triggered; }
     // Runs post updates for all dynamic triggers (resumes coroutines that co_await postUpdate())
-    void doPostUpdates();
+    void doPostUpdates() {
+        if (VL_LIKELY(m_post.empty())) return;
+        doPostUpdatesSlow();
+    }
     // Resumes all coroutines whose triggers are set (those that co_await resumption())
-    void resume();
+    void resume() {
+        if (VL_LIKELY(m_triggered.empty())) return;
+        resumeSlow();
+    }
 #ifdef VL_DEBUG
     void dump() const;
 #endif
@@ -415,6 +513,47 @@ public:
     }
 };
 
+//=============================================================================
+// VlCoroutineFramePool
+// Allocator for coroutine frames. Each thread keeps free lists of frames by size class (a
+// multiple of GRANULE bytes), so calling a suspendable task reuses a frame of a previously
+// finished call instead of going to malloc. Frames larger than MAX_POOLED use operator new.
+
+class VlCoroutineFramePool final {
+public:
+    // TYPES
+    struct Stats final {
+        uint64_t m_allocs = 0;  // Frames allocated
+        uint64_t m_reused = 0;  // Frames allocated from a free list
+        uint64_t m_unpooled = 0;  // Frames too large for pooling
+        uint64_t m_cachedBytes = 0;  // Bytes currently held in the free lists
+    };
+
+private:
+    static constexpr size_t GRANULE = 64;  // Size class granularity in bytes
+    static constexpr size_t MAX_POOLED = 4096;  // Largest pooled frame in bytes
+    static constexpr size_t NUM_CLASSES = MAX_POOLED / GRANULE;
+    struct FreeFrame final {
+        FreeFrame* m_nextp;  // Next free frame of same size class
+    };
+
+    // MEMBERS
+    std::array<FreeFrame*, NUM_CLASSES> m_freeps{};  // Free list heads by size class
+    Stats m_stats;  // Statistics for this thread
+
+    // METHODS
+    static VlCoroutineFramePool* threadPoolp();
+    static size_t sizeClass(size_t size) { return (size - 1) / GRANULE; }
+
+public:
+    ~VlCoroutineFramePool();
+    // Allocate/free a frame of the given size, using the calling thread's pool
+    static void* allocate(size_t size);
+    static void deallocate(void* ptr, size_t size);
+    // Statistics of the calling thread's pool
+    static Stats stats();
+};
+
 //=============================================================================
 // VlCoroutine
 // Return value of a coroutine. Used for chaining coroutine suspension/resumption.
@@ -428,6 +567,12 @@ private:
 
         ~VlPromise();
 
+        // Coroutine frames come from the frame pool
+        static void* operator new(size_t size) { return VlCoroutineFramePool::allocate(size); }
+        static void operator delete(void* ptr, size_t size) {
+            VlCoroutineFramePool::deallocate(ptr, size);
+        }
+
         VlCoroutine get_return_object() { return {this}; }
 
         // Never suspend at the start of the coroutine
@@ -26,6 +26,8 @@
 
 #include "verilated.h"
 
+#include <array>
+#include <atomic>
 #include <bitset>
 #include <condition_variable>
 #include <memory>
@@ -98,47 +100,62 @@ enum class VerilatedTraceSigType : uint8_t {
 //=============================================================================
 // Offloaded tracing
 
-// A simple synchronized first in first out queue
-template <typename T>
-class VerilatedThreadQueue final {  // LCOV_EXCL_LINE  // lcov bug
-private:
-    mutable VerilatedMutex m_mutex;  // Protects m_queue
+// A lock-free, fixed capacity, single producer single consumer first in first
+// out queue. A consumer finding the queue empty spins for a while, then parks
+// on a condition variable. The producer only takes the lock when the consumer
+// is parked, so in steady state neither side makes a system call.
+template <typename T, size_t N_Capacity>
+class VerilatedSpscQueue final {  // LCOV_EXCL_LINE  // lcov bug
+    static_assert((N_Capacity & (N_Capacity - 1)) == 0, "Capacity must be a power of 2");
+    static constexpr size_t MASK = N_Capacity - 1;
+
+    std::array<T, N_Capacity> m_ring;  // Elements, indexed by position modulo capacity
+    // Head and tail on separate cache lines, so the two sides do not contend
+    alignas(VL_CACHE_LINE_BYTES) std::atomic<size_t> m_head{0};  // Next read, by consumer
+    alignas(VL_CACHE_LINE_BYTES) std::atomic<size_t> m_tail{0};  // Next write, by producer
+    std::atomic<bool> m_parked{false};  // Consumer is waiting on m_cv
+    mutable VerilatedMutex m_mutex;  // Protects parking of the consumer
     std::condition_variable_any m_cv;
-    std::deque<T> m_queue VL_GUARDED_BY(m_mutex);
 
 public:
-    // Put an element at the back of the queue
+    // Put an element at the back of the queue. Producer only. The caller must
+    // guarantee the queue can never hold more than N_Capacity elements.
     void put(T value) VL_MT_SAFE_EXCLUDES(m_mutex) {
-        const VerilatedLockGuard lock{m_mutex};
-        m_queue.push_back(value);
-        m_cv.notify_one();
+        const size_t tail = m_tail.load(std::memory_order_relaxed);
+        assert(tail - m_head.load(std::memory_order_acquire) < N_Capacity);
+        m_ring[tail & MASK] = value;
+        // Sequentially consistent with m_parked, so either the consumer sees
+        // the element, or we see the consumer is parked
+        m_tail.store(tail + 1, std::memory_order_seq_cst);
+        if (VL_UNLIKELY(m_parked.load(std::memory_order_seq_cst))) {
+            const VerilatedLockGuard lock{m_mutex};
+            m_cv.notify_one();
+        }
     }
 
-    // Put an element at the front of the queue
-    void put_front(T value) VL_MT_SAFE_EXCLUDES(m_mutex) {
-        const VerilatedLockGuard lock{m_mutex};
-        m_queue.push_front(value);
-        m_cv.notify_one();
+    // Non blocking get. Consumer only.
+    bool tryGet(T& result) {
+        const size_t head = m_head.load(std::memory_order_relaxed);
+        if (head == m_tail.load(std::memory_order_acquire)) return false;
+        result = m_ring[head & MASK];
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
     }
 
-    // Get an element from the front of the queue. Blocks if none available
+    // Get an element from the front of the queue. Blocks if none available.
+    // Consumer only.
     T get() VL_MT_SAFE_EXCLUDES(m_mutex) {
+        T value;
+        for (unsigned i = 0; i < VL_LOCK_SPINS; ++i) {
+            if (tryGet(value)) return value;
+            VL_CPU_RELAX();
+        }
         VerilatedLockGuard lock{m_mutex};
-        m_cv.wait(m_mutex, [this]() VL_REQUIRES(m_mutex) { return !m_queue.empty(); });
-        assert(!m_queue.empty());
-        T value = m_queue.front();
-        m_queue.pop_front();
+        m_parked.store(true, std::memory_order_seq_cst);
+        m_cv.wait(m_mutex, [&]() { return tryGet(value); });
+        m_parked.store(false, std::memory_order_relaxed);
         return value;
     }
-
-    // Non blocking get
-    bool tryGet(T& result) VL_MT_SAFE_EXCLUDES(m_mutex) {
-        const VerilatedLockGuard lockGuard{m_mutex};
-        if (m_queue.empty()) return false;
-        result = m_queue.front();
-        m_queue.pop_front();
-        return true;
-    }
 };
 
 // Commands used by thread tracing. Anonymous enum in class, as we want
@@ -155,6 +172,7 @@ public:
         CHG_IDATA = 0x4,
         CHG_QDATA = 0x5,
         CHG_WDATA = 0x6,
+        CHG_RUN = 0x7,  // Values of signals with consecutive codes, one word each
         CHG_DOUBLE = 0x8,
         CHG_EVENT = 0x9,
         // TODO: full..
@@ -190,6 +208,10 @@ class VerilatedTraceBaseC VL_NOT_FINAL {
 public:
     /// True if file currently open
     virtual bool isOpen() const VL_MT_SAFE = 0;
+    /// Trace only signals under the given scopes. 'scopes' is a list of
+    /// hierarchical scope names separated by commas or spaces, which may use
+    /// '*' and '?' wildcards. Empty traces everything. Call before open().
+    virtual void traceScopes(const std::string& scopes) VL_MT_SAFE = 0;
 
     // internal use only
     bool modelConnected() const VL_MT_SAFE { return m_modelConnected; }
@@ -259,6 +281,7 @@ private:
         mutable VerilatedMutex m_mutex;  // Mutex for suspension until ready
         std::condition_variable_any m_cv;  // Condition variable for suspension
         bool m_waiting VL_GUARDED_BY(m_mutex) = false;  // Whether a thread is suspended in wait()
+        std::vector<uint32_t> m_record;  // Changes recorded by the callback, if flight recording
 
         void wait();
 
@@ -274,6 +297,7 @@ private:
 protected:
     uint32_t* m_sigs_oldvalp = nullptr;  // Previous value store
     EData* m_sigs_enabledp = nullptr;  // Bit vector of enabled codes (nullptr = all on)
+    uint32_t* m_sigs_enabledCountp = nullptr;  // Number of enabled codes before index
 private:
     std::vector<bool> m_sigs_enabledVec;  // Staging for m_sigs_enabledp
     std::vector<CallbackRecord> m_initCbs;  // Routines to initialize tracing
@@ -291,6 +315,8 @@ private:
     uint32_t m_maxBits = 0;  // Number of bits in the widest signal
     // TODO: Should keep this as a Trie, that is how it's accessed all the time.
     std::vector<std::pair<int, std::string>> m_dumpvars;  // dumpvar() entries
+    std::vector<std::string> m_traceScopes;  // traceScopes() entries
+    std::string m_declName;  // Buffer reused by declName()
     double m_timeRes = 1e-9;  // Time resolution (ns/ms etc)
     double m_timeUnit = 1e-0;  // Time units (ns/ms etc)
     uint64_t m_timeLastDump = 0;  // Last time we did a dump
@@ -298,6 +324,19 @@ private:
     VerilatedContext* m_contextp = nullptr;  // The context used by the traced models
     std::set<const VerilatedModel*> m_models;  // The collection of models being traced
 
+    // Flight recorder, see flightRecorder(). Dumps are recorded in memory in
+    // the offload command format, into two alternating segments, each
+    // starting with a full dump, so the older one always holds a full value
+    // snapshot followed by at least m_flightCycles dumps of changes.
+    uint64_t m_flightCycles = 0;  // Number of dumps to retain, 0 = flight recorder off
+    uint64_t m_flightDumps = 0;  // Number of dumps recorded in current segment
+    bool m_flightRecording = false;  // Recording, and not yet triggered
+    uint32_t m_flightDumpon = 0;  // Context's dumponCount() when recording started
+    unsigned m_flightCur = 0;  // Index of the current segment
+    std::vector<uint32_t> m_flightSegments[2];  // Recorded dumps
+    std::vector<uint32_t> m_flightConsts;  // Recorded constant dump
+    std::vector<uint32_t>* m_recordp = nullptr;  // Where the callbacks record, if recording
+
     void addCallbackRecord(std::vector<CallbackRecord>& cbVec, CallbackRecord&& cbRec)
         VL_MT_SAFE_EXCLUDES(m_mutex);
 
@@ -308,19 +347,31 @@ private:
     void runCallbacks(const std::vector<CallbackRecord>& cbVec);
     void runOffloadedCallbacks(const std::vector<CallbackRecord>& cbVec);
 
+    // Record a dump into the flight recorder, instead of emitting it
+    void flightRecordDump(uint64_t timeui);
+    // Emit the contents of the flight recorder, and stop recording
+    void flightRecorderWrite();
+    // Emit one recorded change, return the next one
+    const uint32_t* flightReplay(Buffer* bufp, const uint32_t* readp);
+
     // Flush any remaining data for this file
     static void onFlush(void* selfp) VL_MT_UNSAFE_ONE;
     // Close the file on termination
     static void onExit(void* selfp) VL_MT_UNSAFE_ONE;
 
+    // Maximum number of offload buffers allocated. Some jitter is expected, so
+    // some number of alternative offload buffers are required.
+    static constexpr uint32_t MAX_OFFLOAD_BUFFERS = 8;
     // Number of total offload buffers that have been allocated
     uint32_t m_numOffloadBuffers = 0;
     // Size of offload buffers
     size_t m_offloadBufferSize = 0;
     // Buffers handed to worker for processing
-    VerilatedThreadQueue<uint32_t*> m_offloadBuffersToWorker;
+    VerilatedSpscQueue<uint32_t*, MAX_OFFLOAD_BUFFERS> m_offloadBuffersToWorker;
     // Buffers returned from worker after processing
-    VerilatedThreadQueue<uint32_t*> m_offloadBuffersFromWorker;
+    VerilatedSpscQueue<uint32_t*, MAX_OFFLOAD_BUFFERS> m_offloadBuffersFromWorker;
+    // Buffers already taken back from the worker, but not yet reused
+    std::vector<uint32_t*> m_offloadBuffersFree;
 
 protected:
     // Write pointer into current buffer
@@ -367,6 +418,8 @@ protected:
 
     // Declare new signal and return true if enabled
     bool declCode(uint32_t code, const std::string& declName, uint32_t bits);
+    // True if signal is under a traceScopes() scope
+    bool traceScopeMatch(const std::string& declName) const;
 
     void closeBase();
     void flushBase();
@@ -380,6 +433,18 @@ protected:
         if (idx == std::string::npos) return str;
         return str.substr(idx + 1);
     }
+    // As lastWord, but points into 'str' instead of copying
+    static const char* lastWordp(const std::string& str) {
+        const size_t idx = str.rfind(' ');
+        return str.c_str() + (idx == std::string::npos ? 0 : idx + 1);
+    }
+    // Hierarchical name of signal 'name' under 'prefix'. Returns a buffer that is
+    // reused by the next call, so there is no allocation per declared signal.
+    const std::string& declName(const std::string& prefix, const char* name) {
+        m_declName.assign(prefix);
+        m_declName.append(name);
+        return m_declName;
+    }
 
     //=========================================================================
     // Virtual functions to be provided by the format-specific implementation
@@ -415,10 +480,19 @@ public:
     // Set variables to dump, using $dumpvars format
     // If level = 0, dump everything and hier is then ignored
     void dumpvars(int level, const std::string& hier) VL_MT_SAFE;
+    // Set scopes to dump, see VerilatedTraceBaseC::traceScopes
+    void traceScopes(const std::string& scopes) VL_MT_SAFE;
 
     // Call
     void dump(uint64_t timeui) VL_MT_SAFE_EXCLUDES(m_mutex);
 
+    // Flight recorder: keep only the last 'cycles' (or more) dumps in memory,
+    // and write them out, starting with a full dump, when triggered by
+    // flightRecorderTrigger() or $dumpon. Must be called before open().
+    void flightRecorder(uint64_t cycles) VL_MT_SAFE_EXCLUDES(m_mutex);
+    // Write the flight recorder contents, then continue dumping as normal
+    void flightRecorderTrigger() VL_MT_SAFE_EXCLUDES(m_mutex);
+
     //=========================================================================
     // Internal interface to Verilator generated code
 
@@ -452,10 +526,16 @@ protected:
     static_assert(std::is_base_of<VerilatedTrace<Trace, T_Buffer>, Trace>::value, "");
 
     friend Trace;  // Give the trace file access to the private bits
+    friend VerilatedTrace<Trace, T_Buffer>;
     friend std::default_delete<VerilatedTraceBuffer<T_Buffer>>;
 
     uint32_t* const m_sigs_oldvalp;  // Previous value store
     EData* const m_sigs_enabledp;  // Bit vector of enabled codes (nullptr = all on)
+    const uint32_t* const m_sigs_enabledCountp;  // Number of enabled codes before index
+    std::vector<uint32_t>* m_recordp = nullptr;  // Flight recorder record, if recording
+
+    // Record a change into m_recordp, as an offload command with 'words' of value
+    void record(uint32_t cmd, uint32_t code, const void* valp, int words);
 
     explicit VerilatedTraceBuffer(Trace& owner);
     ~VerilatedTraceBuffer() override = default;
@@ -480,6 +560,13 @@ public:
 
     VL_ATTR_ALWINLINE uint32_t* oldp(uint32_t code) { return m_sigs_oldvalp + code; }
 
+    // True if any signal with its first code in [lo, hi) is enabled,
+    // used to skip trace sub-functions covering only excluded scopes
+    VL_ATTR_ALWINLINE bool anyEnabled(uint32_t lo, uint32_t hi) const {
+        if (VL_LIKELY(!m_sigs_enabledCountp)) return true;
+        return m_sigs_enabledCountp[hi] != m_sigs_enabledCountp[lo];
+    }
+
     // Write to previous value buffer value and emit trace entry.
     void fullBit(uint32_t* oldp, CData newval);
     void fullCData(uint32_t* oldp, CData newval, int bits);
@@ -550,43 +637,83 @@ class VerilatedTraceOffloadBuffer final : public VerilatedTraceBuffer<T_Buffer>
 
     uint32_t* m_offloadBufferWritep;  // Write pointer into current buffer
     uint32_t* const m_offloadBufferEndp;  // End of offload buffer
+    uint32_t* m_runp = nullptr;  // Last single word command, or CHG_RUN it was turned into
+    uint32_t m_runNextCode = 0;  // Code that would continue m_runp, 0 if none
+    int m_runBits = 0;  // Width of signals in m_runp, 0 for chgBit
 
     explicit VerilatedTraceOffloadBuffer(Trace& owner);
     ~VerilatedTraceOffloadBuffer() override = default;
 
+    // Signals that fit in one word and have consecutive codes are usually
+    // declared next to each other. If this signal continues the previous
+    // command, append only its value, turning that command into a CHG_RUN:
+    // [CHG_RUN | bits << 4 | count << 16][first code][value 0]...[value count-1]
+    // This leaves little more than a copy of the traced values to the eval
+    // thread, with the comparisons against the previous values, and the
+    // formatting, done by the worker thread.
+    VL_ATTR_ALWINLINE bool runAppend(uint32_t code, uint32_t value, int bits) {
+        if (code != m_runNextCode || bits != m_runBits) return false;
+        if (VL_UNLIKELY(m_runp[0] >= (0xffffU << 16))) return false;  // Count would overflow
+        if ((m_runp[0] & 0xf) != VerilatedTraceOffloadCommand::CHG_RUN) {
+            // Single bits carry the value in the command, move it after the code
+            if (bits == 0) *m_offloadBufferWritep++ = m_runp[0] & 1;
+            m_runp[0] = (1 << 16) | (bits << 4) | VerilatedTraceOffloadCommand::CHG_RUN;
+        }
+        m_runp[0] += 1 << 16;
+        *m_offloadBufferWritep++ = value;
+        ++m_runNextCode;
+        VL_DEBUG_IF(assert(m_offloadBufferWritep <= m_offloadBufferEndp););
+        return true;
+    }
+    // Note a single word command was written at 'm_offloadBufferWritep - words'
+    VL_ATTR_ALWINLINE void runStart(uint32_t code, int bits, int words) {
+        m_runp = m_offloadBufferWritep - words;
+        m_runNextCode = code + 1;
+        m_runBits = bits;
+    }
+
 public:
     //=========================================================================
     // Hot path internal interface to Verilator generated code
 
     // Offloaded tracing. Just dump everything in the offload buffer
     void chgBit(uint32_t code, CData newval) {
+        if (runAppend(code, newval, 0)) return;
         m_offloadBufferWritep[0] = VerilatedTraceOffloadCommand::CHG_BIT_0 | newval;
         m_offloadBufferWritep[1] = code;
         m_offloadBufferWritep += 2;
+        runStart(code, 0, 2);
         VL_DEBUG_IF(assert(m_offloadBufferWritep <= m_offloadBufferEndp););
     }
     void chgCData(uint32_t code, CData newval, int bits) {
+        if (runAppend(code, newval, bits)) return;
         m_offloadBufferWritep[0] = (bits << 4) | VerilatedTraceOffloadCommand::CHG_CDATA;
         m_offloadBufferWritep[1] = code;
         m_offloadBufferWritep[2] = newval;
         m_offloadBufferWritep += 3;
+        runStart(code, bits, 3);
         VL_DEBUG_IF(assert(m_offloadBufferWritep <= m_offloadBufferEndp););
     }
     void chgSData(uint32_t code, SData newval, int bits) {
+        if (runAppend(code, newval, bits)) return;
         m_offloadBufferWritep[0] = (bits << 4) | VerilatedTraceOffloadCommand::CHG_SDATA;
         m_offloadBufferWritep[1] = code;
         m_offloadBufferWritep[2] = newval;
         m_offloadBufferWritep += 3;
+        runStart(code, bits, 3);
         VL_DEBUG_IF(assert(m_offloadBufferWritep <= m_offloadBufferEndp););
     }
     void chgIData(uint32_t code, IData newval, int bits) {
+        if (runAppend(code, newval, bits)) return;
         m_offloadBufferWritep[0] = (bits << 4) | VerilatedTraceOffloadCommand::CHG_IDATA;
         m_offloadBufferWritep[1] = code;
         m_offloadBufferWritep[2] = newval;
         m_offloadBufferWritep += 3;
+        runStart(code, bits, 3);
         VL_DEBUG_IF(assert(m_offloadBufferWritep <= m_offloadBufferEndp););
     }
     void chgQData(uint32_t code, QData newval, int bits) {
+        m_runNextCode = 0;
         m_offloadBufferWritep[0] = (bits << 4) | VerilatedTraceOffloadCommand::CHG_QDATA;
         m_offloadBufferWritep[1] = code;
         *reinterpret_cast<QData*>(m_offloadBufferWritep + 2) = newval;
@@ -594,6 +721,7 @@ public:
         VL_DEBUG_IF(assert(m_offloadBufferWritep <= m_offloadBufferEndp););
     }
     void chgWData(uint32_t code, const WData* newvalp, int bits) {
+        m_runNextCode = 0;
         m_offloadBufferWritep[0] = (bits << 4) | VerilatedTraceOffloadCommand::CHG_WDATA;
         m_offloadBufferWritep[1] = code;
         m_offloadBufferWritep += 2;
@@ -601,6 +729,7 @@ public:
         VL_DEBUG_IF(assert(m_offloadBufferWritep <= m_offloadBufferEndp););
     }
     void chgDouble(uint32_t code, double newval) {
+        m_runNextCode = 0;
         m_offloadBufferWritep[0] = VerilatedTraceOffloadCommand::CHG_DOUBLE;
         m_offloadBufferWritep[1] = code;
         // cppcheck-suppress invalidPointerCast
@@ -612,6 +741,7 @@ public:
         if (newvalp->isTriggered()) chgEventTriggered(code);
     }
     void chgEventTriggered(uint32_t code) {
+        m_runNextCode = 0;
         m_offloadBufferWritep[0] = VerilatedTraceOffloadCommand::CHG_EVENT;
         m_offloadBufferWritep[1] = code;
         m_offloadBufferWritep += 2;
@@ -66,9 +66,10 @@ static double timescaleToDouble(const char* unitp) VL_PURE {
 template <>
 uint32_t* VerilatedTrace<VL_SUB_T, VL_BUF_T>::getOffloadBuffer() {
     uint32_t* bufferp;
-    // Some jitter is expected, so some number of alternative offload buffers are
-    // required, but don't allocate more than 8 buffers.
-    if (m_numOffloadBuffers < 8) {
+    if (!m_offloadBuffersFree.empty()) {
+        bufferp = m_offloadBuffersFree.back();
+        m_offloadBuffersFree.pop_back();
+    } else if (m_numOffloadBuffers < MAX_OFFLOAD_BUFFERS) {
         // Allocate a new buffer if none is available
         if (!m_offloadBuffersFromWorker.tryGet(bufferp)) {
             ++m_numOffloadBuffers;
@@ -86,14 +87,13 @@ uint32_t* VerilatedTrace<VL_SUB_T, VL_BUF_T>::getOffloadBuffer() {
 template <>
 void VerilatedTrace<VL_SUB_T, VL_BUF_T>::waitForOffloadBuffer(const uint32_t* buffp) {
     // Slow path code only called on flush/shutdown, so use a simple algorithm.
-    // Collect buffers from worker and stash them until we get the one we want.
-    std::deque<uint32_t*> stash;
-    do { stash.push_back(m_offloadBuffersFromWorker.get()); } while (stash.back() != buffp);
-    // Now put them back in the queue, in the original order.
-    while (!stash.empty()) {
-        m_offloadBuffersFromWorker.put_front(stash.back());
-        stash.pop_back();
-    }
+    // Collect buffers from worker until we get the one we want. As processing
+    // is in-order, the buffers collected on the way are all free for reuse.
+    uint32_t* bufferp;
+    do {
+        bufferp = m_offloadBuffersFromWorker.get();
+        m_offloadBuffersFree.push_back(bufferp);
+    } while (bufferp != buffp);
 }
 
 //=========================================================================
@@ -151,6 +151,29 @@ void VerilatedTrace<VL_SUB_T, VL_BUF_T>::offloadWorkerThreadMain() {
                 traceBufp->chgIData(oldp, *readp, top);
                 readp += 1;
                 continue;
+            case VerilatedTraceOffloadCommand::CHG_RUN: {
+                // Bits in bits 4-15 of command (0 for single bits), count in the top half
+                const int bits = static_cast<int>(top & 0xfff);
+                const uint32_t count = cmd >> 16;
+                VL_TRACE_OFFLOAD_DEBUG("Command CHG_RUN " << bits << " x " << count);
+                if (bits == 0) {
+                    for (uint32_t i = 0; i < count; ++i) traceBufp->chgBit(oldp + i, readp[i]);
+                } else if (bits <= VL_BYTESIZE) {
+                    for (uint32_t i = 0; i < count; ++i) {
+                        traceBufp->chgCData(oldp + i, readp[i], bits);
+                    }
+                } else if (bits <= VL_SHORTSIZE) {
+                    for (uint32_t i = 0; i < count; ++i) {
+                        traceBufp->chgSData(oldp + i, readp[i], bits);
+                    }
+                } else {
+                    for (uint32_t i = 0; i < count; ++i) {
+                        traceBufp->chgIData(oldp + i, readp[i], bits);
+                    }
+                }
+                readp += count;
+                continue;
+            }
             case VerilatedTraceOffloadCommand::CHG_QDATA:
                 VL_TRACE_OFFLOAD_DEBUG("Command CHG_QDATA " << top);
                 // Bits stored in bottom byte of command
@@ -243,10 +266,17 @@ void VerilatedTrace<VL_SUB_T, VL_BUF_T>::shutdownOffloadWorker() {
 
 template <>
 void VerilatedTrace<VL_SUB_T, VL_BUF_T>::closeBase() {
+    // Never triggered flight recordings are discarded
+    m_flightRecording = false;
     if (offload()) {
         shutdownOffloadWorker();
         while (m_numOffloadBuffers) {
-            delete[] m_offloadBuffersFromWorker.get();
+            if (!m_offloadBuffersFree.empty()) {
+                delete[] m_offloadBuffersFree.back();
+                m_offloadBuffersFree.pop_back();
+            } else {
+                delete[] m_offloadBuffersFromWorker.get();
+            }
             --m_numOffloadBuffers;
         }
     }
@@ -293,6 +323,9 @@ template <>
 VerilatedTrace<VL_SUB_T, VL_BUF_T>::~VerilatedTrace() {
     if (m_sigs_oldvalp) VL_DO_CLEAR(delete[] m_sigs_oldvalp, m_sigs_oldvalp = nullptr);
     if (m_sigs_enabledp) VL_DO_CLEAR(delete[] m_sigs_enabledp, m_sigs_enabledp = nullptr);
+    if (m_sigs_enabledCountp) {
+        VL_DO_CLEAR(delete[] m_sigs_enabledCountp, m_sigs_enabledCountp = nullptr);
+    }
     Verilated::removeFlushCb(VerilatedTrace<VL_SUB_T, VL_BUF_T>::onFlush, this);
     Verilated::removeExitCb(VerilatedTrace<VL_SUB_T, VL_BUF_T>::onExit, this);
     if (offload()) closeBase();
@@ -328,19 +361,30 @@ void VerilatedTrace<VL_SUB_T, VL_BUF_T>::traceInit() VL_MT_UNSAFE {
 
     // Apply enables
     if (m_sigs_enabledp) VL_DO_CLEAR(delete[] m_sigs_enabledp, m_sigs_enabledp = nullptr);
-    if (!m_sigs_enabledVec.empty()) {
-        // Else if was empty, m_sigs_enabledp = nullptr to short circuit tests
+    if (m_sigs_enabledCountp) {
+        VL_DO_CLEAR(delete[] m_sigs_enabledCountp, m_sigs_enabledCountp = nullptr);
+    }
+    if (!m_dumpvars.empty() || !m_traceScopes.empty()) {
+        // Else m_sigs_enabledp = nullptr to short circuit tests
         // But it isn't, so alloc one bit for each code to indicate enablement
         // We don't want to still use m_signs_enabledVec as std::vector<bool> is not
         // guaranteed to be fast
-        m_sigs_enabledp = new uint32_t[1 + VL_WORDS_I(nextCode())]{0};
-        m_sigs_enabledVec.reserve(nextCode());
+        const uint32_t words = VL_WORDS_I(nextCode());
+        m_sigs_enabledp = new uint32_t[1 + words]{0};
+        m_sigs_enabledVec.resize(nextCode());
         for (size_t code = 0; code < nextCode(); ++code) {
             if (m_sigs_enabledVec[code]) {
                 m_sigs_enabledp[VL_BITWORD_I(code)] |= 1U << VL_BITBIT_I(code);
             }
         }
         m_sigs_enabledVec.clear();
+        // Running count of enabled codes, so Buffer::anyEnabled is O(1)
+        m_sigs_enabledCountp = new uint32_t[1 + nextCode()];
+        m_sigs_enabledCountp[0] = 0;
+        for (uint32_t code = 0; code < nextCode(); ++code) {
+            m_sigs_enabledCountp[code + 1]
+                = m_sigs_enabledCountp[code] + (VL_BITISSET_W(m_sigs_enabledp, code) ? 1 : 0);
+        }
     }
 
     // Set callback so flush/abort will flush this file
@@ -359,6 +403,54 @@ void VerilatedTrace<VL_SUB_T, VL_BUF_T>::traceInit() VL_MT_UNSAFE {
         m_workerThread.reset(
             new std::thread{&VerilatedTrace<VL_SUB_T, VL_BUF_T>::offloadWorkerThreadMain, this});
     }
+
+    if (m_flightCycles) {
+        if (offload()) {
+            VL_FATAL_MT(__FILE__, __LINE__, "",
+                        "Flight recorder tracing is not supported with offloaded tracing");
+        }
+        m_flightRecording = true;
+        m_flightDumps = 0;
+        m_flightCur = 0;
+        for (std::vector<uint32_t>& segment : m_flightSegments) segment.clear();
+        m_flightConsts.clear();
+        m_flightDumpon = m_contextp ? m_contextp->dumponCount() : 0;
+    }
+}
+
+template <>
+bool VerilatedTrace<VL_SUB_T, VL_BUF_T>::traceScopeMatch(const std::string& declName) const {
+    // Wildcard match, '*' matches any string including separators
+    const auto globMatch = [](const char* gp, const char* sp, const char* endp) {
+        const char* starGp = nullptr;
+        const char* starSp = nullptr;
+        while (sp != endp) {
+            if (*gp == '*') {
+                starGp = ++gp;
+                starSp = sp;
+            } else if (*gp && (*gp == '?' || *gp == *sp)) {
+                ++gp;
+                ++sp;
+            } else if (starGp) {
+                gp = starGp;
+                sp = ++starSp;
+            } else {
+                return false;
+            }
+        }
+        while (*gp == '*') ++gp;
+        return !*gp;
+    };
+    // A signal is under a scope if the scope matches the signal's name, or
+    // the name of any of the scopes containing the signal
+    const char* const namep = declName.c_str();
+    const char* const endp = namep + declName.size();
+    for (const std::string& glob : m_traceScopes) {
+        for (const char* sp = namep; sp <= endp; ++sp) {
+            if ((sp == endp || *sp == ' ') && globMatch(glob.c_str(), namep, sp)) return true;
+        }
+    }
+    return false;
 }
 
 template <>
@@ -385,12 +477,15 @@ bool VerilatedTrace<VL_SUB_T, VL_BUF_T>::declCode(uint32_t code, const std::stri
             if (*np++ == ' ') ++levels;
         }
         if (levels > dumpvarsLevel) continue;  // Too deep
+        enabled = true;
+        break;
+    }
+    if (enabled && !m_traceScopes.empty()) enabled = traceScopeMatch(declName);
+    if (enabled && (!m_dumpvars.empty() || !m_traceScopes.empty())) {
         // We only need to set first code word if it's a multicode signal
         // as that's all we'll check for later
         if (m_sigs_enabledVec.size() <= code) m_sigs_enabledVec.resize((code + 1024) * 2);
         m_sigs_enabledVec[code] = true;
-        enabled = true;
-        break;
     }
 
     int codesNeeded = VL_WORDS_I(bits);
@@ -441,6 +536,22 @@ void VerilatedTrace<VL_SUB_T, VL_BUF_T>::dumpvars(int level, const std::string&
     }
 }
 
+template <>
+void VerilatedTrace<VL_SUB_T, VL_BUF_T>::traceScopes(const std::string& scopes) VL_MT_SAFE {
+    // Split on separators, and convert Verilog . separators to trace space separators
+    m_traceScopes.clear();
+    std::string item;
+    for (const char* cp = scopes.c_str();; ++cp) {
+        if (*cp && *cp != ',' && !std::isspace(static_cast<unsigned char>(*cp))) {
+            item += *cp == '.' ? ' ' : *cp;
+        } else {
+            if (!item.empty()) m_traceScopes.push_back(item);
+            item.clear();
+            if (!*cp) break;
+        }
+    }
+}
+
 template <>
 void VerilatedTrace<VL_SUB_T, VL_BUF_T>::parallelWorkerTask(void* datap, bool) {
     ParallelWorkerData* const wdp = reinterpret_cast<ParallelWorkerData*>(datap);
@@ -485,6 +596,7 @@ void VerilatedTrace<VL_SUB_T, VL_BUF_T>::runCallbacks(const std::vector<Callback
             workerData.emplace_back(cbr.m_dumpCb, cbr.m_userp, bufp);
             // Grab the new work item
             ParallelWorkerData* const itemp = &workerData.back();
+            if (VL_UNLIKELY(m_recordp)) bufp->m_recordp = &itemp->m_record;
             // Enqueue task to thread pool, or main thread
             if (unsigned rem = cbr.m_fidx % threads) {
                 threadPoolp->workerp(rem - 1)->addTask(parallelWorkerTask, itemp);
@@ -500,6 +612,10 @@ void VerilatedTrace<VL_SUB_T, VL_BUF_T>::runCallbacks(const std::vector<Callback
         for (ParallelWorkerData& item : workerData) {
             // Wait until ready
             item.wait();
+            // Gather flight recorder records in order
+            if (VL_UNLIKELY(m_recordp)) {
+                m_recordp->insert(m_recordp->end(), item.m_record.begin(), item.m_record.end());
+            }
             // Commit the buffer
             commitTraceBuffer(item.m_bufp);
         }
@@ -510,6 +626,7 @@ void VerilatedTrace<VL_SUB_T, VL_BUF_T>::runCallbacks(const std::vector<Callback
     // Fall back on sequential execution
     for (const CallbackRecord& cbr : cbVec) {
         Buffer* const traceBufferp = getTraceBuffer(cbr.m_fidx);
+        traceBufferp->m_recordp = m_recordp;
         cbr.m_dumpCb(cbr.m_userp, traceBufferp);
         commitTraceBuffer(traceBufferp);
     }
@@ -526,6 +643,118 @@ void VerilatedTrace<VL_SUB_T, VL_BUF_T>::runOffloadedCallbacks(
     }
 }
 
+template <>
+const uint32_t* VerilatedTrace<VL_SUB_T, VL_BUF_T>::flightReplay(Buffer* bufp,
+                                                                  const uint32_t* readp) {
+    const uint32_t cmd = readp[0];
+    const uint32_t code = readp[1];
+    const int bits = static_cast<int>(cmd >> 4);
+    switch (cmd & 0xF) {
+    case VerilatedTraceOffloadCommand::CHG_BIT_0: bufp->emitBit(code, 0); return readp + 2;
+    case VerilatedTraceOffloadCommand::CHG_BIT_1: bufp->emitBit(code, 1); return readp + 2;
+    case VerilatedTraceOffloadCommand::CHG_CDATA:
+        bufp->emitCData(code, readp[2], bits);
+        return readp + 3;
+    case VerilatedTraceOffloadCommand::CHG_SDATA:
+        bufp->emitSData(code, readp[2], bits);
+        return readp + 3;
+    case VerilatedTraceOffloadCommand::CHG_IDATA:
+        bufp->emitIData(code, readp[2], bits);
+        return readp + 3;
+    case VerilatedTraceOffloadCommand::CHG_QDATA: {
+        QData val;
+        std::memcpy(&val, readp + 2, sizeof(val));
+        bufp->emitQData(code, val, bits);
+        return readp + 4;
+    }
+    case VerilatedTraceOffloadCommand::CHG_WDATA:
+        bufp->emitWData(code, readp + 2, bits);
+        return readp + 2 + VL_WORDS_I(bits);
+    case VerilatedTraceOffloadCommand::CHG_DOUBLE: {
+        double val;
+        std::memcpy(&val, readp + 2, sizeof(val));
+        bufp->emitDouble(code, val);
+        return readp + 4;
+    }
+    case VerilatedTraceOffloadCommand::CHG_EVENT: bufp->emitEvent(code); return readp + 2;
+    default: {  // LCOV_EXCL_START
+        VL_FATAL_MT(__FILE__, __LINE__, "", "Unknown flight recorder command");
+        return readp + 2;
+    }  // LCOV_EXCL_STOP
+    }
+}
+
+template <>
+void VerilatedTrace<VL_SUB_T, VL_BUF_T>::flightRecordDump(uint64_t timeui) {
+    // When the current segment is complete, start over in the other one,
+    // beginning with a full dump
+    if (m_flightDumps >= m_flightCycles) {
+        m_flightCur ^= 1;
+        m_flightSegments[m_flightCur].clear();
+        m_flightDumps = 0;
+        m_fullDump = true;
+    }
+    ++m_flightDumps;
+
+    std::vector<uint32_t>& segment = m_flightSegments[m_flightCur];
+    segment.push_back(VerilatedTraceOffloadCommand::TIME_CHANGE);
+    segment.push_back(static_cast<uint32_t>(timeui >> 32ULL));
+    segment.push_back(static_cast<uint32_t>(timeui));
+
+    // Run the callbacks, recording into the segment
+    m_recordp = &segment;
+    if (VL_UNLIKELY(m_fullDump)) {
+        m_fullDump = false;
+        runCallbacks(m_fullCbs);
+    } else {
+        runCallbacks(m_chgCbs);
+    }
+    if (VL_UNLIKELY(m_constDump)) {
+        // Constants are only dumped once, so are kept separately
+        m_constDump = false;
+        m_recordp = &m_flightConsts;
+        runCallbacks(m_constCbs);
+    }
+    m_recordp = nullptr;
+
+    for (const CallbackRecord& cbr : m_cleanupCbs) cbr.m_cleanupCb(cbr.m_userp, self());
+}
+
+template <>
+void VerilatedTrace<VL_SUB_T, VL_BUF_T>::flightRecorderWrite() {
+    m_flightRecording = false;
+    Buffer* bufp = nullptr;
+    bool first = true;
+    // Older segment first, it starts with a full dump (unless it is empty)
+    for (const unsigned idx : {m_flightCur ^ 1U, m_flightCur}) {
+        const std::vector<uint32_t>& segment = m_flightSegments[idx];
+        const uint32_t* readp = segment.data();
+        const uint32_t* const endp = readp + segment.size();
+        while (readp < endp) {
+            if ((readp[0] & 0xF) != VerilatedTraceOffloadCommand::TIME_CHANGE) {
+                readp = flightReplay(bufp, readp);
+                continue;
+            }
+            if (bufp) commitTraceBuffer(bufp);
+            emitTimeChange(static_cast<uint64_t>(readp[1]) << 32ULL
+                           | static_cast<uint64_t>(readp[2]));
+            readp += 3;
+            bufp = getTraceBuffer(0);
+            if (first) {
+                first = false;
+                // Constants go with the first dump
+                const uint32_t* constp = m_flightConsts.data();
+                const uint32_t* const constEndp = constp + m_flightConsts.size();
+                while (constp < constEndp) constp = flightReplay(bufp, constp);
+            }
+        }
+    }
+    if (bufp) commitTraceBuffer(bufp);
+    // Release the memory
+    for (std::vector<uint32_t>& segment : m_flightSegments) std::vector<uint32_t>{}.swap(segment);
+    std::vector<uint32_t>{}.swap(m_flightConsts);
+}
+
 template <>
 void VerilatedTrace<VL_SUB_T, VL_BUF_T>::dump(uint64_t timeui) VL_MT_SAFE_EXCLUDES(m_mutex) {
     // Not really VL_MT_SAFE but more VL_MT_UNSAFE_ONE.
@@ -543,6 +772,12 @@ void VerilatedTrace<VL_SUB_T, VL_BUF_T>::dump(uint64_t timeui) VL_MT_SAFE_EXCLUD
 
     Verilated::quiesce();
 
+    // A $dumpon since the previous dump triggers the flight recorder
+    if (VL_UNLIKELY(m_flightRecording) && m_contextp
+        && m_contextp->dumponCount() != m_flightDumpon) {
+        flightRecorderWrite();
+    }
+
     // Call hook for format-specific behaviour
     if (VL_UNLIKELY(m_fullDump)) {
         if (!preFullDump()) return;
@@ -550,6 +785,11 @@ void VerilatedTrace<VL_SUB_T, VL_BUF_T>::dump(uint64_t timeui) VL_MT_SAFE_EXCLUD
         if (!preChangeDump()) return;
     }
 
+    if (VL_UNLIKELY(m_flightRecording)) {
+        flightRecordDump(timeui);
+        return;
+    }
+
     uint32_t* bufferp = nullptr;
     if (offload()) {
         // Currently only incremental dumps run on the worker thread
@@ -619,6 +859,19 @@ void VerilatedTrace<VL_SUB_T, VL_BUF_T>::dump(uint64_t timeui) VL_MT_SAFE_EXCLUD
     }
 }
 
+template <>
+void VerilatedTrace<VL_SUB_T, VL_BUF_T>::flightRecorder(uint64_t cycles)
+    VL_MT_SAFE_EXCLUDES(m_mutex) {
+    const VerilatedLockGuard lock{m_mutex};
+    m_flightCycles = cycles;
+}
+
+template <>
+void VerilatedTrace<VL_SUB_T, VL_BUF_T>::flightRecorderTrigger() VL_MT_SAFE_EXCLUDES(m_mutex) {
+    const VerilatedLockGuard lock{m_mutex};
+    if (m_flightRecording) flightRecorderWrite();
+}
+
 //=============================================================================
 // Non-hot path internal interface to Verilator generated code
 
@@ -802,8 +1055,26 @@ static inline void cvtIDataToStr(char* dstp, IData value) {
 }
 
 static inline void cvtQDataToStr(char* dstp, QData value) {
+#ifdef VL_HAVE_AVX2
+    // Similar to cvtIDataToStr, but broadcast all 64 bits once, then expand
+    // the top and bottom 32 bits with two different byte shuffles
+    const __m256i a = _mm256_set1_epi64x(static_cast<int64_t>(value));
+    const __m256i sh = _mm256_set_epi8(4, 4, 4, 4, 4, 4, 4, 4, 5, 5, 5, 5, 5, 5, 5, 5, 6, 6, 6, 6,
+                                       6, 6, 6, 6, 7, 7, 7, 7, 7, 7, 7, 7);
+    const __m256i sl = _mm256_set_epi8(0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1, 2, 2, 2, 2,
+                                       2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 3, 3);
+    const __m256i m = _mm256_set1_epi64x(0x0102040810204080);
+    const __m256i z = _mm256_set1_epi8('0');
+    const __m256i ch = _mm256_shuffle_epi8(a, sh);
+    const __m256i cl = _mm256_shuffle_epi8(a, sl);
+    const __m256i dh = _mm256_cmpeq_epi8(_mm256_and_si256(ch, m), m);
+    const __m256i dl = _mm256_cmpeq_epi8(_mm256_and_si256(cl, m), m);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dstp), _mm256_sub_epi8(z, dh));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dstp + 32), _mm256_sub_epi8(z, dl));
+#else
     cvtIDataToStr(dstp, value >> 32);
     cvtIDataToStr(dstp + 32, value);
+#endif
 }
 
 #define cvtEDataToStr cvtIDataToStr
@@ -815,7 +1086,19 @@ template <>
 VerilatedTraceBuffer<VL_BUF_T>::VerilatedTraceBuffer(Trace& owner)
     : VL_BUF_T{owner}
     , m_sigs_oldvalp{owner.m_sigs_oldvalp}
-    , m_sigs_enabledp{owner.m_sigs_enabledp} {}
+    , m_sigs_enabledp{owner.m_sigs_enabledp}
+    , m_sigs_enabledCountp{owner.m_sigs_enabledCountp} {}
+
+template <>
+void VerilatedTraceBuffer<VL_BUF_T>::record(uint32_t cmd, uint32_t code, const void* valp,
+                                            int words) {
+    std::vector<uint32_t>& rec = *m_recordp;
+    const size_t pos = rec.size();
+    rec.resize(pos + 2 + words);
+    rec[pos] = cmd;
+    rec[pos + 1] = code;
+    std::memcpy(rec.data() + pos + 2, valp, words * sizeof(uint32_t));
+}
 
 // These functions must write the new value back into the old value store,
 // and subsequently call the format-specific emit* implementations. Note
@@ -827,6 +1110,10 @@ void VerilatedTraceBuffer<VL_BUF_T>::fullBit(uint32_t* oldp, CData newval) {
     const uint32_t code = oldp - m_sigs_oldvalp;
     *oldp = newval;  // Still copy even if not tracing so chg doesn't call full
     if (VL_UNLIKELY(m_sigs_enabledp && !(VL_BITISSET_W(m_sigs_enabledp, code)))) return;
+    if (VL_UNLIKELY(m_recordp)) {
+        record(VerilatedTraceOffloadCommand::CHG_BIT_0 | newval, code, oldp, 0);
+        return;
+    }
     emitBit(code, newval);
 }
 
@@ -834,13 +1121,22 @@ template <>
 void VerilatedTraceBuffer<VL_BUF_T>::fullEvent(uint32_t* oldp, const VlEventBase* newvalp) {
     const uint32_t code = oldp - m_sigs_oldvalp;
     // No need to update *oldp
-    if (newvalp->isTriggered()) emitEvent(code);
+    if (!newvalp->isTriggered()) return;
+    if (VL_UNLIKELY(m_recordp)) {
+        record(VerilatedTraceOffloadCommand::CHG_EVENT, code, oldp, 0);
+        return;
+    }
+    emitEvent(code);
 }
 
 template <>
 void VerilatedTraceBuffer<VL_BUF_T>::fullEventTriggered(uint32_t* oldp) {
     const uint32_t code = oldp - m_sigs_oldvalp;
     // No need to update *oldp
+    if (VL_UNLIKELY(m_recordp)) {
+        record(VerilatedTraceOffloadCommand::CHG_EVENT, code, oldp, 0);
+        return;
+    }
     emitEvent(code);
 }
 
@@ -849,6 +1145,10 @@ void VerilatedTraceBuffer<VL_BUF_T>::fullCData(uint32_t* oldp, CData newval, int
     const uint32_t code = oldp - m_sigs_oldvalp;
     *oldp = newval;  // Still copy even if not tracing so chg doesn't call full
     if (VL_UNLIKELY(m_sigs_enabledp && !(VL_BITISSET_W(m_sigs_enabledp, code)))) return;
+    if (VL_UNLIKELY(m_recordp)) {
+        record((bits << 4) | VerilatedTraceOffloadCommand::CHG_CDATA, code, oldp, 1);
+        return;
+    }
     emitCData(code, newval, bits);
 }
 
@@ -857,6 +1157,10 @@ void VerilatedTraceBuffer<VL_BUF_T>::fullSData(uint32_t* oldp, SData newval, int
     const uint32_t code = oldp - m_sigs_oldvalp;
     *oldp = newval;  // Still copy even if not tracing so chg doesn't call full
     if (VL_UNLIKELY(m_sigs_enabledp && !(VL_BITISSET_W(m_sigs_enabledp, code)))) return;
+    if (VL_UNLIKELY(m_recordp)) {
+        record((bits << 4) | VerilatedTraceOffloadCommand::CHG_SDATA, code, oldp, 1);
+        return;
+    }
     emitSData(code, newval, bits);
 }
 
@@ -865,6 +1169,10 @@ void VerilatedTraceBuffer<VL_BUF_T>::fullIData(uint32_t* oldp, IData newval, int
     const uint32_t code = oldp - m_sigs_oldvalp;
     *oldp = newval;  // Still copy even if not tracing so chg doesn't call full
     if (VL_UNLIKELY(m_sigs_enabledp && !(VL_BITISSET_W(m_sigs_enabledp, code)))) return;
+    if (VL_UNLIKELY(m_recordp)) {
+        record((bits << 4) | VerilatedTraceOffloadCommand::CHG_IDATA, code, oldp, 1);
+        return;
+    }
     emitIData(code, newval, bits);
 }
 
@@ -873,6 +1181,10 @@ void VerilatedTraceBuffer<VL_BUF_T>::fullQData(uint32_t* oldp, QData newval, int
     const uint32_t code = oldp - m_sigs_oldvalp;
     std::memcpy(oldp, &newval, sizeof(newval));
     if (VL_UNLIKELY(m_sigs_enabledp && !(VL_BITISSET_W(m_sigs_enabledp, code)))) return;
+    if (VL_UNLIKELY(m_recordp)) {
+        record((bits << 4) | VerilatedTraceOffloadCommand::CHG_QDATA, code, oldp, 2);
+        return;
+    }
     emitQData(code, newval, bits);
 }
 
@@ -881,6 +1193,11 @@ void VerilatedTraceBuffer<VL_BUF_T>::fullWData(uint32_t* oldp, const WData* newv
     const uint32_t code = oldp - m_sigs_oldvalp;
     for (int i = 0; i < VL_WORDS_I(bits); ++i) oldp[i] = newvalp[i];
     if (VL_UNLIKELY(m_sigs_enabledp && !(VL_BITISSET_W(m_sigs_enabledp, code)))) return;
+    if (VL_UNLIKELY(m_recordp)) {
+        record((bits << 4) | VerilatedTraceOffloadCommand::CHG_WDATA, code, oldp,
+               VL_WORDS_I(bits));
+        return;
+    }
     emitWData(code, newvalp, bits);
 }
 
@@ -889,6 +1206,10 @@ void VerilatedTraceBuffer<VL_BUF_T>::fullDouble(uint32_t* oldp, double newval) {
     const uint32_t code = oldp - m_sigs_oldvalp;
     std::memcpy(oldp, &newval, sizeof(newval));
     if (VL_UNLIKELY(m_sigs_enabledp && !(VL_BITISSET_W(m_sigs_enabledp, code)))) return;
+    if (VL_UNLIKELY(m_recordp)) {
+        record(VerilatedTraceOffloadCommand::CHG_DOUBLE, code, oldp, 2);
+        return;
+    }
     // cppcheck-suppress invalidPointerCast
     emitDouble(code, newval);
 }
@@ -32,10 +32,12 @@
 #include <array>
 #include <atomic>
 #include <deque>
+#include <iterator>
 #include <map>
 #include <memory>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <utility>
 
 //=========================================================================
@@ -197,9 +199,10 @@ public:
 
     // Return true iff at least one element is set
     bool any() const {
-        for (size_t i = 0; i < m_flags.size(); ++i)
-            if (m_flags[i]) return true;
-        return false;
+        // Reduce without branches, which vectorizes for multi-word vectors
+        uint64_t result = 0;
+        for (size_t i = 0; i < m_flags.size(); ++i) result |= m_flags[i];
+        return result != 0;
     }
 
     // Set all elements true in 'this' that are set in 'other'
@@ -286,6 +289,26 @@ inline std::string VL_TO_STRING(const VlEventBase& e) {
 class VlRNG final {
     std::array<uint64_t, 2> m_state;
 
+    // Advance the given state, and return the next value
+    static uint64_t next(uint64_t& s0r, uint64_t& s1r) VL_MT_SAFE {
+        // Xoroshiro128+ algorithm
+        const uint64_t result = s0r + s1r;
+        s1r ^= s0r;
+        s0r = ((s0r << 55) | (s0r >> 9)) ^ s1r ^ (s1r << 14);
+        s1r = (s1r << 36) | (s1r >> 28);
+        return result;
+    }
+    // Fill 'n' values with what 'n' consecutive rand64() calls would return, truncated to the
+    // output type. The state is held in registers, so this is faster than calling rand64().
+    template <typename T_Value>
+    static void fillState(std::array<uint64_t, 2>& stater, T_Value* outp, size_t n) VL_MT_SAFE {
+        uint64_t s0 = stater[0];
+        uint64_t s1 = stater[1];
+        for (size_t i = 0; i < n; ++i) outp[i] = static_cast<T_Value>(next(s0, s1));
+        stater[0] = s0;
+        stater[1] = s1;
+    }
+
 public:
     // The default constructor simply sets state, to avoid vl_rand64()
     // having to check for construction at each call
@@ -295,9 +318,17 @@ public:
     void srandom(uint64_t n) VL_MT_UNSAFE;
     std::string get_randstate() const VL_MT_UNSAFE;
     void set_randstate(const std::string& state) VL_MT_UNSAFE;
-    uint64_t rand64() VL_MT_UNSAFE;
+    uint64_t rand64() VL_MT_UNSAFE { return next(m_state[0], m_state[1]); }
+    template <typename T_Value>
+    void fill(T_Value* outp, size_t n) VL_MT_UNSAFE {
+        fillState(m_state, outp, n);
+    }
     // Threadsafe, but requires use on vl_thread_rng
     static uint64_t vl_thread_rng_rand64() VL_MT_SAFE;
+    template <typename T_Value>
+    static void vl_thread_rng_fill(T_Value* outp, size_t n) VL_MT_SAFE {
+        fillState(vl_thread_rng().m_state, outp, n);
+    }
     static VlRNG& vl_thread_rng() VL_MT_SAFE;
 };
 
@@ -377,14 +408,19 @@ class VlReadMem final {
     const int m_bits;  // Bit width of values
     const std::string& m_filename;  // Filename
     const QData m_end;  // End address (as specified by user)
-    FILE* m_fp = nullptr;  // File handle for filename
+    const char* m_curp = nullptr;  // Next character to read from file contents
+    const char* m_endp = nullptr;  // End of file contents
+    void* m_mapp = nullptr;  // Memory mapped file contents, or nullptr if in m_buffer
+    std::size_t m_mapSize = 0;  // Size of m_mapp region
+    std::string m_buffer;  // File contents if could not memory map
     QData m_addr = 0;  // Next address to read
     int m_linenum = 0;  // Line number last read from file
     bool m_anyAddr = false;  // Had address directive in the file
+    bool m_open = false;  // File opened and read
 public:
     VlReadMem(bool hex, int bits, const std::string& filename, QData start, QData end);
     ~VlReadMem();
-    bool isOpen() const { return m_fp != nullptr; }
+    bool isOpen() const { return m_open; }
     int linenum() const { return m_linenum; }
     bool get(QData& addrr, std::string& valuer);
     void setData(void* valuep, const std::string& rhs);
@@ -474,6 +510,259 @@ std::string VL_TO_STRING(const VlWide<N_Words>& obj) {
     return VL_TO_STRING_W(N_Words, obj.data());
 }
 
+//===================================================================
+// Contiguous double ended queue used as the storage of VlQueue
+// Elements live in a power-of-two sized ring, so push/pop at either end are
+// O(1) without the small chunk allocations of std::deque, and capacity
+// doubles when full.  N_Inline elements, if non-zero, are stored inside the
+// object itself, so a small bounded queue never touches the heap.
+
+template <typename T_Value, size_t N_Inline = 0>
+class VlRingBuffer final {
+    static_assert((N_Inline & (N_Inline - 1)) == 0, "N_Inline must be a power of two");
+    template <typename, size_t>
+    friend class VlRingBuffer;
+
+    // TYPES
+    template <typename T_Ring, typename T_Elem>
+    class Iterator final {
+        friend class VlRingBuffer;
+        template <typename, typename>
+        friend class Iterator;
+        T_Ring* m_ringp;  // Buffer iterated
+        ptrdiff_t m_index;  // Logical index from front
+        Iterator(T_Ring* ringp, ptrdiff_t index)
+            : m_ringp{ringp}
+            , m_index{index} {}
+
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = T_Value;
+        using difference_type = ptrdiff_t;
+        using pointer = T_Elem*;
+        using reference = T_Elem&;
+        Iterator() = default;
+        // Allow iterator to const_iterator conversion
+        operator Iterator<const T_Ring, const T_Elem>() const { return {m_ringp, m_index}; }
+        reference operator*() const { return (*m_ringp)[m_index]; }
+        pointer operator->() const { return &(*m_ringp)[m_index]; }
+        reference operator[](difference_type n) const { return (*m_ringp)[m_index + n]; }
+        Iterator& operator++() {
+            ++m_index;
+            return *this;
+        }
+        Iterator& operator--() {
+            --m_index;
+            return *this;
+        }
+        Iterator operator++(int) { return {m_ringp, m_index++}; }
+        Iterator operator--(int) { return {m_ringp, m_index--}; }
+        Iterator& operator+=(difference_type n) {
+            m_index += n;
+            return *this;
+        }
+        Iterator& operator-=(difference_type n) {
+            m_index -= n;
+            return *this;
+        }
+        Iterator operator+(difference_type n) const { return {m_ringp, m_index + n}; }
+        Iterator operator-(difference_type n) const { return {m_ringp, m_index - n}; }
+        friend Iterator operator+(difference_type n, const Iterator& it) { return it + n; }
+        difference_type operator-(const Iterator& rhs) const { return m_index - rhs.m_index; }
+        bool operator==(const Iterator& rhs) const { return m_index == rhs.m_index; }
+        bool operator!=(const Iterator& rhs) const { return m_index != rhs.m_index; }
+        bool operator<(const Iterator& rhs) const { return m_index < rhs.m_index; }
+        bool operator>(const Iterator& rhs) const { return m_index > rhs.m_index; }
+        bool operator<=(const Iterator& rhs) const { return m_index <= rhs.m_index; }
+        bool operator>=(const Iterator& rhs) const { return m_index >= rhs.m_index; }
+    };
+
+public:
+    using value_type = T_Value;
+    using iterator = Iterator<VlRingBuffer, T_Value>;
+    using const_iterator = Iterator<const VlRingBuffer, const T_Value>;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+private:
+    // MEMBERS
+    T_Value* m_datap = inlinep();  // Element storage, inline or heap
+    size_t m_capacity = N_Inline;  // Size of m_datap, zero or a power of two
+    size_t m_head = 0;  // Physical index of front element
+    size_t m_size = 0;  // Number of elements
+    alignas(T_Value) unsigned char m_inline[N_Inline ? N_Inline * sizeof(T_Value) : 1];
+
+    // METHODS
+    T_Value* inlinep() {
+        return N_Inline ? reinterpret_cast<T_Value*>(m_inline) : nullptr;
+    }
+    bool isInline() const { return N_Inline && m_capacity == N_Inline; }
+    size_t physical(size_t index) const { return (m_head + index) & (m_capacity - 1); }
+    void release() {
+        clear();
+        if (m_capacity && !isInline()) std::allocator<T_Value>{}.deallocate(m_datap, m_capacity);
+        m_datap = inlinep();
+        m_capacity = N_Inline;
+    }
+    template <typename T_Arg>
+    void emplaceBack(T_Arg&& value) {
+        if (VL_UNLIKELY(m_size == m_capacity)) {
+            T_Value copy(std::forward<T_Arg>(value));  // value may be an element grow() moves
+            grow(m_size + 1);
+            new (m_datap + physical(m_size)) T_Value(std::move(copy));
+        } else {
+            new (m_datap + physical(m_size)) T_Value(std::forward<T_Arg>(value));
+        }
+        ++m_size;
+    }
+    template <typename T_Arg>
+    void emplaceFront(T_Arg&& value) {
+        if (VL_UNLIKELY(m_size == m_capacity)) {
+            T_Value copy(std::forward<T_Arg>(value));  // value may be an element grow() moves
+            grow(m_size + 1);
+            m_head = (m_head - 1) & (m_capacity - 1);
+            new (m_datap + m_head) T_Value(std::move(copy));
+        } else {
+            m_head = (m_head - 1) & (m_capacity - 1);
+            new (m_datap + m_head) T_Value(std::forward<T_Arg>(value));
+        }
+        ++m_size;
+    }
+    void grow(size_t minCapacity) {
+        size_t newCapacity = m_capacity ? m_capacity * 2 : 16;
+        while (newCapacity < minCapacity) newCapacity *= 2;
+        T_Value* const newp = std::allocator<T_Value>{}.allocate(newCapacity);
+        for (size_t i = 0; i < m_size; ++i) {
+            T_Value& item = (*this)[i];
+            new (newp + i) T_Value(std::move(item));
+            item.~T_Value();
+        }
+        if (m_capacity && !isInline()) std::allocator<T_Value>{}.deallocate(m_datap, m_capacity);
+        m_datap = newp;
+        m_capacity = newCapacity;
+        m_head = 0;
+    }
+    // Steal heap storage, or move elements out of inline storage, of rhs
+    template <size_t N_RhsInline>
+    void takeFrom(VlRingBuffer<T_Value, N_RhsInline>& rhs) {
+        if (rhs.m_capacity && !rhs.isInline()) {
+            release();
+            m_datap = rhs.m_datap;
+            m_capacity = rhs.m_capacity;
+            m_head = rhs.m_head;
+            m_size = rhs.m_size;
+            rhs.m_datap = rhs.inlinep();
+            rhs.m_capacity = N_RhsInline;
+            rhs.m_head = 0;
+            rhs.m_size = 0;
+        } else {
+            assign(std::make_move_iterator(rhs.begin()), std::make_move_iterator(rhs.end()));
+            rhs.clear();
+        }
+    }
+
+public:
+    // CONSTRUCTORS
+    VlRingBuffer() = default;
+    ~VlRingBuffer() { release(); }
+    VlRingBuffer(const VlRingBuffer& rhs) { assign(rhs.begin(), rhs.end()); }
+    VlRingBuffer(VlRingBuffer&& rhs) { takeFrom(rhs); }
+    VlRingBuffer& operator=(const VlRingBuffer& rhs) {
+        if (this != &rhs) assign(rhs.begin(), rhs.end());
+        return *this;
+    }
+    VlRingBuffer& operator=(VlRingBuffer&& rhs) {
+        if (this != &rhs) takeFrom(rhs);
+        return *this;
+    }
+    template <size_t N_RhsInline>
+    VlRingBuffer& operator=(const VlRingBuffer<T_Value, N_RhsInline>& rhs) {
+        assign(rhs.begin(), rhs.end());
+        return *this;
+    }
+    bool operator==(const VlRingBuffer& rhs) const {
+        return m_size == rhs.m_size && std::equal(begin(), end(), rhs.begin());
+    }
+    bool operator!=(const VlRingBuffer& rhs) const { return !(*this == rhs); }
+
+    // METHODS
+    size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+    size_t capacity() const { return m_capacity; }
+    void reserve(size_t n) {
+        if (n > m_capacity) grow(n);
+    }
+    T_Value& operator[](size_t index) { return m_datap[physical(index)]; }
+    const T_Value& operator[](size_t index) const { return m_datap[physical(index)]; }
+    T_Value& front() { return m_datap[m_head]; }
+    const T_Value& front() const { return m_datap[m_head]; }
+    T_Value& back() { return (*this)[m_size - 1]; }
+    const T_Value& back() const { return (*this)[m_size - 1]; }
+
+    void push_back(const T_Value& value) { emplaceBack(value); }
+    void push_back(T_Value&& value) { emplaceBack(std::move(value)); }
+    void push_front(const T_Value& value) { emplaceFront(value); }
+    void push_front(T_Value&& value) { emplaceFront(std::move(value)); }
+    void pop_front() {
+        m_datap[m_head].~T_Value();
+        m_head = (m_head + 1) & (m_capacity - 1);
+        if (--m_size == 0) m_head = 0;
+    }
+    void pop_back() {
+        back().~T_Value();
+        if (--m_size == 0) m_head = 0;
+    }
+    void clear() {
+        for (size_t i = 0; i < m_size; ++i) (*this)[i].~T_Value();
+        m_head = 0;
+        m_size = 0;
+    }
+    void resize(size_t n, const T_Value& value) {
+        while (m_size > n) pop_back();
+        reserve(n);
+        while (m_size < n) push_back(value);
+    }
+    void resize(size_t n) { resize(n, T_Value{}); }
+    template <typename T_It>
+    void assign(T_It first, T_It last) {
+        clear();
+        reserve(std::distance(first, last));
+        for (; first != last; ++first) push_back(*first);
+    }
+    // Erase/insert shift whichever side of the position is shorter
+    void erase(const_iterator pos) {
+        const size_t index = pos.m_index;
+        if (index < m_size / 2) {
+            for (size_t i = index; i > 0; --i) (*this)[i] = std::move((*this)[i - 1]);
+            pop_front();
+        } else {
+            for (size_t i = index; i + 1 < m_size; ++i) (*this)[i] = std::move((*this)[i + 1]);
+            pop_back();
+        }
+    }
+    void insert(const_iterator pos, const T_Value& value) {
+        const size_t index = pos.m_index;
+        if (index < m_size / 2) {
+            push_front(value);
+            std::rotate(begin(), begin() + 1, begin() + index + 1);
+        } else {
+            push_back(value);
+            std::rotate(begin() + index, end() - 1, end());
+        }
+    }
+
+    iterator begin() { return {this, 0}; }
+    iterator end() { return {this, static_cast<ptrdiff_t>(m_size)}; }
+    const_iterator begin() const { return {this, 0}; }
+    const_iterator end() const { return {this, static_cast<ptrdiff_t>(m_size)}; }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+    reverse_iterator rbegin() { return reverse_iterator{end()}; }
+    reverse_iterator rend() { return reverse_iterator{begin()}; }
+    const_reverse_iterator rbegin() const { return const_reverse_iterator{end()}; }
+    const_reverse_iterator rend() const { return const_reverse_iterator{begin()}; }
+};
+
 //===================================================================
 // Verilog queue and dynamic array container
 // There are no multithreaded locks on this; the base variable must
@@ -481,11 +770,20 @@ std::string VL_TO_STRING(const VlWide<N_Words>& obj) {
 //
 // Bound here is the maximum size() allowed, e.g. 1 + SystemVerilog bound
 // For dynamic arrays it is always zero
+//
+// Small bounded queues keep their elements inline, see vlQueueInlineSize
+constexpr size_t vlQueueInlineSize(size_t maxSize, size_t elemSize) {
+    if (maxSize == 0 || maxSize * elemSize > 256) return 0;
+    size_t n = 1;
+    while (n < maxSize) n *= 2;
+    return n;
+}
+
 template <typename T_Value, size_t N_MaxSize = 0>
 class VlQueue final {
 private:
     // TYPES
-    using Deque = std::deque<T_Value>;
+    using Deque = VlRingBuffer<T_Value, vlQueueInlineSize(N_MaxSize, sizeof(T_Value))>;
 
 public:
     using const_iterator = typename Deque::const_iterator;
@@ -584,8 +882,14 @@ public:
 
     // function void q.push_front(value)
     void push_front(const T_Value& value) {
-        m_deque.push_front(value);
-        if (VL_UNLIKELY(N_MaxSize != 0 && m_deque.size() > N_MaxSize)) m_deque.pop_back();
+        if (VL_UNLIKELY(N_MaxSize != 0 && m_deque.size() >= N_MaxSize)) {
+            // Copy first, as value may be the element being dropped
+            T_Value copy = value;
+            m_deque.pop_back();
+            m_deque.push_front(std::move(copy));
+        } else {
+            m_deque.push_front(value);
+        }
     }
     // function void q.push_back(value)
     void push_back(const T_Value& value) {
@@ -594,14 +898,14 @@ public:
     // function value_t q.pop_front();
     T_Value pop_front() {
         if (m_deque.empty()) return m_defaultValue;
-        T_Value v = m_deque.front();
+        T_Value v = std::move(m_deque.front());
         m_deque.pop_front();
         return v;
     }
     // function value_t q.pop_back();
     T_Value pop_back() {
         if (m_deque.empty()) return m_defaultValue;
-        T_Value v = m_deque.back();
+        T_Value v = std::move(m_deque.back());
         m_deque.pop_back();
         return v;
     }
@@ -1295,6 +1599,70 @@ void VL_WRITEMEM_N(bool hex, int bits, const std::string& filename,
     }
 }
 
+//===================================================================
+/// Verilog associative array container with hashed storage
+/// Used by Verilator instead of VlAssocArray for arrays that are only
+/// indexed, checked with exists(), deleted or sized, so never depend on
+/// key order.  Lookup is then O(1) rather than O(log n).
+
+template <typename T_Key, typename T_Value>
+class VlUnorderedAssocArray final {
+    // TYPES
+    using Map = std::unordered_map<T_Key, T_Value>;
+
+    // MEMBERS
+    Map m_map;  // State of the assoc array
+    T_Value m_defaultValue;  // Default value
+
+public:
+    // CONSTRUCTORS
+    // m_defaultValue isn't defaulted. Caller's constructor must do it.
+    VlUnorderedAssocArray() = default;
+    ~VlUnorderedAssocArray() = default;
+    VlUnorderedAssocArray(const VlUnorderedAssocArray&) = default;
+    VlUnorderedAssocArray(VlUnorderedAssocArray&&) = default;
+    VlUnorderedAssocArray& operator=(const VlUnorderedAssocArray&) = default;
+    VlUnorderedAssocArray& operator=(VlUnorderedAssocArray&&) = default;
+    bool operator==(const VlUnorderedAssocArray& rhs) const { return m_map == rhs.m_map; }
+    bool operator!=(const VlUnorderedAssocArray& rhs) const { return m_map != rhs.m_map; }
+    // METHODS
+    T_Value& atDefault() { return m_defaultValue; }
+    const T_Value& atDefault() const { return m_defaultValue; }
+
+    // Size of array. Verilog: function int size(), or int num()
+    int size() const { return m_map.size(); }
+    bool empty() const { return m_map.empty(); }
+    // Clear array. Verilog: function void delete([input index])
+    void clear() { m_map.clear(); }
+    void erase(const T_Key& index) { m_map.erase(index); }
+    // Return 0/1 if element exists. Verilog: function int exists(input index)
+    int exists(const T_Key& index) const { return m_map.find(index) != m_map.end(); }
+    // Setting. Verilog: assoc[index] = v
+    T_Value& at(const T_Key& index) {
+        const auto it = m_map.find(index);
+        if (it == m_map.end()) return m_map.emplace(index, m_defaultValue).first->second;
+        return it->second;
+    }
+    // Accessing. Verilog: v = assoc[index]
+    const T_Value& at(const T_Key& index) const {
+        const auto it = m_map.find(index);
+        return it == m_map.end() ? m_defaultValue : it->second;
+    }
+    // Setting as a chained operation
+    VlUnorderedAssocArray& set(const T_Key& index, const T_Value& value) {
+        at(index) = value;
+        return *this;
+    }
+    VlUnorderedAssocArray& setDefault(const T_Value& value) {
+        atDefault() = value;
+        return *this;
+    }
+};
+
+template <typename T_Key, typename T_Value>
+struct VlContainsCustomStruct<VlUnorderedAssocArray<T_Key, T_Value>>
+    : VlContainsCustomStruct<T_Value> {};
+
 //===================================================================
 /// Verilog unpacked array container
 /// For when a standard C++[] array is not sufficient, e.g. an
@@ -1336,6 +1704,15 @@ public:
     void fill(const T_Value& value) {
         std::fill(std::begin(m_storage), std::end(m_storage), value);
     }
+    // Bulk operations on a range of elements, as made by V3Reloop
+    void fillRange(size_t start, size_t count, const T_Value& value) {
+        std::fill_n(&m_storage[start], count, value);
+    }
+    template <std::size_t N_ThatDepth>
+    void copyRange(size_t start, const VlUnpacked<T_Value, N_ThatDepth>& that, size_t thatStart,
+                   size_t count) {
+        std::copy_n(&that.m_storage[thatStart], count, &m_storage[start]);
+    }
 
     // To fit C++14
     template <std::size_t N_CurrentDimension = 0, typename U = T_Value>
@@ -1606,6 +1983,168 @@ std::string VL_TO_STRING(const VlUnpacked<T_Value, N_Depth>& obj) {
 template <typename T_Value, std::size_t N_Depth>
 struct VlContainsCustomStruct<VlUnpacked<T_Value, N_Depth>> : VlContainsCustomStruct<T_Value> {};
 
+//===================================================================
+/// Verilog unpacked array container with sparse storage
+/// Used instead of VlUnpacked for very large memories, see
+/// --sparse-array-threshold.  Elements are stored in fixed size pages which
+/// are allocated when first accessed for writing; reads of unallocated
+/// pages return the default (reset) value.
+
+template <typename T_Value, std::size_t N_Depth>
+class VlSparseUnpacked final {
+    // TYPES
+    static constexpr std::size_t PAGE_BITS = 12;  // log2 of elements per page
+    static constexpr std::size_t PAGE_ELEMENTS = 1ULL << PAGE_BITS;
+    static constexpr std::size_t N_Pages = (N_Depth + PAGE_ELEMENTS - 1) >> PAGE_BITS;
+    using Page = std::array<T_Value, PAGE_ELEMENTS>;
+
+    // MEMBERS
+    std::unique_ptr<std::unique_ptr<Page>[]> m_pagesp{new std::unique_ptr<Page>[N_Pages]};
+    T_Value m_defaultValue{};  // Value of elements in unallocated pages
+
+    // METHODS
+    Page& pageAt(std::size_t index) {
+        std::unique_ptr<Page>& pagep = m_pagesp[index >> PAGE_BITS];
+        if (VL_UNLIKELY(!pagep)) {
+            pagep.reset(new Page);
+            pagep->fill(m_defaultValue);
+        }
+        return *pagep;
+    }
+
+public:
+    // CONSTRUCTORS
+    VlSparseUnpacked() = default;
+    // For constant pool tables, which are initialized as {{values}}
+    VlSparseUnpacked(std::initializer_list<T_Value> init) {
+        std::size_t index = 0;
+        for (const T_Value& value : init) (*this)[index++] = value;
+    }
+    VlSparseUnpacked(const VlSparseUnpacked& that) { assign(that); }
+    VlSparseUnpacked(VlSparseUnpacked&&) = default;
+    ~VlSparseUnpacked() = default;
+    VlSparseUnpacked& operator=(const VlSparseUnpacked& that) {
+        assign(that);
+        return *this;
+    }
+    VlSparseUnpacked& operator=(VlSparseUnpacked&&) = default;
+
+    // METHODS
+    constexpr std::size_t size() const { return N_Depth; }
+    // Number of pages currently allocated
+    std::size_t allocatedPages() const {
+        std::size_t count = 0;
+        for (std::size_t p = 0; p < N_Pages; ++p) count += m_pagesp[p] ? 1 : 0;
+        return count;
+    }
+    // Release all storage, so all elements read as the default value
+    void clear() {
+        for (std::size_t p = 0; p < N_Pages; ++p) m_pagesp[p].reset();
+    }
+    T_Value& atDefault() { return m_defaultValue; }
+    void fill(const T_Value& value) {
+        clear();
+        m_defaultValue = value;
+    }
+
+    T_Value& operator[](std::size_t index) { return pageAt(index)[index & (PAGE_ELEMENTS - 1)]; }
+    const T_Value& operator[](std::size_t index) const { return read(index); }
+    // Read without allocating
+    const T_Value& read(std::size_t index) const {
+        const std::unique_ptr<Page>& pagep = m_pagesp[index >> PAGE_BITS];
+        return pagep ? (*pagep)[index & (PAGE_ELEMENTS - 1)] : m_defaultValue;
+    }
+
+    bool neq(const VlSparseUnpacked& that) const {
+        for (std::size_t p = 0; p < N_Pages; ++p) {
+            if (!m_pagesp[p] && !that.m_pagesp[p]) {
+                if (m_defaultValue != that.m_defaultValue) return true;
+                continue;
+            }
+            const std::size_t end = std::min(N_Depth, (p + 1) << PAGE_BITS);
+            for (std::size_t i = p << PAGE_BITS; i < end; ++i) {
+                if (read(i) != that.read(i)) return true;
+            }
+        }
+        return false;
+    }
+    void assign(const VlSparseUnpacked& that) {
+        if (this == &that) return;
+        m_defaultValue = that.m_defaultValue;
+        for (std::size_t p = 0; p < N_Pages; ++p) {
+            if (!that.m_pagesp[p]) {
+                m_pagesp[p].reset();
+            } else if (m_pagesp[p]) {
+                *m_pagesp[p] = *that.m_pagesp[p];
+            } else {
+                m_pagesp[p].reset(new Page(*that.m_pagesp[p]));
+            }
+        }
+    }
+    bool operator==(const VlSparseUnpacked& that) const { return !neq(that); }
+    bool operator!=(const VlSparseUnpacked& that) const { return neq(that); }
+
+    // Dumping. Verilog: str = $sformatf("%p", array)
+    std::string to_string() const {
+        std::string out = "'{";
+        std::string comma;
+        for (std::size_t i = 0; i < N_Depth; ++i) {
+            out += comma + VL_TO_STRING(read(i));
+            comma = ", ";
+        }
+        return out + "} ";
+    }
+};
+
+template <typename T_Value, std::size_t N_Depth>
+std::string VL_TO_STRING(const VlSparseUnpacked<T_Value, N_Depth>& obj) {
+    return obj.to_string();
+}
+
+template <typename T_Value, std::size_t N_Depth>
+struct VlContainsCustomStruct<VlSparseUnpacked<T_Value, N_Depth>>
+    : VlContainsCustomStruct<T_Value> {};
+
+extern void VL_FATAL_MT(const char* filename, int linenum, const char* hier,
+                        const char* msg) VL_MT_SAFE;
+
+template <typename T_Value, std::size_t N_Depth>
+void VL_READMEM_N(bool hex, int bits, QData depth, int array_lsb, const std::string& filename,
+                  VlSparseUnpacked<T_Value, N_Depth>* memp, QData start, QData end) VL_MT_SAFE {
+    if (start < static_cast<QData>(array_lsb)) start = array_lsb;
+    VlReadMem rmem{hex, bits, filename, start, end};
+    if (VL_UNLIKELY(!rmem.isOpen())) return;
+    while (true) {
+        QData addr = 0;
+        std::string data;
+        if (rmem.get(addr /*ref*/, data /*ref*/)) {
+            if (VL_UNLIKELY(addr < static_cast<QData>(array_lsb)
+                            || addr >= static_cast<QData>(array_lsb + depth))) {
+                VL_FATAL_MT(filename.c_str(), rmem.linenum(), "",
+                            "$readmem file address beyond bounds of array");
+            } else {
+                rmem.setData(&((*memp)[addr - array_lsb]), data);
+            }
+        } else {
+            break;
+        }
+    }
+}
+
+template <typename T_Value, std::size_t N_Depth>
+void VL_WRITEMEM_N(bool hex, int bits, QData depth, int array_lsb, const std::string& filename,
+                   const VlSparseUnpacked<T_Value, N_Depth>* memp, QData start,
+                   QData end) VL_MT_SAFE {
+    const QData addr_max = array_lsb + depth - 1;
+    if (start < static_cast<QData>(array_lsb)) start = array_lsb;
+    if (end > addr_max) end = addr_max;
+    VlWriteMem wmem{hex, bits, filename, start, end};
+    if (VL_UNLIKELY(!wmem.isOpen())) return;
+    for (QData addr = start; addr <= end; ++addr) {
+        wmem.print(addr, false, &(memp->read(addr - array_lsb)));
+    }
+}
+
 //===================================================================
 // Helper to apply the given indices to a target expression
 
@@ -1649,18 +2188,23 @@ struct VlApplyIndices<N_Rank, N_Rank, T_Target> final {
 //   derived from the bit selects (_[3:1]), which masks the bits that
 //   need to be updated, and additionally the RHS is widened to a full
 //   element size, with the bits inserted into the masked region.
+//   With a non-zero N_Inline, the first N_Inline updates of an evaluation
+//   are kept in a fixed buffer, in which repeated updates of the same
+//   element are merged into a single entry, avoiding the allocation, and
+//   reducing the work at commit for memories updated at a few addresses.
 template <typename T_Target,  // Type of the variable this commit queue updates
           bool Partial,  // Whether partial element updates are necessary
           // The following we could figure out from 'T_Target using type traits, but passing
           // explicitly to avoid template expansion, as Verilator already knows them
           typename T_Element,  // Non-array leaf element type of T_Target array
-          std::size_t N_Rank  // Rank of T_Target (i.e.: how many dimensions it has)
+          std::size_t N_Rank,  // Rank of T_Target (i.e.: how many dimensions it has)
+          std::size_t N_Inline = 0  // Capacity of inline buffer for partial updates
           >
 class VlNBACommitQueue;
 
 // Specialization for whole element updates only
-template <typename T_Target, typename T_Element, std::size_t N_Rank>
-class VlNBACommitQueue<T_Target, /* Partial: */ false, T_Element, N_Rank> final {
+template <typename T_Target, typename T_Element, std::size_t N_Rank, std::size_t N_Inline>
+class VlNBACommitQueue<T_Target, /* Partial: */ false, T_Element, N_Rank, N_Inline> final {
     // TYPES
     struct Entry final {
         T_Element value;
@@ -1694,8 +2238,8 @@ public:
 };
 
 // With partial element updates
-template <typename T_Target, typename T_Element, std::size_t N_Rank>
-class VlNBACommitQueue<T_Target, /* Partial: */ true, T_Element, N_Rank> final {
+template <typename T_Target, typename T_Element, std::size_t N_Rank, std::size_t N_Inline>
+class VlNBACommitQueue<T_Target, /* Partial: */ true, T_Element, N_Rank, N_Inline> final {
     // TYPES
     struct Entry final {
         T_Element value;
@@ -1704,7 +2248,9 @@ class VlNBACommitQueue<T_Target, /* Partial: */ true, T_Element, N_Rank> final {
     };
 
     // STATE
-    std::vector<Entry> m_pending;  // Pending updates, in program order
+    std::array<Entry, N_Inline> m_inline;  // Pending updates, at most one per element
+    size_t m_nInline = 0;  // Number of valid entries in 'm_inline'
+    std::vector<Entry> m_pending;  // Pending updates after 'm_inline', in program order
 
     // STATIC METHODS
 
@@ -1755,6 +2301,15 @@ class VlNBACommitQueue<T_Target, /* Partial: */ true, T_Element, N_Rank> final {
         return result;
     }
 
+    // Apply a single pending update
+    template <typename T_Commit>
+    VL_ATTR_ALWINLINE static void apply(T_Commit& target, const Entry& entry) {
+        auto& ref = VlApplyIndices<0, N_Rank, T_Commit>::apply(target, entry.indices);
+        // Maybe inefficient, but it works for now ...
+        const auto oldValue = ref;
+        ref = bOr(bAnd(entry.value, entry.mask), bAnd(oldValue, bNot(entry.mask)));
+    }
+
 public:
     // CONSTRUCTOR
     VlNBACommitQueue() = default;
@@ -1763,20 +2318,34 @@ public:
     // METHODS
     template <typename... T_Args>
     void enqueue(const T_Element& value, const T_Element& mask, T_Args... indices) {
-        m_pending.emplace_back(Entry{value, mask, {indices...}});
+        const Entry entry{value, mask, {indices...}};
+        if (m_pending.empty()) {
+            // Merge into the latest update of the same element. Any later updates are
+            // to other elements, so the order relative to them does not matter.
+            for (size_t i = m_nInline; i-- > 0;) {
+                Entry& prev = m_inline[i];
+                if (std::equal(entry.indices, entry.indices + N_Rank, prev.indices)) {
+                    prev.value = bOr(bAnd(value, mask), bAnd(prev.value, bNot(mask)));
+                    prev.mask = bOr(prev.mask, mask);
+                    return;
+                }
+            }
+            if (m_nInline < N_Inline) {
+                m_inline[m_nInline++] = entry;
+                return;
+            }
+        }
+        m_pending.emplace_back(entry);
     }
 
     // Note: T_Commit might be different from T_Target. Specifically, when the signal is a
     // top-level IO port, T_Commit will be a native C array, while T_Target, will be a VlUnpacked
     template <typename T_Commit>
     void commit(T_Commit& target) {
+        for (size_t i = 0; i < m_nInline; ++i) apply(target, m_inline[i]);
+        m_nInline = 0;
         if (m_pending.empty()) return;
-        for (const Entry& entry : m_pending) {  //
-            auto& ref = VlApplyIndices<0, N_Rank, T_Commit>::apply(target, entry.indices);
-            // Maybe inefficient, but it works for now ...
-            const auto oldValue = ref;
-            ref = bOr(bAnd(entry.value, entry.mask), bAnd(oldValue, bNot(entry.mask)));
-        }
+        for (const Entry& entry : m_pending) apply(target, entry);
         m_pending.clear();
     }
 };
@@ -1823,6 +2392,71 @@ public:
     void deleteAll() VL_EXCLUDES(m_mutex) VL_EXCLUDES(m_deleteMutex) VL_MT_SAFE;
 };
 
+//===================================================================
+// Per-thread size-class free lists for class object allocations, so class objects that are
+// frequently created and destroyed do not need to go through the heap allocator each time.
+// Generated classes use it via VL_CLASS_POOL_ALLOC, define VL_NO_CLASS_POOL to disable.
+
+class VlClassPool final {
+    // CONSTANTS
+    static constexpr size_t GRANULE = 16;  // Size class granularity, keeps 'new' alignment
+    static constexpr size_t MAX_SIZE = 512;  // Larger objects always use the heap
+    static constexpr size_t N_LISTS = MAX_SIZE / GRANULE;
+    static constexpr uint32_t MAX_FREE = 256;  // Maximum free objects kept per size class
+
+    // TYPES
+    struct FreeNode final {
+        FreeNode* m_nextp;
+    };
+    // Trivially destructible, so objects freed during static destruction are still handled
+    struct FreeLists final {
+        FreeNode* m_headps[N_LISTS];  // Free objects of each size class
+        uint32_t m_counts[N_LISTS];  // Length of each free list
+    };
+
+    // MEMBERS
+    static thread_local FreeLists t_lists;
+
+public:
+    // METHODS
+    static void* allocate(size_t size) {
+        if (VL_UNLIKELY(size > MAX_SIZE || size == 0)) return ::operator new(size);
+        const size_t index = (size - 1) / GRANULE;
+        FreeNode* const nodep = t_lists.m_headps[index];
+        if (VL_LIKELY(nodep)) {
+            t_lists.m_headps[index] = nodep->m_nextp;
+            --t_lists.m_counts[index];
+            return nodep;
+        }
+        return ::operator new((index + 1) * GRANULE);
+    }
+    static void deallocate(void* ptr, size_t size) {
+        if (VL_UNLIKELY(size > MAX_SIZE || size == 0)) {
+            ::operator delete(ptr);
+            return;
+        }
+        const size_t index = (size - 1) / GRANULE;
+        if (VL_UNLIKELY(t_lists.m_counts[index] >= MAX_FREE)) {
+            ::operator delete(ptr);
+            return;
+        }
+        FreeNode* const nodep = static_cast<FreeNode*>(ptr);
+        nodep->m_nextp = t_lists.m_headps[index];
+        t_lists.m_headps[index] = nodep;
+        ++t_lists.m_counts[index];
+    }
+};
+
+// Class-specific allocation functions for generated classes. As classes have virtual
+// destructors, the size passed to 'operator delete' is the size of the most derived class.
+#ifdef VL_NO_CLASS_POOL
+#define VL_CLASS_POOL_ALLOC
+#else
+#define VL_CLASS_POOL_ALLOC \
+    static void* operator new(size_t size) { return VlClassPool::allocate(size); } \
+    static void operator delete(void* ptr, size_t size) { VlClassPool::deallocate(ptr, size); }
+#endif
+
 //===================================================================
 // Base class for all verilated classes. Includes a reference counter, and a pointer to the deleter
 // object that should destroy it after the counter reaches 0. This allows for easy construction of
@@ -1838,18 +2472,36 @@ class VlClass VL_NOT_FINAL : public VlDeletable {
     VlDeleter* m_deleterp = nullptr;  // The deleter that will delete this object
 
     // METHODS
-    // Atomically increments the reference counter
+    // Increments the reference counter, atomically if T_Atomic
+    template <bool T_Atomic>
     void refCountInc() VL_MT_SAFE {
         VL_DEBUG_IFDEF(assert(m_counter););  // If zero, we might have already deleted
-        ++m_counter;
+        if (T_Atomic) {
+            ++m_counter;
+        } else {
+            m_counter.store(m_counter.load(std::memory_order_relaxed) + 1,
+                            std::memory_order_relaxed);
+        }
     }
-    // Atomically decrements the reference counter. Assuming VlClassRef semantics are sound, it
-    // should never get called at m_counter == 0.
+    // Decrements the reference counter, atomically if T_Atomic. Assuming VlClassRef semantics
+    // are sound, it should never get called at m_counter == 0.
+    template <bool T_Atomic>
     void refCountDec() VL_MT_SAFE {
-        if (!--m_counter) m_deleterp->put(this);
+        size_t count;
+        if (T_Atomic) {
+            count = --m_counter;
+        } else {
+            count = m_counter.load(std::memory_order_relaxed) - 1;
+            m_counter.store(count, std::memory_order_relaxed);
+        }
+        if (!count) m_deleterp->put(this);
     }
 
 public:
+    // Models that only ever access class objects from a single thread declare this as false in
+    // their classes, to avoid the cost of atomic reference counting
+    static constexpr bool vlAtomicRefCount = true;
+
     // CONSTRUCTORS
     VlClass() {}
     VlClass(const VlClass& copied) {}
@@ -1886,11 +2538,11 @@ private:
     // METHODS
     // Increase reference counter with null check
     void refCountInc() const VL_MT_SAFE {
-        if (m_objp) m_objp->refCountInc();
+        if (m_objp) m_objp->template refCountInc<T_Class::vlAtomicRefCount>();
     }
     // Decrease reference counter with null check
     void refCountDec() const VL_MT_SAFE {
-        if (m_objp) m_objp->refCountDec();
+        if (m_objp) m_objp->template refCountDec<T_Class::vlAtomicRefCount>();
     }
 
 public:
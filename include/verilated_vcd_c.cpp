@@ -353,8 +353,7 @@ void VerilatedVcd::pushPrefix(const std::string& name, VerilatedTracePrefixType
     if (properScope) {
         printIndent(1);
         printStr("$scope module ");
-        const std::string n = lastWord(newPrefix);
-        printStr(n.c_str());
+        printStr(lastWordp(newPrefix));
         printStr(" $end\n");
     }
     m_prefixStack.emplace_back(newPrefix + (properScope ? " " : ""), type);
@@ -381,7 +380,7 @@ void VerilatedVcd::declare(uint32_t code, const char* name, const char* wirep, b
                            int arraynum, bool bussed, int msb, int lsb) {
     const int bits = ((msb > lsb) ? (msb - lsb) : (lsb - msb)) + 1;
 
-    const std::string hierarchicalName = m_prefixStack.back().first + name;
+    const std::string& hierarchicalName = declName(m_prefixStack.back().first, name);
 
     const bool enabled = Super::declCode(code, hierarchicalName, bits);
 
@@ -424,30 +423,29 @@ void VerilatedVcd::declare(uint32_t code, const char* name, const char* wirep, b
         entryBeginp[VL_TRACE_SUFFIX_ENTRY_SIZE - 1] = static_cast<char>(entryWritep - entryBeginp);
     }
 
-    // Assemble the declaration
-    std::string decl = "$var ";
-    decl += wirep;
-    decl += ' ';
-    decl += std::to_string(bits);
-    decl += ' ';
-    decl += vcdCode;
-    decl += ' ';
-    decl += lastWord(hierarchicalName);
+    // Emit the declaration
+    printIndent(0);
+    printStr("$var ");
+    printStr(wirep);
+    printStr(" ");
+    printStr(std::to_string(bits).c_str());
+    printStr(" ");
+    printStr(vcdCode);
+    printStr(" ");
+    printStr(lastWordp(hierarchicalName));
     if (array) {
-        decl += '[';
-        decl += std::to_string(arraynum);
-        decl += ']';
+        printStr("[");
+        printStr(std::to_string(arraynum).c_str());
+        printStr("]");
     }
     if (bussed) {
-        decl += " [";
-        decl += std::to_string(msb);
-        decl += ':';
-        decl += std::to_string(lsb);
-        decl += ']';
+        printStr(" [");
+        printStr(std::to_string(msb).c_str());
+        printStr(":");
+        printStr(std::to_string(lsb).c_str());
+        printStr("]");
     }
-    decl += " $end\n";
-    printIndent(0);
-    printStr(decl.c_str());
+    printStr(" $end\n");
 }
 
 void VerilatedVcd::declEvent(uint32_t code, uint32_t fidx, const char* name, int dtypenum,
@@ -665,8 +663,13 @@ void VerilatedVcdBuffer::emitWData(uint32_t code, const WData* newvalp, int bits
     const int bitsInMSW = VL_BITBIT_E(bits) ? VL_BITBIT_E(bits) : VL_EDATASIZE;
     cvtEDataToStr(wp, newvalp[--words] << (VL_EDATASIZE - bitsInMSW));
     wp += bitsInMSW;
-    // Handle the remaining words
-    while (words > 0) {
+    // Handle the remaining words, two at a time while we can
+    while (words > 1) {
+        words -= 2;
+        cvtQDataToStr(wp, VL_SET_QW(newvalp + words));
+        wp += 2 * VL_EDATASIZE;
+    }
+    if (words > 0) {
         cvtEDataToStr(wp, newvalp[--words]);
         wp += VL_EDATASIZE;
     }
@@ -171,6 +171,12 @@ template <>
 void VerilatedVcd::Super::set_time_resolution(const std::string& unit);
 template <>
 void VerilatedVcd::Super::dumpvars(int level, const std::string& hier);
+template <>
+void VerilatedVcd::Super::traceScopes(const std::string& scopes);
+template <>
+void VerilatedVcd::Super::flightRecorder(uint64_t cycles);
+template <>
+void VerilatedVcd::Super::flightRecorderTrigger();
 #endif  // DOXYGEN
 
 //=============================================================================
@@ -321,6 +327,15 @@ public:
     void dumpvars(int level, const std::string& hier) VL_MT_SAFE {
         m_sptrace.dumpvars(level, hier);
     }
+    /// Trace only signals under the given scopes, see VerilatedTraceBaseC
+    void traceScopes(const std::string& scopes) override VL_MT_SAFE {
+        m_sptrace.traceScopes(scopes);
+    }
+    // Only keep the last 'cycles' dumps in memory, until triggered by
+    // flightRecorderTrigger() or $dumpon. Call before open().
+    void flightRecorder(uint64_t cycles) VL_MT_SAFE { m_sptrace.flightRecorder(cycles); }
+    // Write the flight recorder contents, then continue dumping as normal
+    void flightRecorderTrigger() VL_MT_SAFE { m_sptrace.flightRecorderTrigger(); }
 
     // Internal class access
     VerilatedVcd* spTrace() { return &m_sptrace; }
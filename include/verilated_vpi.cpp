@@ -39,6 +39,7 @@
 #include <map>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -170,15 +171,14 @@ class VerilatedVpioVarBase VL_NOT_FINAL : public VerilatedVpio {
 protected:
     const VerilatedVar* m_varp = nullptr;
     const VerilatedScope* m_scopep = nullptr;
-    std::string m_fullname;
+    mutable std::string m_fullname;  // Full name, built when first needed
     int32_t m_indexedDim = -1;
     const VerilatedRange* get_range() const { return m_varp->range(m_indexedDim + 1); }
 
 public:
     VerilatedVpioVarBase(const VerilatedVar* varp, const VerilatedScope* scopep)
         : m_varp{varp}
-        , m_scopep{scopep}
-        , m_fullname{std::string{m_scopep->name()} + '.' + m_varp->name()} {}
+        , m_scopep{scopep} {}
     explicit VerilatedVpioVarBase(const VerilatedVpioVarBase* varp) {
         if (varp) {
             m_varp = varp->m_varp;
@@ -219,7 +219,10 @@ public:
     }
     const VerilatedRange* rangep() const override { return get_range(); }
     const char* name() const override { return m_varp->name(); }
-    const char* fullname() const override { return m_fullname.c_str(); }
+    const char* fullname() const override {
+        if (m_fullname.empty()) m_fullname = std::string{m_scopep->name()} + '.' + m_varp->name();
+        return m_fullname.c_str();
+    }
     virtual void* varDatap() const { return m_varp->datap(); }
     CData* varCDatap() const {
         VL_DEBUG_IFDEF(assert(varp()->vltype() == VLVT_UINT8););
@@ -454,6 +457,21 @@ public:
         return dynamic_cast<VerilatedVpioVarIter*>(reinterpret_cast<VerilatedVpio*>(h));
     }
     uint32_t type() const override { return vpiIterator; }
+    // New handle for a variable of 'scopep', preferring the TOP port of the same name
+    static vpiHandle newVarHandle(const VerilatedVar* varp, const VerilatedScope* scopep,
+                                  const VerilatedScope* topscopep) {
+        if (VL_UNLIKELY(topscopep)) {
+            if (const VerilatedVar* topvarp = topscopep->varFind(varp->name())) {
+                varp = topvarp;
+                scopep = topscopep;
+            }
+        }
+        if (varp->isParam()) {
+            return ((new VerilatedVpioParam{varp, scopep})->castVpiHandle());
+        } else {
+            return ((new VerilatedVpioVar{varp, scopep})->castVpiHandle());
+        }
+    }
     vpiHandle dovpi_scan() override {
         if (VL_UNLIKELY(!m_scopep->varsp())) {
             delete this;  // IEEE 37.2.2 vpi_scan at end does a vpi_release_handle
@@ -475,20 +493,7 @@ public:
                 return nullptr;
             }
             if (m_onlyParams && !m_it->second.isParam()) continue;
-            if (VL_UNLIKELY(m_topscopep)) {
-                if (const VerilatedVar* topvarp = m_topscopep->varFind(m_it->second.name())) {
-                    if (topvarp->isParam()) {
-                        return ((new VerilatedVpioParam{topvarp, m_topscopep})->castVpiHandle());
-                    } else {
-                        return ((new VerilatedVpioVar{topvarp, m_topscopep})->castVpiHandle());
-                    }
-                }
-            }
-            if (m_it->second.isParam()) {
-                return ((new VerilatedVpioParam{&(m_it->second), m_scopep})->castVpiHandle());
-            } else {
-                return ((new VerilatedVpioVar{&(m_it->second), m_scopep})->castVpiHandle());
-            }
+            return newVarHandle(&(m_it->second), m_scopep, m_topscopep);
         }
     }
 };
@@ -869,18 +874,29 @@ class VerilatedVpiImp final {
     enum { CB_ENUM_MAX_VALUE = cbAtEndOfSimTime + 1 };  // Maximum callback reason
     using VpioCbList = std::list<VerilatedVpiCbHolder>;
     using VpioFutureCbs = std::map<std::pair<QData, uint64_t>, VerilatedVpiCbHolder>;
+    using NameCache
+        = std::unordered_map<std::string, std::pair<const VerilatedScope*, const VerilatedVar*>>;
 
     // All only medium-speed, so use singleton function
     // Callbacks that are past or at current timestamp
     std::array<VpioCbList, CB_ENUM_MAX_VALUE> m_cbCurrentLists;
     VpioCbList m_cbCallList;  // List of callbacks currently being called by callCbs
+    // Valid callbacks in m_cbCurrentLists or m_cbCallList, by id, for removal without a search
+    std::unordered_map<uint64_t, VerilatedVpiCbHolder*> m_cbCurrentIds;
+    // Number of valid callbacks of each reason in m_cbCurrentLists or m_cbCallList
+    std::array<size_t, CB_ENUM_MAX_VALUE> m_cbCurrentCounts{};
     VpioFutureCbs m_futureCbs;  // Time based callbacks for future timestamps
     VpioFutureCbs m_nextCbs;  // cbNextSimTime callbacks
     std::list<VerilatedVpiPutHolder> m_inertialPuts;  // Pending vpi puts due to vpiInertialDelay
+    std::vector<VerilatedVpiBatch*> m_deferredBatches;  // Batches with pending putDeferred()
     VerilatedVpiError* m_errorInfop = nullptr;  // Container for vpi error info
     VerilatedAssertOneThread m_assertOne;  // Assert only called from single thread
     uint64_t m_nextCallbackId = 1;  // Id to identify callback
     bool m_evalNeeded = false;  // Model has had signals updated via vpi_put_value()
+    // vpi_handle_by_name variable lookups, valid while no scopes are added or removed
+    NameCache m_nameCache;
+    const VerilatedContext* m_nameCacheContextp = nullptr;  // Context m_nameCache is for
+    uint64_t m_nameCacheGeneration = 0;  // Scope generation m_nameCache is for
 
     static VerilatedVpiImp& s() {  // Singleton
         static VerilatedVpiImp s_s;
@@ -891,6 +907,20 @@ public:
     static void assertOneCheck() { s().m_assertOne.check(); }
     static uint64_t nextCallbackId() { return ++s().m_nextCallbackId; }
 
+    template <typename... T_Args>
+    static void cbCurrentEmplace(uint32_t reason, T_Args&&... args) {
+        VpioCbList& cbObjList = s().m_cbCurrentLists[reason];
+        cbObjList.emplace_back(std::forward<T_Args>(args)...);
+        s().m_cbCurrentIds.emplace(cbObjList.back().id(), &cbObjList.back());
+        ++s().m_cbCurrentCounts[reason];
+    }
+    static void cbCurrentInvalidate(VerilatedVpiCbHolder& ho) {
+        // Entry stays in its list until the list is next iterated
+        s().m_cbCurrentIds.erase(ho.id());
+        --s().m_cbCurrentCounts[ho.cb_datap()->reason];
+        ho.invalidate();
+    }
+
     static void cbCurrentAdd(uint64_t id, const s_cb_data* cb_data_p) {
         // The passed cb_data_p was property of the user, so need to recreate
         if (VL_UNCOVERABLE(cb_data_p->reason >= CB_ENUM_MAX_VALUE)) {
@@ -900,7 +930,7 @@ public:
                                     cb_data_p->reason, id, cb_data_p->obj););
         VerilatedVpioVar* varop = nullptr;
         if (cb_data_p->reason == cbValueChange) varop = VerilatedVpioVar::castp(cb_data_p->obj);
-        s().m_cbCurrentLists[cb_data_p->reason].emplace_back(id, cb_data_p, varop);
+        cbCurrentEmplace(cb_data_p->reason, id, cb_data_p, varop);
     }
     static void cbFutureAdd(uint64_t id, const s_cb_data* cb_data_p, QData time) {
         // The passed cb_data_p was property of the user, so need to recreate
@@ -918,20 +948,15 @@ public:
         s().m_nextCbs.emplace(std::piecewise_construct, std::forward_as_tuple(time, id),
                               std::forward_as_tuple(id, cb_data_p, nullptr));
     }
-    static void cbReasonRemove(uint64_t id, uint32_t reason, QData time) {
+    static void cbReasonRemove(uint64_t id, uint32_t /*reason*/, QData time) {
         // Id might no longer exist, if already removed due to call after event, or teardown
         // We do not remove it now as we may be iterating the list,
         // instead set to nullptr and will cleanup later
-        // Remove from cbCurrent queue
-        for (auto& ir : s().m_cbCurrentLists[reason]) {
-            if (ir.id() == id) {
-                ir.invalidate();
-                return;  // Once found, it won't also be in m_cbCallList, m_futureCbs, or m_nextCbs
-            }
-        }
-        for (auto& ir : s().m_cbCallList) {
-            if (ir.id() == id) {
-                ir.invalidate();
+        // Remove from cbCurrent queue, or m_cbCallList
+        {
+            const auto it = s().m_cbCurrentIds.find(id);
+            if (it != s().m_cbCurrentIds.end()) {
+                cbCurrentInvalidate(*it->second);
                 return;  // Once found, it won't also be in m_futureCbs or m_nextCbs
             }
         }
@@ -962,7 +987,7 @@ public:
             ++it;
             if (VL_UNLIKELY(!hor.invalid())) {
                 VL_DEBUG_IF_PLI(VL_DBG_MSGF("- vpi: moveFutureCbs id=%" PRId64 "\n", hor.id()););
-                s().m_cbCurrentLists[hor.cb_datap()->reason].emplace_back(hor);
+                cbCurrentEmplace(hor.cb_datap()->reason, hor);
             }
             s().m_futureCbs.erase(last_it);
         }
@@ -973,7 +998,7 @@ public:
             ++it;
             if (VL_UNLIKELY(!hor.invalid())) {
                 VL_DEBUG_IF_PLI(VL_DBG_MSGF("- vpi: moveFutureCbs id=%" PRId64 "\n", hor.id()););
-                s().m_cbCurrentLists[hor.cb_datap()->reason].emplace_back(hor);
+                cbCurrentEmplace(hor.cb_datap()->reason, hor);
             }
             s().m_nextCbs.erase(last_it);
         }
@@ -984,13 +1009,17 @@ public:
         return ~0ULL;  // maxquad
     }
     static bool hasCbs(const uint32_t reason) VL_MT_UNSAFE_ONE {
-        return !s().m_cbCurrentLists[reason].empty();
+        return s().m_cbCurrentCounts[reason] != 0;
     }
     static bool callCbs(const uint32_t reason) VL_MT_UNSAFE_ONE {
         VL_DEBUG_IF_PLI(VL_DBG_MSGF("- vpi: callCbs reason=%u\n", reason););
         assertOneCheck();
         moveFutureCbs();
-        if (s().m_cbCurrentLists[reason].empty()) return false;
+        if (!s().m_cbCurrentCounts[reason]) {
+            // Nothing to call, drop any removed callbacks (callValueCbs cleans up its own list)
+            if (reason != cbValueChange) s().m_cbCurrentLists[reason].clear();
+            return false;
+        }
         // Iterate on old list, making new list empty, to prevent looping over newly added elements
         std::swap(s().m_cbCurrentLists[reason], s().m_cbCallList);
         bool called = false;
@@ -999,7 +1028,7 @@ public:
             if (VL_LIKELY(!ihor.invalid())) {  // Not deleted earlier
                 VL_DEBUG_IF_PLI(VL_DBG_MSGF("- vpi: reason_callback reason=%d id=%" PRId64 "\n",
                                             reason, ihor.id()););
-                ihor.invalidate();  // Timed callbacks are one-shot
+                cbCurrentInvalidate(ihor);  // Timed callbacks are one-shot
                 (ihor.cb_rtnp())(ihor.cb_datap());
                 called = true;
             }
@@ -1012,6 +1041,7 @@ public:
         VpioCbList& cbObjList = s().m_cbCurrentLists[cbValueChange];
         bool called = false;
         std::set<VerilatedVpioVar*> update;  // set of objects to update after callbacks
+        std::set<CData*> dirties;  // Dirty flags to clear after callbacks
         if (cbObjList.empty()) return called;
         const auto last = std::prev(cbObjList.end());  // prevent looping over newly added elements
         for (auto it = cbObjList.begin(); true;) {
@@ -1025,6 +1055,14 @@ public:
             VerilatedVpiCbHolder& ho = *it++;
             VerilatedVpioVar* const varop
                 = reinterpret_cast<VerilatedVpioVar*>(ho.cb_datap()->obj);
+            // With --vpi-dirty, variables not written since the last call are unchanged
+            if (CData* const dirtyp = varop->varp()->dirtyp()) {
+                if (!*dirtyp) {
+                    if (was_last) break;
+                    continue;
+                }
+                dirties.insert(dirtyp);
+            }
             void* const newDatap = varop->varDatap();
             void* const prevDatap = varop->prevDatap();  // Was malloced when we added the callback
             VL_DEBUG_IF_PLI(VL_DBG_MSGF("- vpi: value_test %s v[0]=%d/%d %p %p\n",
@@ -1044,8 +1082,21 @@ public:
         for (const auto& ip : update) {
             std::memcpy(ip->prevDatap(), ip->varDatap(), ip->entSize());
         }
+        for (CData* const dirtyp : dirties) *dirtyp = 0;
         return called;
     }
+    static NameCache& nameCache() VL_MT_UNSAFE_ONE {
+        // Drop all entries if the scopes may have changed since they were found
+        VerilatedContext* const contextp = Verilated::threadContextp();
+        const uint64_t generation = contextp->impp()->scopeGeneration();
+        if (VL_UNLIKELY(s().m_nameCacheContextp != contextp
+                        || s().m_nameCacheGeneration != generation)) {
+            s().m_nameCache.clear();
+            s().m_nameCacheContextp = contextp;
+            s().m_nameCacheGeneration = generation;
+        }
+        return s().m_nameCache;
+    }
     static void dumpCbs() VL_MT_UNSAFE_ONE;
     static VerilatedVpiError* error_info() VL_MT_UNSAFE_ONE;  // getter for vpi error info
     static bool evalNeeded() { return s().m_evalNeeded; }
@@ -1053,11 +1104,27 @@ public:
     static void inertialDelay(const VerilatedVpioVar* vop, p_vpi_value valuep) {
         s().m_inertialPuts.emplace_back(vop, valuep);
     }
+    static void deferredBatchAdd(VerilatedVpiBatch* batchp) {
+        s().m_deferredBatches.push_back(batchp);
+    }
+    static void deferredBatchRemove(const VerilatedVpiBatch* batchp) {
+        auto& batches = s().m_deferredBatches;
+        batches.erase(std::remove(batches.begin(), batches.end(), batchp), batches.end());
+    }
     static void doInertialPuts() {
         for (auto& it : s().m_inertialPuts) {
             vpi_put_value(it.varp()->castVpiHandle(), it.valuep(), nullptr, vpiNoDelay);
         }
         s().m_inertialPuts.clear();
+        if (!s().m_deferredBatches.empty()) {
+            for (VerilatedVpiBatch* const batchp : s().m_deferredBatches) {
+                batchp->write(batchp->m_deferred.data());
+                batchp->m_deferred.clear();
+            }
+            s().m_deferredBatches.clear();
+            evalNeeded(true);
+            Verilated::threadContextp()->signalsWritten();
+        }
     }
 };
 
@@ -1170,6 +1237,27 @@ bool VerilatedVpi::evalNeeded() VL_MT_UNSAFE_ONE { return VerilatedVpiImp::evalN
 
 void VerilatedVpi::doInertialPuts() VL_MT_UNSAFE_ONE { VerilatedVpiImp::doInertialPuts(); }
 
+size_t VerilatedVpi::scopeVars(vpiHandle scope, std::vector<vpiHandle>& handles) VL_MT_UNSAFE_ONE {
+    VerilatedVpiImp::assertOneCheck();
+    VL_VPI_ERROR_RESET_();
+    const VerilatedVpioScope* const vop = VerilatedVpioScope::castp(scope);
+    if (VL_UNLIKELY(!vop)) {
+        VL_VPI_WARNING_(__FILE__, __LINE__, "%s: Unsupported handle type %s", __func__,
+                        VerilatedVpiError::strFromVpiObjType(vpi_get(vpiType, scope)));
+        return 0;
+    }
+    const VerilatedVarNameMap* const varsp = vop->scopep()->varsp();
+    if (!varsp) return 0;
+    // Same handles as vpi_iterate(vpiReg, scope) followed by vpi_scan
+    const VerilatedScope* const topscopep
+        = VL_UNLIKELY(vop->toplevel()) ? Verilated::threadContextp()->scopeFind("TOP") : nullptr;
+    handles.reserve(handles.size() + varsp->size());
+    for (const auto& it : *varsp) {
+        handles.push_back(VerilatedVpioVarIter::newVarHandle(&it.second, vop->scopep(), topscopep));
+    }
+    return varsp->size();
+}
+
 //======================================================================
 // VerilatedVpiImp implementation
 
@@ -2064,7 +2152,12 @@ vpiHandle vpi_handle_by_name(PLI_BYTE8* namep, vpiHandle scope) {
         scopeAndName = std::string{voScopep->fullname()} + (scopeIsPackage ? "" : ".") + namep;
         namep = const_cast<PLI_BYTE8*>(scopeAndName.c_str());
     }
-    {
+    auto& nameCache = VerilatedVpiImp::nameCache();
+    const auto cacheIt = nameCache.find(scopeAndName);
+    if (cacheIt != nameCache.end()) {
+        scopep = cacheIt->second.first;
+        varp = cacheIt->second.second;
+    } else {
         // This doesn't yet follow the hierarchy in the proper way
         bool isPackage = false;
         scopep = Verilated::threadContextp()->scopeFind(namep);
@@ -2116,8 +2209,9 @@ vpiHandle vpi_handle_by_name(PLI_BYTE8* namep, vpiHandle scope) {
             if (!scopep) return nullptr;
             varp = scopep->varFind(basename.c_str());
         }
+        if (!varp) return nullptr;
+        nameCache.emplace(scopeAndName, std::make_pair(scopep, varp));
     }
-    if (!varp) return nullptr;
 
     if (varp->isParam()) {
         return (new VerilatedVpioParam{varp, scopep})->castVpiHandle();
@@ -2756,6 +2850,8 @@ vpiHandle vpi_put_value(vpiHandle object, p_vpi_value valuep, p_vpi_time /*time_
             return object;
         }
         VerilatedVpiImp::evalNeeded(true);
+        Verilated::threadContextp()->signalsWritten();
+        if (CData* const dirtyp = vop->varp()->dirtyp()) *dirtyp = 1;
         const int varBits = vop->bitSize();
         if (valuep->format == vpiVectorVal) {
             if (VL_UNLIKELY(!valuep->value.vector)) return nullptr;
@@ -3512,6 +3608,7 @@ void vpi_put_value_array(vpiHandle object, p_vpi_arrayvalue arrayvalue_p, PLI_IN
         return;
     }
 
+    if (CData* const dirtyp = vop->varp()->dirtyp()) *dirtyp = 1;
     vl_put_value_array(object, arrayvalue_p, index_p, num);
 }
 
@@ -3708,3 +3805,119 @@ vpiHandle vpi_handle_by_multi_index(vpiHandle /*obj*/, PLI_INT32 /*num_index*/,
     VL_VPI_UNIMP_();
     return nullptr;
 }
+
+//======================================================================
+// VerilatedVpiBatch implementation
+
+bool VerilatedVpiBatch::add(vpiHandle object) VL_MT_UNSAFE_ONE {
+    VL_DEBUG_IF_PLI(VL_DBG_MSGF("- vpi: VerilatedVpiBatch::add %p\n", object););
+    VerilatedVpiImp::assertOneCheck();
+    VL_VPI_ERROR_RESET_();
+    const VerilatedVpioVar* const vop = VerilatedVpioVar::castp(object);
+    if (VL_UNLIKELY(!vop)) {
+        VL_VPI_ERROR_(__FILE__, __LINE__, "%s: Unsupported handle (%p)", __func__, object);
+        return false;
+    }
+    if (VL_UNLIKELY(!m_deferred.empty())) {
+        VL_VPI_ERROR_(__FILE__, __LINE__, "%s: Called with a putDeferred() pending", __func__);
+        return false;
+    }
+    const VerilatedVar* const varp = vop->varp();
+    const bool memory = vop->isIndexedDimUnpacked();
+    // Must address whole elements, not a bit or part-select of one
+    if (VL_UNLIKELY(vop->bitOffset() || (!memory && vop->indexedDim() + 1 != varp->udims()))) {
+        VL_VPI_ERROR_(__FILE__, __LINE__, "%s: Unsupported part-select handle for %s",
+                      __func__, vop->fullname());
+        return false;
+    }
+    uint32_t entBits = 0;
+    switch (varp->vltype()) {
+    case VLVT_UINT8:
+    case VLVT_UINT16:
+    case VLVT_UINT32:
+    case VLVT_UINT64:
+    case VLVT_WDATA:
+        entBits = varp->entBits();
+        if (entBits == vop->entSize() * 8) entBits = 0;
+        break;
+    case VLVT_REAL: break;
+    default:
+        VL_VPI_ERROR_(__FILE__, __LINE__, "%s: Unsupported vltype (%d) for %s", __func__,
+                      varp->vltype(), vop->fullname());
+        return false;
+    }
+    Entry entry;
+    entry.m_datap = static_cast<uint8_t*>(vop->varDatap());
+    entry.m_offset = m_bytes;
+    entry.m_entSize = vop->entSize();
+    entry.m_entBits = entBits;
+    entry.m_count = memory ? vop->size() : 1;
+    entry.m_writable = varp->isPublicRW();
+    entry.m_dirtyp = varp->dirtyp();
+    m_entries.push_back(entry);
+    m_bytes += static_cast<size_t>(entry.m_entSize) * entry.m_count;
+    return true;
+}
+
+void VerilatedVpiBatch::get(void* bufp) const VL_MT_UNSAFE_ONE {
+    VerilatedVpiImp::assertOneCheck();
+    uint8_t* const outp = static_cast<uint8_t*>(bufp);
+    for (const Entry& entry : m_entries) {
+        std::memcpy(outp + entry.m_offset, entry.m_datap,
+                    static_cast<size_t>(entry.m_entSize) * entry.m_count);
+    }
+}
+
+VerilatedVpiBatch::~VerilatedVpiBatch() VL_MT_UNSAFE_ONE {
+    if (!m_deferred.empty()) VerilatedVpiImp::deferredBatchRemove(this);
+}
+
+void VerilatedVpiBatch::put(const void* bufp) VL_MT_UNSAFE_ONE {
+    VerilatedVpiImp::assertOneCheck();
+    VL_VPI_ERROR_RESET_();
+    write(static_cast<const uint8_t*>(bufp));
+    VerilatedVpiImp::evalNeeded(true);
+    Verilated::threadContextp()->signalsWritten();
+}
+
+void VerilatedVpiBatch::putDeferred(const void* bufp) VL_MT_UNSAFE_ONE {
+    VerilatedVpiImp::assertOneCheck();
+    if (VL_UNLIKELY(!m_bytes)) return;
+    if (m_deferred.empty()) VerilatedVpiImp::deferredBatchAdd(this);
+    const uint8_t* const inp = static_cast<const uint8_t*>(bufp);
+    m_deferred.assign(inp, inp + m_bytes);
+}
+
+void VerilatedVpiBatch::write(const uint8_t* inp) VL_MT_UNSAFE_ONE {
+    for (const Entry& entry : m_entries) {
+        if (VL_UNLIKELY(!entry.m_writable)) {
+            VL_VPI_ERROR_(__FILE__, __LINE__,
+                          "VerilatedVpiBatch::put was used on signal marked read-only,"
+                          " use public_flat_rw instead");
+            continue;
+        }
+        std::memcpy(entry.m_datap, inp + entry.m_offset,
+                    static_cast<size_t>(entry.m_entSize) * entry.m_count);
+        if (entry.m_dirtyp) *entry.m_dirtyp = 1;
+        if (!entry.m_entBits) continue;
+        // Clear bits above the variable width, which the model presumes are zero
+        for (uint32_t i = 0; i < entry.m_count; ++i) {
+            uint8_t* const datap = entry.m_datap + static_cast<size_t>(i) * entry.m_entSize;
+            switch (entry.m_entSize) {
+            case sizeof(CData): *datap &= VL_MASK_I(entry.m_entBits); break;
+            case sizeof(SData):
+                *reinterpret_cast<SData*>(datap) &= VL_MASK_I(entry.m_entBits);
+                break;
+            case sizeof(IData):
+                *reinterpret_cast<IData*>(datap) &= VL_MASK_I(entry.m_entBits);
+                break;
+            case sizeof(QData):
+                *reinterpret_cast<QData*>(datap) &= VL_MASK_Q(entry.m_entBits);
+                break;
+            default:  // WData, always wider than QData
+                reinterpret_cast<EData*>(datap)[VL_WORDS_I(entry.m_entBits) - 1]
+                    &= VL_MASK_E(entry.m_entBits);
+            }
+        }
+    }
+}
@@ -62,11 +62,76 @@ public:
     static bool evalNeeded() VL_MT_UNSAFE_ONE;
     /// Clears VPI dirty state (see evalNeeded())
     static void clearEvalNeeded() VL_MT_UNSAFE_ONE;
-    /// Perform inertially delayed puts
+    /// Perform inertially delayed puts, and deferred VerilatedVpiBatch puts
     static void doInertialPuts() VL_MT_UNSAFE_ONE;
+    /// Verilator extension: append to handles a handle for each variable and
+    /// parameter of a module or scope handle, the same handles as scanning
+    /// vpi_iterate(vpiReg, scope), in one call; returns the number appended.
+    /// The caller must vpi_release_handle each of them.
+    static size_t scopeVars(vpiHandle scope, std::vector<vpiHandle>& handles) VL_MT_UNSAFE_ONE;
 
     // Self test, for internal use only
     static void selfTest() VL_MT_UNSAFE_ONE;
 };
 
+//======================================================================
+/// Verilator extension: list of variable and memory handles read or
+/// written together.  Handles are resolved once by add(); get() and put()
+/// then copy the values of all of them in one call, without the per-call
+/// format dispatch of vpi_get_value/vpi_put_value.
+///
+/// Values are in Verilator's internal storage format: each element takes
+/// 1, 2, 4 or 8 bytes, or a multiple of 4 bytes when wider than 64 bits,
+/// in host byte order.  A memory handle contributes all of its elements.
+///
+/// putDeferred() instead keeps a copy of the values, which the next
+/// VerilatedVpi::doInertialPuts() writes, together with those of all other
+/// deferred batches.
+
+class VerilatedVpiBatch final {
+    friend class VerilatedVpiImp;
+
+    // TYPES
+    struct Entry final {
+        uint8_t* m_datap;  // Variable storage
+        size_t m_offset;  // Offset of value in the batch buffer
+        uint32_t m_entSize;  // Bytes per element
+        uint32_t m_entBits;  // Bits per element, 0 if no masking needed
+        uint32_t m_count;  // Number of elements
+        bool m_writable;  // Variable is public_flat_rw
+        CData* m_dirtyp;  // Variable's --vpi-dirty flag, or nullptr
+    };
+
+    // MEMBERS
+    std::vector<Entry> m_entries;  // Resolved handles, in order added
+    size_t m_bytes = 0;  // Size of the batch buffer
+    std::vector<uint8_t> m_deferred;  // Values to write on doInertialPuts, if non-empty
+
+    VL_UNCOPYABLE(VerilatedVpiBatch);
+    void write(const uint8_t* inp) VL_MT_UNSAFE_ONE;
+
+public:
+    // CONSTRUCTORS
+    VerilatedVpiBatch() = default;
+    ~VerilatedVpiBatch() VL_MT_UNSAFE_ONE;
+
+    // METHODS
+    /// Add a variable or memory handle; returns false with a VPI error if unsupported,
+    /// e.g. a string or a part-select handle, or if a putDeferred() is pending
+    bool add(vpiHandle object) VL_MT_UNSAFE_ONE;
+    /// Number of handles added
+    size_t size() const { return m_entries.size(); }
+    /// Byte offset into the batch buffer of the value of the index'th handle
+    size_t offset(size_t index) const { return m_entries[index].m_offset; }
+    /// Size in bytes of the buffer used by get() and put()
+    size_t bytes() const { return m_bytes; }
+    /// Copy the values of all handles into bufp, which must hold bytes()
+    void get(void* bufp) const VL_MT_UNSAFE_ONE;
+    /// Copy the values of all handles from bufp, which must hold bytes()
+    void put(const void* bufp) VL_MT_UNSAFE_ONE;
+    /// As put(), but only on the next VerilatedVpi::doInertialPuts(); a later
+    /// putDeferred() before then replaces the values
+    void putDeferred(const void* bufp) VL_MT_UNSAFE_ONE;
+};
+
 #endif  // Guard
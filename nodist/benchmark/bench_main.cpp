@@ -0,0 +1,52 @@
+// DESCRIPTION: Verilator: Benchmark driver, see nodist/benchmark/verilator_benchmark
+//
+// Toggles the 'clk' input of the Vbench model until $finish, then prints
+// the number of clock cycles simulated for the benchmark runner.
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+#include <verilated.h>
+#if VM_TRACE
+#include <verilated_vcd_c.h>
+#endif
+
+#include "Vbench.h"
+
+#include <cinttypes>
+#include <cstdio>
+#include <memory>
+
+int main(int argc, char** argv) {
+    const std::unique_ptr<VerilatedContext> contextp{new VerilatedContext};
+    contextp->commandArgs(argc, argv);
+    const std::unique_ptr<Vbench> topp{new Vbench{contextp.get()}};
+
+#if VM_TRACE
+    contextp->traceEverOn(true);
+    const std::unique_ptr<VerilatedVcdC> tfp{new VerilatedVcdC};
+    topp->trace(tfp.get(), 99);
+    tfp->open("bench.vcd");
+#endif
+
+    uint64_t cycles = 0;
+    topp->clk = 0;
+    topp->eval();
+    while (!contextp->gotFinish()) {
+        contextp->timeInc(1);
+        topp->clk = !topp->clk;
+        topp->eval();
+#if VM_TRACE
+        tfp->dump(contextp->time());
+#endif
+        if (topp->clk) ++cycles;
+    }
+    topp->final();
+#if VM_TRACE
+    tfp->close();
+#endif
+
+    printf("bench cycles %" PRIu64 "\n", cycles);
+    return 0;
+}
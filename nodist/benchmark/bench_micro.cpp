@@ -0,0 +1,392 @@
+// DESCRIPTION: Verilator: Microbenchmarks of runtime primitives, see verilator_benchmark
+//
+// Times the hot primitives of the Verilated runtime in isolation: wide
+// arithmetic, queues, associative arrays, trigger vectors, NBA commit
+// queues, coroutine resumption, and VCD value emission.  Each benchmark
+// body runs a given number of iterations; the harness grows the count
+// until a run takes --min-time, and reports the best nanoseconds per
+// iteration of --repeats runs.
+//
+// Usage: bench_micro [--filter <regex>] [--json <filename>] [--min-time <seconds>]
+//                    [--repeats <count>]
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+#include <verilated.h>
+#include <verilated_timing.h>
+#include <verilated_types.h>
+#include <verilated_vcd_c.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <regex>
+#include <string>
+#include <vector>
+
+//======================================================================
+// Harness
+
+using BenchFunc = void (*)(uint64_t iterations);
+
+struct MicroBench final {
+    const char* name;
+    BenchFunc func;
+};
+
+static std::vector<MicroBench>& microBenches() {
+    static std::vector<MicroBench> s_benches;
+    return s_benches;
+}
+
+static bool registerBench(const char* name, BenchFunc func) {
+    microBenches().push_back(MicroBench{name, func});
+    return true;
+}
+
+// Define a benchmark 'name', whose body runs 'iterations' times
+#define MICRO_BENCH(name) \
+    static void name(uint64_t iterations); \
+    static const bool name##_registered VL_ATTR_UNUSED = registerBench(#name, name); \
+    static void name(uint64_t iterations)
+
+// Keep the compiler from optimizing away a value or the stores to it
+template <typename T>
+static inline void doNotOptimize(T& value) {
+    asm volatile("" : "+m"(value) : : "memory");
+}
+
+static double runSeconds(BenchFunc func, uint64_t iterations) {
+    const auto start = std::chrono::steady_clock::now();
+    func(iterations);
+    const auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(end - start).count();
+}
+
+//======================================================================
+// Wide arithmetic, verilated_funcs.h
+
+static constexpr int WIDE_WORDS = 32;  // 1024 bits
+
+struct WideOperands final {
+    VlWide<WIDE_WORDS> a;
+    VlWide<WIDE_WORDS> b;
+    VlWide<WIDE_WORDS> out;
+    WideOperands() {
+        for (int i = 0; i < WIDE_WORDS; ++i) {
+            a[i] = 0x9e3779b9U * (i + 1);
+            b[i] = 0x85ebca6bU * (i + 7);
+            out[i] = 0;
+        }
+    }
+};
+
+MICRO_BENCH(wide_add_1024) {
+    WideOperands w;
+    for (uint64_t i = 0; i < iterations; ++i) {
+        VL_ADD_W(WIDE_WORDS, w.out, w.a, w.out);
+        doNotOptimize(w.out);
+    }
+}
+
+MICRO_BENCH(wide_add_1024_template) {
+    WideOperands w;
+    for (uint64_t i = 0; i < iterations; ++i) {
+        VL_ADD_W<WIDE_WORDS>(w.out, w.a, w.out);
+        doNotOptimize(w.out);
+    }
+}
+
+MICRO_BENCH(wide_xor_1024) {
+    WideOperands w;
+    for (uint64_t i = 0; i < iterations; ++i) {
+        VL_XOR_W(WIDE_WORDS, w.out, w.a, w.out);
+        doNotOptimize(w.out);
+    }
+}
+
+MICRO_BENCH(wide_eq_1024) {
+    WideOperands w;
+    IData sum = 0;
+    for (uint64_t i = 0; i < iterations; ++i) {
+        doNotOptimize(w.a);
+        sum += VL_EQ_W(WIDE_WORDS, w.a, w.b);
+    }
+    doNotOptimize(sum);
+}
+
+MICRO_BENCH(wide_shiftl_1024) {
+    WideOperands w;
+    for (uint64_t i = 0; i < iterations; ++i) {
+        VL_SHIFTL_WWI(1024, 1024, 32, w.out, w.a, static_cast<IData>(i & 1023));
+        doNotOptimize(w.out);
+    }
+}
+
+MICRO_BENCH(wide_mul_256) {
+    WideOperands w;
+    for (uint64_t i = 0; i < iterations; ++i) {
+        VL_MUL_W(8, w.out, w.a, w.b);
+        doNotOptimize(w.out);
+    }
+}
+
+MICRO_BENCH(wide_div_256) {
+    WideOperands w;
+    w.b[7] = 0;  // Divisor smaller than dividend
+    for (uint64_t i = 0; i < iterations; ++i) {
+        VL_DIV_WWW(256, w.out, w.a, w.b);
+        doNotOptimize(w.out);
+    }
+}
+
+MICRO_BENCH(wide_countones_1024) {
+    WideOperands w;
+    IData sum = 0;
+    for (uint64_t i = 0; i < iterations; ++i) {
+        doNotOptimize(w.a);
+        sum += VL_COUNTONES_W(WIDE_WORDS, w.a);
+    }
+    doNotOptimize(sum);
+}
+
+MICRO_BENCH(wide_sel_64_of_1024) {
+    WideOperands w;
+    VlWide<2> out;
+    for (uint64_t i = 0; i < iterations; ++i) {
+        VL_SEL_WWII(64, 1024, out, w.a, static_cast<IData>(i & 511), 64);
+        doNotOptimize(out);
+    }
+}
+
+//======================================================================
+// Queues and associative arrays, verilated_types.h
+
+MICRO_BENCH(queue_push_pop) {
+    VlQueue<IData> q;
+    for (int i = 0; i < 16; ++i) q.push_back(i);
+    IData sum = 0;
+    for (uint64_t i = 0; i < iterations; ++i) {
+        q.push_back(static_cast<IData>(i));
+        sum += q.pop_front();
+    }
+    doNotOptimize(sum);
+}
+
+MICRO_BENCH(queue_index) {
+    VlQueue<IData> q;
+    for (int i = 0; i < 1024; ++i) q.push_back(i);
+    IData sum = 0;
+    for (uint64_t i = 0; i < iterations; ++i) sum += q.at(static_cast<int32_t>(i & 1023));
+    doNotOptimize(sum);
+}
+
+MICRO_BENCH(assoc_write) {
+    VlAssocArray<IData, IData> a;
+    for (uint64_t i = 0; i < iterations; ++i) {
+        a.at(static_cast<IData>((i * 2654435761U) & 0xfff)) = static_cast<IData>(i);
+    }
+    doNotOptimize(a);
+}
+
+MICRO_BENCH(assoc_read) {
+    VlAssocArray<IData, IData> a;
+    for (IData i = 0; i < 4096; ++i) a.at(i) = i;
+    const VlAssocArray<IData, IData>& ca = a;
+    IData sum = 0;
+    for (uint64_t i = 0; i < iterations; ++i) {
+        sum += ca.at(static_cast<IData>((i * 2654435761U) & 0xfff));
+    }
+    doNotOptimize(sum);
+}
+
+//======================================================================
+// Scheduling primitives, verilated_types.h and verilated_timing.h
+
+MICRO_BENCH(trigger_vec_256) {
+    VlTriggerVec<256> trig;
+    VlTriggerVec<256> done;
+    VlTriggerVec<256> pending;
+    trig.clear();
+    done.clear();
+    size_t count = 0;
+    for (uint64_t i = 0; i < iterations; ++i) {
+        trig.setBit(i & 255, true);
+        pending.andNot(trig, done);
+        if (pending.any()) ++count;
+        done.thisOr(trig);
+        if ((i & 255) == 255) {
+            trig.clear();
+            done.clear();
+        }
+    }
+    doNotOptimize(count);
+}
+
+MICRO_BENCH(nba_commit_queue) {
+    VlUnpacked<IData, 1024> mem;
+    for (int i = 0; i < 1024; ++i) mem[i] = 0;
+    VlNBACommitQueue<VlUnpacked<IData, 1024>, false, IData, 1> queue;
+    for (uint64_t i = 0; i < iterations; ++i) {
+        queue.enqueue(static_cast<IData>(i), static_cast<size_t>((i * 7) & 1023));
+        if ((i & 15) == 15) queue.commit(mem);
+    }
+    queue.commit(mem);
+    doNotOptimize(mem);
+}
+
+static VlCoroutine microWaiter(VlTriggerScheduler& sched, uint64_t& count) {
+    while (true) {
+        co_await sched.trigger(true, nullptr);
+        ++count;
+    }
+}
+
+MICRO_BENCH(coroutine_resume) {
+    VlTriggerScheduler sched;
+    uint64_t count = 0;
+    // Each iteration resumes one of the waiting coroutines
+    static constexpr uint64_t WAITERS = 16;
+    for (uint64_t i = 0; i < WAITERS; ++i) microWaiter(sched, count);
+    for (uint64_t i = 0; i < iterations / WAITERS; ++i) sched.resume();
+    doNotOptimize(count);
+}
+
+//======================================================================
+// VCD value emission, verilated_vcd_c.h
+
+class MicroTraceModel final : public VerilatedModel {
+public:
+    static constexpr int SIGNALS = 256;
+    IData m_values[SIGNALS];
+    VlWide<4> m_wide;
+    uint32_t m_baseCode = 0;
+
+    explicit MicroTraceModel(VerilatedContext& context)
+        : VerilatedModel{context} {
+        std::memset(m_values, 0, sizeof(m_values));
+        for (int i = 0; i < 4; ++i) m_wide[i] = 0;
+    }
+    const char* hierName() const override { return "micro"; }
+    const char* modelName() const override { return "MicroTraceModel"; }
+    unsigned threads() const override { return 1; }
+    std::unique_ptr<VerilatedTraceConfig> traceConfig() const override {
+        return std::unique_ptr<VerilatedTraceConfig>{new VerilatedTraceConfig{false, false, false}};
+    }
+
+    static void traceInit(void* voidSelf, VerilatedVcd* tracep, uint32_t code) {
+        MicroTraceModel* const selfp = static_cast<MicroTraceModel*>(voidSelf);
+        selfp->m_baseCode = code;
+        tracep->pushPrefix("micro", VerilatedTracePrefixType::SCOPE_MODULE);
+        for (int i = 0; i < SIGNALS; ++i) {
+            const std::string name = "sig" + std::to_string(i);
+            tracep->declBus(code + i, 0, name.c_str(), -1, VerilatedTraceSigDirection::NONE,
+                            VerilatedTraceSigKind::VAR, VerilatedTraceSigType::LOGIC, false, -1,
+                            31, 0);
+        }
+        tracep->declArray(code + SIGNALS, 0, "wide", -1, VerilatedTraceSigDirection::NONE,
+                          VerilatedTraceSigKind::VAR, VerilatedTraceSigType::LOGIC, false, -1,
+                          127, 0);
+        tracep->popPrefix();
+    }
+    static void traceFull(void* voidSelf, VerilatedVcd::Buffer* bufp) {
+        MicroTraceModel* const selfp = static_cast<MicroTraceModel*>(voidSelf);
+        uint32_t* const oldp = bufp->oldp(selfp->m_baseCode);
+        for (int i = 0; i < SIGNALS; ++i) bufp->fullIData(oldp + i, selfp->m_values[i], 32);
+        bufp->fullWData(oldp + SIGNALS, selfp->m_wide, 128);
+    }
+    static void traceChg(void* voidSelf, VerilatedVcd::Buffer* bufp) {
+        MicroTraceModel* const selfp = static_cast<MicroTraceModel*>(voidSelf);
+        uint32_t* const oldp = bufp->oldp(selfp->m_baseCode);
+        for (int i = 0; i < SIGNALS; ++i) bufp->chgIData(oldp + i, selfp->m_values[i], 32);
+        bufp->chgWData(oldp + SIGNALS, selfp->m_wide, 128);
+    }
+};
+
+MICRO_BENCH(vcd_emit_signal) {
+    VerilatedContext context;
+    context.traceEverOn(true);
+    MicroTraceModel model{context};
+    VerilatedVcdC tfp;
+    tfp.spTrace()->addModel(&model);
+    tfp.spTrace()->addInitCb(&MicroTraceModel::traceInit, &model);
+    tfp.spTrace()->addFullCb(&MicroTraceModel::traceFull, 0, &model);
+    tfp.spTrace()->addChgCb(&MicroTraceModel::traceChg, 0, &model);
+    tfp.open("/dev/null");
+    // Each iteration changes and emits one signal; half the signals change per dump
+    uint64_t time = 0;
+    for (uint64_t i = 0; i < iterations; i += MicroTraceModel::SIGNALS / 2) {
+        for (int s = 0; s < MicroTraceModel::SIGNALS; s += 2) {
+            model.m_values[s + (time & 1)] += static_cast<IData>(i + s);
+        }
+        ++model.m_wide[time & 3];
+        tfp.dump(++time);
+    }
+    tfp.close();
+}
+
+//======================================================================
+// Main
+
+int main(int argc, char** argv) {
+    std::string filter;
+    std::string jsonFilename;
+    double minTime = 0.2;
+    int repeats = 3;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--filter" && i + 1 < argc) {
+            filter = argv[++i];
+        } else if (arg == "--json" && i + 1 < argc) {
+            jsonFilename = argv[++i];
+        } else if (arg == "--min-time" && i + 1 < argc) {
+            minTime = std::atof(argv[++i]);
+        } else if (arg == "--repeats" && i + 1 < argc) {
+            repeats = std::max(1, std::atoi(argv[++i]));
+        } else {
+            fprintf(stderr, "%%Error: Unknown argument: %s\n", arg.c_str());
+            return 1;
+        }
+    }
+    const std::regex filterRe{filter};
+
+    std::string json = "{\n";
+    bool first = true;
+    printf("%-28s %14s %14s\n", "benchmark", "ns/iteration", "iterations");
+    for (const MicroBench& bench : microBenches()) {
+        if (!filter.empty() && !std::regex_search(bench.name, filterRe)) continue;
+        // Grow the iteration count until a run takes long enough to time reliably
+        uint64_t iterations = 256;
+        double seconds = runSeconds(bench.func, iterations);
+        while (seconds < minTime && iterations < (1ULL << 40)) {
+            const double scale = seconds > 0 ? std::min(100.0, 1.5 * minTime / seconds) : 100.0;
+            iterations = static_cast<uint64_t>(iterations * std::max(2.0, scale));
+            seconds = runSeconds(bench.func, iterations);
+        }
+        for (int r = 1; r < repeats; ++r) {
+            seconds = std::min(seconds, runSeconds(bench.func, iterations));
+        }
+        const double ns = seconds * 1e9 / iterations;
+        printf("%-28s %14.3f %14" PRIu64 "\n", bench.name, ns, iterations);
+        json += std::string{first ? "" : ",\n"} + "  \"" + bench.name
+                + "\": " + std::to_string(ns);
+        first = false;
+    }
+    json += "\n}\n";
+
+    if (!jsonFilename.empty()) {
+        FILE* const fp = std::fopen(jsonFilename.c_str(), "w");
+        if (!fp) {
+            fprintf(stderr, "%%Error: Can't write '%s'\n", jsonFilename.c_str());
+            return 1;
+        }
+        std::fputs(json.c_str(), fp);
+        std::fclose(fp);
+    }
+    return 0;
+}
@@ -0,0 +1,81 @@
+// DESCRIPTION: Verilator: Benchmark RISC-V core running a hashing loop, see verilator_benchmark
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module bench (
+    input clk
+);
+  parameter CYCLES = 5000000;
+
+  reg [31:0] imem[0:255];
+  reg [31:0] dmem[0:4095];
+  reg [31:0] cyc = 0;
+  wire rst = cyc < 4;
+
+  wire [31:0] iaddr;
+  wire [31:0] daddr;
+  wire [31:0] dwdata;
+  wire [3:0] dwstrb;
+  wire [31:0] result;
+
+  bench_riscv_core core (
+      .clk(clk),
+      .rst(rst),
+      .iaddr(iaddr),
+      .idata(imem[iaddr[9:2]]),
+      .daddr(daddr),
+      .dwdata(dwdata),
+      .dwstrb(dwstrb),
+      .drdata(dmem[daddr[13:2]]),
+      .result(result)
+  );
+
+  always @(posedge clk) begin
+    cyc <= cyc + 1;
+    if (dwstrb[0]) dmem[daddr[13:2]][7:0] <= dwdata[7:0];
+    if (dwstrb[1]) dmem[daddr[13:2]][15:8] <= dwdata[15:8];
+    if (dwstrb[2]) dmem[daddr[13:2]][23:16] <= dwdata[23:16];
+    if (dwstrb[3]) dmem[daddr[13:2]][31:24] <= dwdata[31:24];
+    if (cyc == CYCLES) begin
+      $display("bench checksum %08x", result);
+      $finish;
+    end
+  end
+
+  integer i;
+  initial begin
+    for (i = 0; i < 256; i = i + 1) imem[i] = 32'h00000013;  // nop
+    for (i = 0; i < 4096; i = i + 1) dmem[i] = i * 32'h9e3779b9;
+    // Hash every word of dmem into x5, storing the running hash back
+    imem[0] = 32'h00100293;  // addi x5, x0, 1
+    imem[1] = 32'h000045b7;  // lui x11, 4
+    imem[2] = 32'h00000613;  // addi x12, x0, 0
+    imem[3] = 32'h00000313;  // addi x6, x0, 0
+    imem[4] = 32'h00032403;  // lw x8, 0(x6)
+    imem[5] = 32'h00544433;  // xor x8, x8, x5
+    imem[6] = 32'h00529493;  // slli x9, x5, 5
+    imem[7] = 32'h009282b3;  // add x5, x5, x9
+    imem[8] = 32'h008282b3;  // add x5, x5, x8
+    imem[9] = 32'h0072d493;  // srli x9, x5, 7
+    imem[10] = 32'h0092c2b3;  // xor x5, x5, x9
+    imem[11] = 32'h00532023;  // sw x5, 0(x6)
+    imem[12] = 32'h0032f493;  // andi x9, x5, 3
+    imem[13] = 32'h00048863;  // beq x9, x0, skip
+    imem[14] = 32'h00134483;  // lbu x9, 1(x6)
+    imem[15] = 32'h409282b3;  // sub x5, x5, x9
+    imem[16] = 32'h00930123;  // sb x9, 2(x6)
+    imem[17] = 32'h00c334b3;  // sltu x9, x6, x12
+    imem[18] = 32'h0092e2b3;  // or x5, x5, x9
+    imem[19] = 32'h00430313;  // addi x6, x6, 4
+    imem[20] = 32'hfcb360e3;  // bltu x6, x11, inner
+    imem[21] = 32'h00160613;  // addi x12, x12, 1
+    imem[22] = 32'h008000ef;  // jal x1, func
+    imem[23] = 32'hfb1ff06f;  // jal x0, outer
+    imem[24] = 32'h4032d493;  // srai x9, x5, 3
+    imem[25] = 32'h00c4f4b3;  // and x9, x9, x12
+    imem[26] = 32'h009282b3;  // add x5, x5, x9
+    imem[27] = 32'h00008067;  // jalr x0, x1, 0
+  end
+endmodule
@@ -0,0 +1,144 @@
+// DESCRIPTION: Verilator: Benchmark single-cycle RV32I core, see verilator_benchmark
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module bench_riscv_core (
+    input clk,
+    input rst,
+    output [31:0] iaddr,
+    input [31:0] idata,
+    output [31:0] daddr,
+    output [31:0] dwdata,
+    output [3:0] dwstrb,  // Byte enables of a store, zero if not a store
+    input [31:0] drdata,
+    output [31:0] result  // Register x5, the programs' checksum
+);
+  localparam [6:0] OP_LUI = 7'b0110111;
+  localparam [6:0] OP_AUIPC = 7'b0010111;
+  localparam [6:0] OP_JAL = 7'b1101111;
+  localparam [6:0] OP_JALR = 7'b1100111;
+  localparam [6:0] OP_BRANCH = 7'b1100011;
+  localparam [6:0] OP_LOAD = 7'b0000011;
+  localparam [6:0] OP_STORE = 7'b0100011;
+  localparam [6:0] OP_IMM = 7'b0010011;
+  localparam [6:0] OP_REG = 7'b0110011;
+
+  reg [31:0] pc;
+  reg [31:0] regs[1:31];
+
+  wire [31:0] inst = idata;
+  wire [6:0] opcode = inst[6:0];
+  wire [4:0] rd = inst[11:7];
+  wire [2:0] funct3 = inst[14:12];
+  wire [4:0] rs1 = inst[19:15];
+  wire [4:0] rs2 = inst[24:20];
+  wire [31:0] imm_i = {{20{inst[31]}}, inst[31:20]};
+  wire [31:0] imm_s = {{20{inst[31]}}, inst[31:25], inst[11:7]};
+  wire [31:0] imm_b = {{19{inst[31]}}, inst[31], inst[7], inst[30:25], inst[11:8], 1'b0};
+  wire [31:0] imm_u = {inst[31:12], 12'b0};
+  wire [31:0] imm_j = {{11{inst[31]}}, inst[31], inst[19:12], inst[20], inst[30:21], 1'b0};
+
+  wire [31:0] a = (rs1 == 5'd0) ? 32'b0 : regs[rs1];
+  wire [31:0] b = (rs2 == 5'd0) ? 32'b0 : regs[rs2];
+
+  // ALU
+  wire [31:0] op2 = (opcode == OP_IMM) ? imm_i : b;
+  wire alt = inst[30] & ((opcode == OP_REG) | (funct3 == 3'b101));  // SUB, SRA, SRAI
+  reg [31:0] alu;
+  always @* begin
+    case (funct3)
+      3'b000: alu = alt ? a - op2 : a + op2;
+      3'b001: alu = a << op2[4:0];
+      3'b010: alu = {31'b0, $signed(a) < $signed(op2)};
+      3'b011: alu = {31'b0, a < op2};
+      3'b100: alu = a ^ op2;
+      3'b101: alu = alt ? $unsigned($signed(a) >>> op2[4:0]) : a >> op2[4:0];
+      3'b110: alu = a | op2;
+      default: alu = a & op2;
+    endcase
+  end
+
+  reg taken;
+  always @* begin
+    case (funct3)
+      3'b000: taken = a == b;
+      3'b001: taken = a != b;
+      3'b100: taken = $signed(a) < $signed(b);
+      3'b101: taken = $signed(a) >= $signed(b);
+      3'b110: taken = a < b;
+      3'b111: taken = a >= b;
+      default: taken = 1'b0;
+    endcase
+  end
+
+  // Memory access, the memory is word addressed
+  wire [31:0] addr = a + ((opcode == OP_STORE) ? imm_s : imm_i);
+  wire [31:0] shifted = drdata >> {addr[1:0], 3'b0};
+  reg [31:0] load;
+  always @* begin
+    case (funct3)
+      3'b000: load = {{24{shifted[7]}}, shifted[7:0]};
+      3'b001: load = {{16{shifted[15]}}, shifted[15:0]};
+      3'b100: load = {24'b0, shifted[7:0]};
+      3'b101: load = {16'b0, shifted[15:0]};
+      default: load = drdata;
+    endcase
+  end
+  assign iaddr = pc;
+  assign daddr = addr;
+  assign dwdata = b << {addr[1:0], 3'b0};
+  assign dwstrb = (opcode != OP_STORE) ? 4'b0000
+                : (funct3 == 3'b000) ? (4'b0001 << addr[1:0])
+                : (funct3 == 3'b001) ? (4'b0011 << addr[1:0])
+                : 4'b1111;
+
+  // Writeback and next PC
+  reg [31:0] wb;
+  reg wen;
+  reg [31:0] npc;
+  always @* begin
+    wb = alu;
+    wen = 1'b0;
+    npc = pc + 32'd4;
+    case (opcode)
+      OP_LUI: begin
+        wb = imm_u;
+        wen = 1'b1;
+      end
+      OP_AUIPC: begin
+        wb = pc + imm_u;
+        wen = 1'b1;
+      end
+      OP_JAL: begin
+        wb = pc + 32'd4;
+        wen = 1'b1;
+        npc = pc + imm_j;
+      end
+      OP_JALR: begin
+        wb = pc + 32'd4;
+        wen = 1'b1;
+        npc = (a + imm_i) & ~32'b1;
+      end
+      OP_BRANCH: if (taken) npc = pc + imm_b;
+      OP_LOAD: begin
+        wb = load;
+        wen = 1'b1;
+      end
+      OP_IMM, OP_REG: wen = 1'b1;
+      default: ;
+    endcase
+  end
+
+  always @(posedge clk) begin
+    if (rst) begin
+      pc <= 32'b0;
+    end else begin
+      pc <= npc;
+      if (wen && rd != 5'd0) regs[rd] <= wb;
+    end
+  end
+
+  assign result = regs[5];
+endmodule
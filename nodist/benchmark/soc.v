@@ -0,0 +1,104 @@
+// DESCRIPTION: Verilator: Benchmark memory-heavy SoC, see verilator_benchmark
+//
+// A RISC-V core strides through four 64 KiB memory banks while a DMA
+// engine copies blocks between random banks and updates a histogram.
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module bench (
+    input clk
+);
+  parameter CYCLES = 3000000;
+
+  reg [31:0] imem[0:255];
+  reg [31:0] mem[0:3][0:16383];
+  reg [31:0] hist[0:4095];
+  reg [31:0] cyc = 0;
+  wire rst = cyc < 4;
+  reg [31:0] lfsr = 32'h1;
+
+  // Core, the banks are interleaved at 64 KiB
+  wire [31:0] iaddr;
+  wire [31:0] daddr;
+  wire [31:0] dwdata;
+  wire [3:0] dwstrb;
+  wire [31:0] result;
+  wire [1:0] cbank = daddr[17:16];
+  wire [13:0] cindex = daddr[15:2];
+
+  bench_riscv_core core (
+      .clk(clk),
+      .rst(rst),
+      .iaddr(iaddr),
+      .idata(imem[iaddr[9:2]]),
+      .daddr(daddr),
+      .dwdata(dwdata),
+      .dwstrb(dwstrb),
+      .drdata(mem[cbank][cindex]),
+      .result(result)
+  );
+
+  // DMA engine, copies 256 word blocks
+  reg [1:0] sbank = 0;
+  reg [1:0] dbank = 0;
+  reg [13:0] sindex = 0;
+  reg [13:0] dindex = 0;
+  reg [8:0] dlen = 0;
+  wire [31:0] dmadata = mem[sbank][sindex];
+  reg [31:0] histsum = 0;
+
+  always @(posedge clk) begin
+    cyc <= cyc + 1;
+    lfsr <= {lfsr[30:0], lfsr[31] ^ lfsr[21] ^ lfsr[1] ^ lfsr[0]};
+    if (dwstrb[0]) mem[cbank][cindex][7:0] <= dwdata[7:0];
+    if (dwstrb[1]) mem[cbank][cindex][15:8] <= dwdata[15:8];
+    if (dwstrb[2]) mem[cbank][cindex][23:16] <= dwdata[23:16];
+    if (dwstrb[3]) mem[cbank][cindex][31:24] <= dwdata[31:24];
+    if (dlen == 0) begin
+      sbank <= lfsr[1:0];
+      dbank <= lfsr[3:2];
+      sindex <= lfsr[17:4];
+      dindex <= lfsr[31:18];
+      dlen <= 9'd256;
+    end else begin
+      mem[dbank][dindex] <= dmadata + 32'd1;
+      sindex <= sindex + 14'd1;
+      dindex <= dindex + 14'd1;
+      dlen <= dlen - 9'd1;
+      hist[dmadata[11:0]] <= hist[dmadata[11:0]] + 32'd1;
+    end
+    histsum <= histsum + hist[lfsr[11:0]];
+    if (cyc == CYCLES) begin
+      $display("bench checksum %08x", result ^ histsum);
+      $finish;
+    end
+  end
+
+  integer i;
+  integer j;
+  initial begin
+    for (i = 0; i < 256; i = i + 1) imem[i] = 32'h00000013;  // nop
+    for (i = 0; i < 4; i = i + 1) begin
+      for (j = 0; j < 16384; j = j + 1) mem[i][j] = (i * 16384 + j) * 32'h9e3779b9;
+    end
+    for (i = 0; i < 4096; i = i + 1) hist[i] = 0;
+    // Hash memory into x5 with a 2044 byte stride, storing the running hash back
+    imem[0] = 32'h00100293;  // addi x5, x0, 1
+    imem[1] = 32'h000405b7;  // lui x11, 64
+    imem[2] = 32'h00000313;  // addi x6, x0, 0
+    imem[3] = 32'h00032403;  // lw x8, 0(x6)
+    imem[4] = 32'h008282b3;  // add x5, x5, x8
+    imem[5] = 32'h00329493;  // slli x9, x5, 3
+    imem[6] = 32'h0092c2b3;  // xor x5, x5, x9
+    imem[7] = 32'h00b2d493;  // srli x9, x5, 11
+    imem[8] = 32'h0092c2b3;  // xor x5, x5, x9
+    imem[9] = 32'h00532023;  // sw x5, 0(x6)
+    imem[10] = 32'h7fc30313;  // addi x6, x6, 2044
+    imem[11] = 32'hfeb360e3;  // bltu x6, x11, loop
+    imem[12] = 32'h40b30333;  // sub x6, x6, x11
+    imem[13] = 32'h00430313;  // addi x6, x6, 4
+    imem[14] = 32'hfd5ff06f;  // jal x0, loop
+  end
+endmodule
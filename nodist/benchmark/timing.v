@@ -0,0 +1,80 @@
+// DESCRIPTION: Verilator: Benchmark timing-heavy testbench, see verilator_benchmark
+//
+// Producer, consumer and agent processes synchronize through delays,
+// clock edges, waits and named events.
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module bench;
+  parameter CYCLES = 300000;
+  localparam AGENTS = 16;
+
+  reg clk = 0;
+  always #5 clk = ~clk;
+
+  reg [31:0] cycles = 0;
+  reg [31:0] checksum = 0;
+
+  reg [31:0] fifo[0:15];
+  reg [4:0] wptr = 0;
+  reg [4:0] rptr = 0;
+  wire [4:0] count = wptr - rptr;
+
+  always @(posedge clk) begin
+    cycles <= cycles + 1;
+    if (cycles == CYCLES) begin
+      $display("bench cycles %0d", cycles);
+      $display("bench checksum %08x", checksum);
+      $finish;
+    end
+  end
+
+  function automatic [31:0] next(input [31:0] v);
+    next = {v[30:0], v[31] ^ v[21] ^ v[1] ^ v[0]};
+  endfunction
+
+  // Producer pushes into the FIFO a random delay after each clock
+  initial begin : producer
+    reg [31:0] r;
+    r = 1;
+    forever begin
+      @(posedge clk);
+      #(r[1:0]);
+      r = next(r);
+      wait (count != 16);
+      fifo[wptr[3:0]] = r;
+      wptr = wptr + 1;
+    end
+  end
+
+  // Consumer pops from the FIFO on the falling edge
+  event popped;
+  initial begin : consumer
+    forever begin
+      wait (count != 0);
+      @(negedge clk);
+      checksum = checksum + fifo[rptr[3:0]];
+      rptr = rptr + 1;
+      ->popped;
+    end
+  end
+
+  // Agents wake after random delays, then wait for a clock or a pop
+  genvar g;
+  generate
+    for (g = 0; g < AGENTS; g = g + 1) begin : agent
+      reg [31:0] state = g + 1;
+      initial begin
+        forever begin
+          #(1 + state[3:0]);
+          state = next(state);
+          if (state[0]) @(posedge clk);
+          else @(popped);
+          checksum = checksum ^ state;
+        end
+      end
+    end
+  endgenerate
+endmodule
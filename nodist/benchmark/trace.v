@@ -0,0 +1,60 @@
+// DESCRIPTION: Verilator: Benchmark design with many traced signals, see verilator_benchmark
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module bench (
+    input clk
+);
+  parameter CYCLES = 200000;
+  localparam LANES = 256;
+
+  reg [31:0] cyc = 0;
+  wire [31:0] chain[0:LANES];
+  assign chain[0] = cyc;
+
+  genvar g;
+  generate
+    for (g = 0; g < LANES; g = g + 1) begin : lane
+      bench_trace_lane #(.SEED(g + 1)) u (
+          .clk(clk),
+          .in(chain[g]),
+          .out(chain[g+1])
+      );
+    end
+  endgenerate
+
+  always @(posedge clk) begin
+    cyc <= cyc + 1;
+    if (cyc == CYCLES) begin
+      $display("bench checksum %08x", chain[LANES]);
+      $finish;
+    end
+  end
+endmodule
+
+// Each lane changes most of its signals every cycle
+module bench_trace_lane #(
+    parameter [31:0] SEED = 1
+) (
+    input clk,
+    input [31:0] in,
+    output [31:0] out
+);
+  reg [31:0] lfsr = SEED;
+  reg [31:0] count = 0;
+  reg [7:0] bytes[0:3];
+  reg [63:0] wide = 0;
+  reg flag = 0;
+
+  always @(posedge clk) begin
+    lfsr <= {lfsr[30:0], lfsr[31] ^ lfsr[21] ^ lfsr[1] ^ lfsr[0]};
+    count <= count + 1;
+    bytes[count[1:0]] <= lfsr[7:0] ^ in[7:0];
+    wide <= {wide[31:0], lfsr ^ in};
+    flag <= ^lfsr;
+  end
+
+  assign out = wide[63:32] + {bytes[0], bytes[1], bytes[2], bytes[3]} + {31'b0, flag};
+endmodule
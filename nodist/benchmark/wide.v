@@ -0,0 +1,44 @@
+// DESCRIPTION: Verilator: Benchmark wide datapath pipeline, see verilator_benchmark
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module bench (
+    input clk
+);
+  parameter CYCLES = 2000000;
+  localparam W = 1024;
+
+  reg [31:0] cyc = 0;
+  reg [63:0] lfsr = 64'h1;
+
+  // Pipeline of wide arithmetic, logic and shifts
+  reg [W-1:0] s0 = 0;
+  reg [W-1:0] s1 = 0;
+  reg [W-1:0] s2 = 0;
+  reg [W-1:0] s3 = 0;
+  reg [511:0] prod = 0;
+  reg [W-1:0] acc = 0;
+  reg [10:0] ones = 0;
+  reg [63:0] checksum = 0;
+
+  wire [9:0] idx = lfsr[9:0] & 10'h3c0;
+
+  always @(posedge clk) begin
+    cyc <= cyc + 1;
+    lfsr <= {lfsr[62:0], lfsr[63] ^ lfsr[62] ^ lfsr[60] ^ lfsr[59]};
+    s0 <= {16{lfsr}} ^ {s3[W-65:0], lfsr};
+    s1 <= s0 + {s0[W-2:0], s0[W-1]};
+    s2 <= s1 ^ (s1 >> 17) ^ (s1 << 29);
+    s3 <= (s2 > s1) ? s2 - s1 : {s2[W/2-1:0], s2[W-1:W/2]};
+    prod <= s3[255:0] * s2[W-1-:256];
+    acc <= acc + {prod, prod} ^ s3;
+    ones <= $countones(acc);
+    checksum <= checksum ^ acc[idx+:64] ^ {53'b0, ones} ^ {63'b0, ^s2};
+    if (cyc == CYCLES) begin
+      $display("bench checksum %016x", checksum);
+      $finish;
+    end
+  end
+endmodule
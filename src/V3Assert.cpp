@@ -42,12 +42,23 @@ class AssertVisitor final : public VNVisitor {
     AstVar* m_monitorNumVarp = nullptr;  // $monitor number variable
     AstVar* m_monitorOffVarp = nullptr;  // $monitoroff variable
     unsigned m_modPastNum = 0;  // Module past numbering
+    // A chain of $past registers of one sampled expression, shared by all $past of it
+    struct PastChain final {
+        AstNodeExpr* keyp;  // Copy of the sampled expression, for comparison
+        AstAlways* alwaysp;  // Clock domain updating the registers
+        AstVar* bitsp;  // For one bit expressions, a shift register, bit N is N+1 ticks ago
+        std::vector<AstVar*> stages;  // Otherwise registers, element N is N+1 ticks ago
+        uint32_t depth() const { return bitsp ? bitsp->width() : stages.size(); }
+    };
+    std::vector<PastChain> m_modPastChains;  // $past registers in current module
+    std::vector<AstAlways*> m_modPastAlwaysps;  // $past updates by clock domain in current module
     unsigned m_modStrobeNum = 0;  // Module $strobe numbering
     const AstNodeProcedure* m_procedurep = nullptr;  // Current procedure
     VDouble0 m_statCover;  // Statistic tracking
     VDouble0 m_statAsNotImm;  // Statistic tracking
     VDouble0 m_statAsImm;  // Statistic tracking
     VDouble0 m_statAsFull;  // Statistic tracking
+    VDouble0 m_statPastShared;  // Statistic tracking
     bool m_inSampled = false;  // True inside a sampled expression
 
     // METHODS
@@ -449,6 +460,50 @@ class AssertVisitor final : public VNVisitor {
     }
 
     //========== Past
+    AstAlways* pastAlwaysp(AstSenTree* sentreep) {
+        // All $past in the same clock domain update in a single process
+        for (AstAlways* const alwaysp : m_modPastAlwaysps) {
+            if (alwaysp->sensesp()->sameTree(sentreep)) {
+                VL_DO_DANGLING(pushDeletep(sentreep), sentreep);
+                return alwaysp;
+            }
+        }
+        AstAlways* const alwaysp
+            = new AstAlways{sentreep->fileline(), VAlwaysKwd::ALWAYS, sentreep, nullptr};
+        m_modp->addStmtsp(alwaysp);
+        m_modPastAlwaysps.push_back(alwaysp);
+        return alwaysp;
+    }
+    PastChain newPastChain(FileLine* flp, AstNodeExpr* inp, AstAlways* alwaysp, uint32_t ticks) {
+        PastChain chain{inp->cloneTreePure(false), alwaysp, nullptr, {}};
+        const std::string name = "_Vpast_" + cvtToStr(m_modPastNum++);
+        AstNodeDType* const dtypep = inp->dtypep()->skipRefp();
+        if (ticks > 1 && ticks <= 64 && inp->width() == 1 && VN_IS(dtypep, BasicDType)
+            && !dtypep->isDouble()) {
+            // Shift register, one bit per tick:  bits <= {bits[ticks-2:0], in}
+            chain.bitsp = new AstVar{flp, VVarType::MODULETEMP, name,
+                                     inp->findBitDType(ticks, ticks, VSigning::UNSIGNED)};
+            m_modp->addStmtsp(chain.bitsp);
+            AstVarRef* const bitsRefp = new AstVarRef{flp, chain.bitsp, VAccess::READ};
+            AstNodeExpr* const oldp
+                = new AstSel{flp, bitsRefp, 0, static_cast<int>(ticks - 1)};
+            AstNodeExpr* const shiftp = new AstConcat{flp, oldp, inp};
+            alwaysp->addStmtsp(new AstAssignDly{
+                flp, new AstVarRef{flp, chain.bitsp, VAccess::WRITE}, shiftp});
+            return chain;
+        }
+        for (uint32_t i = 0; i < ticks; ++i) {
+            AstVar* const outvarp = new AstVar{flp, VVarType::MODULETEMP,
+                                               name + "_" + cvtToStr(i), inp->dtypep()};
+            m_modp->addStmtsp(outvarp);
+            alwaysp->addStmtsp(
+                new AstAssignDly{flp, new AstVarRef{flp, outvarp, VAccess::WRITE}, inp});
+            chain.stages.push_back(outvarp);
+            inp = new AstVarRef{flp, outvarp, VAccess::READ};
+        }
+        VL_DO_DANGLING(inp->deleteTree(), inp);
+        return chain;
+    }
     void visit(AstPast* nodep) override {
         iterateChildren(nodep);
         uint32_t ticks = 1;
@@ -458,26 +513,34 @@ class AssertVisitor final : public VNVisitor {
             ticks = VN_AS(nodep->ticksp(), Const)->toUInt();
         }
         UASSERT_OBJ(ticks >= 1, nodep, "0 tick should have been checked in V3Width");
+        FileLine* const flp = nodep->fileline();
         AstNodeExpr* const exprp = nodep->exprp()->unlinkFrBack();
-        AstNodeExpr* inp = newSampledExpr(exprp);
-        AstVar* invarp = nullptr;
-        AstSenTree* const sentreep = nodep->sentreep()->unlinkFrBack();
-        AstAlways* const alwaysp
-            = new AstAlways{nodep->fileline(), VAlwaysKwd::ALWAYS, sentreep, nullptr};
-        m_modp->addStmtsp(alwaysp);
-        for (uint32_t i = 0; i < ticks; ++i) {
-            AstVar* const outvarp = new AstVar{
-                nodep->fileline(), VVarType::MODULETEMP,
-                "_Vpast_" + cvtToStr(m_modPastNum++) + "_" + cvtToStr(i), inp->dtypep()};
-            m_modp->addStmtsp(outvarp);
-            AstNode* const assp = new AstAssignDly{
-                nodep->fileline(), new AstVarRef{nodep->fileline(), outvarp, VAccess::WRITE}, inp};
-            alwaysp->addStmtsp(assp);
-            // if (debug() >= 9) assp->dumpTree("-  ass: ");
-            invarp = outvarp;
-            inp = new AstVarRef{nodep->fileline(), invarp, VAccess::READ};
-        }
-        nodep->replaceWith(inp);
+        AstNodeExpr* const inp = newSampledExpr(exprp);
+        AstAlways* const alwaysp = pastAlwaysp(nodep->sentreep()->unlinkFrBack());
+        // Reuse the registers of an earlier $past of the same expression, if deep enough
+        const PastChain* chainp = nullptr;
+        for (const PastChain& chain : m_modPastChains) {
+            if (chain.alwaysp == alwaysp && chain.depth() >= ticks && chain.keyp->sameTree(inp)) {
+                chainp = &chain;
+                ++m_statPastShared;
+                break;
+            }
+        }
+        if (chainp) {
+            VL_DO_DANGLING(pushDeletep(inp), inp);
+        } else {
+            m_modPastChains.push_back(newPastChain(flp, inp, alwaysp, ticks));
+            chainp = &m_modPastChains.back();
+        }
+        AstNodeExpr* outp;
+        if (chainp->bitsp) {
+            outp = new AstSel{flp, new AstVarRef{flp, chainp->bitsp, VAccess::READ},
+                              static_cast<int>(ticks - 1), 1};
+            outp->dtypeFrom(nodep);
+        } else {
+            outp = new AstVarRef{flp, chainp->stages[ticks - 1], VAccess::READ};
+        }
+        nodep->replaceWith(outp);
         VL_DO_DANGLING(pushDeletep(nodep), nodep);
     }
 
@@ -690,11 +753,18 @@ class AssertVisitor final : public VNVisitor {
     void visit(AstNodeModule* nodep) override {
         VL_RESTORER(m_modp);
         VL_RESTORER(m_modPastNum);
+        VL_RESTORER(m_modPastChains);
+        VL_RESTORER(m_modPastAlwaysps);
         VL_RESTORER(m_modStrobeNum);
         m_modp = nodep;
         m_modPastNum = 0;
+        m_modPastChains.clear();
+        m_modPastAlwaysps.clear();
         m_modStrobeNum = 0;
         iterateChildren(nodep);
+        for (PastChain& chain : m_modPastChains) {
+            VL_DO_DANGLING(pushDeletep(chain.keyp), chain.keyp);
+        }
     }
     void visit(AstNodeProcedure* nodep) override {
         VL_RESTORER(m_procedurep);
@@ -719,6 +789,7 @@ public:
         V3Stats::addStat("Assertions, assert immediate statements", m_statAsImm);
         V3Stats::addStat("Assertions, cover statements", m_statCover);
         V3Stats::addStat("Assertions, full/parallel case", m_statAsFull);
+        V3Stats::addStat("Assertions, $past registers shared", m_statPastShared);
     }
 };
 
@@ -0,0 +1,111 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//*************************************************************************
+// DESCRIPTION: Verilator: Select hashed storage for associative arrays
+//
+// Code available from: https://verilator.org
+//
+//*************************************************************************
+//
+// Copyright 2025 by Wilson Snyder. This program is free software; you
+// can redistribute it and/or modify it under the terms of either the GNU
+// Lesser General Public License Version 3 or the Perl Artistic License
+// Version 2.0.
+// SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+//
+//*************************************************************************
+// V3AssocHash's Transformations:
+//
+// Whole netlist:
+//   Find associative array types that are only ever indexed, tested with
+//   exists(), deleted or sized.  Such arrays never observe key order, so
+//   mark them unordered, and they are emitted as VlUnorderedAssocArray.
+//
+//   Any other use of an array (iteration, whole array copy or compare,
+//   %p formatting, class members, ports, public, nesting in another type)
+//   keeps the ordered VlAssocArray.
+//
+//*************************************************************************
+
+#include "V3PchAstNoMT.h"  // VL_MT_DISABLED_CODE_UNIT
+
+#include "V3AssocHash.h"
+
+#include <set>
+
+VL_DEFINE_DEBUG_FUNCTIONS;
+
+//######################################################################
+
+class AssocHashVisitor final {
+    // NODE STATE
+    //  AstAssocArrayDType::user1()     -> bool. Key order may be observed
+    const VNUser1InUse m_inuser1;
+
+    // METHODS
+    static AstAssocArrayDType* assocp(AstNodeDType* dtypep) {
+        return dtypep ? VN_CAST(dtypep->skipRefp(), AssocArrayDType) : nullptr;
+    }
+    static bool orderFreeMethod(const string& name) {
+        static const std::set<string> s_names{"at",     "atDefault", "clear",      "empty",
+                                              "erase",  "exists",    "setDefault", "set",
+                                              "size"};
+        return s_names.count(name);
+    }
+    static bool orderFreeUse(const AstNodeExpr* nodep) {
+        const AstNode* const abovep = nodep->firstAbovep();
+        if (!abovep) return false;
+        if (VN_IS(abovep, AssocSel)) return true;
+        if (const AstCMethodHard* const callp = VN_CAST(abovep, CMethodHard)) {
+            return orderFreeMethod(callp->name());
+        }
+        return false;
+    }
+    static bool hashableKey(const AstNodeDType* keyp) {
+        const AstBasicDType* const basicp = VN_CAST(keyp->skipRefp(), BasicDType);
+        if (!basicp) return false;
+        return basicp->isString() || (basicp->isIntegralOrPacked() && !basicp->isWide());
+    }
+
+public:
+    // CONSTRUCTORS
+    explicit AssocHashVisitor(AstNetlist* netlistp) {
+        // Mark every array type with a use that may depend on key order
+        netlistp->foreach([](AstNode* nodep) {
+            if (AstVar* const varp = VN_CAST(nodep, Var)) {
+                if (AstAssocArrayDType* const dtypep = assocp(varp->dtypep())) {
+                    if (varp->isClassMember() || varp->isIO() || varp->isSigPublic()) {
+                        dtypep->user1(true);
+                    }
+                }
+            } else if (AstNodeExpr* const exprp = VN_CAST(nodep, NodeExpr)) {
+                if (AstAssocArrayDType* const dtypep = assocp(exprp->dtypep())) {
+                    if (!orderFreeUse(exprp)) dtypep->user1(true);
+                }
+            } else if (AstNodeDType* const dtypep = VN_CAST(nodep, NodeDType)) {
+                if (VN_IS(dtypep, RefDType)) return;
+                if (AstAssocArrayDType* const subp = assocp(dtypep->subDTypep())) {
+                    subp->user1(true);
+                }
+                if (AstAssocArrayDType* const subp = assocp(dtypep->subDType2p())) {
+                    subp->user1(true);
+                }
+            }
+        });
+        // Switch the remaining types to hashed storage
+        netlistp->foreach([](AstAssocArrayDType* dtypep) {
+            if (dtypep->user1() || !hashableKey(dtypep->keyDTypep())) return;
+            UINFO(4, "  Unordered " << dtypep << endl);
+            dtypep->unordered(true);
+        });
+    }
+    ~AssocHashVisitor() = default;
+};
+
+//######################################################################
+// V3AssocHash static functions
+
+void V3AssocHash::assocHashAll(AstNetlist* nodep) {
+    UINFO(2, __FUNCTION__ << ": " << endl);
+    if (!v3Global.opt.savable()) AssocHashVisitor{nodep};
+    V3Global::dumpCheckGlobalTree("assochash", 0, dumpTreeEitherLevel() >= 3);
+}
@@ -26,6 +26,7 @@
 #include "V3FunctionTraits.h"
 #include "V3Global.h"
 #include "V3Number.h"
+#include "V3PoolAllocator.h"
 #include "V3StdFuture.h"
 
 #include "V3Ast__gen_forward_class_decls.h"  // From ./astgen
@@ -2202,6 +2203,11 @@ public:
 #ifdef VL_LEAK_CHECKS
     static void* operator new(size_t size);
     static void operator delete(void* obj, size_t size);
+#elif defined(VL_POOL_ALLOCATOR)
+    static void* operator new(size_t size) { return V3PoolAllocator<AstNode>::allocate(size); }
+    static void operator delete(void* obj, size_t size) {
+        V3PoolAllocator<AstNode>::deallocate(obj, size);
+    }
 #endif
 
     // CONSTANTS
@@ -2850,6 +2856,12 @@ inline bool AstNode::mayBeUnder<AstVarScope>(const AstNode* nodep) {
     return true;
 }
 template <>
+inline bool AstNode::mayBeUnder<AstCFunc>(const AstNode* nodep) {
+    if (VN_IS(nodep, CFunc)) return false;  // Should not nest
+    if (VN_IS(nodep, NodeExpr)) return false;
+    return true;
+}
+template <>
 inline bool AstNode::mayBeUnder<AstExecGraph>(const AstNode* nodep) {
     if (VN_IS(nodep, ExecGraph)) return false;  // Should not nest
     if (VN_IS(nodep, NodeStmt)) return false;  // Should be directly under CFunc
@@ -325,6 +325,7 @@ class AstAssocArrayDType final : public AstNodeDType {
     //
     // @astgen ptr := m_refDTypep : Optional[AstNodeDType]  // Elements of this type (post-width)
     // @astgen ptr := m_keyDTypep : Optional[AstNodeDType]  // Keys of this type (post-width)
+    bool m_unordered = false;  // Never iterated, use hashed storage (V3AssocHash)
 public:
     AstAssocArrayDType(FileLine* fl, VFlagChildDType, AstNodeDType* dtp, AstNodeDType* keyDtp)
         : ASTGEN_SUPER_AssocArrayDType(fl) {
@@ -378,6 +379,8 @@ public:
         return m_keyDTypep ? m_keyDTypep : keyChildDTypep();
     }
     void keyDTypep(AstNodeDType* nodep) { m_keyDTypep = nodep; }
+    bool unordered() const { return m_unordered; }
+    void unordered(bool flag) { m_unordered = flag; }
     // METHODS
     AstBasicDType* basicp() const override VL_MT_STABLE { return nullptr; }
     int widthAlignBytes() const override { return subDTypep()->widthAlignBytes(); }
@@ -982,11 +985,14 @@ public:
 class AstNBACommitQueueDType final : public AstNodeDType {
     // @astgen ptr := m_subDTypep : AstNodeDType  // Type of the corresponding variable
     const bool m_partial;  // Partial element update required
+    const uint32_t m_inlineCapacity;  // Number of updates stored without allocation
 
 public:
-    AstNBACommitQueueDType(FileLine* fl, AstNodeDType* subDTypep, bool partial)
+    AstNBACommitQueueDType(FileLine* fl, AstNodeDType* subDTypep, bool partial,
+                           uint32_t inlineCapacity = 0)
         : ASTGEN_SUPER_NBACommitQueueDType(fl)
         , m_partial{partial}
+        , m_inlineCapacity{inlineCapacity}
         , m_subDTypep{subDTypep} {
         dtypep(this);
     }
@@ -994,9 +1000,10 @@ public:
 
     AstNodeDType* subDTypep() const override VL_MT_STABLE { return m_subDTypep; }
     bool partial() const { return m_partial; }
+    uint32_t inlineCapacity() const { return m_inlineCapacity; }
     bool sameNode(const AstNode* samep) const override {
         const AstNBACommitQueueDType* const asamep = VN_DBG_AS(samep, NBACommitQueueDType);
-        return m_partial == asamep->m_partial;
+        return m_partial == asamep->m_partial && m_inlineCapacity == asamep->m_inlineCapacity;
     }
     bool similarDTypeNode(const AstNodeDType* samep) const override { return this == samep; }
     AstBasicDType* basicp() const override VL_MT_STABLE { return nullptr; }
@@ -1411,6 +1418,8 @@ public:
     bool isAggregateType() const override { return true; }
     // Outer dimension comes first. The first element is this node.
     std::vector<AstUnpackArrayDType*> unpackDimensions();
+    // Stored as VlSparseUnpacked, see --sparse-array-threshold
+    bool isSparse() const;
     void isCompound(bool flag) { m_isCompound = flag; }
     bool isCompound() const override VL_MT_SAFE { return m_isCompound; }
     bool isIntegralOrPacked() const override { return false; }
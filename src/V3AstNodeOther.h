@@ -313,11 +313,13 @@ class AstNodeProcedure VL_NOT_FINAL : public AstNode {
     // @astgen op2 := stmtsp : List[AstNode] // Note: op1 is used in some sub-types only
     bool m_suspendable : 1;  // Is suspendable by a Delay, EventControl, etc.
     bool m_needProcess : 1;  // Uses VlProcess
+    bool m_shared : 1;  // Replicated into several regions, share code via own CFunc
 protected:
     AstNodeProcedure(VNType t, FileLine* fl, AstNode* stmtsp)
         : AstNode{t, fl} {
         m_needProcess = false;
         m_suspendable = false;
+        m_shared = false;
         addStmtsp(stmtsp);
     }
 
@@ -331,6 +333,8 @@ public:
     void setSuspendable() { m_suspendable = true; }
     bool needProcess() const { return m_needProcess; }
     void setNeedProcess() { m_needProcess = true; }
+    bool isShared() const { return m_shared; }
+    void setShared() { m_shared = true; }
 };
 class AstNodeRange VL_NOT_FINAL : public AstNode {
     // A range, sized or unsized
@@ -631,6 +635,8 @@ class AstCFunc final : public AstNode {
     bool m_declPrivate : 1;  // Declare it private
     bool m_keepIfEmpty : 1;  // Keep declaration and definition separate, even if empty
     bool m_slow : 1;  // Slow routine, called once or just at init time
+    bool m_hot : 1;  // Hot routine, from profile data
+    bool m_cold : 1;  // Cold (but not slow) routine, from profile data
     bool m_funcPublic : 1;  // From user public task/function
     bool m_isConstructor : 1;  // Is C class constructor
     bool m_isDestructor : 1;  // Is C class destructor
@@ -664,6 +670,8 @@ public:
         m_declPrivate = false;
         m_keepIfEmpty = false;
         m_slow = false;
+        m_hot = false;
+        m_cold = false;
         m_funcPublic = false;
         m_isConstructor = false;
         m_isDestructor = false;
@@ -718,6 +726,10 @@ public:
     void keepIfEmpty(bool flag) { m_keepIfEmpty = flag; }
     bool slow() const VL_MT_SAFE { return m_slow; }
     void slow(bool flag) { m_slow = flag; }
+    bool hot() const VL_MT_SAFE { return m_hot; }
+    void hot(bool flag) { m_hot = flag; }
+    bool cold() const VL_MT_SAFE { return m_cold; }
+    void cold(bool flag) { m_cold = flag; }
     bool funcPublic() const { return m_funcPublic; }
     void funcPublic(bool flag) { m_funcPublic = flag; }
     void argTypes(const string& str) { m_argTypes = str; }
@@ -1949,6 +1961,7 @@ class AstVar final : public AstNode {
     VVarAttrClocker m_attrClocker;
     VRandAttr m_rand;  // Randomizability of this variable (rand, randc, etc)
     int m_pinNum = 0;  // For XML, if non-zero the connection pin number
+    int m_ownerWorker = -1;  // Thread pool worker of all mtasks using this, -1 = none/several
     bool m_ansi : 1;  // Params or pins declared in the module header, rather than the body
     bool m_declTyped : 1;  // Declared as type (for dedup check)
     bool m_tristate : 1;  // Inout or triwire or trireg
@@ -1994,6 +2007,7 @@ class AstVar final : public AstNode {
     bool m_ignorePostRead : 1;  // Ignore reads in 'Post' blocks during ordering
     bool m_ignorePostWrite : 1;  // Ignore writes in 'Post' blocks during ordering
     bool m_ignoreSchedWrite : 1;  // Ignore writes in scheduling (for special optimizations)
+    bool m_cacheLineStart : 1;  // Start on a new cache line, to avoid false sharing
 
     void init() {
         m_ansi = false;
@@ -2041,6 +2055,7 @@ class AstVar final : public AstNode {
         m_ignorePostRead = false;
         m_ignorePostWrite = false;
         m_ignoreSchedWrite = false;
+        m_cacheLineStart = false;
         m_attrClocker = VVarAttrClocker::CLOCKER_UNKNOWN;
     }
 
@@ -2202,6 +2217,8 @@ public:
     void setIgnorePostWrite() { m_ignorePostWrite = true; }
     bool ignoreSchedWrite() const { return m_ignoreSchedWrite; }
     void setIgnoreSchedWrite() { m_ignoreSchedWrite = true; }
+    bool cacheLineStart() const { return m_cacheLineStart; }
+    void setCacheLineStart() { m_cacheLineStart = true; }
 
     // METHODS
     void name(const string& name) override { m_name = name; }
@@ -2264,6 +2281,7 @@ public:
     bool isSigModPublic() const { return m_sigModPublic && !isIfaceRef(); }
     bool isSigUserRdPublic() const { return m_sigUserRdPublic && !isIfaceRef(); }
     bool isSigUserRWPublic() const { return m_sigUserRWPublic && !isIfaceRef(); }
+    bool isSigObservable() const;
     bool isTrace() const { return m_trace; }
     bool isRand() const { return m_rand.isRand(); }
     bool isRandC() const { return m_rand.isRandC(); }
@@ -2289,6 +2307,8 @@ public:
     VLifetime lifetime() const { return m_lifetime; }
     void pinNum(int id) { m_pinNum = id; }
     int pinNum() const { return m_pinNum; }
+    void ownerWorker(int index) { m_ownerWorker = index; }
+    int ownerWorker() const { return m_ownerWorker; }
     void propagateAttrFrom(const AstVar* fromp) {
         // This is getting connected to fromp; keep attributes
         // Note the method below too
@@ -3054,13 +3074,14 @@ public:
 class AstCoverToggle final : public AstNodeStmt {
     // Toggle analysis of given signal
     // Parents:  MODULE
-    // @astgen op1 := incp : AstCoverInc
+    // With multiple increments, each is for one bit of origp, LSB first
+    // @astgen op1 := incsp : List[AstCoverInc]
     // @astgen op2 := origp : AstNodeExpr
     // @astgen op3 := changep : AstNodeExpr
 public:
-    AstCoverToggle(FileLine* fl, AstCoverInc* incp, AstNodeExpr* origp, AstNodeExpr* changep)
+    AstCoverToggle(FileLine* fl, AstCoverInc* incsp, AstNodeExpr* origp, AstNodeExpr* changep)
         : ASTGEN_SUPER_CoverToggle(fl) {
-        this->incp(incp);
+        addIncsp(incsp);
         this->origp(origp);
         this->changep(changep);
     }
@@ -475,6 +475,12 @@ bool AstVar::isSigPublic() const {
     return (m_sigPublic || (v3Global.opt.allPublic() && !isTemp() && !isGenVar()))
            && !isIfaceRef();
 }
+bool AstVar::isSigObservable() const {
+    // Only read by the user, through VPI, with --public-flat-rd. Its value must be kept, but
+    // its readers may still be optimized as if it was not public.
+    return v3Global.opt.publicFlatRd() && !v3Global.opt.allPublic() && m_sigUserRdPublic
+           && !m_sigUserRWPublic && !isPrimaryIO() && !isIfaceRef();
+}
 bool AstVar::isScQuad() const { return (isSc() && isQuad() && !isScBv() && !isScBigUint()); }
 bool AstVar::isScBv() const {
     return ((isSc() && width() >= v3Global.opt.pinsBv()) || m_attrScBv);
@@ -914,7 +920,8 @@ AstNodeDType::CTypeRecursed AstNodeDType::cTypeRecurse(bool compound, bool packe
         UASSERT_OBJ(!packed, this, "Unsupported type for packed struct or union");
         const CTypeRecursed key = adtypep->keyDTypep()->cTypeRecurse(true, false);
         const CTypeRecursed val = adtypep->subDTypep()->cTypeRecurse(true, false);
-        info.m_type = "VlAssocArray<" + key.m_type + ", " + val.m_type + ">";
+        info.m_type = (adtypep->unordered() ? "VlUnorderedAssocArray<" : "VlAssocArray<")
+                      + key.m_type + ", " + val.m_type + ">";
     } else if (const auto* const adtypep = VN_CAST(dtypep, CDType)) {
         UASSERT_OBJ(!packed, this, "Unsupported type for packed struct or union");
         info.m_type = adtypep->name();
@@ -947,7 +954,7 @@ AstNodeDType::CTypeRecursed AstNodeDType::cTypeRecurse(bool compound, bool packe
         UASSERT_OBJ(!packed, this, "Unsupported type for packed struct or union");
         if (adtypep->isCompound()) compound = true;
         const CTypeRecursed sub = adtypep->subDTypep()->cTypeRecurse(compound, false);
-        info.m_type = "VlUnpacked<" + sub.m_type;
+        info.m_type = (adtypep->isSparse() ? "VlSparseUnpacked<" : "VlUnpacked<") + sub.m_type;
         info.m_type += ", " + cvtToStr(adtypep->declRange().elements());
         info.m_type += ">";
     } else if (const auto* const adtypep = VN_CAST(dtypep, NBACommitQueueDType)) {
@@ -965,6 +972,9 @@ AstNodeDType::CTypeRecursed AstNodeDType::cTypeRecurse(bool compound, bool packe
         info.m_type += adtypep->partial() ? ", true" : ", false";
         info.m_type += ", " + eDTypep->cTypeRecurse(compound, false).m_type;
         info.m_type += ", " + std::to_string(rank);
+        if (adtypep->inlineCapacity()) {
+            info.m_type += ", " + std::to_string(adtypep->inlineCapacity());
+        }
         info.m_type += ">";
     } else if (packed && (VN_IS(dtypep, PackArrayDType))) {
         const AstPackArrayDType* const adtypep = VN_CAST(dtypep, PackArrayDType);
@@ -1620,6 +1630,7 @@ void AstNodeProcedure::dump(std::ostream& str) const {
     this->AstNode::dump(str);
     if (isSuspendable()) str << " [SUSP]";
     if (needProcess()) str << " [NPRC]";
+    if (isShared()) str << " [SHARED]";
 }
 
 void AstNodeProcedure::dumpJson(std::ostream& str) const {
@@ -2295,6 +2306,15 @@ string AstUnpackArrayDType::prettyDTypeName(bool full) const {
     os << subp->prettyDTypeName(full) << "$" << ranges;
     return os.str();
 }
+bool AstUnpackArrayDType::isSparse() const {
+    const int thresholdMB = v3Global.opt.sparseArrayThreshold();
+    if (thresholdMB <= 0) return false;
+    // Only single dimension arrays of packed elements, e.g. memories
+    const AstNodeDType* const subp = subDTypep()->skipRefp();
+    if (!subp->isIntegralOrPacked()) return false;
+    const uint64_t bytes = static_cast<uint64_t>(elementsConst()) * subp->widthTotalBytes();
+    return bytes >= (static_cast<uint64_t>(thresholdMB) << 20ULL);
+}
 std::vector<AstUnpackArrayDType*> AstUnpackArrayDType::unpackDimensions() {
     std::vector<AstUnpackArrayDType*> dims;
     for (AstUnpackArrayDType* unpackp = this; unpackp;) {
@@ -2455,6 +2475,7 @@ void AstTypeTable::dumpJson(std::ostream& str) const { dumpJsonGen(str); }
 void AstAssocArrayDType::dumpSmall(std::ostream& str) const {
     this->AstNodeDType::dumpSmall(str);
     str << "[assoc-" << nodeAddr(keyDTypep()) << "]";
+    if (unordered()) str << " [UNORDERED]";
 }
 string AstAssocArrayDType::prettyDTypeName(bool full) const {
     return subDTypep()->prettyDTypeName(full) + "$[" + keyDTypep()->prettyDTypeName(full) + "]";
@@ -2975,6 +2996,8 @@ void AstCFile::dumpJson(std::ostream& str) const {
 void AstCFunc::dump(std::ostream& str) const {
     this->AstNode::dump(str);
     if (slow()) str << " [SLOW]";
+    if (hot()) str << " [HOT]";
+    if (cold()) str << " [COLD]";
     if (isStatic()) str << " [STATIC]";
     if (dpiContext()) str << " [DPICTX]";
     if (dpiExportDispatcher()) str << " [DPIED]";
@@ -3028,7 +3051,9 @@ int AstCMethodHard::instrCount() const {
     return 0;
 }
 void AstCMethodHard::setPurity() {
-    static const std::map<std::string, bool> isPureMethod{{"andNot", false},
+    static const std::map<std::string, bool> isPureMethod{{"addPeriodic", false},
+                                                          {"addTimeout", false},
+                                                          {"andNot", false},
                                                           {"any", true},
                                                           {"anyTriggered", false},
                                                           {"assign", false},
@@ -3039,14 +3064,17 @@ void AstCMethodHard::setPurity() {
                                                           {"clear", false},
                                                           {"clearFired", false},
                                                           {"commit", false},
+                                                          {"copyRange", false},
                                                           {"delay", false},
                                                           {"done", false},
                                                           {"enqueue", false},
                                                           {"erase", false},
                                                           {"evaluate", false},
                                                           {"evaluation", false},
+                                                          {"event", false},
                                                           {"exists", true},
                                                           {"fill", false},
+                                                          {"fillRange", false},
                                                           {"find", true},
                                                           {"find_first", true},
                                                           {"find_first_index", true},
@@ -3095,6 +3123,7 @@ void AstCMethodHard::setPurity() {
                                                           {"sliceFrontBack", true},
                                                           {"sort", false},
                                                           {"thisOr", false},
+                                                          {"timerDue", false},
                                                           {"trigger", false},
                                                           {"unique", true},
                                                           {"unique_index", true},
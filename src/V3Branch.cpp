@@ -17,6 +17,7 @@
 //      At each IF/(IF else).
 //         Count underneath $display/$stop statements.
 //         If more on if than else, this branch is unlikely, or vice-versa.
+//         Otherwise, if --coverage-pgo data shows a biased branch, predict it.
 //      At each FTASKREF,
 //         Count calls into the function
 //      Then, if FTASK is called only once, add inline attribute
@@ -27,6 +28,9 @@
 
 #include "V3Branch.h"
 
+#include "V3CoveragePgo.h"
+#include "V3Stats.h"
+
 VL_DEFINE_DEBUG_FUNCTIONS;
 
 //######################################################################
@@ -40,6 +44,8 @@ class BranchVisitor final : public VNVisitorConst {
 
     // STATE - across all visitors
     std::vector<AstCFunc*> m_cfuncsp;  // List of all tasks
+    size_t m_statCoverageHints = 0;  // Branches predicted from --coverage-pgo
+    static constexpr int64_t BIAS_RATIO = 9;  // Taken to not taken ratio to hint a branch
 
     // STATE - for current visit position (use VL_RESTORER)
     int m_likely = false;  // Excuses for branch likely taken
@@ -80,9 +86,25 @@ class BranchVisitor final : public VNVisitorConst {
                 nodep->branchPred(VBranchPred::BP_LIKELY);
             } else if (likeness < 0) {
                 nodep->branchPred(VBranchPred::BP_UNLIKELY);
+            } else if (nodep->branchPred().unknown()) {
+                predictFromCoverage(nodep);
             }  // else leave unknown
         }
     }
+    void predictFromCoverage(AstNodeIf* nodep) {
+        // The 'else' coverage point is one column after the 'if'
+        const int64_t thenCount = V3CoveragePgo::count(nodep->fileline(), 0, "if");
+        const int64_t elseCount = V3CoveragePgo::count(nodep->fileline(), 1, "else");
+        if (thenCount < 0 || elseCount < 0 || thenCount + elseCount == 0) return;
+        // Only hint clearly biased branches
+        if (thenCount >= BIAS_RATIO * elseCount) {
+            nodep->branchPred(VBranchPred::BP_LIKELY);
+            ++m_statCoverageHints;
+        } else if (elseCount >= BIAS_RATIO * thenCount) {
+            nodep->branchPred(VBranchPred::BP_UNLIKELY);
+            ++m_statCoverageHints;
+        }
+    }
     void visit(AstNodeCCall* nodep) override {
         checkUnlikely(nodep);
         nodep->funcp()->user1Inc();
@@ -112,7 +134,9 @@ public:
         iterateChildrenConst(nodep);
         calc_tasks();
     }
-    ~BranchVisitor() override = default;
+    ~BranchVisitor() override {
+        V3Stats::addStat("Optimizations, Branches predicted from coverage", m_statCoverageHints);
+    }
 };
 
 //######################################################################
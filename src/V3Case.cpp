@@ -24,9 +24,10 @@
 //                                                  (other items))
 //                                              body
 //              Or, converts to a if/else tree.
+//          Large 16+ bit cases with many constants and no masking (address muxes, decoders)
+//              Sort the values, and use a binary tree of < compares, with short chains of
+//              == compares at the leaves.
 //      FUTURES:
-//          Large 16+ bit tables with constants and no masking (address muxes)
-//              Enter all into std::multimap, sort by value and use a tree of < and == compares.
 //          "Diagonal" find of {rightmost,leftmost} bit {set,clear}
 //              Ignoring mask, check each value is unique (using std::multimap as above?)
 //              Each branch is then mask-and-compare operation (IE
@@ -38,6 +39,8 @@
 
 #include "V3Case.h"
 
+#include "V3CoveragePgo.h"
+
 #include "V3Stats.h"
 
 VL_DEFINE_DEBUG_FUNCTIONS;
@@ -45,6 +48,8 @@ VL_DEFINE_DEBUG_FUNCTIONS;
 #define CASE_OVERLAP_WIDTH 16  // Maximum width we can check for overlaps in
 #define CASE_BARF 999999  // Magic width when non-constant
 #define CASE_ENCODER_GROUP_DEPTH 8  // Levels of priority to be ORed together in top IF tree
+#define CASE_BINARY_MIN_ITEMS 8  // Minimum number of values to use a binary search tree
+#define CASE_BINARY_LEAF_ITEMS 3  // Maximum number of == compares in binary search tree leaves
 
 //######################################################################
 
@@ -122,6 +127,8 @@ class CaseVisitor final : public VNVisitor {
     // STATE
     VDouble0 m_statCaseFast;  // Statistic tracking
     VDouble0 m_statCaseSlow;  // Statistic tracking
+    VDouble0 m_statCaseBinary;  // Statistic tracking
+    VDouble0 m_statCaseReordered;  // Statistic tracking
     const AstNode* m_alwaysp = nullptr;  // Always in which case is located
 
     // Per-CASE
@@ -399,11 +406,132 @@ class CaseVisitor final : public VNVisitor {
         if (debug() >= 9) ifrootp->dumpTree("-    _simp: ");
     }
 
+    // Case with only distinct (after dropping duplicates) narrow two-state constant values
+    // Returns the values sorted, with the item each selects, or empty if not applicable.
+    std::vector<std::pair<uint64_t, AstCaseItem*>> caseBinaryValues(AstCase* nodep) {
+        std::vector<std::pair<uint64_t, AstCaseItem*>> values;
+        AstNodeExpr* const cexprp = nodep->exprp();
+        if (cexprp->width() > 64 || cexprp->isDouble() || cexprp->isString()) return {};
+        if (!cexprp->isPure()) return {};
+        for (AstCaseItem* itemp = nodep->itemsp(); itemp;
+             itemp = VN_AS(itemp->nextp(), CaseItem)) {
+            for (AstNode* icondp = itemp->condsp(); icondp; icondp = icondp->nextp()) {
+                const AstConst* const iconstp = VN_CAST(icondp, Const);
+                if (!iconstp || iconstp->num().isFourState()) return {};
+                if (iconstp->width() != cexprp->width()) return {};
+                values.emplace_back(iconstp->num().toUQuad(), itemp);
+            }
+        }
+        // Earlier items have priority, so keep the first of equal values
+        std::stable_sort(values.begin(), values.end(),
+                         [](const std::pair<uint64_t, AstCaseItem*>& a,
+                            const std::pair<uint64_t, AstCaseItem*>& b) {
+                             return a.first < b.first;
+                         });
+        values.erase(std::unique(values.begin(), values.end(),
+                                 [](const std::pair<uint64_t, AstCaseItem*>& a,
+                                    const std::pair<uint64_t, AstCaseItem*>& b) {
+                                     return a.first == b.first;
+                                 }),
+                     values.end());
+        if (values.size() < CASE_BINARY_MIN_ITEMS) return {};
+        return values;
+    }
+
+    AstNode* replaceCaseBinaryRecurse(AstNodeExpr* cexprp,
+                                      const std::vector<std::pair<uint64_t, AstCaseItem*>>& values,
+                                      size_t lo, size_t hi, AstNode* defaultp) {
+        FileLine* const flp = cexprp->fileline();
+        const auto newConst = [&](uint64_t value) {
+            V3Number num{cexprp, cexprp->width()};
+            num.setQuad(value);
+            return new AstConst{flp, num};
+        };
+        if (hi - lo > CASE_BINARY_LEAF_ITEMS) {
+            // IF(cexpr < pivot, lower half, upper half)
+            const size_t mid = lo + (hi - lo) / 2;
+            AstNodeExpr* const condp
+                = new AstLt{flp, cexprp->cloneTreePure(false), newConst(values[mid].first)};
+            return new AstIf{flp, condp,
+                             replaceCaseBinaryRecurse(cexprp, values, lo, mid, defaultp),
+                             replaceCaseBinaryRecurse(cexprp, values, mid, hi, defaultp)};
+        }
+        // Chain of IF(cexpr == value, stmts, ...), ending in the default
+        AstNode* resultp = defaultp ? defaultp->cloneTree(true) : nullptr;
+        for (size_t i = hi; i-- > lo;) {
+            AstNodeExpr* const condp = AstEq::newTyped(flp, cexprp->cloneTreePure(false),
+                                                       newConst(values[i].first));
+            AstNode* const stmtsp = values[i].second->stmtsp();
+            resultp = new AstIf{flp, condp, stmtsp ? stmtsp->cloneTree(true) : nullptr, resultp};
+        }
+        return resultp;
+    }
+
+    void replaceCaseBinary(AstCase* nodep,
+                           const std::vector<std::pair<uint64_t, AstCaseItem*>>& values) {
+        // CASE(cexpr, ITEM(v1, s1), ... ITEM(vN, sN), ITEM(default, sD))
+        // ->  IF(cexpr < vMid, IF(cexpr < ...), IF(cexpr < ...)), with leaves
+        //     IF(cexpr == vI, sI, IF(cexpr == vJ, sJ, sD))
+        AstNode* defaultp = nullptr;
+        for (AstCaseItem* itemp = nodep->itemsp(); itemp;
+             itemp = VN_AS(itemp->nextp(), CaseItem)) {
+            if (itemp->isDefault()) defaultp = itemp->stmtsp();
+        }
+        replaceCaseParallel(nodep, false);
+        AstNode* const ifrootp
+            = replaceCaseBinaryRecurse(nodep->exprp(), values, 0, values.size(), defaultp);
+        nodep->replaceWith(ifrootp);
+        VL_DO_DANGLING(nodep->deleteTree(), nodep);
+        if (debug() >= 9) ifrootp->dumpTree("-    _bin: ");
+    }
+
+    // With --coverage-pgo, put the most frequently taken items first, so the
+    // resulting if/else chain usually matches early. Only done when there is
+    // no priority between the items: all conditions are distinct constants.
+    void reorderByCoverage(AstCase* nodep) {
+        if (v3Global.opt.coveragePgo().empty()) return;
+        std::set<std::string> values;
+        std::vector<std::pair<int64_t, AstCaseItem*>> items;
+        bool anyCount = false;
+        for (AstCaseItem* itemp = nodep->itemsp(); itemp;
+             itemp = VN_AS(itemp->nextp(), CaseItem)) {
+            if (itemp->isDefault()) {
+                if (itemp->nextp()) return;  // Default must stay last
+                break;
+            }
+            for (AstNode* condp = itemp->condsp(); condp; condp = condp->nextp()) {
+                const AstConst* const constp = VN_CAST(condp, Const);
+                if (!constp || constp->num().isFourState()) return;
+                if (constp->width() != nodep->exprp()->width()) return;
+                if (!values.emplace(constp->num().ascii()).second) return;
+            }
+            const int64_t count = V3CoveragePgo::count(itemp->fileline(), 0, "case");
+            if (count >= 0) anyCount = true;
+            items.emplace_back(count, itemp);
+        }
+        if (!anyCount || items.size() < 2) return;
+        const std::vector<std::pair<int64_t, AstCaseItem*>> origItems = items;
+        std::stable_sort(items.begin(), items.end(),
+                         [](const std::pair<int64_t, AstCaseItem*>& a,
+                            const std::pair<int64_t, AstCaseItem*>& b) {
+                             return a.first > b.first;
+                         });
+        if (items == origItems) return;
+        UINFO(4, "Reordering case items from coverage " << nodep);
+        AstCaseItem* const defaultp = VN_CAST(items.back().second->nextp(), CaseItem);
+        if (defaultp) defaultp->unlinkFrBack();
+        for (const auto& pair : items) pair.second->unlinkFrBack();
+        for (const auto& pair : items) nodep->addItemsp(pair.second);
+        if (defaultp) nodep->addItemsp(defaultp);
+        ++m_statCaseReordered;
+    }
+
     void replaceCaseComplicated(AstCase* nodep) {
         // CASEx(cexpr,ITEM(icond1,istmts1),ITEM(icond2,istmts2),ITEM(default,istmts3))
         // ->  IF((cexpr==icond1),istmts1,
         //                       IF((EQ (AND MASK cexpr) (AND MASK icond1)
         //                              ,istmts2, istmts3
+        reorderByCoverage(nodep);
         AstNodeExpr* const cexprp = nodep->exprp()->unlinkFrBack();
         // We'll do this in two stages.  First stage, convert the conditions to
         // the appropriate IF AND terms.
@@ -569,9 +697,19 @@ class CaseVisitor final : public VNVisitor {
             // we can make a tree of statements to avoid extra comparisons
             ++m_statCaseFast;
             VL_DO_DANGLING(replaceCaseFast(nodep), nodep);
+            return;
+        }
+        // If a case statement is whole, presume signals involved aren't forming a latch
+        if (m_alwaysp) m_alwaysp->fileline()->warnOff(V3ErrorCode::LATCH, true);
+        const std::vector<std::pair<uint64_t, AstCaseItem*>> values
+            = v3Global.opt.fCase() && v3Global.opt.coveragePgo().empty()
+                  ? caseBinaryValues(nodep)
+                  : std::vector<std::pair<uint64_t, AstCaseItem*>>{};
+        if (!values.empty()) {
+            // Many constant values, use a binary search instead of a long compare chain
+            ++m_statCaseBinary;
+            VL_DO_DANGLING(replaceCaseBinary(nodep, values), nodep);
         } else {
-            // If a case statement is whole, presume signals involved aren't forming a latch
-            if (m_alwaysp) m_alwaysp->fileline()->warnOff(V3ErrorCode::LATCH, true);
             ++m_statCaseSlow;
             VL_DO_DANGLING(replaceCaseComplicated(nodep), nodep);
         }
@@ -593,6 +731,8 @@ public:
     ~CaseVisitor() override {
         V3Stats::addStat("Optimizations, Cases parallelized", m_statCaseFast);
         V3Stats::addStat("Optimizations, Cases complex", m_statCaseSlow);
+        V3Stats::addStat("Optimizations, Cases binary searched", m_statCaseBinary);
+        V3Stats::addStat("Optimizations, Cases reordered from coverage", m_statCaseReordered);
     }
 };
 
@@ -23,6 +23,7 @@
 //                      Add a __Vlast_{clock} for the comparison
 //                      Set the __Vlast_{clock} at the end of the block
 //              Replace UNTILSTABLEs with loops until specified signals become const.
+//      Nest runs of IFs testing triggers in the same word under a test of the whole word
 //   Create global calling function for any per-scope functions.  (For FINALs).
 //
 //*************************************************************************
@@ -32,6 +33,7 @@
 #include "V3Clock.h"
 
 #include "V3Const.h"
+#include "V3Stats.h"
 
 VL_DEFINE_DEBUG_FUNCTIONS;
 
@@ -100,10 +102,31 @@ class ClockVisitor final : public VNVisitor {
         // if (debug()) nodep->dumpTree("-  ct: ");
         // COVERTOGGLE(INC, ORIG, CHANGE) ->
         //   IF(ORIG ^ CHANGE) { INC; CHANGE = ORIG; }
-        AstNode* const incp = nodep->incp()->unlinkFrBack();
+        AstCoverInc* const incsp = nodep->incsp()->unlinkFrBackWithNext();
         AstNodeExpr* const origp = nodep->origp()->unlinkFrBack();
         AstNodeExpr* const changeWrp = nodep->changep()->unlinkFrBack();
         AstNodeExpr* const changeRdp = ConvertWriteRefsToRead::main(changeWrp->cloneTree(false));
+        if (incsp->nextp()) {
+            // COVERTOGGLE(INC0 INC1 ..., ORIG, CHANGE) ->
+            //   IF(ORIG != CHANGE) { IF(ORIG[0] ^ CHANGE[0]) INC0; ...; CHANGE = ORIG; }
+            // so a word that did not change costs one compare, not a branch per bit
+            AstIf* const newp
+                = new AstIf{nodep->fileline(), new AstNeq{nodep->fileline(), origp, changeRdp}};
+            int bit = 0;
+            for (AstCoverInc *incp = incsp, *nextp; incp; incp = nextp, ++bit) {
+                nextp = VN_AS(incp->nextp(), CoverInc);
+                if (nextp) nextp->unlinkFrBackWithNext();
+                FileLine* const flp = incp->fileline();
+                AstNodeExpr* const diffp = new AstXor{flp, origp->cloneTree(false),
+                                                      changeRdp->cloneTree(false)};
+                newp->addThensp(new AstIf{flp, new AstSel{flp, diffp, bit, 1}, incp});
+            }
+            newp->addThensp(new AstAssign{nodep->fileline(), changeWrp, origp->cloneTree(false)});
+            nodep->replaceWith(newp);
+            VL_DO_DANGLING(nodep->deleteTree(), nodep);
+            return;
+        }
+        AstNode* const incp = incsp;
         AstNodeExpr* comparedp = nullptr;
         // Xor will optimize better than Eq, when CoverToggle has bit selects,
         // but can only use Xor with non-opaque types
@@ -187,11 +210,101 @@ public:
     ~ClockVisitor() override = default;
 };
 
+//######################################################################
+// Nest adjacent trigger tests of the same trigger vector word
+
+class TriggerGroupVisitor final : public VNVisitor {
+    // Minimum number of adjacent tests of the same word to nest under a test of the word
+    static constexpr size_t GROUP_MIN = 4;
+
+    // STATE
+    VDouble0 m_statGroups;  // Statistic tracking
+
+    // METHODS
+    // If 'nodep' is 'if (vec.word(n) & mask) ...' with no else, return 'vec.word(n)'
+    static AstCMethodHard* triggerWordp(AstNode* nodep, uint64_t& mask) {
+        const AstIf* const ifp = VN_CAST(nodep, If);
+        if (!ifp || ifp->elsesp()) return nullptr;
+        const AstAnd* const andp = VN_CAST(ifp->condp(), And);
+        if (!andp) return nullptr;
+        const AstConst* const constp = VN_CAST(andp->lhsp(), Const);
+        AstCMethodHard* const callp = VN_CAST(andp->rhsp(), CMethodHard);
+        if (!constp || !callp || callp->name() != "word") return nullptr;
+        const AstVarRef* const refp = VN_CAST(callp->fromp(), VarRef);
+        if (!refp || !VN_IS(callp->pinsp(), Const)) return nullptr;
+        const AstBasicDType* const basicp = refp->dtypep()->basicp();
+        if (!basicp || !basicp->isTriggerVec()) return nullptr;
+        mask = constp->num().toUQuad();
+        return callp;
+    }
+
+    void groupList(AstNode* headp) {
+        for (AstNode* nodep = headp; nodep;) {
+            uint64_t mask = 0;
+            AstCMethodHard* const wordp = triggerWordp(nodep, mask);
+            if (!wordp) {
+                nodep = nodep->nextp();
+                continue;
+            }
+            // Find the run of tests of the same word
+            size_t count = 1;
+            uint64_t groupMask = mask;
+            AstNode* lastp = nodep;
+            for (AstNode* nextp = nodep->nextp(); nextp; nextp = nextp->nextp()) {
+                const AstCMethodHard* const nextWordp = triggerWordp(nextp, mask);
+                if (!nextWordp || !nextWordp->sameTree(wordp)) break;
+                groupMask |= mask;
+                lastp = nextp;
+                ++count;
+            }
+            AstNode* const afterp = lastp->nextp();
+            if (count >= GROUP_MIN) {
+                // IF(w & m0, s0), IF(w & m1, s1), ... ->
+                //   IF(w & (m0 | m1 | ...), IF(w & m0, s0), IF(w & m1, s1), ...)
+                ++m_statGroups;
+                FileLine* const flp = nodep->fileline();
+                AstNodeExpr* const wordCopyp = wordp->cloneTree(false);
+                AstIf* const groupp = new AstIf{
+                    flp, new AstAnd{flp, new AstConst{flp, AstConst::Unsized64{}, groupMask},
+                                    wordCopyp}};
+                if (afterp) afterp->unlinkFrBackWithNext();
+                VNRelinker relinker;
+                nodep->unlinkFrBackWithNext(&relinker);
+                groupp->addThensp(nodep);
+                relinker.relink(groupp);
+                if (afterp) groupp->addNextHere(afterp);
+            }
+            nodep = afterp;
+        }
+    }
+
+    // VISITORS
+    void visit(AstCFunc* nodep) override {
+        iterateChildren(nodep);
+        groupList(nodep->stmtsp());
+    }
+    void visit(AstIf* nodep) override {
+        iterateChildren(nodep);
+        groupList(nodep->thensp());
+        groupList(nodep->elsesp());
+    }
+    void visit(AstNodeExpr*) override {}  // Accelerate
+    void visit(AstNode* nodep) override { iterateChildren(nodep); }
+
+public:
+    // CONSTRUCTORS
+    explicit TriggerGroupVisitor(AstNetlist* netlistp) { iterate(netlistp); }
+    ~TriggerGroupVisitor() override {
+        V3Stats::addStat("Optimizations, Clock trigger tests grouped", m_statGroups);
+    }
+};
+
 //######################################################################
 // Clock class functions
 
 void V3Clock::clockAll(AstNetlist* nodep) {
     UINFO(2, __FUNCTION__ << ":");
     { ClockVisitor{nodep}; }  // Destruct before checking
+    { TriggerGroupVisitor{nodep}; }
     V3Global::dumpCheckGlobalTree("clock", 0, dumpTreeEitherLevel() >= 3);
 }
@@ -553,6 +553,7 @@ class V3ControlResolver final {
         m_profileData;  // Access to profile_data records
     uint8_t m_mode = NONE;
     std::unordered_map<string, V3ControlResolverHierWorkerEntry> m_hierWorkers;
+    std::unordered_map<string, string> m_dpiDomains;  // DPI import C name -> domain
     FileLine* m_profileFileLine = nullptr;
 
     V3ControlResolver() = default;
@@ -587,6 +588,21 @@ public:
         m_hierWorkers.emplace(std::piecewise_construct, std::forward_as_tuple(model),
                               std::forward_as_tuple(workers, flp));
     }
+    void addDpiDomain(FileLine* flp, const string& cname, const string& domain) {
+        if (domain.empty()) {
+            flp->v3error("dpi_domain -domain must not be empty");
+            return;
+        }
+        const auto pair = m_dpiDomains.emplace(cname, domain);
+        if (!pair.second && pair.first->second != domain) {
+            flp->v3error("DPI import '" << cname << "' already has dpi_domain '"
+                                        << pair.first->second << "'");
+        }
+    }
+    string getDpiDomain(const string& cname) const {
+        const auto it = m_dpiDomains.find(cname);
+        return it != m_dpiDomains.cend() ? it->second : "";
+    }
     int getHierWorkers(const string& model) const {
         const auto mit = m_hierWorkers.find(model);
         // Assign a single worker if no specified.
@@ -628,6 +644,10 @@ void V3Control::addCoverageBlockOff(const string& module, const string& blocknam
     V3ControlResolver::s().modules().at(module).addCoverageBlockOff(blockname);
 }
 
+void V3Control::addDpiDomain(FileLine* fl, const string& cname, const string& domain) {
+    V3ControlResolver::s().addDpiDomain(fl, cname, domain);
+}
+
 void V3Control::addHierWorkers(FileLine* fl, const string& model, int workers) {
     V3ControlResolver::s().addHierWorkers(fl, model, workers);
 }
@@ -772,6 +792,9 @@ void V3Control::applyVarAttr(AstNodeModule* modulep, AstNodeFTask* ftaskp, AstVa
     if (vp) vp->apply(varp);
 }
 
+string V3Control::getDpiDomain(const string& cname) {
+    return V3ControlResolver::s().getDpiDomain(cname);
+}
 int V3Control::getHierWorkers(const string& model) {
     return V3ControlResolver::s().getHierWorkers(model);
 }
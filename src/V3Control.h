@@ -33,6 +33,7 @@ public:
     static void addCaseParallel(const string& file, int lineno);
     static void addCoverageBlockOff(const string& file, int lineno);
     static void addCoverageBlockOff(const string& module, const string& blockname);
+    static void addDpiDomain(FileLine* fl, const string& cname, const string& domain);
     static void addHierWorkers(FileLine* fl, const string& model, int workers);
     static void addIgnore(V3ErrorCode code, bool on, const string& filename, int min, int max);
     static void addIgnoreMatch(V3ErrorCode code, const string& filename, const string& contents,
@@ -53,6 +54,7 @@ public:
     static void applyModule(AstNodeModule* modulep);
     static void applyVarAttr(AstNodeModule* modulep, AstNodeFTask* ftaskp, AstVar* varp);
 
+    static string getDpiDomain(const string& cname);
     static int getHierWorkers(const string& model);
     static FileLine* getHierWorkersFileLine(const string& model);
     static uint64_t getProfileData(const string& hierDpi);
@@ -403,13 +403,15 @@ class CoverageVisitor final : public VNVisitor {
         }
     }
 
-    void toggleVarBottom(const ToggleEnt& above, const AstVar* varp) {
+    AstCoverInc* newToggleInc(const string& comment, const AstVar* varp) {
         const std::string hierPrefix
             = (m_beginHier != "") ? AstNode::prettyName(m_beginHier) + "." : "";
+        return newCoverInc(varp->fileline(), "", "v_toggle", hierPrefix + varp->name() + comment,
+                           "", 0, "");
+    }
+    void toggleVarBottom(const ToggleEnt& above, const AstVar* varp) {
         AstCoverToggle* const newp = new AstCoverToggle{
-            varp->fileline(),
-            newCoverInc(varp->fileline(), "", "v_toggle",
-                        hierPrefix + varp->name() + above.m_comment, "", 0, ""),
+            varp->fileline(), newToggleInc(above.m_comment, varp),
             above.m_varRefp->cloneTree(false), above.m_chgRefp->cloneTree(false)};
         m_modp->addStmtsp(newp);
     }
@@ -418,17 +420,19 @@ class CoverageVisitor final : public VNVisitor {
                           const ToggleEnt& above, const AstVar* const varp) {  // Constant
         if (const AstBasicDType* const bdtypep = VN_CAST(dtypep, BasicDType)) {
             if (bdtypep->isRanged()) {
+                // One toggle for the whole word, with a bucket per bit, so V3Clock can
+                // skip all of the per-bit tests when the word has not changed
+                AstCoverInc* incsp = nullptr;
                 for (int index_docs = bdtypep->lo(); index_docs < bdtypep->hi() + 1;
                      ++index_docs) {
-                    const int index_code = index_docs - bdtypep->lo();
-                    ToggleEnt newent{above.m_comment + "["s + cvtToStr(index_docs) + "]",
-                                     new AstSel{varp->fileline(),
-                                                above.m_varRefp->cloneTree(false), index_code, 1},
-                                     new AstSel{varp->fileline(),
-                                                above.m_chgRefp->cloneTree(false), index_code, 1}};
-                    toggleVarBottom(newent, varp);
-                    newent.cleanup();
+                    incsp = AstNode::addNext(
+                        incsp,
+                        newToggleInc(above.m_comment + "["s + cvtToStr(index_docs) + "]", varp));
                 }
+                AstCoverToggle* const newp = new AstCoverToggle{
+                    varp->fileline(), incsp, above.m_varRefp->cloneTree(false),
+                    above.m_chgRefp->cloneTree(false)};
+                m_modp->addStmtsp(newp);
             } else {
                 toggleVarBottom(above, varp);
             }
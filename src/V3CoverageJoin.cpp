@@ -70,19 +70,24 @@ class CoverageJoinVisitor final : public VNVisitor {
                 // covertoggle which is immediately above, so:
                 AstCoverToggle* const removep = VN_AS(duporigp->backp(), CoverToggle);
                 UASSERT_OBJ(removep, nodep, "CoverageJoin duplicate of wrong type");
-                UINFO(8, "  Orig " << nodep << " -->> " << nodep->incp()->declp());
-                UINFO(8, "   dup " << removep << " -->> " << removep->incp()->declp());
                 // The CoverDecl the duplicate pointed to now needs to point to the
                 // original's data. I.e. the duplicate will get the coverage number
-                // from the non-duplicate
-                AstCoverDecl* const datadeclp = nodep->incp()->declp()->dataDeclThisp();
-                removep->incp()->declp()->dataDeclp(datadeclp);
-                UINFO(8, "   new " << removep->incp()->declp());
+                // from the non-duplicate. Identical origp have the same width, so
+                // per-bit increments pair up one to one.
+                for (AstCoverInc *incp = nodep->incsp(), *dupIncp = removep->incsp();
+                     incp && dupIncp; incp = VN_AS(incp->nextp(), CoverInc),
+                                 dupIncp = VN_AS(dupIncp->nextp(), CoverInc)) {
+                    UINFO(8, "  Orig " << nodep << " -->> " << incp->declp());
+                    UINFO(8, "   dup " << removep << " -->> " << dupIncp->declp());
+                    AstCoverDecl* const datadeclp = incp->declp()->dataDeclThisp();
+                    dupIncp->declp()->dataDeclp(datadeclp);
+                    UINFO(8, "   new " << dupIncp->declp());
+                    ++m_statToggleJoins;
+                }
                 // Mark the found node as a duplicate of the first node
                 // (Not vice-versa as we have the iterator for the found node)
                 removep->unlinkFrBack();
                 VL_DO_DANGLING(pushDeletep(removep), removep);
-                ++m_statToggleJoins;
             }
         }
     }
@@ -0,0 +1,97 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//*************************************************************************
+// DESCRIPTION: Verilator: Coverage data guided branch prediction
+//
+// Code available from: https://verilator.org
+//
+//*************************************************************************
+//
+// Copyright 2025 by Wilson Snyder. This program is free software; you
+// can redistribute it and/or modify it under the terms of either the GNU
+// Lesser General Public License Version 3 or the Perl Artistic License
+// Version 2.0.
+// SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+//
+//*************************************************************************
+// Read the coverage.dat given with --coverage-pgo, and total the line and
+// branch coverage counts of each source location over all instances.
+//*************************************************************************
+
+#include "V3PchAstNoMT.h"  // VL_MT_DISABLED_CODE_UNIT
+
+#include "V3CoveragePgo.h"
+
+#include "verilated_cov_key.h"
+
+#include <fstream>
+#include <unordered_map>
+
+VL_DEFINE_DEBUG_FUNCTIONS;
+
+//######################################################################
+
+class CoveragePgoData final {
+    // MEMBERS
+    std::unordered_map<std::string, uint64_t> m_counts;  // Location key -> total count
+
+    // METHODS
+    static std::string keyValue(const std::string& name, const char* shortKey) {
+        const std::string start = std::string{"\001"} + shortKey + "\002";
+        const size_t pos = name.find(start);
+        if (pos == std::string::npos) return "";
+        const size_t begin = pos + start.size();
+        const size_t end = name.find('\001', begin);
+        return name.substr(begin, end == std::string::npos ? std::string::npos : end - begin);
+    }
+    void read(const std::string& filename) {
+        std::ifstream is{filename};
+        if (!is) {
+            v3fatal("Can't read --coverage-pgo file: " << filename);
+            return;
+        }
+        std::string line;
+        while (std::getline(is, line)) {
+            // C '<\001key\002value...>' <count>
+            if (line.size() < 4 || line[0] != 'C' || line[2] != '\'') continue;
+            const size_t end = line.rfind('\'');
+            if (end <= 2) continue;
+            const std::string name = line.substr(3, end - 3);
+            const uint64_t count = std::strtoull(line.c_str() + end + 1, nullptr, 10);
+            const std::string comment = keyValue(name, VL_CIK_COMMENT);
+            if (comment != "if" && comment != "else" && comment != "case") continue;
+            m_counts[key(keyValue(name, VL_CIK_FILENAME), keyValue(name, VL_CIK_LINENO),
+                         keyValue(name, VL_CIK_COLUMN), comment)]
+                += count;
+        }
+        UINFO(2, "Read " << m_counts.size() << " coverage locations from " << filename);
+    }
+
+public:
+    static std::string key(const std::string& filename, const std::string& lineno,
+                           const std::string& column, const std::string& comment) {
+        return filename + ":" + lineno + ":" + column + ":" + comment;
+    }
+    int64_t count(const std::string& key) const {
+        const auto it = m_counts.find(key);
+        return it == m_counts.end() ? -1 : static_cast<int64_t>(it->second);
+    }
+    static CoveragePgoData& s() {
+        static CoveragePgoData s_data{v3Global.opt.coveragePgo()};
+        return s_data;
+    }
+
+    // CONSTRUCTORS
+    explicit CoveragePgoData(const std::string& filename) {
+        if (!filename.empty()) read(filename);
+    }
+};
+
+//######################################################################
+// V3CoveragePgo class functions
+
+int64_t V3CoveragePgo::count(const FileLine* flp, int columnOffset, const std::string& comment) {
+    if (v3Global.opt.coveragePgo().empty()) return -1;
+    return CoveragePgoData::s().count(
+        CoveragePgoData::key(flp->filename(), std::to_string(flp->lineno()),
+                             std::to_string(flp->firstColumn() + columnOffset), comment));
+}
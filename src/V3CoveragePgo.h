@@ -0,0 +1,37 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//*************************************************************************
+// DESCRIPTION: Verilator: Coverage data guided branch prediction
+//
+// Code available from: https://verilator.org
+//
+//*************************************************************************
+//
+// Copyright 2025 by Wilson Snyder. This program is free software; you
+// can redistribute it and/or modify it under the terms of either the GNU
+// Lesser General Public License Version 3 or the Perl Artistic License
+// Version 2.0.
+// SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+//
+//*************************************************************************
+
+#ifndef VERILATOR_V3COVERAGEPGO_H_
+#define VERILATOR_V3COVERAGEPGO_H_
+
+#include "config_build.h"
+#include "verilatedos.h"
+
+#include <string>
+
+class FileLine;
+
+//============================================================================
+
+class V3CoveragePgo final {
+public:
+    // Hit count of the line or branch coverage point with the given comment
+    // ("if", "else", "case") at the location, or -1 if not in the --coverage-pgo data
+    static int64_t count(const FileLine* flp, int columnOffset,
+                         const std::string& comment) VL_MT_DISABLED;
+};
+
+#endif  // Guard
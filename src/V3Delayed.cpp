@@ -108,6 +108,19 @@
 //      __VdlyCommitQueue__LHS.enqueue(__VdlyVal__LHS, __VdlyDim0__LHS, __VdlyDim1__LHS);
 //  - Add new "Post-scheduled" logic:
 //      __VdlyCommitQueue.commit(LHS);
+// For partial updates, the queue stores the first few updates in a fixed
+// size buffer, coalescing updates to the same element, sized here from the
+// number of array elements, or the number of NBAs to the variable.
+//
+// "Direct" scheme. Used for variables only updated by NBAs in clocked
+// logic, that are never read while evaluating the model, except by initial,
+// static or final blocks, e.g. top level outputs only read by the user.
+// No logic can observe the update before the commit, so it's applied
+// immediately, without a shadow variable or commit logic:
+//   LHS <= RHS;
+// is converted to:
+//  - In the original logic, replace the AstAssignDelay with:
+//      LHS = RHS;
 //
 // TODO: generic LHS scheme as discussed in #5092
 //
@@ -129,12 +142,21 @@ VL_DEFINE_DEBUG_FUNCTIONS;
 // Convert AstAssignDlys (NBAs)
 
 class DelayedVisitor final : public VNVisitor {
+    // CONSTANTS
+    // Maximum inline capacity of partial update commit queues
+    static constexpr uint32_t VALUE_QUEUE_INLINE_MAX = 16;
+    // Assumed number of elements updated by each NBA using a partial update commit queue
+    static constexpr uint32_t VALUE_QUEUE_INLINE_PER_NBA = 4;
+    // Maximum element size of partial update commit queues with an inline buffer
+    static constexpr int VALUE_QUEUE_INLINE_MAX_BYTES = 64;
+
     // TYPES
 
     // The various NBA conversion schemes, including error cases
     enum class Scheme : uint8_t {
         Undecided = 0,
         UnsupportedCompoundArrayInLoop,
+        Direct,
         ShadowVar,
         ShadowVarMasked,
         FlagShared,
@@ -153,6 +175,8 @@ class DelayedVisitor final : public VNVisitor {
         bool m_partial = false;  // Used on LHS of NBA under a Sel
         bool m_inLoop = false;  // Used on LHS of NBA in a loop
         bool m_inSuspOrFork = false;  // Used on LHS of NBA in suspendable process or fork
+        bool m_inUnclocked = false;  // Used on LHS of NBA in logic without a clock
+        uint32_t m_nNbas = 0;  // Number of NBAs targeting this variable
         Scheme m_scheme = Scheme::Undecided;  // Conversion scheme to use for this variable
         uint32_t m_nTmp = 0;  // Temporary number for unique names
 
@@ -249,9 +273,12 @@ class DelayedVisitor final : public VNVisitor {
     //  AstVarScope::user1p()   -> VarScopeInfo via m_vscpInfo
     //  AstVarScope::user2p()   -> AstVarRef*: First write reference to the Variable
     //  AstVarScope::user3p()   -> std::vector<WriteReference> via m_writeRefs;
+    //  AstVarScope::user4()    -> bool.  Set true if read, or written other than by an NBA,
+    //                             while evaluating the model
     const VNUser1InUse m_user1InUse{};
     const VNUser2InUse m_user2InUse{};
     const VNUser3InUse m_user3InUse{};
+    const VNUser4InUse m_user4InUse{};
     AstUser1Allocator<AstNodeModule, std::unordered_map<std::string, AstVar*>> m_varMap;
     AstUser1Allocator<AstVarScope, VarScopeInfo> m_vscpInfo;
     AstUser3Allocator<AstVarScope, std::vector<WriteReference>> m_writeRefs;
@@ -276,6 +303,7 @@ class DelayedVisitor final : public VNVisitor {
     AstVarScope* m_prevVscp = nullptr;  // The target of the previous AstAssignDly
 
     // STATE - Statistic tracking
+    VDouble0 m_nSchemeDirect;  // Number of variables using Scheme::Direct
     VDouble0 m_nSchemeShadowVar;  // Number of variables using Scheme::ShadowVar
     VDouble0 m_nSchemeShadowVarMasked;  // Number of variabels using Scheme::ShadowVarMasked
     VDouble0 m_nSchemeFlagShared;  // Number of variables using Scheme::FlagShared
@@ -400,10 +428,26 @@ class DelayedVisitor final : public VNVisitor {
         return true;
     }
 
+    // True if the NBAs to the given variable can update it immediately
+    bool isDirectUpdateOk(const AstVarScope* vscp, const VarScopeInfo& vscpInfo) {
+        // Might be read before the commit, or updated by something else in between
+        if (vscp->user4()) return false;
+        // Might be read by something other than the model logic
+        const AstVar* const varp = vscp->varp();
+        if (varp->isSigUserRWPublic() || varp->isForceable() || varp->isWrittenByDpi()) {
+            return false;
+        }
+        if (varp->isSigPublic()) return false;
+        // The rest of the process might run after other processes
+        return !vscpInfo.m_inSuspOrFork && !vscpInfo.m_inUnclocked;
+    }
+
     // Choose the NBA scheme used for the given variable.
     Scheme chooseScheme(const AstVarScope* vscp, const VarScopeInfo& vscpInfo) {
         UASSERT_OBJ(vscpInfo.m_scheme == Scheme::Undecided, vscp, "NBA scheme already decided");
 
+        if (isDirectUpdateOk(vscp, vscpInfo)) return Scheme::Direct;
+
         const AstNodeDType* const dtypep = vscp->dtypep()->skipRefp();
         // Unpacked arrays
         if (const AstUnpackArrayDType* const uaDTypep = VN_CAST(dtypep, UnpackArrayDType)) {
@@ -553,6 +597,16 @@ class DelayedVisitor final : public VNVisitor {
         return new AstVarRef{flp, tp, VAccess::READ};
     }
 
+    // Scheme::Direct
+    void convertSchemeDirect(AstAssignDly* nodep, AstVarScope* vscp, VarScopeInfo& vscpInfo) {
+        UASSERT_OBJ(vscpInfo.m_scheme == Scheme::Direct, vscp, "Inconsistent NBA scheme");
+        UASSERT_OBJ(!nodep->timingControlp(), nodep, "Timing control on NBA in clocked logic");
+        AstAssign* const assignp = new AstAssign{nodep->fileline(), nodep->lhsp()->unlinkFrBack(),
+                                                 nodep->rhsp()->unlinkFrBack()};
+        nodep->replaceWith(assignp);
+        VL_DO_DANGLING(pushDeletep(nodep), nodep);
+    }
+
     // Scheme::ShadowVar
     void prepareSchemeShadowVar(AstVarScope* vscp, VarScopeInfo& vscpInfo) {
         UASSERT_OBJ(vscpInfo.m_scheme == Scheme::ShadowVar, vscp, "Inconsistent NBA scheme");
@@ -798,6 +852,25 @@ class DelayedVisitor final : public VNVisitor {
     }
 
     // Scheme::ValueQueuePartial/Scheme::ValueQueueWhole
+
+    // Number of partial updates the commit queue of 'vscp' should hold without allocating. As
+    // updates of the same element are merged, if the array has no more elements than this,
+    // the queue never allocates. Otherwise assume each NBA in the loops updates a few elements.
+    static uint32_t valueQueueInlineCapacity(const AstVarScope* vscp,
+                                             const VarScopeInfo& vscpInfo) {
+        uint64_t elements = 1;
+        const AstNodeDType* dtypep = vscp->dtypep()->skipRefp();
+        while (const AstUnpackArrayDType* const adtypep = VN_CAST(dtypep, UnpackArrayDType)) {
+            elements *= adtypep->elementsConst();
+            dtypep = adtypep->subDTypep()->skipRefp();
+        }
+        // Entries are copied on enqueue and commit, do not buffer big ones
+        if (dtypep->widthTotalBytes() > VALUE_QUEUE_INLINE_MAX_BYTES) return 0;
+        if (elements <= VALUE_QUEUE_INLINE_MAX) return static_cast<uint32_t>(elements);
+        return std::min<uint32_t>(VALUE_QUEUE_INLINE_MAX,
+                                  vscpInfo.m_nNbas * VALUE_QUEUE_INLINE_PER_NBA);
+    }
+
     template <bool N_Partial>
     void prepareSchemeValueQueue(AstVarScope* vscp, VarScopeInfo& vscpInfo) {
         UASSERT_OBJ(N_Partial ? vscpInfo.m_scheme == Scheme::ValueQueuePartial
@@ -807,8 +880,9 @@ class DelayedVisitor final : public VNVisitor {
         AstScope* const scopep = vscp->scopep();
 
         // Create the commit queue variable
-        auto* const cqDTypep
-            = new AstNBACommitQueueDType{flp, vscp->dtypep()->skipRefp(), N_Partial};
+        const uint32_t inlineCapacity = N_Partial ? valueQueueInlineCapacity(vscp, vscpInfo) : 0;
+        auto* const cqDTypep = new AstNBACommitQueueDType{flp, vscp->dtypep()->skipRefp(),
+                                                          N_Partial, inlineCapacity};
         v3Global.rootp()->typeTablep()->addTypesp(cqDTypep);
         const std::string name = "__VdlyCommitQueue" + vscp->varp()->shortName();
         AstVarScope* const queueVscp = createTemp(flp, scopep, name, cqDTypep);
@@ -976,6 +1050,10 @@ class DelayedVisitor final : public VNVisitor {
                 // Will report error at the site of the NBA
                 break;
             }
+            case Scheme::Direct: {
+                ++m_nSchemeDirect;
+                break;
+            }
             case Scheme::ShadowVar: {
                 ++m_nSchemeShadowVar;
                 prepareSchemeShadowVar(vscp, vscpInfo);
@@ -1025,6 +1103,10 @@ class DelayedVisitor final : public VNVisitor {
                                           "compound element type inside loop");
                 break;
             }
+            case Scheme::Direct: {
+                convertSchemeDirect(nbap, vscp, vscpInfo);
+                break;
+            }
             case Scheme::ShadowVar: {
                 convertSchemeShadowVar(nbap, vscp, vscpInfo);
                 break;
@@ -1211,6 +1293,8 @@ class DelayedVisitor final : public VNVisitor {
         vscpInfo.m_partial |= VN_IS(nodep->lhsp(), Sel);
         vscpInfo.m_inLoop |= m_inLoop;
         vscpInfo.m_inSuspOrFork |= m_inSuspendableOrFork;
+        vscpInfo.m_inUnclocked |= !m_activep->sensesp()->hasClocked();
+        ++vscpInfo.m_nNbas;
         // Sensitivity might be non-clocked, in a suspendable process, which are handled elsewhere
         if (m_activep->sensesp()->hasClocked()) {
             if (vscpInfo.m_fistActivep != m_activep) {
@@ -1246,6 +1330,12 @@ class DelayedVisitor final : public VNVisitor {
     void visit(AstVarRef* nodep) override {
         // Already checked the NBA LHS ref, ignore here
         if (nodep == m_currNbaLhsRefp) return;
+        // Note references that might happen between an NBA and its commit
+        const AstSenTree* const senTreep = m_activep ? m_activep->sensesp() : nullptr;
+        if (!senTreep || m_inSuspendableOrFork
+            || !(senTreep->hasInitial() || senTreep->hasStatic() || senTreep->hasFinal())) {
+            nodep->varScopep()->user4(true);
+        }
         // Only care about write refs
         if (!nodep->access().isWriteOrRW()) return;
         // Record write reference
@@ -1272,6 +1362,7 @@ public:
     // CONSTRUCTORS
     explicit DelayedVisitor(AstNetlist* nodep) { iterate(nodep); }
     ~DelayedVisitor() override {
+        V3Stats::addStat("NBA, variables using Direct scheme", m_nSchemeDirect);
         V3Stats::addStat("NBA, variables using ShadowVar scheme", m_nSchemeShadowVar);
         V3Stats::addStat("NBA, variables using ShadowVarMasked scheme", m_nSchemeShadowVarMasked);
         V3Stats::addStat("NBA, variables using FlagShared scheme", m_nSchemeFlagShared);
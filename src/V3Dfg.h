@@ -38,6 +38,7 @@
 #include "V3Global.h"
 #include "V3Hash.h"
 #include "V3List.h"
+#include "V3PoolAllocator.h"
 
 #include "V3Dfg__gen_forward_class_decls.h"  // From ./astgen
 
@@ -147,6 +148,12 @@ protected:
 
 public:
     virtual ~DfgVertex() VL_MT_DISABLED;
+#ifdef VL_POOL_ALLOCATOR
+    static void* operator new(size_t size) { return V3PoolAllocator<DfgVertex>::allocate(size); }
+    static void operator delete(void* obj, size_t size) {
+        V3PoolAllocator<DfgVertex>::deallocate(obj, size);
+    }
+#endif
 
 private:
     V3ListLinks<DfgVertex>& links() { return m_links; }
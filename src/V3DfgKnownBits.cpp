@@ -0,0 +1,325 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//*************************************************************************
+// DESCRIPTION: Verilator: Known bits analysis on DfgGraph
+//
+// Code available from: https://verilator.org
+//
+//*************************************************************************
+//
+// Copyright 2025 by Wilson Snyder. This program is free software; you
+// can redistribute it and/or modify it under the terms of either the GNU
+// Lesser General Public License Version 3 or the Perl Artistic License
+// Version 2.0.
+// SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+//
+//*************************************************************************
+//
+// Compute for every packed vertex up to 64 bits wide which bits of its
+// value are known to be zero or one, whatever the values of the variables,
+// by propagating constant bits forward through bitwise operations,
+// concatenations, selects, extends, constant shifts, conditionals and
+// comparisons. Then:
+//
+// - Replace vertices with all bits known by constants
+// - Remove a DfgAnd when the bits it clears are already known zero
+// - Remove a DfgOr when the bits it sets are already known one
+//
+// Peephole then folds the new constants into their sinks. This finds
+// constants peephole cannot see locally, e.g.: a comparison of a
+// concatenation against a constant that differs in a constant bit, or a
+// mask applied to a value that is already zero extended.
+//
+//*************************************************************************
+
+#include "V3PchAstNoMT.h"  // VL_MT_DISABLED_CODE_UNIT
+
+#include "V3Dfg.h"
+#include "V3DfgPasses.h"
+
+#include <deque>
+#include <vector>
+
+VL_DEFINE_DEBUG_FUNCTIONS;
+
+class DfgKnownBits final : public DfgVisitor {
+    // TYPES
+    struct Bits final {
+        uint64_t m_zeros = 0;  // Bits known to be 0
+        uint64_t m_ones = 0;  // Bits known to be 1
+        uint64_t known() const { return m_zeros | m_ones; }
+    };
+
+    // STATE
+    DfgGraph& m_dfg;  // The graph being processed
+    V3DfgKnownBitsContext& m_ctx;  // The optimization context for stats
+    std::deque<Bits> m_bits;  // Storage for the Bits of each vertex, DfgVertex::user points here
+    std::vector<DfgVertex*> m_stack;  // DFS stack for 'compute'
+    Bits m_result;  // Result of the 'visit' methods
+    size_t m_changes = 0;  // Number of vertices replaced
+
+    // METHODS
+    static bool isAnalyzed(const DfgVertex* vtxp) {
+        return VN_IS(vtxp->dtypep(), BasicDType) && vtxp->width() <= 64;
+    }
+    static uint64_t mask(uint32_t width) {
+        return width >= 64 ? ~static_cast<uint64_t>(0) : (static_cast<uint64_t>(1) << width) - 1;
+    }
+    // Must be already computed, unknown for vertices wider than 64 bits
+    static const Bits& bits(const DfgVertex* vtxp) { return *vtxp->getUser<Bits*>(); }
+
+    // Compute Bits of vertex and all vertices it depends on
+    void compute(DfgVertex* rootp) {
+        m_stack.push_back(rootp);
+        while (!m_stack.empty()) {
+            DfgVertex* const vtxp = m_stack.back();
+            if (vtxp->getUser<Bits*>()) {  // Appeared on the stack more than once
+                m_stack.pop_back();
+                continue;
+            }
+            // Variables and constants are leaves, the rest of the graph is acyclic
+            bool ready = true;
+            if (!vtxp->is<DfgVertexVar>() && !vtxp->is<DfgConst>()) {
+                vtxp->forEachSource([&](DfgVertex& src) {
+                    if (src.getUser<Bits*>()) return;
+                    ready = false;
+                    m_stack.push_back(&src);
+                });
+            }
+            if (!ready) continue;
+            m_stack.pop_back();
+            m_result = Bits{};
+            if (isAnalyzed(vtxp)) {
+                iterate(vtxp);
+                // Keep only bits within the width
+                const uint64_t valid = mask(vtxp->width());
+                m_result.m_zeros &= valid;
+                m_result.m_ones &= valid;
+            }
+            m_bits.push_back(m_result);
+            vtxp->setUser<Bits*>(&m_bits.back());
+        }
+    }
+
+    void replace(DfgVertex* vtxp, DfgVertex* replacementp) {
+        vtxp->replaceWith(replacementp);
+        ++m_changes;
+    }
+
+    // Simplify vertex based on the known bits, the vertex becomes unused if changed
+    void simplify(DfgVertex* vtxp) {
+        const Bits& vBits = bits(vtxp);
+        const uint32_t width = vtxp->width();
+
+        // All bits known, replace with constant
+        if (vBits.known() == mask(width)) {
+            DfgConst* const constp = new DfgConst{m_dfg, vtxp->fileline(), width};
+            constp->num().setQuad(vBits.m_ones);
+            ++m_ctx.m_constants;
+            replace(vtxp, constp);
+            return;
+        }
+
+        // 'a & b' is 'a', if 'a' is known zero wherever 'b' might be zero
+        if (DfgAnd* const andp = vtxp->cast<DfgAnd>()) {
+            const Bits& lBits = bits(andp->lhsp());
+            const Bits& rBits = bits(andp->rhsp());
+            const uint64_t valid = mask(width);
+            if ((valid & ~rBits.m_ones & ~lBits.m_zeros) == 0) {
+                ++m_ctx.m_redundantAnds;
+                replace(vtxp, andp->lhsp());
+            } else if ((valid & ~lBits.m_ones & ~rBits.m_zeros) == 0) {
+                ++m_ctx.m_redundantAnds;
+                replace(vtxp, andp->rhsp());
+            }
+            return;
+        }
+
+        // 'a | b' is 'a', if 'a' is known one wherever 'b' might be one
+        if (DfgOr* const orp = vtxp->cast<DfgOr>()) {
+            const Bits& lBits = bits(orp->lhsp());
+            const Bits& rBits = bits(orp->rhsp());
+            const uint64_t valid = mask(width);
+            if ((valid & ~rBits.m_zeros & ~lBits.m_ones) == 0) {
+                ++m_ctx.m_redundantOrs;
+                replace(vtxp, orp->lhsp());
+            } else if ((valid & ~lBits.m_zeros & ~rBits.m_ones) == 0) {
+                ++m_ctx.m_redundantOrs;
+                replace(vtxp, orp->rhsp());
+            }
+            return;
+        }
+    }
+
+    // VISITORS - Set m_result to the known bits of the vertex, sources are already computed
+    void visit(DfgVertex*) override {}  // Unknown
+
+    void visit(DfgConst* vtxp) override {
+        const V3Number& num = vtxp->num();
+        if (num.isFourState()) return;
+        m_result.m_ones = num.toUQuad();
+        m_result.m_zeros = ~m_result.m_ones;
+    }
+
+    void visit(DfgNot* vtxp) override {
+        const Bits& sBits = bits(vtxp->srcp());
+        m_result.m_zeros = sBits.m_ones;
+        m_result.m_ones = sBits.m_zeros;
+    }
+
+    void visit(DfgAnd* vtxp) override {
+        const Bits& lBits = bits(vtxp->lhsp());
+        const Bits& rBits = bits(vtxp->rhsp());
+        m_result.m_zeros = lBits.m_zeros | rBits.m_zeros;
+        m_result.m_ones = lBits.m_ones & rBits.m_ones;
+    }
+
+    void visit(DfgOr* vtxp) override {
+        const Bits& lBits = bits(vtxp->lhsp());
+        const Bits& rBits = bits(vtxp->rhsp());
+        m_result.m_zeros = lBits.m_zeros & rBits.m_zeros;
+        m_result.m_ones = lBits.m_ones | rBits.m_ones;
+    }
+
+    void visit(DfgXor* vtxp) override {
+        const Bits& lBits = bits(vtxp->lhsp());
+        const Bits& rBits = bits(vtxp->rhsp());
+        const uint64_t known = lBits.known() & rBits.known();
+        const uint64_t value = lBits.m_ones ^ rBits.m_ones;
+        m_result.m_zeros = known & ~value;
+        m_result.m_ones = known & value;
+    }
+
+    void visit(DfgConcat* vtxp) override {
+        const Bits& lBits = bits(vtxp->lhsp());
+        const Bits& rBits = bits(vtxp->rhsp());
+        const uint32_t rWidth = vtxp->rhsp()->width();
+        m_result.m_zeros = (lBits.m_zeros << rWidth) | rBits.m_zeros;
+        m_result.m_ones = (lBits.m_ones << rWidth) | rBits.m_ones;
+    }
+
+    void visit(DfgSel* vtxp) override {
+        if (!isAnalyzed(vtxp->fromp())) return;
+        const Bits& fBits = bits(vtxp->fromp());
+        m_result.m_zeros = fBits.m_zeros >> vtxp->lsb();
+        m_result.m_ones = fBits.m_ones >> vtxp->lsb();
+    }
+
+    void visit(DfgExtend* vtxp) override {
+        const Bits& sBits = bits(vtxp->srcp());
+        m_result.m_zeros = sBits.m_zeros | ~mask(vtxp->srcp()->width());
+        m_result.m_ones = sBits.m_ones;
+    }
+
+    void visit(DfgExtendS* vtxp) override {
+        const Bits& sBits = bits(vtxp->srcp());
+        const uint32_t sWidth = vtxp->srcp()->width();
+        const uint64_t signBit = static_cast<uint64_t>(1) << (sWidth - 1);
+        const uint64_t extension = ~mask(sWidth);
+        m_result.m_zeros = sBits.m_zeros | ((sBits.m_zeros & signBit) ? extension : 0);
+        m_result.m_ones = sBits.m_ones | ((sBits.m_ones & signBit) ? extension : 0);
+    }
+
+    // Shift by a constant amount, 'left' selects the direction
+    void shift(DfgVertexBinary* vtxp, bool left) {
+        const DfgConst* const amountp = vtxp->rhsp()->cast<DfgConst>();
+        if (!amountp || !isAnalyzed(amountp) || amountp->num().isFourState()) return;
+        if (vtxp->lhsp()->width() != vtxp->width()) return;
+        const uint64_t amount = amountp->num().toUQuad();
+        const uint32_t width = vtxp->width();
+        if (amount >= width) {
+            m_result.m_zeros = mask(width);
+            return;
+        }
+        const Bits& lBits = bits(vtxp->lhsp());
+        if (left) {
+            m_result.m_zeros = (lBits.m_zeros << amount) | mask(amount);
+            m_result.m_ones = lBits.m_ones << amount;
+        } else {
+            m_result.m_zeros = (lBits.m_zeros >> amount) | (mask(width) & ~mask(width - amount));
+            m_result.m_ones = lBits.m_ones >> amount;
+        }
+    }
+    void visit(DfgShiftL* vtxp) override { shift(vtxp, true); }
+    void visit(DfgShiftR* vtxp) override { shift(vtxp, false); }
+
+    void visit(DfgCond* vtxp) override {
+        const Bits& cBits = bits(vtxp->condp());
+        const Bits& tBits = bits(vtxp->thenp());
+        const Bits& eBits = bits(vtxp->elsep());
+        if (vtxp->condp()->width() == 1 && cBits.known()) {
+            m_result = cBits.m_ones ? tBits : eBits;
+            return;
+        }
+        m_result.m_zeros = tBits.m_zeros & eBits.m_zeros;
+        m_result.m_ones = tBits.m_ones & eBits.m_ones;
+    }
+
+    // Set m_result to whether the operands are equal, if known
+    void equality(DfgVertexBinary* vtxp, bool eq) {
+        const DfgVertex* const lhsp = vtxp->lhsp();
+        const DfgVertex* const rhsp = vtxp->rhsp();
+        if (!isAnalyzed(lhsp) || !isAnalyzed(rhsp) || lhsp->width() != rhsp->width()) return;
+        const Bits& lBits = bits(lhsp);
+        const Bits& rBits = bits(rhsp);
+        const uint64_t valid = mask(lhsp->width());
+        bool equal;
+        if ((lBits.m_ones & rBits.m_zeros) | (lBits.m_zeros & rBits.m_ones)) {
+            equal = false;  // Differ in a known bit
+        } else if (lBits.known() == valid && rBits.known() == valid) {
+            equal = true;  // All bits known, and the same
+        } else {
+            return;
+        }
+        if (equal == eq) {
+            m_result.m_ones = 1;
+        } else {
+            m_result.m_zeros = 1;
+        }
+    }
+    void visit(DfgEq* vtxp) override { equality(vtxp, true); }
+    void visit(DfgNeq* vtxp) override { equality(vtxp, false); }
+
+    void visit(DfgRedAnd* vtxp) override {
+        const Bits& sBits = bits(vtxp->srcp());
+        if (sBits.m_zeros) {
+            m_result.m_zeros = 1;
+        } else if (sBits.m_ones == mask(vtxp->srcp()->width())) {
+            m_result.m_ones = 1;
+        }
+    }
+
+    void visit(DfgRedOr* vtxp) override {
+        const Bits& sBits = bits(vtxp->srcp());
+        if (sBits.m_ones) {
+            m_result.m_ones = 1;
+        } else if (sBits.m_zeros == mask(vtxp->srcp()->width())) {
+            m_result.m_zeros = 1;
+        }
+    }
+
+    // CONSTRUCTOR
+    DfgKnownBits(DfgGraph& dfg, V3DfgKnownBitsContext& ctx)
+        : m_dfg{dfg}
+        , m_ctx{ctx} {
+        {
+            // DfgVertex::user is the Bits* of the vertex, nullptr until computed
+            const auto userDataInUse = m_dfg.userDataInUse();
+            m_dfg.forEachVertex([](DfgVertex& vtx) { vtx.setUser<Bits*>(nullptr); });
+            for (DfgVertex& vtx : m_dfg.opVertices()) compute(&vtx);
+            // Constants created below are not in 'm_dfg.opVertices()', so this is safe
+            for (DfgVertex& vtx : m_dfg.opVertices()) {
+                if (!vtx.hasSinks() || !isAnalyzed(&vtx)) continue;
+                simplify(&vtx);
+            }
+        }
+        // Remove the replaced vertices
+        if (m_changes) V3DfgPasses::removeUnused(m_dfg);
+    }
+
+public:
+    static void apply(DfgGraph& dfg, V3DfgKnownBitsContext& ctx) { DfgKnownBits{dfg, ctx}; }
+};
+
+void V3DfgPasses::knownBits(DfgGraph& dfg, V3DfgKnownBitsContext& ctx) {
+    DfgKnownBits::apply(dfg, ctx);
+}
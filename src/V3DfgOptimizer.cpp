@@ -33,17 +33,34 @@
 VL_DEFINE_DEBUG_FUNCTIONS;
 
 // Extract more combinational logic equations from procedures for better optimization opportunities
+// The next state logic of edge triggered procedures is extracted too, so DFG can optimize it
+// together with the combinational logic, e.g.: share sub-expressions between the next state of
+// different registers. An 'if' tree assigning only one register is first turned into a single
+// non-blocking assignment of a conditional expression, so it is extracted as a whole.
 class DataflowExtractVisitor final : public VNVisitor {
     // NODE STATE
+    // AstVar::user1            -> int: Number of references writing the variable
+    // AstVar::user2            -> int: Number of references writing the variable via an NBA
     // AstVar::user3            -> bool: Flag indicating variable is subject of force or release
     // statement AstVar::user4  -> bool: Flag indicating variable is combinationally driven
     // AstNodeModule::user4     -> Extraction candidates (via m_extractionCandidates)
+    const VNUser1InUse m_user1InUse;
+    const VNUser2InUse m_user2InUse;
     const VNUser3InUse m_user3InUse;
     const VNUser4InUse m_user4InUse;
 
-    // Expressions considered for extraction as separate assignment to gain more opportunities for
-    // optimization, together with the list of variables they read.
-    using Candidates = std::vector<std::pair<AstNodeExpr*, std::vector<const AstVar*>>>;
+    // Expression considered for extraction as separate assignment to gain more opportunities for
+    // optimization, together with the list of variables it reads.
+    struct Candidate final {
+        AstNodeExpr* m_exprp;  // The expression
+        std::vector<const AstVar*> m_readVars;  // Variables read by the expression
+        bool m_sequential;  // Expression is in an edge triggered procedure
+        Candidate(AstNodeExpr* exprp, std::vector<const AstVar*>&& readVars, bool sequential)
+            : m_exprp{exprp}
+            , m_readVars{std::move(readVars)}
+            , m_sequential{sequential} {}
+    };
+    using Candidates = std::vector<Candidate>;
 
     // Expressions considered for extraction. All the candidates are pure expressions.
     AstUser4Allocator<AstNodeModule, Candidates> m_extractionCandidates;
@@ -51,6 +68,7 @@ class DataflowExtractVisitor final : public VNVisitor {
     // STATE
     AstNodeModule* m_modp = nullptr;  // The module being visited
     Candidates* m_candidatesp = nullptr;
+    bool m_sequential = false;  // Visiting an edge triggered procedure
     bool m_impure = false;  // True if the visited tree has a side effect
     bool m_inForceReleaseLhs = false;  // Iterating LHS of force/release
     // List of AstVar nodes read by the visited tree. 'vector' rather than 'set' as duplicates are
@@ -59,6 +77,107 @@ class DataflowExtractVisitor final : public VNVisitor {
 
     // METHODS
 
+    static bool isEdgeTriggered(const AstAlways* nodep) {
+        if (!nodep->sensesp() || !nodep->sensesp()->sensesp()) return false;
+        if (nodep->keyword() != VAlwaysKwd::ALWAYS && nodep->keyword() != VAlwaysKwd::ALWAYS_FF) {
+            return false;
+        }
+        for (AstSenItem* senp = nodep->sensesp()->sensesp(); senp;
+             senp = VN_AS(senp->nextp(), SenItem)) {
+            if (!senp->edgeType().anEdge()) return false;
+        }
+        return true;
+    }
+
+    // Count the writes of each variable in the netlist, and how many of them are via NBAs
+    static void countWrites(AstNetlist* netlistp) {
+        netlistp->foreach([](AstNodeVarRef* refp) {
+            if (refp->varp() && refp->access().isWriteOrRW()) refp->varp()->user1Inc();
+        });
+        netlistp->foreach([](AstAssignDly* assignp) {
+            assignp->lhsp()->foreach([](AstNodeVarRef* refp) {
+                if (refp->varp() && refp->access().isWriteOrRW()) refp->varp()->user2Inc();
+            });
+        });
+    }
+
+    // Returns the first NBA in the 'if' tree 'stmtp'
+    static AstAssignDly* firstAssignment(AstNode* stmtp) {
+        if (!stmtp) return nullptr;
+        if (AstAssignDly* const assignp = VN_CAST(stmtp, AssignDly)) return assignp;
+        if (AstIf* const ifp = VN_CAST(stmtp, If)) {
+            if (AstAssignDly* const assignp = firstAssignment(ifp->thensp())) return assignp;
+            return firstAssignment(ifp->elsesp());
+        }
+        return nullptr;
+    }
+
+    // If 'stmtp' is an NBA to 'lhsp', or an 'if' with branches that are empty or hold a
+    // single such statement, return the number of NBAs, otherwise return -1.
+    static int nextStateAssignments(AstNode* stmtp, const AstVarRef* lhsp) {
+        if (AstAssignDly* const assignp = VN_CAST(stmtp, AssignDly)) {
+            if (assignp->timingControlp() || !assignp->rhsp()->isPure()) return -1;
+            if (!assignp->lhsp()->sameTree(lhsp)) return -1;
+            return 1;
+        }
+        AstIf* const ifp = VN_CAST(stmtp, If);
+        if (!ifp) return -1;
+        // Keep 'if' statements that become assertions
+        if (ifp->isBoundsCheck() || ifp->uniquePragma() || ifp->unique0Pragma()
+            || ifp->priorityPragma()) {
+            return -1;
+        }
+        if (!ifp->condp()->isPure()) return -1;
+        int count = 0;
+        for (AstNode* const branchp : {ifp->thensp(), ifp->elsesp()}) {
+            if (!branchp) continue;  // Empty branch holds the current value
+            if (branchp->nextp()) return -1;
+            const int branchCount = nextStateAssignments(branchp, lhsp);
+            if (branchCount < 0) return -1;
+            count += branchCount;
+        }
+        return count;
+    }
+
+    // Next state expression of 'stmtp', which passed 'nextStateAssignments'
+    static AstNodeExpr* nextStateExpr(AstNode* stmtp, const AstVarRef* lhsp) {
+        if (!stmtp) return new AstVarRef{lhsp->fileline(), lhsp->varp(), VAccess::READ};
+        if (AstAssignDly* const assignp = VN_CAST(stmtp, AssignDly)) {
+            return assignp->rhsp()->cloneTree(false);
+        }
+        AstIf* const ifp = VN_AS(stmtp, If);
+        return new AstCond{ifp->fileline(), ifp->condp()->cloneTree(false),
+                           nextStateExpr(ifp->thensp(), lhsp), nextStateExpr(ifp->elsesp(), lhsp)};
+    }
+
+    // Replace 'if' trees in the edge triggered procedure that assign only one register with a
+    // single NBA of a conditional expression. Only done if the 'if' tree holds all writes of
+    // the register, as otherwise holding the value could override another NBA.
+    static void mergeNextState(AstAlways* nodep) {
+        for (AstNode *stmtp = nodep->stmtsp(), *nextp; stmtp; stmtp = nextp) {
+            nextp = stmtp->nextp();
+            AstIf* const ifp = VN_CAST(stmtp, If);
+            if (!ifp) continue;
+            const AstAssignDly* const firstp = firstAssignment(ifp);
+            if (!firstp) continue;
+            AstVarRef* const lhsp = VN_CAST(firstp->lhsp(), VarRef);
+            if (!lhsp) continue;
+            AstVar* const varp = lhsp->varp();
+            if (!DfgVertex::isSupportedDType(varp->dtypep())) continue;
+            if (VN_IS(varp->dtypeSkipRefp(), UnpackArrayDType)) continue;
+            const int count = nextStateAssignments(ifp, lhsp);
+            if (count <= 0 || count != varp->user1()) continue;
+            // Replace with single NBA
+            FileLine* const flp = firstp->fileline();
+            AstAssignDly* const newp
+                = new AstAssignDly{flp, lhsp->cloneTree(false), nextStateExpr(ifp, lhsp)};
+            ifp->replaceWith(newp);
+            VL_DO_DANGLING(ifp->deleteTree(), ifp);
+            varp->user1(1);
+            varp->user2(1);
+        }
+    }
+
     // Node considered for extraction as a combinational equation. Trace variable usage/purity.
     void iterateExtractionCandidate(AstNode* nodep) {
         UASSERT_OBJ(!VN_IS(nodep->backp(), NodeExpr), nodep,
@@ -89,12 +208,24 @@ class DataflowExtractVisitor final : public VNVisitor {
         if (m_readVars.empty()) return;
 
         // Add to candidate list
-        m_candidatesp->emplace_back(VN_AS(nodep, NodeExpr), std::move(m_readVars));
+        m_candidatesp->emplace_back(VN_AS(nodep, NodeExpr), std::move(m_readVars), m_sequential);
     }
 
     // VISIT methods
 
     void visit(AstNetlist* nodep) override {
+        // Combine next state logic of registers in edge triggered procedures
+        countWrites(nodep);
+        for (AstNodeModule* modp = nodep->modulesp(); modp;
+             modp = VN_AS(modp->nextp(), NodeModule)) {
+            if (!VN_IS(modp, Module)) continue;
+            std::vector<AstAlways*> alwaysps;
+            modp->foreach([&](AstAlways* alwaysp) {
+                if (isEdgeTriggered(alwaysp)) alwaysps.push_back(alwaysp);
+            });
+            for (AstAlways* const alwaysp : alwaysps) mergeNextState(alwaysp);
+        }
+
         // Analyze the whole design
         iterateChildrenConst(nodep);
 
@@ -105,11 +236,11 @@ class DataflowExtractVisitor final : public VNVisitor {
             // Only extract from proper modules
             if (!VN_IS(modp, Module)) continue;
 
-            for (const auto& pair : m_extractionCandidates(modp)) {
-                AstNodeExpr* const cnodep = pair.first;
+            for (const Candidate& candidate : m_extractionCandidates(modp)) {
+                AstNodeExpr* const cnodep = candidate.m_exprp;
 
                 // Do not extract expressions without any variable references
-                if (pair.second.empty()) continue;
+                if (candidate.m_readVars.empty()) continue;
 
                 // Check if all variables read by this expression are driven combinationally,
                 // and move on if not. Also don't extract it if one of the variables is subject
@@ -117,12 +248,24 @@ class DataflowExtractVisitor final : public VNVisitor {
                 // extra combinational logic can change semantics (see t_force_release_net*).
                 {
                     bool hasBadVar = false;
-                    for (const AstVar* const readVarp : pair.second) {
-                        // variable is target of force/release or not combinationally driven
-                        if (readVarp->user3() || !readVarp->user4()) {
+                    for (const AstVar* const readVarp : candidate.m_readVars) {
+                        // Variable is target of force/release
+                        if (readVarp->user3()) {
                             hasBadVar = true;
                             break;
                         }
+                        // Variable is combinationally driven
+                        if (readVarp->user4()) continue;
+                        // The next state logic can also read registers, as the combinational
+                        // logic is evaluated again after they are updated by the NBAs. Only if
+                        // all writes are NBAs though, and the variable is not written from C++.
+                        if (candidate.m_sequential && readVarp->user1() > 0
+                            && readVarp->user1() == readVarp->user2()
+                            && !readVarp->isSigUserRWPublic()) {
+                            continue;
+                        }
+                        hasBadVar = true;
+                        break;
                     }
                     if (hasBadVar) continue;
                 }
@@ -152,13 +295,18 @@ class DataflowExtractVisitor final : public VNVisitor {
 
     void visit(AstAlways* nodep) override {
         VL_RESTORER(m_candidatesp);
-        // Only extract from combinational logic under proper modules
+        VL_RESTORER(m_sequential);
+        // Only extract from combinational or edge triggered logic under proper modules
         const bool isComb = !nodep->sensesp()
                             && (nodep->keyword() == VAlwaysKwd::ALWAYS
                                 || nodep->keyword() == VAlwaysKwd::ALWAYS_COMB
                                 || nodep->keyword() == VAlwaysKwd::ALWAYS_LATCH);
-        m_candidatesp
-            = isComb && VN_IS(m_modp, Module) ? &m_extractionCandidates(m_modp) : nullptr;
+        // Sampling the next state in combinational logic is only valid without timing controls
+        m_sequential = isEdgeTriggered(nodep)
+                       && !nodep->exists([](const AstNode* np) { return np->isTimingControl(); });
+        m_candidatesp = (isComb || m_sequential) && VN_IS(m_modp, Module)
+                            ? &m_extractionCandidates(m_modp)
+                            : nullptr;
         iterateChildrenConst(nodep);
     }
 
@@ -268,7 +416,13 @@ static void process(DfgGraph& dfg, V3DfgOptimizationContext& ctx) {
         }
     }
 
-    // For each acyclic component
+    // For each acyclic component. Note these are optimized serially. The passes are not
+    // independent of each other across components: they look up and add data types in the
+    // global type table, add temporary variables and logic to the module, and create AstNodes,
+    // none of which is thread safe. Doing CSE by component does not miss anything: every
+    // variable is a single vertex, so all cones reading the same inputs are in the same
+    // component. Post V3Scope the graph covers the whole netlist, so this includes flattened
+    // instances. Cones in different instances read different variables and are not common.
     for (auto& component : acyclicComponents) {
         if (dumpDfgLevel() >= 7) component->dumpDotFilePrefixed(ctx.prefix() + "source");
         // Optimize the component
@@ -351,5 +505,10 @@ void V3DfgOptimizer::optimize(AstNetlist* netlistp, const string& label) {
         V3DfgPasses::dfgToAst(*dfg, ctx);
     }
 
+#ifdef VL_POOL_ALLOCATOR
+    // All graphs are destroyed by now, so return their vertex memory in bulk
+    V3PoolAllocator<DfgVertex>::releaseAll();
+#endif
+
     V3Global::dumpCheckGlobalTree("dfg-optimize", 0, dumpTreeEitherLevel() >= 3);
 }
@@ -45,6 +45,14 @@ V3DfgCseContext::~V3DfgCseContext() {
                      m_eliminated);
 }
 
+V3DfgKnownBitsContext::~V3DfgKnownBitsContext() {
+    V3Stats::addStat("Optimizations, DFG " + m_label + " KnownBits, constants", m_constants);
+    V3Stats::addStat("Optimizations, DFG " + m_label + " KnownBits, redundant ands",
+                     m_redundantAnds);
+    V3Stats::addStat("Optimizations, DFG " + m_label + " KnownBits, redundant ors",
+                     m_redundantOrs);
+}
+
 V3DfgRegularizeContext::~V3DfgRegularizeContext() {
     V3Stats::addStat("Optimizations, DFG " + m_label + " Regularize, temporaries introduced",
                      m_temporariesIntroduced);
@@ -617,6 +625,7 @@ void V3DfgPasses::optimize(DfgGraph& dfg, V3DfgOptimizationContext& ctx) {
         apply(4, "binToOneHot     ", [&]() { binToOneHot(dfg, ctx.m_binToOneHotContext); });
     }
     if (v3Global.opt.fDfgPeephole()) {
+        apply(4, "knownBits       ", [&]() { knownBits(dfg, ctx.m_knownBitsContext); });
         apply(4, "peephole        ", [&]() { peephole(dfg, ctx.m_peepholeContext); });
         // We just did CSE above, so without peephole there is no need to run it again these
         apply(4, "cse1            ", [&]() { cse(dfg, ctx.m_cseContext1); });
@@ -64,6 +64,18 @@ public:
     ~V3DfgCseContext() VL_MT_DISABLED;
 };
 
+class V3DfgKnownBitsContext final {
+    const std::string m_label;  // Label to apply to stats
+
+public:
+    VDouble0 m_constants;  // Number of vertices with all bits known replaced by constants
+    VDouble0 m_redundantAnds;  // Number of redundant DfgAnd vertices removed
+    VDouble0 m_redundantOrs;  // Number of redundant DfgOr vertices removed
+    explicit V3DfgKnownBitsContext(const std::string& label)
+        : m_label{label} {}
+    ~V3DfgKnownBitsContext() VL_MT_DISABLED;
+};
+
 class V3DfgRegularizeContext final {
     const std::string m_label;  // Label to apply to stats
 
@@ -110,6 +122,7 @@ public:
     V3DfgBreakCyclesContext m_breakCyclesContext{m_label};
     V3DfgCseContext m_cseContext0{m_label + " 1st"};
     V3DfgCseContext m_cseContext1{m_label + " 2nd"};
+    V3DfgKnownBitsContext m_knownBitsContext{m_label};
     V3DfgPeepholeContext m_peepholeContext{m_label};
     V3DfgRegularizeContext m_regularizeContext{m_label};
     V3DfgEliminateVarsContext m_eliminateVarsContext{m_label};
@@ -161,6 +174,8 @@ void binToOneHot(DfgGraph&, V3DfgBinToOneHotContext&) VL_MT_DISABLED;
 void cse(DfgGraph&, V3DfgCseContext&) VL_MT_DISABLED;
 // Inline fully driven variables
 void inlineVars(DfgGraph&) VL_MT_DISABLED;
+// Replace vertices with known bits by constants, and remove redundant masking
+void knownBits(DfgGraph&, V3DfgKnownBitsContext&) VL_MT_DISABLED;
 // Peephole optimizations
 void peephole(DfgGraph&, V3DfgPeepholeContext&) VL_MT_DISABLED;
 // Regularize graph. This must be run before converting back to Ast.
@@ -218,6 +218,15 @@ class V3DfgPeephole final : public DfgVisitor {
     // Create a DfgConst vertex with the given width and value zero
     DfgConst* makeZero(FileLine* flp, uint32_t width) { return new DfgConst{m_dfg, flp, width}; }
 
+    // True if 'lhsp' and 'rhsp' are selects of adjoining ranges of the same vertex,
+    // with 'lhsp' being the more significant
+    static bool adjoiningSels(DfgVertex* lhsp, DfgVertex* rhsp) {
+        DfgSel* const lSelp = lhsp->cast<DfgSel>();
+        DfgSel* const rSelp = rhsp->cast<DfgSel>();
+        return lSelp && rSelp && lSelp->fromp()->equals(*rSelp->fromp())
+               && lSelp->lsb() == rSelp->lsb() + rSelp->width();
+    }
+
     // Create a new vertex of the given type
     template <typename Vertex, typename... Operands>
     Vertex* make(FileLine* flp, AstNodeDType* dtypep, Operands... operands) {
@@ -251,6 +260,17 @@ class V3DfgPeephole final : public DfgVisitor {
         return aConstp->num().isCaseEq(bConstp->num());
     }
 
+    // Check vertex is a constant with exactly one bit set
+    static bool isOneHotConst(const DfgVertex* vtxp) {
+        const DfgConst* const constp = vtxp->cast<DfgConst>();
+        return constp && !constp->num().isFourState() && constp->num().countOnes() == 1;
+    }
+
+    // Index of the set bit of a constant checked with 'isOneHotConst'
+    static uint32_t oneHotIndex(const DfgVertex* vtxp) {
+        return vtxp->as<DfgConst>()->num().mostSetBitP1() - 1;
+    }
+
     // Note: If any of the following transformers return true, then the vertex was replaced and the
     // caller must not do any further changes, so the caller must check the return value, otherwise
     // there will be hard to debug issues.
@@ -517,6 +537,45 @@ class V3DfgPeephole final : public DfgVisitor {
         return false;
     }
 
+    // If 'lhsp' and 'rhsp' are the same bitwise operation on adjoining selects, e.g.:
+    // 'a[1] & b[1]' and 'a[0] & b[0]', return the single wider operation computing their
+    // concatenation, e.g.: 'a[1:0] & b[1:0]', otherwise return nullptr. This turns logic
+    // computed bit by bit back into word wide operations.
+    template <typename Vertex>
+    Vertex* joinBitwiseOps(FileLine* flp, DfgVertex* lhsp, DfgVertex* rhsp) {
+        static_assert(std::is_base_of<DfgVertexBinary, Vertex>::value, "Must be binary");
+        Vertex* const lOpp = lhsp->template cast<Vertex>();
+        Vertex* const rOpp = rhsp->template cast<Vertex>();
+        if (!lOpp || !rOpp || lOpp->hasMultipleSinks() || rOpp->hasMultipleSinks()) {
+            return nullptr;
+        }
+        // The operations are commutative, so the operands of 'rOpp' can be swapped
+        DfgVertex* rLhsp = rOpp->lhsp();
+        DfgVertex* rRhsp = rOpp->rhsp();
+        if (!adjoiningSels(lOpp->lhsp(), rLhsp) || !adjoiningSels(lOpp->rhsp(), rRhsp)) {
+            std::swap(rLhsp, rRhsp);
+            if (!adjoiningSels(lOpp->lhsp(), rLhsp) || !adjoiningSels(lOpp->rhsp(), rRhsp)) {
+                return nullptr;
+            }
+        }
+        const uint32_t width = lOpp->width() + rOpp->width();
+        AstNodeDType* const dtypep = dtypeForWidth(width);
+        DfgSel* const lSelp = rLhsp->as<DfgSel>();
+        DfgSel* const rSelp = rRhsp->as<DfgSel>();
+        DfgSel* const newLhsp = make<DfgSel>(flp, dtypep, lSelp->fromp(), lSelp->lsb());
+        DfgSel* const newRhsp = make<DfgSel>(flp, dtypep, rSelp->fromp(), rSelp->lsb());
+        return make<Vertex>(flp, dtypep, newLhsp, newRhsp);
+    }
+
+    // Try 'joinBitwiseOps' for all bitwise binary operations
+    DfgVertex* joinAnyBitwiseOps(FileLine* flp, DfgVertex* lhsp, DfgVertex* rhsp) {
+        if (lhsp->type() != rhsp->type()) return nullptr;
+        if (lhsp->is<DfgAnd>()) return joinBitwiseOps<DfgAnd>(flp, lhsp, rhsp);
+        if (lhsp->is<DfgOr>()) return joinBitwiseOps<DfgOr>(flp, lhsp, rhsp);
+        if (lhsp->is<DfgXor>()) return joinBitwiseOps<DfgXor>(flp, lhsp, rhsp);
+        return nullptr;
+    }
+
     template <typename Vertex>
     VL_ATTR_WARN_UNUSED_RESULT bool tryPushCompareOpThroughConcat(Vertex* vtxp, DfgConst* constp,
                                                                   DfgConcat* concatp) {
@@ -930,6 +989,24 @@ class V3DfgPeephole final : public DfgVisitor {
                     DfgShiftL* const replacementp = make<DfgShiftL>(
                         shiftLp->fileline(), vtxp->dtypep(), newSelp, shiftLp->rhsp());
                     replace(vtxp, replacementp);
+                    return;
+                }
+            }
+        }
+
+        // Sel from ShiftR
+        if (DfgShiftR* const shiftRp = fromp->cast<DfgShiftR>()) {
+            // Shift and mask: '(a >> 4)[3:0]' -> 'a[7:4]', if no shifted in zeroes are selected
+            if (const DfgConst* const shiftConstp = shiftRp->rhsp()->cast<DfgConst>()) {
+                const V3Number& shiftNum = shiftConstp->num();
+                if (!shiftNum.isFourState() && shiftNum.mostSetBitP1() <= 32
+                    && static_cast<uint64_t>(msb) + shiftConstp->toU32() < fromp->width()) {
+                    APPLYING(PUSH_SEL_THROUGH_SHIFTR) {
+                        DfgSel* const replacementp
+                            = make<DfgSel>(vtxp, shiftRp->lhsp(), lsb + shiftConstp->toU32());
+                        replace(vtxp, replacementp);
+                        return;
+                    }
                 }
             }
         }
@@ -1272,6 +1349,26 @@ class V3DfgPeephole final : public DfgVisitor {
             }
         }
 
+        if (m_ctx.m_enabled[VDfgPeepholePattern::PUSH_CONCAT_THROUGH_BITWISE_OPS]) {
+            if (DfgVertex* const joinedp = joinAnyBitwiseOps(flp, lhsp, rhsp)) {
+                APPLYING(PUSH_CONCAT_THROUGH_BITWISE_OPS) {
+                    replace(vtxp, joinedp);
+                    return;
+                }
+            }
+            // Same when the concatenation is nested, as they are right leaning
+            if (DfgConcat* const rConcatp = rhsp->cast<DfgConcat>()) {
+                if (DfgVertex* const joinedp = joinAnyBitwiseOps(flp, lhsp, rConcatp->lhsp())) {
+                    APPLYING(PUSH_CONCAT_THROUGH_BITWISE_OPS) {
+                        DfgConcat* const replacementp
+                            = make<DfgConcat>(vtxp, joinedp, rConcatp->rhsp());
+                        replace(vtxp, replacementp);
+                        return;
+                    }
+                }
+            }
+        }
+
         {
             const auto joinSels = [this](DfgSel* lSelp, DfgSel* rSelp, FileLine* flp) -> DfgSel* {
                 if (lSelp->fromp()->equals(*rSelp->fromp())) {
@@ -1346,6 +1443,18 @@ class V3DfgPeephole final : public DfgVisitor {
             if (DfgConcat* const rhsConcatp = rhsp->cast<DfgConcat>()) {
                 if (tryPushCompareOpThroughConcat(vtxp, lhsConstp, rhsConcatp)) return;
             }
+
+            // One-hot decoding: '8'h10 == (8'h10 & a)' -> 'a[4]'
+            if (DfgAnd* const rhsAndp = rhsp->cast<DfgAnd>()) {
+                if (isOneHotConst(lhsConstp) && isSame(lhsConstp, rhsAndp->lhsp())) {
+                    APPLYING(REPLACE_ONE_HOT_MASK_TEST_WITH_SEL) {
+                        DfgSel* const replacementp
+                            = make<DfgSel>(vtxp, rhsAndp->rhsp(), oneHotIndex(lhsConstp));
+                        replace(vtxp, replacementp);
+                        return;
+                    }
+                }
+            }
         }
     }
 
@@ -1445,6 +1554,25 @@ class V3DfgPeephole final : public DfgVisitor {
 
     void visit(DfgNeq* vtxp) override {
         if (foldBinary(vtxp)) return;
+
+        if (commutativeBinary(vtxp)) return;
+
+        DfgVertex* const lhsp = vtxp->lhsp();
+        DfgVertex* const rhsp = vtxp->rhsp();
+
+        // One-hot decoding: '8'h0 != (8'h10 & a)' -> 'a[4]'
+        if (lhsp->isZero()) {
+            if (DfgAnd* const rhsAndp = rhsp->cast<DfgAnd>()) {
+                if (isOneHotConst(rhsAndp->lhsp())) {
+                    APPLYING(REPLACE_ONE_HOT_MASK_TEST_WITH_SEL) {
+                        DfgSel* const replacementp = make<DfgSel>(
+                            vtxp, rhsAndp->rhsp(), oneHotIndex(rhsAndp->lhsp()));
+                        replace(vtxp, replacementp);
+                        return;
+                    }
+                }
+            }
+        }
     }
 
     void visit(DfgPow* vtxp) override {
@@ -1551,6 +1679,30 @@ class V3DfgPeephole final : public DfgVisitor {
             }
         }
 
+        // Mux chains testing the same condition again
+        if (DfgCond* const thenCondp = thenp->cast<DfgCond>()) {
+            if (thenCondp->condp() == condp) {
+                // 'a ? (a ? x : y) : z' -> 'a ? x : z'
+                APPLYING(REMOVE_COND_IN_THEN_WITH_SAME_CONDITION) {
+                    DfgCond* const replacementp
+                        = make<DfgCond>(vtxp, condp, thenCondp->thenp(), elsep);
+                    replace(vtxp, replacementp);
+                    return;
+                }
+            }
+        }
+        if (DfgCond* const elseCondp = elsep->cast<DfgCond>()) {
+            if (elseCondp->condp() == condp) {
+                // 'a ? x : (a ? y : z)' -> 'a ? x : z'
+                APPLYING(REMOVE_COND_IN_ELSE_WITH_SAME_CONDITION) {
+                    DfgCond* const replacementp
+                        = make<DfgCond>(vtxp, condp, thenp, elseCondp->elsep());
+                    replace(vtxp, replacementp);
+                    return;
+                }
+            }
+        }
+
         if (DfgNot* const condNotp = condp->cast<DfgNot>()) {
             if (!condp->hasMultipleSinks() || condNotp->hasMultipleSinks()) {
                 APPLYING(SWAP_COND_WITH_NOT_CONDITION) {
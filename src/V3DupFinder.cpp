@@ -20,7 +20,9 @@
 
 #include "V3File.h"
 
+#include <algorithm>
 #include <iomanip>
+#include <map>
 #include <memory>
 
 VL_DEFINE_DEBUG_FUNCTIONS;
@@ -29,25 +31,36 @@ VL_DEFINE_DEBUG_FUNCTIONS;
 // V3DupFinder class functions
 
 V3DupFinder::size_type V3DupFinder::erase(AstNode* nodep) {
-    const auto& er = equal_range(m_hasher(nodep));
-    for (iterator it = er.first; it != er.second; ++it) {
-        if (nodep == it->second) {
-            erase(it);
+    const Map::iterator bucketIt = m_map.find(m_hasher(nodep));
+    if (bucketIt == m_map.end()) return 0;
+    const Bucket& bucket = bucketIt->second;
+    for (size_t i = 0; i < bucket.size(); ++i) {
+        if (nodep == bucket[i].second) {
+            erase(iterator{bucketIt, i});
             return 1;
         }
     }
     return 0;
 }
 
+void V3DupFinder::erase(iterator it) {
+    Bucket& bucket = it.m_bucketIt->second;
+    bucket.erase(bucket.begin() + it.m_index);
+    if (bucket.empty()) m_map.erase(it.m_bucketIt);
+    --m_size;
+}
+
 V3DupFinder::iterator V3DupFinder::findDuplicate(AstNode* nodep, V3DupFinderUserSame* checkp) {
-    const auto& er = equal_range(m_hasher(nodep));
-    for (iterator it = er.first; it != er.second; ++it) {
-        AstNode* const node2p = it->second;
+    const Map::iterator bucketIt = m_map.find(m_hasher(nodep));
+    if (bucketIt == m_map.end()) return end();
+    const Bucket& bucket = bucketIt->second;
+    for (size_t i = 0; i < bucket.size(); ++i) {
+        AstNode* const node2p = bucket[i].second;
         if (nodep == node2p) continue;  // Same node is not a duplicate
         if (checkp && !checkp->isSame(nodep, node2p)) continue;  // User says it is not a duplicate
         if (!nodep->sameTree(node2p)) continue;  // Not the same trees
         // Found duplicate
-        return it;
+        return iterator{bucketIt, i};
     }
     return end();
 }
@@ -57,19 +70,17 @@ void V3DupFinder::dumpFile(const string& filename, bool tree) {
     const std::unique_ptr<std::ofstream> logp{V3File::new_ofstream(filename)};
     if (logp->fail()) v3fatal("Can't write file: " << filename);
 
-    std::unordered_map<int, int> dist;
+    // Dump in hash order, so dumps can be compared
+    std::vector<const Map::value_type*> bucketps;
+    bucketps.reserve(m_map.size());
+    for (const auto& pair : m_map) bucketps.push_back(&pair);
+    std::sort(bucketps.begin(), bucketps.end(),
+              [](const Map::value_type* ap, const Map::value_type* bp) {
+                  return ap->first < bp->first;
+              });
 
-    V3Hash lasthash;
-    int num_in_bucket = 0;
-    for (auto it = cbegin(); true; ++it) {
-        if (it == cend() || lasthash != it->first) {
-            if (it != cend()) lasthash = it->first;
-            if (num_in_bucket) ++dist[num_in_bucket];
-            num_in_bucket = 0;
-        }
-        if (it == cend()) break;
-        num_in_bucket++;
-    }
+    std::map<int, int> dist;
+    for (const Map::value_type* const bucketp : bucketps) ++dist[bucketp->second.size()];
     *logp << "\n*** STATS:\n\n";
     *logp << "    #InBucket   Occurrences\n";
     for (const auto& i : dist) {
@@ -77,15 +88,14 @@ void V3DupFinder::dumpFile(const string& filename, bool tree) {
     }
 
     *logp << "\n*** Dump:\n\n";
-    for (const auto& it : *this) {
-        if (lasthash != it.first) {
-            lasthash = it.first;
-            *logp << "    " << it.first << '\n';
+    for (const Map::value_type* const bucketp : bucketps) {
+        *logp << "    " << bucketp->first << '\n';
+        for (const Entry& entry : bucketp->second) {
+            *logp << "\t" << entry.second << '\n';
+            // Dumping the entire tree may make nearly N^2 sized dumps,
+            // because the nodes under this one may also be in the hash table!
+            if (tree) entry.second->dumpTree(*logp, "    ");
         }
-        *logp << "\t" << it.second << '\n';
-        // Dumping the entire tree may make nearly N^2 sized dumps,
-        // because the nodes under this one may also be in the hash table!
-        if (tree) it.second->dumpTree(*logp, "    ");
     }
 }
 
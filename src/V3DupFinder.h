@@ -27,8 +27,10 @@
 #include "V3Error.h"
 #include "V3Hasher.h"
 
-#include <map>
 #include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 //============================================================================
 
@@ -39,13 +41,46 @@ struct V3DupFinderUserSame VL_NOT_FINAL {
     virtual ~V3DupFinderUserSame() = default;
 };
 
-// This really is just a multimap from 'node hash' to 'node pointer', with some minor extensions.
-class V3DupFinder final : private std::multimap<V3Hash, AstNode*> {
-    using Super = std::multimap<V3Hash, AstNode*>;
+// This is a hash map from 'node hash' to 'node pointers', with some minor extensions.
+// Nodes with the same hash are kept in insertion order, so findDuplicate deterministically
+// returns the earliest inserted duplicate.
+class V3DupFinder final {
+public:
+    // TYPES
+    struct Entry final {
+        V3Hash first;  // Hash of node
+        AstNode* second;  // The node
+    };
+
+private:
+    using Bucket = std::vector<Entry>;
+    using Map = std::unordered_map<V3Hash, Bucket>;
+
+public:
+    using size_type = size_t;
+    class iterator final {
+        friend class V3DupFinder;
+        Map::iterator m_bucketIt;  // Bucket of entry, or end() of map
+        size_t m_index = 0;  // Index of entry within bucket
+        iterator(Map::iterator bucketIt, size_t index)
+            : m_bucketIt{bucketIt}
+            , m_index{index} {}
 
+    public:
+        Entry& operator*() const { return m_bucketIt->second[m_index]; }
+        Entry* operator->() const { return &m_bucketIt->second[m_index]; }
+        bool operator==(const iterator& that) const {
+            return m_bucketIt == that.m_bucketIt && m_index == that.m_index;
+        }
+        bool operator!=(const iterator& that) const { return !(*this == that); }
+    };
+
+private:
     // MEMBERS
-    const V3Hasher* const m_hasherOwnedp = nullptr;  // Pointer to owned hasher
+    const V3Hasher* m_hasherOwnedp = nullptr;  // Pointer to owned hasher
     const V3Hasher& m_hasher;  // Reference to hasher
+    Map m_map;  // Nodes by hash
+    size_type m_size = 0;  // Number of nodes
 
 public:
     // CONSTRUCTORS
@@ -54,29 +89,40 @@ public:
         , m_hasher{*m_hasherOwnedp} {}
     explicit V3DupFinder(const V3Hasher& hasher)
         : m_hasher{hasher} {}
+    V3DupFinder(V3DupFinder&& that) noexcept
+        : m_hasherOwnedp{std::exchange(that.m_hasherOwnedp, nullptr)}
+        , m_hasher{that.m_hasher}
+        , m_map{std::move(that.m_map)}
+        , m_size{std::exchange(that.m_size, 0)} {}
     ~V3DupFinder() {
         if (m_hasherOwnedp) delete m_hasherOwnedp;
     }
+    V3DupFinder(const V3DupFinder&) = delete;
+    V3DupFinder& operator=(const V3DupFinder&) = delete;
+    V3DupFinder& operator=(V3DupFinder&&) = delete;
 
     // METHODS
-
-    // Expose minimal set of superclass interface
-    using Super::begin;
-    using Super::cbegin;
-    using Super::cend;
-    using Super::clear;
-    using Super::const_iterator;
-    using Super::empty;
-    using Super::end;
-    using Super::erase;
-    using Super::iterator;
-    using Super::size_type;
+    iterator end() { return iterator{m_map.end(), 0}; }
+    bool empty() const { return !m_size; }
+    size_type size() const { return m_size; }
+    void clear() {
+        m_map.clear();
+        m_size = 0;
+    }
 
     // Insert node into data structure
-    iterator insert(AstNode* nodep) { return emplace(m_hasher(nodep), nodep); }
+    iterator insert(AstNode* nodep) {
+        const V3Hash hash = m_hasher(nodep);
+        const Map::iterator bucketIt = m_map.emplace(hash, Bucket{}).first;
+        bucketIt->second.push_back(Entry{hash, nodep});
+        ++m_size;
+        return iterator{bucketIt, bucketIt->second.size() - 1};
+    }
 
     // Erase node from data structure
     size_type erase(AstNode* nodep) VL_MT_DISABLED;
+    // Erase entry from data structure
+    void erase(iterator it) VL_MT_DISABLED;
 
     // Return duplicate, if one was inserted, with optional user check for sameness
     iterator findDuplicate(AstNode* nodep, V3DupFinderUserSame* checkp = nullptr) VL_MT_DISABLED;
@@ -31,6 +31,7 @@ public:
     static void emitcInlines() VL_MT_DISABLED;
     static void emitcModel() VL_MT_DISABLED;
     static void emitcPch() VL_MT_DISABLED;
+    static void emitcStatsModel() VL_MT_DISABLED;
     static void emitcSyms(bool dpiHdrOnly = false) VL_MT_DISABLED;
 };
 
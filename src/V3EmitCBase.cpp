@@ -113,7 +113,7 @@ string EmitCBaseVisitorConst::cFuncArgs(const AstCFunc* nodep) {
     if (nodep->isLoose() && !nodep->isStatic()) {
         if (nodep->isConst().trueKnown()) args += "const ";
         args += prefixNameProtect(EmitCParentModule::get(nodep));
-        args += "* vlSelf";
+        args += v3Global.opt.restrictPointers() ? "* __restrict vlSelf" : "* vlSelf";
     }
     if (nodep->needProcess()) {
         if (!args.empty()) args += ", ";
@@ -262,6 +262,17 @@ void EmitCBaseVisitorConst::emitVarDecl(const AstVar* nodep, bool asRef) {
                                   && name.substr(name.size() - suffix.size()) == suffix;
             if (beStatic) puts("static thread_local ");
         }
+        // V3VariableOrder starts the state written by each thread on a new cache line.
+        // With --huge-pages, also start large arrays and wide members on a cache line
+        const bool member = !asRef && !nodep->isFuncLocal() && !nodep->isStatic();
+        if (member
+            && (nodep->cacheLineStart()
+                || (v3Global.opt.hugePages() && basicp && !basicp->isOpaque()
+                    && (nodep->isWide() || VN_IS(nodep->dtypeSkipRefp(), UnpackArrayDType))
+                    && nodep->dtypeSkipRefp()->arrayUnpackedElements() * basicp->widthTotalBytes()
+                           >= VL_CACHE_LINE_BYTES))) {
+            puts("alignas(VL_CACHE_LINE_BYTES) ");
+        }
         putns(nodep, nodep->vlArgType(true, false, false, "", asRef));
         puts(";\n");
     }
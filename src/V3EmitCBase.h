@@ -79,6 +79,15 @@ public:
     static bool isConstPoolMod(const AstNode* modp) {
         return modp == v3Global.rootp()->constPoolp()->modp();
     }
+    // Return divisor if a wide unsigned division/modulus by a constant that
+    // fits in one word, which is emitted as VL_DIV_WWI/VL_MODDIV_WWI
+    static const AstConst* narrowConstDivisorp(const AstNodeBiop* nodep) {
+        if (!nodep->isWide() || !(VN_IS(nodep, Div) || VN_IS(nodep, ModDiv))) return nullptr;
+        const AstConst* const constp = VN_CAST(nodep->rhsp(), Const);
+        if (!constp || constp->num().isFourState() || constp->num().isEqZero()) return nullptr;
+        if (constp->num().mostSetBitP1() > VL_EDATASIZE) return nullptr;
+        return constp;
+    }
 };
 
 class EmitCBaseVisitorConst VL_NOT_FINAL : public VNVisitorConst, public EmitCBase {
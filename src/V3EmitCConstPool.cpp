@@ -38,6 +38,7 @@ class EmitCConstPool final : public EmitCConstInit {
     int m_outFileSize = 0;
     VDouble0 m_tablesEmitted;
     VDouble0 m_constsEmitted;
+    VDouble0 m_tablesAligned;
 
     // METHODS
 
@@ -67,6 +68,15 @@ class EmitCConstPool final : public EmitCConstInit {
         setOutputFile(outFileAndNodePair.first, outFileAndNodePair.second);
     }
 
+    static bool isLargeTable(const AstVar* varp) {
+        const AstNodeDType* const dtypep = varp->dtypep()->skipRefp();
+        if (!VN_IS(dtypep, UnpackArrayDType)) return false;
+        const AstBasicDType* const basicp = varp->basicp();
+        if (!basicp || basicp->isOpaque()) return false;
+        return dtypep->arrayUnpackedElements() * basicp->widthTotalBytes()
+               >= VL_CACHE_LINE_BYTES;
+    }
+
     void emitVars(const AstConstPool* poolp) {
         std::vector<const AstVar*> varps;
         for (AstNode* nodep = poolp->modp()->stmtsp(); nodep; nodep = nodep->nextp()) {
@@ -86,6 +96,12 @@ class EmitCConstPool final : public EmitCConstInit {
             maybeSplitCFile();
             const string nameProtect = topClassName() + "__ConstPool__" + varp->nameProtect();
             puts("\n");
+            // Constant tables are placed in read-only data, start large ones on a
+            // cache line, so lookups touch as few lines as possible
+            if (isLargeTable(varp)) {
+                putns(varp, "alignas(VL_CACHE_LINE_BYTES) ");
+                ++m_tablesAligned;
+            }
             putns(varp, "extern const ");
             putns(varp, varp->dtypep()->cType(nameProtect, false, false));
             putns(varp, " = ");
@@ -114,6 +130,7 @@ public:
         emitVars(poolp);
         V3Stats::addStatSum("ConstPool, Tables emitted", m_tablesEmitted);
         V3Stats::addStatSum("ConstPool, Constants emitted", m_constsEmitted);
+        V3Stats::addStatSum("ConstPool, Tables aligned", m_tablesAligned);
     }
 };
 
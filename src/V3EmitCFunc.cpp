@@ -47,6 +47,7 @@ void EmitCFunc::emitOpName(AstNode* nodep, const string& format, AstNode* lhsp,
     //   %nq      emitIQW on the [node]
     //   %nw      width in bits
     //   %nW      width in words
+    //   %nT      width in words as template argument, if wide
     //   %ni      iterate
     //  %l*     lhsp - if appropriate, then second char as above
     //  %r*     rhsp - if appropriate, then second char as above
@@ -133,6 +134,9 @@ void EmitCFunc::emitOpName(AstNode* nodep, const string& format, AstNode* lhsp,
                         needComma = true;
                     }
                     break;
+                case 'T':
+                    if (detailp->isWide()) puts("<" + cvtToStr(detailp->widthWords()) + ">");
+                    break;
                 case 'i':
                     COMMA;
                     UASSERT_OBJ(detailp, nodep, "emitOperator() references undef node");
@@ -241,6 +245,16 @@ void EmitCFunc::displayEmit(AstNode* nodep, bool isScan) {
     }
 }
 
+int EmitCFunc::displayDecimalChars(const AstNode* argp, char fmtLetter) {
+    // Characters of a sized decimal output, argp is nullptr if ignored
+    const double mantissabits = !argp ? 0 : (argp->widthMin() - ((fmtLetter == 'd') ? 1 : 0));
+    // This is log10(2**mantissabits) as log2(2**mantissabits)/log2(10),
+    // + 1.0 rounding bias.
+    double dchars = mantissabits / 3.321928094887362 + 1.0;
+    if (fmtLetter == 'd') dchars++;  // space for sign
+    return int(dchars);
+}
+
 void EmitCFunc::displayArg(AstNode* dispp, AstNode** elistp, bool isScan, const string& vfmt,
                            bool ignore, char fmtLetter) {
     // Print display argument, edits elistp
@@ -269,13 +283,8 @@ void EmitCFunc::displayArg(AstNode* dispp, AstNode** elistp, bool isScan, const
     string pfmt;
     if ((fmtLetter == '#' || fmtLetter == 'd') && !isScan
         && vfmt == "") {  // Size decimal output.  Spec says leading spaces, not zeros
-        const double mantissabits = ignore ? 0 : (argp->widthMin() - ((fmtLetter == 'd') ? 1 : 0));
-        // This is log10(2**mantissabits) as log2(2**mantissabits)/log2(10),
-        // + 1.0 rounding bias.
-        double dchars = mantissabits / 3.321928094887362 + 1.0;
-        if (fmtLetter == 'd') dchars++;  // space for sign
-        const int nchars = int(dchars);
-        pfmt = "%"s + cvtToStr(nchars) + fmtLetter;
+        pfmt = "%"s + cvtToStr(displayDecimalChars(ignore ? nullptr : argp, fmtLetter))
+               + fmtLetter;
     } else {
         pfmt = "%"s + vfmt + fmtLetter;
     }
@@ -310,6 +319,7 @@ void EmitCFunc::displayArg(AstNode* dispp, AstNode** elistp, bool isScan, const
 
 void EmitCFunc::displayNode(AstNode* nodep, AstScopeName* scopenamep, const string& vformat,
                             AstNode* exprsp, bool isScan) {
+    if (!isScan && displayPreParsed(nodep, scopenamep, vformat, exprsp)) return;
     AstNode* elistp = exprsp;
 
     // Convert Verilog display to C printf formats
@@ -411,6 +421,140 @@ void EmitCFunc::displayNode(AstNode* nodep, AstScopeName* scopenamep, const stri
     displayEmit(nodep, isScan);
 }
 
+bool EmitCFunc::displayPreParsed(AstNode* nodep, AstScopeName* scopenamep,
+                                 const string& vformat, AstNode* exprsp) {
+    // Emit a $display or $sformatf whose format has only simple specifiers as a chain
+    // of VlFormat appends, so the format is not parsed at runtime.
+    // Return false, emitting nothing, when the format needs _vl_vsformat.
+    struct Item final {
+        char m_fmt;  // Format letter as in displayArg, or '\0' for literal text
+        string m_text;  // Literal text, or width of format ("" or "0")
+        AstNode* m_argp;  // Argument, or nullptr
+    };
+    const AstDisplay* const dispp = VN_CAST(nodep, Display);
+    if (!dispp && !VN_IS(nodep, SFormatF)) return false;
+    if (vformat.empty()) return false;
+    std::vector<Item> items;
+    string text;
+    const auto flushText = [&]() {
+        if (!text.empty()) items.push_back({'\0', text, nullptr});
+        text.clear();
+    };
+    AstNode* elistp = exprsp;
+    string vfmt;
+    bool inPct = false;
+    for (const char ch : vformat) {
+        if (!inPct && ch == '%') {
+            inPct = true;
+            vfmt = "";
+            continue;
+        } else if (!inPct) {
+            text += ch;
+            continue;
+        }
+        const char lower = std::tolower(ch);
+        if (std::isdigit(lower) || lower == '.' || lower == '-' || lower == '*') {
+            vfmt += ch;
+            continue;
+        }
+        inPct = false;
+        if (lower == '%') {
+            text += '%';
+            continue;
+        }
+        if (lower == 'm') {
+            UASSERT_OBJ(scopenamep, nodep, "Display with %m but no AstScopeName");
+            const string suffix = scopenamep->scopePrettySymName();
+            flushText();
+            items.push_back({'m', suffix.empty() ? "" : ".", nullptr});
+            text += suffix;
+            continue;
+        }
+        char fmt;
+        switch (lower) {
+        case '~': fmt = 'd'; break;  // Signed decimal
+        case 'd': fmt = '#'; break;  // Unsigned decimal
+        case 'h':  // FALLTHRU
+        case 'x': fmt = 'x'; break;
+        case 'b':  // FALLTHRU
+        case 'c':  // FALLTHRU
+        case '@': fmt = lower; break;
+        default: return false;
+        }
+        // Only the widths whose output does not depend on the runtime parser
+        if (vfmt != "" && (vfmt != "0" || fmt == 'c' || fmt == '@')) return false;
+        AstNode* const argp = elistp;
+        if (!argp) return false;
+        elistp = elistp->nextp();
+        if ((fmt == '@') != argp->isString()) return false;
+        if (fmt != '@' && (argp->isDouble() || !argp->dtypep()->basicp() || argp->isWide())) {
+            return false;
+        }
+        if (fmt == 'c' && argp->widthMin() > 8) return false;  // displayArg warns
+        flushText();
+        items.push_back({fmt, vfmt, argp});
+    }
+    if (inPct || elistp) return false;
+    flushText();
+
+    // Emit
+    size_t reserve = 0;
+    for (const Item& item : items) reserve += item.m_argp ? 20 : item.m_text.size();
+    const string format = "VlFormat{" + cvtToStr(reserve) + "}";
+    if (!dispp) {
+        putns(nodep, format);
+    } else if (dispp->filep()) {
+        putns(nodep, "VL_FWRITES_NX(");
+        iterateConst(dispp->filep());
+        puts("," + format);
+    } else {
+        putns(nodep, "VL_WRITES_NX(" + format);
+    }
+    ofp()->indentInc();
+    for (const Item& item : items) {
+        ofp()->putbs("");
+        switch (item.m_fmt) {
+        case '\0':
+            puts(".addText(");
+            ofp()->putsQuoted(item.m_text);
+            puts(", " + cvtToStr(item.m_text.size()) + ")");
+            continue;
+        case 'm':
+            puts(".addScope(vlSymsp->name(), "s + (item.m_text.empty() ? "false" : "true") + ")");
+            continue;
+        case 'd':
+            puts(".addDecS(" + cvtToStr(item.m_argp->widthMin()) + ", ");
+            puts(cvtToStr(item.m_text.empty() ? displayDecimalChars(item.m_argp, 'd') : 0));
+            puts(", ");
+            break;
+        case '#':
+            puts(".addDecU(");
+            puts(cvtToStr(item.m_text.empty() ? displayDecimalChars(item.m_argp, '#') : 0));
+            puts(", ");
+            break;
+        case 'x':
+        case 'b':
+            puts(item.m_fmt == 'x' ? ".addHex(" : ".addBin(");
+            puts(cvtToStr(item.m_argp->widthMin()));
+            puts(item.m_text.empty() ? ", false, " : ", true, ");
+            break;
+        case 'c': puts(".addChar("); break;
+        case '@': puts(".addString("); break;
+        default: nodep->v3fatalSrc("Unexpected format " << item.m_fmt);  // LCOV_EXCL_LINE
+        }
+        iterateConst(item.m_argp);
+        puts(")");
+    }
+    puts(".str()");
+    ofp()->indentDec();
+    if (dispp) {
+        puts(");\n");
+    } else {
+        puts(" ");
+    }
+    return true;
+}
+
 void EmitCFunc::emitCCallArgs(const AstNodeCCall* nodep, const string& selfPointer,
                               bool inProcess) {
     putns(nodep, "(");
@@ -440,7 +584,68 @@ void EmitCFunc::emitCCallArgs(const AstNodeCCall* nodep, const string& selfPoint
     puts(")");
 }
 
+void EmitCFunc::emitBasePointers(AstCFunc* nodep) {
+    // Cache pointers to other module instances accessed more than once in locals, so they can
+    // be declared '__restrict'. This requires all other accesses to these instances in the
+    // function to use the same pointer, so functions that call others, or contain arbitrary
+    // C++ code, are not eligible.
+    const bool eligible = !nodep->exists([](const AstNode* np) {
+        return VN_IS(np, NodeCCall) || VN_IS(np, CAwait) || VN_IS(np, CStmt) || VN_IS(np, CExpr)
+               || VN_IS(np, UCStmt) || VN_IS(np, UCFunc);
+    });
+    if (!eligible) return;
+    std::map<string, std::pair<const AstNodeModule*, size_t>> counts;  // Sorted for stability
+    nodep->foreach([&](const AstVarRef* refp) {
+        const AstVar* const varp = refp->varp();
+        const AstNodeModule* const varModp = EmitCParentModule::get(varp);
+        if (!refp->selfPointer().isVlSym() || varp->isStatic() || varp->isIfaceRef()) return;
+        if (isConstPoolMod(varModp) || VN_IS(varModp, Class)) return;
+        const string pointer = refp->selfPointerProtect(m_useSelfForThis);
+        if (pointer[0] != '(' || pointer[1] != '&') return;
+        auto& entry = counts[pointer];
+        entry.first = varModp;
+        ++entry.second;
+    });
+    for (const auto& pair : counts) {
+        if (pair.second.second < 2) continue;
+        const string name = "vlBase" + cvtToStr(m_basePointers.size());
+        m_basePointers.emplace(pair.first, name);
+        puts(prefixNameProtect(pair.second.first) + "* const __restrict " + name
+             + " VL_ATTR_UNUSED = " + pair.first + ";\n");
+    }
+}
+
+void EmitCFunc::gatherMovableVars(AstCFunc* nodep) {
+    // Function local class references and strings that are read only once, and not in a loop,
+    // are dead after the read, so an assignment from them can move the value instead of
+    // copying it. These are typically the temporaries holding function return values.
+    std::unordered_map<const AstVar*, size_t> reads;
+    const auto countRead = [&](const AstNodeVarRef* refp, bool inLoop) {
+        const AstVar* const varp = refp->varp();
+        if (!varp->isFuncLocal() || varp->isIO()) return;
+        const AstNodeDType* const dtypep = varp->dtypep()->skipRefp();
+        if (!VN_IS(dtypep, ClassRefDType) && !dtypep->isString()) return;
+        // Writes are fine, but reads in loops and read-modify-writes can be repeated
+        if (refp->access().isWriteOnly()) return;
+        reads[varp] += inLoop || refp->access().isRW() ? 2 : 1;
+    };
+    nodep->foreach([&](const AstNodeVarRef* refp) { countRead(refp, false); });
+    nodep->foreach([&](const AstNode* np) {
+        if (!VN_IS(np, While) && !VN_IS(np, DoWhile)) return;
+        np->foreach([&](const AstNodeVarRef* refp) { countRead(refp, true); });
+    });
+    for (const auto& pair : reads) {
+        if (pair.second == 1) m_movableVars.emplace(pair.first);
+    }
+}
+
 void EmitCFunc::emitDereference(AstNode* nodep, const string& pointer) {
+    const auto it = m_basePointers.find(pointer);
+    if (it != m_basePointers.end()) {
+        putns(nodep, it->second);
+        puts("->");
+        return;
+    }
     if (pointer[0] == '(' && pointer[1] == '&') {
         // remove "address of" followed by immediate dereference
         // Note: this relies on only the form '(&OBJECT)' being used by Verilator
@@ -648,7 +853,13 @@ void EmitCFunc::emitVarReset(AstVar* varp, bool constructing) {
                                    VN_AS(valuep, Const));
             }
         } else if (AstUnpackArrayDType* const adtypep = VN_CAST(dtypep, UnpackArrayDType)) {
-            if (initarp->defaultp()) {
+            if (adtypep->isSparse()) {
+                if (!constructing) puts(varNameProtected + ".clear();\n");
+                if (initarp->defaultp()) {
+                    emitSetVarConstant(varNameProtected + ".atDefault()",
+                                       VN_AS(initarp->defaultp(), Const));
+                }
+            } else if (initarp->defaultp()) {
                 puts("for (int __Vi = 0; __Vi < " + cvtToStr(adtypep->elementsConst()));
                 puts("; ++__Vi) {\n");
                 emitSetVarConstant(varNameProtected + "[__Vi]", VN_AS(initarp->defaultp(), Const));
@@ -713,6 +924,15 @@ string EmitCFunc::emitVarResetRecurse(const AstVar* varp, bool constructing,
     } else if (const AstUnpackArrayDType* const adtypep = VN_CAST(dtypep, UnpackArrayDType)) {
         UASSERT_OBJ(adtypep->hi() >= adtypep->lo(), varp,
                     "Should have swapped msb & lsb earlier.");
+        if (adtypep->isSparse()) {
+            // Reset the default value, rather than every element
+            const string cvtarray = (adtypep->subDTypep()->isWide() ? ".data()" : "");
+            const string pre = constructing ? "" : varNameProtected + suffix + ".clear();\n";
+            return pre
+                   + emitVarResetRecurse(varp, constructing, varNameProtected,
+                                         adtypep->subDTypep(), depth + 1,
+                                         suffix + ".atDefault()" + cvtarray);
+        }
         const string ivar = "__Vi"s + cvtToStr(depth);
         const string pre = ("for (int " + ivar + " = " + cvtToStr(0) + "; " + ivar + " < "
                             + cvtToStr(adtypep->elementsConst()) + "; ++" + ivar + ") {\n");
@@ -748,14 +968,7 @@ string EmitCFunc::emitVarResetRecurse(const AstVar* varp, bool constructing,
     } else if (basicp && basicp->isRandomGenerator()) {
         return "";
     } else if (basicp) {
-        const bool zeroit
-            = (varp->attrFileDescr()  // Zero so we don't do file IO if never $fopen
-               || varp->isFuncLocal()  // Randomization too slow
-               || (basicp && basicp->isZeroInit())
-               || (v3Global.opt.underlineZero() && !varp->name().empty() && varp->name()[0] == '_')
-               || (varp->isXTemp()
-                       ? (v3Global.opt.xAssign() != "unique")
-                       : (v3Global.opt.xInitial() == "fast" || v3Global.opt.xInitial() == "0")));
+        const bool zeroit = isVarResetZero(varp, basicp);
         const bool slow = !varp->isFuncLocal() && !varp->isClassMember();
         splitSizeInc(1);
         if (dtypep->isWide()) {  // Handle unpacked; not basicp->isWide
@@ -812,6 +1025,72 @@ string EmitCFunc::emitVarResetRecurse(const AstVar* varp, bool constructing,
     return "";
 }
 
+bool EmitCFunc::isVarResetZero(const AstVar* varp, const AstBasicDType* basicp) {
+    return (varp->attrFileDescr()  // Zero so we don't do file IO if never $fopen
+            || varp->isFuncLocal()  // Randomization too slow
+            || (basicp && basicp->isZeroInit())
+            || (v3Global.opt.underlineZero() && !varp->name().empty() && varp->name()[0] == '_')
+            || (varp->isXTemp()
+                    ? (v3Global.opt.xAssign() != "unique")
+                    : (v3Global.opt.xInitial() == "fast" || v3Global.opt.xInitial() == "0")));
+}
+
+bool EmitCFunc::isVarResetTable(const AstCReset* nodep) {
+    // Narrow module member randomly reset by VL_SCOPED_RAND_RESET_I/Q
+    if (m_classOrPackage || !VN_IS(m_modp, Module)) return false;
+    const AstVar* const varp = nodep->varrefp()->varp();
+    if (varp->isFuncLocal() || varp->isClassMember() || varp->isStatic()) return false;
+    if (varp->isParam() || varp->valuep() || varp->isXTemp()) return false;
+    if (varp->isIO() && m_modp->isTop() && optSystemC()) return false;
+    const AstBasicDType* const basicp = VN_CAST(varp->dtypep()->skipRefp(), BasicDType);
+    if (!basicp || basicp->isOpaque() || basicp->isWide()) return false;
+    if (v3Global.opt.xInitialEdge() && varp->isUsedClock()) return false;
+    return !isVarResetZero(varp, basicp);
+}
+
+bool EmitCFunc::emitVarResetTable(AstCReset* nodep) {
+    // Emit a run of random resets of narrow variables as tables walked by the run-time library,
+    // rather than a statement each, as that is much faster to compile for large designs
+    static constexpr size_t RESET_TABLE_MIN_VARS = 8;
+    std::vector<const AstVar*> varps;
+    for (AstNode* np = nodep; np; np = np->nextp()) {
+        const AstCReset* const resetp = VN_CAST(np, CReset);
+        if (!resetp || !isVarResetTable(resetp)) break;
+        varps.push_back(resetp->varrefp()->varp());
+    }
+    if (varps.size() < RESET_TABLE_MIN_VARS) return false;
+    m_resetTableSkip = varps.size() - 1;
+    emitVarResetScopeHash();
+    // One table for each C type
+    std::map<string, std::vector<const AstVar*>> typeVarps;
+    for (const AstVar* const varp : varps) {
+        const int width = varp->dtypep()->widthMin();
+        const string ctype = width <= 8    ? "CData"
+                             : width <= 16 ? "SData"
+                             : width <= VL_IDATASIZE ? "IData"
+                                                     : "QData";
+        typeVarps[ctype].push_back(varp);
+    }
+    const string className = prefixNameProtect(m_modp);
+    for (const auto& pair : typeVarps) {
+        puts("{\n");
+        puts("static const VlScopedRandResetEntry<" + className + ", " + pair.first
+             + "> __Vtable[] = {\n");
+        for (const AstVar* const varp : pair.second) {
+            splitSizeInc(1);
+            const uint64_t salt = VString::hashMurmur(varp->prettyName());
+            putns(varp, "{&" + className + "::" + varp->nameProtect() + ", "
+                            + cvtToStr(varp->dtypep()->widthMin()) + ", " + std::to_string(salt)
+                            + "ull},\n");
+        }
+        puts("};\n");
+        puts("VL_SCOPED_RAND_RESET_TABLE(" + VSelfPointerText::replaceThis(m_useSelfForThis, "this")
+             + ", __Vtable, __VscopeHash);\n");
+        puts("}\n");
+    }
+    return true;
+}
+
 void EmitCFunc::emitVarResetScopeHash() {
     if (VL_LIKELY(m_createdScopeHash)) { return; }
     if (m_classOrPackage) {
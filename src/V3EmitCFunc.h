@@ -121,6 +121,7 @@ class EmitCFunc VL_NOT_FINAL : public EmitCConstInit {
     bool m_inUC = false;  // Inside an AstUCStmt or AstUCExpr
     bool m_emitConstInit = false;  // Emitting constant initializer
     bool m_createdScopeHash = false;  // Already created a scope hash
+    size_t m_resetTableSkip = 0;  // Following AstCResets already emitted in a reset table
 
     // State associated with processing $display style string formatting
     struct EmitDispState final {
@@ -148,6 +149,10 @@ protected:
     EmitCLazyDecls m_lazyDecls;  // Visitor for emitting lazy declarations
     bool m_useSelfForThis = false;  // Replace "this" with "vlSelf"
     bool m_usevlSelfRef = false;  // Use vlSelfRef reference instead of vlSelf pointer
+    // Local restricted pointers replacing 'vlSymsp->...' self pointers in current function
+    std::unordered_map<string, string> m_basePointers;
+    // Local class references and strings in current function whose single read can move
+    std::unordered_set<const AstVar*> m_movableVars;
     const AstNodeModule* m_modp = nullptr;  // Current module being emitted
     const AstCFunc* m_cfuncp = nullptr;  // Current function being emitted
     bool m_instantiatesOwnProcess = false;
@@ -186,6 +191,9 @@ public:
     void displayEmit(AstNode* nodep, bool isScan);
     void displayArg(AstNode* dispp, AstNode** elistp, bool isScan, const string& vfmt, bool ignore,
                     char fmtLetter);
+    bool displayPreParsed(AstNode* nodep, AstScopeName* scopenamep, const string& vformat,
+                          AstNode* exprsp);
+    static int displayDecimalChars(const AstNode* argp, char fmtLetter);
 
     bool emitSimpleOk(AstNodeExpr* nodep);
     void emitIQW(AstNode* nodep) {
@@ -217,6 +225,8 @@ public:
                     AstNode* thsp);
     void emitCCallArgs(const AstNodeCCall* nodep, const string& selfPointer, bool inProcess);
     void emitDereference(AstNode* nodep, const string& pointer);
+    void emitBasePointers(AstCFunc* nodep);
+    void gatherMovableVars(AstCFunc* nodep);
     void emitCvtPackStr(AstNode* nodep);
     void emitCvtWideArray(AstNode* nodep, AstNode* fromp);
     void emitConstant(AstConst* nodep, AstVarRef* assigntop, const string& assignString);
@@ -227,6 +237,9 @@ public:
                                const string& varNameProtected, AstNodeDType* dtypep, int depth,
                                const string& suffix);
     void emitVarResetScopeHash();
+    static bool isVarResetZero(const AstVar* varp, const AstBasicDType* basicp);
+    bool isVarResetTable(const AstCReset* nodep);
+    bool emitVarResetTable(AstCReset* nodep);
     void emitChangeDet();
     void emitConstInit(AstNode* initp) {
         // We should refactor emit to produce output into a provided buffer, not go through members
@@ -395,8 +408,13 @@ public:
             // speculatively and also reduce the data cache pollution when
             // executing in the wrong path to make Verilated code faster.
             puts("auto& vlSelfRef = std::ref(*vlSelf).get();\n");
+            if (v3Global.opt.restrictPointers() && !VN_IS(m_modp, Class)) {
+                emitBasePointers(nodep);
+            }
         }
 
+        gatherMovableVars(nodep);
+
         if (nodep->initsp()) {
             putsDecoration(nodep, "// Init\n");
             iterateAndNextConstNull(nodep->initsp());
@@ -413,6 +431,8 @@ public:
         }
 
         m_usevlSelfRef = false;
+        m_basePointers.clear();
+        m_movableVars.clear();
 
         puts("}\n");
         if (nodep->ifdef() != "") puts("#endif  // " + nodep->ifdef() + "\n");
@@ -536,6 +556,14 @@ public:
             decind = true;
             if (!VN_IS(nodep->rhsp(), Const)) ofp()->putBreak();
             putns(nodep, "= ");
+            const AstVarRef* const rhsRefp = VN_CAST(nodep->rhsp(), VarRef);
+            if (rhsRefp && m_movableVars.count(rhsRefp->varp())) {
+                // Last use of a temporary, so no need to copy it
+                puts("std::move(");
+                iterateAndNextConstNull(nodep->rhsp());
+                puts(")");
+                rhs = false;
+            }
         }
         if (rhs) iterateAndNextConstNull(nodep->rhsp());
         if (paren) puts(")");
@@ -663,7 +691,11 @@ public:
     }
     void visit(AstCoverDecl* nodep) override {
         putns(nodep, "vlSelf->__vlCoverInsert(");  // As Declared in emitCoverageDecl
-        puts("&(vlSymsp->__Vcoverage[");
+        if (v3Global.opt.useCoverageShards()) {
+            puts("&(vlSymsp->__Vcoverage[0].m_bins[");
+        } else {
+            puts("&(vlSymsp->__Vcoverage[");
+        }
         puts(cvtToStr(nodep->dataDeclThisp()->binNum()));
         puts("])");
         // If this isn't the first instantiation of this module under this
@@ -690,7 +722,12 @@ public:
         puts(");\n");
     }
     void visit(AstCoverInc* nodep) override {
-        if (v3Global.opt.threads() > 1) {
+        if (v3Global.opt.useCoverageShards()) {
+            // Only this thread writes its shard, so no atomic needed
+            putns(nodep, "++(vlSymsp->__Vcoverage[Verilated::threadIndex()].m_bins[");
+            puts(cvtToStr(nodep->declp()->dataDeclThisp()->binNum()));
+            puts("]);\n");
+        } else if (v3Global.opt.threads() > 1) {
             putns(nodep, "vlSymsp->__Vcoverage[");
             puts(cvtToStr(nodep->declp()->dataDeclThisp()->binNum()));
             puts("].fetch_add(1, std::memory_order_relaxed);\n");
@@ -745,7 +782,8 @@ public:
             // Currently ignored as both Vcd and Fst do not support them, as would need "X" dump
             break;
         case VDumpCtlType::ON:
-            // Currently ignored as $dumpoff is also ignored
+            // Only triggers flight recording traces, as $dumpoff is ignored
+            if (v3Global.opt.trace()) putns(nodep, "vlSymsp->_vm_contextp__->dumpon();\n");
             break;
         default: nodep->v3fatalSrc("Bad case, unexpected " << nodep->ctlType().ascii());
         }
@@ -1222,10 +1260,25 @@ public:
             puts(" ");
             iterateAndNextConstNull(nodep->rhsp());
             puts(")");
+        } else if (const AstConst* const constp = narrowConstDivisorp(nodep)) {
+            const std::string name = VN_IS(nodep, Div) ? "VL_DIV_WWI" : "VL_MODDIV_WWI";
+            emitOpName(nodep, name + "(%lw, %P, %li, " + cvtToStr(constp->num().toUInt()) + "U)",
+                       nodep->lhsp(), nullptr, nullptr);
         } else {
             emitOpName(nodep, nodep->emitC(), nodep->lhsp(), nodep->rhsp(), nullptr);
         }
     }
+    void visit(AstArraySel* nodep) override {
+        // Read sparse arrays without allocating storage for untouched pages
+        const AstUnpackArrayDType* const adtypep
+            = VN_CAST(nodep->fromp()->dtypep()->skipRefp(), UnpackArrayDType);
+        const AstVarRef* const varrefp = VN_CAST(nodep->fromp(), VarRef);
+        if (adtypep && adtypep->isSparse() && varrefp && varrefp->access().isReadOnly()) {
+            emitOpName(nodep, "%li.read(%ri)", nodep->fromp(), nodep->bitp(), nullptr);
+            return;
+        }
+        visit(static_cast<AstNodeBiop*>(nodep));
+    }
     void visit(AstNodeTriop* nodep) override {
         UASSERT_OBJ(!emitSimpleOk(nodep), nodep, "Triop cannot be described in a simple way");
         emitOpName(nodep, nodep->emitC(), nodep->lhsp(), nodep->rhsp(), nodep->thsp());
@@ -1516,6 +1569,11 @@ public:
         }
     }
     void visit(AstCReset* nodep) override {
+        if (m_resetTableSkip) {
+            --m_resetTableSkip;
+            return;
+        }
+        if (emitVarResetTable(nodep)) return;
         AstVar* const varp = nodep->varrefp()->varp();
         emitVarReset(varp, nodep->constructing());
     }
@@ -175,7 +175,9 @@ class EmitCHeader final : public EmitCConstInit {
         if (v3Global.opt.coverage() && !VN_IS(modp, Class)) {
             decorateFirst(first, section);
             puts("void __vlCoverInsert(");
-            puts(v3Global.opt.threads() > 1 ? "std::atomic<uint32_t>" : "uint32_t");
+            puts(v3Global.opt.threads() > 1 && !v3Global.opt.useCoverageShards()
+                     ? "std::atomic<uint32_t>"
+                     : "uint32_t");
             puts("* countp, bool enable, const char* filenamep, int lineno, int column,\n");
             puts("const char* hierp, const char* pagep, const char* commentp, const char* "
                  "linescovp);\n");
@@ -586,6 +588,14 @@ class EmitCHeader final : public EmitCConstInit {
         ofp()->resetPrivate();
         ofp()->putsPrivate(false);  // public:
 
+        // Class objects are only accessed from a single thread without mtasks, so no need for
+        // atomic reference counting
+        if (VN_IS(modp, Class) && !v3Global.opt.mtasks()) {
+            puts("static constexpr bool vlAtomicRefCount = false;\n");
+        }
+        // Reuse memory of destroyed objects
+        if (VN_IS(modp, Class)) puts("VL_CLASS_POOL_ALLOC\n");
+
         // Emit all class body contents
         emitCellDecls(modp);
         emitEnums(modp);
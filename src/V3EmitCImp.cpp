@@ -18,10 +18,13 @@
 
 #include "V3EmitC.h"
 #include "V3EmitCFunc.h"
+#include "V3Hasher.h"
 #include "V3ThreadPool.h"
 #include "V3UniqueNames.h"
 
 #include <map>
+#include <numeric>
+#include <queue>
 #include <set>
 #include <vector>
 
@@ -149,47 +152,86 @@ public:
     }
 };
 
+//######################################################################
+// Visitor that estimates the C++ compilation cost of an AstCFunc
+
+class EmitCCompileCost final : VNVisitorConst {
+    // MEMBERS
+    uint64_t m_cost = 0;  // Estimated cost, in units of --output-split statements
+
+    // VISITORS
+    void visit(AstNodeExpr* nodep) override {
+        ++m_cost;
+        // Wide operations expand to loops over the words
+        if (nodep->isWide()) m_cost += std::min(nodep->widthWords(), 16);
+        iterateChildrenConst(nodep);
+    }
+    void visit(AstCMethodHard* nodep) override {
+        // Methods of the templated runtime containers need instantiating
+        m_cost += 10;
+        visit(static_cast<AstNodeExpr*>(nodep));
+    }
+    void visit(AstNode* nodep) override {
+        ++m_cost;
+        iterateChildrenConst(nodep);
+    }
+
+    // CONSTRUCTOR
+    explicit EmitCCompileCost(AstCFunc* cfuncp) { iterateConst(cfuncp); }
+
+public:
+    static uint64_t count(AstCFunc* cfuncp) VL_MT_STABLE {
+        return EmitCCompileCost{cfuncp}.m_cost;
+    }
+};
+
 //######################################################################
 // Internal EmitC implementation
 
 class EmitCImp final : EmitCFunc {
+public:
+    // TYPES
+    // A file of functions, planned up front so all the files can be emitted in parallel
+    struct FuncFile final {
+        std::set<string> m_headers;  // Header files required by output file
+        string m_filename;  // Output filename
+        std::vector<AstCFunc*> m_funcps;  // Functions in the file, in emission order
+    };
+
+private:
     // MEMBERS
     const AstNodeModule* const m_fileModp;  // Files names/headers constructed using this module
     const bool m_slow;  // Creating __Slow file
-    const std::set<string>* m_requiredHeadersp;  // Header files required by output file
-    std::string m_subFileName;  // substring added to output filenames
     V3UniqueNames m_uniqueNames;  // For generating unique file names
     std::deque<AstCFile*>& m_cfilesr;  // cfiles generated by this emit
 
     // METHODS
-    void openNextOutputFile(const std::set<string>& headers, const string& subFileName) {
+    string outputFilename(const string& subFileName, const string& hotness) {
+        // Unfortunately we have some lint checks here, so we can't just skip processing.
+        // We should move them to a different stage.
+        if (v3Global.opt.lintOnly()) return VL_DEV_NULL;
+        string filename = v3Global.opt.makeDir() + "/" + prefixNameProtect(m_fileModp);
+        if (!subFileName.empty()) {
+            filename += "__" + subFileName;
+            filename = m_uniqueNames.get(filename);
+        }
+        if (m_slow) filename += "__Slow";
+        if (!hotness.empty()) filename += "__" + hotness;
+        filename += ".cpp";
+        return filename;
+    }
+    void openNextOutputFile(const std::set<string>& headers, const string& filename) {
         UASSERT(!ofp(), "Output file already open");
 
         splitSizeReset();  // Reset file size tracking
         m_lazyDecls.reset();  // Need to emit new lazy declarations
 
-        if (v3Global.opt.lintOnly()) {
-            // Unfortunately we have some lint checks here, so we can't just skip processing.
-            // We should move them to a different stage.
-            const string filename = VL_DEV_NULL;
-            AstCFile* const filep = createCFile(filename, /* slow: */ m_slow, /* source: */ true);
-            m_cfilesr.push_back(filep);
-            V3OutCFile* const ofilep = new V3OutCFile{filename};
-            setOutputFile(ofilep, filep);
-        } else {
-            string filename = v3Global.opt.makeDir() + "/" + prefixNameProtect(m_fileModp);
-            if (!subFileName.empty()) {
-                filename += "__" + subFileName;
-                filename = m_uniqueNames.get(filename);
-            }
-            if (m_slow) filename += "__Slow";
-            filename += ".cpp";
-            AstCFile* const filep = createCFile(filename, /* slow: */ m_slow, /* source: */ true);
-            m_cfilesr.push_back(filep);
-            V3OutCFile* const ofilep
-                = v3Global.opt.systemC() ? new V3OutScFile{filename} : new V3OutCFile{filename};
-            setOutputFile(ofilep, filep);
-        }
+        AstCFile* const filep = createCFile(filename, /* slow: */ m_slow, /* source: */ true);
+        m_cfilesr.push_back(filep);
+        V3OutCFile* const ofilep = v3Global.opt.systemC() && !v3Global.opt.lintOnly()
+                                       ? new V3OutScFile{filename}
+                                       : new V3OutCFile{filename};
+        setOutputFile(ofilep, filep);
 
         putsHeader();
         puts("// DESCRIPTION: Verilator output: Design implementation internals\n");
@@ -312,13 +354,14 @@ class EmitCImp final : EmitCFunc {
             // Rather than putting out VL_COVER_INSERT calls directly, we do it via this
             // function. This gets around gcc slowness constructing all of the template
             // arguments.
+            const bool shards = v3Global.opt.useCoverageShards();
             puts("void " + prefixNameProtect(m_modp) + "::__vlCoverInsert(");
-            puts(v3Global.opt.threads() > 1 ? "std::atomic<uint32_t>" : "uint32_t");
+            puts(v3Global.opt.threads() > 1 && !shards ? "std::atomic<uint32_t>" : "uint32_t");
             puts("* countp, bool enable, const char* filenamep, int lineno, int column,\n");
             puts("const char* hierp, const char* pagep, const char* commentp, const char* "
                  "linescovp) "
                  "{\n");
-            if (v3Global.opt.threads() > 1) {
+            if (v3Global.opt.threads() > 1 && !shards) {
                 puts("assert(sizeof(uint32_t) == sizeof(std::atomic<uint32_t>));\n");
                 puts("uint32_t* count32p = reinterpret_cast<uint32_t*>(countp);\n");
             } else {
@@ -331,8 +374,17 @@ class EmitCImp final : EmitCFunc {
             // Used for second++ instantiation of identical bin
             puts("if (!enable) count32p = &fake_zero_count;\n");
             puts("*count32p = 0;\n");
-            puts("VL_COVER_INSERT(vlSymsp->_vm_contextp__->coveragep(), VerilatedModule::name(), "
-                 "count32p,");
+            if (shards) {
+                puts("const size_t stride"
+                     " = sizeof(vlSymsp->__Vcoverage[0]) / sizeof(uint32_t);\n");
+                puts("const uint32_t nshards = enable ? " + cvtToStr(v3Global.opt.threads())
+                     + " : 1;\n");
+                puts("VL_COVER_INSERT_SHARDS(vlSymsp->_vm_contextp__->coveragep(), "
+                     "VerilatedModule::name(), count32p, stride, nshards,");
+            } else {
+                puts("VL_COVER_INSERT(vlSymsp->_vm_contextp__->coveragep(), "
+                     "VerilatedModule::name(), count32p,");
+            }
             puts("  \"filename\",filenamep,");
             puts("  \"lineno\",lineno,");
             puts("  \"column\",column,\n");
@@ -396,22 +448,34 @@ class EmitCImp final : EmitCFunc {
                         } else if (varp->basicp() && varp->basicp()->isTriggerVec()) {
                         } else if (VN_IS(varp->dtypep(), NBACommitQueueDType)) {
                         } else {
-                            int vects = 0;
                             AstNodeDType* elementp = varp->dtypeSkipRefp();
+                            while (AstUnpackArrayDType* const arrayp
+                                   = VN_CAST(elementp, UnpackArrayDType)) {
+                                UASSERT_OBJ(arrayp->hi() >= arrayp->lo(), varp,
+                                            "Should have swapped msb & lsb earlier.");
+                                elementp = arrayp->subDTypep()->skipRefp();
+                            }
+                            const AstBasicDType* const basicp = elementp->basicp();
+                            // Do not save MTask state, only matters within an evaluation
+                            if (basicp && basicp->keyword().isMTaskState()) continue;
+                            // Arrays and wides of numbers are saved in bulk; the bytes are the
+                            // same as saving each element
+                            if (VN_IS(elementp, BasicDType)
+                                && (basicp->keyword().isIntNumeric() || basicp->isDouble())) {
+                                putns(varp, "os" + op + varp->nameProtect() + ";\n");
+                                continue;
+                            }
+                            int vects = 0;
+                            elementp = varp->dtypeSkipRefp();
                             for (AstUnpackArrayDType* arrayp = VN_CAST(elementp, UnpackArrayDType);
                                  arrayp; arrayp = VN_CAST(elementp, UnpackArrayDType)) {
                                 const int vecnum = vects++;
-                                UASSERT_OBJ(arrayp->hi() >= arrayp->lo(), varp,
-                                            "Should have swapped msb & lsb earlier.");
                                 const string ivar = "__Vi"s + cvtToStr(vecnum);
                                 puts("for (int __Vi" + cvtToStr(vecnum) + " = " + cvtToStr(0));
                                 puts("; " + ivar + " < " + cvtToStr(arrayp->elementsConst()));
                                 puts("; ++" + ivar + ") {\n");
                                 elementp = arrayp->subDTypep()->skipRefp();
                             }
-                            const AstBasicDType* const basicp = elementp->basicp();
-                            // Do not save MTask state, only matters within an evaluation
-                            if (basicp && basicp->keyword().isMTaskState()) continue;
                             // Want to detect types that are represented as arrays
                             // (i.e. packed types of more than 64 bits).
                             if (elementp->isWide()
@@ -473,7 +537,7 @@ class EmitCImp final : EmitCFunc {
             headers.insert(prefixNameProtect(m_fileModp));
             headers.insert(symClassName());
 
-            openNextOutputFile(headers, "");
+            openNextOutputFile(headers, outputFilename("", ""));
 
             doCommonImp(modp);
             if (classp) {
@@ -485,11 +549,12 @@ class EmitCImp final : EmitCFunc {
             closeOutputFile();
         }
     }
-    void emitCFuncImp(const AstNodeModule* modp) {
+    void planCFuncFiles(const AstNodeModule* modp, std::vector<FuncFile>& funcFilesr) {
         // Partition functions based on which module definitions they require, by building a
         // map from "AstNodeModules whose definitions are required" -> "functions that need
-        // them"
-        std::map<const std::set<string>, std::vector<AstCFunc*>> depSet2funcps;
+        // them". Profile-guided hot and cold functions also go to their own files.
+        std::map<std::pair<const std::set<string>, string>, std::vector<AstCFunc*>>
+            depSet2funcps;
 
         const auto gather = [this, &depSet2funcps](const AstNodeModule* modp) {
             for (AstNode* nodep = modp->stmtsp(); nodep; nodep = nodep->nextp()) {
@@ -500,54 +565,125 @@ class EmitCImp final : EmitCFunc {
                     if (funcp->dpiExportDispatcher()) continue;
                     if (funcp->slow() != m_slow) continue;
                     const auto& depSet = EmitCGatherDependencies::gather(funcp);
-                    depSet2funcps[depSet].push_back(funcp);
+                    const string hotness = funcp->hot() ? "Hot" : funcp->cold() ? "Cold" : "";
+                    depSet2funcps[{depSet, hotness}].push_back(funcp);
                 }
             }
         };
 
         gather(modp);
-        VL_RESTORER(m_classOrPackage);
         if (const AstClassPackage* const packagep = VN_CAST(modp, ClassPackage)) {
-            m_classOrPackage = packagep;
             gather(packagep->classp());
         }
 
-        // Emit all functions in each dependency set into separate files
+        // Plan all functions in each dependency set into separate files
         for (const auto& pair : depSet2funcps) {
-            m_requiredHeadersp = &pair.first;
+            const std::set<string>& headers = pair.first.first;
+            const string& hotness = pair.first.second;
             // Compute the hash of the dependencies, so we can add it to the filenames to
             // disambiguate them
             V3Hash hash;
-            for (const string& name : *m_requiredHeadersp) hash += name;
-            m_subFileName = "DepSet_" + hash.toString();
-            // Open output file
-            openNextOutputFile(*m_requiredHeadersp, m_subFileName);
-            // Emit functions in this dependency set
-            for (AstCFunc* const funcp : pair.second) {
-                VL_RESTORER(m_modp);
-                m_modp = EmitCParentModule::get(funcp);
-                iterateConst(funcp);
+            for (const string& name : headers) hash += name;
+            const string depSetName = "DepSet_" + hash.toString();
+            std::vector<std::vector<AstCFunc*>> files = packFiles(pair.second);
+            // Splitting file, so using parallel build.
+            if (files.size() > 1) v3Global.useParallelBuild(true);
+            for (std::vector<AstCFunc*>& funcps : files) {
+                // Name output file by its first function if names must be stable
+                string subFileName = depSetName;
+                if (v3Global.opt.outputSplitStable() && files.size() > 1) {
+                    subFileName += "_" + V3Hash{funcps.front()->name()}.toString();
+                }
+                funcFilesr.push_back(
+                    {headers, outputFilename(subFileName, hotness), std::move(funcps)});
             }
-            // Close output file
-            closeOutputFile();
         }
     }
-
-    // VISITORS
-    void visit(AstCFunc* nodep) override {
-        if (splitNeeded()) {
-            // Splitting file, so using parallel build.
-            v3Global.useParallelBuild(true);
-            // Close old file
-            closeOutputFile();
-            // Open a new file
-            openNextOutputFile(*m_requiredHeadersp, m_subFileName);
+    void emitCFuncFile(const AstNodeModule* modp, const FuncFile& funcFile) {
+        VL_RESTORER(m_classOrPackage);
+        m_classOrPackage = VN_CAST(modp, ClassPackage);
+        openNextOutputFile(funcFile.m_headers, funcFile.m_filename);
+        // Emit functions in this file
+        for (AstCFunc* const funcp : funcFile.m_funcps) {
+            VL_RESTORER(m_modp);
+            m_modp = EmitCParentModule::get(funcp);
+            iterateConst(funcp);
         }
-
-        EmitCFunc::visit(nodep);
+        // Close output file
+        closeOutputFile();
+    }
+    // Distribute functions into files with --output-split, so that each file takes about the
+    // same time to compile. Largest functions first, each to the currently cheapest file.
+    static std::vector<std::vector<AstCFunc*>> packFiles(const std::vector<AstCFunc*>& funcps) {
+        const uint64_t split = v3Global.opt.outputSplit();
+        if (!split || funcps.size() <= 1) return {funcps};
+        std::vector<uint64_t> costs;
+        costs.reserve(funcps.size());
+        uint64_t total = 0;
+        for (AstCFunc* const funcp : funcps) {
+            costs.push_back(EmitCCompileCost::count(funcp));
+            total += costs.back();
+        }
+        if (v3Global.opt.outputSplitStable()) return packFilesStable(funcps, costs);
+        const size_t nFiles = std::min<uint64_t>(funcps.size(), (total + split - 1) / split);
+        if (nFiles <= 1) return {funcps};
+        std::vector<size_t> order(funcps.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(),
+                         [&](size_t a, size_t b) { return costs[a] > costs[b]; });
+        // Min-heap of (cost so far, file index)
+        using Load = std::pair<uint64_t, size_t>;
+        std::priority_queue<Load, std::vector<Load>, std::greater<Load>> loads;
+        for (size_t i = 0; i < nFiles; ++i) loads.emplace(0, i);
+        std::vector<size_t> fileOf(funcps.size());
+        for (const size_t i : order) {
+            const Load load = loads.top();
+            loads.pop();
+            fileOf[i] = load.second;
+            loads.emplace(load.first + costs[i], load.second);
+        }
+        // Keep the original function order within each file
+        std::vector<std::vector<AstCFunc*>> files(nFiles);
+        for (size_t i = 0; i < funcps.size(); ++i) files[fileOf[i]].push_back(funcps[i]);
+        return files;
+    }
+    // With --output-split-stable, order the functions by content, and end a file after a
+    // function chosen from its own hash, so that a change only affects the files around it.
+    // On average this ends a file every --output-split units of cost.
+    static std::vector<std::vector<AstCFunc*>>
+    packFilesStable(const std::vector<AstCFunc*>& funcps, const std::vector<uint64_t>& costs) {
+        const uint64_t split = v3Global.opt.outputSplit();
+        std::vector<std::pair<uint32_t, size_t>> order;  // (content hash, index)
+        order.reserve(funcps.size());
+        for (size_t i = 0; i < funcps.size(); ++i) {
+            order.emplace_back(V3Hasher::uncachedHash(funcps[i]).value(), i);
+        }
+        std::sort(order.begin(), order.end(), [&](const auto& a, const auto& b) {
+            if (a.first != b.first) return a.first < b.first;
+            return funcps[a.second]->name() < funcps[b.second]->name();
+        });
+        std::vector<std::vector<AstCFunc*>> files(1);
+        uint64_t cost = 0;
+        for (const auto& pair : order) {
+            if (cost >= 2 * split) {
+                files.emplace_back();
+                cost = 0;
+            }
+            files.back().push_back(funcps[pair.second]);
+            cost += costs[pair.second];
+            // Mix the hash so the choice is independent of the sort order
+            const uint64_t mixed = (pair.first * 0x9E3779B97F4A7C15ULL) >> 32;
+            if (mixed % split < costs[pair.second]) {
+                files.emplace_back();
+                cost = 0;
+            }
+        }
+        if (files.back().empty()) files.pop_back();
+        return files;
     }
 
-    explicit EmitCImp(const AstNodeModule* modp, bool slow, std::deque<AstCFile*>& cfilesr)
+    EmitCImp(const AstNodeModule* modp, bool slow, std::deque<AstCFile*>& cfilesr,
+             std::vector<FuncFile>& funcFilesr)
         : m_fileModp{modp}
         , m_slow{slow}
         , m_cfilesr{cfilesr} {
@@ -563,15 +699,30 @@ class EmitCImp final : EmitCFunc {
         // Emit implementations of common parts
         emitCommonImp(modp);
 
-        // Emit implementations of all AstCFunc
-        emitCFuncImp(modp);
+        // Plan files for the implementations of all AstCFunc
+        planCFuncFiles(modp, funcFilesr);
+    }
+    EmitCImp(const AstNodeModule* modp, bool slow, std::deque<AstCFile*>& cfilesr,
+             const FuncFile& funcFile)
+        : m_fileModp{modp}
+        , m_slow{slow}
+        , m_cfilesr{cfilesr} {
+        m_modp = modp;
+        emitCFuncFile(modp, funcFile);
     }
     ~EmitCImp() override = default;
 
 public:
-    static void main(const AstNodeModule* modp, bool slow,
-                     std::deque<AstCFile*>& cfilesr) VL_MT_STABLE {
-        EmitCImp{modp, slow, cfilesr};
+    // Emit the common parts, and return the files needed for the functions
+    static void main(const AstNodeModule* modp, bool slow, std::deque<AstCFile*>& cfilesr,
+                     std::vector<FuncFile>& funcFilesr) VL_MT_STABLE {
+        EmitCImp{modp, slow, cfilesr, funcFilesr};
+    }
+    // Emit one of the files returned by main
+    static void mainFuncFile(const AstNodeModule* modp, bool slow,
+                             std::deque<AstCFile*>& cfilesr,
+                             const FuncFile& funcFile) VL_MT_STABLE {
+        EmitCImp{modp, slow, cfilesr, funcFile};
     }
 };
 
@@ -976,6 +1127,28 @@ public:
     }
 };
 
+//######################################################################
+// Symbol map for --prof-sample, naming the module and source line of each
+// function, as the sampler reports them by their C++ symbol name
+
+static void emitProfSampleMap() {
+    const string filename
+        = v3Global.opt.makeDir() + "/" + v3Global.opt.prefix() + "__prof_sample.map";
+    const std::unique_ptr<std::ofstream> ofp{V3File::new_ofstream(filename)};
+    if (ofp->fail()) v3fatal("Can't write file: " << filename);
+    *ofp << "# Verilator --prof-sample symbol map: function, module, file:line\n";
+    for (AstNode* nodep = v3Global.rootp()->modulesp(); nodep; nodep = nodep->nextp()) {
+        const AstNodeModule* const modp = VN_AS(nodep, NodeModule);
+        modp->foreach([&](const AstCFunc* funcp) {
+            string name = EmitCBaseVisitorConst::funcNameProtect(funcp, modp);
+            if (!funcp->isLoose()) name = EmitCBase::prefixNameProtect(modp) + "::" + name;
+            const FileLine* const flp = funcp->fileline();
+            *ofp << name << "\t" << modp->prettyName() << "\t" << flp->filename() << ":"
+                 << flp->lineno() << "\n";
+        });
+    }
+}
+
 //######################################################################
 // EmitC class functions
 
@@ -983,21 +1156,31 @@ void V3EmitC::emitcImp() {
     UINFO(2, __FUNCTION__ << ":");
     // Make parent module pointers available.
     const EmitCParentModule emitCParentModule;
+    // Per module and slowness: the common part's cfiles, and the planned function
+    // files, each with its cfiles. Kept in order so the file list is deterministic.
+    struct ImpCFiles final {
+        const AstNodeModule* m_modp;
+        bool m_slow;
+        std::deque<AstCFile*> m_cfiles;
+        std::vector<EmitCImp::FuncFile> m_funcFiles;
+        std::deque<std::deque<AstCFile*>> m_funcCfiles;
+    };
+    std::list<ImpCFiles> impCfiles;
     std::list<std::deque<AstCFile*>> cfiles;
     V3ThreadScope threadScope;
 
-    // Process each module in turn
+    // Process each module in turn, the common parts first, while planning the files of
+    // functions, then emit all those files in parallel, as a module can have many
     for (const AstNode* nodep = v3Global.rootp()->modulesp(); nodep; nodep = nodep->nextp()) {
         if (VN_IS(nodep, Class)) continue;  // Imped with ClassPackage
         const AstNodeModule* const modp = VN_AS(nodep, NodeModule);
-        cfiles.emplace_back();
-        auto& slowCfilesr = cfiles.back();
-        threadScope.enqueue(
-            [modp, &slowCfilesr] { EmitCImp::main(modp, /* slow: */ true, slowCfilesr); });
-        cfiles.emplace_back();
-        auto& fastCfilesr = cfiles.back();
-        threadScope.enqueue(
-            [modp, &fastCfilesr] { EmitCImp::main(modp, /* slow: */ false, fastCfilesr); });
+        for (const bool slow : {true, false}) {
+            impCfiles.push_back({modp, slow, {}, {}, {}});
+            ImpCFiles& impr = impCfiles.back();
+            threadScope.enqueue([&impr] {
+                EmitCImp::main(impr.m_modp, impr.m_slow, impr.m_cfiles, impr.m_funcFiles);
+            });
+        }
     }
 
     // Emit trace routines (currently they can only exist in the top module)
@@ -1015,9 +1198,28 @@ void V3EmitC::emitcImp() {
     }
     // Wait for futures
     threadScope.wait();
+    for (ImpCFiles& impr : impCfiles) {
+        for (const EmitCImp::FuncFile& funcFile : impr.m_funcFiles) {
+            impr.m_funcCfiles.emplace_back();
+            std::deque<AstCFile*>& funcCfilesr = impr.m_funcCfiles.back();
+            threadScope.enqueue([&impr, &funcFile, &funcCfilesr] {
+                EmitCImp::mainFuncFile(impr.m_modp, impr.m_slow, funcCfilesr, funcFile);
+            });
+        }
+    }
+    threadScope.wait();
+    for (const ImpCFiles& impr : impCfiles) {
+        for (const auto cfilep : impr.m_cfiles) v3Global.rootp()->addFilesp(cfilep);
+        for (const auto& collr : impr.m_funcCfiles) {
+            for (const auto cfilep : collr) v3Global.rootp()->addFilesp(cfilep);
+        }
+    }
     for (const auto& collr : cfiles) {
         for (const auto cfilep : collr) v3Global.rootp()->addFilesp(cfilep);
     }
+
+    // The map would leak the names hidden by --protect-ids
+    if (v3Global.opt.profSample() && !v3Global.opt.protectIds()) emitProfSampleMap();
 }
 
 void V3EmitC::emitcFiles() {
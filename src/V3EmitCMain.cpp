@@ -76,21 +76,12 @@ private:
              + "{contextp.get(), \"" + topName + "\"}};\n");
         puts("\n");
 
-        puts("// Simulate until $finish\n");
-        puts("while (VL_LIKELY(!contextp->gotFinish())) {\n");
-        puts(/**/ "// Evaluate model\n");
-        puts(/**/ "topp->eval();\n");
-        puts(/**/ "// Advance time\n");
-        if (v3Global.rootp()->delaySchedulerp() || v3Global.opt.timing()) {
-            puts("if (!topp->eventsPending()) break;\n");
-        }
-        if (v3Global.rootp()->delaySchedulerp()) {
-            puts("contextp->time(topp->nextTimeSlot());\n");
-        } else {
-            puts("contextp->timeInc(1);\n");
-        }
-
-        puts("}\n");
+        puts("// Simulate until $finish, evaluating each time slot with pending events\n");
+        puts("// There are no inputs to change, otherwise this is a loop of:\n");
+        puts("//   topp->eval();\n");
+        puts("//   if (!topp->eventsPending()) break;\n");
+        puts("//   contextp->time(topp->nextTimeSlot());\n");
+        puts("topp->evalTimeSlots();\n");
         puts("\n");
 
         puts("if (VL_LIKELY(!contextp->gotFinish())) {\n");
@@ -99,6 +99,16 @@ class EmitCModel final : public EmitCFunc {
 
         puts("// Symbol table holding complete model state (owned by this class)\n");
         puts(symClassName() + "* const vlSymsp;\n");
+        if (v3Global.opt.skipIdleEval()) {
+            puts("// Inputs and signalsWritten() count at last eval(), for --skip-idle-eval\n");
+            for (const AstNode* nodep = modp->stmtsp(); nodep; nodep = nodep->nextp()) {
+                const AstVar* const varp = VN_CAST(nodep, Var);
+                if (!varp || !varp->isPrimaryIO() || !varp->isNonOutput()) continue;
+                puts(varp->dtypep()->cType("__Vm_last__" + varp->nameProtect(), false, false)
+                     + ";\n");
+            }
+            puts("uint64_t __Vm_lastSignalsWritten = 0;\n");
+        }
 
         puts("\n");
         ofp()->putsPrivate(false);  // public:
@@ -200,6 +210,20 @@ class EmitCModel final : public EmitCFunc {
                 puts(";\n");
             }
         }
+        if (!optSystemC()) {
+            puts("/// Run 'cycles' clock cycles, setting 'clk' to 1 then 0, with an eval()\n");
+            puts("/// and a 'halfPeriod' time step after each edge.  If 'samplecb' is given,\n");
+            puts("/// it is called with the cycle count every 'sampleEvery' cycles, and may\n");
+            puts("/// return false to stop.  Returns the number of cycles run, which is\n");
+            puts("/// less than 'cycles' if stopped or after $finish.\n");
+            puts("uint64_t evalCycles(uint64_t cycles, CData& clk, uint64_t halfPeriod = 1,\n");
+            puts("const std::function<bool(uint64_t)>& samplecb = nullptr,\n");
+            puts("uint64_t sampleEvery = 1);\n");
+            puts("/// Run a closed simulation, with no inputs changed by the application:\n");
+            puts("/// eval() in each time slot with pending events, jumping straight to\n");
+            puts("/// the next, until $finish or no events remain.\n");
+            puts("void evalTimeSlots();\n");
+        }
         if (!optSystemC()) {
             puts("/// Simulation complete, run final blocks.  Application "
                  "must call on completion.\n");
@@ -314,6 +338,7 @@ class EmitCModel final : public EmitCFunc {
         puts("{\n");
         puts("// Register model with the context\n");
         puts("contextp()->addModel(this);\n");
+        emitNumaPlacement(modp);
         if (v3Global.opt.trace())
             puts("contextp()->traceBaseModelCbAdd(\n"
                  "[this](VerilatedTraceBaseC* tfp, int levels, int options) {"
@@ -361,6 +386,39 @@ class EmitCModel final : public EmitCFunc {
         }
     }
 
+    void emitNumaPlacement(AstNodeModule* modp) {
+        // V3VariableOrder grouped the variables used by a single worker together
+        std::vector<std::pair<int, std::pair<const AstVar*, const AstVar*>>> ranges;
+        for (const AstNode* nodep = modp->stmtsp(); nodep; nodep = nodep->nextp()) {
+            const AstVar* const varp = VN_CAST(nodep, Var);
+            if (!varp) continue;
+            // Only variables that V3EmitCHeaders declares as members
+            const bool member = varp->isIO() || varp->isSignal() || varp->isClassMember()
+                                || varp->isTemp() || varp->isGenVar();
+            const int owner = member && !varp->isStatic() ? varp->ownerWorker() : -1;
+            if (!ranges.empty() && ranges.back().first == owner) {
+                ranges.back().second.second = varp;
+            } else {
+                ranges.emplace_back(owner, std::make_pair(varp, varp));
+            }
+        }
+        bool first = true;
+        for (const auto& range : ranges) {
+            if (range.first < 0) continue;
+            if (first) {
+                first = false;
+                puts("// Move state used by only one worker to that worker's NUMA node\n");
+                puts("if (VlThreadPool* const poolp = vlSymsp->__Vm_threadPoolp) {\n");
+            }
+            const string firstName = "vlSymsp->TOP." + range.second.first->nameProtect();
+            const string lastName = "vlSymsp->TOP." + range.second.second->nameProtect();
+            puts("poolp->numaPlace(" + cvtToStr(range.first) + ", &" + firstName
+                 + ",\n reinterpret_cast<const char*>(&" + lastName + ") + sizeof(" + lastName
+                 + "));\n");
+        }
+        if (!first) puts("}\n");
+    }
+
     void emitDestructorImplementation() {
         putSectionDelimiter("Destructor");
 
@@ -413,6 +471,8 @@ class EmitCModel final : public EmitCFunc {
         puts("VL_DEBUG_IF(VL_DBG_MSGF(\"+++++TOP Evaluate " + topClassName()
              + "::eval_step\\n\"); );\n");
 
+        if (v3Global.opt.skipIdleEval()) emitSkipIdleEval(modp);
+
         puts("#ifdef VL_DEBUG\n");
         putsDecoration(nullptr, "// Debug assertions\n");
         puts(topModNameProtected + "__" + protect("_eval_debug_assertions")
@@ -444,6 +504,34 @@ class EmitCModel final : public EmitCFunc {
         puts("}\n");
     }
 
+    void emitSkipIdleEval(AstNodeModule* modp) {
+        putsDecoration(nullptr, "// Skip if nothing changed since the last eval(), see "
+                                "--skip-idle-eval\n");
+        puts("const bool changed = VL_UNLIKELY(!vlSymsp->__Vm_didInit)\n");
+        puts("|| __Vm_lastSignalsWritten != contextp()->signalsWrittenCount()");
+        std::vector<const AstVar*> inputs;
+        for (const AstNode* nodep = modp->stmtsp(); nodep; nodep = nodep->nextp()) {
+            const AstVar* const varp = VN_CAST(nodep, Var);
+            if (!varp || !varp->isPrimaryIO() || !varp->isNonOutput()) continue;
+            inputs.push_back(varp);
+            puts("\n|| vlSymsp->TOP." + varp->nameProtect() + " != __Vm_last__"
+                 + varp->nameProtect());
+        }
+        if (const AstVar* const delaySchedp = v3Global.rootp()->delaySchedulerp()) {
+            const string dly = "vlSymsp->TOP." + delaySchedp->nameProtect();
+            puts("\n|| " + dly + ".awaitingCurrentTime()");
+            puts("\n|| (!" + dly + ".empty() && " + dly
+                 + ".nextTimeSlot() <= contextp()->time())");
+        }
+        puts(";\n");
+        puts("if (!changed) return;\n");
+        puts("__Vm_lastSignalsWritten = contextp()->signalsWrittenCount();\n");
+        for (const AstVar* const varp : inputs) {
+            puts("__Vm_last__" + varp->nameProtect() + " = vlSymsp->TOP." + varp->nameProtect()
+                 + ";\n");
+        }
+    }
+
     void emitStandardMethods2(AstNodeModule* modp) {
         const string topModNameProtected = prefixNameProtect(modp);
         const string selfDecl = "(" + topModNameProtected + "* vlSelf)";
@@ -462,6 +550,52 @@ class EmitCModel final : public EmitCFunc {
             puts("}\n");
         }
 
+        // ::evalCycles
+        if (!optSystemC()) {
+            puts("\nuint64_t " + topClassName() + "::evalCycles(uint64_t cycles, CData& clk, "
+                 "uint64_t halfPeriod,\n");
+            puts("const std::function<bool(uint64_t)>& samplecb, uint64_t sampleEvery) {\n");
+            if (v3Global.opt.mtasks()) {
+                putsDecoration(nullptr, "// Keep the workers spinning between cycles\n");
+                puts("vlSymsp->__Vm_threadPoolp->hotBegin();\n");
+            }
+            puts("uint64_t cycle = 0;\n");
+            puts("while (cycle < cycles && !contextp()->gotFinish()) {\n");
+            puts("clk = 1;\n");
+            puts("eval();\n");
+            puts("contextp()->timeInc(halfPeriod);\n");
+            puts("if (VL_UNLIKELY(contextp()->gotFinish())) break;\n");
+            puts("clk = 0;\n");
+            puts("eval();\n");
+            puts("contextp()->timeInc(halfPeriod);\n");
+            puts("++cycle;\n");
+            puts("if (samplecb && sampleEvery && cycle % sampleEvery == 0 && !samplecb(cycle)) "
+                 "break;\n");
+            puts("}\n");
+            if (v3Global.opt.mtasks()) puts("vlSymsp->__Vm_threadPoolp->hotEnd();\n");
+            puts("return cycle;\n");
+            puts("}\n");
+
+            // ::evalTimeSlots
+            puts("\nvoid " + topClassName() + "::evalTimeSlots() {\n");
+            const AstVar* const delaySchedp = v3Global.rootp()->delaySchedulerp();
+            if (delaySchedp) {
+                puts("auto& dlySched = vlSymsp->TOP." + delaySchedp->nameProtect() + ";\n");
+            }
+            puts("while (VL_LIKELY(!contextp()->gotFinish())) {\n");
+            puts("eval();\n");
+            if (delaySchedp) {
+                puts("if (dlySched.empty()) break;\n");
+                puts("contextp()->time(dlySched.nextTimeSlot());\n");
+            } else if (v3Global.opt.timing()) {
+                puts("break;  // No events pending\n");
+            } else {
+                puts("contextp()->timeInc(1);\n");
+            }
+            puts("}\n");
+            puts("}\n");
+        }
+
         putSectionDelimiter("Events and timing");
         if (auto* const delaySchedp = v3Global.rootp()->delaySchedulerp()) {
             putns(modp, "bool " + topClassName() + "::eventsPending() { return !vlSymsp->TOP.");
@@ -683,10 +817,76 @@ class EmitCModel final : public EmitCFunc {
         if (ofp()) closeOutputFile();
     }
 
+    void emitBatchHeader() {
+        UASSERT(!ofp(), "Output file should not be open");
+        const int lanes = v3Global.opt.batchLanes();
+        const string className = topClassName() + "__Batch";
+        const string filename = v3Global.opt.makeDir() + "/" + className + ".h";
+        setOutputFile(new V3OutCFile{filename},
+                      newCFile(filename, /* slow: */ false, /* source: */ false));
+
+        ofp()->putsHeader();
+        puts("// DESCRIPTION: Verilator output: Batch of model lanes evaluated in lockstep\n");
+        puts("//\n");
+        puts("// Holds " + cvtToStr(lanes) + " instances ('lanes') of the model in one\n");
+        puts("// VerilatedContext. The application drives each lane's ports with\n");
+        puts("// independent stimulus, then evaluates all lanes together.\n");
+
+        ofp()->putsGuard();
+
+        puts("\n");
+        puts("#include \"" + topClassName() + ".h\"\n");
+        puts("\n");
+        puts("#include <array>\n");
+        puts("#include <memory>\n");
+        puts("#include <string>\n");
+
+        puts("\nclass " + className + " final {\n");
+        ofp()->resetPrivate();
+        ofp()->putsPrivate(true);  // private:
+        puts("VerilatedContext* const m_contextp;  // Context shared by all lanes\n");
+        puts("std::array<std::unique_ptr<" + topClassName() + ">, " + cvtToStr(lanes)
+             + "> m_lanes;\n");
+        ofp()->putsPrivate(false);  // public:
+        puts("// Number of lanes\n");
+        puts("static constexpr unsigned lanes = " + cvtToStr(lanes) + ";\n");
+        puts("\n// CONSTRUCTORS\n");
+        puts("/// Construct the lanes under the given context; lane N is named\n");
+        puts("/// '<name>__lane<N>'\n");
+        puts("explicit " + className
+             + "(VerilatedContext* contextp, const char* namep = \"TOP\")\n");
+        puts(": m_contextp{contextp} {\n");
+        puts("for (unsigned i = 0; i < lanes; ++i) {\n");
+        puts("const std::string name = std::string{namep} + \"__lane\" + std::to_string(i);\n");
+        puts("m_lanes[i].reset(new " + topClassName() + "{contextp, name.c_str()});\n");
+        puts("}\n");
+        puts("}\n");
+        puts(className + "(const " + className + "&) = delete;\n");
+        puts(className + "& operator=(const " + className + "&) = delete;\n");
+        puts("\n// API METHODS\n");
+        puts("/// Return lane 'index', to access its ports\n");
+        puts(topClassName() + "& lane(unsigned index) { return *m_lanes[index]; }\n");
+        puts("/// Evaluate all lanes, in lane order\n");
+        puts("void eval() {\n");
+        puts("for (const auto& lanep : m_lanes) lanep->eval();\n");
+        puts("}\n");
+        puts("/// Simulation complete, run final blocks of all lanes\n");
+        puts("void final() {\n");
+        puts("for (const auto& lanep : m_lanes) lanep->final();\n");
+        puts("}\n");
+        puts("/// Return the context shared by all lanes\n");
+        puts("VerilatedContext* contextp() const { return m_contextp; }\n");
+        puts("};\n");
+
+        ofp()->putsEndGuard();
+        closeOutputFile();
+    }
+
     void main(AstNodeModule* modp) {
         m_modp = modp;
         emitHeader(modp);
         emitImplementation(modp);
+        if (v3Global.opt.batchLanes()) emitBatchHeader();
         if (v3Global.dpi()) emitDpiExportDispatchers(modp);
     }
 
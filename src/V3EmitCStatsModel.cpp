@@ -0,0 +1,196 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//*************************************************************************
+// DESCRIPTION: Verilator: Emit model memory footprint report
+//
+// Code available from: https://verilator.org
+//
+//*************************************************************************
+//
+// Copyright 2025 by Wilson Snyder. This program is free software; you
+// can redistribute it and/or modify it under the terms of either the GNU
+// Lesser General Public License Version 3 or the Perl Artistic License
+// Version 2.0.
+// SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+//
+//*************************************************************************
+// For --stats-model, write <prefix>__stats_model.json, with estimates of the
+// runtime memory of the model: the bytes of each module and how many
+// instances there are, the arrays and wide members, the trace old value
+// buffer, the constant pool, and the variables and instructions that the
+// fast (eval) code touches. Sizes are the values' storage, without padding
+// or heap allocated contents of dynamic types.
+//*************************************************************************
+
+#include "V3PchAstNoMT.h"  // VL_MT_DISABLED_CODE_UNIT
+
+#include "V3EmitC.h"
+#include "V3File.h"
+#include "V3InstrCount.h"
+
+#include <algorithm>
+#include <map>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+VL_DEFINE_DEBUG_FUNCTIONS;
+
+//######################################################################
+// Model footprint report
+
+class EmitCStatsModel final {
+    // TYPES
+    struct Member final {
+        const AstVar* m_varp;
+        const char* m_kindp;  // "VlUnpacked" or "VlWide"
+        uint64_t m_bytes;
+    };
+    struct ModuleInfo final {
+        uint64_t m_instances = 0;  // Number of instances in the model
+        uint64_t m_bytes = 0;  // Bytes of member variables, per instance
+        std::vector<Member> m_members;  // Array and wide members
+    };
+
+    // STATE
+    std::map<const AstNodeModule*, ModuleInfo> m_modules;  // Per module
+    std::vector<const AstNodeModule*> m_moduleOrder;  // Modules in netlist order
+    std::unordered_map<const AstVar*, const AstNodeModule*> m_varModule;  // Module of member
+
+    // METHODS
+    static uint64_t varBytes(const AstVar* varp) {
+        return static_cast<uint64_t>(varp->dtypeSkipRefp()->widthTotalBytes());
+    }
+    static bool isMember(const AstVar* varp) {
+        return !varp->isParam() && !varp->isStatic() && !varp->isFuncLocal();
+    }
+
+    void gatherModules(AstNetlist* netlistp) {
+        for (AstNode* nodep = netlistp->modulesp(); nodep; nodep = nodep->nextp()) {
+            const AstNodeModule* const modp = VN_AS(nodep, NodeModule);
+            if (VN_IS(modp, Class)) continue;  // Per object, not part of the model
+            m_moduleOrder.push_back(modp);
+            ModuleInfo& info = m_modules[modp];
+            for (const AstNode* stmtp = modp->stmtsp(); stmtp; stmtp = stmtp->nextp()) {
+                const AstVar* const varp = VN_CAST(stmtp, Var);
+                if (!varp || !isMember(varp)) continue;
+                m_varModule.emplace(varp, modp);
+                const uint64_t bytes = varBytes(varp);
+                info.m_bytes += bytes;
+                const AstNodeDType* const dtypep = varp->dtypeSkipRefp();
+                if (VN_IS(dtypep, UnpackArrayDType)) {
+                    info.m_members.push_back({varp, "VlUnpacked", bytes});
+                } else if (dtypep->isWide()) {
+                    info.m_members.push_back({varp, "VlWide", bytes});
+                }
+            }
+            std::stable_sort(
+                info.m_members.begin(), info.m_members.end(),
+                [](const Member& a, const Member& b) { return a.m_bytes > b.m_bytes; });
+        }
+        // Modules are in level order, so instances of parents are known before children
+        for (const AstNodeModule* const modp : m_moduleOrder) {
+            ModuleInfo& info = m_modules[modp];
+            if (modp->isTop() || VN_IS(modp, Package) || VN_IS(modp, ClassPackage)) {
+                info.m_instances = 1;
+            }
+            modp->foreach([&](const AstCell* cellp) {
+                const auto it = m_modules.find(cellp->modp());
+                if (it != m_modules.end()) it->second.m_instances += info.m_instances;
+            });
+        }
+    }
+
+    static uint64_t traceCodes(AstNetlist* netlistp) {
+        uint64_t codes = 0;
+        netlistp->foreach([&](const AstTraceDecl* declp) {
+            codes = std::max<uint64_t>(codes, declp->code() + declp->codeInc());
+        });
+        return codes;
+    }
+
+    static uint64_t constPoolBytes(AstNetlist* netlistp) {
+        uint64_t bytes = 0;
+        const AstModule* const modp = netlistp->constPoolp()->modp();
+        for (const AstNode* nodep = modp->stmtsp(); nodep; nodep = nodep->nextp()) {
+            if (const AstVar* const varp = VN_CAST(nodep, Var)) bytes += varBytes(varp);
+        }
+        return bytes;
+    }
+
+    // Instructions of _eval, and the bytes of the members referenced by the functions it calls
+    void evalWorkingSet(AstNetlist* netlistp, uint64_t& instrr, uint64_t& bytesr) const {
+        AstCFunc* const evalp = netlistp->evalp();
+        if (!evalp) return;
+        instrr = V3InstrCount::count(evalp, false);
+        std::unordered_set<const AstVar*> varps;
+        std::unordered_set<const AstCFunc*> funcps{evalp};
+        std::vector<const AstCFunc*> stack{evalp};
+        while (!stack.empty()) {
+            const AstCFunc* const funcp = stack.back();
+            stack.pop_back();
+            funcp->foreach([&](const AstNodeVarRef* refp) { varps.insert(refp->varp()); });
+            funcp->foreach([&](const AstNodeCCall* callp) {
+                if (funcps.insert(callp->funcp()).second) stack.push_back(callp->funcp());
+            });
+        }
+        for (const AstVar* const varp : varps) {
+            const auto it = m_varModule.find(varp);
+            if (it == m_varModule.end()) continue;  // Local or constant
+            bytesr += varBytes(varp) * m_modules.at(it->second).m_instances;
+        }
+    }
+
+public:
+    explicit EmitCStatsModel(AstNetlist* netlistp) {
+        gatherModules(netlistp);
+
+        const string filename
+            = v3Global.opt.makeDir() + "/" + v3Global.opt.prefix() + "__stats_model.json";
+        V3OutJsonFile of{filename};
+
+        uint64_t totalBytes = 0;
+        of.begin("modules", '[');
+        for (const AstNodeModule* const modp : m_moduleOrder) {
+            const ModuleInfo& info = m_modules.at(modp);
+            totalBytes += info.m_bytes * info.m_instances;
+            of.begin()
+                .put("name", modp->prettyName())
+                .put("instances", info.m_instances)
+                .put("bytes", info.m_bytes)
+                .put("total_bytes", info.m_bytes * info.m_instances);
+            if (!info.m_members.empty()) {
+                of.begin("members", '[');
+                for (const Member& member : info.m_members) {
+                    of.begin()
+                        .put("name", member.m_varp->prettyName())
+                        .put("kind", member.m_kindp)
+                        .put("bytes", member.m_bytes)
+                        .end();
+                }
+                of.end();
+            }
+            of.end();
+        }
+        of.end();
+        of.put("model_bytes", totalBytes);
+
+        const uint64_t codes = traceCodes(netlistp);
+        of.put("trace_codes", codes);
+        of.put("trace_buffer_bytes", codes * 4);  // A uint32_t old value per code
+        of.put("const_pool_bytes", constPoolBytes(netlistp));
+
+        uint64_t evalInstr = 0;
+        uint64_t evalBytes = 0;
+        evalWorkingSet(netlistp, evalInstr, evalBytes);
+        of.put("eval_instr_count", evalInstr);
+        of.put("eval_working_set_bytes", evalBytes);
+    }
+};
+
+//######################################################################
+// EmitC class functions
+
+void V3EmitC::emitcStatsModel() {
+    UINFO(2, __FUNCTION__ << ":");
+    EmitCStatsModel{v3Global.rootp()};
+}
@@ -106,6 +106,7 @@ class EmitCSyms final : EmitCBaseVisitorConst {
     std::vector<ModVarPair> m_modVars;  // Each public {mod,var}
     std::map<const std::string, ScopeFuncData> m_scopeFuncs;  // Each {scope,dpi-export-func}
     std::map<const std::string, ScopeVarData> m_scopeVars;  // Each {scope,public-var}
+    std::set<std::pair<const AstNodeModule*, string>> m_vpiDirtyVars;  // Each {mod,dirty-flag}
     ScopeNames m_scopeNames;  // Each unique AstScopeName. Dpi scopes added later
     ScopeNames m_dpiScopeNames;  // Each unique AstScopeName for DPI export
     ScopeNames m_vpiScopeCandidates;  // All scopes for VPI
@@ -114,6 +115,7 @@ class EmitCSyms final : EmitCBaseVisitorConst {
     const bool m_dpiHdrOnly;  // Only emit the DPI header
     int m_numStmts = 0;  // Number of statements output
     int m_funcNum = 0;  // CFunc split function number
+    std::set<string> m_varInitScopes;  // Scope symbol names with deferred variable registration
     V3OutCFile* m_ofpBase = nullptr;  // Base (not split) C file
     std::unordered_map<int, bool> m_usesVfinal;  // Split method uses __Vfinal
     VDouble0 m_statVarScopeBytes;  // Statistic tracking
@@ -121,10 +123,13 @@ class EmitCSyms final : EmitCBaseVisitorConst {
     // METHODS
     void emitSymHdr();
     void checkSplit(bool usesVfinal);
+    void checkSplitVarInit();
     void closeSplit();
     void emitSymImpPreamble();
     void emitScopeHier(bool destroy);
     void emitSymImp();
+    void emitVarInits();
+    string dpiScopedArgs(const AstCFunc* nodep);
     void emitDpiHdr();
     void emitDpiImp();
 
@@ -369,8 +374,20 @@ class EmitCSyms final : EmitCBaseVisitorConst {
     void visit(AstVar* nodep) override {
         nameCheck(nodep);
         iterateChildrenConst(nodep);
-        if ((nodep->isSigUserRdPublic() || nodep->isSigUserRWPublic()) && !m_cfuncp)
-            m_modVars.emplace_back(m_modp, nodep);
+        if (v3Global.opt.vpiDirty() && VString::endsWith(nodep->name(), "__Vvpidirty")) {
+            m_vpiDirtyVars.emplace(m_modp, nodep->name());
+        }
+        if ((nodep->isSigUserRdPublic() || nodep->isSigUserRWPublic()) && !m_cfuncp) {
+            const AstUnpackArrayDType* const adtypep
+                = VN_CAST(nodep->dtypeSkipRefp(), UnpackArrayDType);
+            if (adtypep && adtypep->isSparse()) {
+                nodep->v3warn(E_UNSUPPORTED, "Unsupported: Public access to array using sparse "
+                                             "storage (see --sparse-array-threshold): "
+                                                 << nodep->prettyNameQ());
+            } else {
+                m_modVars.emplace_back(m_modp, nodep);
+            }
+        }
     }
     void visit(AstVarScope* nodep) override {
         iterateChildrenConst(nodep);
@@ -488,6 +505,11 @@ void EmitCSyms::emitSymHdr() {
         puts("bool __Vm_even_cycle__ico = false;\n");
         puts("bool __Vm_even_cycle__act = false;\n");
         puts("bool __Vm_even_cycle__nba = false;\n");
+        if (v3Global.opt.useThreadsWorkStealing()) {
+            puts("VlMTaskGraph __Vm_mtaskGraph__ico;\n");
+            puts("VlMTaskGraph __Vm_mtaskGraph__act;\n");
+            puts("VlMTaskGraph __Vm_mtaskGraph__nba;\n");
+        }
     }
 
     if (v3Global.opt.profExec()) {
@@ -505,7 +527,12 @@ void EmitCSyms::emitSymHdr() {
         putns(scopep, protectIf(scopep->nameDotless(), scopep->protect()) + ";\n");
     }
 
-    if (m_coverBins) {
+    if (m_coverBins && v3Global.opt.useCoverageShards()) {
+        puts("\n// COVERAGE, one shard per thread, summed by VL_COVER_INSERT_SHARDS\n");
+        puts("struct alignas(VL_CACHE_LINE_BYTES) {\n");
+        puts("uint32_t m_bins[" + cvtToStr(m_coverBins) + "];\n");
+        puts("} __Vcoverage[" + cvtToStr(v3Global.opt.threads()) + "];\n");
+    } else if (m_coverBins) {
         puts("\n// COVERAGE\n");
         puts(v3Global.opt.threads() > 1 ? "std::atomic<uint32_t>" : "uint32_t");
         puts(" __Vcoverage[");
@@ -513,6 +540,11 @@ void EmitCSyms::emitSymHdr() {
         puts("];\n");
     }
 
+    if (v3Global.opt.profEval()) {
+        puts("\n// EVALUATION COUNTERS\n");
+        puts("VlEvalCounters __Vm_evalCounters;\n");
+    }
+
     if (v3Global.opt.profPgo()) {
         puts("\n// PGO PROFILING\n");
         puts("VlPgoProfiler<" + std::to_string(ExecMTask::numUsedIds()) + "> _vm_pgoProfiler;\n");
@@ -535,6 +567,11 @@ void EmitCSyms::emitSymHdr() {
     puts(symClassName() + "(VerilatedContext* contextp, const char* namep, " + topClassName()
          + "* modelp);\n");
     puts("~"s + symClassName() + "();\n");
+    if (v3Global.opt.hugePages()) {
+        puts("// Allocated page aligned, on huge pages when large enough\n");
+        puts("static void* operator new(size_t size) { return VL_HUGE_ALLOC(size); }\n");
+        puts("static void operator delete(void* ptr, size_t size) { VL_HUGE_FREE(ptr, size); }\n");
+    }
 
     for (const auto& i : m_usesVfinal) {
         puts("void " + symClassName() + "_" + cvtToStr(i.first) + "(");
@@ -542,6 +579,10 @@ void EmitCSyms::emitSymHdr() {
         puts(");\n");
     }
 
+    for (const string& symName : m_varInitScopes) {
+        puts("static void " + protect("__Vvarinit_" + symName) + "(VerilatedSyms* symsp);\n");
+    }
+
     puts("\n// METHODS\n");
     puts("const char* name() { return TOP.name(); }\n");
 
@@ -623,6 +664,27 @@ void EmitCSyms::checkSplit(bool usesVfinal) {
     puts(") {\n");
 }
 
+void EmitCSyms::checkSplitVarInit() {
+    // As checkSplit, but the new file holds whole functions, not called from the constructor
+    if (ofp()
+        && (!v3Global.opt.outputSplitCFuncs() || m_numStmts < v3Global.opt.outputSplitCFuncs())) {
+        return;
+    }
+
+    v3Global.useParallelBuild(true);
+
+    m_numStmts = 0;
+    const string filename
+        = v3Global.opt.makeDir() + "/" + symClassName() + "__" + cvtToStr(++m_funcNum) + ".cpp";
+    AstCFile* const cfilep = newCFile(filename, true /*slow*/, true /*source*/);
+    cfilep->support(true);
+    if (ofp() && ofp() != m_ofpBase) closeOutputFile();
+
+    V3OutCFile* const ofilep = optSystemC() ? new V3OutScFile{filename} : new V3OutCFile{filename};
+    setOutputFile(ofilep, cfilep);
+    emitSymImpPreamble();
+}
+
 void EmitCSyms::emitSymImpPreamble() {
     ofp()->putsHeader();
     puts("// DESCR"
@@ -737,6 +799,15 @@ void EmitCSyms::emitSymImp() {
         puts("_vm_pgoProfiler.write(\"" + topClassName()
              + "\", _vm_contextp__->profVltFilename(), " + firstHierCall + ");\n");
     }
+    if (v3Global.opt.profSample()) {
+        puts("VlSampleProfiler::stop(_vm_contextp__->profSampleFilename());\n");
+    }
+    if (v3Global.opt.profEval()) {
+        puts("_vm_contextp__->removeEvalCountersCb(&VlEvalCounters::addCounters, "
+             "&__Vm_evalCounters);\n");
+        puts("__Vm_evalCounters.write(\"" + topClassName()
+             + "\", _vm_contextp__->profEvalFilename());\n");
+    }
     puts("}\n");
 
     if (v3Global.needTraceDumper()) {
@@ -835,6 +906,16 @@ void EmitCSyms::emitSymImp() {
         V3Stats::addStat(V3Stats::STAT_MODEL_SIZE, stackSize + m_statVarScopeBytes);
     }
 
+    if (v3Global.opt.profSample()) {
+        puts("// Start sampling profiler\n");
+        puts("VlSampleProfiler::start();\n");
+    }
+    if (v3Global.opt.profEval()) {
+        puts("// Register evaluation counters\n");
+        puts("__Vm_evalCounters.name(namep);\n");
+        puts("_vm_contextp__->addEvalCountersCb(&VlEvalCounters::addCounters, "
+             "&__Vm_evalCounters);\n");
+    }
     if (v3Global.opt.profPgo()) {
         puts("// Configure profiling for PGO\n");
         if (v3Global.opt.mtasks()) {
@@ -894,6 +975,9 @@ void EmitCSyms::emitSymImp() {
         ++m_numStmts;
     }
 
+    if (v3Global.dpi()) {
+        for (const auto& pair : m_scopeVars) m_varInitScopes.insert(pair.second.m_scopeName);
+    }
     if (!m_scopeNames.empty()) {  // Setup scope names
         puts("// Setup scopes\n");
         for (ScopeNames::iterator it = m_scopeNames.begin(); it != m_scopeNames.end(); ++it) {
@@ -909,6 +993,12 @@ void EmitCSyms::emitSymImp() {
             puts(cvtToStr(it->second.m_timeunit));
             puts(", VerilatedScope::" + it->second.m_type + ");\n");
             ++m_numStmts;
+            if (m_varInitScopes.count(it->second.m_symName)) {
+                // Variables are registered on first lookup, see emitVarInits
+                puts(protect("__Vscope_" + it->second.m_symName) + ".varInit(&" + symClassName()
+                     + "::" + protect("__Vvarinit_" + it->second.m_symName) + ");\n");
+                ++m_numStmts;
+            }
         }
     }
 
@@ -937,93 +1027,127 @@ void EmitCSyms::emitSymImp() {
                 ++m_numStmts;
             }
         }
-        // It would be less code if each module inserted its own variables.
-        // Someday.  For now public isn't common.
-        for (auto it = m_scopeVars.begin(); it != m_scopeVars.end(); ++it) {
-            checkSplit(true);
-            AstScope* const scopep = it->second.m_scopep;
-            AstVar* const varp = it->second.m_varp;
-            int pdim = 0;
-            int udim = 0;
-            string bounds;
-            if (AstBasicDType* const basicp = varp->basicp()) {
-                // Range is always first, it's not in "C" order
-                for (AstNodeDType* dtypep = varp->dtypep(); dtypep;) {
-                    dtypep
-                        = dtypep->skipRefp();  // Skip AstRefDType/AstTypedef, or return same node
-                    if (const AstNodeArrayDType* const adtypep = VN_CAST(dtypep, NodeArrayDType)) {
+        m_ofpBase->puts("}\n");
+    }
+
+    m_ofpBase->puts("}\n");
+
+    closeSplit();
+    emitVarInits();
+    if (ofp() && ofp() != m_ofpBase) closeOutputFile();
+    setOutputFile(nullptr);
+    VL_DO_CLEAR(delete m_ofpBase, m_ofpBase = nullptr);
+}
+
+void EmitCSyms::emitVarInits() {
+    // Each scope's public variables are inserted by a function the scope
+    // calls when its variables are first searched, so model construction
+    // does not build every variable map.
+    string lastScopeName;
+    for (auto it = m_scopeVars.begin(); it != m_scopeVars.end(); ++it) {
+        if (!m_varInitScopes.count(it->second.m_scopeName)) continue;
+        if (it->second.m_scopeName != lastScopeName) {
+            if (!lastScopeName.empty()) puts("}\n");
+            lastScopeName = it->second.m_scopeName;
+            checkSplitVarInit();
+            puts("\nvoid " + symClassName() + "::" + protect("__Vvarinit_" + lastScopeName)
+                 + "(VerilatedSyms* symsp) {\n");
+            puts(symClassName() + "* const vlSymsp = static_cast<" + symClassName()
+                 + "*>(symsp);\n");
+        }
+        AstScope* const scopep = it->second.m_scopep;
+        AstVar* const varp = it->second.m_varp;
+        int pdim = 0;
+        int udim = 0;
+        string bounds;
+        if (AstBasicDType* const basicp = varp->basicp()) {
+            // Range is always first, it's not in "C" order
+            for (AstNodeDType* dtypep = varp->dtypep(); dtypep;) {
+                dtypep = dtypep->skipRefp();  // Skip AstRefDType/AstTypedef, or return same node
+                if (const AstNodeArrayDType* const adtypep = VN_CAST(dtypep, NodeArrayDType)) {
+                    bounds += " ,";
+                    bounds += cvtToStr(adtypep->left());
+                    bounds += ",";
+                    bounds += cvtToStr(adtypep->right());
+                    if (VN_IS(dtypep, PackArrayDType))
+                        pdim++;
+                    else
+                        udim++;
+                    dtypep = adtypep->subDTypep();
+                } else {
+                    if (basicp->isRanged()) {
                         bounds += " ,";
-                        bounds += cvtToStr(adtypep->left());
+                        bounds += cvtToStr(basicp->left());
                         bounds += ",";
-                        bounds += cvtToStr(adtypep->right());
-                        if (VN_IS(dtypep, PackArrayDType))
-                            pdim++;
-                        else
-                            udim++;
-                        dtypep = adtypep->subDTypep();
-                    } else {
-                        if (basicp->isRanged()) {
-                            bounds += " ,";
-                            bounds += cvtToStr(basicp->left());
-                            bounds += ",";
-                            bounds += cvtToStr(basicp->right());
-                            pdim++;
-                        }
-                        break;  // AstBasicDType - nothing below, 1
+                        bounds += cvtToStr(basicp->right());
+                        pdim++;
                     }
+                    break;  // AstBasicDType - nothing below, 1
                 }
             }
+        }
 
-            putns(scopep, protect("__Vscope_" + it->second.m_scopeName));
-            putns(varp, ".varInsert(__Vfinal,");
-            putsQuoted(protect(it->second.m_varBasePretty));
+        putns(scopep, "vlSymsp->" + protect("__Vscope_" + it->second.m_scopeName));
+        putns(varp, ".varInsert(1,");
+        putsQuoted(protect(it->second.m_varBasePretty));
 
-            std::string varName;
-            varName += protectIf(scopep->nameDotless(), scopep->protect()) + ".";
-            varName += protect(varp->name());
+        std::string varName;
+        varName += "vlSymsp->" + protectIf(scopep->nameDotless(), scopep->protect()) + ".";
+        varName += protect(varp->name());
 
-            if (varp->isParam()) {
-                if (varp->vlEnumType() == "VLVT_STRING"
-                    && !VN_IS(varp->subDTypep(), UnpackArrayDType)) {
-                    puts(", const_cast<void*>(static_cast<const void*>(");
-                    puts(varName);
-                    puts(".c_str())), ");
-                } else {
-                    puts(", const_cast<void*>(static_cast<const void*>(&(");
-                    puts(varName);
-                    puts("))), ");
-                }
+        if (varp->isParam()) {
+            if (varp->vlEnumType() == "VLVT_STRING"
+                && !VN_IS(varp->subDTypep(), UnpackArrayDType)) {
+                puts(", const_cast<void*>(static_cast<const void*>(");
+                puts(varName);
+                puts(".c_str())), ");
             } else {
-                puts(", &(");
+                puts(", const_cast<void*>(static_cast<const void*>(&(");
                 puts(varName);
-                puts("), ");
+                puts("))), ");
             }
+        } else {
+            puts(", &(");
+            puts(varName);
+            puts("), ");
+        }
 
-            puts(varp->isParam() ? "true" : "false");
-            puts(", ");
-            puts(varp->vlEnumType());  // VLVT_UINT32 etc
-            puts(",");
-            puts(varp->vlEnumDir());  // VLVD_IN etc
-            puts(",");
-            puts(cvtToStr(udim));
-            puts(",");
-            puts(cvtToStr(pdim));
-            puts(bounds);
-            puts(");\n");
+        puts(varp->isParam() ? "true" : "false");
+        puts(", ");
+        puts(varp->vlEnumType());  // VLVT_UINT32 etc
+        puts(",");
+        puts(varp->vlEnumDir());  // VLVD_IN etc
+        puts(",");
+        puts(cvtToStr(udim));
+        puts(",");
+        puts(cvtToStr(pdim));
+        puts(bounds);
+        puts(");\n");
+        ++m_numStmts;
+
+        const string dirtyName = varp->name() + "__Vvpidirty";
+        if (m_vpiDirtyVars.count({scopep->modp(), dirtyName})) {
+            putns(scopep, "vlSymsp->" + protect("__Vscope_" + it->second.m_scopeName));
+            putns(varp, ".varDirty(1, ");
+            putsQuoted(protect(it->second.m_varBasePretty));
+            puts(", &(");
+            puts("vlSymsp->" + protectIf(scopep->nameDotless(), scopep->protect()) + ".");
+            puts(protect(dirtyName));
+            puts("));\n");
             ++m_numStmts;
         }
-        m_ofpBase->puts("}\n");
     }
-
-    m_ofpBase->puts("}\n");
-
-    closeSplit();
-    setOutputFile(nullptr);
-    VL_DO_CLEAR(delete m_ofpBase, m_ofpBase = nullptr);
+    if (!lastScopeName.empty()) puts("}\n");
 }
 
 //######################################################################
 
+string EmitCSyms::dpiScopedArgs(const AstCFunc* nodep) {
+    // Arguments of the __Vscope variant of an export, after the scope
+    const string args = cFuncArgs(nodep);
+    return args.empty() ? "" : ", " + args;
+}
+
 void EmitCSyms::emitDpiHdr() {
     UINFO(6, __FUNCTION__ << ": ");
     const string filename = v3Global.opt.makeDir() + "/" + topClassName() + "__Dpi.h";
@@ -1059,6 +1183,10 @@ void EmitCSyms::emitDpiHdr() {
                                       + ifNoProtect(" at " + nodep->fileline()->ascii()) + "\n");
             putns(nodep, "extern " + nodep->rtnTypeVoid() + " " + nodep->nameProtect() + "("
                              + cFuncArgs(nodep) + ");\n");
+            putsDecoration(nodep, "// DPI export in the given scope, without svSetScope"
+                                  " (Verilator extension)\n");
+            putns(nodep, "extern " + nodep->rtnTypeVoid() + " " + nodep->nameProtect()
+                             + "__Vscope(const svScope scope" + dpiScopedArgs(nodep) + ");\n");
         } else if (nodep->dpiImportPrototype()) {
             if (!firstImp++) puts("\n// DPI IMPORTS\n");
             putsDecoration(nodep, "// DPI import"
@@ -1111,21 +1239,26 @@ void EmitCSyms::emitDpiImp() {
             // Prevent multi-definition if used by multiple models
             puts("#ifndef VL_DPIDECL_" + nodep->name() + "_\n");
             puts("#define VL_DPIDECL_" + nodep->name() + "_\n");
-            putns(nodep,
-                  nodep->rtnTypeVoid() + " " + nodep->name() + "(" + cFuncArgs(nodep) + ") {\n");
-            puts("// DPI export" + ifNoProtect(" at " + nodep->fileline()->ascii()) + "\n");
-            putns(nodep, "return " + topClassName() + "::" + nodep->name() + "(");
-            string comma;
+            string callArgs;
             for (AstNode* stmtp = nodep->argsp(); stmtp; stmtp = stmtp->nextp()) {
                 if (const AstVar* const portp = VN_CAST(stmtp, Var)) {
                     if (portp->isIO() && !portp->isFuncReturn()) {
-                        puts(comma);
-                        comma = ", ";
-                        putns(portp, portp->name());
+                        if (!callArgs.empty()) callArgs += ", ";
+                        callArgs += portp->name();
                     }
                 }
             }
-            puts(");\n");
+            const string callp = "return " + topClassName() + "::" + nodep->name() + "(";
+            putns(nodep,
+                  nodep->rtnTypeVoid() + " " + nodep->name() + "(" + cFuncArgs(nodep) + ") {\n");
+            puts("// DPI export" + ifNoProtect(" at " + nodep->fileline()->ascii()) + "\n");
+            putns(nodep, callp + callArgs + ");\n");
+            puts("}\n");
+            // Scope is set directly, as a scope from svGetScopeFromName is already resolved
+            putns(nodep, nodep->rtnTypeVoid() + " " + nodep->name()
+                             + "__Vscope(const svScope scope" + dpiScopedArgs(nodep) + ") {\n");
+            puts("Verilated::dpiScope(static_cast<const VerilatedScope*>(scope));\n");
+            putns(nodep, callp + callArgs + ");\n");
             puts("}\n");
             puts("#endif\n");
             puts("\n");
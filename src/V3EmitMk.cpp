@@ -182,13 +182,22 @@ private:
         const int totalBucketsNum = v3Global.opt.outputGroups();
         // Return early if there's nothing to do.
         bool groupingRedundant = false;
-        if (inputFilesCount < MIN_FILES_COUNT
-            && inputFilesCount <= static_cast<size_t>(totalBucketsNum)) {
+        if (v3Global.opt.outputGroupsUser()) {
+            // An explicitly requested number of groups is honored even for small models, where
+            // reparsing the shared headers in each file dominates the compile time
+            if (inputFilesCount <= static_cast<size_t>(totalBucketsNum)) {
+                UINFO(4, "File concatenation skipped: Not more files than groups ("
+                             << m_inputFiles.size() << " <= " << totalBucketsNum << ")");
+                groupingRedundant = true;
+            }
+        } else if (inputFilesCount < MIN_FILES_COUNT
+                   && inputFilesCount <= static_cast<size_t>(totalBucketsNum)) {
             UINFO(4, "File concatenation skipped: Too few files (" << m_inputFiles.size() << " < "
                                                                    << MIN_FILES_COUNT << ")");
             groupingRedundant = true;
         }
-        if (inputFilesCount < (MIN_FILES_PER_BUCKET * totalBucketsNum)) {
+        if (!v3Global.opt.outputGroupsUser()
+            && inputFilesCount < (MIN_FILES_PER_BUCKET * totalBucketsNum)) {
             UINFO(4, "File concatenation skipped: Too few files per bucket ("
                          << m_inputFiles.size() << " < " << MIN_FILES_PER_BUCKET << " - "
                          << totalBucketsNum << ")");
@@ -506,17 +515,23 @@ public:
             std::vector<FilenameWithScore> fastFiles;
             uint64_t slowTotalScore = 0;
             uint64_t fastTotalScore = 0;
+            std::vector<string> hotColdFiles;
 
             for (AstNodeFile* nodep = v3Global.rootp()->filesp(); nodep;
                  nodep = VN_AS(nodep->nextp(), NodeFile)) {
                 const AstCFile* const cfilep = VN_CAST(nodep, CFile);
                 if (cfilep && cfilep->source() && cfilep->support() == false) {
+                    // Profile-guided hot and cold files are compiled with their own flags
+                    const string name = V3Os::filenameNonDirExt(cfilep->name());
+                    if (VString::endsWith(name, "__Hot") || VString::endsWith(name, "__Cold")) {
+                        hotColdFiles.push_back(name);
+                        continue;
+                    }
                     std::vector<FilenameWithScore>& files = cfilep->slow() ? slowFiles : fastFiles;
                     uint64_t& totalScore = cfilep->slow() ? slowTotalScore : fastTotalScore;
 
                     totalScore += cfilep->complexityScore();
-                    files.push_back(
-                        {V3Os::filenameNonDirExt(cfilep->name()), cfilep->complexityScore()});
+                    files.push_back({name, cfilep->complexityScore()});
                 }
             }
 
@@ -524,6 +539,7 @@ public:
                 std::move(slowFiles), slowTotalScore, "vm_classes_Slow_");
             vmClassesFastList = EmitGroup::singleConcatenatedFilesList(
                 std::move(fastFiles), fastTotalScore, "vm_classes_");
+            for (const string& name : hotColdFiles) vmClassesFastList.push_back({name, {}});
         }
 
         // Generate the makefile
@@ -551,10 +567,15 @@ public:
         of.puts("VM_PARALLEL_BUILDS = ");
         of.puts(v3Global.useParallelBuild() ? "1" : "0");
         of.puts("\n");
-        of.puts("# Tracing output mode?  0/1 (from --trace-fst/--trace-saif/--trace-vcd)\n");
+        of.puts("# Tracing output mode?  0/1"
+                " (from --trace-bin/--trace-fst/--trace-saif/--trace-vcd)\n");
         of.puts("VM_TRACE = ");
         of.puts(v3Global.opt.trace() ? "1" : "0");
         of.puts("\n");
+        of.puts("# Tracing output mode in binary format?  0/1 (from --trace-bin)\n");
+        of.puts("VM_TRACE_BIN = ");
+        of.puts(v3Global.opt.traceEnabledBin() ? "1" : "0");
+        of.puts("\n");
         of.puts("# Tracing output mode in FST format?  0/1 (from --trace-fst)\n");
         of.puts("VM_TRACE_FST = ");
         of.puts(v3Global.opt.traceEnabledFst() ? "1" : "0");
@@ -663,6 +684,8 @@ public:
         of.puts("\n### Switches...\n");
         of.puts("# C++ code coverage  0/1 (from --prof-c)\n");
         of.putSet("VM_PROFC", ((v3Global.opt.profC()) ? "1" : "0"));
+        of.puts("# Sampling profiler  0/1 (from --prof-sample)\n");
+        of.putSet("VM_PROF_SAMPLE", ((v3Global.opt.profSample()) ? "1" : "0"));
         of.puts("# SystemC output mode?  0/1 (from --sc)\n");
         of.putSet("VM_SC", ((v3Global.opt.systemC()) ? "1" : "0"));
         of.puts("# Legacy or SystemC output mode?  0/1 (from --sc)\n");
@@ -851,8 +874,14 @@ class EmitMkHierVerilation final {
         }
         of.puts("\n");
 
-        // Build hierarchical libraries as soon as possible to get maximum parallelism
-        of.puts("hier_build: $(VM_HIER_LIBS) " + v3Global.opt.prefix() + ".mk\n");
+        // Build hierarchical libraries as soon as possible to get maximum parallelism.
+        // Make starts prerequisites in order, so list the blocks on the longest chains of
+        // dependent Verilations first, so large blocks are not started last.
+        of.puts("hier_build:");
+        for (const V3HierBlock* const blockp : m_planp->hierBlocksScheduled()) {
+            of.puts(" " + blockp->hierLibFilename(true));
+        }
+        of.puts(" " + v3Global.opt.prefix() + ".mk\n");
         of.puts("\t$(MAKE) -f " + v3Global.opt.prefix() + ".mk\n");
         of.puts("hier_verilation: " + v3Global.opt.prefix() + ".mk\n");
         emitCommonOpts(of);
@@ -871,7 +900,9 @@ class EmitMkHierVerilation final {
             of.puts(v3Global.opt.prefix()
                     + ".mk: $(VM_HIER_INPUT_FILES) $(VM_HIER_VERILOG_LIBS) ");
             of.puts(V3Os::filenameNonDir(argsFile) + " ");
-            for (const auto& itr : *m_planp) of.puts(itr.second->hierWrapperFilename(true) + " ");
+            for (const V3HierBlock* const blockp : m_planp->hierBlocksScheduled()) {
+                of.puts(blockp->hierWrapperFilename(true) + " ");
+            }
             of.puts("\n");
             emitLaunchVerilator(of, argsFile);
         }
@@ -904,6 +935,16 @@ class EmitMkHierVerilation final {
             }
             of.puts("\n\t$(MAKE) -f " + blockp->hierMkFilename(false) + " -C " + prefix);
             of.puts(" VM_PREFIX=" + prefix);
+            if (!v3Global.opt.hierCache().empty()) {
+                // Add the library to the cache entry the Verilation recorded, if any
+                const string libFilename = blockp->hierLibFilename(true);
+                const string libNonDir = V3Os::filenameNonDir(libFilename);
+                const string tmpFilename = "\"$$d/" + libNonDir + ".tmp$$$$\"";
+                const string entryFilename = prefix + "/" + prefix + "__hierCache.txt";
+                of.puts("\n\t-@if [ -f " + entryFilename + " ]; then d=`cat " + entryFilename
+                        + "` && cp " + libFilename + " " + tmpFilename + " && mv -f "
+                        + tmpFilename + " \"$$d/" + libNonDir + "\"; fi");
+            }
             of.puts("\n\n");
         }
         of.puts("endif  # Guard\n");
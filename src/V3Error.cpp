@@ -263,7 +263,7 @@ void V3ErrorGuarded::v3errorEndGuts(std::ostringstream& sstr, const string& extr
             if (!inFatal) {
                 inFatal = true;
 #ifndef V3ERROR_NO_GLOBAL_
-                if (dumpTreeLevel() || dumpTreeJsonLevel() || debug()) {
+                if (v3Global.rootp() && (dumpTreeLevel() || dumpTreeJsonLevel() || debug())) {
                     V3Broken::allowMidvisitorCheck(true);
                     if (dumpTreeLevel()) {
                         v3Global.rootp()->dumpTreeFile(v3Global.debugFilename("final.tree", 990));
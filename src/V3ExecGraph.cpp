@@ -29,6 +29,7 @@
 
 #include <memory>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 VL_DEFINE_DEBUG_FUNCTIONS;
@@ -308,6 +309,53 @@ public:
     }
     bool contains(const ExecMTask* mtaskp) const { return mtasks.count(mtaskp); }
     uint32_t endTime() const { return m_endTime; }
+
+    // Renumber the threads, so the ones with the most dependencies between them get adjacent
+    // numbers, and so adjacent pool workers, which VlThreadPool places on a shared cache.
+    // The last thread runs on the eval thread, so keeps its place, and starts the chain.
+    void orderByCommunication() {
+        std::vector<uint32_t> used;  // Non-empty threads, in order
+        for (uint32_t i = 0; i < threads.size(); ++i) {
+            if (!threads[i].empty()) used.push_back(i);
+        }
+        if (used.size() < 3) return;
+        // Dependencies between each pair of threads
+        std::vector<std::vector<uint32_t>> deps(threads.size(),
+                                                std::vector<uint32_t>(threads.size(), 0));
+        for (const ExecMTask* const mtaskp : mtasks) {
+            for (const V3GraphEdge& edge : mtaskp->inEdges()) {
+                const ExecMTask* const prevp = edge.fromp()->as<ExecMTask>();
+                if (!contains(prevp)) continue;
+                ++deps[threadId(prevp)][threadId(mtaskp)];
+                ++deps[threadId(mtaskp)][threadId(prevp)];
+            }
+        }
+        // Greedily append the thread with the most dependencies on those already placed
+        std::vector<uint32_t> weight(threads.size(), 0);
+        std::vector<uint32_t> order;
+        std::vector<uint32_t> unplaced(used.begin(), used.end() - 1);
+        uint32_t lastId = used.back();
+        while (!unplaced.empty()) {
+            for (const uint32_t i : unplaced) weight[i] += deps[lastId][i];
+            auto bestit = unplaced.begin();
+            for (auto it = unplaced.begin(); it != unplaced.end(); ++it) {
+                if (weight[*it] > weight[*bestit]) bestit = it;
+            }
+            lastId = *bestit;
+            order.push_back(lastId);
+            unplaced.erase(bestit);
+        }
+        order.push_back(used.back());
+        // Move the threads to their new numbers
+        std::vector<std::vector<const ExecMTask*>> newThreads(threads.size());
+        for (uint32_t n = 0; n < order.size(); ++n) {
+            newThreads[used[n]] = std::move(threads[order[n]]);
+            for (const ExecMTask* const mtaskp : newThreads[used[n]]) {
+                mtaskState[mtaskp].threadId = used[n];
+            }
+        }
+        threads = std::move(newThreads);
+    }
 };
 
 uint32_t ThreadSchedule::s_nextId = 0;
@@ -730,7 +778,9 @@ public:
     }
 
     static std::vector<ThreadSchedule> apply(V3Graph& mtaskGraph) {
-        return PackThreads{}.pack(mtaskGraph);
+        std::vector<ThreadSchedule> schedules = PackThreads{}.pack(mtaskGraph);
+        for (ThreadSchedule& schedule : schedules) schedule.orderByCommunication();
+        return schedules;
     }
 };
 
@@ -940,6 +990,7 @@ void addMTaskToFunction(const ThreadSchedule& schedule, const uint32_t threadId,
         addStrStmt("vlSymsp->_vm_pgoProfiler.startCounter(" + std::to_string(mtaskp->id())
                    + ");\n");
     }
+    if (v3Global.opt.profEval()) addStrStmt("vlSymsp->__Vm_evalCounters.mtask();\n");
 
     // Move the actual body into this function
     funcp->addStmtsp(mtaskp->bodyp()->unlinkFrBack());
@@ -984,6 +1035,11 @@ const std::vector<AstCFunc*> createThreadFunctions(const ThreadSchedule& schedul
         // Setup vlSelf and vlSyms
         funcp->addStmtsp(new AstCStmt{fl, EmitCBase::voidSelfAssign(modp)});
         funcp->addStmtsp(new AstCStmt{fl, EmitCBase::symClassAssign()});
+        if (v3Global.opt.useCoverageShards()) {
+            // Selects this thread's coverage counters
+            funcp->addStmtsp(
+                new AstCStmt{fl, "Verilated::threadIndex(" + cvtToStr(threadId) + ");\n"});
+        }
 
         // Invoke each mtask scheduled to this thread from the thread function
         for (const ExecMTask* const mtaskp : thread) {
@@ -1037,6 +1093,7 @@ void addThreadEndWrapper(AstExecGraph* const execGraphp) {
     };
 
     addStrStmt("Verilated::mtaskId(0);\n");
+    if (v3Global.opt.useCoverageShards()) addStrStmt("Verilated::threadIndex(0);\n");
     if (v3Global.opt.profExec()) {
         addStrStmt("VL_EXEC_TRACE_ADD_RECORD(vlSymsp).execGraphEnd();\n");
     }
@@ -1061,6 +1118,8 @@ void addThreadStartToExecGraph(AstExecGraph* const execGraphp,
             "for (size_t i = 0; i < " + cvtToStr(last)
             + "; ++i) indexes.push_back(vlSymsp->__Vm_threadPoolp->assignWorkerIndex());\n");
     }
+    // Keep evaluations sharing the thread pool in the same order on every worker
+    if (last > 0) addStrStmt("vlSymsp->__Vm_threadPoolp->enqueueBegin();\n");
     uint32_t i = 0;
     for (AstCFunc* const funcp : funcps) {
         if (i != last) {
@@ -1072,7 +1131,9 @@ void addThreadStartToExecGraph(AstExecGraph* const execGraphp,
                 addTextStmt("vlSymsp->__Vm_threadPoolp->workerp(" + cvtToStr(i) + ")->addTask(");
             }
             execGraphp->addStmtsp(new AstAddrOfCFunc{fl, funcp});
-            addTextStmt(", vlSelf, vlSymsp->__Vm_even_cycle__" + tag + ");\n");
+            addTextStmt(", vlSelf, vlSymsp->__Vm_even_cycle__" + tag
+                        + ", vlSymsp->_vm_contextp__);\n");
+            if (i + 1 == last) addStrStmt("vlSymsp->__Vm_threadPoolp->enqueueEnd();\n");
         } else {
             // The last will run on the main thread.
             AstCCall* const callp = new AstCCall{fl, funcp};
@@ -1151,6 +1212,82 @@ void wrapMTaskBodies(AstExecGraph* const execGraphp) {
     }
 }
 
+// Classes of functions based on the profiled cost of the MTasks calling them
+enum : uint8_t { PROF_HOT = 1, PROF_NORMAL = 2, PROF_COLD = 4 };
+using ProfClasses = std::unordered_map<AstCFunc*, uint8_t>;
+
+void classifyMTaskFuncs(AstExecGraph* const execGraphp, ProfClasses& classes) {
+    // The hottest MTasks taking half of the time are hot, the ones taking the last 1% are cold
+    std::vector<AstMTaskBody*> bodyps;
+    uint64_t total = 0;
+    for (AstMTaskBody* mtaskBodyp = execGraphp->mTaskBodiesp(); mtaskBodyp;
+         mtaskBodyp = VN_AS(mtaskBodyp->nextp(), MTaskBody)) {
+        bodyps.push_back(mtaskBodyp);
+        total += mtaskBodyp->execMTaskp()->cost();
+    }
+    std::stable_sort(bodyps.begin(), bodyps.end(), [](AstMTaskBody* ap, AstMTaskBody* bp) {
+        return ap->execMTaskp()->cost() > bp->execMTaskp()->cost();
+    });
+    uint64_t sum = 0;
+    for (AstMTaskBody* const mtaskBodyp : bodyps) {
+        const uint8_t cls = sum < total / 2                 ? PROF_HOT
+                            : sum >= total - total / 100 ? PROF_COLD
+                                                         : PROF_NORMAL;
+        sum += mtaskBodyp->execMTaskp()->cost();
+        // After wrapMTaskBodies, the body is a call to the MTask function
+        mtaskBodyp->foreach([&](AstNodeCCall* callp) { classes[callp->funcp()] = cls; });
+    }
+}
+
+void markHotColdFuncs(AstNetlist* netlistp, const ProfClasses& mtaskClasses) {
+    ProfClasses reached;  // Classes of MTasks reaching each function
+    std::vector<std::pair<AstCFunc*, uint8_t>> stack;
+    const auto propagate = [&]() {
+        while (!stack.empty()) {
+            AstCFunc* const funcp = stack.back().first;
+            const uint8_t cls = stack.back().second;
+            stack.pop_back();
+            uint8_t& bits = reached[funcp];
+            if (bits & cls) continue;
+            bits |= cls;
+            funcp->foreach([&](AstNodeCCall* callp) {
+                if (!mtaskClasses.count(callp->funcp())) stack.emplace_back(callp->funcp(), cls);
+            });
+        }
+    };
+    for (const auto& pair : mtaskClasses) stack.emplace_back(pair.first, pair.second);
+    propagate();
+    // Functions also called from outside the MTasks are normal, unless only from slow code
+    const std::unordered_set<AstCFunc*> fromMTasks = [&]() {
+        std::unordered_set<AstCFunc*> funcps;
+        for (const auto& pair : reached) funcps.insert(pair.first);
+        return funcps;
+    }();
+    netlistp->foreach([&](AstCFunc* funcp) {
+        if (funcp->slow() || fromMTasks.count(funcp) || mtaskClasses.count(funcp)) return;
+        funcp->foreach([&](AstNodeCCall* callp) {
+            if (fromMTasks.count(callp->funcp()) && !mtaskClasses.count(callp->funcp())) {
+                stack.emplace_back(callp->funcp(), PROF_NORMAL);
+            }
+        });
+    });
+    propagate();
+    size_t hot = 0;
+    size_t cold = 0;
+    for (const auto& pair : reached) {
+        if (pair.first->slow()) continue;
+        if (pair.second & PROF_HOT) {
+            pair.first->hot(true);
+            ++hot;
+        } else if (pair.second == PROF_COLD) {
+            pair.first->cold(true);
+            ++cold;
+        }
+    }
+    V3Stats::addStat("Optimizations, Profile-guided hot functions", hot);
+    V3Stats::addStat("Optimizations, Profile-guided cold functions", cold);
+}
+
 void implementExecGraph(AstExecGraph* const execGraphp, const ThreadSchedule& schedule) {
     // Nothing to be done if there are no MTasks in the graph at all.
     if (execGraphp->depGraphp()->empty()) return;
@@ -1164,8 +1301,131 @@ void implementExecGraph(AstExecGraph* const execGraphp, const ThreadSchedule& sc
     addThreadStartToExecGraph(execGraphp, funcps, schedule.id());
 }
 
+void implementExecGraphWorkStealing(AstExecGraph* const execGraphp,
+                                    const ThreadSchedule& schedule) {
+    // Nothing to be done if there are no MTasks in the graph at all.
+    if (execGraphp->depGraphp()->empty()) return;
+
+    AstNodeModule* const modp = v3Global.rootp()->topModulep();
+    FileLine* const fl = modp->fileline();
+    const string& tag = execGraphp->name();
+
+    const auto addStrStmt = [=](const string& stmt) -> void {  //
+        execGraphp->addStmtsp(new AstCStmt{fl, stmt});
+    };
+    const auto addTextStmt = [=](const string& text) -> void {
+        execGraphp->addStmtsp(new AstText{fl, text, /* tracking: */ true});
+    };
+
+    // Number the MTasks densely for the run-time tables, in static schedule order
+    std::vector<const ExecMTask*> mtasks;
+    std::unordered_map<const ExecMTask*, uint32_t> indexes;
+    for (const std::vector<const ExecMTask*>& thread : schedule.threads) {
+        for (const ExecMTask* const mtaskp : thread) {
+            indexes.emplace(mtaskp, static_cast<uint32_t>(mtasks.size()));
+            mtasks.push_back(mtaskp);
+        }
+    }
+
+    // Create a function for each MTask, the run-time picks which thread calls it
+    std::vector<AstCFunc*> funcps;
+    for (const ExecMTask* const mtaskp : mtasks) {
+        const string name{"__Vmtask__" + tag + "__s" + cvtToStr(schedule.id()) + "__"
+                          + cvtToStr(mtaskp->id())};
+        AstCFunc* const funcp = new AstCFunc{fl, name, nullptr, "void"};
+        modp->addStmtsp(funcp);
+        funcps.push_back(funcp);
+        funcp->isStatic(true);  // Uses void self pointer, so static and hand rolled
+        funcp->isLoose(true);
+        funcp->entryPoint(true);
+        funcp->argTypes("void* voidSelf, bool even_cycle");
+
+        funcp->addStmtsp(new AstCStmt{fl, EmitCBase::voidSelfAssign(modp)});
+        funcp->addStmtsp(new AstCStmt{fl, EmitCBase::symClassAssign()});
+        if (v3Global.opt.profPgo()) {
+            funcp->addStmtsp(new AstCStmt{fl, "vlSymsp->_vm_pgoProfiler.startCounter("
+                                                  + std::to_string(mtaskp->id()) + ");\n"});
+        }
+        if (v3Global.opt.profEval()) {
+            funcp->addStmtsp(new AstCStmt{fl, "vlSymsp->__Vm_evalCounters.mtask();\n"});
+        }
+        funcp->addStmtsp(mtaskp->bodyp()->unlinkFrBack());
+        if (v3Global.opt.profPgo()) {
+            funcp->addStmtsp(new AstCStmt{fl, "vlSymsp->_vm_pgoProfiler.stopCounter("
+                                                  + std::to_string(mtaskp->id()) + ");\n"});
+        }
+    }
+
+    // Emit the static tables describing the graph
+    addStrStmt("{\n");
+    std::vector<uint32_t> succs;
+    addTextStmt("static const VlMTaskInfo __Vm_mtaskInfo[] = {\n");
+    for (size_t i = 0; i < mtasks.size(); ++i) {
+        const ExecMTask* const mtaskp = mtasks[i];
+        const uint32_t succBegin = succs.size();
+        for (const V3GraphEdge& edge : mtaskp->outEdges()) {
+            succs.push_back(indexes.at(edge.top()->as<ExecMTask>()));
+        }
+        addTextStmt("{");
+        execGraphp->addStmtsp(new AstAddrOfCFunc{fl, funcps[i]});
+        addTextStmt(", " + cvtToStr(schedule.threadId(mtaskp)) + ", "
+                    + cvtToStr(mtaskp->inEdges().size()) + ", " + cvtToStr(succBegin) + ", "
+                    + cvtToStr(succs.size()) + "},\n");
+    }
+    addTextStmt("};\n");
+    string succText = "static const uint32_t __Vm_mtaskSuccs[] = {";
+    for (const uint32_t succ : succs) succText += cvtToStr(succ) + ", ";
+    if (succs.empty()) succText += "0 /* unused */";
+    addStrStmt(succText + "};\n");
+
+    // Execute, initializing the run-time graph on first use
+    const string graphName = "vlSymsp->__Vm_mtaskGraph__" + tag;
+    addStrStmt("if (VL_UNLIKELY(!" + graphName + ".initialized())) " + graphName
+               + ".init(__Vm_mtaskInfo, " + cvtToStr(mtasks.size()) + ", __Vm_mtaskSuccs, "
+               + cvtToStr(v3Global.opt.threads()) + ", vlSymsp->_vm_contextp__);\n");
+    if (v3Global.opt.profExec()) {
+        addStrStmt("VL_EXEC_TRACE_ADD_RECORD(vlSymsp).threadScheduleWaitBegin();\n");
+    }
+    addStrStmt(graphName + ".execute(vlSymsp->__Vm_threadPoolp, vlSelf, vlSymsp->__Vm_even_cycle__"
+               + tag + ");\n");
+    if (v3Global.opt.profExec()) {
+        addStrStmt("VL_EXEC_TRACE_ADD_RECORD(vlSymsp).threadScheduleWaitEnd();\n");
+    }
+    addStrStmt("}\n");
+    V3Stats::addStatSum("Optimizations, Thread schedule total tasks", mtasks.size());
+}
+
+void assignWorkers(const ThreadSchedule& schedule) {
+    // Record which pool worker first runs each MTask, for V3VariableOrder.
+    // With hierarchical blocks the workers are only picked at run time.
+    if (v3Global.opt.hierChild() || !v3Global.opt.hierBlocks().empty()) return;
+    const uint32_t nThreads = v3Global.opt.threads();
+    int index = 0;
+    int last = -1;
+    for (const std::vector<const ExecMTask*>& thread : schedule.threads) {
+        if (!thread.empty()) last = index++;
+    }
+    index = 0;
+    for (const std::vector<const ExecMTask*>& thread : schedule.threads) {
+        if (thread.empty()) continue;
+        for (const ExecMTask* const mtaskp : thread) {
+            int worker = index;
+            if (v3Global.opt.useThreadsWorkStealing()) {
+                // Each MTask is readied on a queue, the last owned by the eval thread
+                worker = static_cast<int>(schedule.threadId(mtaskp) % nThreads);
+                if (worker == static_cast<int>(nThreads) - 1) worker = -1;
+            } else if (index == last) {
+                worker = -1;  // The last thread runs on the eval thread
+            }
+            const_cast<ExecMTask*>(mtaskp)->worker(worker);
+        }
+        ++index;
+    }
+}
+
 void implement(AstNetlist* netlistp) {
     // Called by Verilator top stage
+    ProfClasses mtaskClasses;  // Class of each MTask function, with MTask profile data
     netlistp->topModulep()->foreach([&](AstExecGraph* execGraphp) {
         // Back in V3Order, we partitioned mtasks using provisional cost
         // estimates. However, V3Order precedes some optimizations (notably
@@ -1187,14 +1447,23 @@ void implement(AstNetlist* netlistp) {
 
         // Wrap each MTask body into a CFunc for better profiling/debugging
         wrapMTaskBodies(execGraphp);
+        if (V3Control::containsMTaskProfileData()) classifyMTaskFuncs(execGraphp, mtaskClasses);
 
         for (const ThreadSchedule& schedule : packed) {
+            assignWorkers(schedule);
             // Replace the graph body with its multi-threaded implementation.
-            implementExecGraph(execGraphp, schedule);
+            if (v3Global.opt.useThreadsWorkStealing()) {
+                // The static schedule only seeds which thread first runs each MTask
+                UASSERT_OBJ(packed.size() == 1, execGraphp, "Multiple schedules without hier");
+                implementExecGraphWorkStealing(execGraphp, schedule);
+            } else {
+                implementExecGraph(execGraphp, schedule);
+            }
         }
 
         addThreadEndWrapper(execGraphp);
     });
+    if (!mtaskClasses.empty()) markHotColdFuncs(netlistp, mtaskClasses);
 }
 
 void selfTest() {
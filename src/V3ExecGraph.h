@@ -44,6 +44,7 @@ private:
     uint32_t m_cost = 0;
     uint64_t m_predictStart = 0;  // Predicted start time of task
     int m_threads = 1;  // Threads used by this mtask
+    int m_worker = -1;  // Thread pool worker first running this mtask, -1 = eval thread
     VL_UNCOPYABLE(ExecMTask);
 
 public:
@@ -60,6 +61,8 @@ public:
     string hashName() const { return m_hashName; }
     void threads(int threads) { m_threads = threads; }
     int threads() const { return m_threads; }
+    void worker(int index) { m_worker = index; }
+    int worker() const { return m_worker; }
     void dump(std::ostream& str) const;
 
     static uint32_t numUsedIds() VL_MT_SAFE { return s_nextId; }
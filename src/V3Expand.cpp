@@ -80,6 +80,7 @@ class ExpandVisitor final : public VNVisitor {
     VDouble0 m_statWides;  // Statistic tracking
     VDouble0 m_statWideWords;  // Statistic tracking
     VDouble0 m_statWideLimited;  // Statistic tracking
+    VDouble0 m_statWideVector;  // Statistic tracking
 
     // METHODS
     // Use state that ExpandOkVisitor calculated
@@ -101,6 +102,15 @@ class ExpandVisitor final : public VNVisitor {
         }
     }
 
+    // With --expand-vector-words, keep wide bitwise, compare and conditional operations at
+    // least that wide as library calls, which process several words per SIMD instruction
+    bool keepVector(AstNode* nodep) {
+        const int minWords = v3Global.opt.expandVectorWords();
+        if (!minWords || nodep->widthWords() < minWords) return false;
+        ++m_statWideVector;
+        return true;
+    }
+
     static int longOrQuadWidth(AstNode* nodep) {
         return (nodep->width() + (VL_EDATASIZE - 1)) & ~(VL_EDATASIZE - 1);
     }
@@ -164,6 +174,19 @@ class ExpandVisitor final : public VNVisitor {
         // Concat may pass negative word numbers, that means it wants a zero
         FileLine* const fl = nodep->fileline();
         if (nodep->isWide() && word >= 0 && word < nodep->widthWords()) {
+            // Bitwise operators left fused by V3Premit are computed word by word
+            if (const AstNot* const notp = VN_CAST(nodep, Not)) {
+                return new AstNot{fl, newAstWordSelClone(notp->lhsp(), word)};
+            } else if (const AstAnd* const andp = VN_CAST(nodep, And)) {
+                return new AstAnd{fl, newAstWordSelClone(andp->lhsp(), word),
+                                  newAstWordSelClone(andp->rhsp(), word)};
+            } else if (const AstOr* const orp = VN_CAST(nodep, Or)) {
+                return new AstOr{fl, newAstWordSelClone(orp->lhsp(), word),
+                                 newAstWordSelClone(orp->rhsp(), word)};
+            } else if (const AstXor* const xorp = VN_CAST(nodep, Xor)) {
+                return new AstXor{fl, newAstWordSelClone(xorp->lhsp(), word),
+                                  newAstWordSelClone(xorp->rhsp(), word)};
+            }
             return new AstWordSel{fl, nodep->cloneTreePure(true),
                                   new AstConst{fl, static_cast<uint32_t>(word)}};
         } else if (nodep->isQuad() && word == 0) {
@@ -301,7 +324,7 @@ class ExpandVisitor final : public VNVisitor {
     bool expandWide(AstNodeAssign* nodep, AstNot* rhsp) {
         UINFO(8, "    Wordize ASSIGN(NOT) " << nodep);
         // -> {for each_word{ ASSIGN(WORDSEL(wide,#),NOT(WORDSEL(lhs,#))) }}
-        if (!doExpandWide(nodep)) return false;
+        if (keepVector(nodep) || !doExpandWide(nodep)) return false;
         FileLine* const fl = rhsp->fileline();
         for (int w = 0; w < nodep->widthWords(); ++w) {
             addWordAssign(nodep, w, new AstNot{fl, newAstWordSelClone(rhsp->lhsp(), w)});
@@ -311,7 +334,7 @@ class ExpandVisitor final : public VNVisitor {
     //-------- Biops
     bool expandWide(AstNodeAssign* nodep, AstAnd* rhsp) {
         UINFO(8, "    Wordize ASSIGN(AND) " << nodep);
-        if (!doExpandWide(nodep)) return false;
+        if (keepVector(nodep) || !doExpandWide(nodep)) return false;
         FileLine* const fl = nodep->fileline();
         for (int w = 0; w < nodep->widthWords(); ++w) {
             addWordAssign(nodep, w,
@@ -322,7 +345,7 @@ class ExpandVisitor final : public VNVisitor {
     }
     bool expandWide(AstNodeAssign* nodep, AstOr* rhsp) {
         UINFO(8, "    Wordize ASSIGN(OR) " << nodep);
-        if (!doExpandWide(nodep)) return false;
+        if (keepVector(nodep) || !doExpandWide(nodep)) return false;
         FileLine* const fl = nodep->fileline();
         for (int w = 0; w < nodep->widthWords(); ++w) {
             addWordAssign(nodep, w,
@@ -333,7 +356,7 @@ class ExpandVisitor final : public VNVisitor {
     }
     bool expandWide(AstNodeAssign* nodep, AstXor* rhsp) {
         UINFO(8, "    Wordize ASSIGN(XOR) " << nodep);
-        if (!doExpandWide(nodep)) return false;
+        if (keepVector(nodep) || !doExpandWide(nodep)) return false;
         FileLine* const fl = nodep->fileline();
         for (int w = 0; w < nodep->widthWords(); ++w) {
             addWordAssign(nodep, w,
@@ -345,7 +368,7 @@ class ExpandVisitor final : public VNVisitor {
     //-------- Triops
     bool expandWide(AstNodeAssign* nodep, AstNodeCond* rhsp) {
         UINFO(8, "    Wordize ASSIGN(COND) " << nodep);
-        if (!doExpandWide(nodep)) return false;
+        if (keepVector(nodep) || !doExpandWide(nodep)) return false;
         FileLine* const fl = nodep->fileline();
         for (int w = 0; w < nodep->widthWords(); ++w) {
             addWordAssign(nodep, w,
@@ -804,7 +827,7 @@ class ExpandVisitor final : public VNVisitor {
         if (nodep->user1SetOnce()) return;  // Process once
         iterateChildren(nodep);
         if (nodep->lhsp()->isWide()) {
-            if (isImpure(nodep)) return;
+            if (isImpure(nodep) || keepVector(nodep->lhsp())) return;
             UINFO(8, "    Wordize EQ/NEQ " << nodep);
             // -> (0=={or{for each_word{WORDSEL(lhs,#)^WORDSEL(rhs,#)}}}
             FileLine* const fl = nodep->fileline();
@@ -965,6 +988,7 @@ public:
         V3Stats::addStat("Optimizations, expand wides", m_statWides);
         V3Stats::addStat("Optimizations, expand wide words", m_statWideWords);
         V3Stats::addStat("Optimizations, expand limited", m_statWideLimited);
+        V3Stats::addStat("Optimizations, expand kept as vector", m_statWideVector);
     }
 };
 
@@ -20,6 +20,7 @@
 
 #include "V3Os.h"
 #include "V3String.h"
+#include "V3ThreadPool.h"
 
 #include <cerrno>
 #include <cstdarg>
@@ -135,8 +136,9 @@ public:
     }
     void writeDepend(const string& filename);
     std::vector<string> getAllDeps() const;
-    void writeTimes(const string& filename, const string& cmdlineIn);
-    bool checkTimes(const string& filename, const string& cmdlineIn);
+    std::vector<string> getAllTargets() const;
+    void writeTimes(const string& filename, const string& cmdlineIn, const string& contentHash);
+    bool checkTimes(const string& filename, const string& cmdlineIn, const string& contentHash);
 };
 
 V3FileDependImp dependImp;  // Depend implementation class
@@ -177,7 +179,16 @@ std::vector<string> V3FileDependImp::getAllDeps() const {
     return r;
 }
 
-void V3FileDependImp::writeTimes(const string& filename, const string& cmdlineIn) {
+std::vector<string> V3FileDependImp::getAllTargets() const {
+    std::vector<string> r;
+    for (const auto& itr : m_filenameList) {
+        if (itr.target()) r.push_back(itr.filename());
+    }
+    return r;
+}
+
+void V3FileDependImp::writeTimes(const string& filename, const string& cmdlineIn,
+                                  const string& contentHash) {
     const std::unique_ptr<std::ofstream> ofp{V3File::new_ofstream(filename)};
     if (ofp->fail()) v3fatal("Can't write file: " << filename);
 
@@ -185,6 +196,7 @@ void V3FileDependImp::writeTimes(const string& filename, const string& cmdlineIn
     *ofp << "# DESCR"
          << "IPTION: Verilator output: Timestamp data for --skip-identical.  Delete at will.\n";
     *ofp << "C \"" << cmdline << "\"\n";
+    if (!contentHash.empty()) *ofp << "H \"" << contentHash << "\"\n";
 
     for (std::set<DependFile>::iterator iter = m_filenameList.begin();
          iter != m_filenameList.end(); ++iter) {
@@ -212,7 +224,8 @@ void V3FileDependImp::writeTimes(const string& filename, const string& cmdlineIn
     }
 }
 
-bool V3FileDependImp::checkTimes(const string& filename, const string& cmdlineIn) {
+bool V3FileDependImp::checkTimes(const string& filename, const string& cmdlineIn,
+                                  const string& contentHash) {
     const std::unique_ptr<std::ifstream> ifp{V3File::new_ifstream_nodepend(filename)};
     if (ifp->fail()) {
         UINFO(2, "   --check-times failed: no input " << filename);
@@ -235,6 +248,21 @@ bool V3FileDependImp::checkTimes(const string& filename, const string& cmdlineIn
             return false;
         }
     }
+    string chkHash;
+    *ifp >> std::ws;
+    if (ifp->peek() == 'H') {
+        char chkDir;
+        *ifp >> chkDir;
+        char quote;
+        *ifp >> quote;
+        chkHash = V3Os::getline(*ifp, '"');
+    }
+    if (!contentHash.empty() && contentHash != chkHash) {
+        UINFO(2, "   --check-times failed: different content hash");
+        return false;
+    }
+
+    std::vector<string> targets;  // Outputs to again record, when sources matched by hash
 
     while (!ifp->eof()) {
         char chkDir;
@@ -255,6 +283,9 @@ bool V3FileDependImp::checkTimes(const string& filename, const string& cmdlineIn
         char quote;
         *ifp >> quote;
         const string chkFilename = V3Os::getline(*ifp, '"');
+        // The hash replaces checking the source files, but the outputs must be unchanged
+        if (!contentHash.empty() && chkDir != 'T') continue;
+        if (!contentHash.empty()) targets.push_back(chkFilename);
 
         V3Os::filesystemFlush(chkFilename);
         // NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init)
@@ -291,6 +322,7 @@ bool V3FileDependImp::checkTimes(const string& filename, const string& cmdlineIn
             }
         }
     }
+    for (const string& target : targets) addTgtDepend(target);
     return true;
 }
 
@@ -301,11 +333,14 @@ void V3File::addSrcDepend(const string& filename) VL_MT_SAFE { dependImp.addSrcD
 void V3File::addTgtDepend(const string& filename) VL_MT_SAFE { dependImp.addTgtDepend(filename); }
 void V3File::writeDepend(const string& filename) { dependImp.writeDepend(filename); }
 std::vector<string> V3File::getAllDeps() { return dependImp.getAllDeps(); }
-void V3File::writeTimes(const string& filename, const string& cmdlineIn) {
-    dependImp.writeTimes(filename, cmdlineIn);
+std::vector<string> V3File::getAllTargets() { return dependImp.getAllTargets(); }
+void V3File::writeTimes(const string& filename, const string& cmdlineIn,
+                        const string& contentHash) {
+    dependImp.writeTimes(filename, cmdlineIn, contentHash);
 }
-bool V3File::checkTimes(const string& filename, const string& cmdlineIn) {
-    return dependImp.checkTimes(filename, cmdlineIn);
+bool V3File::checkTimes(const string& filename, const string& cmdlineIn,
+                        const string& contentHash) {
+    return dependImp.checkTimes(filename, cmdlineIn, contentHash);
 }
 void V3File::createMakeDirFor(const string& filename) {
     if (filename != VL_DEV_NULL
@@ -331,6 +366,7 @@ class VInFilterImp final {
     using StrList = VInFilter::StrList;
 
     std::map<const std::string, std::string> m_contentsMap;  // Cache of file contents
+    std::map<const std::string, std::string> m_prefetchMap;  // Contents read ahead, until used
     bool m_readEof = false;  // Received EOF on read
 #ifdef INFILTER_PIPE
     pid_t m_pid = 0;  // fork() process id
@@ -353,10 +389,29 @@ private:
         }
     }
     bool readContentsFile(const string& filename, StrList& outl) {
+        string contents;
+        if (!readFileString(filename, contents)) return false;
+        outl.push_back(std::move(contents));
+        return true;
+    }
+    // Read a whole file into a single string, sized up front.  Return false if can't open.
+    static bool readFileString(const string& filename, string& contents) VL_MT_SAFE {
         const int fd = open(filename.c_str(), O_RDONLY);
         if (fd < 0) return false;
-        m_readEof = false;
-        readBlocks(fd, -1, outl);
+        struct stat sstat;
+        if (fstat(fd, &sstat) == 0 && sstat.st_size > 0) contents.reserve(sstat.st_size);
+        char buf[INFILTER_IPC_BUFSIZ];
+        while (true) {
+            errno = 0;
+            const ssize_t got = read(fd, buf, INFILTER_IPC_BUFSIZ);
+            if (got > 0) {
+                contents.append(buf, got);
+            } else if (got < 0 && errno == EINTR) {
+                continue;
+            } else {
+                break;
+            }
+        }
         close(fd);
         return true;
     }
@@ -572,7 +627,13 @@ protected:
             outl.push_back(it->second);
             return true;
         }
-        if (!readContents(filename, outl)) return false;
+        const auto pit = m_prefetchMap.find(filename);
+        if (pit != m_prefetchMap.end()) {
+            outl.push_back(std::move(pit->second));
+            m_prefetchMap.erase(pit);
+        } else if (!readContents(filename, outl)) {
+            return false;
+        }
         if (listSize(outl) < INFILTER_CACHE_MAX) {
             // Cache small files (only to save space)
             // It's quite common to `include "timescale" thousands of times
@@ -581,6 +642,24 @@ protected:
         }
         return true;
     }
+    // Read files ahead of their use, on the thread pool, so latency of
+    // slow (e.g. network) file systems overlaps between files
+    void prefetch(const std::vector<string>& filenames) {
+        if (m_pid) return;  // The filter handles one file at a time
+        std::vector<string> contents(filenames.size());
+        std::unique_ptr<bool[]> oks{new bool[filenames.size()]};
+        {
+            V3ThreadScope threadScope;
+            for (size_t i = 0; i < filenames.size(); ++i) {
+                threadScope.enqueue([&filenames, &contents, &oks, i]() {
+                    oks[i] = readFileString(filenames[i], contents[i]);
+                });
+            }
+        }
+        for (size_t i = 0; i < filenames.size(); ++i) {
+            if (oks[i]) m_prefetchMap.emplace(filenames[i], std::move(contents[i]));
+        }
+    }
     static size_t listSize(const StrList& sl) {
         size_t result = 0;
         for (const string& i : sl) result += i.length();
@@ -609,6 +688,10 @@ bool VInFilter::readWholefile(const string& filename, VInFilter::StrList& outl)
     UASSERT(m_impp, "readWholefile on invalid filter");
     return m_impp->readWholefile(filename, outl);
 }
+void VInFilter::prefetch(const std::vector<string>& filenames) {
+    UASSERT(m_impp, "prefetch on invalid filter");
+    m_impp->prefetch(filenames);
+}
 
 //######################################################################
 // V3OutFormatter: A class for printing to a file, with automatic indentation of C++ code.
@@ -68,8 +68,12 @@ public:
     static void addTgtDepend(const string& filename) VL_MT_SAFE;
     static void writeDepend(const string& filename);
     static std::vector<string> getAllDeps();
-    static void writeTimes(const string& filename, const string& cmdlineIn);
-    static bool checkTimes(const string& filename, const string& cmdlineIn);
+    static std::vector<string> getAllTargets();
+    static void writeTimes(const string& filename, const string& cmdlineIn,
+                           const string& contentHash = "");
+    // With contentHash, sources match if the recorded hash is the same, whatever their times
+    static bool checkTimes(const string& filename, const string& cmdlineIn,
+                           const string& contentHash = "");
 
     // Directory utilities
     static void createMakeDirFor(const string& filename);
@@ -99,6 +103,8 @@ public:
     // METHODS
     // Read file contents and return it.  Return true on success.
     bool readWholefile(const string& filename, StrList& outl);
+    // Read files in parallel, to be returned by later readWholefile() calls
+    void prefetch(const std::vector<string>& filenames);
 };
 
 //============================================================================
@@ -333,6 +339,9 @@ public:
     V3OutJsonFile& put(const std::string& name, int value) {
         return putNamed(name, std::to_string(value), false);
     }
+    V3OutJsonFile& put(const std::string& name, uint64_t value) {
+        return putNamed(name, std::to_string(value), false);
+    }
 
     // Put unnamed value
     V3OutJsonFile& put(const std::string& value) { return putNamed("", value, true); }
@@ -31,6 +31,7 @@
 // clang-format on
 
 #include <algorithm>
+#include <array>
 #include <iomanip>
 #include <limits>
 #include <unordered_set>
@@ -317,17 +318,35 @@ FileLine* FileLine::copyOrSameFileLineApplied() {
 FileLine* FileLine::copyOrSameFileLine() {
     // When a fileline is "used" to produce a node, calls this function.
     // Return this, or a copy of this
-    // There are often more than one token per line, thus we use the
-    // same pointer as long as we're on the same line, file & warn state.
-    static FileLine* lastNewp = nullptr;
-    if (lastNewp && *lastNewp == *this) {  // Compares lineno, filename, etc
-        return lastNewp;
-    }
+    // There are often several nodes made from each token, and the parser
+    // makes nodes from recent tokens after lexing ahead, so intern the
+    // copies in a small direct mapped cache of recent ones. FileLines are
+    // never freed, so cached pointers stay valid; a copy modified since no
+    // longer compares equal.
+    static std::array<FileLine*, COPY_CACHE_SIZE> s_recentps{};
+    FileLine*& slotr = s_recentps[contentHash() % COPY_CACHE_SIZE];
+    if (slotr && slotr->equalContent(*this)) return slotr;
     FileLine* const newp = new FileLine{this};
-    lastNewp = newp;
+    slotr = newp;
     return newp;
 }
 
+size_t FileLine::contentHash() const VL_PURE {
+    size_t hash = m_filenameno;
+    hash = hash * 31 + m_msgEnIdx;
+    hash = hash * 31 + static_cast<size_t>(m_firstLineno);
+    hash = hash * 31 + static_cast<size_t>(m_firstColumn);
+    hash = hash * 31 + static_cast<size_t>(m_lastLineno);
+    hash = hash * 31 + static_cast<size_t>(m_lastColumn);
+    return hash ^ (hash >> 16);
+}
+
+bool FileLine::equalContent(const FileLine& rhs) const VL_PURE {
+    // Unlike operator==, also the include context and source text
+    return *this == rhs && m_waive == rhs.m_waive && m_contentLineno == rhs.m_contentLineno
+           && m_contentp == rhs.m_contentp && m_parent == rhs.m_parent;
+}
+
 string FileLine::filebasename() const VL_MT_SAFE { return V3Os::filenameNonDir(filename()); }
 
 string FileLine::filebasenameNoExt() const { return V3Os::filenameNonDirExt(filename()); }
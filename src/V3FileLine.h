@@ -132,6 +132,7 @@ class FileLine final {
 
     // CONSTANTS
     static constexpr unsigned SHOW_SOURCE_MAX_LENGTH = 400;  // Don't show source lines > this long
+    static constexpr size_t COPY_CACHE_SIZE = 4096;  // Recent copies interned by copyOrSameFileLine
 
     // TYPES
     using fileNameIdx_t = FileLineSingleton::fileNameIdx_t;
@@ -390,6 +391,8 @@ public:
     }
 
 private:
+    size_t contentHash() const VL_PURE;
+    bool equalContent(const FileLine& rhs) const VL_PURE;
     string warnContext() const;
     string warnContextParent() const VL_REQUIRES(V3Error::s().m_mutex);
     const MsgEnBitSet& msgEn() const VL_MT_SAFE { return singleton().msgEn(m_msgEnIdx); }
@@ -40,6 +40,15 @@
 //
 //  After each WRITE of forced RHS
 //      reevaluate <lhs>__VforceVal to support VarRef rollback after release
+//
+//  With -fforce-fast-path, signals not used in a sensitivity list do not get
+//  a <name>__VforceRd signal, instead:
+//      replace all READ references to <name> with the expression
+//          __VforceActive ? (<name>__VforceEn ? <name>__VforceVal : <name>) : <name>
+//      where __VforceActive is set by every force statement, so until the first
+//      force executes reads only cost a test of a single, well predicted flag.
+//      Signals marked 'forceable' can be forced externally at any time, so are not
+//      guarded by __VforceActive.
 //*************************************************************************
 
 #include "V3PchAstNoMT.h"  // VL_MT_DISABLED_CODE_UNIT
@@ -59,50 +68,46 @@ class ForceState final {
         AstVar* const m_rdVarp;  // New variable to replace read references with
         AstVar* const m_valVarp;  // Forced value
         AstVar* const m_enVarp;  // Force enabled signal
-        explicit ForceComponentsVar(AstVar* varp)
-            : m_rdVarp{new AstVar{varp->fileline(), VVarType::WIRE, varp->name() + "__VforceRd",
-                                  varp->dtypep()}}
+        ForceComponentsVar(AstVar* varp, bool readMux)
+            : m_rdVarp{readMux ? nullptr
+                               : new AstVar{varp->fileline(), VVarType::WIRE,
+                                            varp->name() + "__VforceRd", varp->dtypep()}}
             , m_valVarp{new AstVar{varp->fileline(), VVarType::VAR, varp->name() + "__VforceVal",
                                    varp->dtypep()}}
             , m_enVarp{new AstVar{
                   varp->fileline(), VVarType::VAR, varp->name() + "__VforceEn",
                   (ForceState::isRangedDType(varp) ? varp->dtypep() : varp->findBitDType())}} {
-            m_rdVarp->addNext(m_enVarp);
-            m_rdVarp->addNext(m_valVarp);
-            varp->addNextHere(m_rdVarp);
+            m_enVarp->addNext(m_valVarp);
+            if (m_rdVarp) m_rdVarp->addNext(m_enVarp);
+            varp->addNextHere(m_rdVarp ? m_rdVarp : m_enVarp);
         }
     };
 
 public:
     struct ForceComponentsVarScope final {
-        AstVarScope* const m_rdVscp;  // New variable to replace read references with
+        AstVarScope* const m_rdVscp;  // New variable to replace read references with, or
+                                      // nullptr if reads are replaced with 'forcedRead'
         AstVarScope* const m_valVscp;  // Forced value
         AstVarScope* const m_enVscp;  // Force enabled signal
-        explicit ForceComponentsVarScope(AstVarScope* vscp, ForceComponentsVar& fcv)
-            : m_rdVscp{new AstVarScope{vscp->fileline(), vscp->scopep(), fcv.m_rdVarp}}
+        AstVarScope* const m_activeVscp;  // Global flag guarding 'forcedRead', or nullptr
+        ForceComponentsVarScope(AstVarScope* vscp, ForceComponentsVar& fcv,
+                                AstVarScope* activeVscp)
+            : m_rdVscp{fcv.m_rdVarp
+                           ? new AstVarScope{vscp->fileline(), vscp->scopep(), fcv.m_rdVarp}
+                           : nullptr}
             , m_valVscp{new AstVarScope{vscp->fileline(), vscp->scopep(), fcv.m_valVarp}}
-            , m_enVscp{new AstVarScope{vscp->fileline(), vscp->scopep(), fcv.m_enVarp}} {
-            m_rdVscp->addNext(m_enVscp);
-            m_rdVscp->addNext(m_valVscp);
-            vscp->addNextHere(m_rdVscp);
+            , m_enVscp{new AstVarScope{vscp->fileline(), vscp->scopep(), fcv.m_enVarp}}
+            , m_activeVscp{fcv.m_rdVarp ? nullptr : activeVscp} {
+            m_enVscp->addNext(m_valVscp);
+            if (m_rdVscp) m_rdVscp->addNext(m_enVscp);
+            vscp->addNextHere(m_rdVscp ? m_rdVscp : m_enVscp);
 
             FileLine* const flp = vscp->fileline();
 
-            {  // Add initialization of the enable signal
-                AstVarRef* const lhsp = new AstVarRef{flp, m_enVscp, VAccess::WRITE};
-                V3Number zero{m_enVscp, m_enVscp->width()};
-                zero.setAllBits0();
-                AstNodeExpr* const rhsp = new AstConst{flp, zero};
-                AstAssign* const assignp = new AstAssign{flp, lhsp, rhsp};
-                AstActive* const activep = new AstActive{
-                    flp, "force-init",
-                    new AstSenTree{flp, new AstSenItem{flp, AstSenItem::Static{}}}};
-                activep->sensesStorep(activep->sensesp());
+            // Add initialization of the enable signal
+            ForceState::addZeroInit(m_enVscp);
 
-                activep->addStmtsp(new AstInitial{flp, assignp});
-                vscp->scopep()->addBlocksp(activep);
-            }
-            {  // Add the combinational override
+            if (m_rdVscp) {  // Add the combinational override
                 AstVarRef* const lhsp = new AstVarRef{flp, m_rdVscp, VAccess::WRITE};
                 AstNodeExpr* const rhsp = forcedUpdate(vscp);
 
@@ -141,6 +146,16 @@ public:
             return new AstCond{flp, new AstVarRef{flp, m_enVscp, VAccess::READ},
                                new AstVarRef{flp, m_valVscp, VAccess::READ}, origp};
         }
+        // Value to replace read references with when there is no 'm_rdVscp'
+        AstNodeExpr* forcedRead(AstVarScope* const vscp) const {
+            AstNodeExpr* const forcedp = forcedUpdate(vscp);
+            if (!m_activeVscp) return forcedp;
+            FileLine* const flp = vscp->fileline();
+            AstVarRef* const origp = new AstVarRef{flp, vscp, VAccess::READ};
+            ForceState::markNonReplaceable(origp);
+            return new AstCond{flp, new AstVarRef{flp, m_activeVscp, VAccess::READ}, forcedp,
+                               origp};
+        }
     };
 
 private:
@@ -157,10 +172,49 @@ private:
     const VNUser4InUse m_user4InUse;
     AstUser1Allocator<AstVar, ForceComponentsVar> m_forceComponentsVar;
     AstUser1Allocator<AstVarScope, ForceComponentsVarScope> m_forceComponentsVarScope;
+    std::unordered_set<const AstVar*> m_needsRdVars;  // Variables that must use __VforceRd
+    AstVarScope* m_activeVscp = nullptr;  // Flag set by any force statement, created on demand
+
+    // METHODS
+    // Global flag set when the first force statement is executed
+    AstVarScope* activeVscp() {
+        if (m_activeVscp) return m_activeVscp;
+        AstScope* const scopep = v3Global.rootp()->topScopep()->scopep();
+        FileLine* const flp = scopep->fileline();
+        AstVar* const varp = new AstVar{flp, VVarType::MODULETEMP, "__VforceActive",
+                                        v3Global.rootp()->findBitDType()};
+        scopep->modp()->addStmtsp(varp);
+        m_activeVscp = new AstVarScope{flp, scopep, varp};
+        scopep->addVarsp(m_activeVscp);
+        addZeroInit(m_activeVscp);
+        return m_activeVscp;
+    }
+    // Reads of variables in sensitivities must be actual variables, and forces of several
+    // variables at once would write to a concatenation of __VforceRd signals, so these
+    // variables keep using the __VforceRd signal.
+    void gatherNeedsRdVars(AstNetlist* nodep) {
+        const auto addRefs = [this](AstNode* itemp) {
+            itemp->foreach(
+                [this](const AstNodeVarRef* refp) { m_needsRdVars.emplace(refp->varp()); });
+        };
+        nodep->foreach([&](AstSenItem* itemp) { addRefs(itemp); });
+        nodep->foreach([&](AstCoverToggle* itemp) { addRefs(itemp); });
+        const auto addMulti = [&](AstNodeExpr* lhsp) {
+            size_t nVars = 0;
+            lhsp->foreach([&](const AstNodeVarRef* refp) {
+                if (refp->access().isWriteOrRW()) ++nVars;
+            });
+            if (nVars > 1) addRefs(lhsp);
+        };
+        nodep->foreach([&](AstAssignForce* forcep) { addMulti(forcep->lhsp()); });
+        nodep->foreach([&](AstRelease* releasep) { addMulti(releasep->lhsp()); });
+    }
 
 public:
     // CONSTRUCTORS
-    ForceState() = default;
+    explicit ForceState(AstNetlist* nodep) {
+        if (v3Global.opt.fForceFastPath()) gatherNeedsRdVars(nodep);
+    }
     VL_UNCOPYABLE(ForceState);
 
     // STATIC METHODS
@@ -170,6 +224,20 @@ public:
         const AstBasicDType* const basicp = nodep->dtypep()->skipRefp()->basicp();
         return basicp && basicp->isRanged();
     }
+    static void addZeroInit(AstVarScope* vscp) {
+        FileLine* const flp = vscp->fileline();
+        AstVarRef* const lhsp = new AstVarRef{flp, vscp, VAccess::WRITE};
+        V3Number zero{vscp, vscp->width()};
+        zero.setAllBits0();
+        AstNodeExpr* const rhsp = new AstConst{flp, zero};
+        AstAssign* const assignp = new AstAssign{flp, lhsp, rhsp};
+        AstActive* const activep = new AstActive{
+            flp, "force-init", new AstSenTree{flp, new AstSenItem{flp, AstSenItem::Static{}}}};
+        activep->sensesStorep(activep->sensesp());
+
+        activep->addStmtsp(new AstInitial{flp, assignp});
+        vscp->scopep()->addBlocksp(activep);
+    }
     static bool isNotReplaceable(const AstVarRef* const nodep) { return nodep->user2(); }
     static void markNonReplaceable(AstVarRef* const nodep) { nodep->user2SetOnce(); }
     static AstVarScope* getValVscp(AstVarRef* const refp) {
@@ -182,7 +250,11 @@ public:
     // METHODS
     const ForceComponentsVarScope& getForceComponents(AstVarScope* vscp) {
         AstVar* const varp = vscp->varp();
-        return m_forceComponentsVarScope(vscp, vscp, m_forceComponentsVar(varp, varp));
+        const bool readMux = v3Global.opt.fForceFastPath() && !m_needsRdVars.count(varp)
+                             && VN_IS(varp->dtypep()->skipRefp(), BasicDType);
+        AstVarScope* const activep = readMux && !varp->isForceable() ? activeVscp() : nullptr;
+        return m_forceComponentsVarScope(vscp, vscp, m_forceComponentsVar(varp, varp, readMux),
+                                         activep);
     }
     ForceComponentsVarScope* tryGetForceComponents(AstVarRef* nodep) const {
         return m_forceComponentsVarScope.tryGet(nodep->varScopep());
@@ -233,9 +305,18 @@ class ForceConvertVisitor final : public VNVisitor {
         ones.setAllBits1();
         AstAssign* const setEnp
             = new AstAssign{flp, lhsp->cloneTreePure(false), new AstConst{rhsp->fileline(), ones}};
-        transformWritenVarScopes(setEnp->lhsp(), [this](AstVarScope* vscp) {
-            return m_state.getForceComponents(vscp).m_enVscp;
+        AstVarScope* activeVscp = nullptr;
+        bool hasRd = true;
+        transformWritenVarScopes(setEnp->lhsp(), [&](AstVarScope* vscp) {
+            const ForceState::ForceComponentsVarScope& fc = m_state.getForceComponents(vscp);
+            if (fc.m_activeVscp) activeVscp = fc.m_activeVscp;
+            if (!fc.m_rdVscp) hasRd = false;
+            return fc.m_enVscp;
         });
+        if (activeVscp) {
+            setEnp->addNext(new AstAssign{flp, new AstVarRef{flp, activeVscp, VAccess::WRITE},
+                                          new AstConst{flp, AstConst::BitTrue{}}});
+        }
         // Set corresponding value signals to the forced value
         AstAssign* const setValp
             = new AstAssign{flp, lhsp->cloneTreePure(false), rhsp->cloneTreePure(false)};
@@ -246,15 +327,21 @@ class ForceConvertVisitor final : public VNVisitor {
             return valVscp;
         });
 
-        // Set corresponding read signal directly as well, in case something in the same
-        // process reads it later
-        AstAssign* const setRdp = new AstAssign{flp, lhsp->unlinkFrBack(), rhsp->unlinkFrBack()};
-        transformWritenVarScopes(setRdp->lhsp(), [this](AstVarScope* vscp) {
-            return m_state.getForceComponents(vscp).m_rdVscp;
-        });
-
         setEnp->addNext(setValp);
-        setEnp->addNext(setRdp);
+
+        // Set corresponding read signal directly as well, in case something in the same
+        // process reads it later. Not needed when reads use the forced value directly.
+        if (hasRd) {
+            AstAssign* const setRdp
+                = new AstAssign{flp, lhsp->unlinkFrBack(), rhsp->unlinkFrBack()};
+            transformWritenVarScopes(setRdp->lhsp(), [this](AstVarScope* vscp) {
+                return m_state.getForceComponents(vscp).m_rdVscp;
+            });
+            setEnp->addNext(setRdp);
+        } else {
+            VL_DO_DANGLING(pushDeletep(lhsp->unlinkFrBack()), lhsp);
+            VL_DO_DANGLING(pushDeletep(rhsp->unlinkFrBack()), rhsp);
+        }
         relinker.relink(setEnp);
     }
 
@@ -285,12 +372,18 @@ class ForceConvertVisitor final : public VNVisitor {
         AstAssign* const resetRdp
             = new AstAssign{flp, lhsp->cloneTreePure(false), lhsp->unlinkFrBack()};
         // Replace write refs on the LHS
-        resetRdp->lhsp()->foreach([this](AstNodeVarRef* refp) {
+        bool needsReset = true;
+        resetRdp->lhsp()->foreach([&](AstNodeVarRef* refp) {
             if (refp->access() != VAccess::WRITE) return;
             AstVarScope* const vscp = refp->varScopep();
             AstVarScope* const newVscp = vscp->varp()->isContinuously()
                                              ? m_state.getForceComponents(vscp).m_rdVscp
                                              : vscp;
+            // Reads of nets without __VforceRd see the driven value as soon as released
+            if (!newVscp) {
+                needsReset = false;
+                return;
+            }
             AstVarRef* const newpRefp = new AstVarRef{refp->fileline(), newVscp, VAccess::WRITE};
             refp->replaceWith(newpRefp);
             VL_DO_DANGLING(refp->deleteTree(), refp);
@@ -310,6 +403,11 @@ class ForceConvertVisitor final : public VNVisitor {
             VL_DO_DANGLING(refp->deleteTree(), refp);
         });
 
+        if (!needsReset) {
+            VL_DO_DANGLING(pushDeletep(resetRdp), resetRdp);
+            relinker.relink(resetEnp);
+            return;
+        }
         resetRdp->addNext(resetEnp);
         relinker.relink(resetRdp);
     }
@@ -364,9 +462,11 @@ class ForceReplaceVisitor final : public VNVisitor {
             // Replace VarRef from forced LHS with rdVscp.
             if (ForceState::ForceComponentsVarScope* const fcp
                 = m_state.tryGetForceComponents(nodep)) {
-                FileLine* const flp = nodep->fileline();
-                AstVarRef* const origp = new AstVarRef{flp, nodep->varScopep(), VAccess::READ};
-                ForceState::markNonReplaceable(origp);
+                if (!fcp->m_rdVscp) {
+                    nodep->replaceWith(fcp->forcedRead(nodep->varScopep()));
+                    VL_DO_DANGLING(pushDeletep(nodep), nodep);
+                    break;
+                }
                 nodep->varp(fcp->m_rdVscp->varp());
                 nodep->varScopep(fcp->m_rdVscp);
             }
@@ -375,8 +475,8 @@ class ForceReplaceVisitor final : public VNVisitor {
         case VAccess::WRITE: {
             if (!m_inLogic) return;
             // Emit rdVscp update after each write to any VarRef on forced LHS.
-            if (ForceState::ForceComponentsVarScope* const fcp
-                = m_state.tryGetForceComponents(nodep)) {
+            ForceState::ForceComponentsVarScope* const fcp = m_state.tryGetForceComponents(nodep);
+            if (fcp && fcp->m_rdVscp) {
                 FileLine* const flp = nodep->fileline();
                 AstVarRef* const lhsp = new AstVarRef{flp, fcp->m_rdVscp, VAccess::WRITE};
                 AstNodeExpr* const rhsp = fcp->forcedUpdate(nodep->varScopep());
@@ -418,7 +518,7 @@ void V3Force::forceAll(AstNetlist* nodep) {
     UINFO(2, __FUNCTION__ << ":");
     if (!v3Global.hasForceableSignals()) return;
     {
-        ForceState state;
+        ForceState state{nodep};
         { ForceConvertVisitor{nodep, state}; }
         { ForceReplaceVisitor{nodep, state}; }
         V3Global::dumpCheckGlobalTree("force", 0, dumpTreeEitherLevel() >= 3);
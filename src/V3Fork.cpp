@@ -46,6 +46,7 @@
 
 #include "V3AstNodeExpr.h"
 #include "V3MemberMap.h"
+#include "V3Stats.h"
 
 #include <set>
 
@@ -296,6 +297,7 @@ class DynScopeVisitor final : public VNVisitor {
                                         // process
     size_t m_id = 0;  // Unique ID for a frame
     size_t m_class_id = 0;  // Unique ID for a frame class
+    VDouble0 m_statInitsByValue;  // Statistic tracking
 
     // METHODS
 
@@ -346,6 +348,32 @@ class DynScopeVisitor final : public VNVisitor {
         if (r.second) m_frameOrder.push_back(nodep);
     }
 
+    static bool initsByValue(const AstFork* nodep) {
+        // The block item declarations of a fork that does not wait for its processes, can be
+        // copied into each of them when they are only written by their initializers, so
+        // nothing needs to be shared through a dynamic scope object
+        if (nodep->joinType().join()) return false;
+        std::set<const AstVar*> varps;
+        for (const AstNode* stmtp = nodep->initsp(); stmtp; stmtp = stmtp->nextp()) {
+            const AstVar* const varp = VN_CAST(stmtp, Var);
+            if (!varp) continue;
+            if (varp->lifetime().isStatic()) return false;  // Shared by all spawns
+            if (const AstBasicDType* const dtypep
+                = VN_CAST(varp->dtypep()->skipRefp(), BasicDType)) {
+                if (dtypep->isEvent()) return false;
+            }
+            varps.emplace(varp);
+        }
+        for (const AstNode* stmtp = nodep->stmtsp(); stmtp; stmtp = stmtp->nextp()) {
+            if (stmtp->exists([&](const AstVarRef* refp) {
+                    return refp->access().isWriteOrRW() && varps.count(refp->varp());
+                })) {
+                return false;
+            }
+        }
+        return true;
+    }
+
     bool needsDynScope(const AstVarRef* refp) const {
         return
             // Can this variable escape the scope
@@ -377,6 +405,33 @@ class DynScopeVisitor final : public VNVisitor {
         iterateChildren(nodep);
     }
     void visit(AstFork* nodep) override {
+        if (nodep->initsp() && initsByValue(nodep)) {
+            // Move the declarations into an enclosing begin. V3Fork then captures them by
+            // value as the other locals of the parent, and they live in the frames of the
+            // forked processes.
+            AstBegin* const beginp = new AstBegin{
+                nodep->fileline(),
+                "_Vwrapped_" + (nodep->name().empty() ? "" : nodep->name() + "_")
+                    + cvtToStr(m_id++),
+                nullptr, false, true};
+            AstNode* initsp = nodep->initsp()->unlinkFrBackWithNext();
+            nodep->replaceWith(beginp);
+            AstNode* assignsp = nullptr;
+            while (AstNode* const stmtp = initsp) {
+                initsp = stmtp->nextp() ? stmtp->nextp()->unlinkFrBackWithNext() : nullptr;
+                if (VN_IS(stmtp, Var)) {
+                    beginp->addStmtsp(stmtp);
+                } else {
+                    AstAssign* const asgnp = VN_AS(stmtp, Assign);
+                    iterate(asgnp->rhsp());
+                    assignsp = AstNode::addNext(assignsp, stmtp);
+                }
+            }
+            if (assignsp) beginp->addStmtsp(assignsp);
+            beginp->addStmtsp(nodep);
+            ++m_statInitsByValue;
+        }
+
         VL_RESTORER(m_forkDepth);
         if (!nodep->joinType().join()) ++m_forkDepth;
 
@@ -500,6 +555,7 @@ public:
         if (typesAdded) v3Global.rootp()->typeTablep()->repairCache();
     }
     ~DynScopeVisitor() override {
+        V3Stats::addStat("Timing, fork declarations captured by value", m_statInitsByValue);
         std::set<ForkDynScopeFrame*> frames;
         for (auto node_frame : m_frames) frames.insert(node_frame.second);
         for (auto* framep : frames) delete framep;
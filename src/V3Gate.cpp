@@ -19,9 +19,13 @@
 // Perform constant optimization across the graph
 // Create VARSCOPEs for any variables we can rip out
 //
+// With --verilate-jobs, the logic driving each inlining candidate is
+// analysed in parallel first, and the analyses are then reused by the
+// serial inlining for as long as the logic is unchanged.
+//
 //*************************************************************************
 
-#include "V3PchAstNoMT.h"  // VL_MT_DISABLED_CODE_UNIT
+#include "V3PchAstMT.h"
 
 #include "V3Gate.h"
 
@@ -30,8 +34,10 @@
 #include "V3DupFinder.h"
 #include "V3Graph.h"
 #include "V3Stats.h"
+#include "V3ThreadPool.h"
 
 #include <list>
+#include <memory>
 #include <unordered_map>
 #include <unordered_set>
 
@@ -168,7 +174,11 @@ public:
                 vVtxp->clearReducibleAndDedupable("VirtIface");
                 vVtxp->setConsumed("VirtIface");
             }
-            if (vscp->varp()->isSigPublic()) {
+            if (vscp->varp()->isSigObservable()) {
+                // Readers can be optimized, but the value must be kept for VPI
+                vVtxp->clearDedupable("SigObservable");
+                vVtxp->setConsumed("SigObservable");
+            } else if (vscp->varp()->isSigPublic()) {
                 // Public signals shouldn't be changed, pli code might be messing with them
                 vVtxp->clearReducibleAndDedupable("SigPublic");
                 vVtxp->setConsumed("SigPublic");
@@ -682,8 +692,62 @@ class GateInline final {
     size_t m_statInlined = 0;  // Statistic tracking - signals inlined
     size_t m_statRefs = 0;  // Statistic tracking
     size_t m_statExcluded = 0;  // Statistic tracking
+    size_t m_statObservable = 0;  // Statistic tracking
+    // Analyses of logic blocks, reused while the logic is unchanged, with the buffersOnly
+    // setting they were made with. Shared, as an analysis in use may be invalidated.
+    std::unordered_map<const AstNode*, std::pair<bool, std::shared_ptr<const GateOkVisitor>>>
+        m_okVisitors;
 
     // METHODS
+    std::shared_ptr<const GateOkVisitor> analysis(AstNode* logicp, bool buffersOnly) {
+        auto& entry = m_okVisitors[logicp];
+        if (!entry.second || entry.first != buffersOnly) {
+            entry.first = buffersOnly;
+            entry.second = std::make_shared<const GateOkVisitor>(logicp, buffersOnly, false);
+        }
+        return entry.second;
+    }
+    static bool isCandidate(GateVarVertex* vVtxp) {
+        return vVtxp->inSize1() && vVtxp->reducible()
+               && vVtxp->inEdges().frontp()->fromp()->as<GateLogicVertex>()->reducible();
+    }
+    // Analyse the logic driving each candidate for inlining on the thread pool.
+    // GateOkVisitor only reads the tree, and each logic block is visited by one thread.
+    void analyzeInParallel() {
+        std::vector<std::pair<AstNode*, bool>> todo;  // Logic, and if buffersOnly
+        std::unordered_set<const AstNode*> seen;
+        for (V3GraphVertex& vtx : m_graph.vertices()) {
+            GateVarVertex* const vVtxp = vtx.cast<GateVarVertex>();
+            if (!vVtxp || !isCandidate(vVtxp)) continue;
+            AstNode* const logicp
+                = vVtxp->inEdges().frontp()->fromp()->as<GateLogicVertex>()->nodep();
+            if (seen.insert(logicp).second) todo.emplace_back(logicp, vVtxp->isClock());
+        }
+        std::vector<std::shared_ptr<const GateOkVisitor>> results(todo.size());
+        const size_t chunk = std::max<size_t>(
+            1024, todo.size() / (static_cast<size_t>(v3Global.opt.verilateJobs()) * 4));
+        {
+            V3ThreadScope threadScope;
+            for (size_t begin = 0; begin < todo.size(); begin += chunk) {
+                const size_t end = std::min(todo.size(), begin + chunk);
+                const auto* const todop = &todo;
+                auto* const resultsp = &results;
+                threadScope.enqueue([todop, resultsp, begin, end]() {
+                    for (size_t i = begin; i < end; ++i) {
+                        const std::pair<AstNode*, bool>& item = (*todop)[i];
+                        (*resultsp)[i] = std::make_shared<const GateOkVisitor>(
+                            item.first, item.second, false);
+                    }
+                });
+            }
+        }
+        for (size_t i = 0; i < todo.size(); ++i) {
+            m_okVisitors.emplace(todo[i].first,
+                                 std::make_pair(todo[i].second, std::move(results[i])));
+        }
+        UINFO(4, "  Gate inline analysed " << todo.size() << " logic blocks in parallel");
+    }
+
     static bool isCheapWide(const AstNodeExpr* exprp) {
         if (const AstSel* const selp = VN_CAST(exprp, Sel)) {
             if (selp->lsbConst() % VL_EDATASIZE != 0) return false;
@@ -727,6 +791,7 @@ class GateInline final {
 
     void commitSubstitutions(AstNode* logicp) {
         if (!m_hasPending.erase(logicp)) return;  // Had no pending substitutions
+        m_okVisitors.erase(logicp);  // Analysis is of the logic before substitution
 
         Substitutions& substitutions = m_substitutions(logicp);
         UASSERT_OBJ(!substitutions.empty(), logicp, "No pending substitutions");
@@ -791,23 +856,22 @@ class GateInline final {
             // vVtxp and it's driving logic might be deleted, so grab next up front
             vIt = ffToVarVtx(++vIt);
 
-            // Nothing to inline if no driver, or multiple drivers ...
-            if (!vVtxp->inSize1()) continue;
-
-            // Can't inline if non-reducible, etc
-            if (!vVtxp->reducible()) continue;
+            // Nothing to inline if no driver, or multiple drivers,
+            // or can't inline if non-reducible, etc
+            if (!isCandidate(vVtxp)) continue;
 
             // Grab the driving logic
             GateLogicVertex* const lVtxp
                 = vVtxp->inEdges().frontp()->fromp()->as<GateLogicVertex>();
-            if (!lVtxp->reducible()) continue;
             AstNode* const logicp = lVtxp->nodep();
 
             // Commit pending optimizations to driving logic, as we will re-analyze
             commitSubstitutions(logicp);
 
             // Can we eliminate?
-            const GateOkVisitor okVisitor{logicp, vVtxp->isClock(), false};
+            const std::shared_ptr<const GateOkVisitor> okVisitorp
+                = analysis(logicp, vVtxp->isClock());
+            const GateOkVisitor& okVisitor = *okVisitorp;
 
             // Was it ok?
             if (!okVisitor.isSimple()) continue;
@@ -890,6 +954,12 @@ class GateInline final {
                 for (AstVarScope* const newVscp : okVisitor.readVscps()) {
                     GateVarVertex* const varvertexp = m_graph.makeVarVertex(newVscp);
                     m_graph.addEdge(varvertexp, dstVtxp, 1);
+                    // Logic reading a newly clock variable may no longer be simple
+                    if (vVtxp->isClock() && !newVscp->varp()->isUsedClock()) {
+                        for (const V3GraphEdge& redge : varvertexp->outEdges()) {
+                            m_okVisitors.erase(redge.top()->as<GateLogicVertex>()->nodep());
+                        }
+                    }
                     // Propagate clock attribute onto generating node
                     varvertexp->propagateAttrClocksFrom(vVtxp);
                 }
@@ -899,11 +969,14 @@ class GateInline final {
                 ++m_statRefs;
             }
 
-            // If removed all usage
-            if (vVtxp->outEmpty()) {
+            // If removed all usage, unless the value is observed through VPI
+            if (vscp->varp()->isSigObservable()) {
+                ++m_statObservable;
+            } else if (vVtxp->outEmpty()) {
                 // Remove Variable vertex
                 VL_DO_DANGLING(vVtxp->unlinkDelete(&m_graph), vVtxp);
                 // Remove driving logic and vertex
+                m_okVisitors.erase(logicp);
                 VL_DO_DANGLING(logicp->unlinkFrBack()->deleteTree(), logicp);
                 VL_DO_DANGLING(lVtxp->unlinkDelete(&m_graph), lVtxp);
             }
@@ -914,6 +987,7 @@ class GateInline final {
         : m_graph{graph} {
         // Find gate interconnect and optimize
         graph.userClearVertices();  // vertex->user(): bool. Indicates we've set it as consumed
+        if (v3Global.opt.verilateJobs() > 1) analyzeInParallel();
         // Get rid of buffers first,
         optimizeSignals(false);
         // Then propagate more complicated equations
@@ -931,6 +1005,7 @@ class GateInline final {
         V3Stats::addStat("Optimizations, Gate sigs deleted", m_statInlined);
         V3Stats::addStat("Optimizations, Gate inputs replaced", m_statRefs);
         V3Stats::addStat("Optimizations, Gate excluded wide expressions", m_statExcluded);
+        V3Stats::addStat("Optimizations, Gate observable sigs kept", m_statObservable);
     }
 
 public:
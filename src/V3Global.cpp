@@ -23,6 +23,7 @@
 #include "V3File.h"
 #include "V3HierBlock.h"
 #include "V3LinkCells.h"
+#include "V3Os.h"
 #include "V3Parse.h"
 #include "V3Stats.h"
 #include "V3ThreadPool.h"
@@ -45,6 +46,17 @@ void V3Global::shutdown() {
 #endif
 }
 
+void V3Global::releaseNetlist() {
+    // Called before running the C++ build, so the compilers are not competing for memory with
+    // a netlist that will not be used again
+    UINFO(2, "Releasing netlist");
+    VL_DO_CLEAR(m_rootp->deleteTree(), m_rootp = nullptr);
+#ifdef VL_POOL_ALLOCATOR
+    V3PoolAllocator<AstNode>::releaseAll();
+#endif
+    V3Os::releaseFreeMemory();
+}
+
 void V3Global::checkTree() const { rootp()->checkTree(); }
 
 void V3Global::readFiles() {
@@ -75,6 +87,21 @@ void V3Global::readFiles() {
                          "Cannot find verilated_std.sv containing built-in std:: definitions: ");
     }
 
+    // Read all source files from the command line up front, in parallel
+    // (no error if not found here, that is reported when parsed)
+    {
+        std::vector<string> filenames;
+        for (const auto& filelib : v3Global.opt.vFiles()) {
+            const string filename = v3Global.opt.filePath(nullptr, filelib.filename(), "", "");
+            if (!filename.empty()) filenames.push_back(filename);
+        }
+        for (const auto& filelib : v3Global.opt.libraryFiles()) {
+            const string filename = v3Global.opt.filePath(nullptr, filelib.filename(), "", "");
+            if (!filename.empty()) filenames.push_back(filename);
+        }
+        if (filenames.size() > 1) filter.prefetch(filenames);
+    }
+
     // Read top module
     for (const auto& filelib : v3Global.opt.vFiles()) {
         parser.parseFile(new FileLine{FileLine::commandLineFilename()}, filelib.filename(), false,
@@ -139,9 +166,14 @@ void V3Global::dumpCheckGlobalTree(const string& stagename, int newNumber, bool
         v3Global.rootp()->dumpTreeDotFile(treeFilename + ".dot", doDump);
     }
     if (v3Global.opt.stats()) V3Stats::statsStage(stagename);
+    if (v3Global.opt.profVerilator()) V3Stats::profStage(stagename);
 
     if (doDump && v3Global.opt.debugEmitV()) V3EmitV::debugEmitV(treeFilename + ".v");
-    if (v3Global.opt.debugCheck() || dumpTreeEitherLevel()) {
+    // With --debug-check-interval, check only a sample of the stages, as
+    // the full tree check can dominate the run time; always check when dumping
+    static int s_checkStages = 0;
+    const bool sampled = ++s_checkStages % v3Global.opt.debugCheckInterval() == 0;
+    if ((v3Global.opt.debugCheck() && sampled) || dumpTreeEitherLevel()) {
         // Error check
         v3Global.rootp()->checkTree();
         // Broken isn't part of check tree because it can munge iterp's
@@ -146,6 +146,7 @@ public:
     V3Global() {}
     void boot();
     void shutdown();  // Release allocated resources
+    void releaseNetlist();  // Delete the netlist early, once nothing more is emitted from it
 
     // ACCESSORS (general)
     AstNetlist* rootp() const VL_MT_SAFE { return m_rootp; }
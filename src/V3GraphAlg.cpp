@@ -22,6 +22,7 @@
 #include "V3GraphAlg.h"
 
 #include "V3Global.h"
+#include "V3GraphCsr.h"
 #include "V3GraphPathChecker.h"
 #include "V3GraphStream.h"
 #include "V3Stats.h"
@@ -175,74 +176,87 @@ void V3Graph::weaklyConnected(V3EdgeFuncP edgeFuncp) { GraphAlgWeakly{this, edge
 // Changes user() and color()
 
 class GraphAlgStrongly final : GraphAlg<> {
-    uint32_t m_currentDfs = 0;  // DFS count
-    std::vector<V3GraphVertex*> m_callTrace;  // List of everything we hit processing so far
-
     void main() {
         // Use Pearce's algorithm to color the strongly connected components. For reference see
         // "An Improved Algorithm for Finding the Strongly Connected Components of a Directed
         // Graph", David J.Pearce, 2005
         //
-        // Node State:
-        //     Vertex::user     // DFS number indicating possible root of subtree, 0=not iterated
-        //     Vertex::color    // Output subtree number (fully processed)
+        // Runs on a V3GraphCsr snapshot, with an explicit DFS stack, so large graphs neither
+        // chase edge pointers nor overflow the call stack.
+        //
+        // Node State (indexed as the snapshot, written back to the vertices at the end):
+        //     dfsNum           // DFS number indicating possible root of subtree, 0=not iterated
+        //     color            // Output subtree number (fully processed)
+        const V3GraphCsr csr{*m_graphp, [this](V3GraphEdge* edgep) { return followEdge(edgep); }};
+        const uint32_t size = csr.size();
+        std::vector<uint32_t> dfsNum(size, 0);
+        std::vector<uint32_t> color(size, 0);
+        std::vector<uint32_t> callTrace;  // List of everything we hit processing so far
+
+        struct Frame final {
+            uint32_t m_vtx;  // Vertex being iterated
+            uint32_t m_edge;  // Next out edge to consider
+            uint32_t m_dfsNum;  // DFS number assigned on entry
+        };
+        std::vector<Frame> stack;
+        uint32_t currentDfs = 0;  // DFS count
+        const auto enter = [&](uint32_t vtx) {
+            const uint32_t thisDfsNum = currentDfs++;
+            dfsNum[vtx] = thisDfsNum;
+            stack.push_back(Frame{vtx, csr.outBegin(vtx), thisDfsNum});
+        };
 
-        // Clear info
-        for (V3GraphVertex& vertex : m_graphp->vertices()) {
-            vertex.color(0);
-            vertex.user(0);
-        }
         // Color graph
-        for (V3GraphVertex& vertex : m_graphp->vertices()) {
-            if (!vertex.user()) {
-                m_currentDfs++;
-                vertexIterate(&vertex);
+        for (uint32_t root = 0; root < size; ++root) {
+            if (dfsNum[root]) continue;
+            ++currentDfs;
+            enter(root);
+            while (!stack.empty()) {
+                Frame& frame = stack.back();
+                const uint32_t vtx = frame.m_vtx;
+                if (frame.m_edge < csr.outEnd(vtx)) {
+                    const uint32_t top = csr.outTarget(frame.m_edge);
+                    if (!dfsNum[top]) {  // Dest not computed yet, revisit this edge after
+                        enter(top);
+                        continue;
+                    }
+                    if (!color[top]) {  // Dest not in a component
+                        if (dfsNum[vtx] > dfsNum[top]) dfsNum[vtx] = dfsNum[top];
+                    }
+                    ++frame.m_edge;
+                    continue;
+                }
+                const uint32_t thisDfsNum = frame.m_dfsNum;
+                stack.pop_back();
+                if (dfsNum[vtx] == thisDfsNum) {  // New head of subtree
+                    color[vtx] = thisDfsNum;  // Mark as component
+                    while (!callTrace.empty() && dfsNum[callTrace.back()] >= thisDfsNum) {
+                        // Lower node is part of this subtree
+                        color[callTrace.back()] = thisDfsNum;
+                        callTrace.pop_back();
+                    }
+                } else {  // In another subtree (maybe...)
+                    callTrace.push_back(vtx);
+                }
             }
         }
+
         // If there's a single vertex of a color, it doesn't need a subgraph
         // This simplifies the consumer's code, and reduces graph debugging clutter
-        for (V3GraphVertex& vertex : m_graphp->vertices()) {
+        for (uint32_t vtx = 0; vtx < size; ++vtx) {
             bool onecolor = true;
-            for (V3GraphEdge& edge : vertex.outEdges()) {
-                if (followEdge(&edge)) {
-                    if (vertex.color() == edge.top()->color()) {
-                        onecolor = false;
-                        break;
-                    }
+            for (uint32_t edge = csr.outBegin(vtx); edge < csr.outEnd(vtx); ++edge) {
+                if (color[vtx] == color[csr.outTarget(edge)]) {
+                    onecolor = false;
+                    break;
                 }
             }
-            if (onecolor) vertex.color(0);
+            if (onecolor) color[vtx] = 0;
         }
-    }
 
-    void vertexIterate(V3GraphVertex* vertexp) {
-        const uint32_t thisDfsNum = m_currentDfs++;
-        vertexp->user(thisDfsNum);
-        vertexp->color(0);
-        for (V3GraphEdge& edge : vertexp->outEdges()) {
-            if (followEdge(&edge)) {
-                V3GraphVertex* top = edge.top();
-                if (!top->user()) {  // Dest not computed yet
-                    vertexIterate(top);
-                }
-                if (!top->color()) {  // Dest not in a component
-                    if (vertexp->user() > top->user()) vertexp->user(top->user());
-                }
-            }
-        }
-        if (vertexp->user() == thisDfsNum) {  // New head of subtree
-            vertexp->color(thisDfsNum);  // Mark as component
-            while (!m_callTrace.empty()) {
-                V3GraphVertex* popVertexp = m_callTrace.back();
-                if (popVertexp->user() >= thisDfsNum) {  // Lower node is part of this subtree
-                    m_callTrace.pop_back();
-                    popVertexp->color(thisDfsNum);
-                } else {
-                    break;
-                }
-            }
-        } else {  // In another subtree (maybe...)
-            m_callTrace.push_back(vertexp);
+        for (uint32_t vtx = 0; vtx < size; ++vtx) {
+            csr.vertexp(vtx)->user(dfsNum[vtx]);
+            csr.vertexp(vtx)->color(color[vtx]);
         }
     }
 
@@ -264,34 +278,59 @@ void V3Graph::stronglyConnected(V3EdgeFuncP edgeFuncp) { GraphAlgStrongly{this,
 class GraphAlgRank final : GraphAlg<> {
     void main() {
         // Rank each vertex, ignoring cutable edges
-        // Vertex::m_user begin: 1 indicates processing, 2 indicates completed
-        // Clear existing ranks
-        for (V3GraphVertex& vertex : m_graphp->vertices()) {
-            vertex.rank(0);
-            vertex.user(0);
-        }
-        for (V3GraphVertex& vertex : m_graphp->vertices()) {
-            if (!vertex.user()) {  //
-                vertexIterate(&vertex, 1);
+        // Runs on a V3GraphCsr snapshot, with an explicit DFS stack.
+        // Node State (indexed as the snapshot, written back to the vertices at the end):
+        //     state            // 1 indicates processing, 2 indicates completed
+        //     rank             // Rank assigned so far
+        const V3GraphCsr csr{*m_graphp, [this](V3GraphEdge* edgep) { return followEdge(edgep); }};
+        const uint32_t size = csr.size();
+        std::vector<uint32_t> state(size, 0);
+        std::vector<uint32_t> rank(size, 0);
+        std::vector<uint32_t> rankAdder(size);
+        for (uint32_t vtx = 0; vtx < size; ++vtx) rankAdder[vtx] = csr.vertexp(vtx)->rankAdder();
+        const auto writeBack = [&]() {
+            for (uint32_t vtx = 0; vtx < size; ++vtx) {
+                csr.vertexp(vtx)->user(state[vtx]);
+                csr.vertexp(vtx)->rank(rank[vtx]);
             }
-        }
-    }
+        };
 
-    void vertexIterate(V3GraphVertex* vertexp, uint32_t currentRank) {
+        struct Frame final {
+            uint32_t m_vtx;  // Vertex being iterated
+            uint32_t m_edge;  // Next out edge to follow
+        };
+        std::vector<Frame> stack;
         // Assign rank to each unvisited node
         // If larger rank is found, assign it and loop back through
         // If we hit a back node make a list of all loops
-        if (vertexp->user() == 1) {
-            m_graphp->loopsMessageCb(vertexp, m_edgeFuncp);
-            return;  // LCOV_EXCL_LINE  // gcc gprof bug misses this return
-        }
-        if (vertexp->rank() >= currentRank) return;  // Already processed it
-        vertexp->user(1);
-        vertexp->rank(currentRank);
-        for (V3GraphEdge& edge : vertexp->outEdges()) {
-            if (followEdge(&edge)) vertexIterate(edge.top(), currentRank + vertexp->rankAdder());
+        const auto enter = [&](uint32_t vtx, uint32_t currentRank) {
+            if (state[vtx] == 1) {
+                writeBack();  // Loop reporting looks at the vertices
+                m_graphp->loopsMessageCb(csr.vertexp(vtx), m_edgeFuncp);
+                return;
+            }
+            if (rank[vtx] >= currentRank) return;  // Already processed it
+            state[vtx] = 1;
+            rank[vtx] = currentRank;
+            stack.push_back(Frame{vtx, csr.outBegin(vtx)});
+        };
+
+        for (uint32_t root = 0; root < size; ++root) {
+            if (state[root]) continue;
+            enter(root, 1);
+            while (!stack.empty()) {
+                Frame& frame = stack.back();
+                const uint32_t vtx = frame.m_vtx;
+                if (frame.m_edge < csr.outEnd(vtx)) {
+                    const uint32_t top = csr.outTarget(frame.m_edge++);
+                    enter(top, rank[vtx] + rankAdder[vtx]);
+                    continue;
+                }
+                state[vtx] = 2;
+                stack.pop_back();
+            }
         }
-        vertexp->user(2);
+        writeBack();
     }
 
 public:
@@ -0,0 +1,75 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//*************************************************************************
+// DESCRIPTION: Verilator: Compressed sparse row snapshot of a V3Graph
+//
+// Code available from: https://verilator.org
+//
+//*************************************************************************
+//
+// Copyright 2025 by Wilson Snyder. This program is free software; you
+// can redistribute it and/or modify it under the terms of either the GNU
+// Lesser General Public License Version 3 or the Perl Artistic License
+// Version 2.0.
+// SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+//
+//*************************************************************************
+//
+// V3GraphCsr is a read-only copy of the topology of a V3Graph, for analysis
+// algorithms that traverse a large graph many times. Vertices are numbered
+// in vertex list order, and the followed out edges of all vertices are held
+// in one contiguous array, in edge list order, so a traversal walks arrays
+// of indices instead of chasing edge and vertex pointers. Algorithms keep
+// their per vertex state in vectors indexed the same way.
+//
+// The snapshot is invalid once the graph's vertices or edges change.
+//
+//*************************************************************************
+
+#ifndef VERILATOR_V3GRAPHCSR_H_
+#define VERILATOR_V3GRAPHCSR_H_
+
+#include "config_build.h"
+#include "verilatedos.h"
+
+#include "V3Graph.h"
+
+#include <vector>
+
+class V3GraphCsr final {
+    // MEMBERS
+    std::vector<V3GraphVertex*> m_vertexps;  // Vertices, by index
+    std::vector<uint32_t> m_outBegin;  // Index of first out edge of each vertex, plus end
+    std::vector<uint32_t> m_outTargets;  // Index of target vertex of each out edge
+
+public:
+    // CONSTRUCTORS
+    // Snapshot 'graph', keeping only the edges for which 'follow(edgep)' is true.
+    // Side-effect: changes user() of vertices, to their index.
+    template <typename T_Follow>
+    V3GraphCsr(V3Graph& graph, T_Follow follow) {
+        uint32_t n = 0;
+        for (V3GraphVertex& vertex : graph.vertices()) {
+            vertex.user(n++);
+            m_vertexps.push_back(&vertex);
+        }
+        m_outBegin.reserve(n + 1);
+        for (V3GraphVertex* const vertexp : m_vertexps) {
+            m_outBegin.push_back(static_cast<uint32_t>(m_outTargets.size()));
+            for (V3GraphEdge& edge : vertexp->outEdges()) {
+                if (follow(&edge)) m_outTargets.push_back(edge.top()->user());
+            }
+        }
+        m_outBegin.push_back(static_cast<uint32_t>(m_outTargets.size()));
+    }
+    VL_UNCOPYABLE(V3GraphCsr);
+
+    // METHODS
+    uint32_t size() const { return static_cast<uint32_t>(m_vertexps.size()); }
+    V3GraphVertex* vertexp(uint32_t index) const { return m_vertexps[index]; }
+    // Range of indices into outTarget() of the followed out edges of a vertex
+    uint32_t outBegin(uint32_t index) const { return m_outBegin[index]; }
+    uint32_t outEnd(uint32_t index) const { return m_outBegin[index + 1]; }
+    uint32_t outTarget(uint32_t edgeIndex) const { return m_outTargets[edgeIndex]; }
+};
+
+#endif  // Guard
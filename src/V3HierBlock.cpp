@@ -95,6 +95,8 @@
 #include "V3Stats.h"
 #include "V3String.h"
 
+#include <algorithm>
+#include <cstdio>
 #include <memory>
 #include <sstream>
 #include <utility>
@@ -398,6 +400,25 @@ void V3HierBlockPlan::registerUsage(const AstNodeModule* parentp, const AstNodeM
     }
 }
 
+// Estimate the cost of Verilating a hierarchical block, by the node count of the modules it
+// contains, excluding other hierarchical blocks that are Verilated separately
+static uint64_t hierBlockCost(const AstNodeModule* modp) {
+    uint64_t cost = 0;
+    std::unordered_set<const AstNodeModule*> visited{modp};
+    std::vector<const AstNodeModule*> stack{modp};
+    while (!stack.empty()) {
+        const AstNodeModule* const currp = stack.back();
+        stack.pop_back();
+        cost += currp->nodeCount();
+        currp->foreach([&](const AstCell* cellp) {
+            const AstNodeModule* const childp = cellp->modp();
+            if (!childp || childp->hierBlock()) return;
+            if (visited.insert(childp).second) stack.push_back(childp);
+        });
+    }
+    return cost;
+}
+
 void V3HierBlockPlan::createPlan(AstNetlist* nodep) {
     // When processing a hierarchical block, no need to create a plan anymore.
     if (v3Global.opt.hierChild()) return;
@@ -413,6 +434,7 @@ void V3HierBlockPlan::createPlan(AstNetlist* nodep) {
 
     std::unique_ptr<V3HierBlockPlan> planp(new V3HierBlockPlan);
     { HierBlockUsageCollectVisitor{planp.get(), nodep}; }
+    for (const auto& itr : planp->m_blocks) itr.second->cost(hierBlockCost(itr.first));
 
     V3Stats::addStat("HierBlock, Hierarchical blocks", planp->m_blocks.size());
 
@@ -461,6 +483,33 @@ V3HierBlockPlan::HierVector V3HierBlockPlan::hierBlocksSorted() const {
     return sorted;
 }
 
+V3HierBlockPlan::HierVector V3HierBlockPlan::hierBlocksScheduled() const {
+    // A block's parents are Verilated only after it, so the critical path from a block is its
+    // own cost, plus the longest critical path of its parents. Compute it parents first.
+    const HierVector sorted = hierBlocksSorted();
+    std::unordered_map<const V3HierBlock*, uint64_t> critical;
+    for (const V3HierBlock* const blockp : vlstd::reverse_view(sorted)) {
+        uint64_t above = 0;
+        for (const V3HierBlock* const parentp : blockp->parents()) {
+            above = std::max(above, critical.at(parentp));
+        }
+        critical[blockp] = blockp->cost() + above;
+    }
+    HierVector scheduled = sorted;
+    std::stable_sort(scheduled.begin(), scheduled.end(),
+                     [&](const V3HierBlock* ap, const V3HierBlock* bp) {
+                         const uint64_t a = critical.at(ap);
+                         const uint64_t b = critical.at(bp);
+                         if (a != b) return a > b;
+                         return ap->hierPrefix() < bp->hierPrefix();
+                     });
+    for (const V3HierBlock* const blockp : scheduled) {
+        UINFO(3, "Schedule " << blockp->modp()->prettyNameQ() << " cost " << blockp->cost()
+                             << " critical path " << critical.at(blockp));
+    }
+    return scheduled;
+}
+
 void V3HierBlockPlan::writeCommandArgsFiles(bool forCMake) const {
     for (const_iterator it = begin(); it != end(); ++it) {
         it->second->writeCommandArgsFile(forCMake);
@@ -505,3 +554,96 @@ string V3HierBlockPlan::topCommandArgsFilename(bool forCMake) {
 void V3HierBlockPlan::writeParametersFiles() const {
     for (const auto& block : *this) block.second->writeParametersFile();
 }
+
+//######################################################################
+// V3HierBlockCache
+
+static string V3HierCacheEntryDir(const string& key) {
+    return v3Global.opt.hierCache() + "/" + key;
+}
+
+static bool V3HierCacheCopy(const string& fromFilename, const string& toFilename) {
+    const std::unique_ptr<std::ifstream> ifp{V3File::new_ifstream_nodepend(fromFilename)};
+    if (ifp->fail()) return false;
+    const std::unique_ptr<std::ofstream> ofp{V3File::new_ofstream_nodepend(toFilename)};
+    if (ofp->fail()) return false;
+    *ofp << ifp->rdbuf();
+    return !ofp->fail();
+}
+
+static void V3HierCacheWriteEntryFile(const string& key) {
+    const std::unique_ptr<std::ofstream> ofp{
+        V3File::new_ofstream(V3HierBlockCache::entryFilename())};
+    *ofp << V3Os::filenameRealPath(V3HierCacheEntryDir(key)) << "\n";
+}
+
+string V3HierBlockCache::entryFilename() {
+    return v3Global.opt.makeDir() + "/" + v3Global.opt.prefix() + "__hierCache.txt";
+}
+
+bool V3HierBlockCache::restore(const string& key) {
+    const string entryDir = V3HierCacheEntryDir(key);
+    // The manifest is written last, so if present, the entry is complete
+    const std::unique_ptr<std::ifstream> ifp{
+        V3File::new_ifstream_nodepend(entryDir + "/manifest")};
+    if (ifp->fail()) return false;
+    std::vector<string> filenames;
+    while (!ifp->eof()) {
+        const string filename = V3Os::getline(*ifp);
+        if (!filename.empty()) filenames.push_back(filename);
+    }
+    UINFO(1, "--hierarchical-cache: Restoring " << filenames.size() << " files from "
+                                                << entryDir);
+    V3File::createMakeDir();
+    for (const string& filename : filenames) {
+        const string toFilename = v3Global.opt.makeDir() + "/" + filename;
+        if (!V3HierCacheCopy(entryDir + "/" + filename, toFilename)) {
+            v3fatal("Can't restore hierarchical block cache file: " << toFilename);
+        }
+    }
+    V3HierCacheWriteEntryFile(key);
+    // The library is added by the build once compiled. Copy it last, so it is newer than
+    // the makefile it depends on, and is not rebuilt.
+    const string libFilename = v3Global.opt.libCreateName(false);
+    V3HierCacheCopy(entryDir + "/" + libFilename, v3Global.opt.makeDir() + "/" + libFilename);
+    return true;
+}
+
+void V3HierBlockCache::store(const string& key) {
+    const string entryDir = V3HierCacheEntryDir(key);
+    // Fill a temporary directory, then rename it into place, so concurrent runs, possibly on
+    // other hosts sharing the cache, only ever see complete entries
+    const string tmpDir = entryDir + ".tmp" + VHashSha256{V3Os::trueRandom(16)}.digestSymbol();
+    V3Os::createDir(v3Global.opt.hierCache());
+    V3Os::createDir(tmpDir);
+    std::vector<string> filenames;
+    const auto removeTmpDir = [&]() {
+        for (const string& filename : filenames) std::remove((tmpDir + "/" + filename).c_str());
+        std::remove((tmpDir + "/manifest").c_str());
+        std::remove(tmpDir.c_str());
+    };
+    const string makeDir = v3Global.opt.makeDir() + "/";
+    // The times recorded for --skip-identical refer to the files of this run
+    const string timesFilename = v3Global.opt.prefix() + "__verFiles.dat";
+    for (const string& target : V3File::getAllTargets()) {
+        if (target.compare(0, makeDir.size(), makeDir) != 0) continue;
+        const string filename = target.substr(makeDir.size());
+        if (filename.find('/') != string::npos || filename == timesFilename) continue;
+        if (!V3HierCacheCopy(target, tmpDir + "/" + filename)) {
+            // Not an error, the block is just not cached
+            UINFO(1, "--hierarchical-cache: Can't write " << tmpDir << "/" << filename);
+            removeTmpDir();
+            return;
+        }
+        filenames.push_back(filename);
+    }
+    {
+        const std::unique_ptr<std::ofstream> ofp{
+            V3File::new_ofstream_nodepend(tmpDir + "/manifest")};
+        for (const string& filename : filenames) *ofp << filename << "\n";
+    }
+    // Fails if another run stored the same outputs meanwhile, which is just as good
+    if (std::rename(tmpDir.c_str(), entryDir.c_str()) != 0) removeTmpDir();
+    UINFO(1, "--hierarchical-cache: Stored " << filenames.size() << " files to " << entryDir);
+    V3HierCacheWriteEntryFile(key);
+}
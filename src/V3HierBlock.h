@@ -78,6 +78,8 @@ private:
     HierBlockSet m_children;
     // Parameters that are overridden by #(.param(value)) syntax.
     const V3HierBlockParams m_params;
+    // Estimated cost of Verilating this block, the node count of its modules
+    uint64_t m_cost = 0;
 
     // METHODS
     VL_UNCOPYABLE(V3HierBlock);
@@ -99,6 +101,8 @@ public:
     const HierBlockSet& children() const { return m_children; }
     const V3HierBlockParams& params() const { return m_params; }
     const AstNodeModule* modp() const { return m_modp; }
+    uint64_t cost() const { return m_cost; }
+    void cost(uint64_t value) { m_cost = value; }
 
     // For emitting Makefile and CMakeLists.txt
     V3StringList commandArgs(bool forCMake) const VL_MT_DISABLED;
@@ -144,6 +148,9 @@ public:
     // Returns all hierarchical blocks that sorted in leaf-first order.
     // Latter block refers only already appeared hierarchical blocks.
     HierVector hierBlocksSorted() const VL_MT_DISABLED;
+    // Returns all hierarchical blocks in the order their builds should be started, the block
+    // with the longest chain of dependent Verilations above it first.
+    HierVector hierBlocksScheduled() const VL_MT_DISABLED;
 
     // Write command line arguments to .f files for child Verilation run
     void writeCommandArgsFiles(bool forCMake) const VL_MT_DISABLED;
@@ -153,4 +160,18 @@ public:
     static void createPlan(AstNetlist* nodep) VL_MT_DISABLED;
 };
 
+//######################################################################
+
+// Content addressed cache of the outputs of hierarchical block Verilation, see
+// --hierarchical-cache. The key is a hash of everything the outputs depend on.
+class V3HierBlockCache final {
+public:
+    // File in a hierarchical child's -Mdir holding the path of its cache entry
+    static string entryFilename() VL_MT_DISABLED;
+    // Copy the outputs of this hierarchical child run from the cache, if present
+    static bool restore(const string& key) VL_MT_DISABLED;
+    // Copy the outputs of this hierarchical child run to the cache
+    static void store(const string& key) VL_MT_DISABLED;
+};
+
 #endif  // guard
@@ -175,11 +175,14 @@ class InlineMarkVisitor final : public VNVisitor {
         iterateChildren(nodep);
     }
     void visit(AstNodeAssign* nodep) override {
-        // Don't count assignments, as they'll likely flatten out
+        // Don't count plain copies, as they'll likely flatten out. Assignments computing
+        // something are real logic, which inlining would duplicate for each instance.
         // Still need to iterate though to nullify VarXRefs
         const int oldcnt = m_modp->user4();
         iterateChildren(nodep);
-        m_modp->user4(oldcnt);
+        if (VN_IS(nodep->rhsp(), NodeVarRef) || VN_IS(nodep->rhsp(), Const)) {
+            m_modp->user4(oldcnt);
+        }
     }
     void visit(AstNetlist* nodep) override {
         // Build ModuleState, user2, and user4 for all modules.
@@ -19,10 +19,85 @@
 
 #include "V3InstrCount.h"
 
+#include <fstream>
 #include <iomanip>
+#include <sstream>
 
 VL_DEFINE_DEBUG_FUNCTIONS;
 
+//######################################################################
+// Node costs measured on the target machine, from --instr-count-table
+
+class InstrCountTable final {
+    // TYPES
+    struct Cost final {
+        int m_narrow = -1;  // Cost when result fits in 64 bits, -1 if not given
+        int m_perWord = -1;  // Cost per 32-bit word when wide, -1 if not given
+    };
+
+    // MEMBERS
+    std::array<Cost, VNType::_ENUM_END> m_costs;  // Cost of each node type
+    Cost m_dpiCost;  // Cost of a call to a DPI import
+    bool m_empty = true;  // No table given
+
+    // METHODS
+    void read(const std::string& filename) {
+        std::ifstream is{filename};
+        if (!is) {
+            v3fatal("Can't read --instr-count-table file: " << filename);
+            return;
+        }
+        std::map<std::string, Cost*> names;
+        for (int i = 0; i < VNType::_ENUM_END; ++i) names[VNType{i}.ascii()] = &m_costs[i];
+        names["DPICALL"] = &m_dpiCost;
+        std::string line;
+        int lineno = 0;
+        while (std::getline(is, line)) {
+            ++lineno;
+            // <NODETYPE> <narrow cost> [<cost per word>]
+            line = line.substr(0, line.find('#'));
+            std::istringstream iss{line};
+            std::string name;
+            if (!(iss >> name)) continue;
+            Cost cost;
+            const auto it = names.find(name);
+            if (!(iss >> cost.m_narrow) || cost.m_narrow < 0 || it == names.end()) {
+                v3error("Malformed --instr-count-table entry at " << filename << ":" << lineno
+                                                                  << ": " << line);
+                continue;
+            }
+            if (!(iss >> cost.m_perWord)) cost.m_perWord = -1;
+            *it->second = cost;
+            m_empty = false;
+        }
+        UINFO(2, "Read instruction cost table " << filename);
+    }
+
+    explicit InstrCountTable(const std::string& filename) {
+        if (!filename.empty()) read(filename);
+    }
+
+public:
+    static const InstrCountTable& s() {
+        static const InstrCountTable s_table{v3Global.opt.instrCountTable()};
+        return s_table;
+    }
+    // Cost of node itself, excluding its children
+    int cost(const AstNode* nodep) const {
+        if (m_empty) return nodep->instrCount();
+        const Cost* costp = &m_costs[nodep->type()];
+        // Replaces --instr-count-dpi, which is the cost of the imported function
+        if (const AstCFunc* const funcp = VN_CAST(nodep, CFunc)) {
+            if (funcp->dpiImportPrototype()) costp = &m_dpiCost;
+        }
+        const int words = nodep->widthInstrs();
+        if (words > 1) {
+            return costp->m_perWord >= 0 ? costp->m_perWord * words : nodep->instrCount();
+        }
+        return costp->m_narrow >= 0 ? costp->m_narrow : nodep->instrCount();
+    }
+};
+
 /// Estimate the instruction cost for executing all logic within and below
 /// a given AST node. Note this estimates the number of instructions we'll
 /// execute, not the number we'll generate. That is, for conditionals,
@@ -107,7 +182,7 @@ private:
         // debug prints to show local cost of each subtree, so we can see a
         // hierarchical view of the cost when in debug mode.
         const uint32_t savedCount = m_instrCount;
-        m_instrCount = nodep->instrCount();
+        m_instrCount = InstrCountTable::s().cost(nodep);
         return savedCount;
     }
     void endVisitBase(uint32_t savedCount, AstNode* nodep) {
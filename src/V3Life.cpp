@@ -21,15 +21,23 @@
 //          ASSIGN(X,...) IF( ..., ASSIGN(X,...), ASSIGN(X,...)) => deletes first
 //          We don't do the opposite yet though (remove assigns in if followed by outside if)
 //
+//      With --verilate-jobs, entry point functions and procedures that
+//      call no common functions are analysed in parallel, and the
+//      constant folding of assignments that had constants substituted
+//      is deferred until all threads finish.
+//
 //*************************************************************************
 
-#include "V3PchAstNoMT.h"  // VL_MT_DISABLED_CODE_UNIT
+#include "V3PchAstMT.h"
 
 #include "V3Life.h"
 
 #include "V3Const.h"
 #include "V3Stats.h"
+#include "V3ThreadPool.h"
 
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 VL_DEFINE_DEBUG_FUNCTIONS;
@@ -38,23 +46,46 @@ VL_DEFINE_DEBUG_FUNCTIONS;
 // Structure for global state
 
 class LifeState final {
-    // NODE STATE
-    //   See below
-    const VNUser1InUse m_inuser1;
-
     // STATE
+    const bool m_deferFold;  // Fold substituted constants later, as running in parallel
+    std::vector<AstNodeAssign*> m_foldps;  // Assignments to fold, in order found
+    std::unordered_set<const AstNode*> m_foldSet;  // Members of m_foldps not since deleted
+
 public:
     VDouble0 m_statAssnDel;  // Statistic tracking
     VDouble0 m_statAssnCon;  // Statistic tracking
     VDouble0 m_statCResetDel;  // Statistic tracking
 
     // CONSTRUCTORS
-    LifeState() = default;
+    explicit LifeState(bool deferFold)
+        : m_deferFold{deferFold} {}
     ~LifeState() {
         V3Stats::addStatSum("Optimizations, Lifetime assign deletions", m_statAssnDel);
         V3Stats::addStatSum("Optimizations, Lifetime creset deletions", m_statCResetDel);
         V3Stats::addStatSum("Optimizations, Lifetime constant prop", m_statAssnCon);
     }
+    VL_UNCOPYABLE(LifeState);
+    VL_UNMOVABLE(LifeState);
+
+    // METHODS
+    // Constant fold the RHS of an assignment after constants were substituted into it
+    void fold(AstNodeAssign* nodep) {
+        if (!m_deferFold) {
+            V3Const::constifyEdit(nodep->rhsp());  // rhsp may change
+        } else if (m_foldSet.emplace(nodep).second) {
+            m_foldps.push_back(nodep);
+        }
+    }
+    // A statement is about to be deleted
+    void removed(const AstNode* nodep) { m_foldSet.erase(nodep); }
+    // Fold the deferred assignments, called once no other threads run
+    void foldDeferred() {
+        for (AstNodeAssign* const nodep : m_foldps) {
+            if (m_foldSet.count(nodep)) V3Const::constifyEdit(nodep->rhsp());
+        }
+        m_foldps.clear();
+        m_foldSet.clear();
+    }
 };
 
 //######################################################################
@@ -121,10 +152,6 @@ public:
 // Structure for all variables under a given meta-basic block
 
 class LifeBlock final {
-    // NODE STATE
-    // Cleared each AstIf:
-    //   AstVarScope::user1()   -> int.       Used in combining to detect duplicates
-
     // LIFE MAP
     //  For each basic block, we'll make a new map of what variables that if/else is changing
     using LifeMap = std::unordered_map<AstVarScope*, LifeVarEntry>;
@@ -154,6 +181,7 @@ public:
                 // above our current iteration point.
                 if (debug() > 4) oldassp->dumpTree("-      REMOVE/SAMEBLK: ");
                 entp->complexAssign();
+                m_statep->removed(oldassp);
                 oldassp->unlinkFrBack();
                 if (VN_IS(oldassp, CReset)) {
                     ++m_statep->m_statCResetDel;
@@ -202,7 +230,8 @@ public:
         const auto pair = m_map.emplace(nodep, LifeVarEntry::CONSUMED{});
         if (!pair.second) {
             if (AstConst* const constp = pair.first->second.constNodep()) {
-                if (!varrefp->varp()->isSigPublic() && !varrefp->varp()->sensIfacep()) {
+                if ((!varrefp->varp()->isSigPublic() || varrefp->varp()->isSigObservable())
+                    && !varrefp->varp()->sensIfacep()) {
                     // Aha, variable is constant; substitute in.
                     // We'll later constant propagate
                     UINFO(4, "     replaceconst: " << varrefp);
@@ -247,15 +276,14 @@ public:
         // Find any common sets on both branches of IF and propagate upwards
         // life1p->lifeDump();
         // life2p->lifeDump();
-        AstNode::user1ClearTree();  // user1p() used on entire tree
-        for (auto& itr : life1p->m_map) {
-            // When the if branch sets a var before it's used, mark that variable
-            if (itr.second.setBeforeUse()) itr.first->user1(1);
-        }
+        // Not AstVarScope::user1, as other threads may be analysing other functions
         for (auto& itr : life2p->m_map) {
             // When the else branch sets a var before it's used
             AstVarScope* const nodep = itr.first;
-            if (itr.second.setBeforeUse() && nodep->user1()) {
+            if (!itr.second.setBeforeUse()) continue;
+            // And the if branch sets it before it's used
+            const auto it1 = life1p->m_map.find(nodep);
+            if (it1 != life1p->m_map.end() && it1->second.setBeforeUse()) {
                 // Both branches set the var, we can remove the assignment before the IF.
                 UINFO(4, "DUALBRANCH " << nodep);
                 const auto itab = m_map.find(nodep);
@@ -331,7 +359,7 @@ class LifeVisitor final : public VNVisitor {
         if (m_lifep->replaced()) {
             // We changed something, try to constant propagate, but don't delete the
             // assignment as we still need nodep to remain.
-            V3Const::constifyEdit(nodep->rhsp());  // rhsp may change
+            m_statep->fold(nodep);
         }
         // Has to be direct assignment without any EXTRACTing.
         if (VN_IS(nodep->lhsp(), VarRef) && !m_sideEffect && !m_noopt) {
@@ -499,18 +527,16 @@ class LifeTopVisitor final : public VNVisitor {
     // finding code within.
 private:
     // STATE
-    LifeState* const m_statep;  // Current state
+    std::vector<AstNode*> m_rootps;  // Entry point functions and procedures, in tree order
 
     // VISITORS
     void visit(AstCFunc* nodep) override {
-        if (nodep->entryPoint()) {
-            // Usage model 1: Simulate all C code, doing lifetime analysis
-            LifeVisitor{nodep, m_statep};
-        }
+        // Usage model 1: Simulate all C code, doing lifetime analysis
+        if (nodep->entryPoint()) m_rootps.push_back(nodep);
     }
     void visit(AstNodeProcedure* nodep) override {
         // Usage model 2: Cleanup basic blocks
-        LifeVisitor{nodep, m_statep};
+        m_rootps.push_back(nodep);
     }
     void visit(AstVar*) override {}  // Accelerate
     void visit(AstNodeStmt*) override {}  // Accelerate
@@ -519,11 +545,57 @@ private:
 
 public:
     // CONSTRUCTORS
-    LifeTopVisitor(AstNetlist* nodep, LifeState* statep)
-        : m_statep{statep} {
-        iterate(nodep);
-    }
+    explicit LifeTopVisitor(AstNetlist* nodep) { iterate(nodep); }
     ~LifeTopVisitor() override = default;
+    const std::vector<AstNode*>& rootps() const { return m_rootps; }
+};
+
+//######################################################################
+// Partition roots that may be analysed in parallel
+
+class LifeGroups final {
+    // LifeVisitor edits the non-entry functions a root calls, so roots calling a common
+    // function must be analysed by the same thread
+
+    // STATE
+    std::vector<size_t> m_parent;  // Union-find forest over root indices
+
+    // METHODS
+    size_t find(size_t i) {
+        while (m_parent[i] != i) i = m_parent[i] = m_parent[m_parent[i]];
+        return i;
+    }
+
+public:
+    std::vector<std::vector<AstNode*>> m_groups;  // Output groups, in order of first root
+
+    // CONSTRUCTORS
+    explicit LifeGroups(const std::vector<AstNode*>& rootps) {
+        m_parent.resize(rootps.size());
+        for (size_t i = 0; i < rootps.size(); ++i) m_parent[i] = i;
+        std::unordered_map<const AstCFunc*, size_t> owners;  // Callee -> first calling root
+        for (size_t i = 0; i < rootps.size(); ++i) {
+            std::unordered_set<const AstCFunc*> visited;
+            std::vector<const AstNode*> todo{rootps[i]};
+            while (!todo.empty()) {
+                const AstNode* const nodep = todo.back();
+                todo.pop_back();
+                nodep->foreach([&](const AstNodeCCall* callp) {
+                    const AstCFunc* const funcp = callp->funcp();
+                    if (funcp->entryPoint() || !visited.emplace(funcp).second) return;
+                    const auto pair = owners.emplace(funcp, i);
+                    if (!pair.second) m_parent[find(i)] = find(pair.first->second);
+                    todo.push_back(funcp);
+                });
+            }
+        }
+        std::unordered_map<size_t, size_t> groupIndex;  // Union-find root -> m_groups index
+        for (size_t i = 0; i < rootps.size(); ++i) {
+            const auto pair = groupIndex.emplace(find(i), m_groups.size());
+            if (pair.second) m_groups.emplace_back();
+            m_groups[pair.first->second].push_back(rootps[i]);
+        }
+    }
 };
 
 //######################################################################
@@ -531,9 +603,28 @@ public:
 
 void V3Life::lifeAll(AstNetlist* nodep) {
     UINFO(2, __FUNCTION__ << ":");
-    {
-        LifeState state;
-        LifeTopVisitor{nodep, &state};
+    const std::vector<AstNode*> rootps = LifeTopVisitor{nodep}.rootps();
+    if (v3Global.opt.verilateJobs() <= 1) {
+        LifeState state{false};
+        for (AstNode* const rootp : rootps) LifeVisitor{rootp, &state};
+    } else {
+        const LifeGroups groups{rootps};
+        UINFO(4, "  Life groups " << groups.m_groups.size() << " roots " << rootps.size());
+        std::vector<std::unique_ptr<LifeState>> states;
+        for (size_t i = 0; i < groups.m_groups.size(); ++i) {
+            states.emplace_back(new LifeState{true});
+        }
+        {
+            V3ThreadScope threadScope;
+            for (size_t i = 0; i < groups.m_groups.size(); ++i) {
+                LifeState* const statep = states[i].get();
+                const std::vector<AstNode*>* const groupp = &groups.m_groups[i];
+                threadScope.enqueue([statep, groupp]() {
+                    for (AstNode* const rootp : *groupp) LifeVisitor{rootp, statep};
+                });
+            }
+        }
+        for (const std::unique_ptr<LifeState>& statep : states) statep->foldDeferred();
     }  // Destruct before checking
     VIsCached::clearCacheTree();  // Removing assignments may affect isPure
     V3Global::dumpCheckGlobalTree("life", 0, dumpTreeEitherLevel() >= 3);
@@ -149,6 +149,30 @@ private:
     // TYPES
     using ScopeAliasMap = std::unordered_map<VSymEnt*, VSymEnt*>;
     using IfaceModSyms = std::vector<std::pair<AstIface*, VSymEnt*>>;
+    // findDotted arguments, and results, for DottedCache
+    struct DottedKey final {
+        VSymEnt* m_lookupSymp;
+        std::string m_dotname;
+        bool m_firstId;
+        bool operator==(const DottedKey& that) const {
+            return m_lookupSymp == that.m_lookupSymp && m_firstId == that.m_firstId
+                   && m_dotname == that.m_dotname;
+        }
+    };
+    struct DottedKeyHash final {
+        size_t operator()(const DottedKey& key) const {
+            return (V3Hash{key.m_dotname}
+                    + V3Hash{reinterpret_cast<uint64_t>(key.m_lookupSymp)}
+                    + V3Hash{static_cast<uint32_t>(key.m_firstId)})
+                .value();
+        }
+    };
+    struct DottedResult final {
+        VSymEnt* m_resultp;
+        VSymEnt* m_okSymp;
+        std::string m_baddot;
+    };
+    using DottedCache = std::unordered_map<DottedKey, DottedResult, DottedKeyHash>;
 
     static LinkDotState* s_errorThisp;  // Last self, for error reporting only
 
@@ -163,6 +187,8 @@ private:
     std::array<ScopeAliasMap, SAMN__MAX> m_scopeAliasMap;  // Map of <lhs,rhs> aliases
     std::vector<VSymEnt*> m_ifaceVarSyms;  // List of AstIfaceRefDType's to be imported
     IfaceModSyms m_ifaceModSyms;  // List of AstIface+Symbols to be processed
+    DottedCache m_dottedCache;  // Resolved findDotted lookups
+    uint64_t m_dottedCacheEditCount = 0;  // VSymEnt::editCount() m_dottedCache is valid for
     const VLinkDotStep m_step;  // Operational step
 
 public:
@@ -630,11 +656,9 @@ private:
         return findp;
     }
 
-public:
-    VSymEnt* findDotted(FileLine* refLocationp, VSymEnt* lookupSymp, const string& dotname,
-                        string& baddot, VSymEnt*& okSymp, bool firstId) {
-        // Given a dotted hierarchy name, return where in scope it is
-        // Note when dotname=="" we just fall through and return lookupSymp
+    VSymEnt* findDottedUncached(FileLine* refLocationp, VSymEnt* lookupSymp,
+                                const string& dotname, string& baddot, VSymEnt*& okSymp,
+                                bool firstId) {
         UINFO(8, "    dottedFind se" << cvtToHex(lookupSymp) << " '" << dotname << "'");
         string leftname = dotname;
         okSymp = lookupSymp;  // So can list bad scopes
@@ -742,6 +766,38 @@ public:
         return lookupSymp;
     }
 
+public:
+    VSymEnt* findDotted(FileLine* refLocationp, VSymEnt* lookupSymp, const string& dotname,
+                        string& baddot, VSymEnt*& okSymp, bool firstId) {
+        // Given a dotted hierarchy name, return where in scope it is
+        // Note when dotname=="" we just fall through and return lookupSymp
+        if (dotname.empty()) {
+            okSymp = lookupSymp;
+            return lookupSymp;
+        }
+        // The same references are resolved repeatedly, e.g. from every instance of a module,
+        // so remember the lookups, until the symbol tables next change
+        if (m_dottedCacheEditCount != VSymEnt::editCount()) {
+            if (!m_dottedCache.empty()) DottedCache{}.swap(m_dottedCache);  // Frees buckets
+            m_dottedCacheEditCount = VSymEnt::editCount();
+        }
+        DottedKey key{lookupSymp, dotname, firstId};
+        const auto it = m_dottedCache.find(key);
+        if (it != m_dottedCache.end()) {
+            okSymp = it->second.m_okSymp;
+            baddot = it->second.m_baddot;
+            return it->second.m_resultp;
+        }
+        const int errors = V3Error::errorCount();
+        VSymEnt* const resultp
+            = findDottedUncached(refLocationp, lookupSymp, dotname, baddot, okSymp, firstId);
+        // Errors are reported against the reference, so those lookups must be repeated
+        if (V3Error::errorCount() == errors) {
+            m_dottedCache.emplace(std::move(key), DottedResult{resultp, okSymp, baddot});
+        }
+        return resultp;
+    }
+
     static string removeLastInlineScope(const string& name) {
         string out = name;
         const string dot = "__DOT__";
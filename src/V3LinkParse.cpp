@@ -346,6 +346,8 @@ class LinkParseVisitor final : public VNVisitor {
         if (v3Global.opt.anyPublicFlat() && nodep->varType().isVPIAccessible()) {
             if (v3Global.opt.publicFlatRW()) {
                 nodep->sigUserRWPublic(true);
+            } else if (v3Global.opt.publicFlatRd()) {
+                nodep->sigUserRdPublic(true);
             } else if (v3Global.opt.publicParams() && nodep->isParam()) {
                 nodep->sigUserRWPublic(true);
             } else if (m_modp && v3Global.opt.publicDepth()) {
@@ -19,6 +19,14 @@
 //             if only referenced in one CFUNC, make it local
 //          VARSCOPE
 //             if non-public, always written before used, make it local
+//             (in every referencing function, if none of them can call
+//             another, so values never flow between them through the
+//             variable), and remove the now dead stores in referencing
+//             functions that never read it
+//      All functions without calls:
+//          VARREF (module variable, referenced often)
+//             copy into a local on entry, and back on exit if written, so
+//             the C++ compiler can keep it in a register
 //
 //*************************************************************************
 
@@ -39,7 +47,7 @@ VL_DEFINE_DEBUG_FUNCTIONS;
 class LocalizeVisitor final : public VNVisitor {
     // NODE STATE
     //  AstVarScope::user1()    ->  Bool indicating VarScope is not optimizable.
-    //  AstCFunc::user1()       ->  Bool indicating CFunc is not a leaf function.
+    //  AstCFunc::user1()       ->  Bool indicating CFunc might suspend (contains a CAwait).
     //  AstVarScope::user2()    ->  Bool indicating VarScope was fully assigned in the current
     //                              function.
     //  AstVarScope::user3p()   ->  Set of CFuncs referencing this VarScope. (via m_accessors)
@@ -55,7 +63,12 @@ class LocalizeVisitor final : public VNVisitor {
 
     // STATE - across all visitors
     std::vector<AstVarScope*> m_varScopeps;  // List of variables to consider for localization
+    // Functions directly called by each function
+    std::unordered_map<const AstCFunc*, std::unordered_set<const AstCFunc*>> m_callees;
+    // Functions transitively called by each function, computed on demand
+    std::unordered_map<const AstCFunc*, std::unordered_set<const AstCFunc*>> m_reachable;
     VDouble0 m_statLocVars;  // Statistic tracking
+    VDouble0 m_statDeadStores;  // Statistic tracking
 
     // STATE - for current visit position (use VL_RESTORER)
     AstCFunc* m_cfuncp = nullptr;  // Current active function
@@ -73,13 +86,61 @@ class LocalizeVisitor final : public VNVisitor {
                 && nodep->varp()->dtypep()->widthTotalBytes() <= v3Global.opt.localizeMaxSize());
     }
 
-    static bool existsNonLeaf(const std::unordered_set<AstCFunc*>& funcps) {
+    const std::unordered_set<const AstCFunc*>& reachable(const AstCFunc* funcp) {
+        const auto pair = m_reachable.emplace(funcp, std::unordered_set<const AstCFunc*>{});
+        std::unordered_set<const AstCFunc*>& reached = pair.first->second;
+        if (!pair.second) return reached;
+        std::vector<const AstCFunc*> stack{funcp};
+        while (!stack.empty()) {
+            const auto it = m_callees.find(stack.back());
+            stack.pop_back();
+            if (it == m_callees.end()) continue;
+            for (const AstCFunc* const calleep : it->second) {
+                if (reached.insert(calleep).second) stack.push_back(calleep);
+            }
+        }
+        return reached;
+    }
+
+    // True if the value of a variable might flow from one of the referencing functions to
+    // another, either because one can (transitively) call another, or itself recursively,
+    // while the variable is live, or because one can suspend, and others run meanwhile.
+    bool existsInterference(const std::unordered_set<AstCFunc*>& funcps) {
         for (const AstCFunc* const funcp : funcps) {
             if (funcp->user1()) return true;
+            if (!m_callees.count(funcp)) continue;  // Leaf function
+            const std::unordered_set<const AstCFunc*>& reached = reachable(funcp);
+            for (const AstCFunc* const otherp : funcps) {
+                if (reached.count(otherp)) return true;
+            }
         }
         return false;
     }
 
+    // Remove assignments to the localized 'vscp' in 'funcp' if it's never read there.
+    // Returns true if no references remain.
+    bool removeDeadStores(AstCFunc* funcp, const AstVarScope* vscp) {
+        const auto er = m_references(funcp).equal_range(vscp);
+        for (auto it = er.first; it != er.second; ++it) {
+            if (it->second->access().isReadOrRW()) return false;
+        }
+        bool allRemoved = true;
+        for (auto it = er.first; it != er.second; ++it) {
+            AstVarRef* const refp = it->second;
+            AstNodeAssign* const assignp = VN_CAST(refp->backp(), NodeAssign);
+            if (!assignp || assignp->lhsp() != refp || assignp->timingControlp()
+                || !assignp->rhsp()->isPure() || !assignp->backp()) {
+                allRemoved = false;
+                continue;
+            }
+            UINFO(4, "Removing dead store " << assignp);
+            ++m_statDeadStores;
+            // Delayed deletion, as we still hold references into the removed tree
+            pushDeletep(assignp->unlinkFrBack());
+        }
+        return allRemoved;
+    }
+
     void moveVarScopes() {
         for (AstVarScope* const nodep : m_varScopeps) {
             if (!isOptimizable(nodep)) continue;  // Not optimizable
@@ -87,11 +148,12 @@ class LocalizeVisitor final : public VNVisitor {
             const std::unordered_set<AstCFunc*>& funcps = m_accessors(nodep);
             if (funcps.empty()) continue;  // No referencing functions at all
 
-            // If more than one referencing function, but not all are leaf
-            // functions, then don't localize, as one of the referencing
-            // functions might be calling another, which the current analysis
-            // cannot cope with. This should be rare (introduced by V3Depth).
-            if (funcps.size() > 1 && existsNonLeaf(funcps)) continue;
+            // If more than one referencing function, then the value must not
+            // flow between them, so none of them can call another. Each of
+            // them writing the variable before reading it is not sufficient
+            // then, e.g.: the caller might read the value written by the callee
+            // after the call. This is rare (introduced by V3Depth).
+            if (funcps.size() > 1 && existsInterference(funcps)) continue;
 
             UINFO(4, "Localizing " << nodep);
             ++m_statLocVars;
@@ -103,6 +165,10 @@ class LocalizeVisitor final : public VNVisitor {
             // In each referencing function, create a replacement local variable
             AstVar* const oldVarp = nodep->varp();
             for (AstCFunc* const funcp : funcps) {
+                // The value is never used after this function, so writes without a
+                // later read are dead. If nothing is left, no local is needed.
+                if (removeDeadStores(funcp, nodep)) continue;
+
                 // Create the new local variable.
                 const string newName
                     = nodep->scopep() == funcp->scopep()
@@ -133,7 +199,7 @@ class LocalizeVisitor final : public VNVisitor {
     }
 
     void visit(AstCAwait* nodep) override {
-        m_cfuncp->user1(true);  // Mark caller as not a leaf function
+        m_cfuncp->user1(true);  // Mark caller as suspendable
         iterateChildrenConst(nodep);
     }
 
@@ -147,8 +213,8 @@ class LocalizeVisitor final : public VNVisitor {
         iterateChildrenConst(nodep);
     }
 
-    void visit(AstCCall* nodep) override {
-        m_cfuncp->user1(true);  // Mark caller as not a leaf function
+    void visit(AstNodeCCall* nodep) override {
+        m_callees[m_cfuncp].emplace(nodep->funcp());  // Record call graph edge
         iterateChildrenConst(nodep);
     }
 
@@ -220,6 +286,120 @@ public:
     explicit LocalizeVisitor(AstNetlist* nodep) { iterate(nodep); }
     ~LocalizeVisitor() override {
         V3Stats::addStat("Optimizations, Vars localized", m_statLocVars);
+        V3Stats::addStat("Optimizations, Localized dead stores removed", m_statDeadStores);
+    }
+};
+
+//######################################################################
+// PromoteVisitor - promote frequently used module variables into registers
+
+class PromoteVisitor final : public VNVisitorConst {
+    // Promote a variable if referenced at least this many times in a function
+    static constexpr size_t PROMOTE_MIN_REFS = 4;
+
+    // STATE - for current function
+    // References to each module variable in this function, in order of first reference
+    std::vector<std::pair<AstVarScope*, std::vector<AstVarRef*>>> m_refs;
+    std::unordered_map<const AstVarScope*, size_t> m_refIndex;  // Index into m_refs
+    bool m_promotable = true;  // Current function contains nothing that might observe variables
+    VDouble0 m_statPromoted;  // Statistic tracking
+
+    // METHODS
+    static bool isCandidate(const AstVarScope* vscp) {
+        const AstVar* const varp = vscp->varp();
+        if (varp->isSigPublic() || varp->isFuncLocal() || varp->isStatic()) return false;
+        if (varp->isClassMember()) return false;
+        const AstBasicDType* const basicp = VN_CAST(vscp->dtypep()->skipRefp(), BasicDType);
+        return basicp && !basicp->isOpaque() && !vscp->isWide();
+    }
+
+    void promote(AstCFunc* funcp, AstVarScope* vscp, const std::vector<AstVarRef*>& refps) {
+        const bool written = std::any_of(refps.begin(), refps.end(), [](const AstVarRef* refp) {
+            return refp->access().isWriteOrRW();
+        });
+        // With multiple threads, delaying the store might lose concurrent updates of other
+        // bits of the variable, so only promote variables this function only reads.
+        if (written && v3Global.opt.mtasks()) return;
+        UINFO(4, "Promoting " << vscp << " in " << funcp);
+        ++m_statPromoted;
+        FileLine* const flp = vscp->fileline();
+        AstVar* const oldVarp = vscp->varp();
+        const string name = vscp->scopep() == funcp->scopep()
+                                ? oldVarp->name()
+                                : vscp->scopep()->nameDotless() + "__DOT__" + oldVarp->name();
+        AstVar* const newVarp
+            = new AstVar{flp, VVarType::BLOCKTEMP, "__Vpromoted__" + name, oldVarp};
+        newVarp->funcLocal(true);
+        newVarp->noReset(true);
+        funcp->addInitsp(newVarp);
+        for (AstVarRef* const refp : refps) {
+            refp->varScopep(nullptr);
+            refp->varp(newVarp);
+        }
+        // Load on entry
+        funcp->stmtsp()->addHereThisAsNext(
+            new AstAssign{flp, new AstVarRef{flp, newVarp, VAccess::WRITE},
+                          new AstVarRef{flp, vscp, VAccess::READ}});
+        // Store on exit, the only exit is at the end, as there are no returns
+        if (written) {
+            funcp->addStmtsp(new AstAssign{flp, new AstVarRef{flp, vscp, VAccess::WRITE},
+                                           new AstVarRef{flp, newVarp, VAccess::READ}});
+        }
+    }
+
+    // VISITORS
+    void visit(AstCFunc* nodep) override {
+        if (!nodep->stmtsp() || nodep->finalsp() || nodep->dpiImportWrapper()) return;
+        // Initializers of locals are evaluated before the loads would be
+        bool initRefs = false;
+        if (nodep->initsp()) {
+            nodep->initsp()->foreachAndNext([&](const AstVarRef*) { initRefs = true; });
+        }
+        if (initRefs) return;
+        m_refs.clear();
+        m_refIndex.clear();
+        m_promotable = true;
+        iterateAndNextConstNull(nodep->stmtsp());
+        if (!m_promotable) return;
+        for (const auto& pair : m_refs) {
+            if (pair.second.size() < PROMOTE_MIN_REFS) continue;
+            if (!isCandidate(pair.first)) continue;
+            promote(nodep, pair.first, pair.second);
+        }
+    }
+    void visit(AstVarRef* nodep) override {
+        AstVarScope* const vscp = nodep->varScopep();
+        if (!vscp) return;  // Already a local
+        const auto pair = m_refIndex.emplace(vscp, m_refs.size());
+        if (pair.second) m_refs.emplace_back(vscp, std::vector<AstVarRef*>{});
+        m_refs[pair.first->second].second.push_back(nodep);
+    }
+    // Statements that cannot observe variables other than through the references they contain
+    void visit(AstNodeAssign* nodep) override {
+        if (nodep->timingControlp()) m_promotable = false;
+        iterateChildrenConst(nodep);
+    }
+    void visit(AstNodeIf* nodep) override { iterateChildrenConst(nodep); }
+    void visit(AstWhile* nodep) override { iterateChildrenConst(nodep); }
+    void visit(AstJumpBlock* nodep) override { iterateChildrenConst(nodep); }
+    void visit(AstJumpGo* nodep) override {}
+    void visit(AstJumpLabel* nodep) override {}
+    void visit(AstComment* nodep) override {}
+    // Anything else that might call out of the function, or leave it early
+    void visit(AstNodeStmt* nodep) override { m_promotable = false; }
+    void visit(AstNodeCCall* nodep) override { m_promotable = false; }
+    void visit(AstNodeFTaskRef* nodep) override { m_promotable = false; }
+    void visit(AstCExpr* nodep) override { m_promotable = false; }
+    void visit(AstCAwait* nodep) override { m_promotable = false; }
+    void visit(AstNode* nodep) override {
+        if (m_promotable) iterateChildrenConst(nodep);
+    }
+
+public:
+    // CONSTRUCTORS
+    explicit PromoteVisitor(AstNetlist* nodep) { iterateConst(nodep); }
+    ~PromoteVisitor() override {
+        V3Stats::addStat("Optimizations, Vars promoted to registers", m_statPromoted);
     }
 };
 
@@ -229,5 +409,6 @@ public:
 void V3Localize::localizeAll(AstNetlist* nodep) {
     UINFO(2, __FUNCTION__ << ":");
     { LocalizeVisitor{nodep}; }  // Destruct before checking
+    { PromoteVisitor{nodep}; }  // Destruct before checking
     V3Global::dumpCheckGlobalTree("localize", 0, dumpTreeEitherLevel() >= 6);
 }
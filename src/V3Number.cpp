@@ -1380,6 +1380,13 @@ V3Number& V3Number::opAnd(const V3Number& lhs, const V3Number& rhs) {
     NUM_ASSERT_LOGIC_ARGS2(lhs, rhs);
     // i op j, max(L(lhs),L(rhs)) bit return, careful need to X/Z extend.
     setZero();
+    if (!lhs.isFourState() && !rhs.isFourState()) {  // Fast path, word at a time
+        for (int word = 0; word < words(); ++word) {
+            m_data.num()[word].m_value = lhs.valueWord(word) & rhs.valueWord(word);
+        }
+        opCleanThis();
+        return *this;
+    }
     for (int bit = 0; bit < width(); ++bit) {
         if (lhs.bitIs1(bit) && rhs.bitIs1(bit)) {
             setBit(bit, 1);
@@ -1396,6 +1403,13 @@ V3Number& V3Number::opOr(const V3Number& lhs, const V3Number& rhs) {
     NUM_ASSERT_LOGIC_ARGS2(lhs, rhs);
     // i op j, max(L(lhs),L(rhs)) bit return, careful need to X/Z extend.
     setZero();
+    if (!lhs.isFourState() && !rhs.isFourState()) {  // Fast path, word at a time
+        for (int word = 0; word < words(); ++word) {
+            m_data.num()[word].m_value = lhs.valueWord(word) | rhs.valueWord(word);
+        }
+        opCleanThis();
+        return *this;
+    }
     for (int bit = 0; bit < width(); ++bit) {
         if (lhs.bitIs1(bit) || rhs.bitIs1(bit)) {
             setBit(bit, 1);
@@ -1413,6 +1427,13 @@ V3Number& V3Number::opXor(const V3Number& lhs, const V3Number& rhs) {
     NUM_ASSERT_OP_ARGS2(lhs, rhs);
     NUM_ASSERT_LOGIC_ARGS2(lhs, rhs);
     setZero();
+    if (!lhs.isFourState() && !rhs.isFourState()) {  // Fast path, word at a time
+        for (int word = 0; word < words(); ++word) {
+            m_data.num()[word].m_value = lhs.valueWord(word) ^ rhs.valueWord(word);
+        }
+        opCleanThis();
+        return *this;
+    }
     for (int bit = 0; bit < width(); ++bit) {
         if (lhs.bitIs1(bit) && rhs.bitIs0(bit)) {
             setBit(bit, 1);
@@ -1836,6 +1857,17 @@ V3Number& V3Number::opShiftR(const V3Number& lhs, const V3Number& rhs) {
     }
     const uint32_t rhsval = rhs.toUInt();
     if (rhsval < static_cast<uint32_t>(lhs.width())) {
+        if (!lhs.isFourState()) {  // Fast path, word at a time
+            const int wordShift = rhsval / 32;
+            const int bitShift = rhsval % 32;
+            for (int word = 0; word < words(); ++word) {
+                uint32_t value = lhs.valueWord(word + wordShift) >> bitShift;
+                if (bitShift) value |= lhs.valueWord(word + wordShift + 1) << (32 - bitShift);
+                m_data.num()[word].m_value = value;
+            }
+            opCleanThis();
+            return *this;
+        }
         for (int bit = 0; bit < width(); ++bit) setBit(bit, lhs.bitIs(bit + rhsval));
     }
     return *this;
@@ -1874,6 +1906,18 @@ V3Number& V3Number::opShiftL(const V3Number& lhs, const V3Number& rhs) {
         if (rhs.bitIs1(bit)) return *this;  // shift of over 2^32 must be zero
     }
     const uint32_t rhsval = rhs.toUInt();
+    if (!lhs.isFourState()) {  // Fast path, word at a time
+        if (rhsval >= static_cast<uint32_t>(width())) return *this;
+        const int wordShift = rhsval / 32;
+        const int bitShift = rhsval % 32;
+        for (int word = wordShift; word < words(); ++word) {
+            uint32_t value = lhs.valueWord(word - wordShift) << bitShift;
+            if (bitShift) value |= lhs.valueWord(word - wordShift - 1) >> (32 - bitShift);
+            m_data.num()[word].m_value = value;
+        }
+        opCleanThis();
+        return *this;
+    }
     for (uint32_t bit = 0; bit < static_cast<uint32_t>(width()); ++bit) {
         if (bit >= rhsval) setBit(bit, lhs.bitIs(bit - rhsval));
     }
@@ -1889,10 +1933,15 @@ V3Number& V3Number::opNegate(const V3Number& lhs) {
     NUM_ASSERT_OP_ARGS1(lhs);
     NUM_ASSERT_LOGIC_ARGS1(lhs);
     if (lhs.isFourState()) return setAllBitsX();
-    V3Number notlhs(&lhs, width());
-    notlhs.opNot(lhs);
-    const V3Number one(&lhs, width(), 1);
-    opAdd(notlhs, one);
+    // 0 - lhs, without temporaries
+    setZero();
+    uint64_t borrow = 0;
+    for (int word = 0; word < words(); ++word) {
+        const uint64_t diff = 0ULL - lhs.valueWord(word) - borrow;
+        m_data.num()[word].m_value = diff & 0xffffffffULL;
+        borrow = (diff >> 32ULL) ? 1 : 0;
+    }
+    opCleanThis();
     return *this;
 }
 V3Number& V3Number::opAdd(const V3Number& lhs, const V3Number& rhs) {
@@ -1904,8 +1953,8 @@ V3Number& V3Number::opAdd(const V3Number& lhs, const V3Number& rhs) {
     // Addem
     uint64_t carry = 0;
     for (int word = 0; word < words(); ++word) {
-        const uint64_t lwordval = lhs.m_data.num()[word].m_value;
-        const uint64_t rwordval = rhs.m_data.num()[word].m_value;
+        const uint64_t lwordval = lhs.valueWord(word);
+        const uint64_t rwordval = rhs.valueWord(word);
         const uint64_t sum = lwordval + rwordval + carry;
         m_data.num()[word].m_value = sum & 0xffffffffULL;
         carry = sum > 0xffffffffULL;
@@ -1919,9 +1968,17 @@ V3Number& V3Number::opSub(const V3Number& lhs, const V3Number& rhs) {
     NUM_ASSERT_OP_ARGS2(lhs, rhs);
     NUM_ASSERT_LOGIC_ARGS2(lhs, rhs);
     if (lhs.isFourState() || rhs.isFourState()) return setAllBitsX();
-    V3Number negrhs(&rhs, width());
-    negrhs.opNegate(rhs);
-    return opAdd(lhs, negrhs);
+    // Subtract directly with borrow, rather than adding the negated rhs via temporaries
+    setZero();
+    uint64_t borrow = 0;
+    for (int word = 0; word < words(); ++word) {
+        const uint64_t diff
+            = static_cast<uint64_t>(lhs.valueWord(word)) - rhs.valueWord(word) - borrow;
+        m_data.num()[word].m_value = diff & 0xffffffffULL;
+        borrow = (diff >> 32ULL) ? 1 : 0;
+    }
+    opCleanThis();
+    return *this;
 }
 V3Number& V3Number::opMul(const V3Number& lhs, const V3Number& rhs) {
     // i op j, max(L(lhs),L(rhs)) bit return, if any 4-state, 4-state return
@@ -2621,4 +2678,15 @@ void V3Number::selfTestThis() {
     UASSERT_SELFTEST(int, log2b(1), 0);
     UASSERT_SELFTEST(int, log2b(0x40000000UL), 30);
     UASSERT_SELFTEST(int, log2bQuad(0x4000000000000000ULL), 62);
+
+    // Two-state word-at-a-time fast paths, crossing word boundaries
+    const V3Number a{m_fileline, "96'h1234_5678_9abc_def0_0fed_cba9"};
+    const V3Number b{m_fileline, "96'h0000_0001_ffff_ffff_0000_0001"};
+    const V3Number sh{m_fileline, 32, 36};
+    V3Number result{m_fileline, 96, 0};
+    UASSERT_SELFTEST(string, result.opShiftL(a, sh).ascii(), "96'habcdef00fedcba9000000000");
+    UASSERT_SELFTEST(string, result.opShiftR(a, sh).ascii(), "96'h123456789abcdef");
+    UASSERT_SELFTEST(string, result.opSub(a, b).ascii(), "96'h123456769abcdef10fedcba8");
+    UASSERT_SELFTEST(string, result.opNegate(b).ascii(), "96'hfffffffe00000000ffffffff");
+    UASSERT_SELFTEST(string, result.opXor(a, b).ascii(), "96'h123456796543210f0fedcba8");
 }
@@ -458,6 +458,10 @@ private:
     int countZ(int lsb, int nbits) const VL_MT_SAFE;
 
     int words() const VL_MT_SAFE { return ((width() + 31) / 32); }
+    // Value bits of a word, zero above the width; only meaningful if !isFourState()
+    uint32_t valueWord(int word) const VL_MT_SAFE {
+        return (word >= 0 && word < words()) ? m_data.num()[word].m_value : 0;
+    }
     uint32_t hiWordMask() const VL_MT_SAFE {
         // Correct number of zero bits/width matters
         return VL_MASK_I(width());
@@ -462,6 +462,29 @@ string V3Options::allArgsStringForHierBlock(bool forTop) const {
     return out;
 }
 
+string V3Options::allArgsStringForPgo() const {
+    string out;
+    bool first = true;
+    bool stripArg = false;
+    for (const string& arg : m_impp->m_lineArgs) {
+        if (first) {  // Program name
+            first = false;
+            continue;
+        }
+        if (stripArg) {
+            stripArg = false;
+            continue;
+        }
+        if (arg == "-build-pgo" || arg == "--build-pgo") {
+            stripArg = true;
+            continue;
+        }
+        if (out != "") out += " ";
+        out += '"' + VString::quoteAny(arg, '"', '\\') + '"';
+    }
+    return out;
+}
+
 void V3Options::ccSet() {  // --cc
     m_outFormatOk = true;
     m_systemC = false;
@@ -857,6 +880,10 @@ void V3Options::notify() VL_MT_DISABLED {
     if (m_build && (m_gmake || m_cmake || m_makeJson)) {
         cmdfl->v3error("--make cannot be used together with --build. Suggest see manual");
     }
+    if (!m_buildPgo.empty() && !m_build) cmdfl->v3error("--build-pgo requires --build");
+    if (!m_buildPgo.empty() && m_hierarchical) {
+        cmdfl->v3error("--build-pgo cannot be used together with --hierarchical");
+    }
 
     // m_build, m_preprocOnly, m_dpiHdrOnly, m_lintOnly, m_jsonOnly and m_xmlOnly are mutually
     // exclusive
@@ -935,8 +962,10 @@ void V3Options::notify() VL_MT_DISABLED {
     }
 
     if (trace()) {
-        // With --trace-vcd, --trace-threads is ignored
-        if (traceFormat().vcd()) m_traceThreads = 1;
+        // With --trace-vcd, --trace-bin or --trace-saif, --trace-threads is ignored
+        if (traceFormat().vcd() || traceFormat().bin() || traceFormat().saif()) {
+            m_traceThreads = 1;
+        }
     }
 
     UASSERT(!(useTraceParallel() && useTraceOffload()),
@@ -951,6 +980,17 @@ void V3Options::notify() VL_MT_DISABLED {
                       "--main not usable with SystemC. Suggest see examples for sc_main().");
     }
 
+    if (m_profSample && m_profC) {
+        cmdfl->v3warn(E_UNSUPPORTED, "Unsupported: --prof-sample with --prof-c, both use SIGPROF");
+    }
+    if (m_skipIdleEval && systemC()) {
+        cmdfl->v3warn(E_UNSUPPORTED, "Unsupported: --skip-idle-eval with SystemC output");
+    }
+    if (m_batchLanes && systemC()) {
+        cmdfl->v3warn(E_UNSUPPORTED, "Unsupported: --batch-lanes with SystemC output");
+        m_batchLanes = 0;
+    }
+
     if (coverage() && savable()) {
         cmdfl->v3error("Unsupported: --coverage and --savable not supported together");
     }
@@ -965,6 +1005,7 @@ void V3Options::notify() VL_MT_DISABLED {
 
     // Sanity check of expected configuration
     UASSERT(threads() >= 1, "'threads()' must return a value >= 1");
+    m_outputGroupsUser = m_outputGroups > 0;
     if (m_outputGroups == -1) m_outputGroups = (m_buildJobs != -1) ? m_buildJobs : 0;
     if (m_buildJobs == -1) m_buildJobs = 1;
     if (m_verilateJobs == -1) m_verilateJobs = 1;
@@ -1187,6 +1228,15 @@ void V3Options::parseOptsList(FileLine* fl, const string& optdir, int argc,
     DECL_OPTION("-assert-case", OnOff, &m_assertCase);
     DECL_OPTION("-autoflush", OnOff, &m_autoflush);
 
+    DECL_OPTION("-batch-lanes", CbVal, [this, fl](const char* valp) {
+        const int val = std::atoi(valp);
+        if (val < 0) {
+            fl->v3error("--batch-lanes requires a non-negative integer, but '" << valp
+                                                                              << "' was passed");
+        } else {
+            m_batchLanes = val;
+        }
+    });
     DECL_OPTION("-bbox-sys", OnOff, &m_bboxSys);
     DECL_OPTION("-bbox-unsup", CbOnOff, [this](bool flag) {
         m_bboxUnsup = flag;
@@ -1199,8 +1249,9 @@ void V3Options::parseOptsList(FileLine* fl, const string& optdir, int argc,
         m_main = true;
         if (m_timing.isDefault()) m_timing = VOptionBool::OPT_TRUE;
     });
-    DECL_OPTION("-build", Set, &m_build);
+    DECL_OPTION("-build", OnOff, &m_build);
     DECL_OPTION("-build-dep-bin", Set, &m_buildDepBin);
+    DECL_OPTION("-build-pgo", Set, &m_buildPgo);
     DECL_OPTION("-build-jobs", CbVal, [this, fl](const char* valp) {
         int val = std::atoi(valp);
         if (val < 0) {
@@ -1249,6 +1300,8 @@ void V3Options::parseOptsList(FileLine* fl, const string& optdir, int argc,
     DECL_OPTION("-coverage-expr-max", Set, &m_coverageExprMax);
     DECL_OPTION("-coverage-line", OnOff, &m_coverageLine);
     DECL_OPTION("-coverage-max-width", Set, &m_coverageMaxWidth);
+    DECL_OPTION("-coverage-pgo", Set, &m_coveragePgo);
+    DECL_OPTION("-coverage-shards", OnOff, &m_coverageShards);
     DECL_OPTION("-coverage-toggle", OnOff, &m_coverageToggle);
     DECL_OPTION("-coverage-underscore", OnOff, &m_coverageUnderscore);
     DECL_OPTION("-coverage-user", OnOff, &m_coverageUser);
@@ -1264,6 +1317,12 @@ void V3Options::parseOptsList(FileLine* fl, const string& optdir, int argc,
                 V3Error::vlAbort)
         .undocumented();  // See also --debug-sigsegv
     DECL_OPTION("-debug-check", OnOff, &m_debugCheck);
+    DECL_OPTION("-debug-check-interval", CbVal, [this, fl](const char* valp) {
+        m_debugCheckInterval = std::atoi(valp);
+        if (m_debugCheckInterval < 1) {
+            fl->v3error("--debug-check-interval must be >= 1: " << valp);
+        }
+    });
     DECL_OPTION("-debug-collision", OnOff, &m_debugCollision).undocumented();
     DECL_OPTION("-debug-emitv", OnOff, &m_debugEmitV).undocumented();
     DECL_OPTION("-debug-exit-parse", OnOff, &m_debugExitParse).undocumented();
@@ -1307,6 +1366,7 @@ void V3Options::parseOptsList(FileLine* fl, const string& optdir, int argc,
     DECL_OPTION("-exe", OnOff, &m_exe);
     DECL_OPTION("-expand-limit", CbVal,
                 [this](const char* valp) { m_expandLimit = std::atoi(valp); });
+    DECL_OPTION("-expand-vector-words", Set, &m_expandVectorWords);
 
     DECL_OPTION("-F", CbVal, [this, fl, &optdir](const char* valp) VL_MT_DISABLED {
         parseOptsFile(fl, parseFileArg(optdir, valp), true);
@@ -1331,6 +1391,7 @@ void V3Options::parseOptsList(FileLine* fl, const string& optdir, int argc,
     DECL_OPTION("-fdead-assigns", FOnOff, &m_fDeadAssigns);
     DECL_OPTION("-fdead-cells", FOnOff, &m_fDeadCells);
     DECL_OPTION("-fdedup", FOnOff, &m_fDedupe);
+    DECL_OPTION("-fdelay-fsm", FOnOff, &m_fDelayFsm);
     DECL_OPTION("-fdfg", CbFOnOff, [this](bool flag) {
         m_fDfgPreInline = flag;
         m_fDfgPostInline = flag;
@@ -1348,6 +1409,7 @@ void V3Options::parseOptsList(FileLine* fl, const string& optdir, int argc,
     DECL_OPTION("-fdfg-post-inline", FOnOff, &m_fDfgPostInline);
     DECL_OPTION("-fdfg-scoped", FOnOff, &m_fDfgScoped);
     DECL_OPTION("-fexpand", FOnOff, &m_fExpand);
+    DECL_OPTION("-fforce-fast-path", FOnOff, &m_fForceFastPath);
     DECL_OPTION("-ffunc-opt", CbFOnOff, [this](bool flag) {  //
         m_fFuncSplitCat = flag;
         m_fFuncBalanceCat = flag;
@@ -1363,15 +1425,20 @@ void V3Options::parseOptsList(FileLine* fl, const string& optdir, int argc,
     DECL_OPTION("-fmerge-cond", FOnOff, &m_fMergeCond);
     DECL_OPTION("-fmerge-cond-motion", FOnOff, &m_fMergeCondMotion);
     DECL_OPTION("-fmerge-const-pool", FOnOff, &m_fMergeConstPool);
+    DECL_OPTION("-fperiodic", FOnOff, &m_fPeriodic);
     DECL_OPTION("-freloop", FOnOff, &m_fReloop);
     DECL_OPTION("-freorder", FOnOff, &m_fReorder);
+    DECL_OPTION("-fshare-replicas", FOnOff, &m_fShareReplicas);
     DECL_OPTION("-fslice", FOnOff, &m_fSlice);
+    DECL_OPTION("-fsparse-eval", FOnOff, &m_fSparseEval);
     DECL_OPTION("-fsplit", FOnOff, &m_fSplit);
+    DECL_OPTION("-fsplit-temps", FOnOff, &m_fSplitTemps);
     DECL_OPTION("-fsubst", FOnOff, &m_fSubst);
     DECL_OPTION("-fsubst-const", FOnOff, &m_fSubstConst);
     DECL_OPTION("-ftable", FOnOff, &m_fTable);
     DECL_OPTION("-ftaskify-all-forked", FOnOff, &m_fTaskifyAll).undocumented();  // Debug
     DECL_OPTION("-fvar-split", FOnOff, &m_fVarSplit);
+    DECL_OPTION("-fvar-split-arrays", FOnOff, &m_fVarSplitArrays);
 
     DECL_OPTION("-G", CbPartialMatch, [this](const char* optp) { addParameter(optp, false); });
     DECL_OPTION("-gate-stmts", Set, &m_gateStmts);
@@ -1395,7 +1462,9 @@ void V3Options::parseOptsList(FileLine* fl, const string& optdir, int argc,
         const V3HierarchicalBlockOption opt{valp};
         m_hierBlocks.emplace(opt.mangledName(), opt);
     });
+    DECL_OPTION("-hierarchical-cache", Set, &m_hierCache);
     DECL_OPTION("-hierarchical-child", Set, &m_hierChild);
+    DECL_OPTION("-huge-pages", OnOff, &m_hugePages);
     DECL_OPTION("-hierarchical-params-file", CbVal, [this](const char* optp) {
         m_hierParamsFile.push_back({optp, work()});
     });
@@ -1409,6 +1478,7 @@ void V3Options::parseOptsList(FileLine* fl, const string& optdir, int argc,
         m_instrCountDpi = val;
         if (m_instrCountDpi < 0) fl->v3fatal("--instr-count-dpi must be non-negative: " << val);
     });
+    DECL_OPTION("-instr-count-table", Set, &m_instrCountTable);
 
     DECL_OPTION("-json-edit-nums", OnOff, &m_jsonEditNums);
     DECL_OPTION("-json-ids", OnOff, &m_jsonIds);
@@ -1444,6 +1514,7 @@ void V3Options::parseOptsList(FileLine* fl, const string& optdir, int argc,
         validateIdentifier(fl, valp, "--lib-create");
         m_libCreate = valp;
     });
+    DECL_OPTION("-lib-create-batch", OnOff, &m_libCreateBatch);
     DECL_OPTION("-lint-only", OnOff, &m_lintOnly);
     DECL_OPTION("-localize-max-size", Set, &m_localizeMaxSize);
 
@@ -1499,6 +1570,7 @@ void V3Options::parseOptsList(FileLine* fl, const string& optdir, int argc,
             fl->v3error("--output-split-ctrace must be >= 0: " << valp);
         }
     });
+    DECL_OPTION("-output-split-stable", OnOff, &m_outputSplitStable);
 
     DECL_OPTION("-P", Set, &m_preprocNoLine);
     DECL_OPTION("-pins64", CbCall, [this]() { m_pinsBv = 65; });
@@ -1532,8 +1604,11 @@ void V3Options::parseOptsList(FileLine* fl, const string& optdir, int argc,
     DECL_OPTION("-private", CbCall, [this]() { m_public = false; });
     DECL_OPTION("-prof-c", OnOff, &m_profC);
     DECL_OPTION("-prof-cfuncs", CbCall, [this]() { m_profC = m_profCFuncs = true; });
+    DECL_OPTION("-prof-eval", OnOff, &m_profEval);
     DECL_OPTION("-prof-exec", OnOff, &m_profExec);
     DECL_OPTION("-prof-pgo", OnOff, &m_profPgo);
+    DECL_OPTION("-prof-sample", OnOff, &m_profSample);
+    DECL_OPTION("-prof-verilator", OnOff, &m_profVerilator);
     DECL_OPTION("-profile-cfuncs", CbCall,
                 [this]() { m_profC = m_profCFuncs = true; });  // Renamed
     DECL_OPTION("-protect-ids", OnOff, &m_protectIds);
@@ -1545,6 +1620,10 @@ void V3Options::parseOptsList(FileLine* fl, const string& optdir, int argc,
     });
     DECL_OPTION("-public", OnOff, &m_public);
     DECL_OPTION("-public-depth", Set, &m_publicDepth);
+    DECL_OPTION("-public-flat-rd", CbOnOff, [this](bool flag) {
+        m_publicFlatRd = flag;
+        v3Global.dpi(true);
+    });
     DECL_OPTION("-public-flat-rw", CbOnOff, [this](bool flag) {
         m_publicFlatRW = flag;
         v3Global.dpi(true);
@@ -1570,6 +1649,7 @@ void V3Options::parseOptsList(FileLine* fl, const string& optdir, int argc,
         if (m_reloopLimit < 2) fl->v3error("--reloop-limit must be >= 2: " << valp);
     });
     DECL_OPTION("-report-unoptflat", OnOff, &m_reportUnoptflat);
+    DECL_OPTION("-restrict-pointers", OnOff, &m_restrictPointers);
     DECL_OPTION("-rr", CbCall, []() {});  // Processed only in bin/verilator shell
     DECL_OPTION("-runtime-debug", CbCall, [this, fl]() {
         decorations(fl, "node");
@@ -1587,7 +1667,11 @@ void V3Options::parseOptsList(FileLine* fl, const string& optdir, int argc,
         m_systemC = true;
     });
     DECL_OPTION("-skip-identical", OnOff, &m_skipIdentical);
+    DECL_OPTION("-skip-identical-content", OnOff, &m_skipIdenticalContent);
+    DECL_OPTION("-skip-idle-eval", OnOff, &m_skipIdleEval);
+    DECL_OPTION("-sparse-array-threshold", Set, &m_sparseArrayThreshold);
     DECL_OPTION("-stats", OnOff, &m_stats);
+    DECL_OPTION("-stats-model", OnOff, &m_statsModel);
     DECL_OPTION("-stats-vars", CbOnOff, [this](bool flag) {
         m_statsVars = flag;
         m_stats |= flag;
@@ -1639,6 +1723,7 @@ void V3Options::parseOptsList(FileLine* fl, const string& optdir, int argc,
         m_threadsMaxMTasks = std::atoi(valp);
         if (m_threadsMaxMTasks < 1) fl->v3fatal("--threads-max-mtasks must be >= 1: " << valp);
     });
+    DECL_OPTION("-threads-work-stealing", OnOff, &m_threadsWorkStealing);
     DECL_OPTION("-timescale", CbVal, [this, fl](const char* valp) {
         VTimescale unit;
         VTimescale prec;
@@ -1663,12 +1748,17 @@ void V3Options::parseOptsList(FileLine* fl, const string& optdir, int argc,
     DECL_OPTION("-top", Set, &m_topModule);
     DECL_OPTION("-top-module", Set, &m_topModule);
     DECL_OPTION("-trace", OnOff, &m_trace);
+    DECL_OPTION("-trace-bin", CbCall, [this]() {
+        m_trace = true;
+        m_traceFormat = TraceFormat::BIN;
+    });
     DECL_OPTION("-trace-saif", CbCall, [this]() {
         m_trace = true;
         m_traceFormat = TraceFormat::SAIF;
     });
     DECL_OPTION("-trace-coverage", OnOff, &m_traceCoverage);
     DECL_OPTION("-trace-depth", Set, &m_traceDepth);
+    DECL_OPTION("-trace-fine-activity", OnOff, &m_traceFineActivity);
     DECL_OPTION("-trace-fst", CbCall, [this]() {
         m_trace = true;
         m_traceFormat = TraceFormat::FST;
@@ -1697,11 +1787,13 @@ void V3Options::parseOptsList(FileLine* fl, const string& optdir, int argc,
         m_trace = true;
         m_traceFormat = TraceFormat::VCD;
     });
+    DECL_OPTION("-tsp-exact-limit", Set, &m_tspExactLimit).undocumented();  // Optimization tweak
 
     DECL_OPTION("-U", CbPartialMatch, &V3PreShell::undef);
     DECL_OPTION("-underline-zero", OnOff, &m_underlineZero);  // Deprecated
     DECL_OPTION("-no-unlimited-stack", CbCall, []() {});  // Processed only in bin/verilator shell
     DECL_OPTION("-unroll-count", Set, &m_unrollCount).undocumented();  // Optimization tweak
+    DECL_OPTION("-unroll-partial", Set, &m_unrollPartial);
     DECL_OPTION("-unroll-stmts", Set, &m_unrollStmts).undocumented();  // Optimization tweak
     DECL_OPTION("-unused-regexp", Set, &m_unusedRegexp);
 
@@ -1730,6 +1822,7 @@ void V3Options::parseOptsList(FileLine* fl, const string& optdir, int argc,
         std::exit(0);
     });
     DECL_OPTION("-vpi", OnOff, &m_vpi);
+    DECL_OPTION("-vpi-dirty", OnOff, &m_vpiDirty);
 
     DECL_OPTION("-Wall", CbCall, []() {
         FileLine::globalWarnLintOff(false);
@@ -2188,6 +2281,7 @@ void V3Options::optimize(int level) {
     m_fConst = flag;
     m_fConstBitOpTree = flag;
     m_fDedupe = flag;
+    m_fDelayFsm = flag;
     m_fDfgPreInline = flag;
     m_fDfgPostInline = flag;
     m_fDfgScoped = flag;
@@ -2200,6 +2294,7 @@ void V3Options::optimize(int level) {
     m_fLifePost = flag;
     m_fLocalize = flag;
     m_fMergeCond = flag;
+    m_fPeriodic = flag;
     m_fReloop = flag;
     m_fReorder = flag;
     m_fSplit = flag;
@@ -161,22 +161,25 @@ inline std::ostream& operator<<(std::ostream& os, const VTimescale& rhs) {
 
 class TraceFormat final {
 public:
-    enum en : uint8_t { VCD = 0, FST, SAIF } m_e;
+    enum en : uint8_t { VCD = 0, FST, SAIF, BIN } m_e;
     // cppcheck-suppress noExplicitConstructor
     constexpr TraceFormat(en _e = VCD)
         : m_e{_e} {}
     explicit TraceFormat(int _e)
         : m_e(static_cast<en>(_e)) {}  // Need () or GCC 4.8 false warning
     constexpr operator en() const { return m_e; }
+    bool bin() const { return m_e == BIN; }
     bool fst() const { return m_e == FST; }
     bool saif() const { return m_e == SAIF; }
     bool vcd() const { return m_e == VCD; }
     string classBase() const VL_MT_SAFE {
-        static const char* const names[] = {"VerilatedVcd", "VerilatedFst", "VerilatedSaif"};
+        static const char* const names[] = {"VerilatedVcd", "VerilatedFst", "VerilatedSaif",
+                                                    "VerilatedBin"};
         return names[m_e];
     }
     string sourceName() const VL_MT_SAFE {
-        static const char* const names[] = {"verilated_vcd", "verilated_fst", "verilated_saif"};
+        static const char* const names[] = {"verilated_vcd", "verilated_fst", "verilated_saif",
+                                                    "verilated_bin"};
         return names[m_e];
     }
 };
@@ -262,6 +265,7 @@ private:
     bool m_context = true;          // main switch: --Wcontext
     bool m_coverageExpr = false;    // main switch: --coverage-expr
     bool m_coverageLine = false;    // main switch: --coverage-block
+    bool m_coverageShards = false;  // main switch: --coverage-shards
     bool m_coverageToggle = false;  // main switch: --coverage-toggle
     bool m_coverageUnderscore = false;  // main switch: --coverage-underscore
     bool m_coverageUser = false;    // main switch: --coverage-func
@@ -286,13 +290,16 @@ private:
     bool m_exe = false;             // main switch: --exe
     bool m_flatten = false;         // main switch: --flatten
     bool m_hierarchical = false;    // main switch: --hierarchical
+    bool m_hugePages = false;       // main switch: --huge-pages
     bool m_ignc = false;            // main switch: --ignc
     bool m_jsonOnly = false;        // main switch: --json-only
+    bool m_libCreateBatch = false;  // main switch: --lib-create-batch
     bool m_lintOnly = false;        // main switch: --lint-only
     bool m_gmake = false;           // main switch: --make gmake
     bool m_makeJson = false;        // main switch: --make json
     bool m_main = false;            // main switch: --main
     bool m_outFormatOk = false;     // main switch: --cc, --sc or --sp was specified
+    bool m_outputSplitStable = false;  // main switch: --output-split-stable
     bool m_pedantic = false;        // main switch: --Wpedantic
     bool m_pinsInoutEnables = false;// main switch: --pins-inout-enables
     bool m_pinsScUint = false;      // main switch: --pins-sc-uint
@@ -302,10 +309,14 @@ private:
     bool m_ppComments = false;      // main switch: --pp-comments
     bool m_profC = false;           // main switch: --prof-c
     bool m_profCFuncs = false;      // main switch: --prof-cfuncs
+    bool m_profEval = false;        // main switch: --prof-eval
     bool m_profExec = false;        // main switch: --prof-exec
     bool m_profPgo = false;         // main switch: --prof-pgo
+    bool m_profSample = false;      // main switch: --prof-sample
+    bool m_profVerilator = false;   // main switch: --prof-verilator
     bool m_protectIds = false;      // main switch: --protect-ids
     bool m_public = false;          // main switch: --public
+    bool m_publicFlatRd = false;    // main switch: --public-flat-rd
     bool m_publicFlatRW = false;    // main switch: --public-flat-rw
     bool m_publicIgnore = false;    // main switch: --public-ignore
     bool m_publicParams = false;    // main switch: --public-params
@@ -313,19 +324,25 @@ private:
     bool m_quietStats = false;      // main switch: --quiet-stats
     bool m_relativeIncludes = false;  // main switch: --relative-includes
     bool m_reportUnoptflat = false;  // main switch: --report-unoptflat
+    bool m_restrictPointers = false;  // main switch: --restrict-pointers
     bool m_savable = false;         // main switch: --savable
+    bool m_skipIdenticalContent = false;  // main switch: --skip-identical-content
+    bool m_skipIdleEval = false;    // main switch: --skip-idle-eval
     bool m_stdPackage = true;       // main switch: --std-package
     bool m_stdWaiver = true;        // main switch: --std-waiver
     bool m_structsPacked = false;   // main switch: --structs-packed
     bool m_systemC = false;         // main switch: --sc: System C instead of simple C++
     bool m_stats = false;           // main switch: --stats
+    bool m_statsModel = false;      // main switch: --stats-model
     bool m_statsVars = false;       // main switch: --stats-vars
     bool m_threadsCoarsen = true;   // main switch: --threads-coarsen
     bool m_threadsDpiPure = true;   // main switch: --threads-dpi all/pure
     bool m_threadsDpiUnpure = false;  // main switch: --threads-dpi all
+    bool m_threadsWorkStealing = false;  // main switch: --threads-work-stealing
     VOptionBool m_timing;           // main switch: --timing
     bool m_trace = false;           // main switch: --trace
     bool m_traceCoverage = false;   // main switch: --trace-coverage
+    bool m_traceFineActivity = false;  // main switch: --trace-fine-activity
     bool m_traceParams = true;      // main switch: --trace-params
     bool m_traceStructs = false;    // main switch: --trace-structs
     bool m_noTraceTop = false;      // main switch: --no-trace-top
@@ -333,15 +350,19 @@ private:
     bool m_underlineZero = false;   // main switch: --underline-zero; undocumented old Verilator 2
     bool m_verilate = true;         // main switch: --verilate
     bool m_vpi = false;             // main switch: --vpi
+    bool m_vpiDirty = false;        // main switch: --vpi-dirty
     bool m_waiverMultiline = false;  // main switch: --waiver-multiline
     bool m_xInitialEdge = false;    // main switch: --x-initial-edge
     bool m_xmlOnly = false;         // main switch: --xml-only
 
+    int         m_batchLanes = 0;    // main switch: --batch-lanes
     int         m_buildJobs = -1;    // main switch: --build-jobs, -j
     int         m_coverageExprMax = 32;    // main switch: --coverage-expr-max
     int         m_convergeLimit = 100;  // main switch: --converge-limit
     int         m_coverageMaxWidth = 256; // main switch: --coverage-max-width
+    int         m_debugCheckInterval = 1;  // main switch: --debug-check-interval
     int         m_expandLimit = 64;  // main switch: --expand-limit
+    int         m_expandVectorWords = 0;  // main switch: --expand-vector-words
     int         m_gateStmts = 100;    // main switch: --gate-stmts
     int         m_hierChild = 0;      // main switch: --hierarchical-child
     int         m_hierThreads = 0;      // main switch: --hierarchical-threads
@@ -355,6 +376,7 @@ private:
     int         m_maxNumWidth = 65536;  // main switch: --max-num-width
     int         m_moduleRecursion = 100;  // main switch: --module-recursion-depth
     int         m_outputGroups = -1;  // main switch: --output-groups
+    bool        m_outputGroupsUser = false;  // main switch: --output-groups given explicitly
     int         m_outputSplit = 20000;  // main switch: --output-split
     int         m_outputSplitCFuncs = -1;  // main switch: --output-split-cfuncs
     int         m_outputSplitCTrace = -1;  // main switch: --output-split-ctrace
@@ -363,6 +385,7 @@ private:
     int         m_publicDepth = 0;   // main switch: --public-depth
     int         m_reloopLimit = 40; // main switch: --reloop-limit
     VOptionBool m_skipIdentical;  // main switch: --skip-identical
+    int         m_sparseArrayThreshold = 0;  // main switch: --sparse-array-threshold
     bool        m_stopFail = true;  // main switch: --stop-fail
     int         m_threads = 1;      // main switch: --threads
     int         m_threadsMaxMTasks = 0;  // main switch: --threads-max-mtasks
@@ -370,12 +393,14 @@ private:
     VTimescale  m_timeDefaultUnit;  // main switch: --timescale
     VTimescale  m_timeOverridePrec;  // main switch: --timescale-override
     VTimescale  m_timeOverrideUnit;  // main switch: --timescale-override
+    int         m_tspExactLimit = 500;  // main switch: --tsp-exact-limit
     int         m_traceDepth = 0;   // main switch: --trace-depth
     TraceFormat m_traceFormat;  // main switch: --trace or --trace-fst
     int         m_traceMaxArray = 32;  // main switch: --trace-max-array
     int         m_traceMaxWidth = 256; // main switch: --trace-max-width
     int         m_traceThreads = 0; // main switch: --trace-threads
     int         m_unrollCount = 64;  // main switch: --unroll-count
+    int         m_unrollPartial = 0;  // main switch: --unroll-partial
     int         m_unrollStmts = 30000;  // main switch: --unroll-stmts
     int         m_verilateJobs = -1;  // main switch: --verilate-jobs
 
@@ -384,10 +409,14 @@ private:
     int         m_compLimitParens = 240;  // compiler selection; number of nested parens
 
     string      m_buildDepBin;  // main switch: --build-dep-bin {filename}
+    string      m_buildPgo;     // main switch: --build-pgo {command}
     string      m_diagnosticsSarifOutput;  // main switch: --diagnostics-sarif-output
+    string      m_coveragePgo;  // main switch: --coverage-pgo {filename}
     string      m_exeName;      // main switch: -o {name}
     string      m_flags;        // main switch: -f {name}
+    string      m_hierCache;    // main switch: --hierarchical-cache {dir}
     VFileLibList m_hierParamsFile; // main switch: --hierarchical-params-file
+    string      m_instrCountTable;  // main switch: --instr-count-table {filename}
     string      m_jsonOnlyOutput;    // main switch: --json-only-output
     string      m_jsonOnlyMetaOutput;    // main switch: --json-only-meta-output
     string      m_l2Name;       // main switch: --l2name; "" for top-module's name
@@ -420,6 +449,7 @@ private:
     bool m_fConstBitOpTree;  // main switch: -fno-const-bit-op-tree constant bit op tree
     bool m_fConstEager = true;  // main switch: -fno-const-eagerly run V3Const during passes
     bool m_fDedupe;      // main switch: -fno-dedupe: logic deduplication
+    bool m_fDelayFsm;    // main switch: -fno-delay-fsm: lower delay sequences to state machines
     bool m_fDfgBreakCycles = true; // main switch: -fno-dfg-break-cycles
     bool m_fDfgPeephole = true; // main switch: -fno-dfg-peephole
     bool m_fDfgPreInline;    // main switch: -fno-dfg-pre-inline and -fno-dfg
@@ -428,6 +458,7 @@ private:
     bool m_fDeadAssigns;     // main switch: -fno-dead-assigns: remove dead assigns
     bool m_fDeadCells;   // main switch: -fno-dead-cells: remove dead cells
     bool m_fExpand;      // main switch: -fno-expand: expansion of C macros
+    bool m_fForceFastPath = false;  // main switch: -fforce-fast-path: read forced values directly
     bool m_fFuncBalanceCat = true;  // main switch: -fno-func-balance-cat: expansion of C macros
     bool m_fFuncSplitCat = true;  // main switch: -fno-func-split-cat: expansion of C macros
     bool m_fGate;        // main switch: -fno-gate: gate wire elimination
@@ -439,15 +470,20 @@ private:
     bool m_fMergeCond;   // main switch: -fno-merge-cond: merge conditionals
     bool m_fMergeCondMotion = true; // main switch: -fno-merge-cond-motion: perform code motion
     bool m_fMergeConstPool = true;  // main switch: -fno-merge-const-pool
+    bool m_fPeriodic;    // main switch: -fno-periodic: lower clock generators to timers
     bool m_fReloop;      // main switch: -fno-reloop: reform loops
     bool m_fReorder;     // main switch: -fno-reorder: reorder assignments in blocks
+    bool m_fShareReplicas = false;  // main switch: -fshare-replicas: share replicated logic
     bool m_fSlice = true;  // main switch: -fno-slice: array assignment slicing
+    bool m_fSparseEval = false;  // main switch: -fsparse-eval: skip unchanged combo functions
     bool m_fSplit;       // main switch: -fno-split: always assignment splitting
+    bool m_fSplitTemps = false;  // main switch: -fsplit-temps: split combo blocks at temporaries
     bool m_fSubst;       // main switch: -fno-subst: substitute expression temp values
     bool m_fSubstConst;  // main switch: -fno-subst-const: final constant substitution
     bool m_fTable;       // main switch: -fno-table: lookup table creation
     bool m_fTaskifyAll = false;  // main switch: --ftaskify-all-forked
     bool m_fVarSplit;    // main switch: -fno-var-split: automatic variable splitting
+    bool m_fVarSplitArrays = false;  // main switch: -fvar-split-arrays: automatic array splitting
     // clang-format on
 
     bool m_available = false;  // Set to true at the end of option parsing
@@ -515,7 +551,10 @@ public:
     string flags() const { return m_flags; }
     bool systemC() const VL_MT_SAFE { return m_systemC; }
     bool savable() const VL_MT_SAFE { return m_savable; }
+    bool skipIdenticalContent() const { return m_skipIdenticalContent; }
+    bool skipIdleEval() const { return m_skipIdleEval; }
     bool stats() const { return m_stats; }
+    bool statsModel() const { return m_statsModel; }
     bool statsVars() const { return m_statsVars; }
     bool stdPackage() const { return m_stdPackage; }
     bool stdWaiver() const { return m_stdWaiver; }
@@ -529,6 +568,7 @@ public:
     bool build() const { return m_build; }
     string buildDepBin() const { return m_buildDepBin; }
     void buildDepBin(const string& flag) { m_buildDepBin = flag; }
+    string buildPgo() const { return m_buildPgo; }
     bool cmake() const { return m_cmake; }
     bool context() const VL_MT_SAFE { return m_context; }
     bool coverage() const VL_MT_SAFE {
@@ -536,9 +576,11 @@ public:
     }
     bool coverageExpr() const { return m_coverageExpr; }
     bool coverageLine() const { return m_coverageLine; }
+    bool coverageShards() const { return m_coverageShards; }
     bool coverageToggle() const { return m_coverageToggle; }
     bool coverageUnderscore() const { return m_coverageUnderscore; }
     bool coverageUser() const { return m_coverageUser; }
+    string coveragePgo() const { return m_coveragePgo; }
     bool debugCheck() const VL_MT_SAFE { return m_debugCheck; }
     bool debugCollision() const { return m_debugCollision; }
     bool debugEmitV() const VL_MT_SAFE { return m_debugEmitV; }
@@ -568,14 +610,17 @@ public:
     bool threadsDpiPure() const { return m_threadsDpiPure; }
     bool threadsDpiUnpure() const { return m_threadsDpiUnpure; }
     bool threadsCoarsen() const { return m_threadsCoarsen; }
+    bool threadsWorkStealing() const { return m_threadsWorkStealing; }
     VOptionBool timing() const { return m_timing; }
     bool trace() const { return m_trace; }
     bool traceCoverage() const { return m_traceCoverage; }
+    bool traceFineActivity() const { return m_traceFineActivity; }
     bool traceParams() const { return m_traceParams; }
     bool traceStructs() const { return m_traceStructs; }
     bool traceUnderscore() const { return m_traceUnderscore; }
     bool main() const { return m_main; }
     bool outFormatOk() const { return m_outFormatOk; }
+    bool outputSplitStable() const { return m_outputSplitStable; }
     bool jsonOnly() const { return m_jsonOnly; }
     bool keepTempFiles() const { return (V3Error::debugDefault() != 0); }
     bool pedantic() const { return m_pedantic; }
@@ -587,39 +632,51 @@ public:
     bool ppComments() const { return m_ppComments; }
     bool profC() const { return m_profC; }
     bool profCFuncs() const { return m_profCFuncs; }
+    bool profEval() const { return m_profEval; }
     bool profExec() const { return m_profExec; }
     bool profPgo() const { return m_profPgo; }
-    bool usesProfiler() const { return profExec() || profPgo(); }
+    bool profSample() const { return m_profSample; }
+    bool profVerilator() const { return m_profVerilator; }
+    bool usesProfiler() const { return profEval() || profExec() || profPgo() || profSample(); }
     bool protectIds() const VL_MT_SAFE { return m_protectIds; }
     bool allPublic() const { return m_public; }
     bool publicParams() const { return m_publicParams; }
     bool publicOff() const { return m_publicIgnore; }
+    bool publicFlatRd() const { return m_publicFlatRd; }
     bool publicFlatRW() const { return m_publicFlatRW; }
     int publicDepth() const { return m_publicDepth; }
-    bool anyPublicFlat() const { return m_publicParams || m_publicFlatRW || m_publicDepth; }
+    bool anyPublicFlat() const {
+        return m_publicParams || m_publicFlatRd || m_publicFlatRW || m_publicDepth;
+    }
     bool lintOnly() const VL_MT_SAFE { return m_lintOnly; }
     bool ignc() const { return m_ignc; }
     bool quietExit() const VL_MT_SAFE { return m_quietExit; }
     bool quietStats() const VL_MT_SAFE { return m_quietStats; }
     bool reportUnoptflat() const { return m_reportUnoptflat; }
+    bool restrictPointers() const { return m_restrictPointers; }
     bool verilate() const { return m_verilate; }
     bool vpi() const { return m_vpi; }
+    bool vpiDirty() const { return m_vpiDirty; }
     bool waiverMultiline() const { return m_waiverMultiline; }
     bool xInitialEdge() const { return m_xInitialEdge; }
     bool xmlOnly() const { return m_xmlOnly; }
     bool serializeOnly() const { return m_xmlOnly || m_jsonOnly; }
     bool topIfacesSupported() const { return lintOnly() && !hierarchical(); }
 
+    int batchLanes() const { return m_batchLanes; }
     int buildJobs() const VL_MT_SAFE { return m_buildJobs; }
     int convergeLimit() const { return m_convergeLimit; }
     int coverageExprMax() const { return m_coverageExprMax; }
     int coverageMaxWidth() const { return m_coverageMaxWidth; }
+    int debugCheckInterval() const { return m_debugCheckInterval; }
     bool dumpTreeAddrids() const VL_MT_SAFE;
     int expandLimit() const { return m_expandLimit; }
+    int expandVectorWords() const { return m_expandVectorWords; }
     int gateStmts() const { return m_gateStmts; }
     int ifDepth() const { return m_ifDepth; }
     int inlineMult() const { return m_inlineMult; }
     int instrCountDpi() const { return m_instrCountDpi; }
+    string instrCountTable() const { return m_instrCountTable; }
     int localizeMaxSize() const { return m_localizeMaxSize; }
     bool jsonEditNums() const { return m_jsonEditNums; }
     bool jsonIds() const { return m_jsonIds; }
@@ -630,8 +687,10 @@ public:
     int outputSplitCFuncs() const { return m_outputSplitCFuncs; }
     int outputSplitCTrace() const { return m_outputSplitCTrace; }
     int outputGroups() const { return m_outputGroups; }
+    bool outputGroupsUser() const { return m_outputGroupsUser; }
     int pinsBv() const VL_MT_SAFE { return m_pinsBv; }
     int reloopLimit() const { return m_reloopLimit; }
+    int sparseArrayThreshold() const { return m_sparseArrayThreshold; }
     VOptionBool skipIdentical() const { return m_skipIdentical; }
     bool stopFail() const { return m_stopFail; }
     int threads() const VL_MT_SAFE { return m_threads; }
@@ -643,8 +702,10 @@ public:
     VTimescale timeOverrideUnit() const { return m_timeOverrideUnit; }
     VTimescale timeComputePrec(const VTimescale& flag) const;
     VTimescale timeComputeUnit(const VTimescale& flag) const;
+    int tspExactLimit() const VL_MT_SAFE { return m_tspExactLimit; }
     int traceDepth() const { return m_traceDepth; }
     TraceFormat traceFormat() const { return m_traceFormat; }
+    bool traceEnabledBin() const { return trace() && traceFormat().bin(); }
     bool traceEnabledFst() const { return trace() && traceFormat().fst(); }
     bool traceEnabledSaif() const { return trace() && traceFormat().saif(); }
     bool traceEnabledVcd() const { return trace() && traceFormat().vcd(); }
@@ -653,7 +714,16 @@ public:
     int traceThreads() const { return m_traceThreads; }
     bool useTraceOffload() const { return trace() && traceFormat().fst() && traceThreads() > 1; }
     bool useTraceParallel() const {
-        return trace() && traceFormat().vcd() && (threads() > 1 || hierChild() > 1);
+        return trace()
+               && (traceFormat().vcd() || traceFormat().bin() || traceFormat().saif()
+                   || (traceFormat().fst() && !useTraceOffload()))
+               && (threads() > 1 || hierChild() > 1);
+    }
+    bool useThreadsWorkStealing() const {
+        return threadsWorkStealing() && mtasks() && hierBlocks().empty() && !hierChild();
+    }
+    bool useCoverageShards() const {
+        return coverage() && coverageShards() && mtasks() && hierBlocks().empty() && !hierChild();
     }
     bool useFstWriterThread() const { return traceThreads() && traceFormat().fst(); }
     unsigned vmTraceThreads() const {
@@ -662,6 +732,7 @@ public:
     int unrollCount() const { return m_unrollCount; }
     int unrollCountAdjusted(const VOptionBool& full, bool generate, bool simulate);
     int unrollStmts() const { return m_unrollStmts; }
+    int unrollPartial() const { return m_unrollPartial; }
     int verilateJobs() const { return m_verilateJobs; }
 
     int compLimitBlocks() const { return m_compLimitBlocks; }
@@ -674,10 +745,12 @@ public:
     }
     string exeName() const { return m_exeName != "" ? m_exeName : prefix(); }
     VFileLibList hierParamFile() const { return m_hierParamsFile; }
+    string hierCache() const { return m_hierCache; }
     string jsonOnlyOutput() const { return m_jsonOnlyOutput; }
     string jsonOnlyMetaOutput() const { return m_jsonOnlyMetaOutput; }
     string l2Name() const { return m_l2Name; }
     string libCreate() const { return m_libCreate; }
+    bool libCreateBatch() const { return m_libCreateBatch; }
     string libCreateName(bool shared) {
         string libName = "lib" + libCreate();
         if (shared) {
@@ -736,6 +809,7 @@ public:
     bool fConstBitOpTree() const { return m_fConstBitOpTree; }
     bool fConstEager() const { return m_fConstEager; }
     bool fDedupe() const { return m_fDedupe; }
+    bool fDelayFsm() const { return m_fDelayFsm; }
     bool fDfgBreakCyckes() const { return m_fDfgBreakCycles; }
     bool fDfgPeephole() const { return m_fDfgPeephole; }
     bool fDfgPreInline() const { return m_fDfgPreInline; }
@@ -747,6 +821,7 @@ public:
     bool fDeadAssigns() const { return m_fDeadAssigns; }
     bool fDeadCells() const { return m_fDeadCells; }
     bool fExpand() const { return m_fExpand; }
+    bool fForceFastPath() const { return m_fForceFastPath; }
     bool fFuncBalanceCat() const { return m_fFuncBalanceCat; }
     bool fFuncSplitCat() const { return m_fFuncSplitCat; }
     bool fFunc() const { return fFuncSplitCat() || fFuncBalanceCat(); }
@@ -759,15 +834,20 @@ public:
     bool fMergeCond() const { return m_fMergeCond; }
     bool fMergeCondMotion() const { return m_fMergeCondMotion; }
     bool fMergeConstPool() const { return m_fMergeConstPool; }
+    bool fPeriodic() const { return m_fPeriodic; }
     bool fReloop() const { return m_fReloop; }
     bool fReorder() const { return m_fReorder; }
+    bool fShareReplicas() const { return m_fShareReplicas; }
     bool fSlice() const { return m_fSlice; }
+    bool fSparseEval() const { return m_fSparseEval; }
     bool fSplit() const { return m_fSplit; }
+    bool fSplitTemps() const { return m_fSplitTemps; }
     bool fSubst() const { return m_fSubst; }
     bool fSubstConst() const { return m_fSubstConst; }
     bool fTable() const { return m_fTable; }
     bool fTaskifyAll() const { return m_fTaskifyAll; }
     bool fVarSplit() const { return m_fVarSplit; }
+    bool fVarSplitArrays() const { return m_fVarSplitArrays; }
 
     string traceClassBase() const VL_MT_SAFE { return m_traceFormat.classBase(); }
     string traceClassLang() const { return m_traceFormat.classBase() + (systemC() ? "Sc" : "C"); }
@@ -777,6 +857,7 @@ public:
     }
 
     bool hierarchical() const { return m_hierarchical; }
+    bool hugePages() const { return m_hugePages; }
     int hierChild() const VL_MT_SAFE { return m_hierChild; }
     int hierThreads() const VL_MT_SAFE { return m_hierThreads == 0 ? m_threads : m_hierThreads; }
     bool hierTop() const VL_MT_SAFE { return !m_hierChild && !m_hierBlocks.empty(); }
@@ -794,6 +875,8 @@ public:
     // Return options for child hierarchical blocks when forTop==false, otherwise returns args for
     // the top module.
     string allArgsStringForHierBlock(bool forTop) const;
+    // Return arguments for Verilating again with --build-pgo
+    string allArgsStringForPgo() const;
     void parseOpts(FileLine* fl, int argc, char** argv) VL_MT_DISABLED;
     void parseOptsList(FileLine* fl, const string& optdir, int argc, char** argv) VL_MT_DISABLED;
     void parseOptsFile(FileLine* fl, const string& filename, bool rel) VL_MT_DISABLED;
@@ -27,7 +27,9 @@
 #include "V3Ast.h"
 #include "V3Graph.h"
 #include "V3OrderGraph.h"
+#include "V3Stats.h"
 
+#include <algorithm>
 #include <limits>
 #include <map>
 #include <vector>
@@ -51,6 +53,10 @@ class V3OrderCFuncEmitter final {
     }();
     // Current function being populated
     AstCFunc* m_funcp = nullptr;
+    // Condition of the last statement added to the current function, if it is an 'if'
+    const AstNodeExpr* m_lastCondp = nullptr;
+    // True if the current function contains only combinational logic
+    bool m_funcCombo = false;
     // Function ordinals to ensure unique names
     std::map<std::pair<AstNodeModule*, std::string>, unsigned> m_funcNums;
     // The result Active blocks that must be invoked to run the code in the order it was emitted
@@ -67,6 +73,102 @@ class V3OrderCFuncEmitter final {
         return name;
     }
 
+    // With -fsparse-eval, guard the body of the finished combinational function 'm_funcp', so
+    // it is skipped when none of the variables it references changed since it last ran. Only
+    // functions without side effects, that never read a variable they also write before
+    // fully assigning it, are guarded. Re-running such a function on unchanged variables
+    // leaves them unchanged, so skipping it is exact, even if other logic writes them too.
+    void gateOnChanges() {
+        // Budget: at most this many variables to compare, for at least this much code each
+        constexpr size_t maxVars = 16;
+        constexpr size_t minNodesPerVar = 16;
+
+        // Reject functions with statements or expressions that are not plain computation
+        const auto isSimple = [](AstNode* nodep) {
+            if (VN_IS(nodep, NodeStmt)) {
+                if (VN_IS(nodep, AssignDly)) return false;
+                return VN_IS(nodep, NodeAssign) || VN_IS(nodep, If) || VN_IS(nodep, Comment);
+            }
+            if (AstNodeVarRef* const refp = VN_CAST(nodep, NodeVarRef)) {
+                return VN_IS(refp, VarRef) && refp->varScopep();
+            }
+            if (AstNodeExpr* const exprp = VN_CAST(nodep, NodeExpr)) {
+                return exprp->isPure() && exprp->isGateOptimizable();
+            }
+            return true;
+        };
+        for (AstNode* stmtp = m_funcp->stmtsp(); stmtp; stmtp = stmtp->nextp()) {
+            if (stmtp->exists([&](AstNode* nodep) { return !isSimple(nodep); })) return;
+        }
+
+        // Gather referenced variables, in order of first reference
+        struct VarState final {
+            bool m_defined = false;  // Fully assigned on all paths so far
+            bool m_readUndefined = false;  // Read before being fully assigned
+            bool m_written = false;  // Written somewhere
+        };
+        std::vector<AstVarScope*> vscps;
+        std::map<AstVarScope*, VarState> states;
+        const auto gather = [&](AstNode* nodep) {
+            nodep->foreach([&](AstVarRef* refp) {
+                AstVarScope* const vscp = refp->varScopep();
+                VarState& state = states[vscp];
+                if (std::find(vscps.begin(), vscps.end(), vscp) == vscps.end()) {
+                    vscps.push_back(vscp);
+                }
+                if (refp->access().isReadOrRW() && !state.m_defined) state.m_readUndefined = true;
+                if (refp->access().isWriteOrRW()) state.m_written = true;
+            });
+        };
+        for (AstNode* stmtp = m_funcp->stmtsp(); stmtp; stmtp = stmtp->nextp()) {
+            // An unconditional whole variable assignment fully defines the variable
+            AstNodeAssign* const assignp = VN_CAST(stmtp, NodeAssign);
+            AstVarRef* const lhsp = assignp ? VN_CAST(assignp->lhsp(), VarRef) : nullptr;
+            if (!lhsp) {
+                gather(stmtp);
+                continue;
+            }
+            gather(assignp->rhsp());
+            gather(lhsp);
+            states[lhsp->varScopep()].m_defined = true;
+        }
+
+        // Check the variables are few, narrow numbers, and all inputs are left unchanged
+        if (vscps.empty() || vscps.size() > maxVars) return;
+        const size_t nodeCount = m_funcp->nodeCount();
+        if (nodeCount < minNodesPerVar * (vscps.size() + 1)) return;
+        for (AstVarScope* const vscp : vscps) {
+            const VarState& state = states[vscp];
+            if (state.m_readUndefined && state.m_written) return;
+            const AstBasicDType* const basicp = VN_CAST(vscp->dtypep()->skipRefp(), BasicDType);
+            if (!basicp || !basicp->keyword().isIntNumeric()) return;
+            if (vscp->width() > VL_QUADSIZE) return;
+        }
+
+        // Build: if (!(valid && a == prev_a && ...)) { <body>; valid = 1; prev_a = a; ... }
+        FileLine* const flp = m_funcp->fileline();
+        AstScope* const scopep = m_funcp->scopep();
+        const std::string prefix = "__Vsparse__" + m_funcp->name();
+        AstVarScope* const validp = scopep->createTemp(prefix + "__valid", 1);
+        AstNodeExpr* condp = new AstVarRef{flp, validp, VAccess::READ};
+        AstNode* const updatesp = new AstAssign{flp, new AstVarRef{flp, validp, VAccess::WRITE},
+                                                new AstConst{flp, AstConst::BitTrue{}}};
+        for (size_t i = 0; i < vscps.size(); ++i) {
+            AstVarScope* const vscp = vscps[i];
+            AstVarScope* const prevp
+                = scopep->createTempLike(prefix + "__prev" + std::to_string(i), vscp);
+            condp = new AstLogAnd{flp, condp,
+                                  new AstEq{flp, new AstVarRef{flp, vscp, VAccess::READ},
+                                            new AstVarRef{flp, prevp, VAccess::READ}}};
+            updatesp->addNext(new AstAssign{flp, new AstVarRef{flp, prevp, VAccess::WRITE},
+                                            new AstVarRef{flp, vscp, VAccess::READ}});
+        }
+        AstNode* const bodyp = m_funcp->stmtsp()->unlinkFrBackWithNext();
+        bodyp->addNext(updatesp);
+        m_funcp->addStmtsp(new AstIf{flp, new AstLogNot{flp, condp}, bodyp});
+        V3Stats::addStatSum("Optimizations, Sparse eval gated functions", 1);
+    }
+
 public:
     // CONSTRUCTOR
     V3OrderCFuncEmitter(const std::string& tag, bool slow)
@@ -77,8 +179,19 @@ public:
 
     // Force the creation of a new function
     void forceNewFunction() {
+        if (m_funcp && m_funcCombo && !m_slow && v3Global.opt.fSparseEval()) gateOnChanges();
         m_size = 0;
         m_funcp = nullptr;
+        m_lastCondp = nullptr;
+    }
+
+    // True if splitting before 'stmtp' should be deferred. Consecutive 'if' statements with
+    // the same condition are merged by V3MergeCond, but only within one function, so keep
+    // them together, up to twice the split size.
+    bool deferSplit(const AstNode* stmtp) const {
+        if (!m_lastCondp || m_size - m_splitSize >= m_splitSize) return false;
+        const AstNodeIf* const ifp = VN_CAST(stmtp, NodeIf);
+        return ifp && ifp->condp()->sameTree(m_lastCondp);
     }
 
     // Retrieve Active block, which when executed will call the constructed functions
@@ -99,13 +212,15 @@ public:
         // Some properties to consider
         const bool suspendable = procp && procp->isSuspendable();
         const bool needProcess = procp && procp->needProcess();
+        // Shared procedures get functions of their own, so all copies are identical
+        const bool shared = procp && procp->isShared();
         // TODO: This is a bit muddy: 'initial forever @(posedge clk) begin ... end' is a fancy
         //       way of saying always @(posedge clk), so it might be quite hot...
         //       Also, if m_funcp is slow, but this one isn't we should force a new function
         const bool slow = m_slow && !(suspendable && VN_IS(procp, Always));
 
-        // Put suspendable processes into individual functions on their own
-        if (suspendable) forceNewFunction();
+        // Put suspendable and shared processes into individual functions on their own
+        if (suspendable || shared) forceNewFunction();
         // When profCFuncs, create a new function for each logic vertex
         if (v3Global.opt.profCFuncs()) forceNewFunction();
         // If the new domain is different, force a new function as it needs to be called separately
@@ -128,7 +243,13 @@ public:
             // Unlink the current statement from the next statement (if any)
             if (nextp) nextp->unlinkFrBackWithNext();
             // Split the function if too large, but don't split suspendable processes
-            if (!suspendable && m_size >= m_splitSize) forceNewFunction();
+            if (!suspendable && m_size >= m_splitSize) {
+                if (deferSplit(currp)) {
+                    V3Stats::addStatSum("Optimizations, Order splits deferred to merge", 1);
+                } else {
+                    forceNewFunction();
+                }
+            }
             // Create a new function if we don't have a current one
             if (!m_funcp) {
                 UASSERT_OBJ(!m_size, currp, "Should have used forceNewFunction");
@@ -142,6 +263,7 @@ public:
                 m_funcp->isLoose(true);
                 m_funcp->slow(slow);
                 scopep->addBlocksp(m_funcp);
+                m_funcCombo = !suspendable;
                 // Create call to the new functino
                 AstCCall* const callp = new AstCCall{flp, m_funcp};
                 callp->dtypeSetVoid();
@@ -153,11 +275,14 @@ public:
             }
             // Add the code to the current function
             m_funcp->addStmtsp(currp);
+            const AstNodeIf* const ifp = VN_CAST(currp, NodeIf);
+            m_lastCondp = ifp ? ifp->condp() : nullptr;
+            m_funcCombo &= lVtxp->isCombo();
             // If splitting, add in the size of the code we just added
             if (m_split) m_size += currp->nodeCount();
         }
-        // Put suspendable processes into individual functions on their own
-        if (suspendable) forceNewFunction();
+        // Put suspendable and shared processes into individual functions on their own
+        if (suspendable || shared) forceNewFunction();
     }
 };
 
@@ -142,6 +142,7 @@ class OrderLogicVertex final : public OrderEitherVertex {
     AstNode* const m_nodep;  // The logic this vertex represents
     AstScope* const m_scopep;  // Scope the logic is under
     AstSenTree* const m_hybridp;  // Additional sensitivities for hybrid combinational logic
+    const bool m_isCombo;  // Combinational logic (domain is assigned later from drivers)
 
 public:
     // CONSTRUCTOR
@@ -150,7 +151,8 @@ public:
         : OrderEitherVertex{graphp, domainp},
           m_nodep{nodep},
           m_scopep{scopep},
-          m_hybridp{hybridp} {
+          m_hybridp{hybridp},
+          m_isCombo{!domainp && !hybridp} {
         UASSERT_OBJ(scopep, nodep, "Must not be null");
         UASSERT_OBJ(!(domainp && hybridp), nodep, "Cannot have bot domainp and hybridp set");
     }
@@ -163,6 +165,7 @@ public:
     AstNode* nodep() const VL_MT_STABLE { return m_nodep; }
     AstScope* scopep() const VL_MT_STABLE { return m_scopep; }
     AstSenTree* hybridp() const { return m_hybridp; }
+    bool isCombo() const { return m_isCombo; }
 
     // LCOV_EXCL_START // Debug code
     string name() const override VL_MT_STABLE {
@@ -198,6 +198,37 @@ class OrderMoveGraphSerializer final {
         }
     }
 
+    // True if the scopes are adjacent in the hierarchy: parent, child or sibling
+    static bool nearScopes(const AstScope* ap, const AstScope* bp) {
+        if (!ap || !bp) return false;
+        const AstScope* const aAbovep = ap->aboveScopep();
+        const AstScope* const bAbovep = bp->aboveScopep();
+        return aAbovep == bp || bAbovep == ap || (aAbovep && aAbovep == bAbovep);
+    }
+
+    // Choose the DomScope to continue with after 'currDomScope' ran out of ready vertices.
+    // Prefer to continue under the same domain, to keep the trigger checks merged, and within
+    // that, with a scope near the current one, as the state of neighbouring instances is
+    // laid out together. Otherwise prefer the same scope under another domain. Ties are
+    // broken by the order DomScopes became ready, to keep the result deterministic. Looking
+    // for a near scope is limited to a window after the first candidate, to stay linear.
+    OrderMoveDomScope* pickNext(const OrderMoveDomScope& currDomScope) {
+        constexpr size_t NEAR_WINDOW = 64;
+        OrderMoveDomScope* sameDomainp = nullptr;
+        OrderMoveDomScope* sameScopep = nullptr;
+        size_t window = NEAR_WINDOW;
+        for (OrderMoveDomScope& domScope : m_readyDomScopeps) {
+            if (domScope.domainp() == currDomScope.domainp()) {
+                if (nearScopes(domScope.scopep(), currDomScope.scopep())) return &domScope;
+                if (!sameDomainp) sameDomainp = &domScope;
+            } else if (!sameScopep && domScope.scopep() == currDomScope.scopep()) {
+                sameScopep = &domScope;
+            }
+            if (sameDomainp && !--window) break;
+        }
+        return sameDomainp ? sameDomainp : sameScopep;
+    }
+
 public:
     // CONSTRUCTOR
     explicit OrderMoveGraphSerializer(OrderMoveGraph& moveGraph) {
@@ -242,17 +273,8 @@ public:
             if (!nDeps) ready(dVtxp);
         }
 
-        // If no more ready vertices in the current DomScope, prefer to continue with a new scope
-        // under the same domain.
-        if (currReadyList.empty()) {
-            m_nextDomScopep = nullptr;
-            for (OrderMoveDomScope& domScope : m_readyDomScopeps) {
-                if (domScope.domainp() == currDomScope.domainp()) {
-                    m_nextDomScopep = &domScope;
-                    break;
-                }
-            }
-        }
+        // If no more ready vertices in the current DomScope, pick the next one for locality
+        if (currReadyList.empty()) m_nextDomScopep = pickNext(currDomScope);
 
         // Finally yield the selected vertex
         return mVtxp;
@@ -37,6 +37,7 @@
 
 #include <array>
 #include <memory>
+#include <set>
 #include <type_traits>
 #include <unordered_map>
 #include <unordered_set>
@@ -177,7 +178,7 @@ using EdgeHeap = PairingHeap<EdgeKey>;
 // MTask utility classes
 
 struct MergeCandidateKey final {
-    // Note: Structure layout chosen to minimize padding in PairingHeap<*>::Node
+    // Note: Structure layout chosen to minimize padding in V3Scoreboard<*>::Node
     uint64_t m_id;  // Unique ID part of edge score
     uint64_t m_score;  // Score part of ID
     bool operator<(const MergeCandidateKey& other) const {
@@ -329,6 +330,10 @@ private:
     // In abstract time units.
     uint64_t m_cost = 0;
 
+    // Domain of all logic in this LogicMTask, nullptr if none or if m_multiDomain
+    const AstSenTree* m_domainp = nullptr;
+    bool m_multiDomain = false;  // Contains logic of different domains
+
     // Cost of critical paths going FORWARD from graph-start to the start
     // of this vertex, and also going REVERSE from the end of the graph to
     // the end of the vertex. Same units as m_cost.
@@ -366,6 +371,7 @@ public:
             m_mVertices.linkBack(mVtxp);
             if (const OrderLogicVertex* const olvp = mVtxp->logicp()) {
                 m_cost += V3InstrCount::count(olvp->nodep(), true);
+                m_domainp = olvp->domainp();
             }
         }
     }
@@ -380,6 +386,17 @@ public:
     void moveAllVerticesFrom(LogicMTask* otherp) {
         m_mVertices.splice(m_mVertices.end(), otherp->vertexList());
         m_cost += otherp->m_cost;
+        if (!sameDomain(otherp)) {
+            m_domainp = nullptr;
+            m_multiDomain = true;
+        } else if (!m_domainp) {
+            m_domainp = otherp->m_domainp;
+        }
+    }
+    // True if merging with 'otherp' would not mix logic of different domains
+    bool sameDomain(const LogicMTask* otherp) const {
+        if (m_multiDomain || otherp->m_multiDomain) return false;
+        return !m_domainp || !otherp->m_domainp || m_domainp == otherp->m_domainp;
     }
     static uint64_t incGeneration() {
         static uint64_t s_generation = 0;
@@ -650,6 +667,10 @@ static uint64_t edgeScore(const MTaskEdge* edgep) {
 void MergeCandidate::rescore() {
     if (const SiblingMC* const sibp = toSiblingMC()) {
         m_key.m_score = siblingScore(sibp);
+        // The '2 +' favors keeping logic of independent domains in different
+        // MTasks, so they run concurrently when they are triggered together,
+        // over an otherwise-equal-scoring merge.
+        if (!sibp->ap()->sameDomain(sibp->bp())) m_key.m_score += 2;
     } else {
         // The '1 +' favors merging a SiblingMC over an otherwise-
         // equal-scoring MTaskEdge. The comment on selfTest() talks
@@ -1106,6 +1127,57 @@ static void partRedirectEdgesFrom(V3Graph& graph, LogicMTask* recipientp, LogicM
     VL_DO_DANGLING(donorp->unlinkDelete(&graph), donorp);
 }
 
+//######################################################################
+// Chain coarsening
+
+// Merge each mtask into its only predecessor, when that predecessor has no other successor,
+// while the merged cost stays within 'costLimit'. Such a pair always executes back to back,
+// so merging it loses no parallelism, but it removes a vertex and an edge that Contraction
+// would otherwise score and merge one at a time. This is the coarsening phase of a
+// multilevel partitioner, Contraction then partitions and refines the coarsened graph.
+// The graph must be ordered, so one pass reaches the fixed point.
+static void partCoarsenChains(V3Graph& mTaskGraph, uint64_t costLimit, LogicMTask* entryMTaskp,
+                              LogicMTask* exitMTaskp) {
+    size_t merges = 0;
+    for (V3GraphVertex* const vtxp : mTaskGraph.vertices().unlinkable()) {
+        LogicMTask* const donorp = vtxp->as<LogicMTask>();
+        if (donorp == exitMTaskp || !donorp->inSize1()) continue;
+        MTaskEdge* const edgep = static_cast<MTaskEdge*>(donorp->inEdges().frontp());
+        LogicMTask* const recipientp = edgep->fromMTaskp();
+        if (recipientp == entryMTaskp || !recipientp->outSize1()) continue;
+        if (recipientp->cost() + donorp->cost() > costLimit) continue;
+        // Remove the connecting edge, then donorp's out edges move to recipientp
+        recipientp->removeRelativeMTask(donorp);
+        recipientp->removeRelativeEdge<GraphWay::FORWARD>(edgep);
+        donorp->removeRelativeEdge<GraphWay::REVERSE>(edgep);
+        VL_DO_DANGLING(edgep->unlinkDelete(), edgep);
+        recipientp->moveAllVerticesFrom(donorp);
+        partRedirectEdgesFrom(mTaskGraph, recipientp, donorp, nullptr);
+        ++merges;
+    }
+    UINFO(4, "Partitioner chain coarsening merged " << merges << " mtasks");
+}
+
+static void partSelfTestCoarsenChains() {
+    // a -> b -> c -> d, a -> e, with d too costly to merge into the others
+    V3Graph mTaskGraph;
+    std::array<LogicMTask*, 5> vx;
+    for (LogicMTask*& vxp : vx) {
+        vxp = new LogicMTask{&mTaskGraph, nullptr};
+        vxp->setCost(1);
+    }
+    vx[3]->setCost(10);
+    new MTaskEdge{&mTaskGraph, vx[0], vx[1], 1};
+    new MTaskEdge{&mTaskGraph, vx[1], vx[2], 1};
+    new MTaskEdge{&mTaskGraph, vx[2], vx[3], 1};
+    new MTaskEdge{&mTaskGraph, vx[0], vx[4], 1};
+    partCoarsenChains(mTaskGraph, 10, nullptr, nullptr);
+    // Only c merged into b, a has two successors
+    UASSERT_SELFTEST(size_t, mTaskGraph.vertices().size(), 4);
+    UASSERT_SELFTEST(uint64_t, vx[1]->cost(), 2);
+    UASSERT_SELFTEST(bool, vx[1]->hasRelativeMTask(vx[3]), true);
+}
+
 //######################################################################
 // Contraction
 
@@ -1706,9 +1778,10 @@ public:
 // DpiImportCallVisitor
 
 // Scan node, indicate whether it contains a call to a DPI imported
-// routine.
+// routine, and which side-effect domains those calls are in. Imports
+// without a 'dpi_domain' control are all in the default domain "".
 class DpiImportCallVisitor final : public VNVisitor {
-    bool m_hasDpiHazard = false;  // Found a DPI import call.
+    std::set<string> m_domains;  // Domains of the DPI import calls with hazards
     bool m_tracingCall = false;  // Iterating into a CCall to a CFunc
     // METHODS
     void visit(AstCFunc* nodep) override {
@@ -1719,9 +1792,9 @@ class DpiImportCallVisitor final : public VNVisitor {
                                  : !v3Global.opt.threadsDpiUnpure()) {
                 // If hierarchical DPI wrapper cost is not found or is of a 0 cost,
                 // we have a normal DPI which induces DPI hazard by default.
-                m_hasDpiHazard = V3Control::getProfileData(nodep->cname()) == 0;
-                UINFO(9, "DPI wrapper '" << nodep->cname()
-                                         << "' has dpi hazard = " << m_hasDpiHazard);
+                const bool hazard = V3Control::getProfileData(nodep->cname()) == 0;
+                if (hazard) m_domains.insert(V3Control::getDpiDomain(nodep->cname()));
+                UINFO(9, "DPI wrapper '" << nodep->cname() << "' has dpi hazard = " << hazard);
             }
         }
         iterateChildren(nodep);
@@ -1737,7 +1810,8 @@ class DpiImportCallVisitor final : public VNVisitor {
 public:
     // CONSTRUCTORS
     explicit DpiImportCallVisitor(AstNode* nodep) { iterate(nodep); }
-    bool hasDpiHazard() const { return m_hasDpiHazard; }
+    bool hasDpiHazard() const { return !m_domains.empty(); }
+    const std::set<string>& domains() const { return m_domains; }
     ~DpiImportCallVisitor() override = default;
 
 private:
@@ -1974,13 +2048,28 @@ class FixDataHazards final {
         // Handle nodes containing DPI calls, we want to serialize those
         // by default unless user gave '--threads-dpi none'.
         // Same basic strategy as above to serialize access to SC vars.
+        // Calls are only serialized against calls in the same 'dpi_domain',
+        // so each domain gets its own chain. Merging changes the mtasks, so
+        // the hazards are found again for each domain.
         if (!v3Global.opt.threadsDpiPure() || !v3Global.opt.threadsDpiUnpure()) {
-            TasksByRank tasksByRank;
+            std::set<string> domains;
             for (V3GraphVertex& vtx : m_mTaskGraph.vertices()) {
-                LogicMTask& mtask = static_cast<LogicMTask&>(vtx);
-                if (hasDpiHazard(&mtask)) tasksByRank[mtask.rank()].insert(&mtask);
+                const std::set<string> mtaskDomains
+                    = dpiHazardDomains(static_cast<LogicMTask*>(&vtx));
+                domains.insert(mtaskDomains.begin(), mtaskDomains.end());
             }
-            mergeSameRankTasks(tasksByRank);
+            for (const string& domain : domains) {
+                TasksByRank tasksByRank;
+                for (V3GraphVertex& vtx : m_mTaskGraph.vertices()) {
+                    LogicMTask& mtask = static_cast<LogicMTask&>(vtx);
+                    if (dpiHazardDomains(&mtask).count(domain)) {
+                        tasksByRank[mtask.rank()].insert(&mtask);
+                    }
+                }
+                mergeSameRankTasks(tasksByRank);
+            }
+            const size_t named = domains.size() - domains.count("");
+            if (named) V3Stats::addStatSum("Optimizations, DPI domain chains", named);
         }
     }
 
@@ -2029,7 +2118,8 @@ class FixDataHazards final {
             lastRecipientp = recipientp;
         }
     }
-    bool hasDpiHazard(LogicMTask* mtaskp) {
+    std::set<string> dpiHazardDomains(LogicMTask* mtaskp) {
+        std::set<string> domains;
         for (const OrderMoveVertex& mVtx : mtaskp->vertexList()) {
             if (OrderLogicVertex* const lvtxp = mVtx.logicp()) {
                 // NOTE: We don't handle DPI exports. If testbench code calls a
@@ -2040,10 +2130,11 @@ class FixDataHazards final {
                 // Find all calls to DPI-imported functions, we can put those
                 // into a serial order at least. That should solve the most
                 // likely DPI-related data hazards.
-                if (DpiImportCallVisitor{lvtxp->nodep()}.hasDpiHazard()) return true;
+                const DpiImportCallVisitor visitor{lvtxp->nodep()};
+                domains.insert(visitor.domains().begin(), visitor.domains().end());
             }
         }
-        return false;
+        return domains;
     }
 
     VL_UNCOPYABLE(FixDataHazards);
@@ -2301,10 +2392,6 @@ class Partitioner final {
         debugMTaskGraphStats(*m_mTaskGraphp, "hazards");
         hashGraphDebug(*m_mTaskGraphp, "mTaskGraphpp after fixDataHazards()");
 
-        // Setup the critical path into and out of each node.
-        partInitCriticalPaths(*m_mTaskGraphp);
-        hashGraphDebug(*m_mTaskGraphp, "after partInitCriticalPaths()");
-
         // Order the graph. We know it's already ranked from fixDataHazards()
         // so we don't need to rank it again.
         //
@@ -2324,7 +2411,9 @@ class Partitioner final {
         //
         // Some tests disable this, hence the test on threadsCoarsen().
         // Coarsening is always enabled in production.
-        if (v3Global.opt.threadsCoarsen()) {
+        const bool coarsen = v3Global.opt.threadsCoarsen();
+        uint64_t cpLimit = 0;
+        if (coarsen) {
             const int targetParFactor = v3Global.opt.threads();
             UASSERT(targetParFactor >= 2, "Should not reach Partitioner when --threads <= 1");
 
@@ -2335,10 +2424,19 @@ class Partitioner final {
             // when scheduling them.
             const unsigned fudgeNumerator = 3;
             const unsigned fudgeDenominator = 5;
-            const uint64_t cpLimit
-                = ((totalGraphCost * fudgeNumerator) / (targetParFactor * fudgeDenominator));
+            cpLimit = ((totalGraphCost * fudgeNumerator) / (targetParFactor * fudgeDenominator));
             UINFO(4, "Partitioner set cpLimit = " << cpLimit);
 
+            // First cheaply merge serial chains, so Contraction starts from a smaller graph
+            partCoarsenChains(*m_mTaskGraphp, cpLimit, m_entryMTaskp, m_exitMTaskp);
+            debugMTaskGraphStats(*m_mTaskGraphp, "chains");
+        }
+
+        // Setup the critical path into and out of each node.
+        partInitCriticalPaths(*m_mTaskGraphp);
+        hashGraphDebug(*m_mTaskGraphp, "after partInitCriticalPaths()");
+
+        if (coarsen) {
             Contraction::apply(*m_mTaskGraphp, cpLimit, m_entryMTaskp, m_exitMTaskp,
                                // --debugPartition is used by tests
                                // to enable slow assertions.
@@ -2515,5 +2613,6 @@ void V3Order::selfTestParallel() {
     UINFO(2, __FUNCTION__ << ":");
     PropagateCp<GraphWay::FORWARD>::selfTest();
     PropagateCp<GraphWay::REVERSE>::selfTest();
+    partSelfTestCoarsenChains();
     Contraction::selfTest();
 }
@@ -76,6 +76,9 @@ VL_DEFINE_DEBUG_FUNCTIONS;
 #else
 # include <sys/time.h>
 # include <sys/wait.h>  // Needed on FreeBSD for WIFEXITED
+# ifdef __GLIBC__
+#  include <malloc.h>  // malloc_trim
+# endif
 # include <unistd.h>  // usleep
 #endif
 // clang-format on
@@ -468,6 +471,13 @@ void V3Os::u_sleep(int64_t usec) {
 #endif
 }
 
+void V3Os::releaseFreeMemory() {
+#ifdef __GLIBC__
+    // glibc keeps freed heap for reuse; smaller allocations are otherwise never returned
+    ::malloc_trim(0);
+#endif
+}
+
 //######################################################################
 // METHODS (sub command)
 
@@ -79,6 +79,8 @@ public:
     static void u_sleep(int64_t usec);  ///< Sleep for a given number of microseconds.
     /// Return wall time since epoch in microseconds, or 0 if not implemented
     static uint64_t timeUsecs();
+    /// Return memory freed by the program to the operating system, where supported
+    static void releaseFreeMemory();
 
     // METHODS (sub command)
     /// Run system command, returns the exit code of the child process.
@@ -58,9 +58,11 @@
 #include "V3Unroll.h"
 #include "V3Width.h"
 
+#include <algorithm>
 #include <cctype>
 #include <deque>
 #include <memory>
+#include <unordered_map>
 #include <vector>
 
 VL_DEFINE_DEBUG_FUNCTIONS;
@@ -904,9 +906,32 @@ class ParamProcessor final {
             longname = parameterizedHierBlockName(srcModpr, paramsp);
             any_overrides = longname != srcModpr->name();
         } else {
+            // The name must not depend on the order the pins were written in, else
+            // '#(.A(1), .B(2))' and '#(.B(2), .A(1))' would make two identical modules,
+            // so order each parameter's part of the name by parameter declaration order
+            std::unordered_map<const AstNode*, size_t> declOrder;
+            for (const AstNode* stmtp = srcModpr->stmtsp(); stmtp; stmtp = stmtp->nextp()) {
+                declOrder.emplace(stmtp, declOrder.size());
+            }
+            std::vector<std::pair<size_t, std::string>> parts;
             for (AstPin* pinp = paramsp; pinp; pinp = VN_AS(pinp->nextp(), Pin)) {
-                cellPinCleanup(nodep, pinp, srcModpr, longname /*ref*/, any_overrides /*ref*/);
+                const AstNode* const declp = pinp->modVarp()
+                                                 ? static_cast<const AstNode*>(pinp->modVarp())
+                                                 : pinp->modPTypep();
+                const auto it = declOrder.find(declp);
+                string part;
+                cellPinCleanup(nodep, pinp, srcModpr, part /*ref*/, any_overrides /*ref*/);
+                if (!part.empty()) {
+                    parts.emplace_back(it == declOrder.end() ? declOrder.size() : it->second,
+                                       std::move(part));
+                }
             }
+            std::stable_sort(parts.begin(), parts.end(),
+                             [](const std::pair<size_t, std::string>& a,
+                                const std::pair<size_t, std::string>& b) {
+                                 return a.first < b.first;
+                             });
+            for (const auto& part : parts) longname += part.second;
         }
         IfaceRefRefs ifaceRefRefs;
         cellInterfaceCleanup(pinsp, srcModpr, longname /*ref*/, any_overrides /*ref*/,
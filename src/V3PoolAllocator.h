@@ -0,0 +1,149 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//*************************************************************************
+// DESCRIPTION: Verilator: Size class pool allocator for AST and DFG nodes
+//
+// Code available from: https://verilator.org
+//
+//*************************************************************************
+//
+// Copyright 2025 by Wilson Snyder. This program is free software; you
+// can redistribute it and/or modify it under the terms of either the GNU
+// Lesser General Public License Version 3 or the Perl Artistic License
+// Version 2.0.
+// SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+//
+//*************************************************************************
+//
+// V3PoolAllocator<T_Tag> carves small objects out of large slabs, and
+// recycles freed objects through free lists, one per size class. This
+// replaces a malloc/free pair per node with a few instructions, and packs
+// nodes of one kind densely together, which improves cache locality.
+//
+// Slabs and free lists are per thread, so parallel passes need no locking.
+// An object may be freed by a different thread than allocated it, in which
+// case the memory joins the freeing thread's free list. Slabs are never
+// returned to the system, the memory is reused until the process exits.
+//
+// Each T_Tag is a distinct pool, so AstNode and DfgVertex objects do not
+// share slabs. Objects larger than the largest size class use ::operator new.
+//
+// releaseAll() returns every slab to the system at once, for when all objects
+// of the pool are known to be dead, e.g. after the netlist is deleted.
+//
+// The pool is used only in optimized builds. Debug builds, and builds with
+// VL_LEAK_CHECKS, keep the system allocator, so memory checking tools and
+// the V3Broken leak tracking see each object individually.
+//
+//*************************************************************************
+
+#ifndef VERILATOR_V3POOLALLOCATOR_H_
+#define VERILATOR_V3POOLALLOCATOR_H_
+
+#include "config_build.h"
+#include "verilatedos.h"
+
+#include "V3Mutex.h"
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <vector>
+
+#if !defined(VL_DEBUG) && !defined(VL_LEAK_CHECKS)
+#define VL_POOL_ALLOCATOR 1  // Use V3PoolAllocator for AstNode and DfgVertex
+#endif
+
+template <typename T_Tag>
+class V3PoolAllocator final {
+    // TYPES
+    // Size class step. Pooled classes hold pointers at most, so pointer alignment suffices,
+    // and unlike malloc's 16 byte rounding plus header, an object uses exactly its sizeof.
+    static constexpr size_t GRANULE = sizeof(void*);
+    static constexpr size_t MAX_SIZE = 512;  // Largest pooled object
+    static constexpr size_t NUM_CLASSES = MAX_SIZE / GRANULE;
+    static constexpr size_t SLAB_SIZE = 256 * 1024;  // Bytes requested from system at once
+
+    struct FreeEntry final {
+        FreeEntry* m_nextp;  // Next free entry of same size class
+    };
+    // Trivially constructible, so thread_local access needs no initialization guard
+    struct ThreadPool final {
+        FreeEntry* m_freeps[NUM_CLASSES];  // Free list heads, by size class
+        char* m_slabp;  // Next unused byte in current slab
+        char* m_slabEndp;  // End of current slab
+        uint32_t m_generation;  // s_generation this pool's contents belong to
+    };
+
+    // STATE
+    static thread_local ThreadPool t_pool;
+    static V3Mutex s_mutex;  // Protects s_slabps
+    static std::vector<void*> s_slabps VL_GUARDED_BY(s_mutex);  // All slabs, for releaseAll
+    static std::atomic<uint32_t> s_generation;  // Incremented by releaseAll
+
+    // METHODS
+    static size_t sizeClass(size_t size) { return (size + GRANULE - 1) / GRANULE - 1; }
+
+    static void* allocateSlow(size_t cls) VL_MT_SAFE {
+        const size_t bytes = (cls + 1) * GRANULE;
+        if (static_cast<size_t>(t_pool.m_slabEndp - t_pool.m_slabp) < bytes) {
+            // Remainder of an exhausted slab is abandoned, at most MAX_SIZE bytes
+            t_pool.m_slabp = static_cast<char*>(::operator new(SLAB_SIZE));
+            t_pool.m_slabEndp = t_pool.m_slabp + SLAB_SIZE;
+            const V3LockGuard lock{s_mutex};
+            s_slabps.push_back(t_pool.m_slabp);
+        }
+        void* const resultp = t_pool.m_slabp;
+        t_pool.m_slabp += bytes;
+        return resultp;
+    }
+
+public:
+    // Allocate an object of the given size
+    static void* allocate(size_t size) VL_MT_SAFE {
+        if (VL_UNLIKELY(size > MAX_SIZE)) return ::operator new(size);
+        const uint32_t generation = s_generation.load(std::memory_order_relaxed);
+        if (VL_UNLIKELY(t_pool.m_generation != generation)) {
+            // Slabs were released since this thread last allocated, so forget them
+            t_pool = ThreadPool{};
+            t_pool.m_generation = generation;
+        }
+        const size_t cls = sizeClass(size);
+        if (FreeEntry* const entryp = t_pool.m_freeps[cls]) {
+            t_pool.m_freeps[cls] = entryp->m_nextp;
+            return entryp;
+        }
+        return allocateSlow(cls);
+    }
+    // Release an object, 'size' must be what it was allocated with
+    static void deallocate(void* objp, size_t size) VL_MT_SAFE {
+        if (VL_UNLIKELY(!objp)) return;
+        if (VL_UNLIKELY(size > MAX_SIZE)) {
+            ::operator delete(objp);
+            return;
+        }
+        const size_t cls = sizeClass(size);
+        FreeEntry* const entryp = static_cast<FreeEntry*>(objp);
+        entryp->m_nextp = t_pool.m_freeps[cls];
+        t_pool.m_freeps[cls] = entryp;
+    }
+    // Return all slabs to the system. No object from this pool may be alive, and no other
+    // thread may be using the pool concurrently.
+    static void releaseAll() VL_MT_SAFE_EXCLUDES(s_mutex) {
+        const V3LockGuard lock{s_mutex};
+        for (void* const slabp : s_slabps) ::operator delete(slabp);
+        s_slabps.clear();
+        s_slabps.shrink_to_fit();
+        s_generation.fetch_add(1, std::memory_order_relaxed);
+    }
+};
+
+template <typename T_Tag>
+thread_local typename V3PoolAllocator<T_Tag>::ThreadPool V3PoolAllocator<T_Tag>::t_pool;
+template <typename T_Tag>
+V3Mutex V3PoolAllocator<T_Tag>::s_mutex;
+template <typename T_Tag>
+std::vector<void*> V3PoolAllocator<T_Tag>::s_slabps;
+template <typename T_Tag>
+std::atomic<uint32_t> V3PoolAllocator<T_Tag>::s_generation{0};
+
+#endif  // Guard
@@ -196,6 +196,9 @@ public:
     // For getline()
     string m_lineChars;  ///< Characters left for next line
 
+    // For include guards
+    std::map<const std::string, std::string> m_includeGuards;  ///< Filename to guard, or ""
+
     void v3errorEnd(std::ostringstream& str) VL_RELEASE(V3Error::s().m_mutex) {
         fileline()->v3errorEnd(str);
     }
@@ -216,6 +219,8 @@ private:
     string defParams(const string& name);
     FileLine* defFileline(const string& name);
 
+    static string includeGuard(const string& text);
+
     string commentCleanup(const string& text);
     bool commentTokenMatch(string& cmdr, const char* strg);
     static string trimWhitespace(const string& strg, bool trailing);
@@ -809,6 +814,86 @@ string V3PreProcImp::defineSubst(VDefineRef* refp) {
     return out;
 }
 
+//**********************************************************************
+// Include guards
+
+string V3PreProcImp::includeGuard(const string& text) {
+    // If everything in the file is within `ifndef NAME ... `endif, return NAME, else "".
+    // Including the file again when NAME is defined then has no effect, so need not be lexed.
+    // Only a textual scan, so anything unusual is treated as unguarded.
+    size_t pos = 0;
+    const auto skipSpaceAndComments = [&]() -> bool {
+        // Returns false on a comment that may be a metacomment, as those have effects
+        while (pos < text.size()) {
+            if (std::isspace(text[pos])) {
+                ++pos;
+            } else if (text.compare(pos, 2, "//") == 0 || text.compare(pos, 2, "/*") == 0) {
+                const bool line = text[pos + 1] == '/';
+                const size_t end = line ? text.find('\n', pos) : text.find("*/", pos + 2);
+                const string comment = VString::downcase(
+                    text.substr(pos, end == string::npos ? string::npos : end - pos));
+                for (const char* const word : {"verilator", "synopsys", "cadence", "coverage",
+                                               "tracing", "pragma", "synthesis"}) {
+                    if (comment.find(word) != string::npos) return false;
+                }
+                pos = end == string::npos ? text.size() : end + (line ? 1 : 2);
+            } else {
+                break;
+            }
+        }
+        return true;
+    };
+    const auto directive = [&](const char* name) -> bool {
+        const size_t len = std::strlen(name);
+        if (text.compare(pos, len, name) != 0) return false;
+        if (pos + len < text.size() && (std::isalnum(text[pos + len]) || text[pos + len] == '_'))
+            return false;
+        pos += len;
+        return true;
+    };
+
+    if (!skipSpaceAndComments() || !directive("`ifndef")) return "";
+    while (pos < text.size() && (text[pos] == ' ' || text[pos] == '\t')) ++pos;
+    const size_t nameStart = pos;
+    while (pos < text.size() && (std::isalnum(text[pos]) || text[pos] == '_')) ++pos;
+    if (pos == nameStart || std::isdigit(text[nameStart])) return "";
+    const string name = text.substr(nameStart, pos - nameStart);
+
+    int depth = 1;
+    while (pos < text.size()) {
+        const char c = text[pos];
+        if (c == '"') {  // String, may contain anything
+            for (++pos; pos < text.size() && text[pos] != '"' && text[pos] != '\n'; ++pos) {
+                if (text[pos] == '\\') ++pos;
+            }
+            ++pos;
+        } else if (text.compare(pos, 2, "//") == 0 || text.compare(pos, 2, "/*") == 0) {
+            const bool line = text[pos + 1] == '/';
+            const size_t end = line ? text.find('\n', pos) : text.find("*/", pos + 2);
+            pos = end == string::npos ? text.size() : end + (line ? 1 : 2);
+        } else if (c != '`') {
+            ++pos;
+        } else if (directive("`define")) {  // Skip the body, directives in it are text
+            while (pos < text.size() && text[pos] != '\n') {
+                if (text[pos] == '\\' && pos + 1 < text.size() && text[pos + 1] == '\n') ++pos;
+                ++pos;
+            }
+        } else if (directive("`ifdef") || directive("`ifndef")) {
+            ++depth;
+        } else if (directive("`else") || directive("`elsif")) {
+            if (depth == 1) return "";
+        } else if (directive("`endif")) {
+            if (--depth == 0) {
+                if (!skipSpaceAndComments() || pos != text.size()) return "";
+                return name;
+            }
+        } else {
+            ++pos;
+        }
+    }
+    return "";
+}
+
 //**********************************************************************
 // Parser routines
 
@@ -818,6 +903,16 @@ void V3PreProcImp::openFile(FileLine*, VInFilter* filterp, const string& filenam
     m_lexp->setYYDebug(debug() >= 5);
     V3File::addSrcDepend(filename);
 
+    // Nothing to do if including again a file whose include guard is now defined.
+    // Not with -E, so the output keeps its `line directives for each include.
+    if (!m_preprocp->isEof() && !v3Global.opt.preprocOnly()) {
+        const auto it = m_includeGuards.find(filename);
+        if (it != m_includeGuards.end() && !it->second.empty() && defExists(it->second)) {
+            UINFO(4, "Include guarded by `" << it->second << ", skipping " << filename);
+            return;
+        }
+    }
+
     // Read a list<string> with the whole file.
     StrList wholefile;
     const bool ok = filterp->readWholefile(filename, wholefile /*ref*/);
@@ -825,6 +920,11 @@ void V3PreProcImp::openFile(FileLine*, VInFilter* filterp, const string& filenam
         fileline()->v3error("File not found: " + filename);
         return;
     }
+    if (m_includeGuards.find(filename) == m_includeGuards.end()) {
+        string text;
+        for (const string& i : wholefile) text += i;
+        m_includeGuards.emplace(filename, includeGuard(text));
+    }
 
     if (!m_preprocp->isEof()) {  // IE not the first file.
         // We allow the same include file twice, because occasionally it pops
@@ -28,12 +28,16 @@
 
 #include "V3Premit.h"
 
+#include "V3EmitCBase.h"
 #include "V3Stats.h"
 #include "V3UniqueNames.h"
 
 VL_DEFINE_DEBUG_FUNCTIONS;
 
 constexpr int STATIC_CONST_MIN_WIDTH = 256;  // Minimum size to extract to static constant
+// Minimum length of string constants to share in the constant pool, shorter ones fit in the
+// small string buffer of std::string, so are constructed without allocation anyway
+constexpr size_t STATIC_STRING_MIN_LENGTH = 16;
 
 //######################################################################
 // Premit state, as a visitor of each AstNode
@@ -46,6 +50,8 @@ class PremitVisitor final : public VNVisitor {
 
     // STATE - across all visitors
     VDouble0 m_extractedToConstPool;  // Statistic tracking
+    VDouble0 m_stringsToConstPool;  // Statistic tracking
+    VDouble0 m_statWideFused;  // Statistic tracking
 
     // STATE - for current visit position (use VL_RESTORER)
     AstCFunc* m_cfuncp = nullptr;  // Current block
@@ -53,8 +59,39 @@ class PremitVisitor final : public VNVisitor {
     AstNode* m_stmtp = nullptr;  // Current statement
     AstWhile* m_inWhileCondp = nullptr;  // Inside condition of this while loop
     bool m_assignLhs = false;  // Inside assignment lhs, don't breakup extracts
+    AstNodeAssign* m_fuseAssignp = nullptr;  // Assignment V3Expand will expand word by word
 
     // METHODS
+    static bool isFusable(const AstNode* nodep) {
+        return VN_IS(nodep, And) || VN_IS(nodep, Or) || VN_IS(nodep, Xor) || VN_IS(nodep, Not);
+    }
+
+    // True if V3Expand will word expand this assignment, so a bitwise operator tree on the
+    // rhs can be computed one word at a time without wide temporaries
+    static bool isFuseAssign(AstNodeAssign* nodep) {
+        if (!v3Global.opt.fExpand()) return false;
+        if (!nodep->isWide() || nodep->widthWords() > v3Global.opt.expandLimit()) return false;
+        if (VN_IS(nodep->dtypep()->skipRefp(), UnpackArrayDType)) return false;
+        if (!VN_IS(nodep->lhsp(), VarRef) && !VN_IS(nodep->lhsp(), ArraySel)) return false;
+        if (AstVar::scVarRecurse(nodep->lhsp()) || AstVar::scVarRecurse(nodep->rhsp())) {
+            return false;
+        }
+        if (!isFusable(nodep->rhsp())) return false;
+        return nodep->lhsp()->isPure() && nodep->rhsp()->isPure();
+    }
+
+    // True if 'nodep' is a bitwise operator only under other bitwise operators on the rhs of
+    // m_fuseAssignp, which V3Expand will compute per word in the same statement
+    bool isFused(const AstNodeExpr* nodep) const {
+        if (!m_fuseAssignp || !isFusable(nodep)) return false;
+        const AstNode* abovep = nodep->backp();
+        while (abovep != m_fuseAssignp) {
+            if (!isFusable(abovep)) return false;
+            abovep = abovep->backp();
+        }
+        return true;
+    }
+
     void checkNode(AstNodeExpr* nodep) {
         // Consider adding a temp for this expression.
         if (!m_stmtp) return;  // Not under a statement
@@ -62,6 +99,10 @@ class PremitVisitor final : public VNVisitor {
         if (!nodep->isWide()) return;  // Not wide
         if (m_assignLhs) return;  // This is an lvalue!
         UASSERT_OBJ(!VN_IS(nodep->firstAbovep(), ArraySel), nodep, "Should have been ignored");
+        if (isFused(nodep)) {
+            ++m_statWideFused;
+            return;
+        }
         createWideTemp(nodep);
     }
 
@@ -116,6 +157,27 @@ class PremitVisitor final : public VNVisitor {
         return varp;
     }
 
+    // Share long string literals as constant pool variables, instead of constructing a new
+    // std::string from the literal every time it is evaluated
+    void internString(AstConst* nodep) {
+        if (!m_stmtp || m_assignLhs) return;
+        if (nodep->num().toString().size() < STATIC_STRING_MIN_LENGTH) return;
+        // Only where any string expression is accepted
+        const AstNode* const backp = nodep->backp();
+        const AstNodeAssign* const assignp = VN_CAST(backp, NodeAssign);
+        if (assignp ? assignp->rhsp() != nodep
+                    : !VN_IS(backp, EqN) && !VN_IS(backp, NeqN) && !VN_IS(backp, LtN)
+                          && !VN_IS(backp, LteN) && !VN_IS(backp, GtN) && !VN_IS(backp, GteN)
+                          && !VN_IS(backp, ConcatN)) {
+            return;
+        }
+        FileLine* const flp = nodep->fileline();
+        AstVarScope* const vscp = v3Global.rootp()->constPoolp()->findConst(nodep, true);
+        nodep->replaceWith(new AstVarRef{flp, vscp->varp(), VAccess::READ});
+        VL_DO_DANGLING(pushDeletep(nodep), nodep);
+        ++m_stringsToConstPool;
+    }
+
     void visitShift(AstNodeBiop* nodep) {
         // Shifts of > 32/64 bits in C++ will wrap-around and generate non-0s
         UINFO(4, "  ShiftFix  " << nodep);
@@ -176,9 +238,11 @@ class PremitVisitor final : public VNVisitor {
     VL_RESTORER(m_assignLhs); \
     VL_RESTORER(m_stmtp); \
     VL_RESTORER(m_inWhileCondp); \
+    VL_RESTORER(m_fuseAssignp); \
     m_assignLhs = false; \
     m_stmtp = stmtp; \
-    m_inWhileCondp = nullptr
+    m_inWhileCondp = nullptr; \
+    m_fuseAssignp = nullptr
 
     void visit(AstWhile* nodep) override {
         UINFO(4, "  WHILE  " << nodep);
@@ -225,7 +289,9 @@ class PremitVisitor final : public VNVisitor {
             // Need to do this even if not wide, as e.g. a select may be on a wide operator
             createWideTemp(nodep->rhsp());
         } else {
+            if (isFuseAssign(nodep)) m_fuseAssignp = nodep;
             iterateAndNextNull(nodep->rhsp());
+            m_fuseAssignp = nullptr;
         }
 
         m_assignLhs = true;  // Restored by VL_RESTORER in START_STATEMENT_OR_RETURN
@@ -260,7 +326,13 @@ class PremitVisitor final : public VNVisitor {
     void visit(AstShiftR* nodep) override { visitShift(nodep); }
     void visit(AstShiftRS* nodep) override { visitShift(nodep); }
 
-    void visit(AstConst* nodep) override { checkNode(nodep); }
+    void visit(AstConst* nodep) override {
+        if (nodep->num().isString()) {
+            internString(nodep);
+            return;
+        }
+        checkNode(nodep);
+    }
     // Operators
     void visit(AstNodeTermop* nodep) override { checkNode(nodep); }
     void visit(AstNodeUniop* nodep) override {
@@ -268,6 +340,8 @@ class PremitVisitor final : public VNVisitor {
         checkNode(nodep);
     }
     void visit(AstNodeBiop* nodep) override {
+        // Narrow constant divisor is emitted directly, don't make it a wide temporary
+        if (EmitCBase::narrowConstDivisorp(nodep)) nodep->rhsp()->user1SetOnce();
         iterateChildren(nodep);
         checkNode(nodep);
     }
@@ -360,6 +434,9 @@ public:
     ~PremitVisitor() override {
         V3Stats::addStat("Optimizations, Prelim extracted value to ConstPool",
                          m_extractedToConstPool);
+        V3Stats::addStat("Optimizations, Prelim extracted strings to ConstPool",
+                         m_stringsToConstPool);
+        V3Stats::addStat("Optimizations, Prelim wide temporaries fused", m_statWideFused);
     }
 };
 
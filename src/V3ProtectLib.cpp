@@ -19,6 +19,7 @@
 #include "V3ProtectLib.h"
 
 #include "V3Control.h"
+#include "V3ExecGraph.h"
 #include "V3Hasher.h"
 #include "V3InstrCount.h"
 #include "V3String.h"
@@ -63,6 +64,10 @@ class ProtectVisitor final : public VNVisitor {
     const string m_topName;
     bool m_foundTop = false;  // Have seen the top module
     bool m_hasClk = false;  // True if the top module has sequential logic
+    bool m_skipUnchanged = false;  // Combo update skips evaluation if data inputs are unchanged
+    bool m_batch = false;  // Data inputs and outputs are packed in one vector, --lib-create-batch
+    std::vector<AstVar*> m_batchInputs;  // Packed data inputs, first one at the LSB
+    std::vector<AstVar*> m_batchOutputs;  // Packed outputs, first one at the LSB
 
     // VISITORS
     void visit(AstNetlist* nodep) override {
@@ -84,6 +89,9 @@ class ProtectVisitor final : public VNVisitor {
         FileLine* const fl = nodep->fileline();
         // Need to know the existence of clk before createSvFile()
         m_hasClk = checkIfClockExists(nodep);
+        // Delayed processes could resume on any evaluation
+        m_skipUnchanged = !v3Global.usesTiming();
+        if (v3Global.opt.libCreateBatch()) m_batch = gatherBatchPorts(nodep);
         createSvFile(fl, nodep);
         createCppFile(fl);
 
@@ -111,6 +119,16 @@ class ProtectVisitor final : public VNVisitor {
         modp->foreach([&cost](AstCFunc* cfuncp) {
             if (cfuncp->name() == "_eval") cost = V3InstrCount::count(cfuncp, false);
         });
+        // With multiple threads, the mtasks are only referenced from there, and run on as many
+        // threads as this block's hier_workers, so add the predicted end of each schedule.
+        v3Global.rootp()->foreach([&cost](const AstExecGraph* execGraphp) {
+            uint64_t end = 0;
+            for (const V3GraphVertex& vtx : execGraphp->depGraphp()->vertices()) {
+                const ExecMTask* const mtp = vtx.as<ExecMTask>();
+                end = std::max(end, mtp->predictStart() + mtp->cost());
+            }
+            cost += static_cast<uint32_t>(end);
+        });
         txtp->addText(fl, "profile_data -hier-dpi \"" + m_libName
                               + "_protectlib_combo_update\" -cost 64'd" + std::to_string(cost)
                               + "\n");
@@ -207,6 +225,12 @@ class ProtectVisitor final : public VNVisitor {
                                                "(\n",
                                          false, true};
         m_comboPortsp->addText(fl, "chandle handle__V\n");
+        if (m_batch) {
+            if (!m_batchInputs.empty()) {
+                m_comboPortsp->addText(fl, "input " + batchDecl(m_batchInputs, "inputs__V"));
+            }
+            batchOutputPort(fl, m_comboPortsp);
+        }
         txtp->addNodesp(m_comboPortsp);
         txtp->addText(fl, ");\n\n");
         seqComment(txtp, fl);
@@ -217,6 +241,7 @@ class ProtectVisitor final : public VNVisitor {
                                                  "(\n",
                                            false, true};
             m_seqPortsp->addText(fl, "chandle handle__V\n");
+            if (m_batch) batchOutputPort(fl, m_seqPortsp);
             txtp->addNodesp(m_seqPortsp);
             txtp->addText(fl, ");\n\n");
         }
@@ -227,6 +252,9 @@ class ProtectVisitor final : public VNVisitor {
                                                      "(\n",
                                                false, true};
         m_comboIgnorePortsp->addText(fl, "chandle handle__V\n");
+        if (m_batch && !m_batchInputs.empty()) {
+            m_comboIgnorePortsp->addText(fl, "input " + batchDecl(m_batchInputs, "inputs__V"));
+        }
         txtp->addNodesp(m_comboIgnorePortsp);
         txtp->addText(fl, ");\n\n");
 
@@ -250,6 +278,13 @@ class ProtectVisitor final : public VNVisitor {
         txtp->addNodesp(m_seqDeclsp);
         m_tmpDeclsp = new AstTextBlock{fl};
         txtp->addNodesp(m_tmpDeclsp);
+        if (m_batch && !m_batchOutputs.empty()) {
+            m_comboDeclsp->addText(fl, batchDecl(m_batchOutputs, "outputs_combo__V", ";"));
+            if (m_hasClk) {
+                m_seqDeclsp->addText(fl, batchDecl(m_batchOutputs, "outputs_seq__V", ";"));
+                m_tmpDeclsp->addText(fl, batchDecl(m_batchOutputs, "outputs_tmp__V", ";"));
+            }
+        }
 
         // CPP hash value
         addComment(txtp, fl, "Hash value to make sure this file and the corresponding");
@@ -274,6 +309,10 @@ class ProtectVisitor final : public VNVisitor {
                                               + m_libName + "_protectlib_combo_update(\n",
                                           false, true};
         m_comboParamsp->addText(fl, "handle__V\n");
+        if (m_batch) {
+            if (!m_batchInputs.empty()) m_comboParamsp->addText(fl, batchConcat(m_batchInputs));
+            if (!m_batchOutputs.empty()) m_comboParamsp->addText(fl, "outputs_combo__V\n");
+        }
         txtp->addNodesp(m_comboParamsp);
         txtp->addText(fl, ");\n");
         txtp->addText(fl, "end\n\n");
@@ -287,15 +326,24 @@ class ProtectVisitor final : public VNVisitor {
             m_comboIgnoreParamsp
                 = new AstTextBlock{fl, m_libName + "_protectlib_combo_ignore(\n", false, true};
             m_comboIgnoreParamsp->addText(fl, "handle__V\n");
+            if (m_batch && !m_batchInputs.empty()) {
+                m_comboIgnoreParamsp->addText(fl, batchConcat(m_batchInputs));
+            }
             txtp->addNodesp(m_comboIgnoreParamsp);
             txtp->addText(fl, ");\n");
             m_seqParamsp = new AstTextBlock{
                 fl, "last_seq_seqnum__V <= " + m_libName + "_protectlib_seq_update(\n", false,
                 true};
             m_seqParamsp->addText(fl, "handle__V\n");
+            if (m_batch && !m_batchOutputs.empty()) {
+                m_seqParamsp->addText(fl, "outputs_tmp__V\n");
+            }
             txtp->addNodesp(m_seqParamsp);
             txtp->addText(fl, ");\n");
             m_nbAssignsp = new AstTextBlock{fl};
+            if (m_batch && !m_batchOutputs.empty()) {
+                m_nbAssignsp->addText(fl, "outputs_seq__V <= outputs_tmp__V;\n");
+            }
             txtp->addNodesp(m_nbAssignsp);
             txtp->addText(fl, "end\n\n");
         }
@@ -314,6 +362,11 @@ class ProtectVisitor final : public VNVisitor {
             m_comboAssignsp = new AstTextBlock{fl, ""};
             txtp->addNodesp(m_comboAssignsp);
         }
+        if (m_batch && !m_batchOutputs.empty()) {
+            const string lhs = batchConcat(m_batchOutputs, "");
+            if (m_hasClk) m_seqAssignsp->addText(fl, lhs + " = outputs_seq__V;\n");
+            m_comboAssignsp->addText(fl, lhs + " = outputs_combo__V;\n");
+        }
         txtp->addText(fl, "end\n\n");
 
         // Final
@@ -349,6 +402,9 @@ class ProtectVisitor final : public VNVisitor {
         txtp->addText(fl, "class " + m_topName + "_container: public " + m_topName + " {\n");
         txtp->addText(fl, "public:\n");
         txtp->addText(fl, "long long m_seqnum;\n");
+        if (m_skipUnchanged) {
+            txtp->addText(fl, "bool m_settled = false;  // Evaluated with the current inputs\n");
+        }
         txtp->addText(fl, m_topName + "_container(const char* scopep__V):\n");
         txtp->addText(fl, m_topName + "(scopep__V) {}\n");
         txtp->addText(fl, "};\n\n");
@@ -385,12 +441,33 @@ class ProtectVisitor final : public VNVisitor {
         m_cComboParamsp = new AstTextBlock{
             fl, "long long " + m_libName + "_protectlib_combo_update(\n", false, true};
         m_cComboParamsp->addText(fl, "void* vhandlep__V\n");
+        if (m_batch) {
+            if (!m_batchInputs.empty()) {
+                m_cComboParamsp->addText(fl, "const svLogicVecVal* inputs__V\n");
+            }
+            if (!m_batchOutputs.empty()) {
+                m_cComboParamsp->addText(fl, "svLogicVecVal* outputs__V\n");
+            }
+        }
         txtp->addNodesp(m_cComboParamsp);
         txtp->addText(fl, ")\n");
         m_cComboInsp = new AstTextBlock{fl, "{\n"};
         castPtr(fl, m_cComboInsp);
+        if (m_skipUnchanged) {
+            m_cComboInsp->addText(fl, "bool changed__V = !handlep__V->m_settled;\n");
+        }
+        if (m_batch) cBatchInputs(fl, m_cComboInsp);
         txtp->addNodesp(m_cComboInsp);
-        m_cComboOutsp = new AstTextBlock{fl, "handlep__V->eval();\n"};
+        if (m_skipUnchanged) {
+            // Simulators, including Verilator in hierarchical mode, can call this with the
+            // same inputs many times. The model already settled on these, as also does the
+            // sequential update, so another evaluation could not change the outputs.
+            m_cComboOutsp = new AstTextBlock{fl, "if (changed__V) handlep__V->eval();\n"};
+            m_cComboOutsp->addText(fl, "handlep__V->m_settled = true;\n");
+        } else {
+            m_cComboOutsp = new AstTextBlock{fl, "handlep__V->eval();\n"};
+        }
+        if (m_batch) cBatchOutputs(fl, m_cComboOutsp);
         txtp->addNodesp(m_cComboOutsp);
         txtp->addText(fl, "return handlep__V->m_seqnum++;\n");
         txtp->addText(fl, "}\n\n");
@@ -400,12 +477,16 @@ class ProtectVisitor final : public VNVisitor {
             m_cSeqParamsp = new AstTextBlock{
                 fl, "long long " + m_libName + "_protectlib_seq_update(\n", false, true};
             m_cSeqParamsp->addText(fl, "void* vhandlep__V\n");
+            if (m_batch && !m_batchOutputs.empty()) {
+                m_cSeqParamsp->addText(fl, "svLogicVecVal* outputs__V\n");
+            }
             txtp->addNodesp(m_cSeqParamsp);
             txtp->addText(fl, ")\n");
             m_cSeqClksp = new AstTextBlock{fl, "{\n"};
             castPtr(fl, m_cSeqClksp);
             txtp->addNodesp(m_cSeqClksp);
             m_cSeqOutsp = new AstTextBlock{fl, "handlep__V->eval();\n"};
+            if (m_batch) cBatchOutputs(fl, m_cSeqOutsp);
             txtp->addNodesp(m_cSeqOutsp);
             txtp->addText(fl, "return handlep__V->m_seqnum++;\n");
             txtp->addText(fl, "}\n\n");
@@ -415,6 +496,9 @@ class ProtectVisitor final : public VNVisitor {
         m_cIgnoreParamsp = new AstTextBlock{
             fl, "void " + m_libName + "_protectlib_combo_ignore(\n", false, true};
         m_cIgnoreParamsp->addText(fl, "void* vhandlep__V\n");
+        if (m_batch && !m_batchInputs.empty()) {
+            m_cIgnoreParamsp->addText(fl, "const svLogicVecVal* inputs__V\n");
+        }
         txtp->addNodesp(m_cIgnoreParamsp);
         txtp->addText(fl, ")\n");
         txtp->addText(fl, "{ }\n\n");
@@ -470,12 +554,21 @@ class ProtectVisitor final : public VNVisitor {
     void handleDataInput(AstVar* varp) {
         FileLine* const fl = varp->fileline();
         handleInput(varp);
+        if (m_batch) return;  // Passed in 'inputs__V'
         m_comboPortsp->addNodesp(varp->cloneTree(false));
         m_comboParamsp->addText(fl, varp->prettyName() + "\n");
         m_comboIgnorePortsp->addNodesp(varp->cloneTree(false));
         if (m_hasClk) m_comboIgnoreParamsp->addText(fl, varp->prettyName() + "\n");
         m_cComboParamsp->addText(fl, varp->dpiArgType(true, false) + "\n");
-        m_cComboInsp->addText(fl, cInputConnection(varp));
+        if (m_skipUnchanged) {
+            const string prevName = varp->name() + "__Vprev";
+            const string fieldName = "handlep__V->" + varp->name();
+            m_cComboInsp->addText(fl, "const auto " + prevName + " = " + fieldName + ";\n");
+            m_cComboInsp->addText(fl, cInputConnection(varp));
+            m_cComboInsp->addText(fl, "changed__V |= " + prevName + " != " + fieldName + ";\n");
+        } else {
+            m_cComboInsp->addText(fl, cInputConnection(varp));
+        }
         m_cIgnoreParamsp->addText(fl, varp->dpiArgType(true, false) + "\n");
     }
 
@@ -490,6 +583,7 @@ class ProtectVisitor final : public VNVisitor {
     void handleOutput(AstVar* varp) {
         FileLine* const fl = varp->fileline();
         m_modPortsp->addNodesp(varp->cloneTree(false));
+        if (m_batch) return;  // Passed in 'outputs__V'
         m_comboPortsp->addNodesp(varp->cloneTree(false));
         m_comboParamsp->addText(fl, varp->prettyName() + "_combo__V\n");
         if (m_hasClk) {
@@ -520,6 +614,105 @@ class ProtectVisitor final : public VNVisitor {
         }
     }
 
+    // Batched interface: all data inputs, and likewise all outputs, are packed into a single
+    // vector, so each call passes one argument for them regardless of the number of ports.
+    // Returns false, to use an argument per port, if a port is not of a packed type.
+    bool gatherBatchPorts(AstNodeModule* modp) {
+        for (AstNode* stmtp = modp->stmtsp(); stmtp; stmtp = stmtp->nextp()) {
+            AstVar* const varp = VN_CAST(stmtp, Var);
+            if (!varp || !varp->isIO()) continue;
+            if (!varp->dtypeSkipRefp()->isIntegralOrPacked()) {
+                UINFO(4, "Not batching protect-lib ports due to " << varp);
+                m_batchInputs.clear();
+                m_batchOutputs.clear();
+                return false;
+            }
+            if (varp->direction() == VDirection::OUTPUT) {
+                m_batchOutputs.push_back(varp);
+            } else if (varp->direction() == VDirection::INPUT && !varp->isUsedClock()
+                       && varp->attrClocker() != VVarAttrClocker::CLOCKER_YES) {
+                m_batchInputs.push_back(varp);
+            }
+        }
+        return true;
+    }
+
+    static int batchWidth(const std::vector<AstVar*>& varps) {
+        int width = 0;
+        for (const AstVar* const varp : varps) width += varp->width();
+        return width;
+    }
+
+    static string batchDecl(const std::vector<AstVar*>& varps, const string& name,
+                            const string& terminator = "") {
+        return "logic [" + cvtToStr(batchWidth(varps) - 1) + ":0] " + name + terminator + "\n";
+    }
+
+    // Concatenation of the ports, with the first port in the LSBs
+    static string batchConcat(const std::vector<AstVar*>& varps, const string& ending = "\n") {
+        string out;
+        for (auto it = varps.rbegin(); it != varps.rend(); ++it) {
+            out += (out.empty() ? "{" : ", ") + (*it)->prettyName();
+        }
+        return out + "}" + ending;
+    }
+
+    void batchOutputPort(FileLine* fl, AstTextBlock* portsp) {
+        if (m_batchOutputs.empty()) return;
+        portsp->addText(fl, "output " + batchDecl(m_batchOutputs, "outputs__V"));
+    }
+
+    void cBatchInputs(FileLine* fl, AstTextBlock* txtp) {
+        if (m_batchInputs.empty()) return;
+        const int width = batchWidth(m_batchInputs);
+        const string widthStr = cvtToStr(width);
+        txtp->addText(fl, "VlWide<" + cvtToStr(VL_WORDS_I(width)) + "> inputs__Vwide;\n");
+        txtp->addText(fl, "VL_SET_W_SVLV(" + widthStr + ", inputs__Vwide, inputs__V);\n");
+        int lsb = 0;
+        for (const AstVar* const varp : m_batchInputs) {
+            const string fieldName = "handlep__V->" + varp->name();
+            const string prevName = varp->name() + "__Vprev";
+            const string w = cvtToStr(varp->width());
+            const string args = widthStr + ", inputs__Vwide, " + cvtToStr(lsb) + ", " + w;
+            if (m_skipUnchanged) {
+                txtp->addText(fl, "const auto " + prevName + " = " + fieldName + ";\n");
+            }
+            if (varp->isWide()) {
+                txtp->addText(fl, "VL_SEL_WWII(" + w + ", " + widthStr + ", " + fieldName
+                                      + ", inputs__Vwide, " + cvtToStr(lsb) + ", " + w + ");\n");
+                txtp->addText(fl, fieldName + "[" + cvtToStr(varp->widthWords() - 1)
+                                      + "] &= VL_MASK_E(" + w + ");\n");
+            } else if (varp->isQuad()) {
+                txtp->addText(fl, fieldName + " = VL_SEL_QWII(" + args + ") & VL_MASK_Q(" + w
+                                      + ");\n");
+            } else {
+                txtp->addText(fl, fieldName + " = VL_SEL_IWII(" + args + ") & VL_MASK_I(" + w
+                                      + ");\n");
+            }
+            if (m_skipUnchanged) {
+                txtp->addText(fl, "changed__V |= " + prevName + " != " + fieldName + ";\n");
+            }
+            lsb += varp->width();
+        }
+    }
+
+    void cBatchOutputs(FileLine* fl, AstTextBlock* txtp) {
+        if (m_batchOutputs.empty()) return;
+        const int width = batchWidth(m_batchOutputs);
+        const string widthStr = cvtToStr(width);
+        txtp->addText(fl, "VlWide<" + cvtToStr(VL_WORDS_I(width)) + "> outputs__Vwide;\n");
+        txtp->addText(fl, "VL_ZERO_W(" + widthStr + ", outputs__Vwide);\n");
+        int lsb = 0;
+        for (const AstVar* const varp : m_batchOutputs) {
+            const string kind = varp->isWide() ? "W" : varp->isQuad() ? "Q" : "I";
+            txtp->addText(fl, "VL_ASSIGNSEL_W" + kind + "(" + widthStr + ", "
+                                  + cvtToStr(varp->width()) + ", " + cvtToStr(lsb)
+                                  + ", outputs__Vwide, handlep__V->" + varp->name() + ");\n");
+            lsb += varp->width();
+        }
+        txtp->addText(fl, "VL_SET_SVLV_W(" + widthStr + ", outputs__V, outputs__Vwide);\n");
+    }
+
     static bool checkIfClockExists(AstNodeModule* modp) {
         for (AstNode* stmtp = modp->stmtsp(); stmtp; stmtp = stmtp->nextp()) {
             if (const AstVar* const varp = VN_CAST(stmtp, Var)) {
@@ -40,6 +40,7 @@
 #include "V3FileLine.h"
 #include "V3Global.h"
 #include "V3MemberMap.h"
+#include "V3Stats.h"
 #include "V3UniqueNames.h"
 
 #include <queue>
@@ -1232,6 +1233,320 @@ public:
     }
 };
 
+//######################################################################
+// Solver-free randomization of simple constraints
+// When every constraint of a class compares a single rand variable with constants
+// (ranges, inside sets, dist items, solve...before) the variables are independent,
+// so the values each may take are computed here as a set of ranges, and randomize()
+// samples those directly with VlRNG rather than sending them to the SMT solver.
+
+class ConstraintValueSet final {
+    // Values of a variable as sorted, disjoint, non-adjacent inclusive ranges in [0, m_max]
+    using Range = std::pair<uint64_t, uint64_t>;
+    std::vector<Range> m_ranges;
+    uint64_t m_max;  // Largest value of the variable
+
+public:
+    // CONSTRUCTORS
+    explicit ConstraintValueSet(uint64_t max, bool full = false)
+        : m_max{max} {
+        if (full) m_ranges.emplace_back(0, max);
+    }
+    ConstraintValueSet(uint64_t max, uint64_t lo, uint64_t hi)
+        : m_max{max} {
+        hi = std::min(hi, max);
+        if (lo <= hi) m_ranges.emplace_back(lo, hi);
+    }
+
+    // ACCESSORS
+    const std::vector<Range>& ranges() const { return m_ranges; }
+    uint64_t max() const { return m_max; }
+    bool empty() const { return m_ranges.empty(); }
+
+    // METHODS
+    ConstraintValueSet operator~() const {
+        ConstraintValueSet out{m_max};
+        uint64_t next = 0;  // First value not yet known to be in a range
+        bool done = false;  // All values up to m_max handled
+        for (const Range& range : m_ranges) {
+            if (range.first > next) out.m_ranges.emplace_back(next, range.first - 1);
+            if (range.second == m_max) {
+                done = true;
+                break;
+            }
+            next = range.second + 1;
+        }
+        if (!done) out.m_ranges.emplace_back(next, m_max);
+        return out;
+    }
+    ConstraintValueSet operator&(const ConstraintValueSet& other) const {
+        ConstraintValueSet out{m_max};
+        auto ait = m_ranges.begin();
+        auto bit = other.m_ranges.begin();
+        while (ait != m_ranges.end() && bit != other.m_ranges.end()) {
+            const uint64_t lo = std::max(ait->first, bit->first);
+            const uint64_t hi = std::min(ait->second, bit->second);
+            if (lo <= hi) out.m_ranges.emplace_back(lo, hi);
+            if (ait->second < bit->second) {
+                ++ait;
+            } else {
+                ++bit;
+            }
+        }
+        return out;
+    }
+    ConstraintValueSet operator|(const ConstraintValueSet& other) const {
+        return ~(~*this & ~other);
+    }
+};
+
+class ConstraintSimpleAnalysis final {
+    // Computes the values each rand variable may take under constraints that are
+    // simple, i.e. that each compare one rand variable with constants
+
+    // TYPES
+    struct Term final {
+        AstVar* m_varp = nullptr;  // Variable constrained, nullptr if constant
+        bool m_true = false;  // If constant, its value
+        ConstraintValueSet m_set{0};  // If variable, values satisfying the term
+    };
+
+    // STATE
+    bool m_simple = true;  // All constraints seen so far are simple
+    std::map<const AstVar*, ConstraintValueSet> m_sets;  // Values allowed for each variable
+    std::vector<AstVar*> m_varps;  // Constrained variables, in order first seen
+
+    // METHODS
+    static uint64_t maskOf(int width) {
+        return width >= 64 ? ~0ULL : ((1ULL << width) - 1);
+    }
+    static AstVar* randVarOf(const AstNodeExpr* nodep) {
+        // The plain rand variable that nodep reads, or nullptr
+        const AstVarRef* const refp = VN_CAST(nodep, VarRef);
+        if (!refp || !refp->access().isReadOnly()) return nullptr;
+        AstVar* const varp = refp->varp();
+        if (!varp->rand().isRand() || varp->rand().isRandC()) return nullptr;
+        if (!VN_IS(varp->user2p(), Class) || varp->isStatic()) return nullptr;
+        const AstBasicDType* const basicp = VN_CAST(varp->dtypep()->skipRefp(), BasicDType);
+        if (!basicp || !basicp->isIntegralOrPacked() || varp->width() > 64) return nullptr;
+        return varp;
+    }
+    static bool constValue(const AstNodeExpr* nodep, bool isSigned, uint64_t& value) {
+        // The numeric value of a constant, sign extended from its width when isSigned
+        const AstConst* const constp = VN_CAST(nodep, Const);
+        if (!constp || constp->width() > 64 || constp->num().isAnyXZ()) return false;
+        value = constp->num().toUQuad();
+        if (isSigned && constp->width() < 64 && (value >> (constp->width() - 1)) & 1) {
+            value |= ~maskOf(constp->width());
+        }
+        return true;
+    }
+    static ConstraintValueSet compareSet(AstVar* varp, bool isSigned, VNType cmp, uint64_t c) {
+        // Raw values of varp, whose numeric value (signed if isSigned) satisfies "var cmp c"
+        const int width = varp->width();
+        const uint64_t max = maskOf(width);
+        // Work on values biased so the signed order is the unsigned order
+        const uint64_t bias = isSigned ? (1ULL << 63) : 0;
+        const uint64_t bc = c ^ bias;
+        const uint64_t bmin = isSigned ? ~(max >> 1) ^ bias : 0;
+        const uint64_t bmax = isSigned ? (max >> 1) ^ bias : max;
+        uint64_t lo = bmin;
+        uint64_t hi = bmax;
+        switch (cmp) {
+        case VNType::atEq: lo = hi = bc; break;
+        case VNType::atLt:
+            if (bc == 0) return ConstraintValueSet{max};
+            hi = bc - 1;
+            break;
+        case VNType::atLte: hi = bc; break;
+        case VNType::atGt:
+            if (bc == ~0ULL) return ConstraintValueSet{max};
+            lo = bc + 1;
+            break;
+        case VNType::atGte: lo = bc; break;
+        default: v3fatalSrc("Unexpected compare");  // LCOV_EXCL_LINE
+        }
+        lo = std::max(lo, bmin);
+        hi = std::min(hi, bmax);
+        if (lo > hi) return ConstraintValueSet{max};
+        if (!isSigned) return ConstraintValueSet{max, lo, hi};
+        // Back to raw values: negatives are the top half of the raw values
+        const uint64_t slo = lo ^ bias;
+        const uint64_t shi = hi ^ bias;
+        if ((slo >> 63) == (shi >> 63)) return ConstraintValueSet{max, slo & max, shi & max};
+        return ConstraintValueSet{max, 0, shi & max} | ConstraintValueSet{max, slo & max, max};
+    }
+    static bool constCompare(VNType cmp, uint64_t lhs, uint64_t rhs, bool isSigned) {
+        const uint64_t bias = isSigned ? (1ULL << 63) : 0;
+        lhs ^= bias;
+        rhs ^= bias;
+        switch (cmp) {
+        case VNType::atEq: return lhs == rhs;
+        case VNType::atLt: return lhs < rhs;
+        case VNType::atLte: return lhs <= rhs;
+        case VNType::atGt: return lhs > rhs;
+        case VNType::atGte: return lhs >= rhs;
+        default: v3fatalSrc("Unexpected compare");  // LCOV_EXCL_LINE
+        }
+        return false;  // LCOV_EXCL_LINE
+    }
+    static VNType mirrored(VNType cmp) {
+        switch (cmp) {
+        case VNType::atLt: return VNType::atGt;
+        case VNType::atLte: return VNType::atGte;
+        case VNType::atGt: return VNType::atLt;
+        case VNType::atGte: return VNType::atLte;
+        default: return cmp;
+        }
+    }
+    bool compare(const AstNodeBiop* nodep, VNType cmp, bool isSigned, bool negate, Term& out) {
+        const AstNodeExpr* lhsp = nodep->lhsp();
+        const AstNodeExpr* rhsp = nodep->rhsp();
+        uint64_t lval = 0;
+        uint64_t rval = 0;
+        if (constValue(lhsp, isSigned, lval) && constValue(rhsp, isSigned, rval)) {
+            out.m_true = constCompare(cmp, lval, rval, isSigned) != negate;
+            return true;
+        }
+        if (VN_IS(lhsp, Const)) {
+            std::swap(lhsp, rhsp);
+            cmp = mirrored(cmp);
+        }
+        if (!constValue(rhsp, isSigned, rval)) return false;
+        // The variable, possibly extended to the compare's width
+        bool varSigned = isSigned;
+        if (const AstExtend* const extp = VN_CAST(lhsp, Extend)) {
+            lhsp = extp->lhsp();
+            varSigned = false;  // Zero extended, so never negative
+            if (isSigned) {
+                // Compare with a negative constant is decided; otherwise compare unsigned
+                if (rval >> 63) {
+                    const bool isTrue = cmp == VNType::atGt || cmp == VNType::atGte;
+                    AstVar* const varp = randVarOf(lhsp);
+                    if (!varp) return false;
+                    out.m_varp = varp;
+                    out.m_set = ConstraintValueSet{maskOf(varp->width()), isTrue != negate};
+                    return true;
+                }
+            }
+        } else if (const AstExtendS* const extp = VN_CAST(lhsp, ExtendS)) {
+            if (!isSigned) return false;  // Sign extended then compared unsigned
+            lhsp = extp->lhsp();
+        }
+        AstVar* const varp = randVarOf(lhsp);
+        if (!varp) return false;
+        out.m_varp = varp;
+        out.m_set = compareSet(varp, varSigned, cmp, rval);
+        if (negate) out.m_set = ~out.m_set;
+        return true;
+    }
+    bool combine(const Term& lhs, const Term& rhs, bool isAnd, Term& out) {
+        if (!lhs.m_varp || !rhs.m_varp) {
+            const Term& constTerm = lhs.m_varp ? rhs : lhs;
+            const Term& otherTerm = lhs.m_varp ? lhs : rhs;
+            // Anything AND false is false, and OR true is true, else the other side
+            if (constTerm.m_true != isAnd) {
+                out = constTerm;
+            } else {
+                out = otherTerm;
+            }
+            return true;
+        }
+        if (lhs.m_varp != rhs.m_varp) return false;  // Coupled variables
+        out.m_varp = lhs.m_varp;
+        out.m_set = isAnd ? (lhs.m_set & rhs.m_set) : (lhs.m_set | rhs.m_set);
+        return true;
+    }
+    bool expr(const AstNodeExpr* nodep, Term& out) {
+        if (const AstConst* const constp = VN_CAST(nodep, Const)) {
+            if (constp->num().isAnyXZ()) return false;
+            out.m_true = !constp->num().isEqZero();
+            return true;
+        }
+        const bool isBit = nodep->width() == 1;
+        if (VN_IS(nodep, LogAnd) || VN_IS(nodep, LogOr) || (isBit && VN_IS(nodep, And))
+            || (isBit && VN_IS(nodep, Or))) {
+            const AstNodeBiop* const biopp = VN_AS(nodep, NodeBiop);
+            Term lhs;
+            Term rhs;
+            if (!expr(biopp->lhsp(), lhs) || !expr(biopp->rhsp(), rhs)) return false;
+            return combine(lhs, rhs, VN_IS(nodep, LogAnd) || VN_IS(nodep, And), out);
+        }
+        if (VN_IS(nodep, LogNot) || (isBit && VN_IS(nodep, Not))) {
+            if (!expr(VN_AS(nodep, NodeUniop)->lhsp(), out)) return false;
+            if (out.m_varp) {
+                out.m_set = ~out.m_set;
+            } else {
+                out.m_true = !out.m_true;
+            }
+            return true;
+        }
+        if (const AstNodeBiop* const biopp = VN_CAST(nodep, NodeBiop)) {
+            if (biopp->lhsp()->width() > 64) return false;
+            // Equality is the same signed or not, but sign extension needs signed values
+            const bool eqSigned
+                = VN_IS(biopp->lhsp(), ExtendS) || VN_IS(biopp->rhsp(), ExtendS);
+            switch (nodep->type()) {
+            case VNType::atEq: return compare(biopp, VNType::atEq, eqSigned, false, out);
+            case VNType::atEqWild: return compare(biopp, VNType::atEq, eqSigned, false, out);
+            case VNType::atNeq: return compare(biopp, VNType::atEq, eqSigned, true, out);
+            case VNType::atLt: return compare(biopp, VNType::atLt, false, false, out);
+            case VNType::atLtS: return compare(biopp, VNType::atLt, true, false, out);
+            case VNType::atLte: return compare(biopp, VNType::atLte, false, false, out);
+            case VNType::atLteS: return compare(biopp, VNType::atLte, true, false, out);
+            case VNType::atGt: return compare(biopp, VNType::atGt, false, false, out);
+            case VNType::atGtS: return compare(biopp, VNType::atGt, true, false, out);
+            case VNType::atGte: return compare(biopp, VNType::atGte, false, false, out);
+            case VNType::atGteS: return compare(biopp, VNType::atGte, true, false, out);
+            default: break;
+            }
+        }
+        return false;
+    }
+    void addVarSet(AstVar* varp, const ConstraintValueSet& set) {
+        const auto it = m_sets.find(varp);
+        if (it == m_sets.end()) {
+            m_sets.emplace(varp, set);
+            m_varps.push_back(varp);
+        } else {
+            it->second = it->second & set;
+        }
+    }
+
+public:
+    // Add a constraint's items, before ConstraintExprVisitor converts them
+    void add(const AstConstraint* constrp) {
+        for (const AstNode* itemp = constrp->itemsp(); itemp && m_simple;
+             itemp = itemp->nextp()) {
+            if (VN_IS(itemp, ConstraintBefore)) continue;  // Ordering only; vars independent
+            const AstConstraintExpr* const cexprp = VN_CAST(itemp, ConstraintExpr);
+            Term term;
+            if (!cexprp || cexprp->isDisableSoft() || !expr(cexprp->exprp(), term)) {
+                m_simple = false;
+            } else if (!term.m_varp) {
+                if (!term.m_true) m_simple = false;  // Never satisfied; solver reports it
+            } else {
+                addVarSet(term.m_varp, term.m_set);
+            }
+        }
+    }
+    // Add another analysis, e.g. of constraints inherited from a base class
+    void add(const ConstraintSimpleAnalysis& other) {
+        if (!other.m_simple) m_simple = false;
+        for (AstVar* const varp : other.m_varps) addVarSet(varp, other.m_sets.at(varp));
+    }
+    // True if randomize() may sample all constrained variables directly
+    bool simple() const {
+        if (!m_simple) return false;
+        for (const auto& it : m_sets) {
+            if (it.second.empty()) return false;  // Unsatisfiable; solver reports it
+        }
+        return true;
+    }
+    const std::vector<AstVar*>& varps() const { return m_varps; }
+    const ConstraintValueSet& valueSet(const AstVar* varp) const { return m_sets.at(varp); }
+};
+
 //######################################################################
 // Visitor that defines a randomize method where needed
 
@@ -1267,6 +1582,9 @@ class RandomizeVisitor final : public VNVisitor {
     int m_randCaseNum = 0;  // Randcase number within a module for var naming
     std::map<std::string, AstCDType*> m_randcDtypes;  // RandC data type deduplication
     AstConstraint* m_constraintp = nullptr;  // Current constraint
+    std::map<const AstConstraint*, ConstraintSimpleAnalysis>
+        m_constraintAnalysis;  // Analysis of each constraint, before it is converted
+    VDouble0 m_statSimple;  // Statistic tracking classes randomized without solver
 
     // METHODS
     void createRandomGenerator(AstClass* const classp) {
@@ -1692,6 +2010,54 @@ class RandomizeVisitor final : public VNVisitor {
         nodep->addMembersp(taskp);
         return taskp;
     }
+    AstNodeStmt* newSimpleRandStmtsp(FileLine* const fl, AstVar* const tmpVarp,
+                                     AstVar* const varp, const ConstraintValueSet& set) {
+        // tmp = rng % count; then the count'th allowed value is tmp plus the offset of the
+        // range holding it. Count zero means all 2^64 values are allowed
+        uint64_t count = 0;
+        for (const auto& range : set.ranges()) count += range.second - range.first + 1;
+        AstNodeExpr* randp = new AstRandRNG{fl, tmpVarp->dtypep()};
+        if (count) {
+            randp = new AstModDiv{fl, randp, new AstConst{fl, AstConst::Unsized64{}, count}};
+        }
+        AstNodeStmt* const stmtsp
+            = new AstAssign{fl, new AstVarRef{fl, tmpVarp, VAccess::WRITE}, randp};
+        AstNodeIf* lastIfp = nullptr;
+        uint64_t start = 0;  // Index of the first value of the range
+        for (const auto& range : set.ranges()) {
+            const uint64_t size = range.second - range.first + 1;
+            AstNodeExpr* valp = new AstVarRef{fl, tmpVarp, VAccess::READ};
+            if (range.first != start) {
+                valp = new AstAdd{fl, valp,
+                                  new AstConst{fl, AstConst::Unsized64{}, range.first - start}};
+            }
+            if (varp->width() < 64) valp = new AstSel{fl, valp, 0, varp->width()};
+            AstNodeStmt* const assignp = new AstAssign{
+                fl, new AstVarRef{fl, VN_AS(varp->user2p(), NodeModule), varp, VAccess::WRITE},
+                valp};
+            start += size;
+            if (&range == &set.ranges().back()) {
+                if (lastIfp) {
+                    lastIfp->addElsesp(assignp);
+                } else {
+                    stmtsp->addNext(assignp);
+                }
+                break;
+            }
+            AstNodeIf* const ifp = new AstIf{
+                fl,
+                new AstLt{fl, new AstVarRef{fl, tmpVarp, VAccess::READ},
+                          new AstConst{fl, AstConst::Unsized64{}, start}},
+                assignp};
+            if (lastIfp) {
+                lastIfp->addElsesp(ifp);
+            } else {
+                stmtsp->addNext(ifp);
+            }
+            lastIfp = ifp;
+        }
+        return stmtsp;
+    }
     AstNodeStmt* implementConstraintsClear(FileLine* const fileline, AstVar* const genp) {
         AstCMethodHard* const clearp = new AstCMethodHard{
             fileline,
@@ -2009,6 +2375,22 @@ class RandomizeVisitor final : public VNVisitor {
         AstVar* const randModeVarp = getRandModeVar(nodep);
         AstNodeExpr* beginValp = nullptr;
         AstVar* genp = getRandomGenerator(nodep);
+        // Analyze before converting, as constraints of a base class are converted only once
+        ConstraintSimpleAnalysis analysis;
+        if (genp) {
+            nodep->foreachMember([&](AstClass* const, AstConstraint* const constrp) {
+                const auto it = m_constraintAnalysis.find(constrp);
+                if (it != m_constraintAnalysis.end()) {
+                    analysis.add(it->second);
+                    return;
+                }
+                ConstraintSimpleAnalysis& constrAnalysis = m_constraintAnalysis[constrp];
+                constrAnalysis.add(constrp);
+                analysis.add(constrAnalysis);
+            });
+        }
+        const bool simple
+            = genp && !randModeVarp && !getConstraintModeVar(nodep) && analysis.simple();
         if (genp) {
             nodep->foreachMember([&](AstClass* const classp, AstConstraint* const constrp) {
                 AstTask* taskp = VN_AS(constrp->user2p(), Task);
@@ -2038,6 +2420,23 @@ class RandomizeVisitor final : public VNVisitor {
                         nodep, constrp, constrp->itemsp()->unlinkFrBackWithNext()));
                 }
             });
+        }
+        if (simple) {
+            // Independent variables, sample each from its allowed values
+            // Setup tasks are still needed above by randomize() with
+            ++m_statSimple;
+            AstVar* const tmpVarp
+                = new AstVar{fl, VVarType::BLOCKTEMP, "__Vrandval", nodep->findUInt64DType()};
+            tmpVarp->noSubst(true);
+            tmpVarp->funcLocal(true);
+            tmpVarp->lifetime(VLifetime::AUTOMATIC);
+            randomizep->addStmtsp(tmpVarp);
+            for (AstVar* const varp : analysis.varps()) {
+                randomizep->addStmtsp(
+                    newSimpleRandStmtsp(fl, tmpVarp, varp, analysis.valueSet(varp)));
+            }
+            beginValp = new AstConst{fl, AstConst::WidthedValue{}, 32, 1};
+        } else if (genp) {
             randomizep->addStmtsp(implementConstraintsClear(fl, genp));
             AstTask* setupAllTaskp = getCreateConstraintSetupFunc(nodep);
             AstTaskRef* const setupTaskRefp = new AstTaskRef{fl, setupAllTaskp, nullptr};
@@ -2362,7 +2761,9 @@ public:
             VL_DO_DANGLING(pushDeletep(constrp->unlinkFrBack()), constrp);
         });
     }
-    ~RandomizeVisitor() override = default;
+    ~RandomizeVisitor() override {
+        V3Stats::addStat("Randomize, classes without solver", m_statSimple);
+    }
 };
 
 //######################################################################
@@ -27,6 +27,12 @@
 //
 //   Likewise vector assign to the same constant converted to a loop.
 //
+//   If the whole series is between unpacked arrays with the same element
+//   type, or fills an unpacked array with a constant, instead replace it
+//   with a single VlUnpacked copyRange/fillRange call, which compiles to a
+//   memcpy/memset:
+//      CMETHODHARD(var, copyRange, #, var, #+C, count)
+//
 //*************************************************************************
 
 #include "V3PchAstNoMT.h"  // VL_MT_DISABLED_CODE_UNIT
@@ -47,6 +53,7 @@ class ReloopVisitor final : public VNVisitor {
     // STATE
     VDouble0 m_statReloops;  // Statistic tracking
     VDouble0 m_statReItems;  // Statistic tracking
+    VDouble0 m_statBulk;  // Statistic tracking
     AstCFunc* m_cfuncp = nullptr;  // Current block
 
     std::vector<AstNodeAssign*> m_mgAssignps;  // List of assignments merging
@@ -70,6 +77,102 @@ class ReloopVisitor final : public VNVisitor {
             = new AstVar{fl, VVarType::STMTTEMP, newvarname, VFlagLogicPacked{}, 32};
         return varp;
     }
+    // Replace the merged assignments with a single bulk copy or fill of the
+    // array. Return false if not possible, then a loop is created instead.
+    bool mergeBulk(uint32_t items) {
+        AstNodeAssign* const bodyp = m_mgAssignps.front();
+        if (!VN_IS(bodyp, Assign)) return false;
+        AstArraySel* const lselp = VN_CAST(bodyp->lhsp(), ArraySel);
+        if (!lselp || !VN_IS(lselp->fromp()->dtypep()->skipRefp(), UnpackArrayDType)) {
+            return false;
+        }
+        AstArraySel* const rselp = VN_CAST(bodyp->rhsp(), ArraySel);
+        if (m_mgSelRp) {
+            if (!rselp || !VN_IS(rselp->fromp()->dtypep()->skipRefp(), UnpackArrayDType)) {
+                return false;
+            }
+            if (!lselp->dtypep()->similarDType(rselp->dtypep())) return false;
+        } else {
+            const AstBasicDType* const basicp = VN_CAST(lselp->dtypep()->skipRefp(), BasicDType);
+            if (!basicp || basicp->isWide() || basicp->isString()) return false;
+        }
+        UINFO(6, "Reloop bulk items=" << items << " " << bodyp);
+        FileLine* const fl = bodyp->fileline();
+        AstCMethodHard* callp;
+        if (m_mgSelRp) {
+            const int64_t rindexLo = static_cast<int64_t>(m_mgIndexLo) - m_mgOffset;
+            callp = new AstCMethodHard{fl, lselp->fromp()->unlinkFrBack(), "copyRange"};
+            callp->addPinsp(new AstConst{fl, m_mgIndexLo});
+            callp->addPinsp(rselp->fromp()->unlinkFrBack());
+            callp->addPinsp(new AstConst{fl, static_cast<uint32_t>(rindexLo)});
+            callp->addPinsp(new AstConst{fl, items});
+        } else {
+            callp = new AstCMethodHard{fl, lselp->fromp()->unlinkFrBack(), "fillRange"};
+            callp->addPinsp(new AstConst{fl, m_mgIndexLo});
+            callp->addPinsp(new AstConst{fl, items});
+            callp->addPinsp(bodyp->rhsp()->unlinkFrBack());
+        }
+        callp->dtypeSetVoid();
+        bodyp->replaceWith(callp->makeStmt());
+        if (debug() >= 9) callp->dumpTree("-  new: ");
+        for (AstNodeAssign* assp : m_mgAssignps) {
+            if (assp != bodyp) assp->unlinkFrBack();
+            VL_DO_DANGLING(assp->deleteTree(), assp);
+        }
+        ++m_statBulk;
+        return true;
+    }
+    // Replace the merged assignments with a loop
+    void mergeLoop() {
+        // Transform first assign into for loop body
+        AstNodeAssign* const bodyp = m_mgAssignps.front();
+        UASSERT_OBJ(bodyp->lhsp() == m_mgSelLp, bodyp, "Corrupt queue/state");
+        FileLine* const fl = bodyp->fileline();
+        AstVar* const itp = createVarTemp(fl, m_mgCfuncp);
+
+        if (m_mgOffset > 0) {
+            UASSERT_OBJ(m_mgIndexLo >= m_mgOffset, bodyp,
+                        "Reloop iteration starts at negative index");
+            m_mgIndexLo -= m_mgOffset;
+            m_mgIndexHi -= m_mgOffset;
+        }
+
+        AstNode* const initp = new AstAssign{fl, new AstVarRef{fl, itp, VAccess::WRITE},
+                                             new AstConst{fl, m_mgIndexLo}};
+        AstNodeExpr* const condp = new AstLte{fl, new AstVarRef{fl, itp, VAccess::READ},
+                                              new AstConst{fl, m_mgIndexHi}};
+        AstNode* const incp = new AstAssign{
+            fl, new AstVarRef{fl, itp, VAccess::WRITE},
+            new AstAdd{fl, new AstConst{fl, 1}, new AstVarRef{fl, itp, VAccess::READ}}};
+        AstWhile* const whilep = new AstWhile{fl, condp, nullptr, incp};
+        initp->addNext(whilep);
+        itp->AstNode::addNext(initp);
+        bodyp->replaceWith(itp);
+        whilep->addStmtsp(bodyp);
+
+        // Replace constant index with new loop index
+        AstNodeExpr* const offsetp
+            = m_mgOffset == 0 ? nullptr : new AstConst(fl, std::abs(m_mgOffset));
+        AstNodeExpr* const lbitp = m_mgSelLp->bitp();
+        AstNodeExpr* const lvrefp = new AstVarRef{fl, itp, VAccess::READ};
+        lbitp->replaceWith(m_mgOffset > 0 ? new AstAdd{fl, lvrefp, offsetp} : lvrefp);
+        VL_DO_DANGLING(lbitp->deleteTree(), lbitp);
+        if (m_mgSelRp) {  // else constant and no replace
+            AstNodeExpr* const rbitp = m_mgSelRp->bitp();
+            AstNodeExpr* const rvrefp = new AstVarRef{fl, itp, VAccess::READ};
+            rbitp->replaceWith(m_mgOffset < 0 ? new AstAdd{fl, rvrefp, offsetp} : rvrefp);
+            VL_DO_DANGLING(rbitp->deleteTree(), lbitp);
+        }
+        if (debug() >= 9) initp->dumpTree("-  new: ");
+        if (debug() >= 9) whilep->dumpTree("-  new: ");
+
+        // Remove remaining assigns
+        for (AstNodeAssign* assp : m_mgAssignps) {
+            if (assp != bodyp) {
+                VL_DO_DANGLING(assp->unlinkFrBack()->deleteTree(), assp);
+            }
+        }
+    }
     void mergeEnd() {
         if (!m_mgAssignps.empty()) {
             const uint32_t items = m_mgIndexHi - m_mgIndexLo + 1;
@@ -81,55 +184,7 @@ class ReloopVisitor final : public VNVisitor {
                                                  << m_mgAssignps[0]);
                 ++m_statReloops;
                 m_statReItems += items;
-
-                // Transform first assign into for loop body
-                AstNodeAssign* const bodyp = m_mgAssignps.front();
-                UASSERT_OBJ(bodyp->lhsp() == m_mgSelLp, bodyp, "Corrupt queue/state");
-                FileLine* const fl = bodyp->fileline();
-                AstVar* const itp = createVarTemp(fl, m_mgCfuncp);
-
-                if (m_mgOffset > 0) {
-                    UASSERT_OBJ(m_mgIndexLo >= m_mgOffset, bodyp,
-                                "Reloop iteration starts at negative index");
-                    m_mgIndexLo -= m_mgOffset;
-                    m_mgIndexHi -= m_mgOffset;
-                }
-
-                AstNode* const initp = new AstAssign{fl, new AstVarRef{fl, itp, VAccess::WRITE},
-                                                     new AstConst{fl, m_mgIndexLo}};
-                AstNodeExpr* const condp = new AstLte{fl, new AstVarRef{fl, itp, VAccess::READ},
-                                                      new AstConst{fl, m_mgIndexHi}};
-                AstNode* const incp = new AstAssign{
-                    fl, new AstVarRef{fl, itp, VAccess::WRITE},
-                    new AstAdd{fl, new AstConst{fl, 1}, new AstVarRef{fl, itp, VAccess::READ}}};
-                AstWhile* const whilep = new AstWhile{fl, condp, nullptr, incp};
-                initp->addNext(whilep);
-                itp->AstNode::addNext(initp);
-                bodyp->replaceWith(itp);
-                whilep->addStmtsp(bodyp);
-
-                // Replace constant index with new loop index
-                AstNodeExpr* const offsetp
-                    = m_mgOffset == 0 ? nullptr : new AstConst(fl, std::abs(m_mgOffset));
-                AstNodeExpr* const lbitp = m_mgSelLp->bitp();
-                AstNodeExpr* const lvrefp = new AstVarRef{fl, itp, VAccess::READ};
-                lbitp->replaceWith(m_mgOffset > 0 ? new AstAdd{fl, lvrefp, offsetp} : lvrefp);
-                VL_DO_DANGLING(lbitp->deleteTree(), lbitp);
-                if (m_mgSelRp) {  // else constant and no replace
-                    AstNodeExpr* const rbitp = m_mgSelRp->bitp();
-                    AstNodeExpr* const rvrefp = new AstVarRef{fl, itp, VAccess::READ};
-                    rbitp->replaceWith(m_mgOffset < 0 ? new AstAdd{fl, rvrefp, offsetp} : rvrefp);
-                    VL_DO_DANGLING(rbitp->deleteTree(), lbitp);
-                }
-                if (debug() >= 9) initp->dumpTree("-  new: ");
-                if (debug() >= 9) whilep->dumpTree("-  new: ");
-
-                // Remove remaining assigns
-                for (AstNodeAssign* assp : m_mgAssignps) {
-                    if (assp != bodyp) {
-                        VL_DO_DANGLING(assp->unlinkFrBack()->deleteTree(), assp);
-                    }
-                }
+                if (!mergeBulk(items)) mergeLoop();
             }
             // Setup for next merge
             m_mgAssignps.clear();
@@ -251,6 +306,7 @@ public:
     ~ReloopVisitor() override {
         V3Stats::addStat("Optimizations, Reloops", m_statReloops);
         V3Stats::addStat("Optimizations, Reloop iterations", m_statReItems);
+        V3Stats::addStat("Optimizations, Reloop bulk copies", m_statBulk);
     }
 };
 
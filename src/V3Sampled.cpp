@@ -16,7 +16,11 @@
 // V3Sampled's Transformations:
 //
 // Top Scope:
-//   Replace each variable reference under SAMPLED with a new variable.
+//   Replace each variable reference under SAMPLED with a new variable,
+//   shared by all references to the same variable.
+//   Variables never written by the design, other than by static
+//   initializers, keep their value through the
+//   time step, so references to those are used directly.
 //   Remove SAMPLED.
 //
 //*************************************************************************
@@ -25,6 +29,8 @@
 
 #include "V3Sampled.h"
 
+#include "V3Stats.h"
+
 VL_DEFINE_DEBUG_FUNCTIONS;
 
 //######################################################################
@@ -34,14 +40,24 @@ class SampledVisitor final : public VNVisitor {
     // NODE STATE
     //  AstVarScope::user1()  -> AstVarScope*. The VarScope that stores sampled value
     //  AstVarRef::user1()    -> bool. Whether already converted
+    //  AstVar::user2()       -> int. Number of writes, other than by static initializers
     const VNUser1InUse m_user1InUse;
+    const VNUser2InUse m_user2InUse;
 
     // STATE - for current visit position (use VL_RESTORER)
     AstScope* m_scopep = nullptr;  // Current scope
     bool m_inSampled = false;  // True inside a sampled expression
+    VDouble0 m_statStable;  // Statistic tracking
 
     // METHODS
 
+    // Variable that does not change after initialization, so its sampled value is its value
+    static bool isStable(const AstVarScope* vscp) {
+        const AstVar* const varp = vscp->varp();
+        if (varp->user2() || varp->isPrimaryIO() || varp->isSigUserRWPublic()) return false;
+        return !varp->isWrittenByDpi() && !varp->isForceable();
+    }
+
     AstVarScope* createSampledVar(AstVarScope* vscp) {
         if (vscp->user1p()) return VN_AS(vscp->user1p(), VarScope);
         const AstVar* const varp = vscp->varp();
@@ -79,6 +95,10 @@ class SampledVisitor final : public VNVisitor {
         if (m_inSampled && !nodep->user1SetOnce()) {
             UASSERT_OBJ(nodep->access().isReadOnly(), nodep, "Should have failed in V3Access");
             AstVarScope* const varscp = nodep->varScopep();
+            if (isStable(varscp)) {
+                ++m_statStable;
+                return;
+            }
             AstVarScope* const lastscp = createSampledVar(varscp);
             AstNode* const newp = new AstVarRef{nodep->fileline(), lastscp, VAccess::READ};
             newp->user1SetOnce();  // Don't sample this one
@@ -92,8 +112,22 @@ class SampledVisitor final : public VNVisitor {
 
 public:
     // CONSTRUCTORS
-    explicit SampledVisitor(AstNetlist* netlistp) { iterate(netlistp); }
-    ~SampledVisitor() override = default;
+    explicit SampledVisitor(AstNetlist* netlistp) {
+        netlistp->foreach([](const AstNodeVarRef* refp) {
+            if (refp->access().isWriteOrRW()) refp->varp()->user2Inc();
+        });
+        // Static initializers are done before the first time step
+        netlistp->foreach([](const AstActive* activep) {
+            if (!activep->sensesp()->hasStatic()) return;
+            activep->foreach([](const AstNodeVarRef* refp) {
+                if (refp->access().isWriteOrRW()) refp->varp()->user2Inc(-1);
+            });
+        });
+        iterate(netlistp);
+    }
+    ~SampledVisitor() override {
+        V3Stats::addStat("Optimizations, Sampled references to stable variables", m_statStable);
+    }
 };
 
 //######################################################################
@@ -104,15 +104,28 @@ void invertAndMergeSenTreeMap(
     for (const auto& pair : senTreeMap) result.emplace(pair.second, pair.first);
 }
 
-AstSenTree* findTriggeredIface(const AstVarScope* vscp,
-                               const VirtIfaceTriggers::IfaceSensMap& vifTrigged,
-                               const VirtIfaceTriggers::IfaceMemberSensMap& vifMemberTriggered) {
-    const auto ifaceIt = vifTrigged.find(vscp->varp()->sensIfacep());
-    if (ifaceIt != vifTrigged.end()) return ifaceIt->second;
+// Add the virtual interface triggers that can change the value read via 'vscp' to 'out'
+void addTriggeredIface(const AstVarScope* vscp,
+                       const VirtIfaceTriggers::IfaceSensMap& vifTrigged,
+                       const VirtIfaceTriggers::IfaceMemberSensMap& vifMemberTriggered,
+                       std::vector<AstSenTree*>& out) {
+    const AstVar* const varp = vscp->varp();
+    const AstIface* const ifacep = varp->sensIfacep();
+    const auto ifaceIt = vifTrigged.find(ifacep);
+    if (ifaceIt != vifTrigged.end()) out.push_back(ifaceIt->second);
+    // Reads via a virtual interface might see any member of any instance. Reads of a member of
+    // a specific instance only need to see writes via virtual interfaces to the same member.
+    bool isMember = false;
     for (const auto& memberIt : vifMemberTriggered) {
-        if (memberIt.first.m_ifacep == vscp->varp()->sensIfacep()) { return memberIt.second; }
+        if (memberIt.first.m_memberVarp == varp) isMember = true;
+    }
+    for (const auto& memberIt : vifMemberTriggered) {
+        if (memberIt.first.m_ifacep != ifacep) continue;
+        if (isMember && (memberIt.first.m_direct || memberIt.first.m_memberVarp != varp)) {
+            continue;
+        }
+        out.push_back(memberIt.second);
     }
-    return nullptr;
 }
 
 //============================================================================
@@ -178,6 +191,53 @@ AstNodeStmt* profExecSectionPop(FileLine* flp) {
     return new AstCStmt{flp, "VL_EXEC_TRACE_ADD_RECORD(vlSymsp).sectionPop();\n"};
 }
 
+// Descriptions of the triggers in each trigger vector, for --prof-eval
+std::unordered_map<const AstVarScope*, std::vector<string>>& profEvalTriggerNames() {
+    static std::unordered_map<const AstVarScope*, std::vector<string>> s_names;
+    return s_names;
+}
+
+// Index of a region in VlEvalCounters
+uint32_t profEvalRegion(const string& tag) {
+    static const std::array<string, 6> s_tags{"stl", "ico", "act", "nba", "obs", "react"};
+    const auto it = std::find(s_tags.begin(), s_tags.end(), tag);
+    UASSERT(it != s_tags.end(), "Unknown region " << tag);
+    return static_cast<uint32_t>(it - s_tags.begin());
+}
+
+// Count the completed run of a region's loop, which took 'counterp' iterations
+AstNodeStmt* profEvalLoop(FileLine* flp, const string& tag, AstVarScope* counterp) {
+    AstCStmt* const stmtp = new AstCStmt{
+        flp, new AstText{flp, "vlSymsp->__Vm_evalCounters.loop(" + cvtToStr(profEvalRegion(tag))
+                                  + ", \"" + tag + "\", "}};
+    stmtp->addExprsp(new AstVarRef{flp, counterp, VAccess::READ});
+    stmtp->addExprsp(new AstText{flp, ");\n"});
+    return stmtp;
+}
+
+// Count the triggers set in 'trigp' for an iteration of a region's loop
+AstNodeStmt* profEvalTriggers(FileLine* flp, const string& tag, AstVarScope* trigp) {
+    string names = "nullptr";
+    const auto it = profEvalTriggerNames().find(trigp);
+    if (it != profEvalTriggerNames().end() && !it->second.empty()) {
+        names = "__VtriggerNames";
+    }
+    string text = "{\n";
+    if (names != "nullptr") {
+        text += "static const char* const __VtriggerNames[] = {";
+        for (const string& name : it->second) {
+            text += "\n\"" + V3OutFormatter::quoteNameControls(name) + "\",";
+        }
+        text += "};\n";
+    }
+    text += "vlSymsp->__Vm_evalCounters.triggers(" + cvtToStr(profEvalRegion(tag)) + ", \"" + tag
+            + "\", " + names + ", ";
+    AstCStmt* const stmtp = new AstCStmt{flp, new AstText{flp, text}};
+    stmtp->addExprsp(new AstVarRef{flp, trigp, VAccess::READ});
+    stmtp->addExprsp(new AstText{flp, ");\n}\n"});
+    return stmtp;
+}
+
 struct EvalLoop final {
     // Flag set to true during the first iteration of the loop
     AstVarScope* firstIterp;
@@ -224,6 +284,7 @@ EvalLoop createEvalLoop(
 
         // Add the work
         AstIf* const ifp = new AstIf{flp, new AstVarRef{flp, executeFlagp, VAccess::READ}};
+        if (v3Global.opt.profEval()) ifp->addThensp(profEvalTriggers(flp, tag, trigp));
         ifp->addThensp(phaseWorkp);
         phaseFuncp->addStmtsp(ifp);
 
@@ -286,6 +347,9 @@ EvalLoop createEvalLoop(
         stmtps->addNext(loopp);
     }
 
+    // Prof-eval loop counters
+    if (v3Global.opt.profEval()) stmtps->addNext(profEvalLoop(flp, tag, counterp));
+
     // Prof-exec section pop
     if (v3Global.opt.profExec()) stmtps->addNext(profExecSectionPop(flp));
 
@@ -602,6 +666,23 @@ void addVirtIfaceTriggerAssignments(const VirtIfaceTriggers& virtIfaceTriggers,
         actTrig.addExtraTriggerAssignment(p.second, vifTriggerIndex);
         ++vifTriggerIndex;
     }
+    for (const auto& p : virtIfaceTriggers.m_memberTriggers) {
+        actTrig.addExtraTriggerAssignment(p.second, vifTriggerIndex);
+        ++vifTriggerIndex;
+    }
+}
+
+// Allocate the extra triggers in the same order as the assignments above
+void allocateVirtIfaceTriggers(const VirtIfaceTriggers& virtIfaceTriggers,
+                               ExtraTriggers& extraTriggers) {
+    for (const auto& p : virtIfaceTriggers) {
+        extraTriggers.allocate("virtual interface: " + p.first->name());
+    }
+    for (const auto& p : virtIfaceTriggers.m_memberTriggers) {
+        extraTriggers.allocate("virtual interface member: " + p.first.m_ifacep->name() + "."
+                               + p.first.m_memberVarp->name()
+                               + (p.first.m_direct ? " (direct)" : ""));
+    }
 }
 
 //============================================================================
@@ -704,9 +785,16 @@ const TriggerKit createTriggers(AstNetlist* netlistp, AstCFunc* const initFuncp,
         ifp->addThensp(new AstText{flp, message, true});
     };
 
+    // Descriptions of the triggers for --prof-eval, which might leak signal names, so not
+    // recorded when using --protect-ids
+    std::vector<string>* const trigNamesp
+        = v3Global.opt.profEval() && !v3Global.opt.protectIds() ? &profEvalTriggerNames()[vscp]
+                                                                 : nullptr;
+
     // Add a print for each of the extra triggers
     for (unsigned i = 0; i < extraTriggers.size(); ++i) {
         addDebug(i, "Internal '" + name + "' trigger - " + extraTriggers.description(i));
+        if (trigNamesp) trigNamesp->push_back("Internal - " + extraTriggers.description(i));
     }
 
     // Add trigger computation
@@ -742,6 +830,7 @@ const TriggerKit createTriggers(AstNetlist* netlistp, AstCFunc* const initFuncp,
         V3EmitV::verilogForTree(senItemp, ss);
         ss << ")";
         addDebug(triggerNumber, ss.str());
+        if (trigNamesp) trigNamesp->push_back(ss.str());
 
         //
         ++triggerNumber;
@@ -905,6 +994,39 @@ void createSettle(AstNetlist* netlistp, AstCFunc* const initFuncp, SenExprBuilde
     funcp->addStmtsp(stlLoop.stmtsp);
 }
 
+//============================================================================
+// SystemC only: Read top level inputs that are expensive to convert only when they changed
+
+void guardScInputReads(LogicByScope& logic) {
+    size_t guarded = 0;
+    for (const auto& pair : logic) {
+        for (AstNode *nextp, *nodep = pair.second->stmtsp(); nodep; nodep = nextp) {
+            nextp = nodep->nextp();
+            AstAssignW* const assignp = VN_CAST(nodep, AssignW);
+            if (!assignp || !VN_IS(assignp->lhsp(), VarRef)) continue;
+            AstVarRef* const refp = VN_CAST(assignp->rhsp(), VarRef);
+            if (!refp) continue;
+            const AstVar* const varp = refp->varp();
+            if (!varp->isSc() || !varp->isPrimaryIO() || !varp->isNonOutput()) continue;
+            if (!varp->isScBv() && !varp->isScBigUint()) continue;
+            if (!VN_IS(varp->dtypeSkipRefp(), BasicDType)) continue;
+            // The model is sensitive to the input, so a change since the last evaluation is an
+            // event in the current delta cycle. The 'stl' region reads it on the first eval.
+            if (!varp->isScSensitive() && !varp->isUsedClock()) continue;
+            FileLine* const flp = assignp->fileline();
+            AstCMethodHard* const condp = new AstCMethodHard{flp, refp->cloneTree(false), "event"};
+            condp->dtypeSetBit();
+            AstIf* const ifp = new AstIf{flp, condp};
+            ifp->addThensp(new AstAssign{flp, assignp->lhsp()->unlinkFrBack(),
+                                         assignp->rhsp()->unlinkFrBack()});
+            assignp->replaceWith(new AstAlways{flp, VAlwaysKwd::ALWAYS, nullptr, ifp});
+            VL_DO_DANGLING(assignp->deleteTree(), assignp);
+            ++guarded;
+        }
+    }
+    V3Stats::addStat("Scheduling, SystemC input reads on event", guarded);
+}
+
 //============================================================================
 // Order the replicated combinational logic to create the 'ico' region
 
@@ -926,6 +1048,7 @@ AstNode* createInputCombLoop(AstNetlist* netlistp, AstCFunc* const initFuncp,
                 }
             });
         });
+        guardScInputReads(logic);
     }
 
     // We have some extra trigger denoting external conditions
@@ -937,9 +1060,7 @@ AstNode* createInputCombLoop(AstNetlist* netlistp, AstCFunc* const initFuncp,
                                              ? extraTriggers.allocate("DPI export trigger")
                                              : std::numeric_limits<unsigned>::max();
     const size_t firstVifTriggerIndex = extraTriggers.size();
-    for (const auto& p : virtIfaceTriggers) {
-        extraTriggers.allocate("virtual interface: " + p.first->name());
-    }
+    allocateVirtIfaceTriggers(virtIfaceTriggers, extraTriggers);
 
     // Gather the relevant sensitivity expressions and create the trigger kit
     const auto& senTreeps = getSenTreesUsedBy({&logic});
@@ -981,9 +1102,8 @@ AstNode* createInputCombLoop(AstNetlist* netlistp, AstCFunc* const initFuncp,
                              }
                              if (varp->isWrittenByDpi()) out.push_back(dpiExportTriggered);
                              if (vscp->varp()->sensIfacep()) {
-                                 AstSenTree* ifaceTriggered = findTriggeredIface(
-                                     vscp, vifTriggeredIco, vifMemberTriggeredIco);
-                                 out.push_back(ifaceTriggered);
+                                 addTriggeredIface(vscp, vifTriggeredIco,
+                                                   vifMemberTriggeredIco, out);
                              }
                          });
     splitCheck(icoFuncp);
@@ -1173,6 +1293,9 @@ void createEval(AstNetlist* netlistp,  //
     netlistp->evalp(funcp);
 
     if (v3Global.opt.profExec()) funcp->addStmtsp(profExecSectionPush(flp, "eval"));
+    if (v3Global.opt.profEval()) {
+        funcp->addStmtsp(new AstCStmt{flp, "vlSymsp->__Vm_evalCounters.eval();\n"});
+    }
 
     // Start with the ico loop, if any
     if (icoLoop) funcp->addStmtsp(icoLoop);
@@ -1207,6 +1330,7 @@ VirtIfaceTriggers::IfaceMemberSensMap
 VirtIfaceTriggers::makeMemberToSensMap(AstNetlist* const netlistp, size_t vifTriggerIndex,
                                        AstVarScope* trigVscp) const {
     IfaceMemberSensMap memberToSensMap;
+    vifTriggerIndex += m_ifaceTriggers.size();  // Member triggers follow interface triggers
     for (const auto& p : m_memberTriggers) {
         memberToSensMap.emplace(
             std::make_pair(p.first, createTriggerSenTree(netlistp, trigVscp, vifTriggerIndex)));
@@ -1230,6 +1354,8 @@ void schedule(AstNetlist* netlistp) {
     const auto& virtIfaceTriggers = makeVirtIfaceTriggers(netlistp);
     // Prepare timing-related logic and external domains
     TimingKit timingKit = prepareTiming(netlistp);
+    // Turn 'posedge gated_clock' into 'posedge clock iff enable' where possible
+    hoistClockGates(netlistp);
 
     // Step 1. Gather and classify all logic in the design
     LogicClasses logicClasses = gatherLogicClasses(netlistp);
@@ -1312,9 +1438,7 @@ void schedule(AstNetlist* netlistp) {
                                              ? extraTriggers.allocate("DPI export trigger")
                                              : std::numeric_limits<unsigned>::max();
     const size_t firstVifTriggerIndex = extraTriggers.size();
-    for (const auto& p : virtIfaceTriggers) {
-        extraTriggers.allocate("virtual interface: " + p.first->name());
-    }
+    allocateVirtIfaceTriggers(virtIfaceTriggers, extraTriggers);
 
     const auto& senTreeps = getSenTreesUsedBy({&logicRegions.m_pre,  //
                                                &logicRegions.m_act,  //
@@ -1395,9 +1519,7 @@ void schedule(AstNetlist* netlistp) {
             if (it != actTimingDomains.end()) out = it->second;
             if (vscp->varp()->isWrittenByDpi()) out.push_back(dpiExportTriggeredAct);
             if (vscp->varp()->sensIfacep()) {
-                AstSenTree* ifaceTriggered
-                    = findTriggeredIface(vscp, vifTriggeredAct, vifMemberTriggeredAct);
-                out.push_back(ifaceTriggered);
+                addTriggeredIface(vscp, vifTriggeredAct, vifMemberTriggeredAct, out);
             }
         });
     splitCheck(actFuncp);
@@ -1412,6 +1534,9 @@ void schedule(AstNetlist* netlistp) {
         AstVarScope* const trigVscp
             = scopeTopp->createTempLike("__V" + name + "Triggered", actTrigVscp);
         const auto trigMap = cloneMapWithNewTriggerReferences(actTrigMap, trigVscp);
+        if (v3Global.opt.profEval()) {
+            profEvalTriggerNames().emplace(trigVscp, profEvalTriggerNames()[actTrigVscp]);
+        }
         // Remap sensitivities of the input logic to the triggers
         for (LogicByScope* lbs : logic) remapSensitivities(*lbs, trigMap);
 
@@ -1436,9 +1561,7 @@ void schedule(AstNetlist* netlistp) {
                 if (it != timingDomains.end()) out = it->second;
                 if (vscp->varp()->isWrittenByDpi()) out.push_back(dpiExportTriggered);
                 if (vscp->varp()->sensIfacep()) {
-                    AstSenTree* ifaceTriggered
-                        = findTriggeredIface(vscp, vifTriggered, vifMemberTriggered);
-                    out.push_back(ifaceTriggered);
+                    addTriggeredIface(vscp, vifTriggered, vifMemberTriggered, out);
                 }
             });
 
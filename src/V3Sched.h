@@ -157,14 +157,20 @@ class VirtIfaceTriggers final {
     struct IfaceMember final {
         const AstIface* m_ifacep;  // Interface type
         const AstVar* m_memberVarp;  // pointer to member field
+        // Written directly in a known instance, not via a virtual interface. Only readers via
+        // virtual interfaces need this trigger, readers of the instance itself are ordered
+        // after the write anyway, and readers of other instances are not affected.
+        bool m_direct;
 
-        IfaceMember(const AstIface* ifacep, const AstVar* memberVarp)
+        IfaceMember(const AstIface* ifacep, const AstVar* memberVarp, bool direct)
             : m_ifacep(ifacep)
-            , m_memberVarp(memberVarp) {}
+            , m_memberVarp(memberVarp)
+            , m_direct(direct) {}
 
         bool operator<(const IfaceMember& other) const {
             if (m_ifacep != other.m_ifacep) return m_ifacep < other.m_ifacep;
-            return m_memberVarp < other.m_memberVarp;
+            if (m_memberVarp != other.m_memberVarp) return m_memberVarp < other.m_memberVarp;
+            return m_direct < other.m_direct;
         }
     };
 
@@ -180,13 +186,14 @@ public:
     IfaceMemberTriggerVec m_memberTriggers;
     IfaceTriggerVec m_ifaceTriggers;
 
-    void addMemberTrigger(const AstIface* ifacep, const AstVar* memberVarp,
+    void addMemberTrigger(const AstIface* ifacep, const AstVar* memberVarp, bool direct,
                           AstVarScope* triggerVscp) {
-        m_memberTriggers.emplace_back(IfaceMember(ifacep, memberVarp), triggerVscp);
+        m_memberTriggers.emplace_back(IfaceMember(ifacep, memberVarp, direct), triggerVscp);
     }
 
-    AstVarScope* findMemberTrigger(const AstIface* ifacep, const AstVar* memberVarp) const {
-        IfaceMember target{ifacep, memberVarp};
+    AstVarScope* findMemberTrigger(const AstIface* ifacep, const AstVar* memberVarp,
+                                   bool direct) const {
+        IfaceMember target{ifacep, memberVarp, direct};
         for (const auto& pair : m_memberTriggers) {
             if (!(pair.first < target) && !(target < pair.first)) return pair.second;
         }
@@ -196,6 +203,8 @@ public:
     IfaceMemberSensMap makeMemberToSensMap(AstNetlist* netlistp, size_t vifTriggerIndex,
                                            AstVarScope* trigVscp) const;
 
+    // Number of triggers, interface triggers come first, then member triggers
+    size_t size() const { return m_ifaceTriggers.size() + m_memberTriggers.size(); }
     void emplace_back(IfaceTrigger&& p) { m_ifaceTriggers.emplace_back(std::move(p)); }
     IfaceTriggerVec::const_iterator begin() const { return m_ifaceTriggers.begin(); }
     IfaceTriggerVec::const_iterator end() const { return m_ifaceTriggers.end(); }
@@ -221,6 +230,7 @@ void transformForks(AstNetlist* const netlistp) VL_MT_DISABLED;
 void schedule(AstNetlist*) VL_MT_DISABLED;
 
 // Sub-steps
+void hoistClockGates(AstNetlist* netlistp) VL_MT_DISABLED;
 LogicByScope breakCycles(AstNetlist* netlistp,
                          const LogicByScope& combinationalLogic) VL_MT_DISABLED;
 LogicRegions partition(LogicByScope& clockedLogic, LogicByScope& combinationalLogic,
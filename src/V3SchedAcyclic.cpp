@@ -31,11 +31,16 @@
 // variables is converted into hybrid logic, with the back-edge driven
 // variables listed as explicit 'changed' sensitivities.
 //
+// Logic converted into hybrid logic is re-evaluated whenever a cut variable
+// it reads changes, so the edges of each variable are weighted with the
+// estimated cost of that re-evaluation, and the cheapest variables are cut.
+//
 //*************************************************************************
 
 #include "V3PchAstNoMT.h"  // VL_MT_DISABLED_CODE_UNIT
 
 #include "V3Graph.h"
+#include "V3InstrCount.h"
 #include "V3Sched.h"
 #include "V3SenTree.h"
 #include "V3SplitVar.h"
@@ -147,8 +152,8 @@ std::unique_ptr<Graph> buildGraph(const LogicByScope& lbs) {
             nodep->foreach([&](AstVarRef* refp) {
                 AstVarScope* const vscp = refp->varScopep();
                 SchedAcyclicVarVertex* const vvtxp = getVarVertex(vscp);
-                // We want to cut the narrowest signals
-                const int weight = vscp->width() / 8 + 1;
+                // Weighted properly by weightByCost, once cycles are known
+                const int weight = 1;
                 // If written, add logic -> var edge
                 if (refp->access().isWriteOrRW() && !refp->varp()->ignoreSchedWrite()
                     && !vscp->user2SetOnce())
@@ -205,6 +210,29 @@ void removeNonCyclic(Graph* graphp) {
     }
 }
 
+// Weight the edges of each variable with the cost of cutting it. Cutting a variable makes it an
+// explicit sensitivity of all logic reading it, which then needs re-evaluating when it changes.
+// We still want to cut the narrowest signals, as the change detection compares the whole value.
+void weightByCost(Graph* graphp) {
+    // Keep weights small enough that V3GraphAcyc can sum them without overflow
+    constexpr uint64_t maxWeight = 1 << 16;
+    std::unordered_map<const SchedAcyclicLogicVertex*, uint32_t> logicCost;
+    for (V3GraphVertex& vtx : graphp->vertices()) {
+        SchedAcyclicVarVertex* const vvtxp = vtx.cast<SchedAcyclicVarVertex>();
+        if (!vvtxp) continue;
+        uint64_t cost = vvtxp->vscp()->width() / 8 + 1;
+        for (const V3GraphEdge& edge : vvtxp->outEdges()) {
+            const SchedAcyclicLogicVertex* const lvtxp = edge.top()->as<SchedAcyclicLogicVertex>();
+            const auto pair = logicCost.emplace(lvtxp, 0);
+            if (pair.second) pair.first->second = V3InstrCount::count(lvtxp->logicp(), false);
+            cost += pair.first->second;
+        }
+        const int weight = static_cast<int>(std::min(cost, maxWeight));
+        for (V3GraphEdge& edge : vvtxp->inEdges()) edge.weight(weight);
+        for (V3GraphEdge& edge : vvtxp->outEdges()) edge.weight(weight);
+    }
+}
+
 // Has this VarVertex been cut? (any edges in or out has been cut)
 bool isCut(const SchedAcyclicVarVertex* vtxp) {
     for (const V3GraphEdge& edge : vtxp->inEdges()) {
@@ -416,6 +444,9 @@ LogicByScope breakCycles(AstNetlist* netlistp, const LogicByScope& combinational
     // Nothing to do if no cycles, yay!
     if (graphp->empty()) return LogicByScope{};
 
+    // Prefer cutting variables with cheap readers
+    weightByCost(graphp.get());
+
     // Dump for debug
     if (dumpGraphLevel() >= 6) graphp->dumpDotFilePrefixed("sched-comb-cycles");
 
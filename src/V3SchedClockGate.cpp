@@ -0,0 +1,184 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//*************************************************************************
+// DESCRIPTION: Verilator: Scheduling - hoist clock gate enables into triggers
+//
+// Code available from: https://verilator.org
+//
+//*************************************************************************
+//
+// Copyright 2025 by Wilson Snyder. This program is free software; you
+// can redistribute it and/or modify it under the terms of either the GNU
+// Lesser General Public License Version 3 or the Perl Artistic License
+// Version 2.0.
+// SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+//
+//*************************************************************************
+//
+// Recognize integrated clock gate (ICG) cells, that is a gated clock
+// 'gclk = clk & en', where 'en' can only change while 'clk' is low, either
+// because it is a latch transparent while 'clk' is low, or because it is
+// only written by logic sensitive to 'negedge clk'. Then 'posedge gclk' is
+// the same event as 'posedge clk iff en', so we rewrite the sensitivity to
+// the latter form.
+//
+// This removes the gated clock from the 'act' region, where it would
+// otherwise need an extra combinational evaluation and another trigger
+// computation round after every edge of 'clk', and the enable is tested in
+// the trigger computation directly. The domain's logic, including its NBA
+// commits, is then skipped with a single test while the gate is disabled.
+//
+//*************************************************************************
+
+#include "V3PchAstNoMT.h"  // VL_MT_DISABLED_CODE_UNIT
+
+#include "V3Sched.h"
+#include "V3Stats.h"
+
+VL_DEFINE_DEBUG_FUNCTIONS;
+
+namespace V3Sched {
+
+namespace {
+
+// A logic block writing a variable, and the AstActive it is under (nullptr if in an AstCFunc)
+using Writer = std::pair<AstActive*, AstNode*>;
+
+class ClockGateHoister final {
+    // STATE
+    std::unordered_map<const AstVarScope*, std::vector<Writer>> m_writers;
+    size_t m_statHoisted = 0;  // Number of sensitivities rewritten
+
+    // METHODS
+    // Variable that can only be changed by the logic in the design
+    static bool isInternalBit(const AstVarScope* vscp) {
+        const AstVar* const varp = vscp->varp();
+        if (varp->isPrimaryIO() || varp->isSigUserRWPublic() || varp->isForceable()) return false;
+        if (varp->isWrittenByDpi()) return false;
+        return vscp->width() == 1 && VN_IS(vscp->dtypep()->skipRefp(), BasicDType);
+    }
+
+    // If the only writer of 'vscp' is a combinational 'vscp = a & b',
+    // return the variables 'a' and 'b'.
+    std::pair<AstVarScope*, AstVarScope*> gatedClockInputs(const AstVarScope* vscp) const {
+        const auto it = m_writers.find(vscp);
+        if (it == m_writers.end() || it->second.size() != 1) return {nullptr, nullptr};
+        const Writer& writer = it->second.front();
+        if (!writer.first || !writer.first->sensesp()->hasCombo()) return {nullptr, nullptr};
+        const AstNodeAssign* assignp = VN_CAST(writer.second, AssignW);
+        if (const AstAlways* const alwaysp = VN_CAST(writer.second, Always)) {
+            if (alwaysp->stmtsp() && !alwaysp->stmtsp()->nextp()) {
+                assignp = VN_CAST(alwaysp->stmtsp(), Assign);
+            }
+        }
+        if (!assignp || !VN_IS(assignp->lhsp(), VarRef)) return {nullptr, nullptr};
+        const AstAnd* const andp = VN_CAST(assignp->rhsp(), And);
+        if (!andp) return {nullptr, nullptr};
+        const AstVarRef* const lhsp = VN_CAST(andp->lhsp(), VarRef);
+        const AstVarRef* const rhsp = VN_CAST(andp->rhsp(), VarRef);
+        if (!lhsp || !rhsp) return {nullptr, nullptr};
+        return {lhsp->varScopep(), rhsp->varScopep()};
+    }
+
+    // True if 'senTreep' is exactly 'negedge clkp'
+    static bool isNegedgeOf(const AstSenTree* senTreep, const AstVarScope* clkp) {
+        const AstSenItem* const itemp = senTreep->sensesp();
+        if (!itemp || itemp->nextp() || itemp->condp()) return false;
+        if (itemp->edgeType() != VEdgeType::ET_NEGEDGE) return false;
+        const AstVarRef* const refp = VN_CAST(itemp->sensp(), VarRef);
+        return refp && refp->varScopep() == clkp;
+    }
+
+    // True if 'exprp' is a reference to 'clkp', possibly negated (in which case set 'negated')
+    static bool isRefOf(const AstNodeExpr* exprp, const AstVarScope* clkp, bool& negated) {
+        negated = VN_IS(exprp, Not) || VN_IS(exprp, LogNot);
+        if (negated) exprp = VN_AS(exprp, NodeUniop)->lhsp();
+        const AstVarRef* const refp = VN_CAST(exprp, VarRef);
+        return refp && refp->varScopep() == clkp;
+    }
+
+    // True if 'enp' can only change while 'clkp' is low
+    bool isStableWhileHigh(const AstVarScope* enp, const AstVarScope* clkp) const {
+        const auto it = m_writers.find(enp);
+        if (it == m_writers.end()) return false;
+        const std::vector<Writer>& writers = it->second;
+        // Flop based: all writers are triggered by 'negedge clk'
+        if (std::all_of(writers.begin(), writers.end(), [&](const Writer& writer) {
+                return writer.first && isNegedgeOf(writer.first->sensesp(), clkp);
+            })) {
+            return true;
+        }
+        // Latch based: 'if (!clk) en = ...', as the only statement of a combinational process
+        if (writers.size() != 1) return false;
+        const Writer& writer = writers.front();
+        if (!writer.first || !writer.first->sensesp()->hasCombo()) return false;
+        const AstAlways* const alwaysp = VN_CAST(writer.second, Always);
+        if (!alwaysp || !alwaysp->stmtsp() || alwaysp->stmtsp()->nextp()) return false;
+        const AstIf* const ifp = VN_CAST(alwaysp->stmtsp(), If);
+        if (!ifp) return false;
+        bool negated = false;
+        if (!isRefOf(ifp->condp(), clkp, negated)) return false;
+        // Writes must only be in the branch taken while 'clk' is low
+        return negated ? !ifp->elsesp() : !ifp->thensp();
+    }
+
+    void hoist(AstSenItem* itemp) {
+        if (itemp->edgeType() != VEdgeType::ET_POSEDGE || itemp->condp()) return;
+        AstVarRef* refp = VN_CAST(itemp->sensp(), VarRef);
+        if (!refp || !isInternalBit(refp->varScopep())) return;
+        AstVarScope* clkp;
+        AstVarScope* enp;
+        std::tie(clkp, enp) = gatedClockInputs(refp->varScopep());
+        if (!clkp || !enp || clkp == enp) return;
+        if (!isStableWhileHigh(enp, clkp)) std::swap(clkp, enp);
+        if (!isStableWhileHigh(enp, clkp)) return;
+        if (!isInternalBit(enp) || clkp->width() != 1) return;
+        UINFO(4, "Hoisting clock gate enable " << enp->prettyNameQ() << " into " << itemp);
+        FileLine* const flp = itemp->fileline();
+        VL_DO_DANGLING(refp->unlinkFrBack()->deleteTree(), refp);
+        itemp->sensp(new AstVarRef{flp, clkp, VAccess::READ});
+        itemp->condp(new AstVarRef{flp, enp, VAccess::READ});
+        ++m_statHoisted;
+    }
+
+    // CONSTRUCTOR
+    explicit ClockGateHoister(AstNetlist* netlistp) {
+        const auto addWriters = [&](AstActive* activep, AstNode* nodep) {
+            nodep->foreach([&](const AstVarRef* refp) {
+                if (!refp->access().isWriteOrRW()) return;
+                std::vector<Writer>& writers = m_writers[refp->varScopep()];
+                if (writers.empty() || writers.back().second != nodep) {
+                    writers.emplace_back(activep, nodep);
+                }
+            });
+        };
+        // Gather writers of all variables. Static initializers happen before any edge occurs.
+        netlistp->foreach([&](AstActive* activep) {
+            if (activep->sensesp()->hasStatic()) return;
+            for (AstNode* nodep = activep->stmtsp(); nodep; nodep = nodep->nextp()) {
+                addWriters(activep, nodep);
+            }
+        });
+        // Functions might be called from anywhere
+        netlistp->foreach([&](AstCFunc* funcp) { addWriters(nullptr, funcp); });
+        // Rewrite sensitivities
+        for (AstSenTree* senTreep = netlistp->topScopep()->senTreesp(); senTreep;
+             senTreep = VN_AS(senTreep->nextp(), SenTree)) {
+            for (AstSenItem* itemp = senTreep->sensesp(); itemp;
+                 itemp = VN_AS(itemp->nextp(), SenItem)) {
+                hoist(itemp);
+            }
+        }
+    }
+    ~ClockGateHoister() {
+        V3Stats::addStat("Scheduling, clock gate enables hoisted", m_statHoisted);
+    }
+
+public:
+    static void apply(AstNetlist* netlistp) { ClockGateHoister{netlistp}; }
+};
+
+}  // namespace
+
+void hoistClockGates(AstNetlist* netlistp) { ClockGateHoister::apply(netlistp); }
+
+}  // namespace V3Sched
@@ -165,6 +165,12 @@ class SchedGraphBuilder final : public VNVisitor {
                 senItemp->sensp()->foreach([&](AstVarRef* refp) {
                     new V3GraphEdge{m_graphp, getVarVertex(refp->varScopep()), vtxp, 1};
                 });
+                // The 'iff' condition is evaluated with the trigger, so must be up to date too
+                if (AstNodeExpr* const condp = senItemp->condp()) {
+                    condp->foreach([&](AstVarRef* refp) {
+                        new V3GraphEdge{m_graphp, getVarVertex(refp->varScopep()), vtxp, 1};
+                    });
+                }
 
                 // Store back to hash map so we can find it next time
                 pair.first->second = vtxp;
@@ -37,6 +37,7 @@
 #include "V3PchAstNoMT.h"  // VL_MT_DISABLED_CODE_UNIT
 
 #include "V3Graph.h"
+#include "V3InstrCount.h"
 #include "V3Sched.h"
 
 VL_DEFINE_DEBUG_FUNCTIONS;
@@ -269,6 +270,19 @@ void propagateDrivingRegions(SchedReplicateVertex* vtxp) {
     vtxp->user(true);
 }
 
+// With -fshare-replicas, mark procedures large enough that a function call is cheap relative to
+// their body as shared. All copies are then emitted into functions of their own, which are
+// identical, so V3Combine retains only one of them.
+void markShared(AstNode* logicp) {
+    // Minimum instruction count of a shared procedure
+    constexpr uint32_t minSharedInstrs = 100;
+    if (!v3Global.opt.fShareReplicas()) return;
+    AstNodeProcedure* const procp = VN_CAST(logicp, NodeProcedure);
+    if (!procp || procp->isSuspendable()) return;
+    if (V3InstrCount::count(procp, false) < minSharedInstrs) return;
+    procp->setShared();
+}
+
 LogicReplicas replicate(Graph* graphp) {
     LogicReplicas result;
     for (V3GraphVertex& vtx : graphp->vertices()) {
@@ -279,6 +293,8 @@ LogicReplicas replicate(Graph* graphp) {
             const uint8_t targetRegions = lvtxp->drivingRegions() & ~lvtxp->assignedRegion();
             UASSERT(!lvtxp->senTreep()->hasClocked() || targetRegions == 0,
                     "replicating clocked logic");
+            // Mark before cloning, so the original and all replicas are marked
+            if (targetRegions) markShared(lvtxp->logicp());
             if (targetRegions & INPUT) replicateTo(result.m_ico);
             if (targetRegions & ACTIVE) replicateTo(result.m_act);
             if (targetRegions & NBA) replicateTo(result.m_nba);
@@ -27,6 +27,10 @@
 //         Set the corresponding trigger to 1
 //         If the write is done by an AssignDly, the trigger is also set by AssignDly
 //
+// Triggers are per interface member. Writes via a virtual interface, where the instance is not
+// known, and writes directly to a member of a known instance use separate triggers, so direct
+// writes to one instance do not wake up readers of the other instances.
+//
 //*************************************************************************
 
 #include "V3PchAstNoMT.h"  // VL_MT_DISABLED_CODE_UNIT
@@ -58,6 +62,7 @@ private:
     AstIface* m_trigAssignIfacep = nullptr;  // Interface type whose trigger is assigned
                                              // by m_trigAssignp
     AstVar* m_trigAssignMemberVarp;  // Member pointer whose trigger is assigned
+    bool m_trigAssignDirect = false;  // Whether direct member write trigger is assigned
     V3UniqueNames m_vifTriggerNames{"__VvifTrigger"};  // Unique names for virt iface
                                                        // triggers
     VirtIfaceTriggers m_triggers;  // Interfaces and corresponding trigger vars
@@ -78,7 +83,8 @@ private:
     }
     // For each write across a virtual interface boundary (member-level tracking)
     static void foreachWrittenVirtIfaceMember(
-        AstNode* const nodep, const std::function<void(AstVarRef*, AstIface*, AstVar*)>& onWrite) {
+        AstNode* const nodep,
+        const std::function<void(AstVarRef*, AstIface*, AstVar*, bool)>& onWrite) {
         nodep->foreach([&](AstVarRef* const refp) {
             if (refp->access().isReadOnly()) return;
             if (AstIfaceRefDType* const dtypep = VN_CAST(refp->varp()->dtypep(), IfaceRefDType)) {
@@ -86,12 +92,12 @@ private:
                     if (AstMemberSel* const memberSelp = VN_CAST(refp->firstAbovep(), MemberSel)) {
                         // Extract the member varp from the MemberSel node
                         AstVar* memberVarp = memberSelp->varp();
-                        onWrite(refp, dtypep->ifacep(), memberVarp);
+                        onWrite(refp, dtypep->ifacep(), memberVarp, false);
                     }
                 }
             } else if (AstIface* const ifacep = refp->varp()->sensIfacep()) {
                 AstVar* memberVarp = refp->varp();
-                onWrite(refp, ifacep, memberVarp);
+                onWrite(refp, ifacep, memberVarp, true);
             }
         });
     }
@@ -127,16 +133,17 @@ private:
 
     // Create trigger reference for a specific interface member
     AstVarRef* createVirtIfaceMemberTriggerRefp(FileLine* const flp, AstIface* ifacep,
-                                                const AstVar* memberVarp) {
+                                                const AstVar* memberVarp, bool direct) {
         // Check if we already have a trigger for this specific member
-        AstVarScope* existingTrigger = m_triggers.findMemberTrigger(ifacep, memberVarp);
+        AstVarScope* existingTrigger = m_triggers.findMemberTrigger(ifacep, memberVarp, direct);
         if (!existingTrigger) {
             AstScope* const scopeTopp = m_netlistp->topScopep()->scopep();
             // Create a unique name for this member trigger
-            const std::string triggerName
-                = m_vifTriggerNames.get(ifacep) + "_Vtrigm_" + memberVarp->name();
+            const std::string triggerName = m_vifTriggerNames.get(ifacep)
+                                            + (direct ? "_Vtrigd_" : "_Vtrigm_")
+                                            + memberVarp->name();
             AstVarScope* const vscp = scopeTopp->createTemp(triggerName, 1);
-            m_triggers.addMemberTrigger(ifacep, memberVarp, vscp);
+            m_triggers.addMemberTrigger(ifacep, memberVarp, direct, vscp);
             existingTrigger = vscp;
         }
         return new AstVarRef{flp, existingTrigger, VAccess::WRITE};
@@ -149,6 +156,7 @@ private:
         VL_RESTORER(m_trigAssignIfacep);
         m_trigAssignIfacep = nullptr;
         VL_RESTORER(m_trigAssignMemberVarp);
+        VL_RESTORER(m_trigAssignDirect);
         m_trigAssignMemberVarp = nullptr;
         iterateChildren(nodep);
     }
@@ -158,6 +166,7 @@ private:
         VL_RESTORER(m_trigAssignIfacep);
         m_trigAssignIfacep = nullptr;
         VL_RESTORER(m_trigAssignMemberVarp);
+        VL_RESTORER(m_trigAssignDirect);
         m_trigAssignMemberVarp = nullptr;
         iterateChildren(nodep);
     }
@@ -184,12 +193,14 @@ private:
             VL_RESTORER(m_trigAssignp);
             VL_RESTORER(m_trigAssignIfacep);
             VL_RESTORER(m_trigAssignMemberVarp);
+            VL_RESTORER(m_trigAssignDirect);
             iterateAndNextNull(nodep->thensp());
         }
         {
             VL_RESTORER(m_trigAssignp);
             VL_RESTORER(m_trigAssignIfacep);
             VL_RESTORER(m_trigAssignMemberVarp);
+            VL_RESTORER(m_trigAssignDirect);
             iterateAndNextNull(nodep->elsesp());
         }
         if (v3Global.usesTiming()) {
@@ -208,6 +219,7 @@ private:
             VL_RESTORER(m_trigAssignp);
             VL_RESTORER(m_trigAssignIfacep);
             VL_RESTORER(m_trigAssignMemberVarp);
+            VL_RESTORER(m_trigAssignDirect);
             iterateAndNextNull(nodep->stmtsp());
         }
         if (v3Global.usesTiming()) {
@@ -222,6 +234,7 @@ private:
             VL_RESTORER(m_trigAssignp);
             VL_RESTORER(m_trigAssignIfacep);
             VL_RESTORER(m_trigAssignMemberVarp);
+            VL_RESTORER(m_trigAssignDirect);
             iterateChildren(nodep);
         }
         if (v3Global.usesTiming()) {
@@ -241,18 +254,20 @@ private:
         }
         FileLine* const flp = nodep->fileline();
 
-        foreachWrittenVirtIfaceMember(nodep, [&](AstVarRef*, AstIface* ifacep,
-                                                 AstVar* memberVarp) {
-            if (ifacep != m_trigAssignIfacep || memberVarp != m_trigAssignMemberVarp) {
+        foreachWrittenVirtIfaceMember(nodep, [&](AstVarRef*, AstIface* ifacep, AstVar* memberVarp,
+                                                 bool direct) {
+            if (ifacep != m_trigAssignIfacep || memberVarp != m_trigAssignMemberVarp
+                || direct != m_trigAssignDirect) {
                 // Write to different interface member than before - need new trigger assignment
                 m_trigAssignIfacep = ifacep;
                 m_trigAssignMemberVarp = memberVarp;
+                m_trigAssignDirect = direct;
                 m_trigAssignp = nullptr;
             }
             if (!m_trigAssignp) {
-                m_trigAssignp
-                    = new AstAssign{flp, createVirtIfaceMemberTriggerRefp(flp, ifacep, memberVarp),
-                                    new AstConst{flp, AstConst::BitTrue{}}};
+                m_trigAssignp = new AstAssign{
+                    flp, createVirtIfaceMemberTriggerRefp(flp, ifacep, memberVarp, direct),
+                    new AstConst{flp, AstConst::BitTrue{}}};
                 nodep->addNextHere(m_trigAssignp);
             }
         });
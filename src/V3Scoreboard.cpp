@@ -21,7 +21,7 @@
 class ScoreboardTestElem;
 
 struct Key final {
-    // Node: Structure layout chosen to minimize padding in PairingHeao<*>::Node
+    // Node: Structure layout chosen to minimize padding in V3Scoreboard<*>::Node
     uint64_t m_id;  // Unique ID part of edge score
     uint32_t m_score;  // Score part of ID
     bool operator<(const Key& other) const {
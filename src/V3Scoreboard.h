@@ -21,34 +21,63 @@
 #include "verilatedos.h"
 
 #include "V3Error.h"
-#include "V3PairingHeap.h"
+
+#include <algorithm>
+#include <vector>
 
 //===============================================================================================
 // V3Scoreboard is essentially a heap that can be hinted that some elements have changed keys, at
-// which points those elements will be deferred as 'unknown' until the next 'rescore' call. We
-// largely reuse the implementation of the slightly more generic PairingHeap, but we do rely on the
-// internal structure of the PairingHeap so changing that class requires changing this.
+// which points those elements will be deferred as 'unknown' until the next 'rescore' call.
+//
+// The known elements are kept in a 4-ary max-heap over a contiguous vector. Each heap entry holds
+// a copy of the element's key next to the element pointer, so sifting compares keys within the
+// vector rather than chasing pointers to the elements, which are scattered over the heap. The
+// unknown elements are kept in a plain vector.
 //
-// For efficiency, the elements themselves must be the heap nodes, by deriving them from
-// V3Scoreboard<T_Elem, T_Key>::Node. This also means a single element can only be associated with
-// a single scoreboard.
+// Elements must derive from V3Scoreboard<T_Elem, T_Key>::Node, which holds the key and the
+// element's position in the scoreboard. This also means a single element can only be associated
+// with a single scoreboard. Keys must be unique, so the best element is always well defined. The
+// key of an element in the known heap must not change, other than immediately before a
+// 'hintScoreChanged' or 'remove' call.
 
 template <typename T_Elem, typename T_Key>
 class V3Scoreboard final {
+public:
     // TYPES
-    using Heap = PairingHeap<T_Key>;
+    class Node VL_NOT_FINAL {
+        friend class V3Scoreboard;
+        // m_index of an element not in a scoreboard
+        static constexpr uint32_t ABSENT = 0xffffffffU;
+        // Flag in m_index of an element on the unknown list
+        static constexpr uint32_t UNKNOWN = 0x80000000U;
 
-public:
-    using Node = typename Heap::Node;
+    public:
+        T_Key m_key;  // The key in the scoreboard
+
+    private:
+        uint32_t m_index = ABSENT;  // Index in the known heap, or in unknown list if UNKNOWN
+
+    public:
+        // CONSTRUCTOR
+        explicit Node() = default;
+        VL_UNCOPYABLE(Node);
+
+        // METHODS
+        const T_Key& key() const { return m_key; }
+    };
 
 private:
-    using Link = typename Heap::Link;
+    struct Entry final {
+        T_Key m_key;  // Copy of the element's key
+        Node* m_nodep;  // The element
+    };
+    static constexpr size_t ARITY = 4;  // Children per heap entry
 
     // Note: T_Elem is incomplete here, so we cannot assert 'std::is_base_of<Node, T_Elem>::value'
 
     // MEMBERS
-    Heap m_known;  // The heap of entries with known scores
-    Link m_unknown;  // List of entries with unknown scores
+    std::vector<Entry> m_known;  // The heap of entries with known scores
+    std::vector<Node*> m_unknown;  // Entries with unknown scores
 
 public:
     // CONSTRUCTORS
@@ -58,13 +87,69 @@ public:
 private:
     VL_UNCOPYABLE(V3Scoreboard);
 
-    // METHODSs
-    void addUnknown(T_Elem* nodep) {
-        // Just prepend it to the list of unknown entries
-        nodep->m_next.link(m_unknown.unlink());
-        m_unknown.linkNonNull(nodep);
-        // We mark nodes on the unknown list by making their child pointer point to themselves
-        nodep->m_kids.m_ptr = nodep;
+    // METHODS
+    void place(size_t index, const Entry& entry) {
+        m_known[index] = entry;
+        entry.m_nodep->m_index = static_cast<uint32_t>(index);
+    }
+    // Put 'entry' at 'index' or above it
+    void siftUp(size_t index, const Entry& entry) {
+        while (index) {
+            const size_t parent = (index - 1) / ARITY;
+            if (!(m_known[parent].m_key < entry.m_key)) break;
+            place(index, m_known[parent]);
+            index = parent;
+        }
+        place(index, entry);
+    }
+    // Put 'entry' at 'index' or below it
+    void siftDown(size_t index, const Entry& entry) {
+        const size_t size = m_known.size();
+        while (true) {
+            const size_t first = index * ARITY + 1;
+            if (first >= size) break;
+            const size_t last = std::min(first + ARITY, size);
+            size_t maxChild = first;
+            for (size_t child = first + 1; child < last; ++child) {
+                if (m_known[maxChild].m_key < m_known[child].m_key) maxChild = child;
+            }
+            if (!(entry.m_key < m_known[maxChild].m_key)) break;
+            place(index, m_known[maxChild]);
+            index = maxChild;
+        }
+        place(index, entry);
+    }
+    void insertKnown(Node* nodep) {
+        m_known.emplace_back();
+        siftUp(m_known.size() - 1, Entry{nodep->m_key, nodep});
+    }
+    void removeKnown(Node* nodep) {
+        const size_t index = nodep->m_index;
+        nodep->m_index = Node::ABSENT;
+        const Entry lastEntry = m_known.back();
+        m_known.pop_back();
+        if (index == m_known.size()) return;  // Removed the last entry
+        // Move the last entry into the hole
+        if (index && m_known[(index - 1) / ARITY].m_key < lastEntry.m_key) {
+            siftUp(index, lastEntry);
+        } else {
+            siftDown(index, lastEntry);
+        }
+    }
+    void addUnknown(Node* nodep) {
+        UDEBUGONLY(UASSERT(m_unknown.size() < Node::UNKNOWN, "Too many elements"););
+        nodep->m_index = Node::UNKNOWN | static_cast<uint32_t>(m_unknown.size());
+        m_unknown.push_back(nodep);
+    }
+    void removeUnknown(Node* nodep) {
+        const size_t index = nodep->m_index & ~Node::UNKNOWN;
+        nodep->m_index = Node::ABSENT;
+        Node* const lastp = m_unknown.back();
+        m_unknown.pop_back();
+        if (index == m_unknown.size()) return;  // Removed the last entry
+        // Move the last entry into the hole
+        m_unknown[index] = lastp;
+        lastp->m_index = Node::UNKNOWN | static_cast<uint32_t>(index);
     }
 
 public:
@@ -73,7 +158,7 @@ public:
     // in this scoreboard. Furthermore, this method is only valid if the element can only possibly
     // be in this scoreboard. That is: if the element might be in another scoreboard, the behaviour
     // of this method is undefined.
-    static bool contains(const T_Elem* nodep) { return nodep->m_ownerpp; }
+    static bool contains(const T_Elem* nodep) { return nodep->m_index != Node::ABSENT; }
 
     // Add an element to the scoreboard. This will not be returned before the next 'rescore' call.
     void add(T_Elem* nodep) {
@@ -85,54 +170,52 @@ public:
 
     // Remove element from scoreboard.
     void remove(T_Elem* nodep) {
-        if (nodep->m_kids.m_ptr == nodep) {
-            // Node is on the unknown list, replace with next
-            nodep->replaceWith(nodep->m_next.unlink());
-            return;
+        if (needsRescore(nodep)) {
+            removeUnknown(nodep);
+        } else {
+            removeKnown(nodep);
         }
-        // Node is in the known heap, remove it
-        m_known.remove(nodep);
     }
 
     // Get the known element with the highest score (as we are using a max-heap), or nullptr if
     // there are no elements with known entries. This does not automatically 'rescore'. The client
     // must call 'rescore' appropriately to ensure all elements in the scoreboard are reflected in
     // the result of this method.
-    T_Elem* best() const { return T_Elem::heapNodeToElem(m_known.max()); }
+    T_Elem* best() const {
+        if (m_known.empty()) return nullptr;
+        return T_Elem::heapNodeToElem(m_known.front().m_nodep);
+    }
 
     // Tell the scoreboard that this element's score may have changed. At the time of this call,
     // the element's score becomes 'unknown' to the scoreboard. Unknown elements will not be
     // returned by 'best until the next call to 'rescore'.
     void hintScoreChanged(T_Elem* nodep) {
         // If it's already in the unknown list, then nothing to do
-        if (nodep->m_kids.m_ptr == nodep) return;
+        if (needsRescore(nodep)) return;
         // Otherwise it was in the heap, remove it
-        m_known.remove(nodep);
-        // Prepend it to the unknown list
+        removeKnown(nodep);
+        // Add it to the unknown list
         addUnknown(nodep);
     }
 
     // True if we have elements with unknown score
-    bool needsRescore() const { return m_unknown; }
+    bool needsRescore() const { return !m_unknown.empty(); }
 
     // True if the element's score is unknown, false otherwise.
-    static bool needsRescore(const T_Elem* nodep) { return nodep->m_kids.m_ptr == nodep; }
+    static bool needsRescore(const T_Elem* nodep) {
+        return nodep->m_index != Node::ABSENT && (nodep->m_index & Node::UNKNOWN);
+    }
 
     // For each element whose score is unknown, recompute the score and add to the known heap
     void rescore() {
-        // Rescore and insert all unknown elements
-        for (Node *nodep = m_unknown.unlink(), *nextp; nodep; nodep = nextp) {
-            // Pick up next
-            nextp = nodep->m_next.ptr();
-            // Reset pointers
-            nodep->m_next.m_ptr = nullptr;
-            nodep->m_kids.m_ptr = nullptr;
-            nodep->m_ownerpp = nullptr;
+        m_known.reserve(m_known.size() + m_unknown.size());
+        for (Node* const nodep : m_unknown) {
             // Re-compute the score of the element
             T_Elem::heapNodeToElem(nodep)->rescore();
             // re-insert into the heap
-            m_known.insert(nodep);
+            insertKnown(nodep);
         }
+        m_unknown.clear();
     }
 };
 
@@ -38,6 +38,7 @@
 #include "V3Ast.h"
 #include "V3AstUserAllocator.h"
 #include "V3Error.h"
+#include "V3Stats.h"
 #include "V3Task.h"
 #include "V3Width.h"
 
@@ -46,6 +47,7 @@
 #include <stack>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 //============================================================================
@@ -142,6 +144,10 @@ private:
     std::unordered_map<const AstNodeDType*, ConstAllocator> m_constps;
     size_t m_constGeneration = 0;
     std::vector<SimStackNode*> m_callStack;  ///< Call stack for verbose error messages
+    // Memoization of constant function calls, see visit(AstFuncRef)
+    std::unordered_map<const AstNodeFTask*, bool> m_funcMemoizable;  // Function has no state
+    std::unordered_map<string, AstConst*> m_funcResults;  // Call key -> returned value
+    size_t m_statFuncMemoized = 0;  // Number of calls answered from m_funcResults
 
     // Cleanup
     // V3Numbers that represents strings are a bit special and the API for
@@ -253,6 +259,53 @@ private:
         return m_constps[nodep->dtypep()].allocate(m_constGeneration, nodep);
     }
 
+    // True if the result of calling 'funcp' depends only on its arguments, and the call has no
+    // other effect, so calls with the same arguments can reuse an earlier result
+    bool isMemoizable(AstNodeFTask* funcp) {
+        const auto it = m_funcMemoizable.find(funcp);
+        if (it != m_funcMemoizable.end()) return it->second;
+        m_funcMemoizable.emplace(funcp, false);  // Until known, e.g. if recursive
+        bool memoizable = !funcp->exists([](const AstNode* nodep) {
+            return VN_IS(nodep, Display) || VN_IS(nodep, Finish) || VN_IS(nodep, Stop);
+        });
+        // Locals keep their values across calls, so must be written before they are read
+        std::unordered_set<const AstVar*> localps;
+        funcp->foreach([&](const AstVar* varp) {
+            if (!varp->isIO() && varp != funcp->fvarp()) localps.emplace(varp);
+        });
+        funcp->foreach([&](AstNode* nodep) {
+            if (!memoizable) return;
+            if (const AstVarRef* const refp = VN_CAST(nodep, VarRef)) {
+                if (localps.erase(refp->varp())) {
+                    if (!refp->access().isWriteOnly()) memoizable = false;
+                } else if (refp->access().isWriteOrRW() && !refp->varp()->isFuncLocal()) {
+                    memoizable = false;
+                }
+            } else if (const AstNodeFTaskRef* const refp = VN_CAST(nodep, NodeFTaskRef)) {
+                if (!refp->taskp() || !isMemoizable(refp->taskp())) memoizable = false;
+            }
+        });
+        m_funcMemoizable[funcp] = memoizable;
+        return memoizable;
+    }
+    // Key identifying a call by its function and argument values, or empty if any argument
+    // is not a simple constant
+    string funcMemoKey(const AstNodeFTask* funcp, const V3TaskConnects& tconnects) {
+        string key = cvtToHex(funcp);
+        for (const auto& pair : tconnects) {
+            AstNodeExpr* const pinp = pair.second->exprp();
+            if (!pinp) {
+                key += ";-";
+                continue;
+            }
+            const AstConst* const constp = fetchConstNull(pinp);
+            if (!constp) return "";
+            const string value = constp->num().ascii();
+            key += ";" + cvtToStr(value.size()) + ":" + value;
+        }
+        return key;
+    }
+
 public:
     void newValue(AstNode* nodep, const AstNodeExpr* valuep) {
         if (const AstConst* const constp = VN_CAST(valuep, Const)) {
@@ -1109,6 +1162,19 @@ private:
                 iterateConst(pinp);
             }
         }
+        // Constant functions generating tables often make many identical calls,
+        // so reuse the result of an earlier call with the same arguments
+        string memoKey;
+        if (!m_checkOnly && optimizable() && isMemoizable(funcp)) {
+            memoKey = funcMemoKey(funcp, tconnects);
+            const auto it = m_funcResults.find(memoKey);
+            if (it != m_funcResults.end()) {
+                UINFO(5, "   FUNCREF memoized " << it->second);
+                ++m_statFuncMemoized;
+                newValue(nodep, it->second);
+                return;
+            }
+        }
         for (V3TaskConnects::iterator it = tconnects.begin(); it != tconnects.end(); ++it) {
             AstVar* const portp = it->first;
             AstNode* const pinp = it->second->exprp();
@@ -1138,6 +1204,13 @@ private:
             // Grab return value from output variable (if it's a function)
             UASSERT_OBJ(funcp->fvarp(), nodep, "Function reference points at non-function");
             newValue(nodep, fetchValue(funcp->fvarp()));
+            if (!memoKey.empty()) {
+                if (AstConst* const constp = fetchConstNull(funcp->fvarp())) {
+                    AstConst* const resultp = constp->cloneTree(false);
+                    m_reclaimValuesp.push_back(resultp);
+                    m_funcResults.emplace(memoKey, resultp);
+                }
+            }
         }
     }
 
@@ -1313,6 +1386,10 @@ public:
         mainGuts(nodep);
     }
     ~SimulateVisitor() override {
+        if (m_statFuncMemoized) {
+            V3Stats::addStatSum("Optimizations, Constant function calls memoized",
+                                m_statFuncMemoized);
+        }
         m_constps.clear();
         for (AstNode* ip : m_reclaimValuesp) delete ip;
         m_reclaimValuesp.clear();
@@ -56,6 +56,11 @@
 // better. Later modules (V3Gate, V3Order) run faster if they aren't
 // handling enormous blocks with long lists of inputs and outputs.
 //
+// With -fsplit-temps and --threads, a combinational block may also be split
+// at temporaries, variables written by one top level assignment and only
+// read after it, when that shortens the longest dependent chain within the
+// block, so the partitioner can run the pieces in parallel.
+//
 // Furthermore, the optional reorder routine can optimize this:
 //      NODEASSIGN/NODEIF/WHILE
 //              S1: ASSIGN {v1} <= 0.   // Duplicate of below
@@ -84,6 +89,7 @@
 #include "V3Graph.h"
 #include "V3Stats.h"
 
+#include <functional>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -847,11 +853,22 @@ class SplitVisitor final : public SplitReorderBaseVisitor {
 
     // AstNodeIf* whose condition we're currently visiting
     const AstNode* m_curIfConditional = nullptr;
+    // Split combinational blocks at temporaries, -fsplit-temps
+    const bool m_splitTemps = v3Global.opt.fSplitTemps() && v3Global.opt.threads() > 1;
+    bool m_inCombo = false;  // Under a combinational only AstActive
+    std::vector<SplitVarStdVertex*> m_tempVtxps;  // Temporaries pruned in current block
+    std::unordered_set<const AstVarScope*> m_multiDriven;  // Written by several logic blocks
     VDouble0 m_statSplits;  // Statistic tracking
+    VDouble0 m_statSplitTemps;  // Statistic tracking
+
+    // Smallest node count of the largest split block for -fsplit-temps; below this
+    // the partitioner would merge the pieces again anyway
+    static constexpr uint32_t SPLIT_TEMPS_MIN_COST = 50;
 
     // CONSTRUCTORS
 public:
     explicit SplitVisitor(AstNetlist* nodep) {
+        if (m_splitTemps) findMultiDriven(nodep);
         iterate(nodep);
 
         // Splice newly-split blocks into the tree. Remove placeholders
@@ -870,7 +887,10 @@ public:
         }
     }
 
-    ~SplitVisitor() override { V3Stats::addStat("Optimizations, Split always", m_statSplits); }
+    ~SplitVisitor() override {
+        V3Stats::addStat("Optimizations, Split always", m_statSplits);
+        V3Stats::addStat("Optimizations, Split always at temporaries", m_statSplitTemps);
+    }
 
     // METHODS
 protected:
@@ -884,7 +904,145 @@ protected:
         }
     }
 
-    void colorAlwaysGraph() {
+    void findMultiDriven(AstNetlist* nodep) {
+        // Another driver may change a temporary between split blocks, so never split these
+        std::unordered_map<const AstVarScope*, const AstNode*> writers;
+        nodep->foreach([&](AstActive* activep) {
+            for (AstNode* logicp = activep->stmtsp(); logicp; logicp = logicp->nextp()) {
+                logicp->foreach([&](const AstVarRef* refp) {
+                    if (!refp->access().isWriteOrRW()) return;
+                    const auto pair = writers.emplace(refp->varScopep(), logicp);
+                    if (pair.first->second != logicp) m_multiDriven.emplace(refp->varScopep());
+                });
+            }
+        });
+    }
+
+    void pruneDepsOnTemps(AstAlways* nodep) {
+        // In a combinational block, a variable assigned as a whole by a single top
+        // level statement, and only read by later statements, is a temporary, like
+        // the output of a continuous assignment. Prune edges on it, so the writer
+        // and readers may be split; V3Order will then order the writer first.
+        m_tempVtxps.clear();
+        std::unordered_map<const V3GraphVertex*, int> positions;  // Top statement number
+        std::unordered_set<const V3GraphVertex*> topVtxps;  // Top level statements
+        int pos = 0;
+        for (AstNode* stmtp = nodep->stmtsp(); stmtp; stmtp = stmtp->nextp()) {
+            ++pos;
+            topVtxps.emplace(reinterpret_cast<SplitLogicVertex*>(stmtp->user3p()));
+            stmtp->foreach([&](AstNode* itemp) {
+                if (itemp->user3p()) {
+                    positions.emplace(reinterpret_cast<SplitLogicVertex*>(itemp->user3p()), pos);
+                }
+            });
+        }
+        for (V3GraphVertex& vertex : m_graph.vertices()) {
+            SplitVarStdVertex* const vstdp = vertex.cast<SplitVarStdVertex>();
+            if (!vstdp || !vstdp->outSize1()) continue;  // Not a single writer
+            const AstVarScope* const vscp = VN_AS(vstdp->nodep(), VarScope);
+            if (vscp->user2p()) continue;  // Also has delayed assignments
+            if (m_multiDriven.count(vscp) || vscp->varp()->isForceable()) continue;
+            const V3GraphVertex* const writerp = vstdp->outEdges().frontp()->top();
+            if (!topVtxps.count(writerp)) continue;
+            const AstAssign* const assignp
+                = VN_CAST(static_cast<const SplitLogicVertex*>(writerp)->nodep(), Assign);
+            const AstVarRef* const lhsp = assignp ? VN_CAST(assignp->lhsp(), VarRef) : nullptr;
+            if (!lhsp || lhsp->varScopep() != vscp) continue;  // Partial or other write
+            const int writerPos = positions.at(writerp);
+            bool laterReads = true;
+            for (const V3GraphEdge& edge : vstdp->inEdges()) {
+                const auto it = positions.find(edge.fromp());
+                if (it == positions.end() || it->second <= writerPos) {
+                    laterReads = false;
+                    break;
+                }
+            }
+            if (!laterReads) continue;
+            UINFO(9, "Will prune deps on temporary " << vscp);
+            m_tempVtxps.push_back(vstdp);
+            for (V3GraphEdge& edge : vstdp->inEdges()) {
+                static_cast<SplitEdge&>(edge).setIgnoreThisStep();
+            }
+            for (V3GraphEdge& edge : vstdp->outEdges()) {
+                static_cast<SplitEdge&>(edge).setIgnoreThisStep();
+            }
+        }
+    }
+
+    std::unordered_map<uint32_t, uint32_t> colorCosts() {
+        // Node count of the statements of each color
+        std::unordered_map<uint32_t, uint32_t> costs;
+        for (V3GraphVertex& vertex : m_graph.vertices()) {
+            const SplitLogicVertex* const logicp = vertex.cast<SplitLogicVertex>();
+            if (!logicp || VN_IS(logicp->nodep(), NodeIf)) continue;
+            costs[logicp->color()] += logicp->nodep()->nodeCount();
+        }
+        return costs;
+    }
+
+    uint32_t tempsCriticalPath(AstAlways* nodep) {
+        // Cost of the longest chain of colors depending on each other through the pruned
+        // temporaries, or 0 if they would depend on each other in a cycle
+        const IfColorVisitor ifColor{nodep};
+        std::unordered_map<uint32_t, ColorSet> succs;
+        for (SplitVarStdVertex* const vstdp : m_tempVtxps) {
+            const uint32_t writerColor = vstdp->outEdges().frontp()->top()->color();
+            for (const V3GraphEdge& edge : vstdp->inEdges()) {
+                const SplitLogicVertex* const readerp = edge.fromp()->as<SplitLogicVertex>();
+                // A split 'if' is cloned into all colors under it, with its condition
+                if (AstNodeIf* const ifp = VN_CAST(readerp->nodep(), NodeIf)) {
+                    for (const uint32_t color : ifColor.colors(ifp)) {
+                        if (color != writerColor) succs[writerColor].insert(color);
+                    }
+                } else if (readerp->color() != writerColor) {
+                    succs[writerColor].insert(readerp->color());
+                }
+            }
+        }
+        const std::unordered_map<uint32_t, uint32_t> costs = colorCosts();
+        std::unordered_map<uint32_t, uint32_t> paths;  // Path from color, 0 = being visited
+        bool cyclic = false;
+        const std::function<uint32_t(uint32_t)> pathFrom = [&](uint32_t color) -> uint32_t {
+            const auto pair = paths.emplace(color, 0);
+            if (!pair.second) {
+                if (!pair.first->second) cyclic = true;
+                return pair.first->second;
+            }
+            uint32_t succPath = 0;
+            const auto it = succs.find(color);
+            if (it != succs.end()) {
+                for (const uint32_t succ : it->second) {
+                    succPath = std::max(succPath, pathFrom(succ));
+                }
+            }
+            const auto costIt = costs.find(color);
+            const uint32_t path = succPath + (costIt != costs.end() ? costIt->second : 0) + 1;
+            paths[color] = path;
+            return path;
+        };
+        uint32_t critical = 0;
+        for (const auto& pair : costs) critical = std::max(critical, pathFrom(pair.first));
+        return cyclic ? 0 : critical;
+    }
+
+    void colorAlwaysTemps(AstAlways* nodep) {
+        // With -fsplit-temps, recolor splitting also at temporaries, if that shortens the
+        // critical path, that is the largest block of the plain split
+        uint32_t largest = 0;
+        for (const auto& pair : colorCosts()) largest = std::max(largest, pair.second + 1);
+        if (largest < SPLIT_TEMPS_MIN_COST) return;
+        colorAlwaysGraph(nodep, true);
+        if (m_tempVtxps.empty()) return;  // Same coloring as before
+        const uint32_t critical = tempsCriticalPath(nodep);
+        if (critical && critical < largest) {
+            UINFO(5, "Split at temporaries, critical path " << largest << " -> " << critical);
+            ++m_statSplitTemps;
+            return;
+        }
+        colorAlwaysGraph(nodep, false);
+    }
+
+    void colorAlwaysGraph(AstAlways* nodep, bool splitTemps) {
         // Color the graph to indicate subsets, each of which
         // we can split into its own always block.
         m_graph.removeRedundantEdgesMax(&V3GraphEdge::followAlwaysTrue);
@@ -896,6 +1054,7 @@ protected:
         // must be kept together.
         SplitEdge::incrementStep();
         pruneDepsOnInputs();
+        if (splitTemps) pruneDepsOnTemps(nodep);
 
         // For any 'if' node whose deps have all been pruned
         // (meaning, its conditional expression only looks at primary
@@ -963,7 +1122,8 @@ protected:
         // Look across the entire tree of if/else blocks in the always,
         // and color regions that must be kept together.
         UINFO(5, "SplitVisitor @ " << nodep);
-        colorAlwaysGraph();
+        colorAlwaysGraph(nodep, false);
+        if (m_splitTemps && m_inCombo) colorAlwaysTemps(nodep);
 
         // Map each AstNodeIf to the set of colors (split always blocks)
         // it must participate in. Also find the whole set of colors.
@@ -981,6 +1141,11 @@ protected:
             emitSplit.go();
         }
     }
+    void visit(AstActive* nodep) override {
+        VL_RESTORER(m_inCombo);
+        m_inCombo = nodep->hasCombo() && !nodep->hasClocked();
+        iterateChildren(nodep);
+    }
     void visit(AstNodeIf* nodep) override {
         UINFO(4, "     IF " << nodep);
         if (!nodep->condp()->isPure()) m_noReorderWhy = "Impure IF condition";
@@ -118,7 +118,10 @@
 #include "V3Stats.h"
 #include "V3UniqueNames.h"
 
+#include <map>
 #include <set>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 VL_DEFINE_DEBUG_FUNCTIONS;
@@ -406,9 +409,16 @@ class SplitUnpackedVarVisitor final : public VNVisitor, public SplitVarImpl {
     AstNode* m_contextp = nullptr;
     const AstNodeFTask* m_inFTaskp = nullptr;
     size_t m_numSplit = 0;
+    size_t m_numSplitAuto = 0;  // Number of arrays split automatically
     // List for SplitPackedVarVisitor
     SplitVarRefs m_forPackedSplit;
     V3UniqueNames m_tempNames;  // For generating unique temporary variable names
+    std::unordered_set<const AstVar*> m_autoVarps;  // Arrays in module split automatically
+    std::unordered_set<const AstVar*> m_xrefVarps;  // Referenced hierarchically
+
+    // Largest array, and most elements per module -fvar-split-arrays splits
+    static constexpr int AUTO_MAX_ELEMENTS = 64;
+    static constexpr int AUTO_MODULE_BUDGET = 1024;
 
     static AstVarRef* isTargetVref(AstNode* nodep) {
         if (AstVarRef* const refp = VN_CAST(nodep, VarRef)) {
@@ -455,6 +465,88 @@ class SplitUnpackedVarVisitor final : public VNVisitor, public SplitVarImpl {
         return refp;
     }
 
+    // With -fvar-split-arrays, find arrays that are likely false dependency sources, and mark
+    // them as if they had a split_var metacomment. Only arrays that are safe to split, i.e.
+    // only accessed as constant elements from logic blocks, are considered.
+    void findAutoCandidates(AstNodeModule* modp) {
+        struct ArrayInfo final {
+            bool ineligible = false;
+            // Per logic block, the elements read and written
+            std::map<const AstNode*, std::pair<std::set<int>, std::set<int>>> blocks;
+        };
+        std::unordered_map<const AstVar*, ArrayInfo> infos;
+        std::vector<AstVar*> varps;  // In declaration order
+        for (AstNode* itemp = modp->stmtsp(); itemp; itemp = itemp->nextp()) {
+            AstVar* const varp = VN_CAST(itemp, Var);
+            if (!varp || varp->attrSplitVar() || varp->isIO() || m_xrefVarps.count(varp)) {
+                continue;
+            }
+            if (cannotSplitReason(varp)) continue;
+            const AstUnpackArrayDType* const dtypep
+                = VN_AS(varp->dtypep()->skipRefp(), UnpackArrayDType);
+            if (VN_IS(dtypep->subDTypep()->skipRefp(), UnpackArrayDType)) continue;
+            if (dtypep->elementsConst() > AUTO_MAX_ELEMENTS) continue;
+            infos.emplace(varp, ArrayInfo{});
+            varps.push_back(varp);
+        }
+        if (varps.empty()) return;
+
+        for (AstNode* itemp = modp->stmtsp(); itemp; itemp = itemp->nextp()) {
+            const bool isLogic = VN_IS(itemp, Always) || VN_IS(itemp, AssignW)
+                                 || VN_IS(itemp, Initial);
+            // Elements passed to tasks may be written by reference
+            itemp->foreach([&](const AstNodeFTaskRef* callp) {
+                callp->foreach([&](const AstVarRef* refp) {
+                    const auto it = infos.find(refp->varp());
+                    if (it != infos.end()) it->second.ineligible = true;
+                });
+            });
+            itemp->foreach([&](const AstVarRef* refp) {
+                const auto it = infos.find(refp->varp());
+                if (it == infos.end()) return;
+                ArrayInfo& info = it->second;
+                const AstArraySel* const selp = VN_CAST(refp->backp(), ArraySel);
+                const AstConst* const indexp
+                    = selp && selp->fromp() == refp ? VN_CAST(selp->bitp(), Const) : nullptr;
+                if (!isLogic || !indexp || indexp->toSInt() < 0
+                    || indexp->toSInt() >= outerMostSizeOfUnpackedArray(refp->varp())) {
+                    info.ineligible = true;
+                    return;
+                }
+                auto& use = info.blocks[itemp];
+                if (refp->access().isReadOrRW()) use.first.insert(indexp->toSInt());
+                if (refp->access().isWriteOrRW()) use.second.insert(indexp->toSInt());
+            });
+        }
+
+        int budget = AUTO_MODULE_BUDGET;
+        for (AstVar* const varp : varps) {
+            const ArrayInfo& info = infos.at(varp);
+            if (info.ineligible) continue;
+            int writers = 0;
+            bool read = false;
+            bool readOther = false;  // A block reads an element other than one it writes
+            for (const auto& pair : info.blocks) {
+                const std::set<int>& reads = pair.second.first;
+                const std::set<int>& writes = pair.second.second;
+                if (!writes.empty()) ++writers;
+                if (!reads.empty()) read = true;
+                if (!writes.empty()) {
+                    for (const int index : reads) {
+                        if (writes.size() > 1 || !writes.count(index)) readOther = true;
+                    }
+                }
+            }
+            if (!read || (writers < 2 && !readOther)) continue;
+            const int elements = outerMostSizeOfUnpackedArray(varp);
+            if (elements > budget) continue;
+            budget -= elements;
+            UINFO(4, varp->prettyNameQ() << " will be split automatically");
+            varp->attrSplitVar(true);
+            m_autoVarps.emplace(varp);
+        }
+    }
+
     void visit(AstNode* nodep) override { iterateChildren(nodep); }
     void visit(AstNodeModule* nodep) override {
         UINFO(4, "Start checking " << nodep->prettyNameQ());
@@ -467,8 +559,10 @@ class SplitUnpackedVarVisitor final : public VNVisitor, public SplitVarImpl {
         VL_RESTORER(m_modp);
         m_modp = nodep;
         m_tempNames.reset();
+        if (v3Global.opt.fVarSplitArrays()) findAutoCandidates(nodep);
         iterateChildren(nodep);
         split();
+        m_autoVarps.clear();
     }
     void visit(AstNodeStmt* nodep) override { setContextAndIterateChildren(nodep); }
     void visit(AstCell* nodep) override { setContextAndIterateChildren(nodep); }
@@ -702,7 +796,9 @@ class SplitUnpackedVarVisitor final : public VNVisitor, public SplitVarImpl {
                 newp->funcLocal(varp->isFuncLocal() || varp->isFuncReturn());
                 insertp->addNextHere(newp);
                 insertp = newp;
-                newp->attrSplitVar(needNext || !cannotSplitPackedVarReason(newp));
+                // Elements of an automatically split array are left to -fvar-split
+                newp->attrSplitVar(!m_autoVarps.count(varp)
+                                   && (needNext || !cannotSplitPackedVarReason(newp)));
                 vars.push_back(newp);
                 setContextAndIterate(nullptr, newp);
             }
@@ -748,6 +844,7 @@ class SplitUnpackedVarVisitor final : public VNVisitor, public SplitVarImpl {
                 pushDeletep(varp->unlinkFrBack());
             }
             ++numSplit;
+            if (m_autoVarps.count(varp)) ++m_numSplitAuto;
         }
         return numSplit;
     }
@@ -766,11 +863,16 @@ class SplitUnpackedVarVisitor final : public VNVisitor, public SplitVarImpl {
 public:
     explicit SplitUnpackedVarVisitor(AstNetlist* nodep)
         : m_tempNames{"__VsplitVar"} {
+        if (v3Global.opt.fVarSplitArrays()) {
+            nodep->foreach([&](const AstVarXRef* xrefp) { m_xrefVarps.emplace(xrefp->varp()); });
+        }
         iterate(nodep);
     }
     ~SplitUnpackedVarVisitor() override {
         UASSERT(m_refs.empty(), "Don't forget to call split()");
-        V3Stats::addStat("SplitVar, unpacked arrays split due to attribute", m_numSplit);
+        V3Stats::addStat("SplitVar, unpacked arrays split due to attribute",
+                         m_numSplit - m_numSplitAuto);
+        V3Stats::addStat("SplitVar, unpacked arrays split automatically", m_numSplitAuto);
     }
     const SplitVarRefs& getPackedVarRefs() const { return std::move(m_forPackedSplit); }
 
@@ -905,7 +1007,9 @@ public:
     const AstBasicDType* basicp() const { return m_basicp; }
     // Make a plan for variables after split
     // when skipUnused==true, split variable for unread bits will not be created.
-    std::vector<SplitNewVar> splitPlan(const AstVar* varp, bool skipUnused) const {
+    // when splitAtReads==true, also split at the boundaries of read ranges.
+    std::vector<SplitNewVar> splitPlan(const AstVar* varp, bool skipUnused,
+                                       bool splitAtReads) const {
         UASSERT(m_dedupDone, "dedup() must be called before");
         AstNodeDType* const dtypep = varp->dtypeSkipRefp();
         std::vector<SplitNewVar> plan;
@@ -915,6 +1019,12 @@ public:
             points.emplace_back(ref.lsb(), false);  // Start of a region
             points.emplace_back(ref.msb() + 1, true);  // End of a region
         }
+        if (splitAtReads) {
+            for (const PackedVarRefEntry& ref : m_rhs) {
+                points.emplace_back(ref.lsb(), false);
+                points.emplace_back(ref.msb() + 1, true);
+            }
+        }
         const int bit_lo = basicp()->lo();
         const int bit_hi = bit_lo + dtypep->width() - 1;
         if (skipUnused && !m_rhs.empty()) {  // Range to be read must be kept, so add points here
@@ -1162,8 +1272,10 @@ class SplitPackedVarVisitor final : public VNVisitor, public SplitVarImpl {
             UINFO(4, "In module " << m_modp->name() << " var " << varp->prettyNameQ()
                                   << " which has " << ref.lhs().size() << " lhs refs and "
                                   << ref.rhs().size() << " rhs refs will be split.");
+            // If traced, all bit must be kept. Automatic candidates are only read via disjoint
+            // selects, so they can also be split at those, which splits whole assignments.
             std::vector<SplitNewVar> vars
-                = ref.splitPlan(varp, !varp->isTrace());  // If traced, all bit must be kept
+                = ref.splitPlan(varp, !varp->isTrace(), !varp->attrSplitVar());
             if (vars.empty()) continue;
             if (vars.size() == 1 && vars.front().bitwidth() == varp->width())
                 continue;  // No split
@@ -1210,6 +1322,8 @@ class SplitPackedVarVisitor final : public VNVisitor, public SplitVarImpl {
         // Store one VarInfo per AstVar via user3
         struct VarInfo final {
             bool ineligible = false;  // Ineligible for automatic consideration
+            bool writtenWhole = false;  // Wide variable assigned whole by an AssignW
+            bool wideSel = false;  // Some Sel is wider than VL_QUADSIZE
             std::vector<Range> ranges;  // [lsb, msb] inclusive of Sels
         };
         const VNUser3InUse user3InUse;
@@ -1238,6 +1352,16 @@ class SplitPackedVarVisitor final : public VNVisitor, public SplitVarImpl {
                 continue;
             }
 
+            // A wide net assigned whole can still be split, if it is only read via narrow
+            // selects. The lanes then use scalar storage and operations instead of VlWide.
+            if (varp->width() > VL_QUADSIZE && vrefp->access().isWriteOnly()) {
+                const AstAssignW* const assignp = VN_CAST(vrefp->backp(), AssignW);
+                if (assignp && assignp->lhsp() == vrefp) {
+                    info.writtenWhole = true;
+                    continue;
+                }
+            }
+
             // Ineligible if it is not being Sel from
             AstSel* const selp = VN_CAST(vrefp->firstAbovep(), Sel);
             if (!selp || vrefp != selp->fromp()) {
@@ -1255,6 +1379,7 @@ class SplitPackedVarVisitor final : public VNVisitor, public SplitVarImpl {
             const int32_t lsb = lsbConstp->toSInt();
             const int32_t msb = lsb + selp->widthConst() - 1;
             info.ranges.emplace_back(lsb, msb);
+            if (selp->widthConst() > VL_QUADSIZE) info.wideSel = true;
         }
 
         // Check the usage of each variable
@@ -1263,6 +1388,8 @@ class SplitPackedVarVisitor final : public VNVisitor, public SplitVarImpl {
             if (!infop) continue;
             // Don't consider if ineligible
             if (infop->ineligible) continue;
+            // Splitting a whole assignment only pays off if the lanes are not wide
+            if (infop->writtenWhole && infop->wideSel) continue;
             // Sort ranges by LSB then MSB
             std::sort(infop->ranges.begin(), infop->ranges.end(),
                       [](const Range& a, const Range& b) {
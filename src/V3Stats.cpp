@@ -20,6 +20,7 @@
 
 #include <iomanip>
 #include <map>
+#include <unordered_set>
 
 VL_DEFINE_DEBUG_FUNCTIONS;
 
@@ -47,6 +48,7 @@ class StatsVisitor final : public VNVisitorConst {
     Counters m_counters;  // The actual counts we will display
     Counters m_dumpster;  // Alternate buffer to make discarding parts of the tree easier
     Counters* m_accump;  // The currently active accumulator
+    std::unordered_set<const FileLine*> m_filelines;  // Distinct FileLines referenced by nodes
     std::vector<uint64_t> m_statVarWidths;  // Variables of given width
     std::vector<std::map<const std::string, uint32_t>>
         m_statVarWidthNames;  // Var names of given width
@@ -54,6 +56,7 @@ class StatsVisitor final : public VNVisitorConst {
     // METHODS
     void countThenIterateChildren(AstNode* nodep) {
         ++m_accump->m_statTypeCount[nodep->type()];
+        if (m_accump == &m_counters) m_filelines.emplace(nodep->fileline());
         iterateChildrenConst(nodep);
     }
 
@@ -140,12 +143,16 @@ public:
             }
         }
         addStat("Node memory TOTAL (MiB)", totalNodeMemoryUsage >> 20);
+        addStat("Node FileLines, distinct", m_filelines.size());
+        addStat("Node FileLines memory (MiB)", (m_filelines.size() * sizeof(FileLine)) >> 20);
 
         // Node Memory usage
         for (int t = 0; t < VNType::_ENUM_END; ++t) {
             if (const uint64_t count = m_counters.m_statTypeCount[t]) {
-                const double share = 100.0 * count * typeSize(t) / totalNodeMemoryUsage;
-                addStat("Node memory share (%), " + typeName(t), share, 2);
+                const uint64_t bytes = count * typeSize(t);
+                addStat("Node memory (KiB), " + typeName(t), bytes >> 10);
+                addStat("Node memory share (%), " + typeName(t), 100.0 * bytes / totalNodeMemoryUsage,
+                        2);
             }
         }
 
@@ -143,6 +143,10 @@ public:
     static void statsFinalAll(AstNetlist* nodep);
     /// Called by the top level to dump the statistics
     static void statsReport();
+    /// Called each stage with --prof-verilator
+    static void profStage(const string& name);
+    /// Called by the top level to write the --prof-verilator report
+    static void profReport();
     /// Called by debug dumps
     static void infoHeader(std::ofstream& os, const string& prefix);
     /// Called for final build report
@@ -219,6 +219,81 @@ void V3Stats::statsStage(const string& name) {
     V3Stats::addStatPerf("Stage, Memory (MB), " + digitName, memory);
 }
 
+//######################################################################
+// Verilator pass profiling (--prof-verilator)
+
+struct V3StatsProfStage final {
+    string m_name;  // Stage name
+    double m_startWall;  // Wall time at start of the stage (sec)
+    double m_wall;  // Wall time taken by the stage (sec)
+    double m_cpu;  // CPU time taken by the stage (sec)
+    double m_cpuTotal;  // CPU time at end of the stage (sec)
+    int64_t m_memDelta;  // Change in memory usage over the stage (bytes)
+    uint64_t m_mem;  // Memory usage at end of the stage (bytes)
+    int64_t m_nodeDelta;  // Change in number of AstNodes over the stage
+    uint64_t m_nodes;  // Number of AstNodes at end of the stage
+};
+
+static std::vector<V3StatsProfStage> s_profStages;  // All stages recorded
+// Measured from program startup, so the first stage also covers option parsing
+static VlOs::DeltaWallTime s_profWallTime{true};
+static VlOs::DeltaCpuTime s_profCpuTime{true};
+static const uint64_t s_profStartMem = VlOs::memPeakUsageBytes();
+
+void V3Stats::profStage(const string& name) {
+    const double wall = s_profWallTime.deltaTime();
+    const double cpu = s_profCpuTime.deltaTime();
+    const uint64_t mem = VlOs::memPeakUsageBytes();
+    uint64_t nodes = 0;
+    if (v3Global.rootp()) v3Global.rootp()->foreach([&](const AstNode*) { ++nodes; });
+
+    double lastWall = 0.0;
+    double lastCpu = 0.0;
+    uint64_t lastMem = s_profStartMem;
+    uint64_t lastNodes = 0;
+    if (!s_profStages.empty()) {
+        const V3StatsProfStage& last = s_profStages.back();
+        lastWall = last.m_startWall + last.m_wall;
+        lastCpu = last.m_cpuTotal;
+        lastMem = last.m_mem;
+        lastNodes = last.m_nodes;
+    }
+    s_profStages.push_back({name, lastWall, wall - lastWall, cpu - lastCpu, cpu,
+                            static_cast<int64_t>(mem) - static_cast<int64_t>(lastMem), mem,
+                            static_cast<int64_t>(nodes) - static_cast<int64_t>(lastNodes),
+                            nodes});
+}
+
+void V3Stats::profReport() {
+    UINFO(2, __FUNCTION__ << ":");
+
+    // Written in Chrome trace event format, so can be loaded into chrome://tracing,
+    // Perfetto or speedscope directly, with the per-stage measurements as arguments
+    const string filename
+        = v3Global.opt.hierTopDataDir() + "/" + v3Global.opt.prefix() + "__prof_verilator.json";
+    const std::unique_ptr<std::ofstream> ofp{V3File::new_ofstream(filename)};
+    if (ofp->fail()) v3fatal("Can't write file: " << filename);
+    std::ofstream& os = *ofp;
+
+    os << std::setprecision(6) << std::fixed;
+    os << "{\"displayTimeUnit\": \"ms\",\n";
+    os << " \"otherData\": {\"version\": \"" << V3Options::version() << "\"},\n";
+    os << " \"traceEvents\": [";
+    string sep = "\n  ";
+    int stageNumber = 0;
+    for (const V3StatsProfStage& stage : s_profStages) {
+        os << sep << "{\"name\": \"" << V3OutFormatter::quoteNameControls(stage.m_name)
+           << "\", \"cat\": \"stage\", \"ph\": \"X\", \"pid\": 0, \"tid\": 0"
+           << ", \"ts\": " << stage.m_startWall * 1e6 << ", \"dur\": " << stage.m_wall * 1e6
+           << ", \"args\": {\"stage\": " << ++stageNumber << ", \"wallSec\": " << stage.m_wall
+           << ", \"cpuSec\": " << stage.m_cpu << ", \"memBytes\": " << stage.m_mem
+           << ", \"memDeltaBytes\": " << stage.m_memDelta << ", \"nodes\": " << stage.m_nodes
+           << ", \"nodesDelta\": " << stage.m_nodeDelta << "}}";
+        sep = ",\n  ";
+    }
+    os << "\n ]\n}\n";
+}
+
 void V3Stats::infoHeader(std::ofstream& os, const string& prefix) {
     os << prefix << "Information:\n";
     os << prefix << "  Version: " << V3Options::version() << '\n';
@@ -29,6 +29,7 @@
 #include <iomanip>
 #include <map>
 #include <memory>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
@@ -44,7 +45,25 @@ class VSymEnt final {
     // Symbol table that can have a "superior" table for resolving upper references
     // MEMBERS
     using IdNameMap = std::multimap<std::string, VSymEnt*>;
+    // Hash index over the keys of m_idNameMap, which must stay ordered for deterministic
+    // iteration. Small tables are faster with the std::map alone, so this is only built
+    // once a table has INDEX_MIN_SIZE entries. Unnamed entries are not indexed.
+    struct NameHash final {
+        size_t operator()(const std::string* namep) const {
+            return std::hash<std::string>{}(*namep);
+        }
+    };
+    struct NameEqual final {
+        bool operator()(const std::string* ap, const std::string* bp) const {
+            return *ap == *bp;
+        }
+    };
+    using IdNameIndex
+        = std::unordered_map<const std::string*, IdNameMap::iterator, NameHash, NameEqual>;
+    static constexpr size_t INDEX_MIN_SIZE = 32;
+
     IdNameMap m_idNameMap;  // Hash of variables by name
+    std::unique_ptr<IdNameIndex> m_idNameIndexp;  // Index into m_idNameMap, if large
     AstNode* m_nodep;  // Node that entry belongs to
     VSymEnt* m_fallbackp = nullptr;  // Table "above" this in name scope, for fallback resolution
     VSymEnt* m_parentp = nullptr;  // Table that created this
@@ -57,7 +76,38 @@ class VSymEnt final {
 #else
     static constexpr int debug() { return 0; }  // NOT runtime, too hot of a function
 #endif
+    IdNameMap::iterator findName(const string& name) {
+        if (m_idNameIndexp && !name.empty()) {
+            const auto it = m_idNameIndexp->find(&name);
+            return it == m_idNameIndexp->end() ? m_idNameMap.end() : it->second;
+        }
+        return m_idNameMap.find(name);
+    }
+    IdNameMap::const_iterator findName(const string& name) const {
+        return const_cast<VSymEnt*>(this)->findName(name);
+    }
+    void addName(const string& name, VSymEnt* entp) {
+        symTableEdited();
+        const IdNameMap::iterator it = m_idNameMap.emplace(name, entp);
+        if (m_idNameIndexp) {
+            if (!name.empty()) m_idNameIndexp->emplace(&it->first, it);
+        } else if (m_idNameMap.size() >= INDEX_MIN_SIZE) {
+            m_idNameIndexp.reset(new IdNameIndex);
+            m_idNameIndexp->reserve(m_idNameMap.size() * 2);
+            for (IdNameMap::iterator mit = m_idNameMap.begin(); mit != m_idNameMap.end(); ++mit) {
+                if (!mit->first.empty()) m_idNameIndexp->emplace(&mit->first, mit);
+            }
+        }
+    }
+
 public:
+    // Count of changes to any symbol table, so lookups can be cached between changes
+    static uint64_t& editCount() VL_MT_DISABLED {
+        static uint64_t s_editCount = 0;
+        return s_editCount;
+    }
+    static void symTableEdited() VL_MT_DISABLED { ++editCount(); }
+
     using const_iterator = IdNameMap::const_iterator;
     const_iterator begin() const { return m_idNameMap.begin(); }
     const_iterator end() const { return m_idNameMap.end(); }
@@ -109,9 +159,15 @@ public:
     void* operator new(size_t size) { return std::malloc(size); }
     void operator delete(void* objp, size_t size) {}
 #endif
-    void fallbackp(VSymEnt* entp) { m_fallbackp = entp; }
+    void fallbackp(VSymEnt* entp) {
+        symTableEdited();
+        m_fallbackp = entp;
+    }
     VSymEnt* fallbackp() const { return m_fallbackp; }
-    void parentp(VSymEnt* entp) { m_parentp = entp; }
+    void parentp(VSymEnt* entp) {
+        symTableEdited();
+        m_parentp = entp;
+    }
     VSymEnt* parentp() const { return m_parentp; }
     void classOrPackagep(AstNodeModule* entp) { m_classOrPackagep = entp; }
     AstNodeModule* classOrPackagep() const { return m_classOrPackagep; }
@@ -125,7 +181,7 @@ public:
     VSymEnt* insert(const string& name, VSymEnt* entp) {
         UINFO(9, "     SymInsert se" << cvtToHex(this) << " '" << name << "' se" << cvtToHex(entp)
                                      << "  " << entp->nodep());
-        if (name != "" && m_idNameMap.find(name) != m_idNameMap.end()) {
+        if (name != "" && findName(name) != m_idNameMap.end()) {
             // If didn't already report warning
             if (!V3Error::errorCount()) {  // LCOV_EXCL_START
                 if (debug() >= 9 || V3Error::debugDefault())
@@ -133,15 +189,16 @@ public:
                 entp->nodep()->v3fatalSrc("Inserting two symbols with same name: " << name);
             }  // LCOV_EXCL_STOP
         } else {
-            m_idNameMap.emplace(name, entp);
+            addName(name, entp);
         }
         return entp;
     }
     void reinsert(const string& name, VSymEnt* entp) {
-        const auto it = m_idNameMap.find(name);
+        const auto it = findName(name);
         if (name != "" && it != m_idNameMap.end()) {
             UINFO(9, "     SymReinsert se" << cvtToHex(this) << " '" << name << "' se"
                                            << cvtToHex(entp) << "  " << entp->nodep());
+            symTableEdited();
             it->second = entp;  // Replace
         } else {
             insert(name, entp);
@@ -150,7 +207,7 @@ public:
     VSymEnt* findIdFlat(const string& name) const {
         // Find identifier without looking upward through symbol hierarchy
         // First, scan this begin/end block or module for the name
-        const auto it = m_idNameMap.find(name);
+        const auto it = findName(name);
         UINFO(9, "     SymFind   se"
                      << cvtToHex(this) << " '" << name << "' -> "
                      << (it == m_idNameMap.end() ? "NONE"
@@ -215,7 +272,7 @@ public:
     void importFromPackage(VSymGraph* graphp, const VSymEnt* srcp, const string& id_or_star) {
         // Import tokens from source symbol table into this symbol table
         if (id_or_star != "*") {
-            const auto it = srcp->m_idNameMap.find(id_or_star);
+            const auto it = srcp->findName(id_or_star);
             if (it != srcp->m_idNameMap.end()) {
                 importOneSymbol(graphp, it->first, it->second, true);
             }
@@ -229,7 +286,7 @@ public:
     void exportFromPackage(VSymGraph* graphp, const VSymEnt* srcp, const string& id_or_star) {
         // Export tokens from source symbol table into this symbol table
         if (id_or_star != "*") {
-            const auto it = vlstd::as_const(srcp->m_idNameMap).find(id_or_star);
+            const auto it = srcp->findName(id_or_star);
             if (it != srcp->m_idNameMap.end()) exportOneSymbol(graphp, it->first, it->second);
         } else {
             for (IdNameMap::const_iterator it = srcp->m_idNameMap.begin();
@@ -26,6 +26,7 @@
 #include "V3File.h"
 #include "V3Graph.h"
 
+#include <algorithm>
 #include <cmath>
 #include <list>
 #include <memory>
@@ -43,6 +44,9 @@ VL_DEFINE_DEBUG_FUNCTIONS;
 namespace V3TSP {
 static uint32_t edgeIdNext = 0;
 
+static void sortGreedy(const StateVec& states, StateVec* resultp) VL_MT_SAFE;
+static uint64_t pathCost(const StateVec& path) VL_MT_SAFE;
+static void selfTestGreedy();
 static void selfTestStates();
 static void selfTestString();
 }  // namespace V3TSP
@@ -432,6 +436,93 @@ private:
     VL_UNCOPYABLE(TspGraphTmpl);
 };
 
+//######################################################################
+// Greedy algorithm, for large state sets
+
+// The exact sort below builds the complete graph between all states, so
+// needs O(N^2) memory, and sorts all those edges for the matching. For
+// big sets, instead build the path by nearest neighbour, which takes
+// O(N) memory, then improve it by 2-opt moves bounded to nearby
+// positions. The result is usually a little worse, but cheap to compute.
+
+// Maximum distance between the ends of a reversed segment in the 2-opt search
+constexpr size_t TSP_GREEDY_WINDOW = 50;
+// Maximum number of 2-opt passes over the path
+constexpr int TSP_GREEDY_PASSES = 8;
+
+uint64_t V3TSP::pathCost(const V3TSP::StateVec& path) VL_MT_SAFE {
+    uint64_t cost = 0;
+    for (size_t i = 1; i < path.size(); ++i) cost += path[i - 1]->cost(path[i]);
+    return cost;
+}
+
+void V3TSP::sortGreedy(const V3TSP::StateVec& states, V3TSP::StateVec* resultp) VL_MT_SAFE {
+    // Start from the state furthest from an arbitrary one, as that is
+    // likely near an end of a good path
+    size_t startIdx = 0;
+    int startCost = -1;
+    for (size_t i = 0; i < states.size(); ++i) {
+        const int cost = states.front()->cost(states[i]);
+        if (cost > startCost) {
+            startCost = cost;
+            startIdx = i;
+        }
+    }
+
+    // Nearest neighbour construction
+    V3TSP::StateVec& path = *resultp;
+    V3TSP::StateVec remaining;
+    remaining.reserve(states.size() - 1);
+    for (size_t i = 0; i < states.size(); ++i) {
+        if (i != startIdx) remaining.push_back(states[i]);
+    }
+    path.reserve(states.size());
+    path.push_back(states[startIdx]);
+    while (!remaining.empty()) {
+        const TspStateBase* const lastp = path.back();
+        size_t bestIdx = 0;
+        int bestCost = lastp->cost(remaining[0]);
+        // Stop on a zero cost neighbour, nothing can be nearer
+        for (size_t i = 1; i < remaining.size() && bestCost > 0; ++i) {
+            const int cost = lastp->cost(remaining[i]);
+            if (cost < bestCost) {
+                bestCost = cost;
+                bestIdx = i;
+            }
+        }
+        path.push_back(remaining[bestIdx]);
+        remaining[bestIdx] = remaining.back();
+        remaining.pop_back();
+    }
+
+    // Bounded 2-opt: reverse path[i..j] when that shortens the (open) path
+    const size_t size = path.size();
+    for (int pass = 0; pass < TSP_GREEDY_PASSES; ++pass) {
+        bool improved = false;
+        for (size_t i = 0; i + 1 < size; ++i) {
+            const size_t jEnd = std::min(size, i + 1 + TSP_GREEDY_WINDOW);
+            for (size_t j = i + 1; j < jEnd; ++j) {
+                int before = 0;
+                int after = 0;
+                if (i > 0) {
+                    before += path[i - 1]->cost(path[i]);
+                    after += path[i - 1]->cost(path[j]);
+                }
+                if (j + 1 < size) {
+                    before += path[j]->cost(path[j + 1]);
+                    after += path[i]->cost(path[j + 1]);
+                }
+                if (after < before) {
+                    std::reverse(path.begin() + i, path.begin() + j + 1);
+                    improved = true;
+                }
+            }
+        }
+        if (!improved) break;
+    }
+    UINFO(6, "TSP greedy sort of " << size << " states, cost " << pathCost(path));
+}
+
 //######################################################################
 // Main algorithm
 
@@ -447,6 +538,12 @@ void V3TSP::tspSort(const V3TSP::StateVec& states, V3TSP::StateVec* resultp) VL_
         return;
     }
 
+    // Keep the better, but quadratic memory, sort for small sets
+    if (states.size() > static_cast<size_t>(v3Global.opt.tspExactLimit())) {
+        sortGreedy(states, resultp);
+        return;
+    }
+
     // Build the initial graph from the starting state set.
     using Graph = TspGraphTmpl<const TspStateBase*>;
     Graph graph;
@@ -650,6 +747,64 @@ void V3TSP::selfTestStates() {
     }
 }
 
+void V3TSP::selfTestGreedy() {
+    // Linear test, the nearest neighbour path is already optimal
+    {
+        const TspTestState s10{10, 0};
+        const TspTestState s60{60, 0};
+        const TspTestState s20{20, 0};
+        const TspTestState s100{100, 0};
+        const TspTestState s5{5, 0};
+        const V3TSP::StateVec states{&s10, &s60, &s20, &s100, &s5};
+
+        V3TSP::StateVec result;
+        sortGreedy(states, &result);
+
+        const V3TSP::StateVec expect{&s100, &s60, &s20, &s10, &s5};
+        if (VL_UNCOVERABLE(expect != result)) {
+            for (const TspStateBase* const stateBasep : result) {
+                const TspTestState* const statep = dynamic_cast<const TspTestState*>(stateBasep);
+                cout << statep->xpos() << " ";
+            }
+            cout << endl;
+            v3fatalSrc(
+                "TSP greedy linear self-test fail. Result (above) did not match expectation.");
+        }
+    }
+
+    // Grid test, in scrambled order, must be near the exact sort's cost
+    {
+        constexpr unsigned SIDE = 12;
+        std::vector<std::unique_ptr<TspTestState>> points;
+        for (unsigned i = 0; i < SIDE * SIDE; ++i) {
+            const unsigned n = (i * 37) % (SIDE * SIDE);
+            points.emplace_back(new TspTestState{(n % SIDE) * 10, (n / SIDE) * 10});
+        }
+        V3TSP::StateVec states;
+        for (const auto& pointp : points) states.push_back(pointp.get());
+
+        V3TSP::StateVec exact;
+        tspSort(states, &exact);
+        V3TSP::StateVec result;
+        sortGreedy(states, &result);
+
+        V3TSP::StateVec sortedStates = states;
+        V3TSP::StateVec sortedResult = result;
+        std::sort(sortedStates.begin(), sortedStates.end());
+        std::sort(sortedResult.begin(), sortedResult.end());
+        if (VL_UNCOVERABLE(sortedStates != sortedResult)) {
+            v3fatalSrc("TSP greedy grid self-test fail. Result is not a permutation.");
+        }
+        const uint64_t exactCost = pathCost(exact);
+        const uint64_t resultCost = pathCost(result);
+        if (VL_UNCOVERABLE(resultCost * 4 > exactCost * 5)) {
+            v3fatalSrc("TSP greedy grid self-test fail. Cost " << resultCost
+                                                               << " too far above exact cost "
+                                                               << exactCost);
+        }
+    }
+}
+
 void V3TSP::selfTestString() {
     using Graph = TspGraphTmpl<std::string>;
     Graph graph;
@@ -696,4 +851,5 @@ void V3TSP::selfTestString() {
 void V3TSP::selfTest() {
     selfTestString();
     selfTestStates();
+    selfTestGreedy();
 }
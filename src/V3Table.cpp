@@ -17,7 +17,13 @@
 //      Look at all large always and assignments.
 //      Count # of input bits and # of output bits, and # of statements
 //      If high # of statements relative to inpbits*outbits,
-//      replace with lookup table
+//      or if the estimated execution cost of the logic is much higher than
+//      a lookup, replace with lookup table
+//
+//      If many blocks of consecutive table entries are identical, as in
+//      decoders of sparse input spaces, use a two level table instead:
+//      the upper input bits select one of the distinct blocks, which the
+//      lower input bits index into.
 //
 //*************************************************************************
 
@@ -25,10 +31,13 @@
 
 #include "V3Table.h"
 
+#include "V3InstrCount.h"
 #include "V3Simulate.h"
 #include "V3Stats.h"
 
 #include <cmath>
+#include <map>
+#include <unordered_map>
 #include <vector>
 
 VL_DEFINE_DEBUG_FUNCTIONS;
@@ -47,6 +56,16 @@ static constexpr int TABLE_SPACE_TIME_MULT = 8;
 static constexpr int TABLE_MIN_NODE_COUNT = 32;
 // Assume an instruction is 4 bytes
 static constexpr int TABLE_BYTES_PER_INST = 4;
+// Logic this many times more costly to evaluate than a lookup is worth a table
+// up to TABLE_MAX_BYTES, regardless of the space tradeoff
+static constexpr int TABLE_DYNAMIC_MULT = 4;
+// Maximum input bits when considering the evaluation cost
+static constexpr unsigned TABLE_DYNAMIC_MAX_INPUT_BITS = 16;
+// Before two level compression, up to 16MB may be simulated when considering the evaluation cost
+static constexpr int TABLE_MAX_SPARSE_BYTES = 16 * 1024 * 1024;
+// Lookups in tables larger than the L1 cache are assumed to miss
+static constexpr int TABLE_L1_BYTES = 32 * 1024;
+static constexpr int TABLE_CACHE_MISS_INSTRS = 12;
 
 //######################################################################
 
@@ -152,6 +171,8 @@ class TableVisitor final : public VNVisitor {
     // STATE
     double m_totalBytes = 0;  // Total bytes in tables created
     VDouble0 m_statTablesCre;  // Statistic tracking
+    VDouble0 m_statTablesTwoLevel;  // Statistic tracking
+    VDouble0 m_statTablesCost;  // Statistic tracking
 
     //  State cleared on each module
     AstNodeModule* m_modp = nullptr;  // Current MODULE
@@ -166,6 +187,7 @@ class TableVisitor final : public VNVisitor {
     unsigned m_outWidthBytes = 0;  // Output table width - in bytes
     std::vector<AstVarScope*> m_inVarps;  // Input variable list
     std::vector<TableOutputVar> m_outVarps;  // Output variable list
+    bool m_byCost = false;  // Table chosen for the evaluation cost, not for the space tradeoff
 
     // METHODS
 
@@ -187,6 +209,14 @@ public:
     }
 
 private:
+    // Estimated cost of a lookup, as by V3InstrCount
+    uint32_t lookupCost(double space, bool twoLevel) const {
+        uint32_t cost = m_inVarps.size() + (m_outVarps.size() + 1) * (AstNode::INSTR_COUNT_LD + 1);
+        if (twoLevel) cost += 2 * AstNode::INSTR_COUNT_LD;
+        if (space > TABLE_L1_BYTES) cost += TABLE_CACHE_MISS_INSTRS;
+        return cost;
+    }
+
     bool treeTest(AstAlways* nodep) {
         // Process alw/assign tree
         m_inWidthBits = 0;
@@ -194,6 +224,9 @@ private:
         m_inVarps.clear();
         m_outVarps.clear();
 
+        // Longest path cost through the logic, before simulation takes the user fields
+        const uint32_t logicCost = V3InstrCount::count(nodep, false);
+
         // Collect stats
         TableSimulateVisitor chkvis{this};
         chkvis.mainTableCheck(nodep);
@@ -216,13 +249,18 @@ private:
         if (!m_outWidthBytes || !m_inWidthBits) {
             chkvis.clearOptimizable(nodep, "Table has no outputs");
         }
+        // Worth a table even with a bad tradeoff if much faster; checked
+        // against TABLE_MAX_BYTES after two level compression
+        m_byCost = space > time * TABLE_SPACE_TIME_MULT
+                   && m_inWidthBits <= TABLE_DYNAMIC_MAX_INPUT_BITS
+                   && logicCost >= TABLE_DYNAMIC_MULT * lookupCost(space, false);
         if (chkvis.instrCount() < TABLE_MIN_NODE_COUNT) {
             chkvis.clearOptimizable(nodep, "Table has too few nodes involved");
         }
-        if (space > TABLE_MAX_BYTES) {
+        if (space > (m_byCost ? TABLE_MAX_SPARSE_BYTES : TABLE_MAX_BYTES)) {
             chkvis.clearOptimizable(nodep, "Table takes too much space");
         }
-        if (space > time * TABLE_SPACE_TIME_MULT) {
+        if (!m_byCost && space > time * TABLE_SPACE_TIME_MULT) {
             chkvis.clearOptimizable(nodep, "Table has bad tradeoff");
         }
         if (m_totalBytes > TABLE_TOTAL_BYTES) {
@@ -232,44 +270,145 @@ private:
                                 << chkvis.instrCount() << " Data=" << chkvis.dataCount()
                                 << " in width (bits)=" << m_inWidthBits << " out width (bytes)="
                                 << m_outWidthBytes << " Spacetime=" << (space / time) << "("
-                                << space << "/" << time << ")"
-                                << ": " << nodep);
+                                << space << "/" << time << ") Cost=" << logicCost
+                                << (m_byCost ? " by cost" : "") << ": " << nodep);
         if (chkvis.optimizable()) {
             UINFO(3, " Table Optimize spacetime=" << (space / time) << " " << nodep);
-            m_totalBytes += space;
         }
         return chkvis.optimizable();
     }
 
+    // Table layout: with 'blockBits' zero, a flat table, else the upper input
+    // bits index into 'blockIds' to select a block of 2^blockBits entries
+    struct Layout final {
+        unsigned m_blockBits = 0;  // Index bits within each block, 0 for a flat table
+        unsigned m_blockIdBits = 0;  // Bits of a block number
+        std::vector<uint32_t> m_blockIds;  // Block number of each block of inputs
+        std::vector<uint32_t> m_blockFirst;  // First input of each distinct block
+        double m_space = 0;  // Total bytes
+    };
+
+    // Choose the smallest of the flat and two level table layouts, given
+    // the output row number of each input value
+    Layout chooseLayout(const std::vector<uint32_t>& rowIds) const {
+        const double rowBytes = m_outWidthBytes + m_outVarps.size();
+        Layout best;
+        best.m_space = std::pow<double>(2.0, m_inWidthBits) * rowBytes;
+        const double flatSpace = best.m_space;
+        for (unsigned blockBits = 1; blockBits < m_inWidthBits; ++blockBits) {
+            Layout layout;
+            layout.m_blockBits = blockBits;
+            const size_t blockSize = 1ULL << blockBits;
+            std::map<std::vector<uint32_t>, uint32_t> blocks;  // Contents -> block number
+            for (size_t first = 0; first < rowIds.size(); first += blockSize) {
+                std::vector<uint32_t> contents{rowIds.begin() + first,
+                                               rowIds.begin() + first + blockSize};
+                const auto pair = blocks.emplace(std::move(contents), blocks.size());
+                if (pair.second) layout.m_blockFirst.push_back(first);
+                layout.m_blockIds.push_back(pair.first->second);
+            }
+            layout.m_blockIdBits = V3Number::log2b(blocks.size() - 1) + 1;
+            const int idBytes = layout.m_blockIdBits <= 8 ? 1 : layout.m_blockIdBits <= 16 ? 2 : 4;
+            layout.m_space = static_cast<double>(layout.m_blockIds.size()) * idBytes
+                             + static_cast<double>(blocks.size()) * blockSize * rowBytes;
+            if (layout.m_space < best.m_space) best = std::move(layout);
+        }
+        // Only worth the extra lookup if much smaller
+        if (best.m_blockBits && best.m_space * 2 > flatSpace) {
+            best = Layout{};
+            best.m_space = flatSpace;
+        }
+        return best;
+    }
+
     void replaceWithTable(AstAlways* nodep) {
         // We've determined this table of nodes is optimizable, do it.
+        FileLine* const fl = nodep->fileline();
+
+        // Simulate all inputs, and number the distinct output rows
+        std::vector<std::vector<V3Number>> rows;  // Assigned mask, then each output
+        std::vector<uint32_t> rowIds;  // Row number of each input value
+        simulateTables(nodep, rows, rowIds);
+        const Layout layout = chooseLayout(rowIds);
+        if (m_byCost && layout.m_space > TABLE_MAX_BYTES) {
+            UINFO(4, "  Table takes too much space after compression: " << nodep);
+            return;
+        }
+        if (m_totalBytes + layout.m_space > TABLE_TOTAL_BYTES) {
+            UINFO(4, "  Table out of memory: " << nodep);
+            return;
+        }
+        m_totalBytes += layout.m_space;
         ++m_modTables;
         ++m_statTablesCre;
-
-        FileLine* const fl = nodep->fileline();
+        if (layout.m_blockBits) ++m_statTablesTwoLevel;
+        if (m_byCost) ++m_statTablesCost;
 
         // We will need a table index variable, create it here.
-        AstVar* const indexVarp
-            = new AstVar{fl, VVarType::BLOCKTEMP, "__Vtableidx" + cvtToStr(m_modTables),
-                         VFlagBitPacked{}, static_cast<int>(m_inWidthBits)};
-        m_modp->addStmtsp(indexVarp);
-        AstVarScope* const indexVscp = new AstVarScope{indexVarp->fileline(), m_scopep, indexVarp};
-        m_scopep->addVarsp(indexVscp);
+        AstVarScope* const indexVscp
+            = createIndexVar(fl, "__Vtableidx" + cvtToStr(m_modTables), m_inWidthBits);
+
+        // Entry of each input value in the output tables, and number of entries
+        const auto entry = [&](uint32_t inValue) -> uint32_t {
+            if (!layout.m_blockBits) return inValue;
+            const uint32_t blockId = layout.m_blockIds[inValue >> layout.m_blockBits];
+            return (blockId << layout.m_blockBits) | (inValue & VL_MASK_I(layout.m_blockBits));
+        };
+        const uint32_t outMaxIndex
+            = layout.m_blockBits ? (layout.m_blockFirst.size() << layout.m_blockBits) - 1
+                                 : VL_MASK_I(m_inWidthBits);
 
         // The 'output assigned' table builder
         TableBuilder outputAssignedTableBuilder{fl};
         outputAssignedTableBuilder.setTableSize(
             nodep->findBitDType(m_outVarps.size(), m_outVarps.size(), VSigning::UNSIGNED),
-            VL_MASK_I(m_inWidthBits));
+            outMaxIndex);
 
         // Set sizes of output tables
-        for (TableOutputVar& tov : m_outVarps) tov.setTableSize(VL_MASK_I(m_inWidthBits));
-
-        // Populate the tables
-        createTables(nodep, outputAssignedTableBuilder);
+        for (TableOutputVar& tov : m_outVarps) tov.setTableSize(outMaxIndex);
+
+        // Populate the tables, from the first input of each distinct entry
+        std::vector<bool> done(outMaxIndex + 1, false);
+        for (uint32_t inValue = 0; inValue <= VL_MASK_I(m_inWidthBits); ++inValue) {
+            const uint32_t index = entry(inValue);
+            if (done[index]) continue;
+            done[index] = true;
+            const std::vector<V3Number>& row = rows[rowIds[inValue]];
+            outputAssignedTableBuilder.addValue(index, row[0]);
+            for (TableOutputVar& tov : m_outVarps) {
+                if (row[0].bitIs1(tov.ord())) tov.addValue(index, row[tov.ord() + 1]);
+            }
+        }
 
         AstNode* const stmtsp = createLookupInput(fl, indexVscp);
-        createOutputAssigns(nodep, stmtsp, indexVscp, outputAssignedTableBuilder.varScopep());
+        AstVarScope* outIndexVscp = indexVscp;
+        if (layout.m_blockBits) {
+            // Second level index: {blocks[index >> blockBits], index[blockBits-1:0]}
+            TableBuilder blocksTableBuilder{fl};
+            blocksTableBuilder.setTableSize(
+                nodep->findBitDType(layout.m_blockIdBits, layout.m_blockIdBits,
+                                    VSigning::UNSIGNED),
+                layout.m_blockIds.size() - 1);
+            for (size_t i = 0; i < layout.m_blockIds.size(); ++i) {
+                blocksTableBuilder.addValue(
+                    i, V3Number{nodep, static_cast<int>(layout.m_blockIdBits),
+                                layout.m_blockIds[i]});
+            }
+            outIndexVscp = createIndexVar(fl, "__Vtableidx" + cvtToStr(m_modTables) + "__l2",
+                                          layout.m_blockIdBits + layout.m_blockBits);
+            AstNodeExpr* const blockIndexp
+                = new AstShiftR{fl, new AstVarRef{fl, indexVscp, VAccess::READ},
+                                new AstConst{fl, layout.m_blockBits},
+                                static_cast<int>(m_inWidthBits)};
+            AstNodeExpr* const blockp = new AstArraySel{
+                fl, new AstVarRef{fl, blocksTableBuilder.varScopep(), VAccess::READ},
+                blockIndexp};
+            AstNodeExpr* const lowp = new AstSel{fl, new AstVarRef{fl, indexVscp, VAccess::READ},
+                                                 0, static_cast<int>(layout.m_blockBits)};
+            stmtsp->addNext(new AstAssign{fl, new AstVarRef{fl, outIndexVscp, VAccess::WRITE},
+                                          new AstConcat{fl, blockp, lowp}});
+        }
+        createOutputAssigns(nodep, stmtsp, outIndexVscp, outputAssignedTableBuilder.varScopep());
 
         // Link it in.
         // Keep sensitivity list, but delete all else
@@ -278,11 +417,22 @@ private:
         if (debug() >= 6) nodep->dumpTree("-  table_new: ");
     }
 
-    void createTables(AstAlways* nodep, TableBuilder& outputAssignedTableBuilder) {
-        // Create table
+    AstVarScope* createIndexVar(FileLine* fl, const string& name, unsigned width) {
+        AstVar* const varp = new AstVar{fl, VVarType::BLOCKTEMP, name, VFlagBitPacked{},
+                                        static_cast<int>(width)};
+        m_modp->addStmtsp(varp);
+        AstVarScope* const vscp = new AstVarScope{varp->fileline(), m_scopep, varp};
+        m_scopep->addVarsp(vscp);
+        return vscp;
+    }
+
+    void simulateTables(AstAlways* nodep, std::vector<std::vector<V3Number>>& rows,
+                        std::vector<uint32_t>& rowIds) {
         // There may be a simulation path by which the output doesn't change value.
         // We could bail on these cases, or we can have a "change it" boolean.
         // We've chosen the latter route, since recirc is common in large FSMs.
+        std::unordered_map<string, uint32_t> rowNumbers;  // Row contents -> row number
+        rowIds.reserve(VL_MASK_I(m_inWidthBits) + 1ULL);
         TableSimulateVisitor simvis{this};
         for (uint32_t i = 0; i <= VL_MASK_I(m_inWidthBits); ++i) {
             const uint32_t inValue = i;
@@ -313,22 +463,27 @@ private:
                         "Optimizable cleared, even though earlier test run said not: "
                             << simvis.whyNotMessage());
 
-            // Build output value tables and the assigned flags table
-            V3Number outputAssignedMask{nodep, static_cast<int>(m_outVarps.size()), 0};
+            // Build output values and the assigned flags
+            std::vector<V3Number> row;
+            row.emplace_back(nodep, static_cast<int>(m_outVarps.size()), 0);
+            string key;
             for (TableOutputVar& tov : m_outVarps) {
                 if (V3Number* const outnump = simvis.fetchOutNumberNull(tov.varScopep())) {
                     UINFO(8, "   Output " << tov.name() << " = " << *outnump);
                     UASSERT_OBJ(!outnump->isAnyXZ(), outnump, "Table should not contain X/Z");
-                    outputAssignedMask.setBit(tov.ord(), 1);  // Mark output as assigned
-                    tov.addValue(inValue, *outnump);
+                    row[0].setBit(tov.ord(), 1);  // Mark output as assigned
+                    row.push_back(*outnump);
+                    key += outnump->ascii() + ",";
                 } else {
                     UINFO(8, "   Output " << tov.name() << " not set for this input");
                     tov.setMayBeUnassigned();
+                    row.emplace_back(nodep, 1, 0);
+                    key += "-,";
                 }
             }
-
-            // Set changed table
-            outputAssignedTableBuilder.addValue(inValue, outputAssignedMask);
+            const auto pair = rowNumbers.emplace(key, rows.size());
+            if (pair.second) rows.push_back(std::move(row));
+            rowIds.push_back(pair.first->second);
         }  // each value
     }
 
@@ -411,6 +566,8 @@ public:
     explicit TableVisitor(AstNetlist* nodep) { iterate(nodep); }
     ~TableVisitor() override {  //
         V3Stats::addStat("Optimizations, Tables created", m_statTablesCre);
+        V3Stats::addStat("Optimizations, Tables created two level", m_statTablesTwoLevel);
+        V3Stats::addStat("Optimizations, Tables created by cost", m_statTablesCost);
     }
 };
 
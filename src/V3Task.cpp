@@ -322,6 +322,26 @@ struct TaskDpiUtils final {
         }
         return dimStrides;
     }
+    // True if the internal storage of the fixed size unpacked array 'portp' is already the
+    // C layout of the DPI argument, so it can be passed to the DPI function as is
+    static bool isDpiDirectArray(const AstVar* portp) {
+        const AstNodeDType* dtypep = portp->dtypep()->skipRefp();
+        if (!VN_IS(dtypep, UnpackArrayDType)) return false;
+        while (const AstUnpackArrayDType* const adtypep = VN_CAST(dtypep, UnpackArrayDType)) {
+            dtypep = adtypep->subDTypep()->skipRefp();
+        }
+        const AstBasicDType* const basicp = VN_CAST(dtypep, BasicDType);
+        if (!basicp) return false;
+        switch (basicp->keyword()) {
+        case VBasicDTypeKwd::BIT: return !basicp->isRanged() && basicp->width() == 1;
+        case VBasicDTypeKwd::BYTE:
+        case VBasicDTypeKwd::SHORTINT:
+        case VBasicDTypeKwd::INT:
+        case VBasicDTypeKwd::DOUBLE: return true;
+        // 'long long' is not the same type as QData, so might not alias it
+        default: return false;
+        }
+    }
     static bool dpiToInternalFrStmt(AstVar* portp, const string& frName, string& frstmt,
                                     string& ket) {
         ket.clear();
@@ -380,6 +400,7 @@ class TaskVisitor final : public VNVisitor {
     DpiCFuncs m_dpiNames;  // Map of all created DPI functions
     VDouble0 m_statInlines;  // Statistic tracking
     VDouble0 m_statHierDpisWithCosts;  // Statistic tracking
+    VDouble0 m_statDpiDirectArrays;  // Statistic tracking
 
     // METHODS
 
@@ -1109,6 +1130,16 @@ class TaskVisitor final : public VNVisitor {
                                + name + " (&" + propName + ", &" + portp->name() + ");\n");
                         cfuncp->addStmtsp(new AstCStmt{portp->fileline(), varCode});
                         args += "&" + name;
+                    } else if (TaskDpiUtils::isDpiDirectArray(portp)) {
+                        // Pass the internal storage, no temporary or conversions needed
+                        string ptr = "(&" + portp->name();
+                        const int dims = VN_AS(portp->dtypep()->skipRefp(), UnpackArrayDType)
+                                             ->dimensions(false)
+                                             .second;
+                        for (int i = 0; i < dims; ++i) ptr += "[0]";
+                        ptr += ")";
+                        args += "reinterpret_cast<" + portp->dpiArgType(false, false) + ">" + ptr;
+                        ++m_statDpiDirectArrays;
                     } else {
                         if (portp->isWritable() && portp->basicp()->isDpiPrimitive()) {
                             if (!VN_IS(portp->dtypep()->skipRefp(), UnpackArrayDType)) args += "&";
@@ -1151,7 +1182,7 @@ class TaskVisitor final : public VNVisitor {
             if (AstVar* const portp = VN_CAST(stmtp, Var)) {
                 portp->protect(false);  // No additional exposure - already part of shown proto
                 if (portp->isIO() && (portp->isWritable() || portp->isFuncReturn())
-                    && !portp->isDpiOpenArray()) {
+                    && !portp->isDpiOpenArray() && !TaskDpiUtils::isDpiDirectArray(portp)) {
                     AstVarScope* const portvscp = VN_AS(
                         portp->user2p(), VarScope);  // Remembered when we created it earlier
                     cfuncp->addStmtsp(
@@ -1640,6 +1671,7 @@ public:
         V3Stats::addStat("Optimizations, Functions inlined", m_statInlines);
         V3Stats::addStat("Optimizations, Hierarchical DPI wrappers with costs",
                          m_statHierDpisWithCosts);
+        V3Stats::addStat("Optimizations, DPI arrays passed directly", m_statDpiDirectArrays);
     }
 };
 
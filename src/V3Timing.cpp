@@ -40,6 +40,11 @@
 //     - introduce an intermediate variable
 //     - write the original RHS to the intermediate variable before the timing control
 //     - write the intermediate variable to the original LHS after the timing control
+// - for each simple clock generator (always #<const> <plain assignments>):
+//     - replace it with a periodic timer of the global delay scheduler, and an ordinary
+//       process triggered by the timer, so it needs no coroutine
+// - for each initial that is only constant delays and plain statements:
+//     - replace it with a state machine process triggered by a one-shot timer
 // - for each delay:
 //     - scale it according to the module's timescale
 //     - replace it with a CAwait statement waiting on the global delay scheduler (with the
@@ -468,6 +473,7 @@ class TimingControlVisitor final : public VNVisitor {
     AstActive* m_activep = nullptr;  // Current active
     AstNode* m_procp = nullptr;  // NodeProcedure/CFunc/Begin we're under
     int m_forkCnt = 0;  // Number of forks inside a module
+    uint32_t m_timerCnt = 0;  // Number of timers in the delay scheduler
     bool m_underJumpBlock = false;  // True if we are inside of a jump-block
     bool m_underProcedure = false;  // True if we are under an always or initial
 
@@ -481,6 +487,7 @@ class TimingControlVisitor final : public VNVisitor {
     V3UniqueNames m_intraLsbNames{"__Vintralsb"};  // Intra assign delay LSB var names
     V3UniqueNames m_trigSchedNames{"__VtrigSched"};  // Trigger scheduler name generator
     V3UniqueNames m_dynTrigNames{"__VdynTrigger"};  // Dynamic trigger name generator
+    V3UniqueNames m_timerStateNames{"__VtimerState"};  // Delay sequence state var names
 
     // DTypes
     AstBasicDType* m_forkDtp = nullptr;  // Fork variable type
@@ -710,6 +717,168 @@ class TimingControlVisitor final : public VNVisitor {
         m_scopep->addVarsp(vscp);
         return vscp;
     }
+    // Returns the scaled value of a constant, non-zero delay; 0 if it is not one
+    uint64_t constDelay(AstDelay* const delayp) const {
+        if (delayp->isCycleDelay()) return 0;
+        AstConst* const constp = VN_CAST(delayp->lhsp(), Const);
+        if (!constp || constp->isZero()) return 0;
+        const double timescaleFactor = calculateTimescaleFactor(delayp, delayp->timeunit());
+        if (constp->dtypep()->skipRefp()->isDouble()) {
+            return static_cast<uint64_t>(std::round(constp->num().toDouble() * timescaleFactor));
+        }
+        if (constp->width() > 64) return 0;
+        return constp->toUQuad() * static_cast<uint64_t>(timescaleFactor);
+    }
+    // Returns true if the statement can run from a timer-triggered process: it cannot suspend,
+    // call anything, or reference locals
+    bool isTimerStmt(AstNode* const stmtp) const {
+        if (const AstNodeAssign* const assignp = VN_CAST(stmtp, NodeAssign)) {
+            if (!VN_IS(assignp, Assign) && !VN_IS(assignp, AssignDly)) return false;
+            return !assignp->timingControlp() && !needDynamicTrigger(assignp->lhsp())
+                   && !needDynamicTrigger(assignp->rhsp());
+        }
+        if (const AstDisplay* const dispp = VN_CAST(stmtp, Display)) {
+            if (dispp->filep()) return false;
+            for (AstNode* argp = dispp->fmtp()->exprsp(); argp; argp = argp->nextp()) {
+                if (needDynamicTrigger(argp)) return false;
+            }
+            return true;
+        }
+        return VN_IS(stmtp, Finish) || VN_IS(stmtp, Stop);
+    }
+    // Returns a '<delay scheduler>.<method>(id, delay)' timer start statement
+    AstNodeStmt* createTimerStart(FileLine* const flp, const char* methodp, uint32_t id,
+                                  uint64_t delay) {
+        AstCMethodHard* const callp = new AstCMethodHard{
+            flp, new AstVarRef{flp, getCreateDelayScheduler(), VAccess::WRITE}, methodp,
+            new AstConst{flp, id}};
+        callp->addPinsp(new AstConst{flp, AstConst::Unsized64{}, delay});
+        callp->dtypeSetVoid();
+        return callp->makeStmt();
+    }
+    // Put the statements in an ordinary process triggered by the given timer, after m_activep
+    void addTimerProcess(FileLine* const flp, uint32_t id, AstNode* const stmtsp) {
+        AstCMethodHard* const duep = new AstCMethodHard{
+            flp, new AstVarRef{flp, getCreateDelayScheduler(), VAccess::WRITE}, "timerDue",
+            new AstConst{flp, id}};
+        duep->dtypeSetBit();
+        AstActive* const activep = new AstActive{
+            flp, "timer", new AstSenTree{flp, new AstSenItem{flp, VEdgeType::ET_TRUE, duep}}};
+        activep->sensesStorep(activep->sensesp());
+        activep->addStmtsp(new AstAlways{flp, VAlwaysKwd::ALWAYS, nullptr, stmtsp});
+        m_activep->addNextHere(activep);
+    }
+    // Returns the delay of a simple clock generator: an 'always' that only waits for a constant
+    // delay and then runs timer statements. Returns 0 if not one.
+    uint64_t periodicDelay(AstAlways* const nodep) const {
+        if (!v3Global.opt.fPeriodic() || m_classp || hasFlags(nodep, T_HAS_PROC)) return 0;
+        if (m_activep->sensesp()->hasClocked()) return 0;
+        AstDelay* const delayp = VN_CAST(nodep->stmtsp(), Delay);
+        if (!delayp) return 0;
+        AstNode* const afterp = delayp->nextp();
+        if (!delayp->stmtsp() && !afterp) return 0;
+        for (AstNode* stmtp = delayp->stmtsp(); stmtp; stmtp = stmtp->nextp()) {
+            if (!isTimerStmt(stmtp)) return 0;
+        }
+        for (AstNode* stmtp = afterp; stmtp; stmtp = stmtp->nextp()) {
+            if (!isTimerStmt(stmtp)) return 0;
+        }
+        return constDelay(delayp);
+    }
+    // Replace a simple clock generator with a periodic timer and an ordinary process
+    void lowerPeriodic(AstAlways* const nodep, uint64_t period) {
+        FileLine* const flp = nodep->fileline();
+        const uint32_t id = m_timerCnt++;
+        UINFO(4, "  Periodic timer " << id << " period " << period << " " << nodep << endl);
+        // Start the timer when the process would have started
+        AstActive* const initActivep = new AstActive{
+            flp, "", new AstSenTree{flp, new AstSenItem{flp, AstSenItem::Initial{}}}};
+        initActivep->sensesStorep(initActivep->sensesp());
+        initActivep->addStmtsp(
+            new AstInitial{flp, createTimerStart(flp, "addPeriodic", id, period)});
+        m_activep->addNextHere(initActivep);
+        // Run the statements whenever the timer fires
+        AstDelay* const delayp = VN_AS(nodep->stmtsp(), Delay);
+        AstNode* stmtsp = nullptr;
+        if (delayp->stmtsp()) stmtsp = delayp->stmtsp()->unlinkFrBackWithNext();
+        if (AstNode* const afterp = delayp->nextp()) {
+            stmtsp = AstNode::addNext(stmtsp, afterp->unlinkFrBackWithNext());
+        }
+        addTimerProcess(flp, id, stmtsp);
+        VL_DO_DANGLING(pushDeletep(nodep->unlinkFrBack()), nodep);
+    }
+    // Replace an 'initial' that is a straight sequence of constant delays and timer statements
+    // with a state machine in a process triggered by a one-shot timer. State N runs the
+    // statements after the Nth delay, then re-arms the timer with the next delay.
+    bool lowerDelaySequence(AstInitial* const nodep) {
+        if (!v3Global.opt.fDelayFsm() || m_classp || !hasFlags(nodep, T_SUSPENDEE)
+            || hasFlags(nodep, T_HAS_PROC)) {
+            return false;
+        }
+        // Split into segments, each the delay before it and its statements
+        using Segment = std::pair<uint64_t, std::vector<AstNode*>>;
+        std::vector<Segment> segments(1);
+        std::vector<AstDelay*> delays;
+        const std::function<bool(AstNode*)> gather = [&](AstNode* stmtp) {
+            for (; stmtp; stmtp = stmtp->nextp()) {
+                if (AstDelay* const delayp = VN_CAST(stmtp, Delay)) {
+                    const uint64_t delay = constDelay(delayp);
+                    if (!delay) return false;
+                    delays.push_back(delayp);
+                    segments.emplace_back(delay, std::vector<AstNode*>{});
+                    if (!gather(delayp->stmtsp())) return false;
+                } else if (isTimerStmt(stmtp)) {
+                    segments.back().second.push_back(stmtp);
+                } else {
+                    return false;
+                }
+            }
+            return true;
+        };
+        if (!gather(nodep->stmtsp()) || segments.size() < 2) return false;
+        FileLine* const flp = nodep->fileline();
+        const uint32_t id = m_timerCnt++;
+        UINFO(4, "  Delay sequence timer " << id << " states " << segments.size() - 1 << " "
+                                           << nodep << endl);
+        AstVarScope* const stateVscp
+            = createTemp(flp, m_timerStateNames.get(nodep), nodep->findUInt32DType());
+        const auto unlinkSegment = [](const Segment& segment) {
+            AstNode* stmtsp = nullptr;
+            for (AstNode* const stmtp : segment.second) {
+                stmtsp = AstNode::addNext(stmtsp, stmtp->unlinkFrBack());
+            }
+            return stmtsp;
+        };
+        // Go to the given state: set the state, and arm the timer for its delay
+        const auto enterState = [&](size_t state) -> AstNode* {
+            const bool done = state == segments.size();
+            const uint32_t value = done ? 0 : static_cast<uint32_t>(state);
+            AstNode* const setp = new AstAssign{
+                flp, new AstVarRef{flp, stateVscp, VAccess::WRITE}, new AstConst{flp, value}};
+            if (done) return setp;
+            return AstNode::addNext(
+                setp, createTimerStart(flp, "addTimeout", id, segments[state].first));
+        };
+        // The state machine, as an if chain from the last state
+        AstNode* elsep = nullptr;
+        for (size_t state = segments.size() - 1; state > 0; --state) {
+            AstNode* const thensp = AstNode::addNext(unlinkSegment(segments[state]),
+                                                     enterState(state + 1));
+            AstEq* const condp = new AstEq{flp, new AstVarRef{flp, stateVscp, VAccess::READ},
+                                           new AstConst{flp, static_cast<uint32_t>(state)}};
+            condp->dtypeSetBit();
+            elsep = new AstIf{flp, condp, thensp, elsep};
+        }
+        addTimerProcess(flp, id, elsep);
+        // The initial keeps the statements before the first delay, and starts the timer
+        AstNode* const initsp = AstNode::addNext(unlinkSegment(segments[0]), enterState(1));
+        for (AstDelay* const delayp : delays) {
+            if (delayp->backp()) delayp->unlinkFrBack();
+            pushDeletep(delayp);
+        }
+        nodep->addStmtsp(initsp);
+        return true;
+    }
     // Add a done() call on the fork sync
     void addForkDone(AstBegin* const beginp, AstVarScope* const forkVscp) const {
         FileLine* const flp = beginp->fileline();
@@ -786,6 +955,7 @@ class TimingControlVisitor final : public VNVisitor {
         if (hasFlags(nodep, T_HAS_PROC)) nodep->setNeedProcess();
     }
     void visit(AstInitial* nodep) override {
+        if (lowerDelaySequence(nodep)) return;
         visit(static_cast<AstNodeProcedure*>(nodep));
         if (nodep->needProcess() && !nodep->user1SetOnce()) {
             nodep->addStmtsp(
@@ -799,6 +969,10 @@ class TimingControlVisitor final : public VNVisitor {
     }
     void visit(AstAlways* nodep) override {
         if (nodep->user1SetOnce()) return;
+        if (const uint64_t period = periodicDelay(nodep)) {
+            lowerPeriodic(nodep, period);
+            return;
+        }
         VL_RESTORER(m_procp);
         m_procp = nodep;
         VL_RESTORER(m_underProcedure);
@@ -572,6 +572,16 @@ class TraceVisitor final : public VNVisitor {
         return funcp;
     }
 
+    void addEnabledCheck(AstCFunc* funcp, uint32_t loCode, uint32_t hiCode) {
+        // Skip sub function at runtime if all its signals are excluded by
+        // dumpvars or traceScopes, this also skips the activity checks
+        const std::string base = "vlSymsp->__Vm_baseCode + ";
+        const std::string cond = "bufp->anyEnabled(" + base + cvtToStr(loCode) + ", " + base
+                                 + cvtToStr(hiCode) + ")";
+        funcp->addInitsp(
+            new AstCStmt{funcp->fileline(), "if (VL_UNLIKELY(!" + cond + ")) return;\n"});
+    }
+
     void createConstTraceFunctions(const TraceVec& traces) {
         const int splitLimit = v3Global.opt.outputSplitCTrace() ? v3Global.opt.outputSplitCTrace()
                                                                 : std::numeric_limits<int>::max();
@@ -641,6 +651,12 @@ class TraceVisitor final : public VNVisitor {
             const ActCodeSet* prevActSet = nullptr;
             AstIf* ifp = nullptr;
             uint32_t baseCode = 0;
+            uint32_t endCode = 0;
+            const auto finishSubFuncs = [&]() {
+                if (!subFulFuncp) return;
+                addEnabledCheck(subFulFuncp, baseCode, endCode);
+                addEnabledCheck(subChgFuncp, baseCode, endCode);
+            };
             for (; nCodes < maxCodes && it != traces.end(); ++it) {
                 const ActCodeSet& actSet = it->first;
                 // Traced value never changes, no need to add it
@@ -665,6 +681,7 @@ class TraceVisitor final : public VNVisitor {
 
                 // Create new sub function if required
                 if (!subFulFuncp || subStmts > splitLimit) {
+                    finishSubFuncs();
                     baseCode = declp->code();
                     subStmts = 0;
                     subFulFuncp = newCFunc(VTraceType::FULL, topFulFuncp, subFuncNum, baseCode);
@@ -718,7 +735,9 @@ class TraceVisitor final : public VNVisitor {
 
                 // Track partitioning
                 nCodes += declp->codeInc();
+                endCode = std::max(endCode, declp->code() + declp->codeInc());
             }
+            finishSubFuncs();
         }
     }
 
@@ -852,10 +871,12 @@ class TraceVisitor final : public VNVisitor {
             if (AstCCall* const callp = VN_CAST(nodep->exprp(), CCall)) {
                 UINFO(8, "   CCALL " << callp);
                 // See if there are other calls in same statement list;
-                // If so, all funcs might share the same activity code
+                // If so, all funcs might share the same activity code, unless
+                // each call should have its own.
                 TraceActivityVertex* const activityVtxp
                     = getActivityVertexp(nodep, callp->funcp()->slow());
-                for (AstNode* nextp = nodep; nextp; nextp = nextp->nextp()) {
+                AstNode* const lastp = v3Global.opt.traceFineActivity() ? nodep->nextp() : nullptr;
+                for (AstNode* nextp = nodep; nextp != lastp; nextp = nextp->nextp()) {
                     if (AstStmtExpr* const stmtp = VN_CAST(nextp, StmtExpr)) {
                         if (AstCCall* const ccallp = VN_CAST(stmtp->exprp(), CCall)) {
                             stmtp->user2(true);  // Processed
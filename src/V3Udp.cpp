@@ -20,6 +20,10 @@
 //
 // 0 1 0 on a, b, c turns into !a&b&~c
 //
+// A combinational table with few inputs, that gives a 0 or 1 output for
+// every combination of them, instead becomes a single lookup of the
+// output bit in a constant truth table, indexed by the inputs.
+//
 //*************************************************************************
 
 #include "V3PchAstNoMT.h"  // VL_MT_DISABLED_CODE_UNIT
@@ -27,11 +31,14 @@
 #include "V3Udp.h"
 
 #include "V3Error.h"
+#include "V3Stats.h"
 
 #include <vector>
 
 VL_DEFINE_DEBUG_FUNCTIONS;
 
+constexpr size_t UDP_LOOKUP_MAX_INPUTS = 8;  // Most inputs of a table made into a lookup
+
 class UdpVisitor final : public VNVisitor {
     bool m_inInitial = false;  // Is inside of an initial block
     AstVar* m_oFieldVarp = nullptr;  // Output filed var of table line
@@ -41,6 +48,7 @@ class UdpVisitor final : public VNVisitor {
     bool m_isFirstOutput = false;  // Whether the first IO port is output
     AstVarRef* m_outputInitVerfp = nullptr;  // Initial output value for sequential UDP
     AstAlways* m_alwaysBlockp = nullptr;  // Main Always block in UDP transform
+    VDouble0 m_statLookups;  // Statistic tracking
 
     void visit(AstInitial* nodep) override {
         VL_RESTORER(m_inInitial);
@@ -97,6 +105,22 @@ class UdpVisitor final : public VNVisitor {
         fl->warnOff(V3ErrorCode::LATCH, true);
         iterateChildren(nodep);
 
+        if (AstConst* const tablep = truthTable(nodep)) {
+            // Replace the if per line with the lookup
+            ++m_statLookups;
+            if (AstNode* const stmtsp = m_alwaysBlockp->stmtsp()) {
+                pushDeletep(stmtsp->unlinkFrBackWithNext());
+            }
+            AstNodeExpr* indexp = new AstVarRef{fl, m_inputVars[0], VAccess::READ};
+            for (size_t i = 1; i < m_inputVars.size(); ++i) {
+                indexp = new AstConcat{fl, new AstVarRef{fl, m_inputVars[i], VAccess::READ},
+                                       indexp};
+            }
+            m_alwaysBlockp->addStmtsp(
+                new AstAssign{fl, new AstVarRef{fl, m_oFieldVarp, VAccess::WRITE},
+                              new AstSel{fl, tablep, indexp, 1}});
+        }
+
         nodep->replaceWith(m_alwaysBlockp);
     }
     void visit(AstUdpTableLine* nodep) override {
@@ -183,6 +207,47 @@ class UdpVisitor final : public VNVisitor {
     void visit(AstLogAnd* nodep) override { iterateChildren(nodep); }
     void visit(AstLogNot* nodep) override { iterateChildren(nodep); }
     // For logic processing.
+    // Return the output of a combinational table for each combination of the inputs, as a
+    // constant with the output for inputs {..., in[1], in[0]} at that bit index, or nullptr
+    // if an output is x, or some combination has no line, so keeps the previous value.
+    AstConst* truthTable(AstUdpTable* nodep) {
+        const size_t nInputs = m_inputVars.size();
+        if (nInputs < 1 || nInputs > UDP_LOOKUP_MAX_INPUTS) return nullptr;
+        if (m_alwaysBlockp->nextp()) return nullptr;  // Has sequential lines
+        const uint32_t combinations = 1U << nInputs;
+        std::vector<int> outputs(combinations, -1);  // -1 until a line gives the output
+        for (AstUdpTableLine* linep = nodep->linesp(); linep;
+             linep = VN_AS(linep->nextp(), UdpTableLine)) {
+            if (!linep->udpIsCombo() || !linep->oFieldsp()) return nullptr;
+            // Inputs other than 0 or 1 match either value, as in the if per line
+            uint32_t care = 0;
+            uint32_t value = 0;
+            size_t i = 0;
+            for (AstNode* iNodep = linep->iFieldsp(); iNodep && i < nInputs;
+                 iNodep = iNodep->nextp(), ++i) {
+                std::string valName = iNodep->name();
+                isEdgeTrig(valName);
+                if (valName == "0") {
+                    care |= 1U << i;
+                } else if (valName == "1") {
+                    care |= 1U << i;
+                    value |= 1U << i;
+                }
+            }
+            const std::string& oValName = linep->oFieldsp()->name();
+            if (oValName != "0" && oValName != "1") return nullptr;
+            // Later lines win, as do later ifs
+            for (uint32_t combination = 0; combination < combinations; ++combination) {
+                if ((combination & care) == value) outputs[combination] = oValName == "1";
+            }
+        }
+        V3Number num{nodep, static_cast<int>(combinations)};
+        for (uint32_t combination = 0; combination < combinations; ++combination) {
+            if (outputs[combination] < 0) return nullptr;
+            num.setBit(combination, outputs[combination]);
+        }
+        return new AstConst{nodep->fileline(), num};
+    }
     bool isEdgeTrig(std::string& valName) {
         if (valName == "*") return true;
         if (valName == "01" || valName == "p" || valName == "P" || valName == "r"
@@ -227,7 +292,9 @@ class UdpVisitor final : public VNVisitor {
 public:
     // CONSTRUCTORS
     explicit UdpVisitor(AstNetlist* nodep) { iterate(nodep); }
-    ~UdpVisitor() override = default;
+    ~UdpVisitor() override {
+        V3Stats::addStat("Optimizations, UDP tables as lookups", m_statLookups);
+    }
 };
 
 void V3Udp::udpResolve(AstNetlist* rootp) {
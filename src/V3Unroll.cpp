@@ -22,6 +22,14 @@
 //      (Eventually, a better way would be to simulate the entire loop; ala V3Table.)
 //      Convert remaining FORs to WHILEs
 //
+//      A loop within --unroll-count iterations is unrolled if the unrolled
+//      body is within --unroll-stmts, measuring the body after constant
+//      folding with the loop variable replaced.  Loops indexing arrays or
+//      bit selects with the loop variable, which become constant selects
+//      for V3Table and DFG, may have up to UNROLL_INDEX_MULT times more
+//      iterations if the unrolled code stays as small.  Other loops with a
+//      known trip count may be partially unrolled with --unroll-partial.
+//
 //*************************************************************************
 
 #include "V3PchAstNoMT.h"  // VL_MT_DISABLED_CODE_UNIT
@@ -38,6 +46,10 @@ VL_DEFINE_DEBUG_FUNCTIONS;
 // Unroll state, as a visitor of each AstNode
 
 class UnrollVisitor final : public VNVisitor {
+    // TYPES
+    // Extra iterations allowed when unrolling makes indices constant
+    static constexpr int UNROLL_INDEX_MULT = 4;
+
     // STATE
     AstVar* m_forVarp;  // Iterator variable
     const AstVarScope* m_forVscp;  // Iterator variable scope (nullptr for generate pass)
@@ -51,6 +63,7 @@ class UnrollVisitor final : public VNVisitor {
     string m_beginName;  // What name to give begin iterations
     VDouble0 m_statLoops;  // Statistic tracking
     VDouble0 m_statIters;  // Statistic tracking
+    VDouble0 m_statPartial;  // Statistic tracking
 
     // METHODS
 
@@ -78,6 +91,70 @@ class UnrollVisitor final : public VNVisitor {
         return bodySizeOverRecurse(nodep->nextp(), bodySize, bodyLimit);
     }
 
+    // True if the loop variable is used in the index of a select
+    bool indexedByLoopVar(AstNode* nodep) const {
+        const auto refsLoopVar = [this](AstNode* exprp) {
+            return exprp && exprp->exists([this](const AstVarRef* refp) {
+                return refp->varp() == m_forVarp && refp->varScopep() == m_forVscp;
+            });
+        };
+        for (; nodep; nodep = nodep->nextp()) {
+            if (nodep->exists([&](AstNodeSel* selp) { return refsLoopVar(selp->bitp()); })
+                || nodep->exists([&](AstSel* selp) { return refsLoopVar(selp->lsbp()); })) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Size of one iteration after constant folding, with the loop variable
+    // replaced by 'loopValue'
+    int foldedSize(AstNode* stmtsp, const V3Number& loopValue) {
+        if (!stmtsp) return 0;
+        AstBegin* const tempp
+            = new AstBegin{stmtsp->fileline(), "[EditWrapper]", stmtsp->cloneTree(true)};
+        m_varValuep = new AstConst{stmtsp->fileline(), loopValue};
+        m_varModeReplace = true;
+        iterateAndNextNull(tempp->stmtsp());
+        m_varModeReplace = false;
+        VL_DO_CLEAR(pushDeletep(m_varValuep), m_varValuep = nullptr);
+        for (AstNode* nodep = tempp->stmtsp(); nodep;) {
+            AstNode* const nextp = nodep->nextp();
+            V3Const::constifyEdit(nodep);  // nodep may change
+            nodep = nextp;
+        }
+        int size = 0;
+        bodySizeOverRecurse(tempp->stmtsp(), size, std::numeric_limits<int>::max());
+        VL_DO_DANGLING(tempp->deleteTree(), tempp);
+        return size;
+    }
+
+    // Largest factor up to --unroll-partial dividing the trip count, with the
+    // partially unrolled body within --unroll-stmts; 0 if none
+    static int partialFactor(int loops, int size) {
+        for (int factor = v3Global.opt.unrollPartial(); factor >= 2; --factor) {
+            if (loops % factor == 0 && factor * size <= v3Global.opt.unrollStmts()) {
+                return factor;
+            }
+        }
+        return 0;
+    }
+
+    // Unroll 'factor' iterations into each iteration of the loop. The trip
+    // count is a multiple of 'factor', so the condition is only tested once.
+    void partialUnroll(AstWhile* nodep, int factor) {
+        UINFO(4, "   Partial unroll by " << factor << " :" << nodep);
+        AstNode* const stmtsp = nodep->stmtsp()->unlinkFrBackWithNext();
+        AstNode* newp = nullptr;
+        for (int i = 0; i < factor; ++i) {
+            if (i) newp = AstNode::addNext(newp, nodep->incsp()->cloneTree(true));
+            newp = AstNode::addNext(newp, stmtsp->cloneTree(true));
+        }
+        VL_DO_DANGLING(pushDeletep(stmtsp), stmtsp);
+        nodep->addStmtsp(newp);
+        ++m_statPartial;
+    }
+
     bool forUnrollCheck(
         AstNode* const nodep,
         const VOptionBool& unrollFull,  // Pragma unroll_full, unroll_disable
@@ -163,7 +240,12 @@ class UnrollVisitor final : public VNVisitor {
             // Check whether to we actually want to try and unroll.
             int loops;
             const int limit = v3Global.opt.unrollCountAdjusted(unrollFull, m_generate, false);
-            if (!countLoops(initAssp, condp, incp, limit, loops)) {
+            // Count further if more iterations might still be unrolled
+            const int countLimit = unrollFull.isSetTrue() ? limit
+                                   : v3Global.opt.unrollPartial() >= 2
+                                       ? std::max(limit, limit * 16)
+                                       : std::max(limit, limit * UNROLL_INDEX_MULT);
+            if (!countLoops(initAssp, condp, incp, countLimit, loops)) {
                 return cantUnroll(nodep, "Unable to simulate loop");
             }
 
@@ -172,10 +254,37 @@ class UnrollVisitor final : public VNVisitor {
                 int bodySize = 0;
                 int bodyLimit = v3Global.opt.unrollStmts();
                 if (loops > 0) bodyLimit = v3Global.opt.unrollStmts() / loops;
-                if (bodySizeOverRecurse(precondsp, bodySize /*ref*/, bodyLimit)
+                if (loops > limit || bodySizeOverRecurse(precondsp, bodySize /*ref*/, bodyLimit)
                     || bodySizeOverRecurse(bodysp, bodySize /*ref*/, bodyLimit)
                     || bodySizeOverRecurse(incp, bodySize /*ref*/, bodyLimit)) {
-                    return cantUnroll(nodep, "too many statements");
+                    // Too large as written, so consider the size after folding
+                    V3Number loopValue{initAssp};
+                    if (!simulateTree(initAssp->rhsp(), nullptr, initAssp, loopValue)) {
+                        return cantUnroll(nodep, "Unable to simulate loop");
+                    }
+                    const int size = foldedSize(precondsp, loopValue)
+                                     + foldedSize(bodysp, loopValue)
+                                     + foldedSize(incp, loopValue);
+                    UINFO(6, "   Loops " << loops << " folded size " << size);
+                    const bool constIndex = indexedByLoopVar(precondsp)
+                                            || indexedByLoopVar(bodysp);
+                    const int64_t unrolledSize = static_cast<int64_t>(loops) * size;
+                    const bool unroll
+                        = loops <= limit ? unrolledSize <= v3Global.opt.unrollStmts()
+                                         : (constIndex && loops <= limit * UNROLL_INDEX_MULT
+                                            && unrolledSize * UNROLL_INDEX_MULT
+                                                   <= v3Global.opt.unrollStmts());
+                    if (!unroll) {
+                        AstWhile* const whilep = VN_CAST(nodep, While);
+                        const int factor = partialFactor(loops, size);
+                        if (whilep && !precondsp && whilep->stmtsp() && whilep->incsp()
+                            && factor) {
+                            partialUnroll(whilep, factor);
+                            return false;
+                        }
+                        return cantUnroll(nodep, loops > limit ? "too many iterations"
+                                                               : "too many statements");
+                    }
                 }
             }
         }
@@ -337,8 +446,8 @@ class UnrollVisitor final : public VNVisitor {
                     }
 
                     ++m_statIters;
-                    const int limit
-                        = v3Global.opt.unrollCountAdjusted(unrollFull, m_generate, false);
+                    int limit = v3Global.opt.unrollCountAdjusted(unrollFull, m_generate, false);
+                    if (!m_generate) limit = std::max(limit, limit * UNROLL_INDEX_MULT);
                     if (++times / 3 > limit) {
                         nodep->v3error(
                             "Loop unrolling took too long;"
@@ -494,6 +603,7 @@ public:
     ~UnrollVisitor() override {
         V3Stats::addStatSum("Optimizations, Unrolled Loops", m_statLoops);
         V3Stats::addStatSum("Optimizations, Unrolled Iterations", m_statIters);
+        V3Stats::addStatSum("Optimizations, Partially unrolled loops", m_statPartial);
     }
     // METHODS
     void init(bool generate, const string& beginName) {
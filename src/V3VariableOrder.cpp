@@ -25,11 +25,16 @@
 #include "V3VariableOrder.h"
 
 #include "V3AstUserAllocator.h"
+#include "V3Control.h"
 #include "V3EmitCBase.h"
 #include "V3ExecGraph.h"
 #include "V3TSP.h"
 #include "V3ThreadPool.h"
 
+#include <limits>
+#include <set>
+#include <tuple>
+#include <unordered_set>
 #include <vector>
 
 VL_DEFINE_DEBUG_FUNCTIONS;
@@ -46,18 +51,30 @@ class GatherMTaskAffinity final : VNVisitorConst {
 
     // STATE
     MTaskAffinityMap& m_results;  // The result map being built;
+    MTaskAffinityMap& m_writes;  // As m_results, but only for MTasks writing the variable
     const uint32_t m_id;  // Id of mtask being analysed
     const size_t m_usedIds = ExecMTask::numUsedIds();  // Value of max id + 1
 
     // CONSTRUCTOR
-    GatherMTaskAffinity(const ExecMTask* mTaskp, MTaskAffinityMap& results)
+    GatherMTaskAffinity(const ExecMTask* mTaskp, MTaskAffinityMap& results,
+                        MTaskAffinityMap& writes)
         : m_results{results}
+        , m_writes{writes}
         , m_id{mTaskp->id()} {
         iterateChildrenConst(mTaskp->bodyp());
     }
     ~GatherMTaskAffinity() = default;
     VL_UNMOVABLE(GatherMTaskAffinity);
 
+    // METHODS
+    MTaskIdVec& affinity(MTaskAffinityMap& map, const AstVar* varp) {
+        return map
+            .emplace(std::piecewise_construct,  //
+                     std::forward_as_tuple(varp),  //
+                     std::forward_as_tuple(m_usedIds))
+            .first->second;
+    }
+
     // VISIT
     void visit(AstNodeVarRef* nodep) override {
         // Cheaper than relying on emplace().second
@@ -67,12 +84,8 @@ class GatherMTaskAffinity final : VNVisitorConst {
         AstBasicDType* const basicp = varp->dtypep()->basicp();
         if (basicp && basicp->isTriggerVec()) return;
         // Set affinity bit
-        MTaskIdVec& affinity = m_results
-                                   .emplace(std::piecewise_construct,  //
-                                            std::forward_as_tuple(varp),  //
-                                            std::forward_as_tuple(m_usedIds))
-                                   .first->second;
-        affinity[m_id] = true;
+        affinity(m_results, varp)[m_id] = true;
+        if (nodep->access().isWriteOrRW()) affinity(m_writes, varp)[m_id] = true;
     }
 
     void visit(AstCFunc* nodep) override {
@@ -88,8 +101,9 @@ class GatherMTaskAffinity final : VNVisitorConst {
     void visit(AstNode* nodep) override { iterateChildrenConst(nodep); }
 
 public:
-    static void apply(const ExecMTask* mTaskp, MTaskAffinityMap& results) {
-        GatherMTaskAffinity{mTaskp, results};
+    static void apply(const ExecMTask* mTaskp, MTaskAffinityMap& results,
+                      MTaskAffinityMap& writes) {
+        GatherMTaskAffinity{mTaskp, results, writes};
     }
 };
 
@@ -128,6 +142,11 @@ public:
 
 uint32_t VarTspSorter::s_serialNext = 0;
 
+struct VariableOrderStats final {
+    size_t m_coldVars = 0;  // Number of variables placed cold by profile
+    size_t m_sharedLines = 0;  // Estimated cache lines false shared across threads
+};
+
 struct VarAttributes final {
     uint8_t stratum;  // Roughly equivalent to alignment requirement, to avoid padding
     bool anonOk;  // Can be emitted as part of anonymous structure
@@ -135,13 +154,30 @@ struct VarAttributes final {
 class VariableOrder final {
     std::unordered_map<const AstVar*, VarAttributes> m_attributes;
 
+    // Thread of MTasks not assigned to a worker, i.e.: the thread calling eval
+    static constexpr int MAIN_THREAD = std::numeric_limits<int>::max() - 1;
+    // Writer key of variables written by several threads
+    static constexpr int SEVERAL_THREADS = std::numeric_limits<int>::max();
+
     const MTaskAffinityMap& m_mTaskAffinity;
+    const MTaskAffinityMap& m_mTaskWrites;  // As m_mTaskAffinity, but only writing MTasks
+    const std::vector<int>& m_mTaskWorkers;  // Thread pool worker of each MTask, by ID
+    const std::vector<uint64_t>& m_mTaskProfiles;  // Profiled cost of each MTask, by ID
     std::vector<AstVar*>& m_varps;
+    VariableOrderStats& m_stats;
+    const bool m_padLines;  // Start segments on new cache lines, only for module classes
 
     VariableOrder(AstNodeModule* modp, const MTaskAffinityMap& mTaskAffinity,
-                  std::vector<AstVar*>& varps)
+                  const MTaskAffinityMap& mTaskWrites, const std::vector<int>& mTaskWorkers,
+                  const std::vector<uint64_t>& mTaskProfiles, std::vector<AstVar*>& varps,
+                  VariableOrderStats& stats)
         : m_mTaskAffinity{mTaskAffinity}
-        , m_varps{varps} {
+        , m_mTaskWrites{mTaskWrites}
+        , m_mTaskWorkers{mTaskWorkers}
+        , m_mTaskProfiles{mTaskProfiles}
+        , m_varps{varps}
+        , m_stats{stats}
+        , m_padLines{!VN_IS(modp, Class)} {
         orderModuleVars(modp);
     }
     ~VariableOrder() = default;
@@ -168,6 +204,53 @@ class VariableOrder final {
                     });
     }
 
+    // Return the worker running all the given MTasks, or -1 if none or several
+    int ownerWorker(const MTaskIdVec& mTaskIds) const {
+        int owner = -1;
+        for (size_t i = 0; i < mTaskIds.size(); ++i) {
+            if (!mTaskIds[i]) continue;
+            const int worker = m_mTaskWorkers.at(i);
+            if (worker < 0 || (owner >= 0 && worker != owner)) return -1;
+            owner = worker;
+        }
+        return owner;
+    }
+
+    // Return the threads running the given MTasks
+    std::set<int> threadsOf(const MTaskIdVec& mTaskIds) const {
+        std::set<int> threads;
+        for (size_t i = 0; i < mTaskIds.size(); ++i) {
+            if (!mTaskIds[i]) continue;
+            const int worker = m_mTaskWorkers.at(i);
+            threads.insert(worker < 0 ? MAIN_THREAD : worker);
+        }
+        return threads;
+    }
+    std::set<int> accessThreads(const AstVar* varp) const {
+        const auto it = m_mTaskAffinity.find(varp);
+        return it == m_mTaskAffinity.end() ? std::set<int>{} : threadsOf(it->second);
+    }
+    std::set<int> writeThreads(const AstVar* varp) const {
+        const auto it = m_mTaskWrites.find(varp);
+        return it == m_mTaskWrites.end() ? std::set<int>{} : threadsOf(it->second);
+    }
+
+    // Return the thread writing the variable, -1 if none, or SEVERAL_THREADS
+    int writerKey(const AstVar* varp) const {
+        const std::set<int> writers = writeThreads(varp);
+        if (writers.empty()) return -1;
+        return writers.size() == 1 ? *writers.begin() : SEVERAL_THREADS;
+    }
+
+    // Return the summed profiled cost of the given MTasks, 0 if no profile data
+    uint64_t profiledHeat(const MTaskIdVec& mTaskIds) const {
+        uint64_t heat = 0;
+        for (size_t i = 0; i < mTaskIds.size(); ++i) {
+            if (mTaskIds[i]) heat += m_mTaskProfiles.at(i);
+        }
+        return heat;
+    }
+
     // Sort by MTask-affinity first, then the same as simpleSortVars
     void tspSortVars(std::vector<AstVar*>& varps) {
         // Map from "MTask affinity" -> "variable list"
@@ -191,23 +274,134 @@ class VariableOrder final {
         V3TSP::StateVec sortedStates;
         V3TSP::tspSort(states, &sortedStates);
 
-        varps.clear();
+        // With profile data, variables only used by MTasks that measured under
+        // 1% of the hottest set's cost are cold, and go after all hot variables,
+        // keeping the hot ones used together in _eval on fewer cache lines
+        std::unordered_set<const V3TSP::TspStateBase*> coldStates;
+        if (V3Control::containsMTaskProfileData()) {
+            uint64_t maxHeat = 0;
+            for (const V3TSP::TspStateBase* const stateBasep : sortedStates) {
+                const VarTspSorter* const statep = dynamic_cast<const VarTspSorter*>(stateBasep);
+                maxHeat = std::max(maxHeat, profiledHeat(statep->mTaskIds()));
+            }
+            for (const V3TSP::TspStateBase* const stateBasep : sortedStates) {
+                const VarTspSorter* const statep = dynamic_cast<const VarTspSorter*>(stateBasep);
+                if (profiledHeat(statep->mTaskIds()) * 100 < maxHeat) coldStates.insert(statep);
+            }
+        }
 
-        // Helper function to sort given vector, then append to 'varps'
-        const auto sortAndAppend = [this, &varps](std::vector<AstVar*>& subVarps) {
-            simpleSortVars(subVarps);
-            for (AstVar* const varp : subVarps) varps.push_back(varp);
+        // Group the variables used by a single worker together, so the model
+        // can place them on that worker's NUMA node, see VlThreadPool::numaPlace
+        const auto groupOf = [&](const V3TSP::TspStateBase* stateBasep) {
+            const bool cold = coldStates.count(stateBasep);
+            const VarTspSorter* const statep = dynamic_cast<const VarTspSorter*>(stateBasep);
+            const int owner = cold ? -1 : ownerWorker(statep->mTaskIds());
+            return std::make_pair(cold, owner < 0 ? std::numeric_limits<int>::max() : owner);
         };
+        std::stable_sort(sortedStates.begin(), sortedStates.end(),
+                         [&](const V3TSP::TspStateBase* ap, const V3TSP::TspStateBase* bp) {
+                             return groupOf(ap) < groupOf(bp);
+                         });
+
+        // Within the hot variables not owned by one worker, keep those written
+        // by the same thread together, as a segment starting on its own cache
+        // line, so threads writing their own state do not false share lines.
+        // The segments are keyed by (cold, owner group, writer), in order.
+        std::map<std::tuple<bool, int, int>, std::vector<AstVar*>> segments;
 
         // Enumerate by sorted MTaskIdSet, sort within the set separately
         for (const V3TSP::TspStateBase* const stateBasep : sortedStates) {
             const VarTspSorter* const statep = dynamic_cast<const VarTspSorter*>(stateBasep);
-            sortAndAppend(m2v[statep->mTaskIds()]);
+            std::vector<AstVar*>& subVarps = m2v[statep->mTaskIds()];
+            // Cold variables are not contiguous with their worker's group
+            const bool cold = coldStates.count(statep);
+            const int owner = cold ? -1 : ownerWorker(statep->mTaskIds());
+            if (cold) m_stats.m_coldVars += subVarps.size();
+            std::map<int, std::vector<AstVar*>> writerVarps;
+            for (AstVar* const varp : subVarps) {
+                varp->ownerWorker(owner);
+                writerVarps[cold || owner >= 0 ? -1 : writerKey(varp)].push_back(varp);
+            }
+            const int group = groupOf(statep).second;
+            for (auto& pair : writerVarps) {
+                simpleSortVars(pair.second);
+                std::vector<AstVar*>& segVarps
+                    = segments[std::make_tuple(cold, group, pair.first)];
+                segVarps.insert(segVarps.end(), pair.second.begin(), pair.second.end());
+            }
             VL_DO_DANGLING(delete statep, statep);
         }
 
         // Finally add the variables with no known MTask affinity
-        sortAndAppend(m2v[emptyVec]);
+        std::vector<AstVar*>& restVarps = m2v[emptyVec];
+        simpleSortVars(restVarps);
+
+        varps.clear();
+        const bool pad = m_padLines && segments.size() + !restVarps.empty() > 1;
+        const auto append = [&](const std::vector<AstVar*>& segVarps) {
+            bool start = pad;
+            for (AstVar* const varp : segVarps) {
+                if (start && isMember(varp)) {
+                    start = false;
+                    varp->setCacheLineStart();
+                }
+                varps.push_back(varp);
+            }
+        };
+        for (const auto& pair : segments) append(pair.second);
+        append(restVarps);
+
+        m_stats.m_sharedLines = countSharedLines(varps);
+    }
+
+    // Variables that V3EmitCHeaders declares as members of the module's class
+    static bool isMember(const AstVar* varp) {
+        return !varp->isStatic()
+               && (varp->isIO() || varp->isSignal() || varp->isClassMember() || varp->isTemp()
+                   || varp->isGenVar());
+    }
+
+    // Estimate the number of cache lines holding several variables, one
+    // written by a thread and another accessed by a different thread
+    size_t countSharedLines(const std::vector<AstVar*>& varps) const {
+        struct LineUse final {
+            std::set<int> m_accessThreads;  // Threads accessing any variable on the line
+            std::set<int> m_writeThreads;  // Threads writing any variable on the line
+            size_t m_vars = 0;  // Number of variables on the line
+        };
+        std::map<size_t, LineUse> lines;
+        size_t offset = 0;
+        for (const AstVar* const varp : varps) {
+            if (!isMember(varp)) continue;
+            const AstNodeDType* const dtypep = varp->dtypeSkipRefp();
+            // Opaque types such as strings and queues are roughly a few pointers
+            const size_t size = std::max(dtypep->widthTotalBytes(), 8);
+            const size_t align = varp->cacheLineStart()
+                                     ? VL_CACHE_LINE_BYTES
+                                     : std::min(std::max(dtypep->widthAlignBytes(), 1), 8);
+            offset = (offset + align - 1) / align * align;
+            const std::set<int> accesses = accessThreads(varp);
+            const std::set<int> writes = writeThreads(varp);
+            // Only the first and last lines can hold other variables
+            const size_t firstLine = offset / VL_CACHE_LINE_BYTES;
+            const size_t lastLine = (offset + size - 1) / VL_CACHE_LINE_BYTES;
+            for (const size_t line : {firstLine, lastLine}) {
+                LineUse& use = lines[line];
+                use.m_accessThreads.insert(accesses.begin(), accesses.end());
+                use.m_writeThreads.insert(writes.begin(), writes.end());
+                ++use.m_vars;
+                if (firstLine == lastLine) break;
+            }
+            offset += size;
+        }
+        size_t shared = 0;
+        for (const auto& pair : lines) {
+            const LineUse& use = pair.second;
+            if (use.m_vars > 1 && !use.m_writeThreads.empty() && use.m_accessThreads.size() > 1) {
+                ++shared;
+            }
+        }
+        return shared;
     }
 
     void orderModuleVars(AstNodeModule* modp) {
@@ -245,8 +439,12 @@ class VariableOrder final {
 
 public:
     static void processModule(AstNodeModule* modp, const MTaskAffinityMap& mTaskAffinity,
-                              std::vector<AstVar*>& varps) VL_MT_STABLE {
-        VariableOrder{modp, mTaskAffinity, varps};
+                              const MTaskAffinityMap& mTaskWrites,
+                              const std::vector<int>& mTaskWorkers,
+                              const std::vector<uint64_t>& mTaskProfiles,
+                              std::vector<AstVar*>& varps,
+                              VariableOrderStats& stats) VL_MT_STABLE {
+        VariableOrder{modp, mTaskAffinity, mTaskWrites, mTaskWorkers, mTaskProfiles, varps, stats};
     }
 };
 
@@ -257,12 +455,19 @@ void V3VariableOrder::orderAll(AstNetlist* netlistp) {
     UINFO(2, __FUNCTION__ << ":");
 
     MTaskAffinityMap mTaskAffinity;
+    MTaskAffinityMap mTaskWrites;
+    std::vector<int> mTaskWorkers(ExecMTask::numUsedIds(), -1);
+    std::vector<uint64_t> mTaskProfiles(ExecMTask::numUsedIds(), 0);
 
     // Gather MTask affinities
     if (v3Global.opt.mtasks()) {
         netlistp->topModulep()->foreach([&](AstExecGraph* execGraphp) {
             for (const V3GraphVertex& vtx : execGraphp->depGraphp()->vertices()) {
-                GatherMTaskAffinity::apply(vtx.as<const ExecMTask>(), mTaskAffinity);
+                const ExecMTask* const mtaskp = vtx.as<const ExecMTask>();
+                GatherMTaskAffinity::apply(mtaskp, mTaskAffinity, mTaskWrites);
+                mTaskWorkers.at(mtaskp->id()) = mtaskp->worker();
+                mTaskProfiles.at(mtaskp->id())
+                    = V3Control::getProfileData(v3Global.opt.prefix(), mtaskp->hashName());
             }
         });
     }
@@ -270,14 +475,18 @@ void V3VariableOrder::orderAll(AstNetlist* netlistp) {
 
     // Sort variables for each module
     std::unordered_map<AstNodeModule*, std::vector<AstVar*>> sortedVars;
+    std::unordered_map<AstNodeModule*, VariableOrderStats> moduleStats;
     {
         V3ThreadScope threadScope;
 
         for (AstNodeModule* modp = v3Global.rootp()->modulesp(); modp;
              modp = VN_AS(modp->nextp(), NodeModule)) {
             std::vector<AstVar*>& varps = sortedVars[modp];
-            threadScope.enqueue([modp, mTaskAffinity, &varps]() {
-                VariableOrder::processModule(modp, mTaskAffinity, varps);
+            VariableOrderStats& stats = moduleStats[modp];
+            threadScope.enqueue([modp, mTaskAffinity, &mTaskWrites, &mTaskWorkers,
+                                 &mTaskProfiles, &varps, &stats]() {
+                VariableOrder::processModule(modp, mTaskAffinity, mTaskWrites, mTaskWorkers,
+                                             mTaskProfiles, varps, stats);
             });
         }
     }
@@ -285,9 +494,13 @@ void V3VariableOrder::orderAll(AstNetlist* netlistp) {
 
     // Insert them back under the module, in the new order, but at
     // the front of the list so they come out first in dumps/XML.
+    size_t ownedVars = 0;
     for (AstNodeModule* modp = v3Global.rootp()->modulesp(); modp;
          modp = VN_AS(modp->nextp(), NodeModule)) {
         const std::vector<AstVar*>& varps = sortedVars[modp];
+        for (const AstVar* const varp : varps) {
+            if (varp->ownerWorker() >= 0) ++ownedVars;
+        }
 
         if (!varps.empty()) {
             auto it = varps.cbegin();
@@ -306,6 +519,20 @@ void V3VariableOrder::orderAll(AstNetlist* netlistp) {
         }
     }
 
+    if (v3Global.opt.mtasks()) {
+        VariableOrderStats totals;
+        for (const auto& pair : moduleStats) {
+            totals.m_coldVars += pair.second.m_coldVars;
+            totals.m_sharedLines += pair.second.m_sharedLines;
+        }
+        V3Stats::addStat("Optimizations, Variables owned by one worker", ownedVars);
+        V3Stats::addStat("Optimizations, Cache lines shared across threads (estimated)",
+                         totals.m_sharedLines);
+        if (V3Control::containsMTaskProfileData()) {
+            V3Stats::addStat("Optimizations, Variables placed cold by profile", totals.m_coldVars);
+        }
+    }
+
     // Done
     V3Global::dumpCheckGlobalTree("variableorder", 0, dumpTreeEitherLevel() >= 3);
 }
@@ -0,0 +1,134 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//*************************************************************************
+// DESCRIPTION: Verilator: Set VPI dirty flags on public signal writes
+//
+// Code available from: https://verilator.org
+//
+//*************************************************************************
+//
+// Copyright 2025 by Wilson Snyder. This program is free software; you
+// can redistribute it and/or modify it under the terms of either the GNU
+// Lesser General Public License Version 3 or the Perl Artistic License
+// Version 2.0.
+// SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+//
+//*************************************************************************
+// V3VpiDirty's Transformations:
+//
+// Scoped netlist, after scheduling, with --vpi-dirty:
+//   For each VPI public variable only ever written as the target of an
+//   assignment, create a companion '<name>__Vvpidirty' flag, and set it
+//   after every such assignment.  V3EmitCSyms registers the flag with
+//   the variable, and cbValueChange compares only flagged variables.
+//
+//   Variables written any other way (method calls, DPI arguments,
+//   $readmem, etc.) get no flag, and are compared on every call.
+//
+//*************************************************************************
+
+#include "V3PchAstNoMT.h"  // VL_MT_DISABLED_CODE_UNIT
+
+#include "V3VpiDirty.h"
+
+#include "V3Stats.h"
+
+#include <vector>
+
+VL_DEFINE_DEBUG_FUNCTIONS;
+
+//######################################################################
+
+class VpiDirtyVisitor final : public VNVisitorConst {
+    // NODE STATE
+    //  AstVar::user1()         -> bool. Written other than by an assignment
+    //  AstVar::user2p()        -> AstVar*. Dirty flag variable
+    //  AstVarScope::user2p()   -> AstVarScope*. Dirty flag variable scope
+    const VNUser1InUse m_inuser1;
+    const VNUser2InUse m_inuser2;
+
+    // STATE
+    AstNodeAssign* m_assignp = nullptr;  // Assignment whose target is being iterated
+    std::vector<std::pair<AstNodeAssign*, AstVarScope*>> m_writes;  // Assignments to publics
+    size_t m_statFlags = 0;  // Number of dirty flags created
+
+    // METHODS
+    static bool isPublic(const AstVarScope* vscp) {
+        const AstVar* const varp = vscp->varp();
+        return (varp->isSigUserRdPublic() || varp->isSigUserRWPublic()) && !varp->isParam()
+               && !varp->isFuncLocal() && !VN_IS(vscp->scopep()->modp(), Class);
+    }
+    AstVarScope* dirtyVscp(AstVarScope* vscp) {
+        if (AstVarScope* const dirtyVscp = VN_CAST(vscp->user2p(), VarScope)) return dirtyVscp;
+        AstVar* const varp = vscp->varp();
+        FileLine* const flp = varp->fileline();
+        AstVar* dirtyVarp = VN_CAST(varp->user2p(), Var);
+        if (!dirtyVarp) {
+            dirtyVarp = new AstVar{flp, VVarType::MODULETEMP, varp->name() + "__Vvpidirty",
+                                   varp->findBitDType()};
+            dirtyVarp->sigPublic(true);  // Referenced only from the Syms, so keep
+            vscp->scopep()->modp()->addStmtsp(dirtyVarp);
+            varp->user2p(dirtyVarp);
+            ++m_statFlags;
+        }
+        AstVarScope* const dirtyVscp = new AstVarScope{flp, vscp->scopep(), dirtyVarp};
+        vscp->scopep()->addVarsp(dirtyVscp);
+        vscp->user2p(dirtyVscp);
+        return dirtyVscp;
+    }
+
+    // VISITORS
+    void visit(AstNodeAssign* nodep) override {
+        iterateConst(nodep->rhsp());
+        VL_RESTORER(m_assignp);
+        m_assignp = VN_IS(nodep, Assign) || VN_IS(nodep, AssignPre) || VN_IS(nodep, AssignPost)
+                        ? nodep
+                        : nullptr;
+        iterateConst(nodep->lhsp());
+        if (nodep->timingControlp()) iterateConst(nodep->timingControlp());
+    }
+    void visit(AstNodeVarRef* nodep) override {
+        AstVarScope* const vscp = nodep->varScopep();
+        if (!nodep->access().isWriteOrRW() || !vscp || !isPublic(vscp)) return;
+        if (m_assignp && VN_IS(nodep, VarRef)) {
+            const std::pair<AstNodeAssign*, AstVarScope*> write{m_assignp, vscp};
+            if (m_writes.empty() || m_writes.back() != write) m_writes.push_back(write);
+        } else {
+            vscp->varp()->user1(true);
+        }
+    }
+    void visit(AstNode* nodep) override {
+        // Nested statements are not the assignment's target
+        if (VN_IS(nodep, NodeStmt)) {
+            VL_RESTORER(m_assignp);
+            m_assignp = nullptr;
+            iterateChildrenConst(nodep);
+        } else {
+            iterateChildrenConst(nodep);
+        }
+    }
+
+public:
+    // CONSTRUCTORS
+    explicit VpiDirtyVisitor(AstNetlist* netlistp) {
+        iterateConst(netlistp);
+        for (const auto& pair : m_writes) {
+            AstNodeAssign* const assignp = pair.first;
+            AstVarScope* const vscp = pair.second;
+            if (vscp->varp()->user1()) continue;
+            FileLine* const flp = assignp->fileline();
+            assignp->addNextHere(
+                new AstAssign{flp, new AstVarRef{flp, dirtyVscp(vscp), VAccess::WRITE},
+                              new AstConst{flp, AstConst::BitTrue{}}});
+        }
+    }
+    ~VpiDirtyVisitor() override { V3Stats::addStat("VPI, dirty flags", m_statFlags); }
+};
+
+//######################################################################
+// V3VpiDirty static functions
+
+void V3VpiDirty::vpiDirtyAll(AstNetlist* nodep) {
+    UINFO(2, __FUNCTION__ << ": " << endl);
+    { VpiDirtyVisitor{nodep}; }  // Destruct before checking
+    V3Global::dumpCheckGlobalTree("vpidirty", 0, dumpTreeEitherLevel() >= 3);
+}
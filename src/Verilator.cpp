@@ -20,6 +20,7 @@
 #include "V3ActiveTop.h"
 #include "V3Assert.h"
 #include "V3AssertPre.h"
+#include "V3AssocHash.h"
 #include "V3Ast.h"
 #include "V3Begin.h"
 #include "V3Branch.h"
@@ -107,11 +108,13 @@
 #include "V3Unknown.h"
 #include "V3Unroll.h"
 #include "V3VariableOrder.h"
+#include "V3VpiDirty.h"
 #include "V3Waiver.h"
 #include "V3Width.h"
 #include "V3WidthCommit.h"
 
 #include <ctime>
+#include <sys/stat.h>
 
 VL_DEFINE_DEBUG_FUNCTIONS;
 
@@ -119,9 +122,11 @@ V3Global v3Global;
 
 static void reportStatsIfEnabled() {
     if (v3Global.opt.stats()) {
-        V3Stats::statsFinalAll(v3Global.rootp());
+        // Final statistics were already gathered if the netlist was released early
+        if (v3Global.rootp()) V3Stats::statsFinalAll(v3Global.rootp());
         V3Stats::statsReport();
     }
+    if (v3Global.opt.profVerilator()) V3Stats::profReport();
 }
 
 static void emitJson() VL_MT_DISABLED {
@@ -458,6 +463,11 @@ static void process() {
             // Convert sense lists into IF statements.
             V3Clock::clockAll(v3Global.rootp());
 
+            // Flag writes to public signals for cbValueChange
+            if (v3Global.opt.vpi() && v3Global.opt.vpiDirty()) {
+                V3VpiDirty::vpiDirtyAll(v3Global.rootp());
+            }
+
             // Cleanup any dly vars or other temps that are simple assignments
             // Life must be done before Subst, as it assumes each CFunc under
             // _eval is called only once.
@@ -587,6 +597,9 @@ static void process() {
             // Order variables
             V3VariableOrder::orderAll(v3Global.rootp());
 
+            // Use hashed storage for associative arrays never iterated in order
+            V3AssocHash::assocHashAll(v3Global.rootp());
+
             // Create AstCUse to determine what class forward declarations/#includes needed in C
             V3CUse::cUseAll();
         }
@@ -601,6 +614,7 @@ static void process() {
             V3EmitC::emitcModel();
             V3EmitC::emitcPch();
             V3EmitC::emitcHeaders();
+            if (v3Global.opt.statsModel()) V3EmitC::emitcStatsModel();
         } else if (v3Global.opt.dpiHdrOnly()) {
             V3EmitC::emitcSyms(true);
         }
@@ -649,6 +663,102 @@ static void process() {
 
     // Final statistics
     if (v3Global.opt.stats()) V3Stats::statsStage("emit");
+    if (v3Global.opt.profVerilator()) V3Stats::profStage("emit");
+}
+
+static string stripRunVarying(const string& dump) {
+    // Remove node addresses and edit counts from a tree dump, as they differ from run to run
+    string out;
+    out.reserve(dump.size());
+    for (size_t i = 0; i < dump.size(); ++i) {
+        if (dump[i] == '0' && i + 1 < dump.size() && dump[i + 1] == 'x') {
+            i += 2;
+            while (i < dump.size() && std::isxdigit(dump[i])) ++i;
+            --i;
+        } else if (dump[i] == '<' && i + 2 < dump.size() && dump[i + 1] == 'e'
+                   && std::isdigit(dump[i + 2])) {
+            i += 2;
+            while (i < dump.size() && dump[i] != '>') ++i;
+        } else {
+            out += dump[i];
+        }
+    }
+    return out;
+}
+
+static string skipIdenticalHash(const string& argString, bool forCache) {
+    // For --skip-identical-content, hash what the output depends on, once parsed. Modules are
+    // hashed by their parsed tree so that macros are accounted for, and modules that are not
+    // under the top, e.g. other hierarchical blocks, are left out so they may change freely.
+    // With forCache, the hash is also used by other hosts, so the Verilator executable is
+    // identified by its version, rather than by its file times.
+    std::unordered_set<const AstNodeModule*> usedps;
+    std::vector<AstNodeModule*> todo;
+    std::unordered_set<const AstNodeModule*> instancedps;
+    for (AstNode* nodep = v3Global.rootp()->modulesp(); nodep; nodep = nodep->nextp()) {
+        nodep->foreach([&](const AstCell* cellp) {
+            if (cellp->modp()) instancedps.emplace(cellp->modp());
+        });
+    }
+    for (AstNode* nodep = v3Global.rootp()->modulesp(); nodep; nodep = nodep->nextp()) {
+        AstNodeModule* const modp = VN_AS(nodep, NodeModule);
+        const bool top = v3Global.opt.topModule().empty()
+                             ? !instancedps.count(modp)
+                             : (modp->origName() == v3Global.opt.topModule()
+                                || modp->name() == v3Global.opt.topModule());
+        if (!VN_IS(modp, Module) || top) todo.push_back(modp);
+    }
+    while (!todo.empty()) {
+        AstNodeModule* const modp = todo.back();
+        todo.pop_back();
+        if (!usedps.emplace(modp).second) continue;
+        modp->foreach([&](AstCell* cellp) {
+            if (cellp->modp()) todo.push_back(cellp->modp());
+        });
+    }
+
+    string contents = "C " + argString + "\n";
+    if (forCache) contents += "V " + V3Options::version() + "\n";
+    std::unordered_set<string> moduleFiles;  // Files hashed by their modules' trees
+    for (AstNode* nodep = v3Global.rootp()->modulesp(); nodep; nodep = nodep->nextp()) {
+        AstNodeModule* const modp = VN_AS(nodep, NodeModule);
+        moduleFiles.emplace(modp->fileline()->filename());
+        if (!usedps.count(modp)) continue;
+        std::ostringstream os;
+        const std::function<void(const AstNode*)> dumpAll = [&](const AstNode* np) {
+            for (; np; np = np->nextp()) {
+                np->dump(os);
+                os << " " << np->fileline()->filename() << "\n";
+                dumpAll(np->op1p());
+                dumpAll(np->op2p());
+                dumpAll(np->op3p());
+                dumpAll(np->op4p());
+                if (np == modp) break;  // Not the following modules
+            }
+        };
+        dumpAll(modp);
+        contents += "M " + modp->name() + " " + VHashSha256{stripRunVarying(os.str())}.digestHex()
+                    + "\n";
+    }
+    for (const string& filename : V3File::getAllDeps()) {
+        if (moduleFiles.count(filename)) continue;
+        if (filename == v3Global.opt.buildDepBin()) {
+            if (forCache) continue;
+            // Too large to read each run, but a rebuild changes the size or time
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init)
+            struct stat fstat;
+            if (stat(filename.c_str(), &fstat) == 0) {
+                contents += "B " + cvtToStr(fstat.st_size) + " " + cvtToStr(fstat.st_mtime)
+                            + "\n";
+            }
+            continue;
+        }
+        const std::unique_ptr<std::ifstream> ifp{V3File::new_ifstream_nodepend(filename)};
+        std::ostringstream fileContents;
+        fileContents << ifp->rdbuf();
+        contents += "F " + filename + " " + VHashSha256{fileContents.str()}.digestHex() + "\n";
+    }
+    return VHashSha256{contents}.digestHex();
 }
 
 static void verilate(const string& argString) {
@@ -665,7 +775,8 @@ static void verilate(const string& argString) {
     }
     // Undocumented debugging - cannot be a switch as then command line
     // would mismatch forcing non-identicalness when we set it
-    if (!V3Os::getenvStr("VERILATOR_DEBUG_SKIP_IDENTICAL", "").empty()) {  // LCOV_EXCL_START
+    const bool debugSkipIdentical = !V3Os::getenvStr("VERILATOR_DEBUG_SKIP_IDENTICAL", "").empty();
+    if (debugSkipIdentical && !v3Global.opt.skipIdenticalContent()) {  // LCOV_EXCL_START
         v3fatalSrc("VERILATOR_DEBUG_SKIP_IDENTICAL w/ --skip-identical: Changes found\n");
     }  // LCOV_EXCL_STOP
 
@@ -707,6 +818,35 @@ static void verilate(const string& argString) {
     v3Global.readFiles();
     v3Global.removeStd();
 
+    // Can we reuse the outputs of this hierarchical block from an earlier Verilation?
+    string hierCacheKey;
+    if (v3Global.opt.hierChild() && !v3Global.opt.hierCache().empty()
+        && !V3Error::isErrorOrWarn()) {
+        hierCacheKey = skipIdenticalHash(argString, true);
+        if (V3HierBlockCache::restore(hierCacheKey)) {
+            UINFO(1, "--hierarchical-cache: Outputs restored from cache, exiting");
+            return;
+        }
+    }
+
+    // Can we skip the rest as, although times differ, the used sources are the same?
+    string contentHash;
+    if (v3Global.opt.skipIdentical().isTrue() && v3Global.opt.skipIdenticalContent()
+        && !v3Global.opt.preprocOnly() && !V3Error::isErrorOrWarn()) {
+        contentHash = skipIdenticalHash(argString, false);
+        const string timesFilename
+            = v3Global.opt.hierTopDataDir() + "/" + v3Global.opt.prefix() + "__verFiles.dat";
+        if (V3File::checkTimes(timesFilename, argString, contentHash)) {
+            UINFO(1, "--skip-identical-content: No change to used source content, exiting");
+            // Record the new times, so the next run can skip without parsing
+            V3File::writeTimes(timesFilename, argString, contentHash);
+            return;
+        }
+        if (debugSkipIdentical) {  // LCOV_EXCL_START
+            v3fatalSrc("VERILATOR_DEBUG_SKIP_IDENTICAL w/ --skip-identical: Changes found\n");
+        }  // LCOV_EXCL_STOP
+    }
+
     // Link, etc, if needed
     if (!v3Global.opt.preprocOnly()) {  //
         process();
@@ -763,12 +903,14 @@ static void verilate(const string& argString) {
         && !V3Error::isErrorOrWarn()) {
         V3File::writeTimes(v3Global.opt.hierTopDataDir() + "/" + v3Global.opt.prefix()
                                + "__verFiles.dat",
-                           argString);
+                           argString, contentHash);
     }
+    if (!hierCacheKey.empty() && !V3Error::isErrorOrWarn()) V3HierBlockCache::store(hierCacheKey);
 
     V3Os::filesystemFlushBuildDir(v3Global.opt.makeDir());
     if (v3Global.opt.hierTop()) V3Os::filesystemFlushBuildDir(v3Global.opt.hierTopDataDir());
     if (v3Global.opt.stats()) V3Stats::statsStage("wrote");
+    if (v3Global.opt.profVerilator()) V3Stats::profStage("wrote");
 
     // Final writing shouldn't throw warnings, but...
     V3Error::abortIfWarnings();
@@ -793,6 +935,39 @@ static string buildMakeCmd(const string& makefile, const string& target) {
     return cmd.str();
 }
 
+static void execBuildCmd(const string& cmdStr) {
+    const int exit_code = V3Os::system(cmdStr);
+    if (exit_code != 0) {
+        v3error(cmdStr << " exited with " << exit_code << std::endl);
+        std::exit(exit_code);
+    }
+}
+
+static void execBuildPgo() {
+    // Two stage compiler profile-guided optimization: build instrumented, run the user's
+    // command, then rebuild using the profile, all objects each time as the flags change
+    const string makefile = v3Global.opt.prefix() + ".mk";
+    const string makeDir = V3Os::filenameRealPath(v3Global.opt.makeDir());
+    UINFO(1, "Start PGO instrumented build");
+    execBuildCmd(buildMakeCmd(makefile, "pgo-clean"));
+    execBuildCmd(buildMakeCmd(makefile, "-B VM_PGO=generate"));
+    UINFO(1, "Start PGO run");
+    // Clang writes raw profiles to the current directory unless told otherwise
+    execBuildCmd("export LLVM_PROFILE_FILE=" + makeDir + "/" + v3Global.opt.prefix()
+                 + "__pgo_%p.profraw; " + v3Global.opt.buildPgo());
+    if (v3Global.opt.profPgo()) {
+        // Verilate again with the mtask costs the run also measured
+        UINFO(1, "Start PGO Verilation");
+        const string fullpathBin = V3Os::filenameRealPath(v3Global.opt.buildDepBin());
+        execBuildCmd(V3Os::filenameDir(fullpathBin) + "/verilator "
+                     + v3Global.opt.allArgsStringForPgo()
+                     + " --no-build --no-prof-pgo profile.vlt");
+    }
+    UINFO(1, "Start PGO optimized build");
+    execBuildCmd(buildMakeCmd(makefile, "pgo-merge"));
+    execBuildCmd(buildMakeCmd(makefile, "-B VM_PGO=use"));
+}
+
 static void execBuildJob() {
     UASSERT(v3Global.opt.build(), "--build is not specified.");
     UASSERT(v3Global.opt.gmake(), "--build requires GNU Make.");
@@ -800,15 +975,13 @@ static void execBuildJob() {
     VlOs::DeltaWallTime buildWallTime{true};
     UINFO(1, "Start Build");
 
-    const string cmdStr = buildMakeCmd(v3Global.opt.prefix() + ".mk", "");
     V3Os::filesystemFlushBuildDir(v3Global.opt.hierTopDataDir());
-    const int exit_code = V3Os::system(cmdStr);
-    V3Stats::addStatPerf(V3Stats::STAT_WALLTIME_BUILD, buildWallTime.deltaTime());
-
-    if (exit_code != 0) {
-        v3error(cmdStr << " exited with " << exit_code << std::endl);
-        std::exit(exit_code);
+    if (!v3Global.opt.buildPgo().empty()) {
+        execBuildPgo();
+    } else {
+        execBuildCmd(buildMakeCmd(v3Global.opt.prefix() + ".mk", ""));
     }
+    V3Stats::addStatPerf(V3Stats::STAT_WALLTIME_BUILD, buildWallTime.deltaTime());
 }
 
 static void execHierVerilation() {
@@ -861,7 +1034,13 @@ int main(int argc, char** argv) {
         UINFO(1, "Option --no-verilate: Skip Verilation");
     }
 
-    if (v3Global.hierPlanp() && v3Global.opt.gmake()) {
+    const bool execHier = v3Global.hierPlanp() && v3Global.opt.gmake();
+    if (execHier || v3Global.opt.build()) {
+        // Everything is emitted, free the netlist so the build has the memory
+        if (v3Global.opt.stats()) V3Stats::statsFinalAll(v3Global.rootp());
+        v3Global.releaseNetlist();
+    }
+    if (execHier) {
         execHierVerilation();  // execHierVerilation() takes care of --build too
     } else if (v3Global.opt.build()) {
         execBuildJob();
@@ -25,6 +25,9 @@
 #endif
 #include "V3Error.h"
 
+#include <algorithm>
+#include <bitset>
+
 //********************************************************************
 // VlcBuckets - Container of all coverage point hits for a given test
 // This is a bitmap array - we store a single bit to indicate a test
@@ -102,18 +105,20 @@ public:
         }
         return pop;
     }
-    uint64_t dataPopCount(const VlcBuckets& remaining) {
+    uint64_t dataPopCount(const VlcBuckets& remaining) const {
+        // Word at a time, as ranking calls this for every test on every pass
         uint64_t pop = 0;
-        for (uint64_t i = 0; i < m_dataSize; ++i) {
-            if (hits(i) && remaining.hits(i)) ++pop;
+        const uint64_t words = std::min(m_dataSize, remaining.m_dataSize) / 64;
+        for (uint64_t w = 0; w < words; ++w) {
+            pop += std::bitset<64>{m_datap[w] & remaining.m_datap[w]}.count();
         }
         return pop;
     }
     void orData(const VlcBuckets& ordata) {
-        for (uint64_t i = 0; i < m_dataSize; ++i) {
-            if (hits(i) && ordata.hits(i)) clearHits(i);
-        }
+        const uint64_t words = std::min(m_dataSize, ordata.m_dataSize) / 64;
+        for (uint64_t w = 0; w < words; ++w) m_datap[w] &= ~ordata.m_datap[w];
     }
+    uint64_t dataWords() const { return m_dataSize / 64; }
 
     void dump() const {
         std::cout << "#     ";
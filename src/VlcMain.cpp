@@ -69,6 +69,7 @@ void VlcOptions::parseOptsList(int argc, char** argv) {
     DECL_OPTION("-debug", CbCall, []() { V3Error::debugDefault(3); });
     DECL_OPTION("-debugi", CbVal, [](int v) { V3Error::debugDefault(v); });
     DECL_OPTION("-filter-type", Set, &m_filterType);
+    DECL_OPTION("-incremental", OnOff, &m_incremental);
     DECL_OPTION("-rank", OnOff, &m_rank);
     DECL_OPTION("-unlink", OnOff, &m_unlink);
     DECL_OPTION("-V", CbCall, []() {
@@ -130,9 +131,11 @@ int main(int argc, char** argv) {
 
     if (top.opt.readFiles().empty()) top.opt.addReadFile("vlt_coverage.dat");
 
-    {
-        const VlStringSet& readFiles = top.opt.readFiles();
-        for (const auto& filename : readFiles) top.readCoverage(filename);
+    if (top.opt.incremental()) {
+        if (top.opt.writeFile().empty()) v3fatal("--incremental requires --write");
+        top.readCoverages(top.readIncremental(top.opt.writeFile(), top.opt.readFiles()));
+    } else {
+        top.readCoverages(top.opt.readFiles());
     }
 
     if (debug() >= 9) {
@@ -24,15 +24,196 @@
 #include "VlcOptions.h"
 
 #include <algorithm>
+#include <atomic>
 #include <fstream>
+#include <sstream>
 #include <string>
+#include <sys/stat.h>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 
 //######################################################################
+// Worker threads, for independent per-file and per-test work
+
+static size_t vlcThreads() { return std::max(1U, std::thread::hardware_concurrency()); }
+
+// Call func(0..n-1) from worker threads, or inline when not worth the threads.
+// func must not report errors (V3Error is not thread safe); collect them instead.
+template <typename T_Func>
+static void vlcParallelFor(size_t n, bool parallel, T_Func&& func) {
+    const size_t nthreads = parallel ? std::min(vlcThreads(), n) : 1;
+    if (nthreads <= 1) {
+        for (size_t i = 0; i < n; ++i) func(i);
+        return;
+    }
+    std::atomic<size_t> next{0};
+    std::vector<std::thread> workers;
+    for (size_t t = 0; t < nthreads; ++t) {
+        workers.emplace_back([&]() {
+            for (size_t i; (i = next.fetch_add(1)) < n;) func(i);
+        });
+    }
+    for (std::thread& worker : workers) worker.join();
+}
+
+//######################################################################
+
+void VlcTop::addCoverage(VlcTest* testp, const string& point, uint64_t hits) {
+    if (!opt.isTypeMatch(point.c_str())) return;
+    // UINFO(9, "   point '" << point << "'" << " " << hits);
+
+    const uint64_t pointnum = points().findAddPoint(point, hits);
+    if (opt.rank()) {  // Only if ranking - uses a lot of memory
+        if (hits >= VlcBuckets::sufficient()) {
+            points().pointNumber(pointnum).testsCoveringInc();
+            testp->buckets().addData(pointnum, hits);
+        }
+    }
+}
+
+string VlcTop::fileStamp(const string& filename) {
+    // Identifies an input for --incremental; a rewritten input gets a new stamp
+    struct stat st;
+    if (stat(filename.c_str(), &st) != 0) return "";
+    return cvtToStr(st.st_size) + " " + cvtToStr(st.st_mtime) + " " + filename;
+}
+
+bool VlcTop::isBinaryCoverage(const string& filename) {
+    std::ifstream is{filename.c_str(), std::ios::in | std::ios::binary};
+    char magic[VL_COV_BINARY_MAGIC_LEN];
+    if (!is.read(magic, VL_COV_BINARY_MAGIC_LEN)) return false;
+    return std::equal(magic, magic + VL_COV_BINARY_MAGIC_LEN, VL_COV_BINARY_MAGIC);
+}
+
+string VlcTop::readBinaryCoverage(const string& filename, BinaryPoints& points) {
+    // Called from worker threads, so report errors by return value, not v3fatal
+    // See VL_COV_BINARY_MAGIC for the format
+    std::ifstream is{filename.c_str(), std::ios::in | std::ios::binary};
+    if (!is) return "Can't read coverage file: " + filename;
+    std::ostringstream buf;
+    buf << is.rdbuf();
+    const string data = buf.str();
+    const string corrupt = "Corrupt binary coverage file: " + filename;
+
+    size_t pos = VL_COV_BINARY_MAGIC_LEN;
+    const auto getBytes = [&](size_t bytes, uint64_t& value) {
+        if (pos + bytes > data.size()) return false;
+        value = 0;
+        for (size_t i = 0; i < bytes; ++i) {
+            value |= static_cast<uint64_t>(static_cast<uint8_t>(data[pos + i])) << (i * 8);
+        }
+        pos += bytes;
+        return true;
+    };
+
+    uint64_t nstrings;
+    if (!getBytes(4, nstrings)) return corrupt;
+    std::vector<string> strings;
+    strings.reserve(std::min<uint64_t>(nstrings, data.size()));
+    for (uint64_t i = 0; i < nstrings; ++i) {
+        uint64_t len;
+        if (!getBytes(4, len) || pos + len > data.size()) return corrupt;
+        strings.emplace_back(data, pos, len);
+        pos += len;
+    }
+
+    uint64_t npoints;
+    if (!getBytes(8, npoints)) return corrupt;
+    points.reserve(std::min<uint64_t>(npoints, data.size()));
+    for (uint64_t i = 0; i < npoints; ++i) {
+        uint64_t nfields;
+        if (!getBytes(4, nfields)) return corrupt;
+        string name;
+        for (uint64_t f = 0; f < nfields; ++f) {
+            uint64_t key;
+            uint64_t value;
+            if (!getBytes(4, key) || !getBytes(4, value)) return corrupt;
+            if (key >= strings.size() || value >= strings.size()) return corrupt;
+            name += '\001' + strings[key] + '\002' + strings[value];
+        }
+        uint64_t hits;
+        if (!getBytes(8, hits)) return corrupt;
+        points.emplace_back(std::move(name), hits);
+    }
+    return "";
+}
+
+void VlcTop::addBinaryCoverage(const string& filename, const BinaryPoints& points) {
+    UINFO(2, "readCoverage " << filename);
+    // Testrun and computrons argument unsupported as yet
+    VlcTest* const testp = tests().newTest(filename, 0, 0);
+    for (const auto& it : points) addCoverage(testp, it.first, it.second);
+}
+
+void VlcTop::readCoverages(const VlStringSet& filenames) {
+    // Binary files are decoded by worker threads, a window of files at a time,
+    // while the main thread merges them, in filename order, into the point database
+    const std::vector<string> files{filenames.begin(), filenames.end()};
+    const size_t window = vlcThreads();
+    for (size_t base = 0; base < files.size(); base += window) {
+        const size_t nfiles = std::min(window, files.size() - base);
+        std::vector<BinaryPoints> decoded(nfiles);
+        std::vector<string> errors(nfiles);
+        std::vector<std::thread> workers(nfiles);
+        for (size_t i = 0; i < nfiles; ++i) {
+            const string& filename = files[base + i];
+            if (!isBinaryCoverage(filename)) continue;
+            workers[i] = std::thread{[&, i]() {
+                errors[i] = readBinaryCoverage(filename, decoded[i]);
+            }};
+        }
+        for (size_t i = 0; i < nfiles; ++i) {
+            const string& filename = files[base + i];
+            if (!workers[i].joinable()) {
+                readCoverage(filename);
+                continue;
+            }
+            workers[i].join();
+            if (!errors[i].empty()) {
+                v3fatal(errors[i]);
+            } else {
+                addBinaryCoverage(filename, decoded[i]);
+            }
+            BinaryPoints{}.swap(decoded[i]);  // Free memory before next window
+        }
+        for (size_t i = 0; i < nfiles; ++i) {
+            const string stamp = fileStamp(files[base + i]);
+            if (!stamp.empty()) m_mergedFiles.insert(stamp);
+        }
+    }
+}
+
+VlStringSet VlcTop::readIncremental(const string& dbFilename, const VlStringSet& filenames) {
+    // Start from the existing database, and return only the inputs not yet merged into it
+    UINFO(2, "readIncremental " << dbFilename);
+    readCoverage(dbFilename, true);
+    VlStringSet newFiles;
+    for (const string& filename : filenames) {
+        if (filename == dbFilename) continue;
+        if (m_mergedFiles.count(fileStamp(filename))) {
+            UINFO(2, "  already merged " << filename);
+            continue;
+        }
+        newFiles.insert(filename);
+    }
+    return newFiles;
+}
 
 void VlcTop::readCoverage(const string& filename, bool nonfatal) {
     UINFO(2, "readCoverage " << filename);
 
+    if (isBinaryCoverage(filename)) {
+        BinaryPoints points;
+        const string error = readBinaryCoverage(filename, points);
+        if (!error.empty()) {
+            if (!nonfatal) v3fatal(error);
+            return;
+        }
+        addBinaryCoverage(filename, points);
+        return;
+    }
+
     std::ifstream is{filename.c_str()};
     if (!is) {
         if (!nonfatal) v3fatal("Can't read coverage file: " << filename);
@@ -51,18 +232,10 @@ void VlcTop::readCoverage(const string& filename, bool nonfatal) {
                 if (line[secspace] == '\'' && line[secspace + 1] == ' ') break;
             }
             const string point = line.substr(3, secspace - 3);
-            if (!opt.isTypeMatch(point.c_str())) continue;
-
             const uint64_t hits = std::atoll(line.c_str() + secspace + 1);
-            // UINFO(9, "   point '" << point << "'" << " " << hits);
-
-            const uint64_t pointnum = points().findAddPoint(point, hits);
-            if (opt.rank()) {  // Only if ranking - uses a lot of memory
-                if (hits >= VlcBuckets::sufficient()) {
-                    points().pointNumber(pointnum).testsCoveringInc();
-                    testp->buckets().addData(pointnum, hits);
-                }
-            }
+            addCoverage(testp, point, hits);
+        } else if (VString::startsWith(line, "# merged ")) {
+            m_mergedFiles.insert(line.substr(9));  // After "# merged "
         }
     }
 }
@@ -77,6 +250,9 @@ void VlcTop::writeCoverage(const string& filename) {
     }
 
     os << "# SystemC::Coverage-3\n";
+    if (opt.incremental()) {
+        for (const string& stamp : m_mergedFiles) os << "# merged " << stamp << '\n';
+    }
     for (const auto& i : m_points) {
         const VlcPoint& point = m_points.pointNumber(i.second);
         os << "C '" << point.name() << "' " << point.count() << '\n';
@@ -175,6 +351,10 @@ void VlcTop::rank() {
         if (pointp->testsCovering()) remaining.addData(pointp->pointNum(), 1);
     }
 
+    std::vector<uint64_t> remains(bytime.size());
+    // Threads only pay off once a pass touches enough bucket words
+    const bool parallel = bytime.size() * remaining.dataWords() >= (1ULL << 16);
+
     // Additional Greedy algorithm
     // O(n^2) Ouch.  Probably the thing to do is randomize the order of data
     // then hierarchically solve a small subset of tests, and take resulting
@@ -184,15 +364,17 @@ void VlcTop::rank() {
             UINFO_PREFIX("Left on iter" << nextrank << ": ");  // LCOV_EXCL_LINE
             remaining.dump();  // LCOV_EXCL_LINE
         }
+        // Each test's count is independent, so compute them in parallel,
+        // then pick the first best in computron order
+        vlcParallelFor(bytime.size(), parallel, [&](size_t i) {
+            remains[i] = bytime[i]->rank() ? 0 : bytime[i]->buckets().dataPopCount(remaining);
+        });
         VlcTest* bestTestp = nullptr;
         uint64_t bestRemain = 0;
-        for (const auto& testp : bytime) {
-            if (!testp->rank()) {
-                uint64_t remain = testp->buckets().dataPopCount(remaining);
-                if (remain > bestRemain) {
-                    bestTestp = testp;
-                    bestRemain = remain;
-                }
+        for (size_t i = 0; i < bytime.size(); ++i) {
+            if (remains[i] > bestRemain) {
+                bestTestp = bytime[i];
+                bestRemain = remains[i];
             }
         }
         if (VlcTest* const testp = bestTestp) {
@@ -208,26 +390,37 @@ void VlcTop::rank() {
 //######################################################################
 
 void VlcTop::annotateCalc() {
-    // Calculate per-line information into filedata structure
+    // Group points by source file
+    std::vector<std::pair<VlcSource*, std::vector<const VlcPoint*>>> bySource;
+    std::unordered_map<const VlcSource*, size_t> sourceIndex;
     for (const auto& i : m_points) {
         const VlcPoint& point = m_points.pointNumber(i.second);
         const string filename = point.filename();
         const int lineno = point.lineno();
         if (!filename.empty() && lineno != 0) {
-            VlcSource& source = sources().findNewSource(filename);
+            VlcSource* const sourcep = &sources().findNewSource(filename);
             UINFO(9, "AnnoCalc count " << filename << ":" << lineno << ":" << point.column() << " "
                                        << point.count() << " " << point.linescov());
+            const auto it = sourceIndex.emplace(sourcep, bySource.size());
+            if (it.second) bySource.emplace_back(sourcep, std::vector<const VlcPoint*>{});
+            bySource[it.first->second].second.push_back(&point);
+        }
+    }
+    // Calculate per-line information into filedata structure, each source independently
+    vlcParallelFor(bySource.size(), bySource.size() > 1, [&](size_t si) {
+        VlcSource& source = *bySource[si].first;
+        for (const VlcPoint* const pointp : bySource[si].second) {
             // Base coverage
-            source.insertPoint(lineno, &point);
+            source.insertPoint(pointp->lineno(), pointp);
             // Additional lines covered by this statement
             bool range = false;
             int start = 0;
             int end = 0;
-            const string linescov = point.linescov();
+            const string linescov = pointp->linescov();
             for (const char* covp = linescov.c_str(); true; ++covp) {
                 if (!*covp || *covp == ',') {  // Ending
                     for (int lni = start; start && lni <= end; ++lni) {
-                        source.insertPoint(lni, &point);
+                        source.insertPoint(lni, pointp);
                     }
                     if (!*covp) break;
                     start = 0;  // Prep for next
@@ -244,7 +437,7 @@ void VlcTop::annotateCalc() {
                 }
             }
         }
-    }
+    });
 }
 
 void VlcTop::annotateCalcNeeded() {
@@ -277,58 +470,67 @@ void VlcTop::annotateCalcNeeded() {
 void VlcTop::annotateOutputFiles(const string& dirname) {
     // Create if uncreated, ignore errors
     V3Os::createDir(dirname);
+    std::vector<VlcSource*> neededps;
     for (auto& si : m_sources) {
         VlcSource& source = si.second;
         if (!source.needed()) continue;
-        const string filename = source.name();
-        const string outfilename = dirname + "/" + V3Os::filenameNonDir(filename);
+        UINFO(1, "annotateOutputFile " << source.name() << " -> " << dirname << "/"
+                                       << V3Os::filenameNonDir(source.name()));
+        neededps.push_back(&source);
+    }
+    // Files are independent, so write them in parallel, reporting errors afterwards
+    std::vector<string> errors(neededps.size());
+    vlcParallelFor(neededps.size(), neededps.size() > 1, [&](size_t i) {
+        errors[i] = annotateOutputFile(*neededps[i], dirname);
+    });
+    for (const string& error : errors) {
+        if (!error.empty()) v3error(error);
+    }
+}
 
-        UINFO(1, "annotateOutputFile " << filename << " -> " << outfilename);
+string VlcTop::annotateOutputFile(VlcSource& source, const string& dirname) const {
+    // Returns error message, or empty if ok; called from worker threads
+    const string filename = source.name();
+    const string outfilename = dirname + "/" + V3Os::filenameNonDir(filename);
 
-        std::ifstream is{filename.c_str()};
-        if (!is) {
-            v3error("Can't read annotation file: " << filename);
-            return;
-        }
+    std::ifstream is{filename.c_str()};
+    if (!is) return "Can't read annotation file: " + filename;
 
-        std::ofstream os{outfilename.c_str()};
-        if (!os) {
-            v3error("Can't write file: " << outfilename);
-            return;
-        }
+    std::ofstream os{outfilename.c_str()};
+    if (!os) return "Can't write file: " + outfilename;
 
-        os << "//      // verilator_coverage annotation\n";
+    os << "//      // verilator_coverage annotation\n";
 
-        int lineno = 0;
-        while (!is.eof()) {
-            lineno++;
-            string line = V3Os::getline(is);
+    int lineno = 0;
+    while (!is.eof()) {
+        lineno++;
+        string line = V3Os::getline(is);
 
-            VlcSource::LinenoMap& lines = source.lines();
-            const auto lit = lines.find(lineno);
-            if (lit == lines.end()) {
-                os << "        " << line << '\n';
+        VlcSource::LinenoMap& lines = source.lines();
+        const auto lit = lines.find(lineno);
+        if (lit == lines.end()) {
+            os << "        " << line << '\n';
+        } else {
+            VlcSourceCount& sc = lit->second;
+            // UINFO(0, "Source " << source.name() << ":" << sc.lineno() << ":" <<
+            // sc.column());
+            const bool minOk = opt.countOk(sc.minCount());
+            const bool maxOk = opt.countOk(sc.maxCount());
+            if (minOk) {
+                os << " ";
+            } else if (maxOk) {
+                os << "~";
             } else {
-                VlcSourceCount& sc = lit->second;
-                // UINFO(0, "Source " << source.name() << ":" << sc.lineno() << ":" <<
-                // sc.column());
-                const bool minOk = opt.countOk(sc.minCount());
-                const bool maxOk = opt.countOk(sc.maxCount());
-                if (minOk) {
-                    os << " ";
-                } else if (maxOk) {
-                    os << "~";
-                } else {
-                    os << "%";
-                }
-                os << std::setfill('0') << std::setw(6) << sc.maxCount() << " " << line << '\n';
+                os << "%";
+            }
+            os << std::setfill('0') << std::setw(6) << sc.maxCount() << " " << line << '\n';
 
-                if (opt.annotatePoints()) {
-                    for (auto& pit : sc.points()) pit->dumpAnnotate(os, opt.annotateMin());
-                }
+            if (opt.annotatePoints()) {
+                for (auto& pit : sc.points()) pit->dumpAnnotate(os, opt.annotateMin());
             }
         }
     }
+    return "";
 }
 
 void VlcTop::annotate(const string& dirname) {
@@ -33,15 +33,25 @@ public:
     // PUBLIC MEMBERS
     VlcOptions opt;  //< Runtime options
 private:
+    // TYPES
+    using BinaryPoints = std::vector<std::pair<string, uint64_t>>;  // Decoded binary file
+
     // MEMBERS
     VlcTests m_tests;  //< List of all tests (all coverage files)
     VlcPoints m_points;  //< List of all points
     VlcSources m_sources;  //< List of all source files to annotate
+    VlStringSet m_mergedFiles;  //< Stamps of input files merged into the database
 
     // METHODS
     void annotateCalc();
     void annotateCalcNeeded();
     void annotateOutputFiles(const string& dirname);
+    string annotateOutputFile(VlcSource& source, const string& dirname) const;
+    void addCoverage(VlcTest* testp, const string& point, uint64_t hits);
+    void addBinaryCoverage(const string& filename, const BinaryPoints& points);
+    static string fileStamp(const string& filename);
+    static bool isBinaryCoverage(const string& filename);
+    static string readBinaryCoverage(const string& filename, BinaryPoints& points);
 
 public:
     // CONSTRUCTORS
@@ -56,6 +66,8 @@ public:
     // METHODS
     void annotate(const string& dirname);
     void readCoverage(const string& filename, bool nonfatal = false);
+    void readCoverages(const VlStringSet& filenames);
+    VlStringSet readIncremental(const string& dbFilename, const VlStringSet& filenames);
     void writeCoverage(const string& filename);
     void writeInfo(const string& filename);
 
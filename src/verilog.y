@@ -465,6 +465,7 @@ BISONPRE_VERSION(3.7,%define api.header.include {"V3ParseBison.h"})
 %token<fl>              yVLT_COVERAGE_BLOCK_OFF     "coverage_block_off"
 %token<fl>              yVLT_COVERAGE_OFF           "coverage_off"
 %token<fl>              yVLT_COVERAGE_ON            "coverage_on"
+%token<fl>              yVLT_DPI_DOMAIN             "dpi_domain"
 %token<fl>              yVLT_FORCEABLE              "forceable"
 %token<fl>              yVLT_FULL_CASE              "full_case"
 %token<fl>              yVLT_HIER_BLOCK             "hier_block"
@@ -494,6 +495,7 @@ BISONPRE_VERSION(3.7,%define api.header.include {"V3ParseBison.h"})
 %token<fl>              yVLT_D_BLOCK    "--block"
 %token<fl>              yVLT_D_CONTENTS "--contents"
 %token<fl>              yVLT_D_COST     "--cost"
+%token<fl>              yVLT_D_DOMAIN   "--domain"
 %token<fl>              yVLT_D_FILE     "--file"
 %token<fl>              yVLT_D_FUNCTION "--function"
 %token<fl>              yVLT_D_HIER_DPI "--hier-dpi"
@@ -8046,6 +8048,10 @@ vltItem:
                         { V3Control::addCoverageBlockOff(*$2, $4->toUInt()); }
         |       yVLT_COVERAGE_BLOCK_OFF vltDModule vltDBlock
                         { V3Control::addCoverageBlockOff(*$2, *$3); }
+        |       yVLT_DPI_DOMAIN yVLT_D_FUNCTION str vltDDomain
+                        { V3Control::addDpiDomain($<fl>1, *$3, *$4); }
+        |       yVLT_DPI_DOMAIN yVLT_D_TASK str vltDDomain
+                        { V3Control::addDpiDomain($<fl>1, *$3, *$4); }
         |       yVLT_FULL_CASE vltDFile
                         { V3Control::addCaseFull(*$2, 0); }
         |       yVLT_FULL_CASE vltDFile yVLT_D_LINES yaINTNUM
@@ -8104,6 +8110,10 @@ vltDCost<nump>:  // --cost <arg>
                 yVLT_D_COST yaINTNUM                    { $$ = $2; }
         ;
 
+vltDDomain<strp>:  // --domain <arg>
+                yVLT_D_DOMAIN str                       { $$ = $2; }
+        ;
+
 vltDFile<strp>:  // --file <arg>
                 yVLT_D_FILE str                         { $$ = $2; }
         ;
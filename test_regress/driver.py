@@ -1020,7 +1020,12 @@ class VlTest:
         self.trace = (  # pylint: disable=attribute-defined-outside-init
             bool(Args.trace or re.search(r'-trace\b|-trace-fst\b', checkflags)))
 
-        if re.search(r'-trace-fst', checkflags):
+        if re.search(r'-trace-bin', checkflags):
+            if self.sc:
+                self.trace_format = 'bin-sc'  # pylint: disable=attribute-defined-outside-init
+            else:
+                self.trace_format = 'bin-c'  # pylint: disable=attribute-defined-outside-init
+        elif re.search(r'-trace-fst', checkflags):
             if self.sc:
                 self.trace_format = 'fst-sc'  # pylint: disable=attribute-defined-outside-init
             else:
@@ -1583,6 +1588,8 @@ class VlTest:
 
     @property
     def trace_filename(self) -> str:
+        if re.match(r'^bin', self.trace_format):
+            return self.obj_dir + "/simx.vbin"
         if re.match(r'^fst', self.trace_format):
             return self.obj_dir + "/simx.fst"
         if re.match(r'^saif', self.trace_format):
@@ -1905,6 +1912,10 @@ class VlTest:
             fh.write('#include "verilated.h"' + "\n")
             if self.sc:
                 fh.write('#include "systemc.h"' + "\n")
+            if self.trace and self.trace_format == 'bin-c':
+                fh.write("#include \"verilated_bin_c.h\"\n")
+            if self.trace and self.trace_format == 'bin-sc':
+                fh.write("#include \"verilated_bin_sc.h\"\n")
             if self.trace and self.trace_format == 'fst-c':
                 fh.write("#include \"verilated_fst_c.h\"\n")
             if self.trace and self.trace_format == 'fst-sc':
@@ -1992,6 +2003,10 @@ class VlTest:
                 fh.write("\n")
                 fh.write("#if VM_TRACE\n")
                 fh.write("    contextp->traceEverOn(true);\n")
+                if self.trace_format == 'bin-c':
+                    fh.write("    std::unique_ptr<VerilatedBinC> tfp{new VerilatedBinC};\n")
+                if self.trace_format == 'bin-sc':
+                    fh.write("    std::unique_ptr<VerilatedBinSc> tfp{new VerilatedBinSc};\n")
                 if self.trace_format == 'fst-c':
                     fh.write("    std::unique_ptr<VerilatedFstC> tfp{new VerilatedFstC};\n")
                 if self.trace_format == 'fst-sc':
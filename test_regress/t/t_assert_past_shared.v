@@ -0,0 +1,46 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+   input clk;
+
+   integer cyc = 0;
+   reg [63:0] crc = 64'h5aef0c8d_d70a4497;
+
+   wire       req = crc[0];
+   wire       ack = crc[1];
+   wire [7:0] data = crc[15:8];
+
+   reg [7:0]  req_dly;
+   reg [7:0]  data_dly [0:1];
+
+   always @(posedge clk) begin
+      cyc <= cyc + 1;
+      crc <= {crc[62:0], crc[63] ^ crc[2] ^ crc[0]};
+      req_dly <= {req_dly[6:0], req};
+      data_dly[0] <= data;
+      data_dly[1] <= data_dly[0];
+      if (cyc == 99) begin
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+
+   // Many assertions on the same signals share their $past registers
+   assert property (@(posedge clk) cyc < 9 || $past(req, 1) == req_dly[0]);
+   assert property (@(posedge clk) cyc < 9 || $past(req, 3) == req_dly[2]);
+   assert property (@(posedge clk) cyc < 9 || $past(req, 8) == req_dly[7]);
+   assert property (@(posedge clk) cyc < 9 || $past(req, 2) == req_dly[1]);
+   assert property (@(posedge clk) cyc < 9 || $past(data, 2) == data_dly[1]);
+   assert property (@(posedge clk) cyc < 9 || $past(data) == data_dly[0]);
+   assert property (@(posedge clk) cyc < 9 || $past(data, 2) == data_dly[1]);
+   assert property (@(posedge clk) req |=> $past(req));
+   assert property (@(posedge clk) ack |=> $past(ack));
+
+endmodule
@@ -0,0 +1,30 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+   input clk;
+
+   integer cyc = 0;
+   // Only set by a static initializer, so no sampled copy is needed
+   int     table_c [0:3] = '{10, 20, 30, 40};
+   int     value;
+
+   always @(posedge clk) begin
+      cyc <= cyc + 1;
+      value <= table_c[cyc[1:0]];
+      if (cyc == 20) begin
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+
+   assert property (@(posedge clk) cyc < 1 || value == table_c[$past(cyc[1:0])]);
+   assert property (@(posedge clk) $sampled(table_c[cyc[1:0]]) == (cyc[1:0] + 1) * 10);
+
+endmodule
@@ -0,0 +1,25 @@
+#!/usr/bin/env python3
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2025 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+import vltest_bootstrap
+
+test.scenarios('vlt_all')
+
+test.compile()
+
+test.file_grep(test.obj_dir + "/" + test.vm_prefix + "___024root.h",
+               r'VlUnorderedAssocArray<IData, IData> \S*hashed;')
+test.file_grep(test.obj_dir + "/" + test.vm_prefix + "___024root.h",
+               r'VlUnorderedAssocArray<std::string, std::string> \S*names;')
+test.file_grep(test.obj_dir + "/" + test.vm_prefix + "___024root.h",
+               r'VlAssocArray<IData, IData> \S*ordered;')
+
+test.execute()
+
+test.passes()
@@ -0,0 +1,55 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+   input clk;
+
+   integer cyc = 0;
+
+   // Only indexed, so may use hashed storage
+   int hashed [int];
+   string names [string];
+   // Iterated, so must keep key order
+   int ordered [int];
+
+   always @(posedge clk) begin
+      cyc <= cyc + 1;
+      if (cyc < 10) begin
+         hashed[cyc * 1000] = cyc;
+         ordered[100 - cyc] = cyc;
+         names[$sformatf("n%0d", cyc)] = "v";
+      end
+      else if (cyc == 10) begin
+         int idx;
+         int last;
+         if (hashed.size() != 10) $stop;
+         if (!hashed.exists(9000)) $stop;
+         if (hashed.exists(9001)) $stop;
+         if (hashed[3000] != 3) $stop;
+         if (hashed[3001] != 0) $stop;
+         hashed.delete(3000);
+         if (hashed.exists(3000)) $stop;
+         if (hashed.num() != 9) $stop;
+         hashed.delete();
+         if (hashed.size() != 0) $stop;
+         if (names["n4"] != "v") $stop;
+         if (names.exists("n10")) $stop;
+         last = -1;
+         foreach (ordered[k]) begin
+            if (k <= last) $stop;
+            last = k;
+         end
+         if (!ordered.first(idx) || idx != 91) $stop;
+      end
+      else begin
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+endmodule
@@ -0,0 +1,48 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//
+// DESCRIPTION: Verilator: Verilog Test module for --batch-lanes
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+//
+
+#include <verilated.h>
+
+#include <iostream>
+#include <memory>
+
+// These require the above. Comment prevents clang-format moving them
+#include "TestCheck.h"
+
+#include "Vt_batch_lanes__Batch.h"
+
+int errors = 0;
+
+int main(int argc, char** argv) {
+    const std::unique_ptr<VerilatedContext> contextp{new VerilatedContext};
+    contextp->commandArgs(argc, argv);
+    Vt_batch_lanes__Batch batch{contextp.get()};
+    const unsigned lanes = Vt_batch_lanes__Batch::lanes;
+    TEST_CHECK_EQ(lanes, 4);
+    TEST_CHECK_EQ(batch.contextp(), contextp.get());
+    TEST_CHECK_CSTR(batch.lane(2).name(), "TOP__lane2");
+
+    uint8_t clk = 0;
+    while (!contextp->gotFinish()) {
+        for (unsigned i = 0; i < batch.lanes; ++i) batch.lane(i).clk = clk;
+        batch.eval();
+        contextp->timeInc(1);
+        clk = !clk;
+    }
+    batch.final();
+
+    // Lanes are evaluated together, so all finish on the same cycle
+    for (unsigned i = 0; i < batch.lanes; ++i) TEST_CHECK_EQ(batch.lane(i).done, 1);
+    // Each lane has its own state
+    TEST_CHECK_NE(batch.lane(0).value, batch.lane(1).value);
+
+    if (errors) return 10;
+    std::cout << "*-* All Finished *-*\n";
+    return 0;
+}
@@ -0,0 +1,48 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t;
+
+   function automatic int decode(logic [31:0] addr);
+      int result;
+      case (addr)
+        32'h0000_0010: result = 1;
+        32'h0000_0200: result = 2;
+        32'h0000_3000: result = 3;
+        32'h0004_0000: result = 4;
+        32'h0050_0000, 32'h0050_0004: result = 5;
+        32'h0600_0000: result = 6;
+        32'h7000_0000: result = 7;
+        32'h0000_0200: result = 99;  // Duplicate, never taken
+        32'h8000_0000: result = 8;
+        32'hffff_fffc: result = 9;
+        32'h0000_0000: result = 10;
+        default: result = -1;
+      endcase
+      return result;
+   endfunction
+
+   initial begin
+      if (decode(32'h0000_0010) != 1) $stop;
+      if (decode(32'h0000_0200) != 2) $stop;
+      if (decode(32'h0000_3000) != 3) $stop;
+      if (decode(32'h0004_0000) != 4) $stop;
+      if (decode(32'h0050_0000) != 5) $stop;
+      if (decode(32'h0050_0004) != 5) $stop;
+      if (decode(32'h0600_0000) != 6) $stop;
+      if (decode(32'h7000_0000) != 7) $stop;
+      if (decode(32'h8000_0000) != 8) $stop;
+      if (decode(32'hffff_fffc) != 9) $stop;
+      if (decode(32'h0000_0000) != 10) $stop;
+      if (decode(32'h0000_0011) != -1) $stop;
+      if (decode(32'h0050_0002) != -1) $stop;
+      if (decode(32'h8000_0001) != -1) $stop;
+      if (decode(32'hffff_ffff) != -1) $stop;
+      $write("*-* All Finished *-*\n");
+      $finish;
+   end
+
+endmodule
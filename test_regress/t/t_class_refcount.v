@@ -0,0 +1,45 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+class Node;
+   int value;
+   Node next;
+   function new(int v);
+      value = v;
+   endfunction
+endclass
+
+module t;
+   function automatic Node make(int v);
+      Node n = new(v);
+      return n;
+   endfunction
+
+   Node head;
+   Node n;
+   int sum;
+
+   initial begin
+      for (int i = 0; i < 10; ++i) begin
+         n = make(i);
+         n.next = head;
+         head = n;
+      end
+      sum = 0;
+      n = head;
+      while (n != null) begin
+         sum += n.value;
+         n = n.next;
+      end
+      if (sum != 45) $stop;
+      n = make(100);
+      if (n.value != 100) $stop;
+      head = null;
+      n = null;
+      $write("*-* All Finished *-*\n");
+      $finish;
+   end
+endmodule
@@ -0,0 +1,37 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+   input clk;
+
+   integer cyc = 0;
+   reg [7:0] div = 0;
+
+   always @(posedge clk) begin
+      cyc <= cyc + 1;
+      if (cyc < 64) div <= div + 1;
+      if (cyc == 71) begin
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+
+   // Many clocks, each with its own trigger
+   for (genvar i = 0; i < 8; ++i) begin : gen_clk
+      int count = 0;
+      always @(posedge div[i]) count <= count + 1;
+      always @(posedge clk) begin
+         if (cyc == 70 && count != (64 + (1 << i)) >> (i + 1)) begin
+            $display("%%Error: count[%0d] = %0d", i, count);
+            $stop;
+         end
+      end
+   end
+
+endmodule
@@ -0,0 +1,56 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+#include <verilated.h>
+
+#include <memory>
+#include <sys/wait.h>
+#include VM_PREFIX_INCLUDE
+
+// These require the above. Comment prevents clang-format moving them
+#include "TestCheck.h"
+
+//======================================================================
+
+int errors = 0;
+
+static void run(VerilatedContext* contextp, VM_PREFIX* topp, uint64_t until) {
+    while (contextp->time() < until && !contextp->gotFinish()) {
+        topp->clk = !topp->clk;
+        topp->eval();
+        contextp->timeInc(1);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    const std::unique_ptr<VerilatedContext> contextp{new VerilatedContext};
+    contextp->threads(2);
+    contextp->commandArgs(argc, argv);
+    const std::unique_ptr<VM_PREFIX> topp{new VM_PREFIX{contextp.get()}};
+
+    topp->clk = 0;
+    run(contextp.get(), topp.get(), 20);
+    const uint32_t forkCyc = topp->cyc;
+
+    const int pid = contextp->forkProcess();
+    TEST_CHECK_EQ(pid >= 0, true);
+    // Both processes continue from the same state
+    TEST_CHECK_EQ(topp->cyc, forkCyc);
+    run(contextp.get(), topp.get(), 40);
+    TEST_CHECK_EQ(topp->cyc, forkCyc + 10);
+    if (pid == 0) {
+        topp->final();
+        return errors ? 10 : 0;
+    }
+
+    int status = 0;
+    waitpid(pid, &status, 0);
+    TEST_CHECK_EQ(WIFEXITED(status) && WEXITSTATUS(status) == 0, true);
+    topp->final();
+    return errors ? 10 : 0;
+}
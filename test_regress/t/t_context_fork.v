@@ -0,0 +1,17 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t (/*AUTOARG*/
+   // Outputs
+   cyc,
+   // Inputs
+   clk
+   );
+   input clk;
+   output logic [31:0] cyc = 0;
+
+   always @(posedge clk) cyc <= cyc + 1;
+endmodule
@@ -0,0 +1,75 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//*************************************************************************
+//
+// Copyright 2025 by Wilson Snyder. This program is free software; you can
+// redistribute it and/or modify it under the terms of either the GNU
+// Lesser General Public License Version 3 or the Perl Artistic License
+// Version 2.0.
+// SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+//
+//*************************************************************************
+
+#include "verilated_cov.h"
+
+#include <cstdio>
+#include <iostream>
+
+// These require the above. Comment prevents clang-format moving them
+#include "TestCheck.h"
+
+#include VM_PREFIX_INCLUDE
+
+//======================================================================
+
+double sc_time_stamp() { return 0; }
+
+int errors = 0;
+
+//======================================================================
+
+int main() {
+    // Small domain, direct lookup
+    VerilatedCovBins small{4};
+    small.addRange(0, 0, 0);
+    small.addRange(1, 1, 7);
+    small.addRange(2, 4, 9);  // Overlaps bin 1
+    small.addRange(3, 20, 20);
+    small.addRange(3, 30, 31);  // Second range of bin 3
+    for (uint64_t value = 0; value < 40; ++value) small.sample(value);
+    small.sample(~0ULL);
+    TEST_CHECK_EQ(small.size(), 4);
+    TEST_CHECK_EQ(small.count(0), 1);
+    TEST_CHECK_EQ(small.count(1), 7);
+    TEST_CHECK_EQ(small.count(2), 6);
+    TEST_CHECK_EQ(small.count(3), 3);
+
+    // Large domain, binary search
+    VerilatedCovBins large{3};
+    large.addRange(0, 0x1000, 0x1fff);
+    large.addRange(1, 0x100000000ULL, 0x100000000ULL);
+    large.addRange(2, 0xffffffff00000000ULL, ~0ULL);
+    large.sample(0);
+    large.sample(0x1000);
+    large.sample(0x1fff);
+    large.sample(0x2000);
+    large.sample(0x100000000ULL);
+    large.sample(0x100000001ULL);
+    large.sample(~0ULL);
+    large.sample(0xffffffff00000000ULL);
+    TEST_CHECK_EQ(large.count(0), 2);
+    TEST_CHECK_EQ(large.count(1), 1);
+    TEST_CHECK_EQ(large.count(2), 2);
+
+    // Counts as coverage points
+    VerilatedCovContext* const covContextp = Verilated::defaultContextp()->coveragep();
+    for (uint32_t bin = 0; bin < small.size(); ++bin) {
+        VL_COVER_INSERT(covContextp, "top.t", small.countp(bin), "comment", "small",
+                        "bin", std::to_string(bin).c_str());
+    }
+    *small.countp(0) = 0;
+    small.sample(0);
+    TEST_CHECK_EQ(small.count(0), 1);
+
+    printf("*-* All Finished *-*\n");
+    return errors;
+}
@@ -0,0 +1,37 @@
+#!/usr/bin/env python3
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2025 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+import vltest_bootstrap
+
+test.scenarios('vlt')
+test.top_filename = "t/t_cover_lib.v"
+
+test.compile(v_flags2=["--coverage t/t_cover_lib_c.cpp"],
+             verilator_flags2=["--exe -Wall -Wno-DECLFILENAME"],
+             make_flags=['CPPFLAGS_ADD=-DT_COVER_DELTA -DTEST_OBJ_DIR="' + test.obj_dir + '"'],
+             make_top_shell=False,
+             make_main=False)
+
+test.execute()
+
+# Only changed points are appended after the first write
+test.file_grep_count(test.obj_dir + "/coverage_delta.dat", r"\nC '", 6 + 2 + 1)
+
+# Summing the appended deltas gives the same as writing the final counts
+test.run(cmd=[
+    os.environ["VERILATOR_ROOT"] + "/bin/verilator_coverage",
+    "--write",
+    test.obj_dir + "/coverage_merged.dat",
+    test.obj_dir + "/coverage_delta.dat",
+],
+         verilator_run=True)
+test.files_identical_sorted(test.obj_dir + "/coverage_merged.dat",
+                            test.obj_dir + "/coverage_full.dat")
+
+test.passes()
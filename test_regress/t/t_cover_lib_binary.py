@@ -0,0 +1,35 @@
+#!/usr/bin/env python3
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2025 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+import vltest_bootstrap
+
+test.scenarios('vlt')
+test.top_filename = "t/t_cover_lib.v"
+
+test.compile(v_flags2=["--coverage t/t_cover_lib_c.cpp"],
+             verilator_flags2=["--exe -Wall -Wno-DECLFILENAME"],
+             make_flags=['CPPFLAGS_ADD=-DT_COVER_LIB -DTEST_OBJ_DIR="' + test.obj_dir + '"'],
+             make_top_shell=False,
+             make_main=False)
+
+test.execute(all_run_flags=["+verilator+coverage+binary"])
+
+# Converting the binary files back to text must match the text format
+for n in ["1", "2", "3", "4", "1_per_instance"]:
+    test.run(cmd=[
+        os.environ["VERILATOR_ROOT"] + "/bin/verilator_coverage",
+        "--write",
+        test.obj_dir + "/coverage" + n + "_text.dat",
+        test.obj_dir + "/coverage" + n + ".dat",
+    ],
+             verilator_run=True)
+    test.files_identical_sorted(test.obj_dir + "/coverage" + n + "_text.dat",
+                                "t/t_cover_lib__" + n + ".out")
+
+test.passes()
@@ -88,6 +88,15 @@ int main() {
     Verilated::defaultContextp()->coverageFilename(VL_STRINGIFY(TEST_OBJ_DIR) "/coverage4.dat");
     TEST_CHECK_EQ(VerilatedCov::defaultFilename(), VL_STRINGIFY(TEST_OBJ_DIR) "/coverage4.dat");
     VerilatedCov::write();  // Uses defaultFilename()
+#elif defined(T_COVER_DELTA)
+    covContextp->writeDelta(VL_STRINGIFY(TEST_OBJ_DIR) "/coverage_delta.dat");
+    covers[0] += 5;
+    coverw[3] += 1;
+    covContextp->writeDelta(VL_STRINGIFY(TEST_OBJ_DIR) "/coverage_delta.dat");
+    covContextp->writeDelta(VL_STRINGIFY(TEST_OBJ_DIR) "/coverage_delta.dat");  // No change
+    coverw[5] += 2;
+    covContextp->writeDelta(VL_STRINGIFY(TEST_OBJ_DIR) "/coverage_delta.dat");
+    covContextp->write(VL_STRINGIFY(TEST_OBJ_DIR) "/coverage_full.dat");
 #else
 #error
 #endif
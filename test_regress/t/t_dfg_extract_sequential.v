@@ -0,0 +1,74 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+`define stop $stop
+`define check(got ,exp) do if ((got) !== (exp)) begin $write("%%Error: %s:%0d: cyc=%0d got='h%x exp='h%x\n", `__FILE__,`__LINE__, cyc, (got), (exp)); `stop; end while(0)
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+   input clk;
+
+   reg [31:0] cyc = 0;
+   wire rst = cyc < 3;
+   wire en = cyc[1];
+
+   reg [7:0] cnt;
+   reg [7:0] sumA;
+   reg [7:0] sumB;
+   reg [7:0] hold;
+   reg [7:0] prev;
+
+   always @(posedge clk) cyc <= cyc + 1;
+
+   // Reset and enable, with the register held otherwise
+   always @(posedge clk) begin
+      if (rst) cnt <= 8'd0;
+      else if (en) cnt <= cnt + 8'd1;
+   end
+
+   // Same next state expression in two procedures
+   always @(posedge clk) begin
+      if (rst) sumA <= 8'd0;
+      else sumA <= cnt + cyc[7:0];
+   end
+   always @(posedge clk) begin
+      if (rst) sumB <= 8'd0;
+      else sumB <= cnt + cyc[7:0];
+   end
+
+   // Written in two procedures, so cannot be turned into a conditional that holds
+   always @(posedge clk) if (en) hold <= cnt;
+   always @(posedge clk) if (!en) hold <= ~cnt;
+
+   // Reads the previous values of the registers
+   always @(posedge clk) prev <= sumA ^ hold;
+
+   reg [7:0] expCnt = 0;
+   reg [7:0] expSum = 0;
+   reg [7:0] expHold = 0;
+   reg [7:0] expPrev = 0;
+
+   always @(posedge clk) begin
+      if (cyc > 3) begin
+         `check(cnt, expCnt);
+         `check(sumA, expSum);
+         `check(sumB, expSum);
+         `check(hold, expHold);
+         `check(prev, expPrev);
+      end
+      expPrev <= expSum ^ expHold;
+      expHold <= en ? cnt : ~cnt;
+      expSum <= rst ? 8'd0 : cnt + cyc[7:0];
+      expCnt <= rst ? 8'd0 : en ? cnt + 8'd1 : cnt;
+      if (cyc == 99) begin
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+
+endmodule
@@ -0,0 +1,47 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+`define stop $stop
+`define check(got ,exp) do if ((got) !== (exp)) begin $write("%%Error: %s:%0d: cyc=%0d got='h%x exp='h%x\n", `__FILE__,`__LINE__, cyc, (got), (exp)); `stop; end while(0)
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+   input clk;
+
+   reg [31:0] cyc = 0;
+   reg [6:0] cntA = 0;
+   reg [6:0] cntB = 0;
+
+   always @ (posedge clk) begin
+      cyc <= cyc + 1;
+      cntA <= cntA + 7'd1;
+      if (cntA[0]) cntB <= cntB + 7'd3;
+   end
+
+   wire [7:0] oddA = {cntA, 1'b1};
+   wire [7:0] evenB = {cntB, 1'b0};
+   wire [15:0] zextA = {9'd0, cntA};
+
+   // Differ in bit 0, so never equal, becomes constant
+   wire never = oddA == evenB;
+   // Top bits are already zero, mask is redundant
+   wire [15:0] masked = zextA & 16'h00ff;
+   // Bit 0 is already one, or is redundant
+   wire [7:0] ored = oddA | 8'h01;
+
+   always @ (posedge clk) begin
+      `check(never, 1'b0);
+      `check(masked, {9'd0, cntA});
+      `check(ored, {cntA, 1'b1});
+      if (cyc == 99) begin
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+
+endmodule
@@ -175,6 +175,8 @@ module t (
    `signal(REPLACE_CONCAT_ZERO_AND_SEL_TOP_WITH_SHIFTR, {62'd0, rand_a[63:62]});
    `signal(REPLACE_CONCAT_SEL_BOTTOM_AND_ZERO_WITH_SHIFTL, {rand_a[1:0], 62'd0});
    `signal(PUSH_CONCAT_THROUGH_NOTS, {~(rand_a+64'd101), ~(rand_b+64'd101)} );
+   `signal(PUSH_CONCAT_THROUGH_BITWISE_OPS, {rand_a[3] & rand_b[3], rand_a[2] & rand_b[2]});
+   `signal(PUSH_CONCAT_THROUGH_BITWISE_OPS_NESTED, {rand_a[5] ^ rand_b[5], {rand_b[4] ^ rand_a[4], rand_a[0]}});
    `signal(REMOVE_CONCAT_OF_ADJOINING_SELS, {rand_a[10:3], rand_a[2:1]});
    `signal(REPLACE_NESTED_CONCAT_OF_ADJOINING_SELS_ON_LHS_CAT, {rand_a[2:1], rand_b});
    `signal(REPLACE_NESTED_CONCAT_OF_ADJOINING_SELS_ON_RHS_CAT, {rand_b, rand_a[10:3]});
@@ -193,6 +195,11 @@ module t (
    `signal(REPLACE_COND_WITH_THEN_BRANCH_ONES, rand_a[0] ? 1'd1 : rand_a[1]);
    `signal(REPLACE_COND_WITH_ELSE_BRANCH_ZERO, rand_a[0] ? rand_a[1] : 1'd0);
    `signal(REPLACE_COND_WITH_ELSE_BRANCH_ONES, rand_a[0] ? rand_a[1] : 1'd1);
+   `signal(REMOVE_COND_IN_THEN_WITH_SAME_CONDITION, randbit_a ? (randbit_a ? rand_a : rand_b) : const_a);
+   `signal(REMOVE_COND_IN_ELSE_WITH_SAME_CONDITION, randbit_a ? const_a : (randbit_a ? rand_a : rand_b));
+   `signal(REPLACE_ONE_HOT_MASK_TEST_WITH_SEL_EQ, (rand_a & 64'h10) == 64'h10);
+   `signal(REPLACE_ONE_HOT_MASK_TEST_WITH_SEL_NEQ, (rand_b & 64'h200) != 64'd0);
+   `signal(NO_REPLACE_ONE_HOT_MASK_TEST_WITH_SEL, (rand_b & 64'h300) != 64'd0);
    `signal(INLINE_ARRAYSEL, array[0]);
    `signal(NO_INLINE_ARRAYSEL_PARTIAL, array[2]);
    `signal(PUSH_BITWISE_THROUGH_REDUCTION_AND, (&(rand_a + 64'd105)) & (&(rand_b + 64'd108)));
@@ -228,10 +235,13 @@ module t (
    // Some selects need extra temporaries
    wire [63:0] sel_from_cond = rand_a[0] ? rand_a : const_a;
    wire [63:0] sel_from_shiftl = rand_a << 10;
+   wire [63:0] sel_from_shiftr = rand_a >> 10;
    wire [31:0] sel_from_sel = rand_a[10+:32];
 
    `signal(PUSH_SEL_THROUGH_COND, sel_from_cond[2]);
    `signal(PUSH_SEL_THROUGH_SHIFTL, sel_from_shiftl[20:0]);
+   `signal(PUSH_SEL_THROUGH_SHIFTR, sel_from_shiftr[20:4]);
+   `signal(NO_PUSH_SEL_THROUGH_SHIFTR, sel_from_shiftr[63:50]);
    `signal(REPLACE_SEL_FROM_SEL, sel_from_sel[4:3]);
 
    // Asscending ranges
@@ -0,0 +1,28 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t;
+   bit [7:0] u8;
+   bit signed [15:0] s16;
+   bit [40:0] u41;
+   bit signed [63:0] s64;
+   string s;
+
+   initial begin
+      u8 = 8'h0a;
+      s16 = -16'sd1234;
+      u41 = 41'h1_2345_6789;
+      s64 = -64'sd9;
+      s = "str";
+      $display("u8 %d %0d %x %0x %b %0b %c", u8, u8, u8, u8, u8, u8, 8'h41);
+      $display("s16 %d %0d %x", s16, s16, s16);
+      $display("u41 %d %0d %h %0h", u41, u41, u41, u41);
+      $display("s64 %d %0d", s64, s64);
+      $display("%m %s %% [%s]", s, $sformatf("%0d-%x", u8, s16));
+      $write("*-* All Finished *-*\n");
+      $finish;
+   end
+endmodule
@@ -21,7 +21,7 @@ if test.nc:
 test.compile(
     v_flags2=["t/" + test.name + ".cpp"],
     # --no-decoration so .out file doesn't comment on source lines
-    verilator_flags2=["-Wall -Wno-DECLFILENAME --no-decoration"],
+    verilator_flags2=["-Wall -Wno-DECLFILENAME --no-decoration --stats"],
     # NC: Gdd the obj_dir to the C include path
     nc_flags2=["+ncscargs+-I" + test.obj_dir],
     # ModelSim: Generate DPI header, add obj_dir to the C include path
@@ -30,6 +30,7 @@ test.compile(
 if test.vlt_all:
     test.files_identical(test.obj_dir + "/" + test.vm_prefix + "__Dpi.h",
                          "t/" + test.name + "__Dpi.out")
+    test.file_grep(test.stats, r'Optimizations, DPI arrays passed directly\s+[1-9]\d*')
 
 test.execute()
 
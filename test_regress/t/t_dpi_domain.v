@@ -0,0 +1,29 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+import "DPI-C" function void dpii_model_a(int value);
+import "DPI-C" function void dpii_model_b(int value);
+
+module t (clk);
+   input clk;
+   integer cyc = 0;
+
+   always @(posedge clk) begin
+      cyc <= cyc + 1;
+      if (cyc == 9) begin
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+
+   // Each model is its own domain, so calls to A need not be ordered
+   // against calls to B, but the two calls to A still are.
+   always @(posedge clk) dpii_model_a(cyc);
+   always @(posedge clk) dpii_model_a(cyc + 1);
+   always @(posedge clk) dpii_model_b(cyc);
+   always @(posedge clk) dpii_model_b(cyc + 1);
+
+endmodule
@@ -98,6 +98,12 @@ static int check_sub(const char* name, int i) {
 #ifndef T_DPI_EXPORT_NOOPT
     int out = dpix_sub_inst(100 * i);
     CHECK_RESULT(int, out, 100 * i + i);
+#ifdef VERILATOR
+    // Verilator extension, call in a scope without svSetScope
+    svSetScope(prev);
+    CHECK_RESULT(int, dpix_sub_inst__Vscope(scope, 100 * i), 100 * i + i);
+    CHECK_RESULT(svScope, svGetScope(), scope);
+#endif
 #endif
     return 0;  // OK
 }
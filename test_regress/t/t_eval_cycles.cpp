@@ -0,0 +1,53 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//
+// DESCRIPTION: Verilator: Verilog Test module for evalCycles
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+//
+
+#include <verilated.h>
+
+#include <iostream>
+#include <memory>
+
+// These require the above. Comment prevents clang-format moving them
+#include "TestCheck.h"
+
+#include VM_PREFIX_INCLUDE
+
+int errors = 0;
+
+int main(int argc, char** argv) {
+    const std::unique_ptr<VerilatedContext> contextp{new VerilatedContext};
+    contextp->commandArgs(argc, argv);
+    const std::unique_ptr<VM_PREFIX> topp{new VM_PREFIX{contextp.get()}};
+
+    // Plain run, two time steps per cycle
+    TEST_CHECK_EQ(topp->evalCycles(5, topp->clk, 2), 5);
+    TEST_CHECK_EQ(contextp->time(), 20);
+    TEST_CHECK_EQ(topp->clk, 0);
+
+    // Sample points, stopping early when the callback returns false
+    unsigned samples = 0;
+    const uint64_t ran = topp->evalCycles(
+        10, topp->clk, 1,
+        [&](uint64_t cycle) {
+            ++samples;
+            return cycle < 3;
+        },
+        1);
+    TEST_CHECK_EQ(ran, 3);
+    TEST_CHECK_EQ(samples, 3);
+
+    // Stops after $finish
+    TEST_CHECK_NE(topp->evalCycles(100, topp->clk), 100);
+    TEST_CHECK_EQ(contextp->gotFinish(), true);
+    TEST_CHECK_EQ(topp->done, 1);
+    topp->final();
+
+    if (errors) return 10;
+    std::cout << "*-* All Finished *-*\n";
+    return 0;
+}
@@ -0,0 +1,43 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+`define stop $stop
+`define checkh(gotv,expv) do if ((gotv) !== (expv)) begin $write("%%Error: %s:%0d:  got=%0x exp=%0x (%s !== %s)\n", `__FILE__,`__LINE__, (gotv), (expv), `"gotv`", `"expv`"); `stop; end while(0);
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+   input clk;
+
+   integer cyc = 0;
+   logic [255:0] a, b;
+   logic [255:0] x, o, n, m;
+   logic         eq;
+
+   always @(posedge clk) begin
+      x <= a ^ b;
+      o <= a | b;
+      n <= ~a;
+      m <= cyc[0] ? a : b;
+      eq <= a == b;
+   end
+
+   always @(posedge clk) begin
+      cyc <= cyc + 1;
+      a <= {8{cyc}};
+      b <= {8{32'h0f0f0f0f}};
+      if (cyc == 5) begin
+         `checkh(x, {8{32'd3 ^ 32'h0f0f0f0f}});
+         `checkh(o, {8{32'd3 | 32'h0f0f0f0f}});
+         `checkh(n, {8{~32'd3}});
+         `checkh(m, {8{32'h0f0f0f0f}});
+         `checkh(eq, 1'b0);
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+endmodule
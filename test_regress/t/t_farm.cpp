@@ -0,0 +1,71 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//
+// DESCRIPTION: Verilator: Verilog Test module for VerilatedFarm
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+//
+
+#include <verilated.h>
+#include <verilated_farm.h>
+
+#include <iostream>
+#include <memory>
+#include <vector>
+
+// These require the above. Comment prevents clang-format moving them
+#include "TestCheck.h"
+
+#include VM_PREFIX_INCLUDE
+
+int errors = 0;
+
+static constexpr unsigned INSTANCES = 16;
+
+static void runFarm(VerilatedFarm& farm, std::vector<uint32_t>& values) {
+    // TEST_CHECK is not thread safe, so record results, then check them here
+    values.assign(INSTANCES, 0);
+    std::vector<int> seeds(INSTANCES, 0);
+    std::vector<int> dones(INSTANCES, 0);
+    const unsigned failed = farm.run(INSTANCES, [&](VerilatedContext* contextp, unsigned index) {
+        seeds[index] = Verilated::threadContextp() == contextp ? contextp->randSeed() : -1;
+        const std::unique_ptr<VM_PREFIX> topp{new VM_PREFIX{contextp}};
+        topp->clk = 0;
+        while (!contextp->gotFinish()) {
+            topp->eval();
+            contextp->timeInc(1);
+            topp->clk = !topp->clk;
+        }
+        topp->final();
+        dones[index] = topp->done;
+        values[index] = topp->value;
+    });
+    TEST_CHECK_EQ(failed, 0);
+    for (unsigned i = 0; i < INSTANCES; ++i) {
+        TEST_CHECK_EQ(seeds[i], 10 + static_cast<int>(i));
+        TEST_CHECK_EQ(dones[i], 1);
+    }
+}
+
+int main(int argc, char** argv) {
+    VerilatedFarm farm{4};
+    farm.commandArgs(argc, argv);
+    farm.seedBase(10);
+    TEST_CHECK_EQ(farm.workers(), 4);
+    TEST_CHECK_EQ(VerilatedFarm::instanceFilename("coverage.dat", 3), "coverage_3.dat");
+    TEST_CHECK_EQ(VerilatedFarm::instanceFilename("obj/dump", 12), "obj/dump_12");
+
+    std::vector<uint32_t> first;
+    std::vector<uint32_t> second;
+    runFarm(farm, first);
+    runFarm(farm, second);
+    // Each instance is reproducible whatever else runs on the workers
+    for (unsigned i = 0; i < INSTANCES; ++i) TEST_CHECK_EQ(first[i], second[i]);
+    // Different seeds give different results
+    TEST_CHECK_NE(first[0], first[1]);
+
+    if (errors) return 10;
+    std::cout << "*-* All Finished *-*\n";
+    return 0;
+}
@@ -0,0 +1,26 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t (
+   input clk,
+   output logic [31:0] value,
+   output logic done
+);
+
+   int cyc = 0;
+
+   initial value = 0;
+
+   always @(posedge clk) begin
+      cyc <= cyc + 1;
+      value <= value ^ $urandom;
+      if (cyc == 20) begin
+         done <= 1'b1;
+         $finish;
+      end
+   end
+
+endmodule
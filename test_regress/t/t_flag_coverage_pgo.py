@@ -0,0 +1,26 @@
+#!/usr/bin/env python3
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2025 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+import vltest_bootstrap
+
+test.scenarios('vlt')
+
+test.compile(verilator_flags2=["--coverage-line"])
+
+test.execute()
+
+test.file_grep(test.obj_dir + "/coverage.dat", r'if')
+
+test.compile(verilator_flags2=["--stats", "--coverage-pgo", test.obj_dir + "/coverage.dat"])
+
+test.file_grep(test.stats, r'Optimizations, Branches predicted from coverage\s+[1-9]')
+
+test.execute()
+
+test.passes()
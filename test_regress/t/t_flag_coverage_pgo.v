@@ -0,0 +1,35 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+   input clk;
+
+   integer cyc = 0;
+   integer rare = 0;
+   integer sum = 0;
+
+   always @(posedge clk) begin
+      cyc <= cyc + 1;
+      if (cyc[4:0] == 5'd7) begin
+         rare <= rare + 1;
+      end
+      else begin
+         sum <= sum + 1;
+      end
+      case (cyc[1:0])
+        2'd0: sum <= sum + 2;
+        2'd1: sum <= sum + 3;
+        default: sum <= sum + 4;
+      endcase
+      if (cyc == 99) begin
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+endmodule
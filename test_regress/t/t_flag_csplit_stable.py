@@ -0,0 +1,49 @@
+#!/usr/bin/env python3
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2025 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+import vltest_bootstrap
+
+test.scenarios('vlt_all')
+test.top_filename = "t/t_flag_csplit.v"
+
+
+def check_stable_names():
+    found = False
+    for filename in test.glob_some(test.obj_dir + "/*DepSet_*.cpp"):
+        if re.search(r'DepSet_h[0-9a-f]+_h[0-9a-f]+__0', filename):
+            found = True
+        elif not re.search(r'DepSet_h[0-9a-f]+__0', filename):
+            test.error("Split file not named by content: " + filename)
+    if not found:
+        test.error("No content named split file found")
+
+
+test.compile(verilator_flags2=["--output-split 1 --output-split-stable"])
+
+test.execute()
+
+check_stable_names()
+
+first = {}
+for filename in test.glob_some(test.obj_dir + "/*DepSet_*.cpp"):
+    with open(filename, 'r', encoding="utf8") as fh:
+        first[filename] = fh.read()
+
+# A second run must produce identical files
+test.compile(verilator_flags2=["--output-split 1 --output-split-stable"])
+
+for filename in test.glob_some(test.obj_dir + "/*DepSet_*.cpp"):
+    if filename not in first:
+        test.error("New split file on rerun: " + filename)
+    else:
+        with open(filename, 'r', encoding="utf8") as fh:
+            if fh.read() != first[filename]:
+                test.error("Split file changed on rerun: " + filename)
+
+test.passes()
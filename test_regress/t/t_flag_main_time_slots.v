@@ -0,0 +1,28 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t;
+   int count = 0;
+
+   // Sparse events, so most time slots are empty
+   initial begin
+      #10;
+      count = count + 1;
+      #1000000;
+      count = count + 1;
+      #1;
+      count = count + 1;
+   end
+
+   initial begin
+      #2000000;
+      $write("[%0t] count=%0d\n", $time, count);
+      if ($time != 2000000) $stop;
+      if (count != 3) $stop;
+      $write("*-* All Finished *-*\n");
+      $finish;
+   end
+endmodule
@@ -0,0 +1,32 @@
+#!/usr/bin/env python3
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2025 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+import json
+
+import vltest_bootstrap
+
+test.scenarios('vlt')
+test.top_filename = "t/t_flag_stats.v"
+
+test.compile(verilator_flags2=['--prof-verilator'])
+
+filename = test.obj_dir + "/" + test.vm_prefix + "__prof_verilator.json"
+with open(filename, 'r', encoding="utf8") as fh:
+    events = json.load(fh)['traceEvents']
+
+names = [event['name'] for event in events]
+if 'const' not in names or 'emit' not in names:
+    test.error("Missing expected stages in " + filename)
+for event in events:
+    if event['ph'] != 'X' or event['dur'] < 0 or event['args']['cpuSec'] < 0:
+        test.error("Bad event in " + filename + ": " + str(event))
+if events[-1]['name'] != 'wrote':
+    test.error("Last stage should be 'wrote' in " + filename)
+
+test.passes()
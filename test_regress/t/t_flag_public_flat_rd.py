@@ -0,0 +1,22 @@
+#!/usr/bin/env python3
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2025 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+import vltest_bootstrap
+
+test.scenarios('vlt')
+
+test.compile(verilator_flags2=["--public-flat-rd", "--stats"])
+
+test.file_grep(test.stats, r'Optimizations, Gate observable sigs kept\s+([1-9]\d*)')
+# Still registered for VPI
+test.file_grep(test.obj_dir + "/" + test.vm_prefix + "__Syms.cpp", r'varInsert\(1,"b"')
+
+test.execute()
+
+test.passes()
@@ -0,0 +1,34 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+   input clk;
+
+   integer cyc = 0;
+   reg [31:0] sum = 0;
+
+   // Observable intermediate values, still substituted into their readers
+   wire [31:0] a = cyc * 3;
+   wire [31:0] b = a ^ 32'h5a5a_5a5a;
+   wire [31:0] c = b + a;
+
+   always @(posedge clk) begin
+      cyc <= cyc + 1;
+      sum <= sum + c;
+      if (c != (((cyc * 3) ^ 32'h5a5a_5a5a) + cyc * 3)) $stop;
+      if (cyc == 10) begin
+         if (sum != 32'h878787ae) begin
+            $display("%%Error: sum=%x", sum);
+            $stop;
+         end
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+endmodule
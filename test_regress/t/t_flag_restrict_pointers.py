@@ -0,0 +1,23 @@
+#!/usr/bin/env python3
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2025 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+import vltest_bootstrap
+
+test.scenarios('vlt_all')
+test.top_filename = "t/t_inst_tree.v"
+
+test.compile(v_flags2=["--restrict-pointers", test.t_dir + "/t_inst_tree_inl0_pub0.vlt"])
+
+test.execute()
+test.file_grep(test.run_log_filename, r"\] (%m|.*t\.ps): Clocked")
+
+files = test.glob_some(test.obj_dir + "/" + test.vm_prefix + "_*.cpp")
+test.file_grep_any(files, r'\* __restrict vlSelf')
+
+test.passes()
@@ -15,4 +15,7 @@ test.compile(verilator_flags2=["--stats --stats-vars"])
 
 test.execute()
 
+test.file_grep(test.stats, r'Node memory \(KiB\), VAR')
+test.file_grep(test.stats, r'Node FileLines, distinct')
+
 test.passes()
@@ -0,0 +1,40 @@
+#!/usr/bin/env python3
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2025 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+import json
+
+import vltest_bootstrap
+
+test.scenarios('vlt')
+
+test.compile(verilator_flags2=['--stats-model --trace-vcd'])
+
+test.execute()
+
+filename = test.obj_dir + "/" + test.vm_prefix + "__stats_model.json"
+with open(filename, 'r', encoding="utf8") as fh:
+    stats = json.load(fh)
+
+modules = {module['name']: module for module in stats['modules']}
+sub = modules.get('sub')
+if not sub or sub['instances'] != 2:
+    test.error("Expected two instances of 'sub' in " + filename)
+members = {member['name']: member for member in sub.get('members', [])}
+if members.get('mem', {}).get('kind') != 'VlUnpacked' or members['mem']['bytes'] != 256:
+    test.error("Expected 256 byte VlUnpacked 'mem' in " + filename)
+if members.get('wide', {}).get('kind') != 'VlWide' or members['wide']['bytes'] != 16:
+    test.error("Expected 16 byte VlWide 'wide' in " + filename)
+if stats['model_bytes'] < 2 * (256 + 16):
+    test.error("Model bytes too small in " + filename)
+if stats['trace_codes'] <= 0 or stats['trace_buffer_bytes'] != 4 * stats['trace_codes']:
+    test.error("Bad trace buffer size in " + filename)
+if stats['eval_instr_count'] <= 0 or stats['eval_working_set_bytes'] <= 0:
+    test.error("Missing eval working set in " + filename)
+
+test.passes()
@@ -0,0 +1,36 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+   input clk;
+
+   integer cyc = 0;
+
+   sub u_a (.clk(clk), .cyc(cyc));
+   sub u_b (.clk(clk), .cyc(cyc + 1));
+
+   always @(posedge clk) begin
+      cyc <= cyc + 1;
+      if (cyc == 9) begin
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+endmodule
+
+module sub (input clk, input integer cyc);
+   // verilator no_inline_module
+   logic [31:0] mem[64];
+   logic [127:0] wide;
+
+   always @(posedge clk) begin
+      mem[cyc[5:0]] <= cyc;
+      wide <= {wide[95:0], mem[cyc[5:0] + 6'd1]};
+   end
+endmodule
@@ -0,0 +1,22 @@
+#!/usr/bin/env python3
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2025 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+import vltest_bootstrap
+
+test.scenarios('simulator')
+test.top_filename = "t/t_force_release_net.v"
+
+test.compile(verilator_flags2=["-fforce-fast-path"])
+
+test.execute()
+
+files = test.glob_some(test.obj_dir + "/" + test.vm_prefix + "___*.h")
+test.file_grep_any(files, r'__VforceActive')
+
+test.passes()
@@ -0,0 +1,37 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t;
+   int sum = 0;
+   int seen[8];
+
+   initial begin
+      for (int i = 0; i < 8; ++i) begin
+         // Only read by the process, so copied into it
+         fork
+            automatic int id = i;
+            automatic int sq = id * id;
+            #(8 - id) begin
+               seen[id] = sq;
+               sum += id;
+            end
+         join_none
+      end
+      // Written by the process, so still shared through a dynamic scope
+      fork
+         automatic int count = 0;
+         begin
+            #1 count++;
+            #1 if (count != 1) $stop;
+         end
+      join_none
+      #20;
+      for (int i = 0; i < 8; ++i) if (seen[i] != i * i) $stop;
+      if (sum != 28) $stop;
+      $write("*-* All Finished *-*\n");
+      $finish;
+   end
+endmodule
@@ -0,0 +1,29 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t;
+
+   // Calls with repeated arguments can reuse earlier results
+   function automatic int square(int x);
+      return x * x;
+   endfunction
+
+   function automatic int sum_squares(int n);
+      int sum;
+      sum = 0;
+      for (int i = 0; i < n; ++i) sum += square(i % 4);
+      return sum;
+   endfunction
+
+   localparam int SUM = sum_squares(100);
+
+   initial begin
+      if (SUM !== 350) $stop;
+      $write("*-* All Finished *-*\n");
+      $finish;
+   end
+
+endmodule
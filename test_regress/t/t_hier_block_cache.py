@@ -0,0 +1,44 @@
+#!/usr/bin/env python3
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2025 by Wilson Snyder. This program is free software; you can
+# redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+import vltest_bootstrap
+import glob
+import shutil
+
+test.scenarios('vlt')
+test.top_filename = "t/t_hier_block.v"
+
+test.clean_objs()
+
+cache_dir = test.obj_dir + "/cache"
+flags = [
+    '--hierarchical', '--hierarchical-cache', cache_dir, '--Wno-TIMESCALEMOD', '--CFLAGS',
+    '"-pipe -DCPP_MACRO=cplusplus"'
+]
+
+test.compile(v_flags2=['t/t_hier_block.cpp'], verilator_flags2=flags)
+
+test.execute()
+
+# Each block's outputs and library are stored
+test.glob_some(cache_dir + "/*/manifest")
+test.glob_some(cache_dir + "/*/libsub0.a")
+
+# Restored from the cache, so neither Verilated nor compiled again
+shutil.rmtree(test.obj_dir + "/Vsub0")
+
+test.compile(v_flags2=['t/t_hier_block.cpp'], verilator_flags2=flags)
+
+test.execute()
+
+test.file_grep(test.obj_dir + "/Vsub0/sub0.sv", r'^module\s+(\S+)\s+', "sub0")
+if glob.glob(test.obj_dir + "/Vsub0/*.o"):
+    test.error("Restored hierarchical block was compiled again")
+
+test.passes()
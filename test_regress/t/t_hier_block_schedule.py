@@ -0,0 +1,23 @@
+#!/usr/bin/env python3
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2025 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+import vltest_bootstrap
+
+test.scenarios('vlt_all')
+
+test.compile(verilator_flags2=['--stats', '--hierarchical'])
+
+test.execute()
+
+# The leaf of the longest chain starts first, then its parent, then the smaller block
+test.file_grep(test.obj_dir + "/" + test.vm_prefix + "_hier.mk",
+               r'^hier_build: Vleaf/libleaf.a Vbig/libbig.a Vsmall/libsmall.a ')
+test.file_grep(test.stats, r'HierBlock,\s+Hierarchical blocks\s+(\d+)', 3)
+
+test.passes()
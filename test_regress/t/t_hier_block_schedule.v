@@ -0,0 +1,79 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+   input clk;
+
+   integer cyc = 0;
+   logic [31:0] in;
+   logic [31:0] out_small;
+   logic [31:0] out_big;
+
+   assign in = cyc;
+
+   small u_small(.clk, .in, .out(out_small));
+   big u_big(.clk, .in, .out(out_big));
+
+   always @(posedge clk) begin
+      cyc <= cyc + 1;
+      if (cyc == 10) begin
+         if (out_small != 32'h9) $stop;
+         if (out_big == 32'h0) $stop;
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+endmodule
+
+module small (/*AUTOARG*/
+   // Outputs
+   out,
+   // Inputs
+   clk, in
+   ); /*verilator hier_block*/
+   input clk;
+   input [31:0] in;
+   output logic [31:0] out;
+   always @(posedge clk) out <= in;
+endmodule
+
+module big (/*AUTOARG*/
+   // Outputs
+   out,
+   // Inputs
+   clk, in
+   ); /*verilator hier_block*/
+   input clk;
+   input [31:0] in;
+   output logic [31:0] out;
+
+   logic [31:0] leaf_out;
+   logic [31:0] stage [0:15];
+
+   leaf u_leaf(.in, .out(leaf_out));
+
+   always @(posedge clk) begin
+      stage[0] <= leaf_out ^ 32'h1234_5678;
+      for (int i = 1; i < 16; ++i) begin
+         stage[i] <= {stage[i - 1][30:0], stage[i - 1][31]} + stage[i - 1] * i;
+      end
+      out <= stage[15] ^ stage[7] ^ stage[3] ^ 32'h1;
+   end
+endmodule
+
+module leaf (/*AUTOARG*/
+   // Outputs
+   out,
+   // Inputs
+   in
+   ); /*verilator hier_block*/
+   input [31:0] in;
+   output [31:0] out;
+   assign out = ~in;
+endmodule
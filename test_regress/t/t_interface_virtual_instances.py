@@ -0,0 +1,23 @@
+#!/usr/bin/env python3
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2025 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+import vltest_bootstrap
+
+test.scenarios('simulator')
+
+test.compile(verilator_flags2=["--binary"])
+
+test.execute()
+
+if test.vlt_all:
+    files = test.glob_some(test.obj_dir + "/" + test.vm_prefix + "_*.h")
+    test.file_grep_any(files, r'__VvifTrigger\w*_Vtrigd_data')
+    test.file_grep_any(files, r'__VvifTrigger\w*_Vtrigm_addr')
+
+test.passes()
@@ -0,0 +1,54 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+interface Bus;
+  logic [15:0] data;
+  logic [15:0] addr;
+endinterface
+
+module t;
+  logic clk = 0;
+  integer cyc = 0;
+  Bus intf_a();
+  Bus intf_b();
+  virtual Bus vif;
+  logic [15:0] seen_a;
+  logic [15:0] seen_b;
+  logic [15:0] via_vif;
+
+  always @(posedge clk) begin
+    cyc <= cyc + 1;
+    // Direct writes to each instance
+    intf_a.data <= 16'(cyc);
+    intf_b.data <= 16'(cyc * 2);
+    // Write via virtual interface to a different member
+    vif.addr <= 16'(cyc + 100);
+  end
+
+  // Readers of specific instances
+  assign seen_a = intf_a.data + intf_a.addr;
+  assign seen_b = intf_b.data + intf_b.addr;
+  // Reader via virtual interface
+  assign via_vif = vif.data;
+
+  always @(negedge clk) begin
+    if (cyc > 2) begin
+      if (seen_a != 16'((cyc - 1) + (cyc + 99))) $stop;
+      if (seen_b != 16'((cyc - 1) * 2)) $stop;
+      if (via_vif != 16'(cyc - 1)) $stop;
+    end
+    if (cyc == 10) begin
+      $write("*-* All Finished *-*\n");
+      $finish;
+    end
+  end
+
+  initial begin
+    vif = intf_a;
+    intf_b.addr = 0;
+    forever #5ns clk = ~clk;
+  end
+endmodule
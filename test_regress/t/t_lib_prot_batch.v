@@ -0,0 +1,72 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+`ifdef PROCESS_TOP
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+   input clk;
+
+   int cyc = 0;
+   logic [7:0] a;
+   logic [32:0] b;
+   logic [64:0] c;
+   logic d;
+   logic [7:0] qa;
+   logic [32:0] qb;
+   logic [64:0] qc;
+   logic qd_comb;
+   // Inputs as sampled at the previous edge
+   logic [7:0] a_q;
+   logic [32:0] b_q;
+   logic [64:0] c_q;
+
+   assign a = 8'(cyc * 3);
+   assign b = {cyc[0], cyc * 32'h01010101};
+   assign c = {cyc, ~cyc, 1'b1};
+   assign d = cyc[3];
+
+   secret i_secret (.*);
+
+   always @(posedge clk) begin
+      cyc <= cyc + 1;
+      a_q <= a;
+      b_q <= b;
+      c_q <= c;
+      if (cyc > 2) begin
+         if (qa !== a_q + 8'd1) $stop;
+         if (qb !== (b_q ^ 33'h1_0000_0001)) $stop;
+         if (qc !== {c_q[0], c_q[64:1]}) $stop;
+      end
+      if (qd_comb !== (d ^ a[0])) $stop;
+      if (cyc == 20) begin
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+endmodule
+
+`else
+module secret (
+    input clk /*verilator clocker*/,
+    input [7:0] a,
+    input [32:0] b,
+    input [64:0] c,
+    input d,
+    output logic [7:0] qa,
+    output logic [32:0] qb,
+    output logic [64:0] qc,
+    output qd_comb
+);
+   always @(posedge clk) begin
+      qa <= a + 8'd1;
+      qb <= b ^ 33'h1_0000_0001;
+      qc <= {c[0], c[64:1]};
+   end
+   assign qd_comb = d ^ a[0];
+endmodule
+`endif
@@ -0,0 +1,47 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+   input clk;
+
+   integer cyc = 0;
+   reg [127:0] crc;
+   reg [127:0] q10, r10, q7f, r7f, qbig, rbig;
+
+   always @(posedge clk) begin
+      cyc <= cyc + 1;
+      q10 = crc / 128'd10;
+      r10 = crc % 128'd10;
+      q7f = crc / 128'h7fff_ffff;
+      r7f = crc % 128'h7fff_ffff;
+      qbig = crc / 128'h1_0000_0001;
+      rbig = crc % 128'h1_0000_0001;
+`ifdef TEST_VERBOSE
+      $write("[%0t] crc=%x q10=%x r10=%x\n", $time, crc, q10, r10);
+`endif
+      // Recombine quotient and remainder
+      if (q10 * 128'd10 + r10 != crc || r10 >= 128'd10) $stop;
+      if (q7f * 128'h7fff_ffff + r7f != crc || r7f >= 128'h7fff_ffff) $stop;
+      if (qbig * 128'h1_0000_0001 + rbig != crc || rbig >= 128'h1_0000_0001) $stop;
+      if (cyc == 0) begin
+         crc <= 128'h5aef0c8d_d70a4497_1234_5678_9abc_def0;
+      end
+      else if (cyc == 1) begin
+         if (q10 != 128'h0917e7a7_c8b43a0f_1b6b_a23f_42ac_7cb1) $stop;
+         if (r10 != 128'h6) $stop;
+      end
+      else if (cyc < 90) begin
+         crc <= {crc[126:0], crc[127] ^ crc[2] ^ crc[0]};
+      end
+      else begin
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+endmodule
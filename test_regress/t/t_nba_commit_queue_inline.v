@@ -0,0 +1,66 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+`define checkh(gotv,expv) do if ((gotv) !== (expv)) begin $write("%%Error: %s:%0d:  got='h%x exp='h%x\n", `__FILE__,`__LINE__, (gotv), (expv)); `stop; end while(0);
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+   input clk;
+
+   integer cyc = 0;
+
+   // Small memory, the commit queue holds an entry per element
+   logic [15:0] small[8];
+   logic [15:0] small_exp[8];
+   // Large memory, some updates overflow the inline buffer
+   logic [15:0] large[256];
+   logic [15:0] large_exp[256];
+
+   initial begin
+      for (int i = 0; i < 8; ++i) begin
+         small[i] = 0;
+         small_exp[i] = 0;
+      end
+      for (int i = 0; i < 256; ++i) begin
+         large[i] = 0;
+         large_exp[i] = 0;
+      end
+   end
+
+   always @(posedge clk) begin
+      cyc <= cyc + 1;
+      // Repeated partial updates of the same elements, later ones must win
+      for (int i = 0; i < 12; ++i) begin
+         small[(cyc + i) % 8][3:0] <= 4'(cyc + i);
+         small[(cyc * 3 + i) % 8][11:4] <= 8'(cyc * i);
+      end
+      for (int i = 0; i < 40; ++i) begin
+         large[(cyc * 7 + i * 3) % 256][7:0] <= 8'(cyc ^ i);
+         large[(cyc + i) % 256][15:4] <= 12'(cyc + i * 5);
+      end
+      // Same with blocking updates to compare against
+      for (int i = 0; i < 12; ++i) begin
+         small_exp[(cyc + i) % 8][3:0] = 4'(cyc + i);
+         small_exp[(cyc * 3 + i) % 8][11:4] = 8'(cyc * i);
+      end
+      for (int i = 0; i < 40; ++i) begin
+         large_exp[(cyc * 7 + i * 3) % 256][7:0] = 8'(cyc ^ i);
+         large_exp[(cyc + i) % 256][15:4] = 12'(cyc + i * 5);
+      end
+   end
+
+   always @(negedge clk) begin
+      for (int i = 0; i < 8; ++i) `checkh(small[i], small_exp[i]);
+      for (int i = 0; i < 256; ++i) `checkh(large[i], large_exp[i]);
+      if (cyc == 20) begin
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+
+endmodule
@@ -0,0 +1,45 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+`define checkh(gotv,expv) do if ((gotv) !== (expv)) begin $write("%%Error: %s:%0d:  got='h%x exp='h%x\n", `__FILE__,`__LINE__, (gotv), (expv)); `stop; end while(0);
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+   input clk;
+
+   integer cyc = 0;
+
+   // These are only read in the final block, so need no shadow variables
+   logic [31:0] last;
+   logic [7:0] mem[16];
+   logic [7:0] loop_mem[8];
+
+   always @(posedge clk) begin
+      cyc <= cyc + 1;
+      last <= cyc;
+      mem[cyc[3:0]] <= cyc[7:0];
+      for (int i = 0; i < 4; ++i) loop_mem[(cyc + i) % 8] <= 8'(cyc * 2 + i);
+      if (cyc == 20) begin
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+
+   final begin
+      `checkh(last, 20);
+      for (int i = 0; i < 16; ++i) `checkh(mem[i], 8'(i <= 4 ? 16 + i : i));
+      // Find the last cycle writing each element
+      for (int i = 0; i < 8; ++i) begin
+         int c;
+         c = 20;
+         while ((c + 0) % 8 != i && (c + 1) % 8 != i && (c + 2) % 8 != i && (c + 3) % 8 != i) c--;
+         `checkh(loop_mem[i], 8'(c * 2 + ((i - c) % 8 + 8) % 8));
+      end
+   end
+
+endmodule
@@ -0,0 +1,42 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+`define checkh(gotv,expv) do if ((gotv) !== (expv)) begin $write("%%Error: %s:%0d:  got='h%x exp='h%x\n", `__FILE__,`__LINE__, (gotv), (expv)); `stop; end while(0);
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+   input clk;
+
+   integer cyc = 0;
+   logic [31:0] tmp;
+   logic [31:0] pos = 0;
+   logic [31:0] neg = 0;
+
+   // The store to 'tmp' here is never observed, as the only reader below
+   // always overwrites it first
+   always @(posedge clk) begin
+      tmp = cyc * 3;
+   end
+
+   always @(negedge clk) begin
+      tmp = cyc + 1;
+      neg <= tmp;
+   end
+
+   always @(posedge clk) begin
+      cyc <= cyc + 1;
+      pos <= pos + cyc;
+      if (cyc == 10) begin
+         `checkh(pos, 32'd45);
+         `checkh(neg, cyc + 1);
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+
+endmodule
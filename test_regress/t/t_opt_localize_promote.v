@@ -0,0 +1,36 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+`define checkh(gotv,expv) do if ((gotv) !== (expv)) begin $write("%%Error: %s:%0d:  got='h%x exp='h%x\n", `__FILE__,`__LINE__, (gotv), (expv)); `stop; end while(0);
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+   input clk;
+
+   integer cyc = 0;
+   logic [31:0] acc = 0;
+   logic [31:0] res = 0;
+
+   // 'acc' is referenced often, and can be kept in a register
+   always @(posedge clk) begin
+      cyc <= cyc + 1;
+      acc = acc + cyc * 7;
+      if (acc[0]) acc = acc ^ 32'h5;
+      acc = acc + (acc >> 3);
+      res <= acc;
+   end
+
+   always @(negedge clk) begin
+      if (cyc == 20) begin
+         `checkh(res, 32'hd3a);
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+
+endmodule
@@ -0,0 +1,49 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+   input clk;
+
+   reg [3:0] cyc = 0;
+   reg [31:0] value;
+   reg [31:0] sum = 0;
+
+   always @(posedge clk) cyc <= cyc + 1;
+
+   // Large enough that the table is cache line aligned
+   always @* begin
+      case (cyc)
+        4'd0: value = 32'h9f767c45;
+        4'd1: value = 32'h4164d839;
+        4'd2: value = 32'hbde5c099;
+        4'd3: value = 32'h5bc8fbbc;
+        4'd4: value = 32'hcb91ce37;
+        4'd5: value = 32'hb0c11fde;
+        4'd6: value = 32'hf1446bea;
+        4'd7: value = 32'hd76d4330;
+        4'd8: value = 32'hbd69fe29;
+        4'd9: value = 32'ha6eb8c9e;
+        4'd10: value = 32'hec1d7da0;
+        4'd11: value = 32'h87b0b125;
+        4'd12: value = 32'h076ce2ef;
+        4'd13: value = 32'hd7210dff;
+        4'd14: value = 32'h77330bdb;
+        4'd15: value = 32'hc6a53877;
+      endcase
+   end
+
+   always @(posedge clk) begin
+      sum <= sum + value;
+      if (cyc == 15) begin
+         if (sum + value != 32'h34189cce) $stop;
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+endmodule
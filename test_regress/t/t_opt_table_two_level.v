@@ -0,0 +1,73 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+   input clk;
+
+   integer cyc = 0;
+   logic [11:0] in;
+   logic [7:0] out;
+   logic [31:0] sum = 0;
+
+   assign in = 12'h9c0 + cyc[11:0];
+
+   // Sparse decoder, only a small part of the input space decodes
+   always_comb begin
+      case (in)
+        12'ha00: out = 8'h0b;
+        12'ha07: out = 8'h30;
+        12'ha0e: out = 8'h55;
+        12'ha15: out = 8'h7a;
+        12'ha1c: out = 8'h9f;
+        12'ha23: out = 8'hc4;
+        12'ha2a: out = 8'he9;
+        12'ha31: out = 8'h0e;
+        12'ha38: out = 8'h33;
+        12'ha3f: out = 8'h58;
+        12'ha46: out = 8'h7d;
+        12'ha4d: out = 8'ha2;
+        12'ha54: out = 8'hc7;
+        12'ha5b: out = 8'hec;
+        12'ha62: out = 8'h11;
+        12'ha69: out = 8'h36;
+        12'ha70: out = 8'h5b;
+        12'ha77: out = 8'h80;
+        12'ha7e: out = 8'ha5;
+        12'ha85: out = 8'hca;
+        12'ha8c: out = 8'hef;
+        12'ha93: out = 8'h14;
+        12'ha9a: out = 8'h39;
+        12'haa1: out = 8'h5e;
+        12'haa8: out = 8'h83;
+        12'haaf: out = 8'ha8;
+        12'hab6: out = 8'hcd;
+        12'habd: out = 8'hf2;
+        12'hac4: out = 8'h17;
+        12'hacb: out = 8'h3c;
+        12'had2: out = 8'h61;
+        12'had9: out = 8'h86;
+        12'hae0: out = 8'hab;
+        12'hae7: out = 8'hd0;
+        12'haee: out = 8'hf5;
+        12'haf5: out = 8'h1a;
+        default: out = 8'h00;
+      endcase
+   end
+
+   always @(posedge clk) begin
+      cyc <= cyc + 1;
+      sum <= sum + {24'b0, out};
+      if (cyc == 400) begin
+         $display("sum=%0d", sum);
+         if (sum != 32'd4506) $stop;
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+endmodule
@@ -0,0 +1,41 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+`define stop $stop
+`define checkh(gotv,expv) do if ((gotv) !== (expv)) begin $write("%%Error: %s:%0d:  got=%0x exp=%0x (%s !== %s)\n", `__FILE__,`__LINE__, (gotv), (expv), `"gotv`", `"expv`"); `stop; end while(0);
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+   input clk;
+
+   integer cyc = 0;
+   wire rst = cyc < 2;
+
+   // Many processes testing the same condition, split over several functions
+   logic [7:0] a, b, c, d, e, f;
+   always @(posedge clk) if (rst) a <= 8'd1; else a <= a + 8'd1;
+   always @(posedge clk) if (rst) b <= 8'd2; else b <= b + 8'd2;
+   always @(posedge clk) if (rst) c <= 8'd3; else c <= c + 8'd3;
+   always @(posedge clk) if (rst) d <= 8'd4; else d <= d + 8'd4;
+   always @(posedge clk) if (rst) e <= 8'd5; else e <= e + 8'd5;
+   always @(posedge clk) if (rst) f <= 8'd6; else f <= f + 8'd6;
+
+   always @(posedge clk) begin
+      cyc <= cyc + 1;
+      if (cyc == 10) begin
+         `checkh(a, 8'd9);
+         `checkh(b, 8'd18);
+         `checkh(c, 8'd27);
+         `checkh(d, 8'd36);
+         `checkh(e, 8'd45);
+         `checkh(f, 8'd54);
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+endmodule
@@ -0,0 +1,22 @@
+#!/usr/bin/env python3
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2025 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+import vltest_bootstrap
+
+test.scenarios('vlt_all')
+test.top_filename = "t/t_gen_alw.v"  # Few output files
+
+test.compile(verilator_flags2=["--output-groups", "1", "--output-split", "1"])
+
+test.execute()
+
+# Explicit --output-groups concatenates even small models
+test.file_grep(test.obj_dir + "/" + test.vm_prefix + "_classes.mk", r'vm_classes_(Slow_)?0')
+
+test.passes()
@@ -0,0 +1,24 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t (
+    input clk,
+    output [7:0] o1,
+    output [7:0] o2
+);
+  // Same parameters in a different order must share one specialization
+  sub #(.A(3), .B(5)) u1 (.o(o1));
+  sub #(.B(5), .A(3)) u2 (.o(o2));
+endmodule
+
+module sub #(
+    parameter A = 1,
+    parameter B = 2
+) (
+    output [7:0] o
+);
+  assign o = A + B;
+endmodule
@@ -0,0 +1,27 @@
+#!/usr/bin/env python3
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2025 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+import vltest_bootstrap
+
+test.scenarios('vltmt')
+test.top_filename = "t/t_threads_crazy.v"
+
+test.compile(v_flags2=["--prof-pgo"], threads=2)
+
+test.execute(all_run_flags=["+verilator+prof+vlt+file+" + test.obj_dir + "/profile.vlt"])
+
+test.file_grep(test.obj_dir + "/profile.vlt", r'profile_data ')
+
+test.compile(v_flags2=["--stats", " " + test.obj_dir + "/profile.vlt"], threads=2)
+
+test.file_grep(test.stats, r'Optimizations, Variables placed cold by profile\s+\d+')
+
+test.execute()
+
+test.passes()
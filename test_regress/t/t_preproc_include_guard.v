@@ -0,0 +1,18 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+`include "t_preproc_include_guard.vh"
+`include "t_preproc_include_guard.vh"
+
+module t;
+`include "t_preproc_include_guard.vh"
+   wire [`T_PREPROC_WIDTH-1:0] w = '0;
+   initial begin
+      if ($bits(w) != 8) $stop;
+      $write("*-* All Finished *-*\n");
+      $finish;
+   end
+endmodule
@@ -0,0 +1,13 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+`ifndef T_PREPROC_INCLUDE_GUARD_VH
+`define T_PREPROC_INCLUDE_GUARD_VH
+`define T_PREPROC_WIDTH 8
+`ifdef T_PREPROC_NEVER
+`define T_PREPROC_WIDTH_BAD 1
+`endif
+`endif  // T_PREPROC_INCLUDE_GUARD_VH
@@ -0,0 +1,53 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//
+// DESCRIPTION: Verilator: Verilog Test module for --prof-eval
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+//
+
+#include <verilated.h>
+
+#include <iostream>
+#include <memory>
+
+// These require the above. Comment prevents clang-format moving them
+#include "TestCheck.h"
+
+#include VM_PREFIX_INCLUDE
+
+int errors = 0;
+
+int main(int argc, char** argv) {
+    const std::unique_ptr<VerilatedContext> contextp{new VerilatedContext};
+    contextp->commandArgs(argc, argv);
+    const std::unique_ptr<VM_PREFIX> topp{new VM_PREFIX{contextp.get()}};
+
+    uint64_t evals = 0;
+    topp->clk = 0;
+    while (!contextp->gotFinish() && evals < 1000) {
+        topp->clk = !topp->clk;
+        topp->eval();
+        ++evals;
+        contextp->timeInc(1);
+    }
+    topp->final();
+    TEST_CHECK_EQ(contextp->gotFinish(), true);
+
+    const std::map<std::string, uint64_t> counters = contextp->evalCounters();
+    TEST_CHECK_EQ(counters.at("TOP.evals"), evals);
+    // Each eval() runs the 'nba' loop once, and it iterates at least once
+    TEST_CHECK_EQ(counters.at("TOP.nba.loops"), evals);
+    TEST_CHECK_NE(counters.at("TOP.nba.iterations") >= evals, false);
+    uint64_t fires = 0;
+    for (const auto& pair : counters) {
+        if (pair.first.find("TOP.act.trigger") == 0) fires += pair.second;
+    }
+    // The posedge clk trigger fires on every other eval()
+    TEST_CHECK_NE(fires >= evals / 2, false);
+
+    if (errors) return 10;
+    std::cout << "*-* All Finished *-*\n";
+    return 0;
+}
@@ -0,0 +1,27 @@
+#!/usr/bin/env python3
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2025 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+import vltest_bootstrap
+
+test.scenarios('vlt_all')
+test.top_filename = "t/t_farm.v"
+
+test.compile(make_top_shell=False,
+             make_main=False,
+             verilator_flags2=["--exe", test.pli_filename, "-cc", "--prof-eval"])
+
+dat = test.obj_dir + "/profile_eval.dat"
+
+test.execute(all_run_flags=["+verilator+prof+eval+file+" + dat])
+
+test.file_grep(dat, r'VLPROFEVAL model ' + test.vm_prefix)
+test.file_grep(dat, r'VLPROFEVAL region nba loops \d+')
+test.file_grep(dat, r'VLPROFEVAL trigger act \d+ fires \d+ @\(posedge .*clk\)')
+
+test.passes()
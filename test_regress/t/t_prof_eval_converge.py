@@ -0,0 +1,23 @@
+#!/usr/bin/env python3
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2025 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+import vltest_bootstrap
+
+test.scenarios('vlt_all')
+
+test.compile(verilator_flags2=["--prof-eval", "-Wno-UNOPTFLAT", "-fno-dfg", "-fno-var-split"])
+
+dat = test.obj_dir + "/profile_eval.dat"
+
+test.execute(all_run_flags=["+verilator+prof+eval+file+" + dat])
+
+test.file_grep(test.run_log_filename,
+               r"%Warning: .*'(ico|act)' region took .* iterations per evaluation on average")
+
+test.passes()
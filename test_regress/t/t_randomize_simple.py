@@ -0,0 +1,24 @@
+#!/usr/bin/env python3
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2025 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+import vltest_bootstrap
+
+test.scenarios('simulator')
+
+# Independent constraints need no solver, so this runs even without one
+test.compile(verilator_flags2=['--stats', '-Wno-CONSTRAINTIGN'])
+
+if test.vlt_all:
+    test.file_grep(test.stats, r'Randomize, classes without solver\s+(\d+)', 2)
+    for filename in test.glob_some(test.obj_dir + "/" + test.vm_prefix + "*Simple*.cpp"):
+        test.file_grep_not(filename, r'\.next\(__Vm_rng\)')
+
+test.execute()
+
+test.passes()
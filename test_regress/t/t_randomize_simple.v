@@ -0,0 +1,40 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+class Base;
+   rand bit [7:0] a;
+   constraint a_c { a inside {[10:20], 200}; a != 15; }
+endclass
+
+class Simple extends Base;
+   rand int b;
+   rand bit signed [7:0] c;
+   rand bit [63:0] d;
+   rand bit [3:0] e;
+   constraint b_c { b > -5; b < 5; }
+   constraint c_c { c <= -100 || c >= 120; }
+   constraint d_c { d != 0; }
+   constraint e_c { e dist { 1 := 1, [5:6] :/ 2 }; }
+endclass
+
+module t;
+   initial begin
+      Simple obj = new;
+      int seen_b[int];
+      repeat (200) begin
+         if (obj.randomize() != 1) $stop;
+         if (!((obj.a >= 10 && obj.a <= 20) || obj.a == 200) || obj.a == 15) $stop;
+         if (obj.b <= -5 || obj.b >= 5) $stop;
+         if (obj.c > -100 && obj.c < 120) $stop;
+         if (obj.d == 0) $stop;
+         if (!(obj.e inside {1, 5, 6})) $stop;
+         seen_b[obj.b] = 1;
+      end
+      if (seen_b.num() != 9) $stop;
+      $write("*-* All Finished *-*\n");
+      $finish;
+   end
+endmodule
@@ -0,0 +1,45 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+   input clk;
+
+   integer cyc = 0;
+
+   // Register file with snapshot and restore
+   logic [127:0] regs [0:31];
+   logic [127:0] snap [0:31];
+   logic [7:0] bytes [0:63];
+
+   always @(posedge clk) begin
+      cyc <= cyc + 1;
+      if (cyc == 0) begin
+         for (int i = 0; i < 32; ++i) regs[i] <= {4{i}};
+         for (int i = 0; i < 64; ++i) bytes[i] <= 8'h5a;
+      end
+      else if (cyc == 1) begin
+         for (int i = 0; i < 32; ++i) snap[i] <= regs[i];
+      end
+      else if (cyc == 2) begin
+         for (int i = 0; i < 32; ++i) regs[i] <= 0;
+         for (int i = 8; i < 40; ++i) bytes[i] <= 8'ha5;
+      end
+      else if (cyc == 3) begin
+         if (regs[5] != 0) $stop;
+         for (int i = 0; i < 32; ++i) regs[i] <= snap[i];
+      end
+      else if (cyc == 4) begin
+         for (int i = 0; i < 32; ++i) if (regs[i] != {4{i}}) $stop;
+         if (bytes[7] != 8'h5a || bytes[8] != 8'ha5 || bytes[39] != 8'ha5) $stop;
+         if (bytes[40] != 8'h5a) $stop;
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+endmodule
@@ -20,5 +20,6 @@ if test.vlt:
     # Note, with vltmt this might be split differently, so only checking vlt
     test.file_grep(test.stats, r'Optimizations, Reloop iterations\s+(\d+)', 125)
     test.file_grep(test.stats, r'Optimizations, Reloops\s+(\d+)', 2)
+    test.file_grep(test.stats, r'Optimizations, Reloop bulk copies\s+(\d+)', 2)
 
 test.passes()
@@ -0,0 +1,85 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+#include <verilated.h>
+#include <verilated_save.h>
+
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include VM_PREFIX_INCLUDE
+
+// These require the above. Comment prevents clang-format moving them
+#include "TestCheck.h"
+
+//======================================================================
+
+int errors = 0;
+
+static void cycle(VM_PREFIX* topp, int n) {
+    for (int i = 0; i < n; ++i) {
+        topp->clk = 0;
+        topp->eval();
+        topp->clk = 1;
+        topp->eval();
+    }
+}
+
+static void savePlain(VM_PREFIX* topp, const std::string& filename) {
+    VerilatedSave os;
+    os.open(filename);
+    os << *topp;
+    os.close();
+}
+
+static std::string slurp(const std::string& filename) {
+    std::ifstream is{filename, std::ios::binary};
+    return std::string{std::istreambuf_iterator<char>{is}, std::istreambuf_iterator<char>{}};
+}
+
+int main(int argc, char* argv[]) {
+    const std::unique_ptr<VerilatedContext> contextp{new VerilatedContext};
+    contextp->commandArgs(argc, argv);
+    const std::string dir = VL_STRINGIFY(TEST_OBJ_DIR);
+
+    {
+        const std::unique_ptr<VM_PREFIX> topp{new VM_PREFIX{contextp.get()}};
+        VerilatedSave os;
+        os.compress(true);
+        os.incremental(true);
+        for (int i = 0; i < 3; ++i) {
+            cycle(topp.get(), 10);
+            os.open(dir + "/incr" + std::to_string(i) + ".vltsv");
+            TEST_CHECK_EQ(os.isOpen(), true);
+            os << *topp;
+            os.close();
+            savePlain(topp.get(), dir + "/plain" + std::to_string(i) + ".vltsv");
+        }
+        // Incremental saves only hold changed blocks
+        TEST_CHECK_EQ(slurp(dir + "/incr2.vltsv").size() < slurp(dir + "/incr0.vltsv").size(),
+                      true);
+        TEST_CHECK_EQ(slurp(dir + "/incr0.vltsv").size() < slurp(dir + "/plain0.vltsv").size(),
+                      true);
+    }
+
+    for (int i = 0; i < 3; ++i) {
+        const std::unique_ptr<VM_PREFIX> topp{new VM_PREFIX{contextp.get()}};
+        VerilatedRestore os;
+        os.open(dir + "/incr" + std::to_string(i) + ".vltsv");
+        TEST_CHECK_EQ(os.isOpen(), true);
+        os >> *topp;
+        os.close();
+        savePlain(topp.get(), dir + "/replain.vltsv");
+        TEST_CHECK_EQ(slurp(dir + "/replain.vltsv") == slurp(dir + "/plain" + std::to_string(i)
+                                                              + ".vltsv"),
+                      true);
+    }
+
+    return errors ? 10 : 0;
+}
@@ -0,0 +1,22 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+   input clk;
+
+   integer cyc = 0;
+   logic [31:0] mem [0:65535];
+
+   initial for (int i = 0; i < 65536; ++i) mem[i] = i / 64;
+
+   always @(posedge clk) begin
+      cyc <= cyc + 1;
+      mem[cyc * 1000 % 65536] <= cyc;
+   end
+endmodule
@@ -0,0 +1,62 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+`define stop $stop
+`define check(got ,exp) do if ((got) !== (exp)) begin $write("%%Error: %s:%0d: cyc=%0d got='h%x exp='h%x\n", `__FILE__,`__LINE__, cyc, (got), (exp)); `stop; end while(0)
+
+// Latch based clock gate
+module icg_latch(input clk, input en, output gclk);
+   logic en_l;
+   always_latch if (!clk) en_l = en;
+   assign gclk = clk & en_l;
+endmodule
+
+// Flop based clock gate
+module icg_flop(input clk, input en, output gclk);
+   logic en_q = 1'b0;
+   always @(negedge clk) en_q <= en;
+   assign gclk = en_q & clk;
+endmodule
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+   input clk;
+
+   reg [31:0] cyc = 0;
+   wire enA = cyc[1:0] == 2'd0;
+   wire enB = cyc[2];
+
+   always @ (posedge clk) cyc <= cyc + 1;
+
+   wire gclkA;
+   wire gclkB;
+   icg_latch icgA(.clk(clk), .en(enA), .gclk(gclkA));
+   icg_flop icgB(.clk(clk), .en(enB), .gclk(gclkB));
+
+   reg [31:0] cntA = 0;
+   reg [31:0] cntB = 0;
+   always @ (posedge gclkA) cntA <= cntA + 1;
+   always @ (posedge gclkB) cntB <= cntB + 1;
+
+   // Reference models
+   reg [31:0] expA = 0;
+   reg [31:0] expB = 0;
+   always @ (posedge clk) begin
+      if (enA) expA <= expA + 1;
+      if (enB) expB <= expB + 1;
+   end
+
+   always @ (posedge clk) begin
+      `check(cntA, expA);
+      `check(cntB, expB);
+      if (cyc == 99) begin
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+endmodule
@@ -0,0 +1,53 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+`define stop $stop
+`define check(got ,exp) do if ((got) !== (exp)) begin $write("%%Error: %s:%0d: cyc=%0d got='h%x exp='h%x\n", `__FILE__,`__LINE__, cyc, (got), (exp)); `stop; end while(0)
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+   input clk;
+
+   reg [31:0] cyc = 0;
+   reg [31:0] state = 32'h12345678;
+
+   always @ (posedge clk) begin
+      cyc <= cyc + 1;
+      state <= {state[30:0], state[31] ^ state[21] ^ state[1] ^ state[0]};
+   end
+
+   // Reads both a top level input, and clocked state, so is replicated into 'ico' and 'nba'
+   logic [31:0] mixed;
+   always_comb begin
+      mixed = state;
+      for (int i = 0; i < 16; ++i) begin
+         mixed = mixed ^ {mixed[26:0], mixed[31:27]};
+         mixed = mixed + {31'd0, clk} + 32'h9e3779b9;
+      end
+   end
+
+   function automatic [31:0] mix(input [31:0] x, input c);
+      reg [31:0] h;
+      h = x;
+      for (int i = 0; i < 16; ++i) begin
+         h = h ^ {h[26:0], h[31:27]};
+         h = h + {31'd0, c} + 32'h9e3779b9;
+      end
+      return h;
+   endfunction
+
+   always @ (negedge clk) `check(mixed, mix(state, 1'b0));
+
+   always @ (posedge clk) begin
+      `check(mixed, mix(state, 1'b1));
+      if (cyc == 99) begin
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+endmodule
@@ -0,0 +1,52 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//
+// DESCRIPTION: Verilator: Verilog Test module for --skip-idle-eval
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+//
+
+#include <verilated.h>
+
+#include <iostream>
+#include <memory>
+
+// These require the above. Comment prevents clang-format moving them
+#include "TestCheck.h"
+
+#include VM_PREFIX_INCLUDE
+
+int errors = 0;
+
+int main(int argc, char** argv) {
+    const std::unique_ptr<VerilatedContext> contextp{new VerilatedContext};
+    contextp->commandArgs(argc, argv);
+    const std::unique_ptr<VM_PREFIX> topp{new VM_PREFIX{contextp.get()}};
+
+    uint64_t cycles = 0;
+    topp->clk = 0;
+    while (!contextp->gotFinish() && cycles < 100) {
+        topp->clk = !topp->clk;
+        if (topp->clk) ++cycles;
+        topp->eval();
+        // Nothing changed, so these return immediately, but must not lose state
+        const uint32_t value = topp->value;
+        topp->eval();
+        topp->eval();
+        TEST_CHECK_EQ(topp->value, value);
+        // Forces the next evaluation, as if a public signal was written
+        contextp->signalsWritten();
+        topp->eval();
+        TEST_CHECK_EQ(topp->value, value);
+        contextp->timeInc(1);
+    }
+    topp->final();
+
+    TEST_CHECK_EQ(contextp->gotFinish(), true);
+    TEST_CHECK_EQ(topp->done, 1);
+
+    if (errors) return 10;
+    std::cout << "*-* All Finished *-*\n";
+    return 0;
+}
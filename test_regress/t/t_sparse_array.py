@@ -0,0 +1,25 @@
+#!/usr/bin/env python3
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2025 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+import vltest_bootstrap
+
+test.scenarios('vlt_all')
+
+test.compile(verilator_flags2=['--sparse-array-threshold 1'])
+
+test.file_grep(test.obj_dir + "/" + test.vm_prefix + "___024root.h",
+               r'VlSparseUnpacked<QData.*, 1048576> \S*dram;')
+test.file_grep(test.obj_dir + "/" + test.vm_prefix + "___024root.h",
+               r'VlSparseUnpacked<VlWide<6>.*, 65536> \S*hex;')
+test.file_grep(test.obj_dir + "/" + test.vm_prefix + "___024root.h",
+               r'VlUnpacked<CData.*, 16> \S*small;')
+
+test.execute()
+
+test.passes()
@@ -0,0 +1,44 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+   input clk;
+
+   integer cyc = 0;
+
+   // Large enough for --sparse-array-threshold 1
+   reg [63:0] dram [0:(1<<20)-1];  // 8 MB
+   reg [175:0] hex [0:(1<<16)-1];  // 1.5 MB
+   reg [7:0] small [0:15];  // Dense
+
+   initial begin
+      $readmemh("t/t_sys_readmem_h.mem", hex);
+      if (hex['h04] != 176'h400437654321276543211765432107654321abcdef10) $stop;
+      if (hex['h0c] != 176'h400c37654321276543211765432107654321abcdef13) $stop;
+      if (hex['h05] != 176'h0) $stop;
+      if (hex['hffff] != 176'h0) $stop;
+   end
+
+   always @(posedge clk) begin
+      cyc <= cyc + 1;
+      if (cyc < 10) begin
+         dram[cyc * 'h1_2345] <= {32'hdead_0000 | cyc, 32'h0};
+         small[cyc] <= cyc[7:0];
+      end
+      else if (cyc < 20) begin
+         if (dram[(cyc - 10) * 'h1_2345] != {32'hdead_0000 | (cyc - 10), 32'h0}) $stop;
+         if (dram[(cyc - 10) * 'h1_2345 + 1] != 64'h0) $stop;
+         if (small[cyc - 10] != (cyc - 10)) $stop;
+      end
+      else begin
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+endmodule
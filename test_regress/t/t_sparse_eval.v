@@ -0,0 +1,51 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+`define stop $stop
+`define check(got ,exp) do if ((got) !== (exp)) begin $write("%%Error: %s:%0d: cyc=%0d got='h%x exp='h%x\n", `__FILE__,`__LINE__, cyc, (got), (exp)); `stop; end while(0)
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+   input clk;
+
+   reg [31:0] cyc = 0;
+   // Changes only every 8th cycle, so the logic below is idle most cycles
+   reg [15:0] slow = 16'h1234;
+
+   always @ (posedge clk) begin
+      cyc <= cyc + 1;
+      if (cyc[2:0] == 3'd7) slow <= slow * 16'd25173 + 16'd13849;
+   end
+
+   function automatic [15:0] mix(input [15:0] x);
+      reg [15:0] h;
+      h = x;
+      for (int i = 0; i < 8; ++i) begin
+         h = h ^ {h[6:0], h[15:7]};
+         h = h + (h >> 3) + 16'h9e37;
+      end
+      return h;
+   endfunction
+
+   logic [15:0] hash /*verilator public_flat_rd*/;
+   always_comb begin
+      hash = slow;
+      for (int i = 0; i < 8; ++i) begin
+         hash = hash ^ {hash[6:0], hash[15:7]};
+         hash = hash + (hash >> 3) + 16'h9e37;
+      end
+   end
+
+   always @ (posedge clk) begin
+      `check(hash, mix(slow));
+      if (cyc == 99) begin
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+endmodule
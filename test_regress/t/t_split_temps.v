@@ -0,0 +1,47 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+
+   input clk;
+   integer cyc = 0;
+   reg [63:0] crc = 64'h5aef0c8d_d70a4497;
+
+   // Everything hangs off the temporary, so plain splitting can't split
+   // this, but -fsplit-temps can make four blocks of it
+   logic [15:0] tmp;
+   logic [15:0] a, b, c;
+   always_comb begin
+      tmp = crc[15:0] ^ {crc[7:0], crc[15:8]};
+      a = ((tmp + crc[31:16]) ^ (tmp >> 3)) + ((tmp << 2) - crc[47:32]);
+      b = ((tmp - crc[47:32]) ^ (tmp << 5)) + ((tmp >> 1) & crc[63:48]);
+      if (tmp[0]) c = (tmp ^ crc[63:48]) + (crc[31:16] | (tmp >> 7));
+      else c = (tmp & crc[31:16]) - (crc[47:32] ^ (tmp << 4));
+   end
+
+   // Same logic without the temporary, to check against
+   wire [15:0] tmp_e = crc[15:0] ^ {crc[7:0], crc[15:8]};
+   wire [15:0] a_e = ((tmp_e + crc[31:16]) ^ (tmp_e >> 3)) + ((tmp_e << 2) - crc[47:32]);
+   wire [15:0] b_e = ((tmp_e - crc[47:32]) ^ (tmp_e << 5)) + ((tmp_e >> 1) & crc[63:48]);
+   wire [15:0] c_e = tmp_e[0] ? (tmp_e ^ crc[63:48]) + (crc[31:16] | (tmp_e >> 7))
+                     : (tmp_e & crc[31:16]) - (crc[47:32] ^ (tmp_e << 4));
+
+   always @ (posedge clk) begin
+      cyc <= cyc + 1;
+      crc <= {crc[62:0], crc[63] ^ crc[2] ^ crc[0]};
+`ifdef TEST_VERBOSE
+      $write("[%0t] cyc==%0d crc=%x a=%x b=%x c=%x\n", $time, cyc, crc, a, b, c);
+`endif
+      if (a !== a_e || b !== b_e || c !== c_e) $stop;
+      if (cyc == 99) begin
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+endmodule
@@ -0,0 +1,47 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+
+   input clk;
+   integer cyc = 0;
+   reg [63:0] crc = 64'h5aef0c8d_d70a4497;
+
+   // Without splitting the elements depend on each other in a loop (UNOPTFLAT)
+   logic [7:0] chain [0:3];
+   assign chain[0] = crc[7:0];
+   assign chain[1] = chain[0] + 8'd1;
+   always_comb begin
+      chain[2] = chain[1] ^ crc[15:8];
+      chain[3] = chain[2] + chain[0];
+   end
+
+   // Accessed with a variable index, so not split
+   logic [7:0] mem [0:3];
+   always @(posedge clk) mem[crc[1:0]] <= crc[15:8];
+
+   wire [7:0] c0 = crc[7:0];
+   wire [7:0] c1 = c0 + 8'd1;
+   wire [7:0] c2 = c1 ^ crc[15:8];
+   wire [7:0] c3 = c2 + c0;
+
+   always @(posedge clk) begin
+      cyc <= cyc + 1;
+      crc <= {crc[62:0], crc[63] ^ crc[2] ^ crc[0]};
+`ifdef TEST_VERBOSE
+      $write("[%0t] cyc==%0d %x %x %x %x %x\n", $time, cyc, chain[0], chain[1], chain[2],
+             chain[3], mem[0]);
+`endif
+      if (chain[0] !== c0 || chain[1] !== c1 || chain[2] !== c2 || chain[3] !== c3) $stop;
+      if (cyc == 99) begin
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+endmodule
@@ -0,0 +1,42 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+`define stop $stop
+`define checkh(gotv,expv) do if ((gotv) !== (expv)) begin $write("%%Error: %s:%0d:  got=%0x exp=%0x (%s !== %s)\n", `__FILE__,`__LINE__, (gotv), (expv), `"gotv`", `"expv`"); `stop; end while(0);
+
+module t(/*AUTOARG*/
+   // Inputs
+   clk
+   );
+
+  input clk;
+
+  logic [31:0] cnt = 0;
+
+  // Assigned whole, but only read via narrow selects, so split into lanes
+  wire [127:0] lanes;
+  assign lanes = {cnt + 32'd3, cnt + 32'd2, cnt + 32'd1, cnt};
+
+  // Assigned whole, but one select is wide, so not split
+  wire [127:0] wideLanes;
+  assign wideLanes = {cnt, cnt, cnt, cnt};
+
+  always @(posedge clk) begin
+    `checkh(lanes[31:0], cnt);
+    `checkh(lanes[63:32], cnt + 32'd1);
+    `checkh(lanes[95:64], cnt + 32'd2);
+    `checkh(lanes[127:96], cnt + 32'd3);
+    `checkh(wideLanes[95:0], {cnt, cnt, cnt});
+
+    cnt <= cnt + 32'd1;
+
+    if (cnt == 20) begin
+      $write("*-* All Finished *-*\n");
+      $finish;
+    end
+  end
+
+endmodule
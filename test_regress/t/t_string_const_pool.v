@@ -0,0 +1,34 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+   input clk;
+
+   int cyc = 0;
+   string s;
+   string t;
+   int matches = 0;
+
+   function automatic string name(int i);
+      return (i % 2 == 0) ? "an even cycle number here" : "an odd cycle number here";
+   endfunction
+
+   always @(posedge clk) begin
+      cyc <= cyc + 1;
+      s = name(cyc);
+      if (s == "an even cycle number here") matches = matches + 1;
+      t = {s, " with a long suffix"};
+      if (cyc == 10) begin
+         if (matches != 6) $stop;
+         if (t != "an even cycle number here with a long suffix") $stop;
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+endmodule
@@ -0,0 +1,23 @@
+#!/usr/bin/env python3
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2025 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+import vltest_bootstrap
+
+test.scenarios('vltmt')
+test.top_filename = "t/t_threads_crazy.v"
+
+test.compile(verilator_flags2=['--cc --stats'], threads=4)
+
+test.file_grep(test.stats, r'Optimizations, Cache lines shared across threads \(estimated\)\s+(\d+)')
+
+test.file_grep(test.obj_dir + "/" + test.vm_prefix + "___024root.h", r'alignas\(VL_CACHE_LINE_BYTES\) ')
+
+test.execute()
+
+test.passes()
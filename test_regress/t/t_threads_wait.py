@@ -0,0 +1,31 @@
+#!/usr/bin/env python3
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2025 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+import vltest_bootstrap
+
+test.scenarios('vltmt')
+test.top_filename = "t/t_threads_counter.v"
+
+test.compile(verilator_flags2=['--cc --prof-exec'], threads=4)
+
+for policy in ['yield', 'sleep', 'spin']:
+    profile = test.obj_dir + "/profile_exec_" + policy + ".dat"
+    test.execute(all_run_flags=[
+        "+verilator+threads+wait+" + policy, " +verilator+prof+exec+start+2",
+        " +verilator+prof+exec+window+2", " +verilator+prof+exec+file+" + profile
+    ])
+    test.file_grep(profile, r'VLPROF stat thread0_waits \d+')
+    test.file_grep(profile, r'VLPROF stat thread0_wait_ticks \d+')
+    test.file_grep(profile, r'VLPROF stat thread0_yields \d+')
+    test.file_grep(profile, r'VLPROF stat thread0_sleeps \d+')
+
+test.execute(all_run_flags=["+verilator+threads+wait+bad"], fails=True)
+test.file_grep(test.run_log_filename, r'Unknown \+verilator\+threads\+wait\+ policy')
+
+test.passes()
@@ -0,0 +1,23 @@
+#!/usr/bin/env python3
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2025 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+import vltest_bootstrap
+
+test.scenarios('simulator')
+
+test.compile(verilator_flags2=["--exe --main --timing"])
+
+test.file_grep_any(test.glob_some(test.obj_dir + "/" + test.vm_prefix + "___024root*.cpp"),
+                   r'__VdlySched\.addTimeout\(0U, 10')
+test.file_grep_any(test.glob_some(test.obj_dir + "/" + test.vm_prefix + "___024root*.cpp"),
+                   r'__VdlySched\.addTimeout\(\d+U, 7')
+
+test.execute()
+
+test.passes()
@@ -0,0 +1,31 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t;
+   int x = 0;
+   int y = 0;
+
+   // Straight-line delay sequences, lowered to state machines
+   initial begin
+      x = 1;
+      #10 x = 2;
+      #5;
+      x = 3;
+      #5 #5 x = 4;
+   end
+   initial #7 y = 5;
+
+   // Has an 'if', so stays a coroutine
+   initial begin
+      #1 if (x != 1 || y != 0) $stop;
+      #10 if (x != 2 || y != 5) $stop;
+      #5 if (x != 3) $stop;
+      #5 if (x != 3) $stop;
+      #5 if (x != 4) $stop;
+      $write("*-* All Finished *-*\n");
+      $finish;
+   end
+endmodule
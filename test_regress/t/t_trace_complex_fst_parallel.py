@@ -0,0 +1,25 @@
+#!/usr/bin/env python3
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2025 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+import vltest_bootstrap
+
+test.scenarios('vltmt')
+test.top_filename = "t/t_trace_complex.v"
+test.golden_filename = "t/t_trace_complex_fst.out"
+
+test.compile(verilator_flags2=['--cc --trace-fst'], threads=4)
+
+test.execute()
+
+# Parallel trace collection enabled in the trace configuration
+test.file_grep(test.obj_dir + "/" + test.vm_prefix + ".cpp", r'VerilatedTraceConfig\{true, false')
+
+test.fst_identical(test.trace_filename, test.golden_filename)
+
+test.passes()
@@ -48,6 +48,8 @@ int main(int argc, char** argv) {
     tfp->dumpvars(1, "top.t.cyc");  // A signal
     tfp->dumpvars(1, "top.t.sub1a");  // Scope
     tfp->dumpvars(2, "top.t.sub1b");  // Scope
+#elif defined(T_TRACE_SCOPES)
+    tfp->traceScopes("top.t.sub1b.sub2?, top.*.sub1a");
 #else
 #error "Bad test"
 #endif
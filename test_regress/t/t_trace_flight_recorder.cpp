@@ -0,0 +1,40 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+#include <verilated.h>
+#include <verilated_vcd_c.h>
+
+#include <memory>
+
+#include VM_PREFIX_INCLUDE
+
+int main(int argc, char** argv) {
+    const std::unique_ptr<VerilatedContext> contextp{new VerilatedContext};
+    contextp->debug(0);
+    contextp->traceEverOn(true);
+    contextp->commandArgs(argc, argv);
+
+    const std::unique_ptr<VM_PREFIX> topp{new VM_PREFIX{contextp.get(), "top"}};
+    const std::unique_ptr<VerilatedVcdC> tfp{new VerilatedVcdC};
+
+    topp->trace(tfp.get(), 99);
+    tfp->flightRecorder(4);  // Keep only the last 4 to 8 dumps until $dumpon
+    tfp->open(VL_STRINGIFY(TEST_OBJ_DIR) "/simx.vcd");
+
+    topp->clk = 0;
+    while (!contextp->gotFinish() && contextp->time() < 100) {
+        topp->eval();
+        tfp->dump(contextp->time());
+        contextp->timeInc(1);
+        topp->clk = !topp->clk;
+    }
+    tfp->close();
+    topp->final();
+    printf("*-* All Finished *-*\n");
+    return 0;
+}
@@ -0,0 +1,27 @@
+#!/usr/bin/env python3
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2025 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+import vltest_bootstrap
+
+test.scenarios('vlt_all')
+test.pli_filename = "t/t_trace_flight_recorder.cpp"
+
+test.compile(make_main=False, verilator_flags2=["--trace-vcd --exe", test.pli_filename])
+
+test.execute()
+
+# $dumpon at time 25: dumps before the last full segment are discarded
+test.file_grep_not(test.trace_filename, r'^#19$')
+# The retained window starts with a full dump, including the unchanging 'a'
+test.file_grep(test.trace_filename, r'^#20$')
+test.file_grep(test.trace_filename, r'^b00000000000000000000010010111100 ')
+# And dumping continues as normal after the trigger
+test.file_grep(test.trace_filename, r'^#40$')
+
+test.passes()
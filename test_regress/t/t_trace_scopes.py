@@ -0,0 +1,30 @@
+#!/usr/bin/env python3
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2025 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+import vltest_bootstrap
+
+test.scenarios('vlt_all')
+test.pli_filename = "t/t_trace_dumpvars_dyn.cpp"
+test.top_filename = "t/t_trace_dumpvars_dyn.v"
+
+test.compile(make_main=False,
+             verilator_flags2=[
+                 "--trace-vcd --exe --output-split-ctrace 1", test.pli_filename,
+                 "-CFLAGS -DVL_DEBUG"
+             ])
+
+test.file_grep(test.obj_dir + "/V" + test.name + "__Trace__0.cpp", r'bufp->anyEnabled\(')
+
+test.execute()
+
+# sub1a and its three sub2, plus the three sub2 under sub1b, but not sub1b itself
+test.file_grep_count(test.trace_filename, r'\$var wire +32 +\S+ +ADD ', 7)
+test.file_grep_count(test.trace_filename, r'\$var wire +32 +\S+ +value ', 7)
+
+test.passes()
@@ -0,0 +1,78 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+   input clk;
+
+   integer cyc = 0;
+   reg [3:0] in;
+   wire maj_o, aoi_o, part_o;
+
+   udp_maj3 u_maj(maj_o, in[0], in[1], in[2]);
+   udp_aoi22 u_aoi(aoi_o, in[0], in[1], in[2], in[3]);
+   udp_part u_part(part_o, in[0], in[1]);
+
+   always @(posedge clk) begin
+      cyc <= cyc + 1;
+      in <= cyc[3:0];
+      if (cyc > 1) begin
+`ifdef TEST_VERBOSE
+         $write("[%0t] in=%b maj=%b aoi=%b\n", $time, in, maj_o, aoi_o);
+`endif
+         if (maj_o !== ((in[0] & in[1]) | (in[0] & in[2]) | (in[1] & in[2]))) $stop;
+         if (aoi_o !== !((in[0] & in[1]) | (in[2] & in[3]))) $stop;
+         if (in[1] && part_o !== in[0]) $stop;
+      end
+      if (cyc == 20) begin
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+endmodule
+
+// Every combination has a line: becomes a lookup
+primitive udp_maj3 (o, a, b, c);
+   output o;
+   input  a, b, c;
+   table
+      // a b c : o
+         1 1 ? : 1 ;
+         1 ? 1 : 1 ;
+         ? 1 1 : 1 ;
+         0 0 ? : 0 ;
+         0 ? 0 : 0 ;
+         ? 0 0 : 0 ;
+   endtable
+endprimitive
+
+// Every combination has a line: becomes a lookup
+primitive udp_aoi22 (o, a, b, c, d);
+   output o;
+   input  a, b, c, d;
+   table
+      // a b c d : o
+         1 1 ? ? : 0 ;
+         ? ? 1 1 : 0 ;
+         0 ? 0 ? : 1 ;
+         0 ? ? 0 : 1 ;
+         ? 0 0 ? : 1 ;
+         ? 0 ? 0 : 1 ;
+   endtable
+endprimitive
+
+// Not every combination has a line: kept as an if per line
+primitive udp_part (o, a, en);
+   output o;
+   input  a, en;
+   table
+      // a en : o
+         0 1  : 0 ;
+         1 1  : 1 ;
+   endtable
+endprimitive
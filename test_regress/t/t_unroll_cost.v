@@ -0,0 +1,47 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+   input clk;
+
+   integer cyc = 0;
+   logic [127:0] data;
+   logic [31:0] crc;
+   integer sum;
+
+   // Bit serial CRC, more iterations than --unroll-count, but the selects
+   // become constant when unrolled
+   function automatic logic [31:0] crc32(logic [31:0] c, logic [127:0] d);
+      for (int i = 0; i < 128; ++i) begin
+         c = {c[30:0], 1'b0} ^ ((c[31] ^ d[i]) ? 32'h04c11db7 : 32'h0);
+      end
+      return c;
+   endfunction
+
+   always @(posedge clk) begin
+      cyc <= cyc + 1;
+      data <= {data[126:0], data[127] ^ data[100]};
+      if (cyc == 0) begin
+         data <= 128'h0123456789abcdef_fedcba9876543210;
+         crc <= 32'hffffffff;
+         sum = 0;
+      end
+      else begin
+         crc <= crc32(crc, data);
+         // Too many iterations to unroll fully
+         for (int j = 0; j < 1000; ++j) sum = sum + j[2:0];
+      end
+      if (cyc == 10) begin
+         $display("crc=%x sum=%0d", crc, sum);
+         if (sum != 10 * 3500) $stop;
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+endmodule
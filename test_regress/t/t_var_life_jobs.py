@@ -0,0 +1,23 @@
+#!/usr/bin/env python3
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2025 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+import vltest_bootstrap
+
+test.scenarios('simulator')
+test.top_filename = "t/t_var_life.v"
+
+test.compile(verilator_flags2=["--stats", "--verilate-jobs 4", "--debug-check"])
+
+if test.vlt_all:
+    test.file_grep(test.stats, r'Optimizations, Lifetime assign deletions\s+(\d+)', 4)
+    test.file_grep(test.stats, r'Optimizations, Lifetime creset deletions\s+(\d+)', 1)
+
+test.execute()
+
+test.passes()
@@ -13,7 +13,9 @@ test.scenarios('vlt')
 
 test.compile(make_top_shell=False,
              make_main=False,
-             verilator_flags2=["--exe", test.pli_filename, "--sc -fno-inline"])
+             verilator_flags2=["--exe", test.pli_filename, "--sc -fno-inline --stats"])
+
+test.file_grep(test.stats, r'Scheduling, SystemC input reads on event\s+[1-9]\d*')
 
 test.execute()
 
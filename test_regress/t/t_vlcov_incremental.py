@@ -0,0 +1,36 @@
+#!/usr/bin/env python3
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2025 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+import vltest_bootstrap
+
+test.scenarios('dist')
+
+merged = test.obj_dir + "/coverage.dat"
+
+
+def vlcov_incremental(inputs):
+    test.run(cmd=[os.environ["VERILATOR_ROOT"] + "/bin/verilator_coverage", "--incremental",
+                  "--write", merged] + ["t/t_vlcov_data_" + x + ".dat" for x in inputs],
+             verilator_run=True)
+
+
+vlcov_incremental(["a", "b"])
+test.file_grep(merged, r'^# merged \d+ \d+ t/t_vlcov_data_b.dat')
+# The earlier inputs are skipped, so are not counted twice
+vlcov_incremental(["a", "b", "c", "d"])
+vlcov_incremental(["c", "d"])
+
+# Same result as merging everything at once, see t_vlcov_merge
+with open(merged, 'r', encoding="utf8") as fh:
+    lines = [line for line in fh if not line.startswith("# merged ")]
+with open(test.obj_dir + "/points.dat", 'w', encoding="utf8") as fh:
+    fh.writelines(lines)
+test.files_identical_sorted(test.obj_dir + "/points.dat", "t/t_vlcov_merge.out")
+
+test.passes()
@@ -0,0 +1,112 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//*************************************************************************
+//
+// Copyright 2025 by Wilson Snyder. This program is free software; you can
+// redistribute it and/or modify it under the terms of either the GNU
+// Lesser General Public License Version 3 or the Perl Artistic License
+// Version 2.0.
+// SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+//
+//*************************************************************************
+
+#include "verilated.h"
+#include "verilated_vpi.h"
+
+#include VM_PREFIX_INCLUDE
+
+#include "vpi_user.h"
+
+#include <cstring>
+#include <vector>
+
+// These require the above. Comment prevents clang-format moving them
+#include "TestCheck.h"
+#include "TestSimulator.h"
+#include "TestVpi.h"
+
+int errors = 0;
+
+int main(int argc, char** argv) {
+    const std::unique_ptr<VerilatedContext> contextp{new VerilatedContext};
+    contextp->commandArgs(argc, argv);
+    const std::unique_ptr<VM_PREFIX> topp{new VM_PREFIX{contextp.get(), ""}};
+    topp->eval();
+
+    TestVpiHandle narrowh = VPI_HANDLE("narrow");
+    TestVpiHandle quadh = VPI_HANDLE("quad");
+    TestVpiHandle wideh = VPI_HANDLE("wide");
+    TestVpiHandle memh = VPI_HANDLE("mem");
+    TestVpiHandle roh = VPI_HANDLE("ro");
+    TestVpiHandle mem2h = vpi_handle_by_index(memh, 2);
+
+    VerilatedVpiBatch batch;
+    TEST_CHECK_EQ(batch.add(narrowh), true);
+    TEST_CHECK_EQ(batch.add(quadh), true);
+    TEST_CHECK_EQ(batch.add(wideh), true);
+    TEST_CHECK_EQ(batch.add(memh), true);
+    TEST_CHECK_EQ(batch.add(mem2h), true);
+    TEST_CHECK_EQ(batch.size(), 5U);
+    TEST_CHECK_EQ(batch.offset(1), 1U);  // Values are packed, not aligned
+    TEST_CHECK_EQ(batch.bytes(), 1U + 8U + 12U + 4U + 1U);
+
+    std::vector<uint8_t> buf(batch.bytes());
+    batch.get(buf.data());
+    TEST_CHECK_EQ(buf[batch.offset(0)], 0x15);
+    QData q;
+    std::memcpy(&q, &buf[batch.offset(1)], sizeof(q));
+    TEST_CHECK_EQ(q, 0x123456789abcULL);
+    EData w[3];
+    std::memcpy(w, &buf[batch.offset(2)], sizeof(w));
+    TEST_CHECK_EQ(w[0], 0x89abcdefU);
+    TEST_CHECK_EQ(w[2], 0x3fU);
+    for (int i = 0; i < 4; ++i) TEST_CHECK_EQ(buf[batch.offset(3) + i], i + 1);
+    TEST_CHECK_EQ(buf[batch.offset(4)], 3);
+
+    // Put masks bits above each variable's width
+    std::memset(buf.data(), 0xff, buf.size());
+    batch.put(buf.data());
+    TEST_CHECK_EQ(VerilatedVpi::evalNeeded(), true);
+    batch.get(buf.data());
+    TEST_CHECK_EQ(buf[batch.offset(0)], 0x1f);
+    std::memcpy(&q, &buf[batch.offset(1)], sizeof(q));
+    TEST_CHECK_EQ(q, 0xffffffffffffULL);
+    std::memcpy(w, &buf[batch.offset(2)], sizeof(w));
+    TEST_CHECK_EQ(w[2], 0x3fU);
+
+    // Read-only signals can be read but not written
+    VerilatedVpiBatch robatch;
+    TEST_CHECK_EQ(robatch.add(roh), true);
+    IData ro = 0;
+    robatch.get(&ro);
+    TEST_CHECK_EQ(ro, 0xdeadbeefU);
+
+    // Deferred puts are only written by doInertialPuts
+    VerilatedVpi::clearEvalNeeded();
+    VerilatedVpiBatch dbatch;
+    TEST_CHECK_EQ(dbatch.add(narrowh), true);
+    TEST_CHECK_EQ(dbatch.add(quadh), true);
+    std::vector<uint8_t> dbuf(dbatch.bytes());
+    dbuf[dbatch.offset(0)] = 0x0a;
+    q = 0x42;
+    std::memcpy(&dbuf[dbatch.offset(1)], &q, sizeof(q));
+    dbatch.putDeferred(dbuf.data());
+    TEST_CHECK_EQ(dbatch.add(wideh), false);
+    TEST_CHECK_EQ(VerilatedVpi::evalNeeded(), false);
+    batch.get(buf.data());
+    TEST_CHECK_EQ(buf[batch.offset(0)], 0x1f);
+    VerilatedVpi::doInertialPuts();
+    TEST_CHECK_EQ(VerilatedVpi::evalNeeded(), true);
+    batch.get(buf.data());
+    TEST_CHECK_EQ(buf[batch.offset(0)], 0x0a);
+    std::memcpy(&q, &buf[batch.offset(1)], sizeof(q));
+    TEST_CHECK_EQ(q, 0x42ULL);
+    ro = 0;
+    robatch.put(&ro);
+    s_vpi_error_info info;
+    TEST_CHECK_NZ(vpi_chk_error(&info));
+    robatch.get(&ro);
+    TEST_CHECK_EQ(ro, 0xdeadbeefU);
+
+    topp->final();
+    return errors ? 10 : 0;
+}
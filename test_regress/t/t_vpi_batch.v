@@ -0,0 +1,20 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+   input clk;
+
+   logic [4:0] narrow /*verilator public_flat_rw*/ = 5'h15;
+   logic [47:0] quad /*verilator public_flat_rw*/ = 48'h1234_5678_9abc;
+   logic [69:0] wide /*verilator public_flat_rw*/ = 70'h3f_0123_4567_89ab_cdef;
+   logic [7:0] mem [0:3] /*verilator public_flat_rw*/;
+   logic [31:0] ro /*verilator public_flat_rd*/ = 32'hdeadbeef;
+
+   initial for (int i = 0; i < 4; ++i) mem[i] = 8'(i + 1);
+endmodule
@@ -0,0 +1,76 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//*************************************************************************
+//
+// Copyright 2025 by Wilson Snyder. This program is free software; you can
+// redistribute it and/or modify it under the terms of either the GNU
+// Lesser General Public License Version 3 or the Perl Artistic License
+// Version 2.0.
+// SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+//
+//*************************************************************************
+
+#include "verilated.h"
+#include "verilated_vpi.h"
+
+#include VM_PREFIX_INCLUDE
+
+#include "vpi_user.h"
+
+#include <string>
+#include <vector>
+
+// These require the above. Comment prevents clang-format moving them
+#include "TestCheck.h"
+#include "TestSimulator.h"
+#include "TestVpi.h"
+
+int errors = 0;
+
+int main(int argc, char** argv) {
+    const std::unique_ptr<VerilatedContext> contextp{new VerilatedContext};
+    contextp->commandArgs(argc, argv);
+    const std::unique_ptr<VM_PREFIX> topp{new VM_PREFIX{contextp.get(), ""}};
+    topp->eval();
+
+    // Repeated lookups of the same name resolve to the same variable
+    for (int i = 0; i < 3; ++i) {
+        TestVpiHandle ah = VPI_HANDLE("a");
+        TEST_CHECK_NZ(ah);
+        TEST_CHECK_EQ(std::string{vpi_get_str(vpiFullName, ah)}, "t.a");
+        s_vpi_value v;
+        v.format = vpiIntVal;
+        vpi_get_value(ah, &v);
+        TEST_CHECK_EQ(v.value.integer, 0x12);
+    }
+    TestVpiHandle missingh = VPI_HANDLE("missing");
+    TEST_CHECK_Z(missingh);
+
+    // Bulk variable list matches vpi_iterate
+    TestVpiHandle scopeh = VPI_HANDLE("");
+    TEST_CHECK_NZ(scopeh);
+    std::vector<vpiHandle> handles;
+    const size_t count = VerilatedVpi::scopeVars(scopeh, handles);
+    TEST_CHECK_EQ(count, handles.size());
+    TEST_CHECK_EQ(count >= 4, true);
+    TestVpiHandle iterh = vpi_iterate(vpiReg, scopeh);
+    size_t n = 0;
+    while (vpiHandle h = vpi_scan(iterh)) {
+        TEST_CHECK_EQ(std::string{vpi_get_str(vpiFullName, h)},
+                      std::string{vpi_get_str(vpiFullName, handles[n])});
+        TEST_CHECK_EQ(vpi_get(vpiType, h), vpi_get(vpiType, handles[n]));
+        vpi_release_handle(h);
+        ++n;
+    }
+    iterh.freed();
+    TEST_CHECK_EQ(n, count);
+    for (vpiHandle h : handles) vpi_release_handle(h);
+
+    // Not a scope
+    TestVpiHandle bh = VPI_HANDLE("b");
+    handles.clear();
+    TEST_CHECK_EQ(VerilatedVpi::scopeVars(bh, handles), 0U);
+    TEST_CHECK_EQ(handles.size(), 0U);
+
+    topp->final();
+    return errors ? 10 : 0;
+}
@@ -0,0 +1,17 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+   input clk /*verilator public_flat_rd*/;
+
+   localparam int P /*verilator public*/ = 5;
+   logic [7:0] a /*verilator public_flat_rd*/ = 8'h12;
+   logic [31:0] b /*verilator public_flat_rw*/ = 32'h3456;
+   logic [69:0] c /*verilator public_flat_rd*/ = 70'h789;
+endmodule
@@ -0,0 +1,34 @@
+#!/usr/bin/env python3
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2025 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+import vltest_bootstrap
+
+test.scenarios('vlt')
+test.top_filename = "t/t_vpi_var.v"
+test.pli_filename = "t/t_vpi_var.cpp"
+
+test.compile(make_top_shell=False,
+             make_main=False,
+             make_pli=True,
+             sim_time=2100,
+             v_flags2=["+define+USE_VPI_NOT_DPI"],
+             verilator_flags2=[
+                 "-Wno-SYMRSVDWORD --exe --vpi --no-l2name --output-split-cfuncs 1",
+                 test.pli_filename
+             ])
+
+# Variables are registered on first lookup, not in the constructor
+test.file_grep_any(test.glob_some(test.obj_dir + "/" + test.vm_prefix + "__Syms*.cpp"),
+                   r'\.varInit\(&')
+test.file_grep_any(test.glob_some(test.obj_dir + "/" + test.vm_prefix + "__Syms*.cpp"),
+                   r'::__Vvarinit_\w+\(VerilatedSyms\* symsp\)')
+
+test.execute(use_libvpi=True, all_run_flags=['+PLUS +INT=1234 +STRSTR'])
+
+test.passes()
@@ -0,0 +1,40 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+   input clk;
+
+   integer cyc = 0;
+   reg [511:0] a = {16{32'h1234_5678}};
+   reg [511:0] b = {16{32'h9abc_def0}};
+   reg [511:0] c = {16{32'h0f0f_f0f0}};
+   reg [511:0] d = {16{32'hdead_beef}};
+   reg [511:0] y;
+
+   // Bitwise tree computed word by word, without wide temporaries
+   always @* y = (a & b) | ~(c ^ (d & ~a));
+
+   always @(posedge clk) begin
+      cyc <= cyc + 1;
+      for (int i = 0; i < 512; ++i) begin
+         if (y[i] !== ((a[i] & b[i]) | ~(c[i] ^ (d[i] & ~a[i])))) begin
+            $display("%%Error: cyc=%0d bit %0d y=%x", cyc, i, y);
+            $stop;
+         end
+      end
+      a <= {a[510:0], a[511] ^ a[7]};
+      b <= {b[0], b[511:1]};
+      c <= c + {16{cyc[31:0]}};
+      d <= d ^ {a[255:0], b[511:256]};
+      if (cyc == 20) begin
+         $write("*-* All Finished *-*\n");
+         $finish;
+      end
+   end
+endmodule
@@ -0,0 +1,21 @@
+#!/usr/bin/env python3
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2025 by Wilson Snyder. This program is free software; you
+# can redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+# SPDX-License-Identifier: LGPL-3.0-only OR Artistic-2.0
+
+import vltest_bootstrap
+
+test.scenarios('vlt')
+
+test.compile(verilator_flags2=["--x-initial unique"])
+
+test.file_grep_any(test.glob_some(test.obj_dir + "/" + test.vm_prefix + "*Slow*.cpp"),
+                   r'VL_SCOPED_RAND_RESET_TABLE\(')
+
+test.execute(all_run_flags=["+verilator+rand+reset+1"])
+
+test.passes()
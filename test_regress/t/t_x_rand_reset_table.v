@@ -0,0 +1,27 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed under the Creative Commons Public Domain, for
+// any use, without warranty, 2025 by Wilson Snyder.
+// SPDX-License-Identifier: CC0-1.0
+
+module t;
+
+   // Enough uninitialized variables to be reset from tables
+   logic        a0, a1, a2, a3;
+   logic [7:0]  b0, b1, b2, b3;
+   logic [15:0] c0, c1;
+   logic [31:0] d0, d1;
+   logic [47:0] e0, e1;
+
+   initial begin
+      // +verilator+rand+reset+1 sets all bits
+      if ({a0, a1, a2, a3} !== '1) $stop;
+      if ({b0, b1, b2, b3} !== '1) $stop;
+      if ({c0, c1} !== '1) $stop;
+      if ({d0, d1} !== '1) $stop;
+      if ({e0, e1} !== '1) $stop;
+      $write("*-* All Finished *-*\n");
+      $finish;
+   end
+
+endmodule